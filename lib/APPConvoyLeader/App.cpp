@@ -38,8 +38,11 @@
 #include <Speedometer.h>
 #include <DifferentialDrive.h>
 #include <Odometry.h>
+#include <LandmarkCorrection.h>
 #include <Util.h>
 #include <Logging.h>
+#include <SpeedGovernor.h>
+#include <RobotConstants.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -58,27 +61,85 @@
  *****************************************************************************/
 
 static void App_motorSpeedSetpointsChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData);
+static void App_platoonChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData);
+static int32_t App_speedLeftGetter();
+static int32_t App_speedRightGetter();
+static void App_poseSampler();
+static int32_t App_posXGetter();
+static int32_t App_posYGetter();
+static int32_t App_orientationGetter();
+static int32_t App_mileageGetter();
+static int32_t App_speedLimitGetter();
 
 /******************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/** Position x-coordinate of the telemetry snapshot [mm]. */
+static int32_t gTelemetryPosX = 0;
+
+/** Position y-coordinate of the telemetry snapshot [mm]. */
+static int32_t gTelemetryPosY = 0;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void App::setup()
 {
+    /* The channel names are kept in program memory. The SerialMuxProt server
+     * copies a name, therefore it is only temporary needed in RAM.
+     */
+    char channelName[CHANNEL_NAME_BUFFER_SIZE];
+
     Serial.begin(SERIAL_BAUDRATE);
+    /* The log messages would disturb the SerialMuxProt frames, therefore logging
+     * is disabled. If it is enabled for debugging, it doesn't block the loop.
+     */
+    Logging::setOutput(m_txQueue);
     Logging::disable();
     Board::getInstance().init();
     m_systemStateMachine.setState(&StartupState::getInstance());
     m_controlInterval.start(DIFFERENTIAL_DRIVE_CONTROL_PERIOD);
 
+    /* The start and end line poses are learned in the first lap and
+     * used in every further lap to compensate the odometry drift.
+     */
+    LandmarkCorrection::getInstance().enableLearning(true);
+
     /* Setup SerialMuxProt Channels. */
+    Util::copyStr(channelName, sizeof(channelName), F(CURRENT_VEHICLE_DATA_CHANNEL_DLC_CHANNEL_NAME));
     m_serialMuxProtChannelIdCurrentVehicleData =
-        m_smpServer.createChannel(CURRENT_VEHICLE_DATA_CHANNEL_DLC_CHANNEL_NAME, CURRENT_VEHICLE_DATA_CHANNEL_DLC);
-    m_smpServer.subscribeToChannel(SPEED_SETPOINT_CHANNEL_NAME, App_motorSpeedSetpointsChannelCallback);
+        m_smpServer.createChannel(channelName, CURRENT_VEHICLE_DATA_CHANNEL_DLC);
+    Util::copyStr(channelName, sizeof(channelName), F(SPEED_SETPOINT_CHANNEL_NAME));
+    m_smpServer.subscribeToChannel(channelName, App_motorSpeedSetpointsChannelCallback);
+    Util::copyStr(channelName, sizeof(channelName), F(PATH_CHANNEL_NAME));
+    m_serialMuxProtChannelIdPath = m_smpServer.createChannel(channelName, PATH_CHANNEL_DLC);
+
+    /* Every path frame matters, therefore they shall never be coalesced. */
+    m_txQueue.setCoalescable(m_serialMuxProtChannelIdPath, false);
+
+    /* The followers report their gap and health, the leader reports the platoon throughput. */
+    Util::copyStr(channelName, sizeof(channelName), F(PLATOON_CHANNEL_NAME));
+    m_smpServer.subscribeToChannel(channelName, App_platoonChannelCallback);
+    Util::copyStr(channelName, sizeof(channelName), F(THROUGHPUT_CHANNEL_NAME));
+    m_serialMuxProtChannelIdThroughput = m_smpServer.createChannel(channelName, THROUGHPUT_CHANNEL_DLC);
+
+    if (0U != m_serialMuxProtChannelIdThroughput)
+    {
+        m_throughputReportTimer.start(THROUGHPUT_REPORTING_PERIOD);
+    }
+
+    /* Telemetry data frames and the schema, which describes them. */
+    Util::copyStr(channelName, sizeof(channelName), F(TELEMETRY_CHANNEL_NAME));
+    m_serialMuxProtChannelIdTelemetry = m_smpServer.createChannel(channelName, TELEMETRY_CHANNEL_DLC);
+    Util::copyStr(channelName, sizeof(channelName), F(TELEMETRY_SCHEMA_CHANNEL_NAME));
+    m_serialMuxProtChannelIdTelemetrySchema = m_smpServer.createChannel(channelName, TELEMETRY_SCHEMA_CHANNEL_DLC);
+
+    /* Every schema frame describes a different signal, they shall never replace each other. */
+    m_txQueue.setCoalescable(m_serialMuxProtChannelIdTelemetrySchema, false);
+
+    setupTelemetry();
 
     /* Channel sucesfully created? */
     if ((0U != m_serialMuxProtChannelIdCurrentVehicleData))
@@ -106,6 +167,11 @@ void App::loop()
          */
         Odometry::getInstance().process();
 
+        processPath();
+
+        /* The telemetry samples the signals synchronous to the control. */
+        sendTelemetryData();
+
         m_controlInterval.restart();
     }
 
@@ -117,7 +183,20 @@ void App::loop()
         m_reportTimer.restart();
     }
 
+    if (true == m_throughputReportTimer.isTimeout())
+    {
+        reportThroughput();
+
+        m_throughputReportTimer.restart();
+    }
+
     m_systemStateMachine.process();
+
+    /* Describe the telemetry data frames to the host. */
+    sendTelemetrySchema();
+
+    /* Send pending data without blocking. */
+    (void)m_txQueue.process(SERIAL_TX_BUDGET);
 }
 
 /******************************************************************************
@@ -148,6 +227,107 @@ void App::reportVehicleData()
     (void)m_smpServer.sendData(m_serialMuxProtChannelIdCurrentVehicleData, &payload, sizeof(VehicleData));
 }
 
+void App::reportThroughput()
+{
+    SpeedGovernor& governor = SpeedGovernor::getInstance();
+    ThroughputData payload;
+
+    payload.throughput = governor.calculateThroughput(Odometry::getInstance().getMileageCenter());
+    payload.speedLimit = governor.getSpeedLimit();
+    payload.worstGap   = governor.getWorstGap();
+    payload.followers  = governor.getNumFollowers();
+
+    /* Ignoring return value, as error handling is not available. */
+    (void)m_smpServer.sendData(m_serialMuxProtChannelIdThroughput, &payload, sizeof(ThroughputData));
+}
+
+void App::processPath()
+{
+    Odometry& odometry = Odometry::getInstance();
+    int32_t   xPos     = 0;
+    int32_t   yPos     = 0;
+    bool      isMoving = (0 != Speedometer::getInstance().getLinearSpeedCenter());
+    PathData  payload;
+
+    odometry.getPosition(xPos, yPos);
+    m_breadcrumbTrail.process(odometry.getMileageCenter(), xPos, yPos, odometry.getOrientation());
+
+    /* The followers shall get the trailing breadcrumbs, when the robot stops
+     * and not only after it drives again.
+     */
+    if ((true == m_isMoving) && (false == isMoving))
+    {
+        m_breadcrumbTrail.flush();
+    }
+
+    m_isMoving = isMoving;
+
+    if ((0U != m_serialMuxProtChannelIdPath) && (true == m_breadcrumbTrail.getFrame(payload)))
+    {
+        /* Ignoring return value, a lost frame is detected by the follower via sequence number. */
+        (void)m_smpServer.sendData(m_serialMuxProtChannelIdPath, &payload, sizeof(PathData));
+    }
+}
+
+void App::setupTelemetry()
+{
+    const int16_t STEPS_PER_MM = static_cast<int16_t>(RobotConstants::ENCODER_STEPS_PER_MM);
+
+    /* The signal names are kept in program memory. The speeds are scaled by the host from steps/s to mm/s. */
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("SPEED_L"), Telemetry::TYPE_INT16, App_speedLeftGetter, 1, STEPS_PER_MM));
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("SPEED_R"), Telemetry::TYPE_INT16, App_speedRightGetter, 1, STEPS_PER_MM));
+    (void)m_telemetry.select(m_telemetry.registerSignal(PSTR("POS_X"), Telemetry::TYPE_INT32, App_posXGetter));
+    (void)m_telemetry.select(m_telemetry.registerSignal(PSTR("POS_Y"), Telemetry::TYPE_INT32, App_posYGetter));
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("ORIENT"), Telemetry::TYPE_INT16, App_orientationGetter));
+    (void)m_telemetry.select(m_telemetry.registerSignal(PSTR("MILEAGE"), Telemetry::TYPE_UINT32, App_mileageGetter));
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("SPD_LIM"), Telemetry::TYPE_INT16, App_speedLimitGetter, 1, STEPS_PER_MM));
+
+    /* Both coordinates are read at once per data frame. */
+    m_telemetry.setSampler(App_poseSampler);
+    m_telemetry.setDecimation(TELEMETRY_DECIMATION);
+}
+
+void App::sendTelemetryData()
+{
+    Telemetry::DataFrame frame;
+
+    if ((0U != m_serialMuxProtChannelIdTelemetry) && (true == m_telemetry.process(frame)))
+    {
+        (void)m_smpServer.sendData(m_serialMuxProtChannelIdTelemetry, &frame, sizeof(frame));
+    }
+}
+
+void App::sendTelemetrySchema()
+{
+    bool isSynced = m_smpServer.isSynced();
+
+    /* Start over, if the host connected or the layout changed. */
+    if (((true == isSynced) && (false == m_isSmpSynced)) || (m_telemetry.getLayoutId() != m_telemetrySchemaLayoutId))
+    {
+        m_telemetrySchemaIdx      = 0U;
+        m_telemetrySchemaLayoutId = m_telemetry.getLayoutId();
+    }
+
+    m_isSmpSynced = isSynced;
+
+    if ((0U != m_serialMuxProtChannelIdTelemetrySchema) && (true == isSynced) &&
+        (m_telemetry.getNumSchemaFrames() > m_telemetrySchemaIdx) && (0U == m_txQueue.getPendingBytes()))
+    {
+        Telemetry::SchemaFrame frame;
+
+        if (true == m_telemetry.getSchemaFrame(m_telemetrySchemaIdx, frame))
+        {
+            (void)m_smpServer.sendData(m_serialMuxProtChannelIdTelemetrySchema, &frame, sizeof(frame));
+        }
+
+        ++m_telemetrySchemaIdx;
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -171,4 +351,102 @@ void App_motorSpeedSetpointsChannelCallback(const uint8_t* payload, const uint8_
         const SpeedData* motorSpeedData = reinterpret_cast<const SpeedData*>(payload);
         DifferentialDrive::getInstance().setLinearSpeed(motorSpeedData->left, motorSpeedData->right);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Receives the gap and health reports of the followers over SerialMuxProt channel.
+ *
+ * @param[in] payload       Follower id, health and gap
+ * @param[in] payloadSize   Size of the platoon data
+ * @param[in] userData      User data
+ */
+void App_platoonChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData)
+{
+    (void)userData;
+    if ((nullptr != payload) && (PLATOON_CHANNEL_DLC == payloadSize))
+    {
+        const PlatoonData* platoonData = reinterpret_cast<const PlatoonData*>(payload);
+
+        /* Ignoring return value, if too many followers report, the others are not considered. */
+        (void)SpeedGovernor::getInstance().reportFollower(platoonData->followerId, platoonData->gap,
+                                                          platoonData->health);
+    }
+}
+
+/**
+ * Provides the linear speed left for the telemetry.
+ *
+ * @return Linear speed left [steps/s]
+ */
+static int32_t App_speedLeftGetter()
+{
+    return static_cast<int32_t>(Speedometer::getInstance().getLinearSpeedLeft());
+}
+
+/**
+ * Provides the linear speed right for the telemetry.
+ *
+ * @return Linear speed right [steps/s]
+ */
+static int32_t App_speedRightGetter()
+{
+    return static_cast<int32_t>(Speedometer::getInstance().getLinearSpeedRight());
+}
+
+/**
+ * Takes the position snapshot for the telemetry data frame.
+ */
+static void App_poseSampler()
+{
+    Odometry::getInstance().getPosition(gTelemetryPosX, gTelemetryPosY);
+}
+
+/**
+ * Provides the x-coordinate of the snapshot for the telemetry.
+ *
+ * @return x-coordinate [mm]
+ */
+static int32_t App_posXGetter()
+{
+    return gTelemetryPosX;
+}
+
+/**
+ * Provides the y-coordinate of the snapshot for the telemetry.
+ *
+ * @return y-coordinate [mm]
+ */
+static int32_t App_posYGetter()
+{
+    return gTelemetryPosY;
+}
+
+/**
+ * Provides the orientation for the telemetry.
+ *
+ * @return Orientation [mrad]
+ */
+static int32_t App_orientationGetter()
+{
+    return Odometry::getInstance().getOrientation();
+}
+
+/**
+ * Provides the mileage for the telemetry.
+ *
+ * @return Mileage [mm]
+ */
+static int32_t App_mileageGetter()
+{
+    return static_cast<int32_t>(Odometry::getInstance().getMileageCenter());
+}
+
+/**
+ * Provides the speed limit of the governor for the telemetry.
+ *
+ * @return Speed limit [steps/s]
+ */
+static int32_t App_speedLimitGetter()
+{
+    return static_cast<int32_t>(SpeedGovernor::getInstance().getSpeedLimit());
+}
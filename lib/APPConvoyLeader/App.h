@@ -45,8 +45,11 @@
  *****************************************************************************/
 #include <StateMachine.h>
 #include <SimpleTimer.h>
+#include <SerialTxQueue.h>
 #include <SerialMuxProtServer.hpp>
 #include "SerialMuxChannels.h"
+#include <BreadcrumbTrail.hpp>
+#include <Telemetry.h>
 #include <Arduino.h>
 
 /******************************************************************************
@@ -66,10 +69,22 @@ public:
      */
     App() :
         m_serialMuxProtChannelIdCurrentVehicleData(0U),
+        m_serialMuxProtChannelIdPath(0U),
+        m_serialMuxProtChannelIdThroughput(0U),
+        m_serialMuxProtChannelIdTelemetry(0U),
+        m_serialMuxProtChannelIdTelemetrySchema(0U),
         m_systemStateMachine(),
         m_controlInterval(),
         m_reportTimer(),
-        m_smpServer(Serial)
+        m_throughputReportTimer(),
+        m_txQueue(Serial, SerialTxQueue::POLICY_COALESCE),
+        m_smpServer(m_txQueue),
+        m_breadcrumbTrail(),
+        m_isMoving(false),
+        m_telemetry(),
+        m_isSmpSynced(false),
+        m_telemetrySchemaIdx(0U),
+        m_telemetrySchemaLayoutId(0U)
     {
     }
 
@@ -97,12 +112,33 @@ private:
     /** Current data reporting period in ms. */
     static const uint32_t REPORTING_PERIOD = 50U;
 
+    /** Platoon throughput reporting period in ms. */
+    static const uint32_t THROUGHPUT_REPORTING_PERIOD = 1000U;
+
     /** Baudrate for Serial Communication */
     static const uint32_t SERIAL_BAUDRATE = 115200U;
 
+    /** Maximum number of bytes, which are sent to the serial driver per loop. */
+    static const size_t SERIAL_TX_BUDGET = 64U;
+
+    /** Number of differential drive control periods per telemetry data frame. */
+    static const uint8_t TELEMETRY_DECIMATION = 4U;
+
     /** SerialMuxProt Channel id for sending the current vehicle data. */
     uint8_t m_serialMuxProtChannelIdCurrentVehicleData;
 
+    /** SerialMuxProt Channel id for sending the breadcrumb path. */
+    uint8_t m_serialMuxProtChannelIdPath;
+
+    /** SerialMuxProt Channel id for sending the platoon throughput. */
+    uint8_t m_serialMuxProtChannelIdThroughput;
+
+    /** SerialMuxProt Channel id for sending the telemetry data frames. */
+    uint8_t m_serialMuxProtChannelIdTelemetry;
+
+    /** SerialMuxProt Channel id for sending the telemetry schema frames. */
+    uint8_t m_serialMuxProtChannelIdTelemetrySchema;
+
     /** The system state machine. */
     StateMachine m_systemStateMachine;
 
@@ -112,6 +148,16 @@ private:
     /** Timer for reporting current data through SerialMuxProt. */
     SimpleTimer m_reportTimer;
 
+    /** Timer for reporting the platoon throughput through SerialMuxProt. */
+    SimpleTimer m_throughputReportTimer;
+
+    /**
+     * Transmit queue between SerialMuxProt and the serial driver, which decouples
+     * the application from a slow or absent host. Only the latest frame per
+     * channel is kept.
+     */
+    SerialTxQueue m_txQueue;
+
     /**
      * SerialMuxProt Server Instance
      *
@@ -119,6 +165,24 @@ private:
      */
     SerialMuxProtServer<MAX_CHANNELS> m_smpServer;
 
+    /** Breadcrumb trail of the travelled path, which is published for the followers. */
+    BreadcrumbTrail<PathData, PATH_DELTAS_PER_FRAME> m_breadcrumbTrail;
+
+    /** Was the robot moving in the last control cycle? */
+    bool m_isMoving;
+
+    /** Composes the telemetry data frames from the registered signals. */
+    Telemetry m_telemetry;
+
+    /** Was the SerialMuxProt server synchronized with the host last loop? */
+    bool m_isSmpSynced;
+
+    /** Index of the next telemetry schema frame to send. */
+    uint8_t m_telemetrySchemaIdx;
+
+    /** Layout id of the last sent telemetry schema. */
+    uint8_t m_telemetrySchemaLayoutId;
+
     /**
      * Report the current vehicle data.
      * Report the current position and heading of the robot using the Odometry data.
@@ -127,6 +191,36 @@ private:
      */
     void reportVehicleData();
 
+    /**
+     * Drop breadcrumbs along the travelled path and send every completed path frame.
+     * When the robot stops, the trailing breadcrumbs are sent too.
+     * It shall be called after the odometry is processed.
+     */
+    void processPath();
+
+    /**
+     * Report the platoon throughput, the speed limit of the governor and the worst follower gap.
+     * Sends data through the SerialMuxProtServer.
+     */
+    void reportThroughput();
+
+    /**
+     * Register the telemetry signals and select them for the data frame.
+     */
+    void setupTelemetry();
+
+    /**
+     * Send a telemetry data frame every n-th call.
+     * Call it once per differential drive control period.
+     */
+    void sendTelemetryData();
+
+    /**
+     * Send the telemetry schema after the host connected or the layout changed.
+     * One schema frame is sent per call, if the transmit queue is empty.
+     */
+    void sendTelemetrySchema();
+
     /* Not allowed. */
     App(const App& app);            /**< Copy construction of an instance. */
     App& operator=(const App& app); /**< Assignment of an instance. */
@@ -38,8 +38,10 @@
 #include <DifferentialDrive.h>
 #include <StateMachine.h>
 #include <Odometry.h>
+#include <LandmarkCorrection.h>
 #include "ReadyState.h"
 #include "ParameterSets.h"
+#include <SpeedGovernor.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -86,6 +88,9 @@ void DrivingState::entry()
     m_pidCtrl.setSampleTime(PID_PROCESS_PERIOD);
     m_pidCtrl.setLimits(-maxSpeed, maxSpeed);
     m_pidCtrl.setDerivativeOnMeasurement(true);
+
+    /* Start with the top speed, the governor reduces it if the followers can't keep up. */
+    SpeedGovernor::getInstance().resync(m_topSpeed);
 }
 
 void DrivingState::process(StateMachine& sm)
@@ -182,6 +187,9 @@ void DrivingState::processOnTrack(int16_t position, const uint16_t* lineSensorVa
 
                 Sound::playBeep();
 
+                /* The start line is a landmark, which compensates the odometry drift. */
+                (void)LandmarkCorrection::getInstance().observe(LandmarkCorrection::TYPE_START_LINE);
+
                 /* Measure the lap time and use as start point the detected start line. */
                 m_lapTime.start(0);
             }
@@ -195,6 +203,8 @@ void DrivingState::processOnTrack(int16_t position, const uint16_t* lineSensorVa
                  */
                 diffDrive.setLinearSpeed(0, 0);
 
+                (void)LandmarkCorrection::getInstance().observe(LandmarkCorrection::TYPE_END_LINE);
+
                 Sound::playBeep();
                 m_trackStatus = TRACK_STATUS_FINISHED;
 
@@ -257,8 +267,10 @@ void DrivingState::processTrackLost(int16_t position, const uint16_t* lineSensor
     }
     else
     {
+        const int16_t topSpeed = SpeedGovernor::getInstance().limitSpeed(m_topSpeed); /* [steps/s] */
+
         /* Drive straight on. */
-        diffDrive.setLinearSpeed(m_topSpeed, m_topSpeed);
+        diffDrive.setLinearSpeed(topSpeed, topSpeed);
     }
 }
 
@@ -335,6 +347,9 @@ void DrivingState::adaptDriving(int16_t position)
     int16_t             leftSpeed       = 0; /* [steps/s] */
     int16_t             rightSpeed      = 0; /* [steps/s] */
 
+    /* Limit the top speed, so that the followers are able to keep up. */
+    const int16_t topSpeed = SpeedGovernor::getInstance().limitSpeed(m_topSpeed); /* [steps/s] */
+
     /* Our "error" is how far we are away from the center of the
      * line, which corresponds to position (max. line sensor value multiplied
      * with sensor index).
@@ -346,8 +361,8 @@ void DrivingState::adaptDriving(int16_t position)
     /* Get individual motor speeds.  The sign of speedDifference
      * determines if the robot turns left or right.
      */
-    leftSpeed  = m_topSpeed - speedDifference;
-    rightSpeed = m_topSpeed + speedDifference;
+    leftSpeed  = topSpeed - speedDifference;
+    rightSpeed = topSpeed + speedDifference;
 
     /* Constrain our motor speeds to be between 0 and maxSpeed.
      * One motor will always be turning at maxSpeed, and the other
@@ -356,8 +371,8 @@ void DrivingState::adaptDriving(int16_t position)
      * might want to allow the motor speed to go negative so that
      * it can spin in reverse.
      */
-    leftSpeed  = constrain(leftSpeed, 0, m_topSpeed);
-    rightSpeed = constrain(rightSpeed, 0, m_topSpeed);
+    leftSpeed  = constrain(leftSpeed, 0, topSpeed);
+    rightSpeed = constrain(rightSpeed, 0, topSpeed);
 
     diffDrive.setLinearSpeed(leftSpeed, rightSpeed);
 }
@@ -66,7 +66,7 @@ void ErrorState::entry()
     IDisplay& display = Board::getInstance().getDisplay();
 
     display.clear();
-    display.print("Error");
+    display.print(F("Error"));
     display.gotoXY(0, 1);
     display.print(m_errorMsg);
 }
@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <Arduino.h>
 
 /******************************************************************************
  * Macros
@@ -62,7 +63,7 @@ public:
      */
     struct ParameterSet
     {
-        const char* name;          /**< Name of the parameter set */
+        const char* name;          /**< Name of the parameter set in program memory */
         int16_t     topSpeed;      /**< Top speed in steps/s */
         int16_t     kPNumerator;   /**< Kp numerator value */
         int16_t     kPDenominator; /**< Kp denominator value */
@@ -119,8 +120,8 @@ public:
 
 protected:
 private:
-    uint8_t      m_currentSetId;      /**< Set id of current selected set. */
-    ParameterSet m_parSets[MAX_SETS]; /**< All parameter sets */
+    uint8_t      m_currentSetId; /**< Set id of current selected set. */
+    ParameterSet m_parSet;       /**< Current selected set, copied from program memory. */
 
     /**
      * Default constructor.
@@ -132,6 +133,11 @@ private:
      */
     ~ParameterSets();
 
+    /**
+     * Load the current selected set from program memory.
+     */
+    void load();
+
     /* Not allowed. */
     ParameterSets(const ParameterSets& set);            /**< Copy construction of an instance. */
     ParameterSets& operator=(const ParameterSets& set); /**< Assignment of an instance. */
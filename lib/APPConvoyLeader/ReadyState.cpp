@@ -70,7 +70,7 @@ void ReadyState::entry()
     const int32_t SENSOR_VALUE_OUT_PERIOD = 1000; /* ms */
 
     display.clear();
-    display.print("Rdy.");
+    display.print(F("Rdy."));
 
     if (true == m_isLapTimeAvailable)
     {
@@ -44,6 +44,7 @@
  *****************************************************************************/
 
 #include <Arduino.h>
+#include <Telemetry.h>
 
 /******************************************************************************
  * Macros
@@ -52,6 +53,12 @@
 /** Maximum number of SerialMuxProt Channels. */
 #define MAX_CHANNELS (10U)
 
+/**
+ * Size of a buffer for a channel name in RAM. It considers the max. channel name
+ * length of 10 characters, given by the SerialMuxProt, and the termination.
+ */
+#define CHANNEL_NAME_BUFFER_SIZE (11U)
+
 /** Name of Channel to send Current Vehicle Data to. */
 #define CURRENT_VEHICLE_DATA_CHANNEL_DLC_CHANNEL_NAME "CURR_DATA"
 
@@ -64,6 +71,39 @@
 /** DLC of Speedometer Channel */
 #define SPEED_SETPOINT_CHANNEL_DLC (sizeof(SpeedData))
 
+/** Name of Channel to send the breadcrumb path to. */
+#define PATH_CHANNEL_NAME "PATH"
+
+/** DLC of Path Channel */
+#define PATH_CHANNEL_DLC (sizeof(PathData))
+
+/** Number of delta encoded breadcrumbs in one path frame, following the absolute one. */
+#define PATH_DELTAS_PER_FRAME (4U)
+
+/** Name of Channel to receive the follower gap and health reports. */
+#define PLATOON_CHANNEL_NAME "PLATOON"
+
+/** DLC of Platoon Channel */
+#define PLATOON_CHANNEL_DLC (sizeof(PlatoonData))
+
+/** Name of Channel to send the platoon throughput to. */
+#define THROUGHPUT_CHANNEL_NAME "THROUGHPUT"
+
+/** DLC of Throughput Channel */
+#define THROUGHPUT_CHANNEL_DLC (sizeof(ThroughputData))
+
+/** Name of the Channel to send the Telemetry Data frames to. */
+#define TELEMETRY_CHANNEL_NAME "TELEMETRY"
+
+/** DLC of Telemetry Data Channel */
+#define TELEMETRY_CHANNEL_DLC (sizeof(Telemetry::DataFrame))
+
+/** Name of the Channel to send the Telemetry Schema frames to. */
+#define TELEMETRY_SCHEMA_CHANNEL_NAME "TLM_SCHEMA"
+
+/** DLC of Telemetry Schema Channel */
+#define TELEMETRY_SCHEMA_CHANNEL_DLC (sizeof(Telemetry::SchemaFrame))
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
@@ -86,6 +126,46 @@ typedef struct _SpeedData
     int16_t right; /**< Right motor speed [steps/s]. */
 } __attribute__((packed)) SpeedData;
 
+/** Breadcrumb, relative to the previous one. */
+typedef struct _PathDelta
+{
+    int8_t  xPos;        /**< X position delta [mm]. */
+    int8_t  yPos;        /**< Y position delta [mm]. */
+    int16_t orientation; /**< Orientation delta [mrad]. */
+} __attribute__((packed)) PathDelta;
+
+/**
+ * Struct of the "Path" channel payload.
+ * The first breadcrumb is absolute, so every frame can be used standalone.
+ * The following breadcrumbs are relative to their predecessor.
+ */
+typedef struct _PathData
+{
+    uint16_t  sequenceNumber;                /**< Sequence number of the first breadcrumb. */
+    uint8_t   count;                         /**< Number of valid breadcrumbs in the frame [1; 1 + deltas]. */
+    int32_t   xPos;                          /**< X position of the first breadcrumb [mm]. */
+    int32_t   yPos;                          /**< Y position of the first breadcrumb [mm]. */
+    int32_t   orientation;                   /**< Orientation of the first breadcrumb [mrad]. */
+    PathDelta deltas[PATH_DELTAS_PER_FRAME]; /**< Following breadcrumbs. */
+} __attribute__((packed)) PathData;
+
+/** Struct of the "Platoon" channel payload, reported by every follower. */
+typedef struct _PlatoonData
+{
+    uint8_t followerId; /**< Unique id of the follower. */
+    uint8_t health;     /**< Follower health [%]. 0 means it can't follow anymore. */
+    int16_t gap;        /**< Gap to the predecessor along the path [mm]. */
+} __attribute__((packed)) PlatoonData;
+
+/** Struct of the "Throughput" channel payload. */
+typedef struct _ThroughputData
+{
+    uint16_t throughput; /**< Travelled distance per second of the whole platoon [mm/s]. */
+    int16_t  speedLimit; /**< Leader speed limit, applied by the governor [steps/s]. */
+    int16_t  worstGap;   /**< Largest gap of all followers [mm]. */
+    uint8_t  followers;  /**< Number of followers, which reported in time. */
+} __attribute__((packed)) ThroughputData;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
@@ -34,16 +34,36 @@
  *****************************************************************************/
 #include "App.h"
 #include "StartupState.h"
+#include "MotorSpeedCalibrationState.h"
+#include "LineSensorsCalibrationState.h"
+#include "ReadyState.h"
+#include "DrivingState.h"
+#include "ReleaseTrackState.h"
+#include "SystemIdentificationState.h"
+#include "ErrorState.h"
+#include "ParameterSets.h"
+#include <Diagnostics.h>
 #include <Board.h>
 #include <Speedometer.h>
 #include <DifferentialDrive.h>
 #include <Odometry.h>
 #include <Util.h>
+#include <Logging.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef TARGET_NATIVE
+#include <Checkpoint.h>
+#endif /* TARGET_NATIVE */
 
 /******************************************************************************
  * Compiler Switches
  *****************************************************************************/
 
+#if (0 != WHEEL_CONTROL_ISR_ENABLE) && (0 != HAL_PROFILER_ENABLE)
+#error "The HAL profiler is not interrupt safe, but the wheel speed control accesses the HAL in interrupt context."
+#endif /* (0 != WHEEL_CONTROL_ISR_ENABLE) && (0 != HAL_PROFILER_ENABLE) */
+
 /******************************************************************************
  * Macros
  *****************************************************************************/
@@ -60,6 +80,11 @@
  * Local Variables
  *****************************************************************************/
 
+/**
+ * Logging source.
+ */
+LOG_TAG("App");
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -67,22 +92,72 @@
 void App::setup()
 {
     Serial.begin(SERIAL_BAUDRATE);
+    Logging::setOutput(m_txQueue);
     Board::getInstance().init();
+    Diagnostics::getInstance().setBattery(Board::getInstance().getBattery());
     m_systemStateMachine.setState(&StartupState::getInstance());
     m_controlInterval.start(DIFFERENTIAL_DRIVE_CONTROL_PERIOD);
+    m_latencyReportTimer.start(LATENCY_REPORT_PERIOD);
+    m_loopSupervisor.start(MAX_LOOP_PERIOD, Board::getInstance().getIdle().getLoopQuantum());
+    m_idleManager.start(DIFFERENTIAL_DRIVE_CONTROL_PERIOD * 1000U);
+    m_wheelGainsStoreTimer.start(WHEEL_GAINS_STORE_PERIOD);
+
+    /* The wheel speed control is not running yet, which applies the gains right from the start. */
+    loadWheelGains();
+
+#ifdef TARGET_NATIVE
+    /* The simulation may checkpoint the run or continue a checkpointed one. */
+    Checkpoint::getInstance().setCallbacks(onSaveSnapshot, onRestoreSnapshot, this);
+#endif /* TARGET_NATIVE */
+
+#if (0 != HAL_PROFILER_ENABLE)
+    m_halProfilerReportTimer.start(HAL_PROFILER_REPORT_PERIOD);
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
+#if (0 != WHEEL_CONTROL_ISR_ENABLE)
+    /* Create the instances before they are used in interrupt context. */
+    (void)Speedometer::getInstance();
+    (void)DifferentialDrive::getInstance();
+
+    Board::getInstance().getControlTimer().start(WHEEL_CONTROL_PERIOD, processWheelControl);
+#endif /* (0 != WHEEL_CONTROL_ISR_ENABLE) */
 }
 
 void App::loop()
 {
+    m_idleManager.beginLoop(micros());
+    superviseLoop();
+
+#if (0 == WHEEL_CONTROL_ISR_ENABLE)
     Speedometer::getInstance().process();
+#endif /* (0 == WHEEL_CONTROL_ISR_ENABLE) */
 
+    /* The control runs as one chain per control period with a fixed phase:
+     * line sensor acquisition -> line position estimation -> line PID (all in
+     * the active state) -> wheel speed PID -> motor PWM. This keeps the
+     * sense-to-actuate latency short and constant, independent of the loop
+     * duration.
+     */
     if (true == m_controlInterval.isTimeout())
     {
+        m_idleManager.markDeadline(micros());
+        m_latencyMeter.start();
+
+        m_systemStateMachine.process();
+
+        /* Override the set points of the active state, if the loop is degraded. */
+        limitSpeed();
+
+#if (0 == WHEEL_CONTROL_ISR_ENABLE)
         /* The differential drive control needs the measured speed of the
-         * left and right wheel. Therefore it shall be processed after
-         * the speedometer.
+         * left and right wheel and the set points of the active state.
+         * Therefore it shall be processed after the speedometer and the
+         * system state machine.
          */
         DifferentialDrive::getInstance().process(DIFFERENTIAL_DRIVE_CONTROL_PERIOD);
+#endif /* (0 == WHEEL_CONTROL_ISR_ENABLE) */
+
+        m_latencyMeter.stop();
 
         /* The odometry unit needs to detect motor speed changes to be able to
          * calculate correct values. Therefore it shall be processed right after
@@ -90,10 +165,88 @@ void App::loop()
          */
         Odometry::getInstance().process();
 
-        m_controlInterval.restart();
+        /* Update the diagnostics page outside of the control chain, which
+         * writes at most one display line per control period.
+         */
+        Diagnostics::getInstance().setLoopStatistics(
+            m_loopSupervisor.getMaxPeriod(), m_loopSupervisor.getAvgPeriod(), m_loopSupervisor.getOverrunCount());
+        Diagnostics::getInstance().process();
+
+        /* Keep the phase of the control period, even if the loop noticed the timeout late. */
+        m_controlInterval.advance();
+    }
+
+    if (true == m_latencyReportTimer.isTimeout())
+    {
+        reportLatency();
+        reportIdle();
+
+        m_latencyReportTimer.restart();
     }
 
-    m_systemStateMachine.process();
+    if (true == m_wheelGainsStoreTimer.isTimeout())
+    {
+        storeWheelGains();
+
+        m_wheelGainsStoreTimer.restart();
+    }
+
+#if (0 != HAL_PROFILER_ENABLE)
+    if (true == m_halProfilerReportTimer.isTimeout())
+    {
+        reportHalProfile();
+
+        m_halProfilerReportTimer.restart();
+    }
+
+    /* Every loop iteration is one sample of the calls per loop histogram. */
+    HALProfiler::getInstance().endLoop();
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
+    /* Send pending log output without blocking. */
+    (void)m_txQueue.process(SERIAL_TX_BUDGET);
+
+    idle();
+}
+
+bool App::saveSnapshot(Snapshot& snapshot) const
+{
+    IState* states[NUM_STATES];
+
+    getStates(states);
+
+    m_systemStateMachine.save(snapshot, states, NUM_STATES);
+    m_controlInterval.save(snapshot);
+    saveLineSensorsCalibration(snapshot);
+    ParameterSets::getInstance().save(snapshot);
+    Speedometer::getInstance().save(snapshot);
+    DifferentialDrive::getInstance().save(snapshot);
+    Odometry::getInstance().save(snapshot);
+    ReadyState::getInstance().save(snapshot);
+    DrivingState::getInstance().save(snapshot);
+
+    return snapshot.isValid();
+}
+
+bool App::restoreSnapshot(Snapshot& snapshot)
+{
+    IState* states[NUM_STATES];
+    bool    isStateRestored = false;
+    bool    isCalibRestored = false;
+
+    getStates(states);
+
+    isStateRestored = m_systemStateMachine.restore(snapshot, states, NUM_STATES);
+    m_controlInterval.restore(snapshot);
+    isCalibRestored = restoreLineSensorsCalibration(snapshot);
+    ParameterSets::getInstance().restore(snapshot);
+    Speedometer::getInstance().restore(snapshot);
+    DifferentialDrive::getInstance().restore(snapshot);
+    Odometry::getInstance().restore(snapshot);
+    ReadyState::getInstance().restore(snapshot);
+    DrivingState::getInstance().restore(snapshot);
+
+    return (true == isStateRestored) && (true == isCalibRestored) && (true == snapshot.isValid());
 }
 
 /******************************************************************************
@@ -104,6 +257,432 @@ void App::loop()
  * Private Methods
  *****************************************************************************/
 
+void App::getStates(IState* (&states)[NUM_STATES])
+{
+    /* A snapshot refers to the states by their index, therefore new states shall be appended. */
+    states[0U] = &StartupState::getInstance();
+    states[1U] = &MotorSpeedCalibrationState::getInstance();
+    states[2U] = &LineSensorsCalibrationState::getInstance();
+    states[3U] = &ReadyState::getInstance();
+    states[4U] = &DrivingState::getInstance();
+    states[5U] = &ReleaseTrackState::getInstance();
+    states[6U] = &SystemIdentificationState::getInstance();
+    states[7U] = &ErrorState::getInstance();
+}
+
+void App::saveLineSensorsCalibration(Snapshot& snapshot)
+{
+    ILineSensors& lineSensors = Board::getInstance().getLineSensors();
+    uint8_t       numSensors  = lineSensors.getNumLineSensors();
+    uint8_t       idx         = 0U;
+
+    (void)snapshot.put(numSensors);
+
+    for (idx = 0U; idx < numSensors; ++idx)
+    {
+        (void)snapshot.put(lineSensors.getCalibMinValue(idx));
+        (void)snapshot.put(lineSensors.getCalibMaxValue(idx));
+    }
+}
+
+bool App::restoreLineSensorsCalibration(Snapshot& snapshot)
+{
+    ILineSensors& lineSensors = Board::getInstance().getLineSensors();
+    bool          isRestored  = false;
+    uint8_t       numSensors  = 0U;
+
+    /* The calibration fits only to the same line sensor configuration. */
+    if ((true == snapshot.get(numSensors)) && (lineSensors.getNumLineSensors() == numSensors) &&
+        (MAX_LINE_SENSORS >= numSensors))
+    {
+        uint16_t minValues[MAX_LINE_SENSORS];
+        uint16_t maxValues[MAX_LINE_SENSORS];
+        uint8_t  idx = 0U;
+
+        for (idx = 0U; idx < numSensors; ++idx)
+        {
+            (void)snapshot.get(minValues[idx]);
+            (void)snapshot.get(maxValues[idx]);
+        }
+
+        if (true == snapshot.isValid())
+        {
+            lineSensors.setCalibration(minValues, maxValues);
+            isRestored = true;
+        }
+    }
+
+    return isRestored;
+}
+
+#ifdef TARGET_NATIVE
+
+bool App::onSaveSnapshot(Snapshot& snapshot, void* userData)
+{
+    const App* app = static_cast<const App*>(userData);
+
+    return (nullptr != app) && (true == app->saveSnapshot(snapshot));
+}
+
+bool App::onRestoreSnapshot(Snapshot& snapshot, void* userData)
+{
+    App* app = static_cast<App*>(userData);
+
+    return (nullptr != app) && (true == app->restoreSnapshot(snapshot));
+}
+
+#endif /* TARGET_NATIVE */
+
+void App::reportLatency()
+{
+    char valueStr[12];
+
+    LOG_DEBUG_HEAD();
+#if (0 != WHEEL_CONTROL_ISR_ENABLE)
+    /* The wheel speed PID and the motor PWM update run in the control timer
+     * interrupt, which is not part of the measurement. It adds up to one
+     * wheel control period, which is reported separately.
+     */
+    LOG_DEBUG_MSG(F("Latency to set point (us) min/avg/max: "));
+#else  /* (0 != WHEEL_CONTROL_ISR_ENABLE) */
+    LOG_DEBUG_MSG(F("Latency (us) min/avg/max: "));
+#endif /* (0 != WHEEL_CONTROL_ISR_ENABLE) */
+    Util::uintToStr(valueStr, sizeof(valueStr), m_latencyMeter.getMin());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_MSG(F(" / "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_latencyMeter.getAverage());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_MSG(F(" / "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_latencyMeter.getMax());
+    LOG_DEBUG_MSG(valueStr);
+#if (0 != WHEEL_CONTROL_ISR_ENABLE)
+    LOG_DEBUG_MSG(F(" + up to (ms) "));
+    Util::uintToStr(valueStr, sizeof(valueStr), WHEEL_CONTROL_PERIOD);
+    LOG_DEBUG_MSG(valueStr);
+#endif /* (0 != WHEEL_CONTROL_ISR_ENABLE) */
+    LOG_DEBUG_TAIL();
+
+    m_latencyMeter.clear();
+}
+
+void App::reportIdle()
+{
+    char valueStr[12];
+
+    LOG_DEBUG_HEAD();
+    LOG_DEBUG_MSG(F("CPU utilization (permille): "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_idleManager.getUtilization());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_TAIL();
+
+    LOG_DEBUG_HEAD();
+    LOG_DEBUG_MSG(F("Wake-up latency (us) min/avg/max: "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_idleManager.getMinLatency());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_MSG(F(" / "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_idleManager.getAvgLatency());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_MSG(F(" / "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_idleManager.getMaxLatency());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_MSG(F(", missed: "));
+    Util::uintToStr(valueStr, sizeof(valueStr), m_idleManager.getMissedCount());
+    LOG_DEBUG_MSG(valueStr);
+    LOG_DEBUG_TAIL();
+
+    m_idleManager.clear();
+}
+
+void App::loadWheelGains()
+{
+    DifferentialDrive& diffDrive = DifferentialDrive::getInstance();
+    ISettings&         settings  = Board::getInstance().getSettings();
+    WheelGainsRecord   record;
+
+    if ((true == settings.read(WHEEL_GAINS_ADDRESS, &record, sizeof(record))) && (WHEEL_GAINS_MAGIC == record.magic) &&
+        (WHEEL_GAINS_VERSION == record.version) && (calculateChecksum(record) == record.checksum))
+    {
+        diffDrive.setWheelGains(record.gainsLeft, record.gainsRight);
+
+        m_storedGainsLeft  = record.gainsLeft;
+        m_storedGainsRight = record.gainsRight;
+
+        LOG_INFO("Wheel gains loaded.");
+    }
+    else
+    {
+        LOG_INFO("No wheel gains stored, using defaults.");
+    }
+
+    logWheelGains(m_storedGainsLeft, m_storedGainsRight);
+
+    diffDrive.enableWheelTuning(true);
+}
+
+void App::storeWheelGains()
+{
+    WheelTuner::Gains gainsLeft;
+    WheelTuner::Gains gainsRight;
+    bool              isDriving = (&DrivingState::getInstance() == m_systemStateMachine.getState());
+
+    DifferentialDrive::getInstance().getWheelGains(gainsLeft, gainsRight);
+
+    if ((false == isDriving) &&
+        ((gainsLeft.pDivisor != m_storedGainsLeft.pDivisor) || (gainsLeft.iDivisor != m_storedGainsLeft.iDivisor) ||
+         (gainsRight.pDivisor != m_storedGainsRight.pDivisor) || (gainsRight.iDivisor != m_storedGainsRight.iDivisor)))
+    {
+        WheelGainsRecord record;
+
+        /* The padding bytes are part of the checksum too. */
+        (void)memset(&record, 0, sizeof(record));
+
+        record.magic      = WHEEL_GAINS_MAGIC;
+        record.version    = WHEEL_GAINS_VERSION;
+        record.gainsLeft  = gainsLeft;
+        record.gainsRight = gainsRight;
+        record.checksum   = calculateChecksum(record);
+
+        if (true == Board::getInstance().getSettings().write(WHEEL_GAINS_ADDRESS, &record, sizeof(record)))
+        {
+            m_storedGainsLeft  = gainsLeft;
+            m_storedGainsRight = gainsRight;
+
+            LOG_INFO("Wheel gains stored.");
+            logWheelGains(gainsLeft, gainsRight);
+        }
+        else
+        {
+            LOG_ERROR("Storing wheel gains failed.");
+        }
+    }
+}
+
+void App::logWheelGains(const WheelTuner::Gains& gainsLeft, const WheelTuner::Gains& gainsRight)
+{
+    char valueStr[12];
+
+    LOG_INFO_HEAD();
+    LOG_INFO_MSG(F("Wheel gains 1/x left P/I: "));
+    Util::uintToStr(valueStr, sizeof(valueStr), gainsLeft.pDivisor);
+    LOG_INFO_MSG(valueStr);
+    LOG_INFO_MSG(F(" / "));
+    Util::uintToStr(valueStr, sizeof(valueStr), gainsLeft.iDivisor);
+    LOG_INFO_MSG(valueStr);
+    LOG_INFO_MSG(F(", right P/I: "));
+    Util::uintToStr(valueStr, sizeof(valueStr), gainsRight.pDivisor);
+    LOG_INFO_MSG(valueStr);
+    LOG_INFO_MSG(F(" / "));
+    Util::uintToStr(valueStr, sizeof(valueStr), gainsRight.iDivisor);
+    LOG_INFO_MSG(valueStr);
+    LOG_INFO_TAIL();
+}
+
+uint8_t App::calculateChecksum(const WheelGainsRecord& record)
+{
+    const uint8_t* data     = reinterpret_cast<const uint8_t*>(&record);
+    size_t         size     = offsetof(WheelGainsRecord, checksum);
+    uint8_t        checksum = 0U;
+    size_t         idx      = 0U;
+
+    /* The complement rejects a record, where all bytes are 0. */
+    for (idx = 0U; idx < size; ++idx)
+    {
+        checksum += data[idx];
+    }
+
+    return static_cast<uint8_t>(~checksum);
+}
+
+void App::idle()
+{
+    /* All due tasks have run. The next deadline is the control period, which
+     * becomes due with a timer interrupt. If it is already due, the loop
+     * continues immediately.
+     */
+    if (false == m_controlInterval.isTimeout())
+    {
+        m_idleManager.beginIdle(micros());
+
+#if (0 != IDLE_SLEEP_ENABLE)
+        Board::getInstance().getIdle().sleep();
+#endif /* (0 != IDLE_SLEEP_ENABLE) */
+    }
+}
+
+void App::processWheelControl()
+{
+    /* The differential drive control needs the measured speed of the
+     * left and right wheel. The set points of the active state are
+     * taken over from the main loop consistently.
+     */
+    Speedometer::getInstance().process();
+    DifferentialDrive::getInstance().process(WHEEL_CONTROL_PERIOD);
+}
+
+void App::superviseLoop()
+{
+    IWatchdog& watchdog  = Board::getInstance().getWatchdog();
+    bool       isDriving = (&DrivingState::getInstance() == m_systemStateMachine.getState());
+
+    /* A hung loop is only dangerous while driving. The other states may block
+     * on purpose, e.g. while waiting for a button release.
+     */
+    if (isDriving != m_isWatchdogEnabled)
+    {
+        if (true == isDriving)
+        {
+            watchdog.enable(WATCHDOG_TIMEOUT);
+
+            /* Every run starts undegraded. */
+            m_loopSupervisor.reset();
+            applyLoopLevel();
+        }
+        else
+        {
+            watchdog.disable();
+        }
+
+        m_isWatchdogEnabled = isDriving;
+    }
+    else if (true == m_isWatchdogEnabled)
+    {
+        watchdog.trigger();
+    }
+    else
+    {
+        ;
+    }
+
+    if (true == m_loopSupervisor.process(micros()))
+    {
+        applyLoopLevel();
+    }
+}
+
+void App::applyLoopLevel()
+{
+    LoopSupervisor::Level level = m_loopSupervisor.getLevel();
+
+    /* Only the logging, which was shed by the supervision, is enabled again. Logging,
+     * which is disabled otherwise, e.g. by the simulation in socket mode, stays disabled.
+     */
+    if (true == m_isLoggingShed)
+    {
+        Logging::enable();
+        m_isLoggingShed = false;
+    }
+
+    /* The transition is reported, even if the logging is shed afterwards. */
+    LOG_WARNING_VAL("Loop level: ", static_cast<uint8_t>(level));
+    LOG_WARNING_VAL("Max. loop period (us): ", m_loopSupervisor.getMaxPeriod());
+
+    if ((LoopSupervisor::LEVEL_SHED_OUTPUT <= level) && (true == Logging::isEnabled()))
+    {
+        Logging::disable();
+        m_isLoggingShed = true;
+    }
+
+    /* Stop driving in a controlled way and show it to the user. */
+    if ((LoopSupervisor::LEVEL_STOP == level) && (true == m_isWatchdogEnabled))
+    {
+        ErrorState::getInstance().setErrorMsg("Overload");
+        m_systemStateMachine.setState(&ErrorState::getInstance());
+    }
+}
+
+void App::limitSpeed()
+{
+    LoopSupervisor::Level level = m_loopSupervisor.getLevel();
+
+    if (LoopSupervisor::LEVEL_STOP == level)
+    {
+        DifferentialDrive::getInstance().setLinearSpeed(0, 0);
+    }
+    else if (LoopSupervisor::LEVEL_LIMIT_SPEED == level)
+    {
+        DifferentialDrive& diffDrive        = DifferentialDrive::getInstance();
+        int32_t            limit            = (diffDrive.getMaxMotorSpeed() * DEGRADED_SPEED_LIMIT) / 100;
+        int16_t            linearSpeedLeft  = 0;
+        int16_t            linearSpeedRight = 0;
+        int32_t            maxSpeed         = 0;
+
+        diffDrive.getLinearSpeed(linearSpeedLeft, linearSpeedRight);
+
+        maxSpeed = abs(static_cast<int32_t>(linearSpeedLeft));
+
+        if (maxSpeed < abs(static_cast<int32_t>(linearSpeedRight)))
+        {
+            maxSpeed = abs(static_cast<int32_t>(linearSpeedRight));
+        }
+
+        /* Scale both wheels equally to keep the curvature. */
+        if (limit < maxSpeed)
+        {
+            linearSpeedLeft  = static_cast<int16_t>((linearSpeedLeft * limit) / maxSpeed);
+            linearSpeedRight = static_cast<int16_t>((linearSpeedRight * limit) / maxSpeed);
+
+            diffDrive.setLinearSpeed(linearSpeedLeft, linearSpeedRight);
+        }
+    }
+    else
+    {
+        ;
+    }
+}
+
+#if (0 != HAL_PROFILER_ENABLE)
+
+void App::reportHalProfile()
+{
+    const HALProfiler& profiler   = HALProfiler::getInstance();
+    uint8_t            count      = 0U;
+    bool               isReported = false;
+
+    /* Search the next method, which was called at least once. */
+    while ((false == isReported) && (HALProfiler::METHOD_MAX > count))
+    {
+        HALProfiler::Method            method     = static_cast<HALProfiler::Method>(m_halProfilerReportIdx);
+        const HALProfiler::Statistics& statistics = profiler.getStatistics(method);
+
+        ++m_halProfilerReportIdx;
+        m_halProfilerReportIdx %= HALProfiler::METHOD_MAX;
+
+        if (0U < statistics.totalCalls)
+        {
+            char    valueStr[12];
+            uint8_t bin;
+
+            LOG_DEBUG_HEAD();
+            LOG_DEBUG_MSG(HALProfiler::getName(method));
+            LOG_DEBUG_MSG(F(" calls: "));
+            Util::uintToStr(valueStr, sizeof(valueStr), statistics.totalCalls);
+            LOG_DEBUG_MSG(valueStr);
+            LOG_DEBUG_MSG(F(" time (us): "));
+            Util::uintToStr(valueStr, sizeof(valueStr), statistics.totalTime);
+            LOG_DEBUG_MSG(valueStr);
+            LOG_DEBUG_MSG(F(" max/loop: "));
+            Util::uintToStr(valueStr, sizeof(valueStr), statistics.maxLoopTime);
+            LOG_DEBUG_MSG(valueStr);
+            LOG_DEBUG_MSG(F(" calls/loop 0/1/2/3+:"));
+
+            for (bin = 0U; bin < HALProfiler::HISTOGRAM_BINS; ++bin)
+            {
+                LOG_DEBUG_MSG(F(" "));
+                Util::uintToStr(valueStr, sizeof(valueStr), statistics.histogram[bin]);
+                LOG_DEBUG_MSG(valueStr);
+            }
+
+            LOG_DEBUG_TAIL();
+
+            isReported = true;
+        }
+
+        ++count;
+    }
+}
+
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
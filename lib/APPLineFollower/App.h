@@ -40,11 +40,36 @@
  * Compile Switches
  *****************************************************************************/
 
+#ifndef WHEEL_CONTROL_ISR_ENABLE
+/**
+ * Run the wheel speed control (speedometer and wheel speed PIDs) in the control
+ * timer interrupt instead of the main loop. It decouples the wheel speed control
+ * from the duration of the main loop.
+ */
+#define WHEEL_CONTROL_ISR_ENABLE (0)
+#endif /* WHEEL_CONTROL_ISR_ENABLE */
+
+#ifndef IDLE_SLEEP_ENABLE
+/**
+ * Sleep the CPU after all due tasks have run, until the next interrupt wakes it
+ * up. It lowers the power consumption and the jitter of the control period
+ * start. If disabled, the loop spins, which is useful to compare both.
+ */
+#define IDLE_SLEEP_ENABLE (1)
+#endif /* IDLE_SLEEP_ENABLE */
+
 /******************************************************************************
  * Includes
  *****************************************************************************/
 #include <StateMachine.h>
 #include <SimpleTimer.h>
+#include <SerialTxQueue.h>
+#include <Snapshot.h>
+#include <LatencyMeter.h>
+#include <LoopSupervisor.h>
+#include <IdleManager.h>
+#include <WheelTuner.h>
+#include <HALProfiler.h>
 #include <Arduino.h>
 
 /******************************************************************************
@@ -62,7 +87,23 @@ public:
     /**
      * Construct the line follower application.
      */
-    App() : m_systemStateMachine(), m_controlInterval()
+    App() :
+        m_systemStateMachine(),
+        m_controlInterval(),
+        m_txQueue(Serial, SerialTxQueue::POLICY_DROP_NEWEST),
+        m_latencyMeter(),
+        m_latencyReportTimer(),
+        m_loopSupervisor(),
+        m_idleManager(),
+        m_wheelGainsStoreTimer(),
+        m_storedGainsLeft(WheelTuner::getDefaultGains()),
+        m_storedGainsRight(WheelTuner::getDefaultGains()),
+#if (0 != HAL_PROFILER_ENABLE)
+        m_halProfilerReportTimer(),
+        m_halProfilerReportIdx(0U),
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+        m_isWatchdogEnabled(false),
+        m_isLoggingShed(false)
     {
     }
 
@@ -83,19 +124,260 @@ public:
      */
     void loop();
 
+    /**
+     * Save all mutable application and service state to a snapshot.
+     * It is appended to the data, which the snapshot already contains.
+     * Used in the simulation to checkpoint a run.
+     *
+     * @param[out] snapshot Snapshot
+     *
+     * @return If the snapshot is complete, it will return true otherwise false.
+     */
+    bool saveSnapshot(Snapshot& snapshot) const;
+
+    /**
+     * Restore all mutable application and service state from a snapshot,
+     * which was saved before by the same application. It is read from the
+     * current read position of the snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     *
+     * @return If successful restored, it will return true otherwise false.
+     */
+    bool restoreSnapshot(Snapshot& snapshot);
+
 private:
     /** Differential drive control period in ms. */
     static const uint32_t DIFFERENTIAL_DRIVE_CONTROL_PERIOD = 5U;
 
+    /** Wheel speed control period in ms, if it runs in the control timer interrupt. */
+    static const uint8_t WHEEL_CONTROL_PERIOD = 2U;
+
     /** Baudrate for Serial Communication */
     static const uint32_t SERIAL_BAUDRATE = 115200U;
 
+    /** Maximum number of bytes, which are sent to the serial driver per loop. */
+    static const size_t SERIAL_TX_BUDGET = 64U;
+
+    /** Period in ms for reporting the sense-to-actuate latency. */
+    static const uint32_t LATENCY_REPORT_PERIOD = 10000U;
+
+    /** Max. loop period in us. If longer, a control period was missed. A longer loop quantum, e.g. the simulation step, raises it. */
+    static const uint32_t MAX_LOOP_PERIOD = DIFFERENTIAL_DRIVE_CONTROL_PERIOD * 1000U;
+
+    /** Speed limit in percent of the max. motor speed, if the loop is degraded. */
+    static const int16_t DEGRADED_SPEED_LIMIT = 50;
+
+    /**
+     * Watchdog timeout in ms. It must be longer than a blocking alarm sound,
+     * which is played while driving.
+     */
+    static const uint16_t WATCHDOG_TIMEOUT = 500U;
+
+    /** Period in ms for storing changed wheel speed controller gains. */
+    static const uint32_t WHEEL_GAINS_STORE_PERIOD = 10000U;
+
+    /** Address of the wheel speed controller gains in the settings. */
+    static const uint16_t WHEEL_GAINS_ADDRESS = 0U;
+
+    /** Magic number, which marks stored wheel speed controller gains. */
+    static const uint16_t WHEEL_GAINS_MAGIC = 0x5747U;
+
+    /** Version of the stored wheel speed controller gains record. */
+    static const uint8_t WHEEL_GAINS_VERSION = 1U;
+
+    /**
+     * Wheel speed controller gains record in the settings.
+     */
+    struct WheelGainsRecord
+    {
+        uint16_t          magic;      /**< Magic number */
+        uint8_t           version;    /**< Record version */
+        WheelTuner::Gains gainsLeft;  /**< Gains of the left wheel speed controller */
+        WheelTuner::Gains gainsRight; /**< Gains of the right wheel speed controller */
+        uint8_t           checksum;   /**< Checksum over all previous bytes */
+    };
+
+#if (0 != HAL_PROFILER_ENABLE)
+    /** Period in ms for reporting the statistics of the next profiled HAL method. */
+    static const uint32_t HAL_PROFILER_REPORT_PERIOD = 100U;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
     /** The system state machine. */
     StateMachine m_systemStateMachine;
 
     /** Timer used for differential drive control processing. */
     SimpleTimer m_controlInterval;
 
+    /**
+     * Transmit queue between the logging and the serial driver, which decouples
+     * the application from a slow or absent host. If full, new log output is dropped.
+     */
+    SerialTxQueue m_txQueue;
+
+    /** Measures the latency from line sensor acquisition to motor PWM update. */
+    LatencyMeter m_latencyMeter;
+
+    /** Timer used to report the latency statistics periodically. */
+    SimpleTimer m_latencyReportTimer;
+
+    /** Supervises the loop period and degrades the application on overload. */
+    LoopSupervisor m_loopSupervisor;
+
+    /** Measures the CPU utilization and the wake-up latency of the control period. */
+    IdleManager m_idleManager;
+
+    /** Timer used to store changed wheel speed controller gains periodically. */
+    SimpleTimer m_wheelGainsStoreTimer;
+
+    /** Gains of the left wheel speed controller, which are stored in the settings. */
+    WheelTuner::Gains m_storedGainsLeft;
+
+    /** Gains of the right wheel speed controller, which are stored in the settings. */
+    WheelTuner::Gains m_storedGainsRight;
+
+#if (0 != HAL_PROFILER_ENABLE)
+    /** Timer used to report the HAL profiler statistics periodically. */
+    SimpleTimer m_halProfilerReportTimer;
+
+    /** Index of the profiled HAL method, which is reported next. */
+    uint8_t m_halProfilerReportIdx;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
+    /** Is the watchdog enabled? */
+    bool m_isWatchdogEnabled;
+
+    /** Is the logging disabled by the loop supervision? */
+    bool m_isLoggingShed;
+
+    /** Number of states of the system state machine. */
+    static const uint8_t NUM_STATES = 8U;
+
+    /** Max. number of line sensors, whose calibration is saved in a snapshot. */
+    static const uint8_t MAX_LINE_SENSORS = 5U;
+
+    /**
+     * Get all states of the system state machine, which a snapshot refers to by index.
+     *
+     * @param[out] states   State table
+     */
+    static void getStates(IState* (&states)[NUM_STATES]);
+
+    /**
+     * Save the line sensor calibration to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    static void saveLineSensorsCalibration(Snapshot& snapshot);
+
+    /**
+     * Restore the line sensor calibration from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     *
+     * @return If successful restored, it will return true otherwise false.
+     */
+    static bool restoreLineSensorsCalibration(Snapshot& snapshot);
+
+#ifdef TARGET_NATIVE
+    /**
+     * Save the application state for a checkpoint of the simulation.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] userData  Application
+     *
+     * @return If successful saved, it will return true otherwise false.
+     */
+    static bool onSaveSnapshot(Snapshot& snapshot, void* userData);
+
+    /**
+     * Restore the application state from a checkpoint of the simulation.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] userData  Application
+     *
+     * @return If successful restored, it will return true otherwise false.
+     */
+    static bool onRestoreSnapshot(Snapshot& snapshot, void* userData);
+#endif /* TARGET_NATIVE */
+
+    /**
+     * Report the latency statistics via debug log and clear them afterwards.
+     * If the wheel speed control runs in the interrupt, the latency is measured
+     * until the wheel speed set points are updated. The motor PWM follows in the
+     * next control timer interrupt, which is reported as additional bound.
+     */
+    void reportLatency();
+
+    /**
+     * Report the CPU utilization and wake-up latency via debug log and clear them afterwards.
+     */
+    void reportIdle();
+
+    /**
+     * Load the wheel speed controller gains from the settings and enable their
+     * online adaptation. Without valid stored gains, the defaults are kept.
+     */
+    void loadWheelGains();
+
+    /**
+     * Store the adapted wheel speed controller gains in the settings, if they changed.
+     * Writing the settings blocks, therefore they are only stored if the robot doesn't drive.
+     */
+    void storeWheelGains();
+
+    /**
+     * Log the wheel speed controller gains.
+     *
+     * @param[in] gainsLeft     Gains of the left wheel speed controller
+     * @param[in] gainsRight    Gains of the right wheel speed controller
+     */
+    static void logWheelGains(const WheelTuner::Gains& gainsLeft, const WheelTuner::Gains& gainsRight);
+
+    /**
+     * Calculate the checksum of a wheel speed controller gains record.
+     *
+     * @param[in] record    Record
+     *
+     * @return Checksum over all bytes before the checksum.
+     */
+    static uint8_t calculateChecksum(const WheelGainsRecord& record);
+
+    /**
+     * Sleep until the next interrupt, unless the next control period is already due.
+     */
+    void idle();
+
+    /**
+     * Supervise the loop period and serve the watchdog while driving.
+     */
+    void superviseLoop();
+
+    /**
+     * Report the current degradation level and apply it, except the speed limit.
+     */
+    void applyLoopLevel();
+
+    /**
+     * Limit the speed set points according to the current degradation level.
+     */
+    void limitSpeed();
+
+    /**
+     * Process the wheel speed control. It is called by the control timer
+     * in interrupt context.
+     */
+    static void processWheelControl();
+
+#if (0 != HAL_PROFILER_ENABLE)
+    /**
+     * Report the statistics of the next profiled HAL method, which was called
+     * at least once, via debug log. One method is reported at a time to keep
+     * the serial transmit queue from overflowing.
+     */
+    void reportHalProfile();
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
     /* Not allowed. */
     App(const App& app);            /**< Copy construction of an instance. */
     App& operator=(const App& app); /**< Assignment of an instance. */
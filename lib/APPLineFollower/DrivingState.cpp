@@ -40,6 +40,7 @@
 #include <Odometry.h>
 #include "ReadyState.h"
 #include "ParameterSets.h"
+#include <Diagnostics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -72,19 +73,16 @@ void DrivingState::entry()
     const int16_t                      maxSpeed  = diffDrive.getMaxMotorSpeed(); /* [steps/s] */
 
     m_observationTimer.start(OBSERVATION_DURATION);
-    m_pidProcessTime.start(0); /* Immediate */
+
+#if (0 != DIAGNOSTICS_LIVE_ENABLE)
+    Diagnostics::getInstance().enable(Diagnostics::LIVE_REFRESH_PERIOD);
+#endif /* (0 != DIAGNOSTICS_LIVE_ENABLE) */
+
     m_lineStatus  = LINE_STATUS_FIND_START_LINE;
     m_trackStatus = TRACK_STATUS_ON_TRACK; /* Assume that the robot is placed on track. */
 
     /* Configure PID controller with selected parameter set. */
-    m_topSpeed = parSet.topSpeed;
-    m_pidCtrl.clear();
-    m_pidCtrl.setPFactor(parSet.kPNumerator, parSet.kPDenominator);
-    m_pidCtrl.setIFactor(parSet.kINumerator, parSet.kIDenominator);
-    m_pidCtrl.setDFactor(parSet.kDNumerator, parSet.kDDenominator);
-    m_pidCtrl.setSampleTime(PID_PROCESS_PERIOD);
-    m_pidCtrl.setLimits(-maxSpeed, maxSpeed);
-    m_pidCtrl.setDerivativeOnMeasurement(true);
+    m_lineFollowCtrl.start(parSet, maxSpeed);
 }
 
 void DrivingState::process(StateMachine& sm)
@@ -137,6 +135,30 @@ void DrivingState::exit()
 {
     m_observationTimer.stop();
     Board::getInstance().getYellowLed().enable(false);
+
+#if (0 != DIAGNOSTICS_LIVE_ENABLE)
+    Diagnostics::getInstance().disable();
+#endif /* (0 != DIAGNOSTICS_LIVE_ENABLE) */
+}
+
+void DrivingState::save(Snapshot& snapshot) const
+{
+    m_observationTimer.save(snapshot);
+    m_lapTime.save(snapshot);
+    m_lineFollowCtrl.save(snapshot);
+    (void)snapshot.put(m_lineStatus);
+    (void)snapshot.put(m_trackStatus);
+    (void)snapshot.put(m_startEndLineDebounce);
+}
+
+void DrivingState::restore(Snapshot& snapshot)
+{
+    m_observationTimer.restore(snapshot);
+    m_lapTime.restore(snapshot);
+    m_lineFollowCtrl.restore(snapshot);
+    (void)snapshot.get(m_lineStatus);
+    (void)snapshot.get(m_trackStatus);
+    (void)snapshot.get(m_startEndLineDebounce);
 }
 
 /******************************************************************************
@@ -197,6 +219,7 @@ void DrivingState::processOnTrack(int16_t position, const uint16_t* lineSensorVa
 
                 /* Calculate lap time and show it*/
                 ReadyState::getInstance().setLapTime(m_lapTime.getCurrentDuration());
+                Diagnostics::getInstance().addLap(m_lapTime.getCurrentDuration());
             }
             else
             {
@@ -214,12 +237,7 @@ void DrivingState::processOnTrack(int16_t position, const uint16_t* lineSensorVa
 
         if (TRACK_STATUS_FINISHED != m_trackStatus)
         {
-            if (true == m_pidProcessTime.isTimeout())
-            {
-                adaptDriving(position);
-
-                m_pidProcessTime.start(PID_PROCESS_PERIOD);
-            }
+            adaptDriving(position);
         }
     }
 }
@@ -237,12 +255,12 @@ void DrivingState::processTrackLost(int16_t position, const uint16_t* lineSensor
     if (false == isTrackGapDetected(position))
     {
         m_trackStatus = TRACK_STATUS_ON_TRACK;
-        m_pidCtrl.resync();
+        m_lineFollowCtrl.resync();
 
         Board::getInstance().getYellowLed().enable(false);
     }
     /* Max. distance driven, but track still not found? */
-    else if (MAX_DISTANCE < Odometry::getInstance().getMileageCenter())
+    else if (LineFollowController::MAX_DISTANCE < Odometry::getInstance().getMileageCenter())
     {
         /* Stop motors immediately. Don't move this to a later position,
          * as this would extend the driven length.
@@ -255,7 +273,7 @@ void DrivingState::processTrackLost(int16_t position, const uint16_t* lineSensor
     else
     {
         /* Drive straight on. */
-        diffDrive.setLinearSpeed(m_topSpeed, m_topSpeed);
+        diffDrive.setLinearSpeed(m_lineFollowCtrl.getTopSpeed(), m_lineFollowCtrl.getTopSpeed());
     }
 }
 
@@ -300,64 +318,27 @@ bool DrivingState::isStartEndLineDetected(const uint16_t* lineSensorValues)
 
 bool DrivingState::isTrackGapDetected(int16_t position) const
 {
-    bool                isDetected  = false;
     const ILineSensors& lineSensors = Board::getInstance().getLineSensors();
 
-    /* Position value after loosing the track and sensor 0 saw it as last.
-     * It depends on the Zumo32U4LineSensors::readLine() implementation.
-     */
-    const int16_t POS_MIN = 0;
-
-    /* Position value after loosing the track and sensor N saw it as last.
-     * It depends on the Zumo32U4LineSensors::readLine() implementation.
-     */
-    const int16_t POS_MAX = (lineSensors.getNumLineSensors() - 1) * 1000;
-
-    /* Note, no debouncing is done here. If necessary, it shall be done
-     * outside this method.
-     */
-    if ((POS_MIN >= position) || (POS_MAX <= position))
-    {
-        isDetected = true;
-    }
-
-    return isDetected;
+    return LineFollowController::isTrackGapDetected(position, lineSensors.getNumLineSensors());
 }
 
 void DrivingState::adaptDriving(int16_t position)
 {
-    DifferentialDrive&  diffDrive       = DifferentialDrive::getInstance();
-    const ILineSensors& lineSensors     = Board::getInstance().getLineSensors();
-    const int16_t       MAX_MOTOR_SPEED = diffDrive.getMaxMotorSpeed();
-    int16_t             speedDifference = 0; /* [steps/s] */
-    int16_t             leftSpeed       = 0; /* [steps/s] */
-    int16_t             rightSpeed      = 0; /* [steps/s] */
-
-    /* Our "error" is how far we are away from the center of the
-     * line, which corresponds to position (max. line sensor value multiplied
-     * with sensor index).
-     *
-     * Get motor speed difference using PID terms.
-     */
-    speedDifference = m_pidCtrl.calculate(lineSensors.getSensorValueMax() * 2, position);
+    DifferentialDrive&  diffDrive   = DifferentialDrive::getInstance();
+    const ILineSensors& lineSensors = Board::getInstance().getLineSensors();
+    int16_t             leftSpeed   = 0; /* [steps/s] */
+    int16_t             rightSpeed  = 0; /* [steps/s] */
 
-    /* Get individual motor speeds.  The sign of speedDifference
-     * determines if the robot turns left or right.
-     */
-    leftSpeed  = m_topSpeed - speedDifference;
-    rightSpeed = m_topSpeed + speedDifference;
-
-    /* Constrain our motor speeds to be between 0 and maxSpeed.
-     * One motor will always be turning at maxSpeed, and the other
-     * will be at maxSpeed-|speedDifference| if that is positive,
-     * else it will be stationary. For some applications, you
-     * might want to allow the motor speed to go negative so that
-     * it can spin in reverse.
+    /* The PID runs in phase with the control cycle, therefore the new
+     * wheel speed set points are taken over by the differential drive
+     * right after and not one control period later.
      */
-    leftSpeed  = constrain(leftSpeed, 0, MAX_MOTOR_SPEED);
-    rightSpeed = constrain(rightSpeed, 0, MAX_MOTOR_SPEED);
-
-    diffDrive.setLinearSpeed(leftSpeed, rightSpeed);
+    if (true == m_lineFollowCtrl.process(position, lineSensors.getSensorValueMax(), diffDrive.getMaxMotorSpeed(),
+                                         leftSpeed, rightSpeed))
+    {
+        diffDrive.setLinearSpeed(leftSpeed, rightSpeed);
+    }
 }
 
 /******************************************************************************
@@ -46,7 +46,8 @@
 #include <stdint.h>
 #include <IState.h>
 #include <SimpleTimer.h>
-#include <PIDController.h>
+#include <LineFollowController.hpp>
+#include <Snapshot.h>
 
 /******************************************************************************
  * Macros
@@ -91,6 +92,21 @@ public:
      */
     void exit() final;
 
+    /**
+     * Save the driving state to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the driving state from a snapshot.
+     * Change e.g. the PID parameters afterwards to fork a variant.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
 protected:
 private:
     /**
@@ -116,20 +132,12 @@ private:
     /** Observation duration in ms. This is the max. time within the robot must be finished its drive. */
     static const uint32_t OBSERVATION_DURATION = 3000000;
 
-    /** Max. distance in mm after a lost track must be found again. */
-    static const uint32_t MAX_DISTANCE = 200;
-
-    /** Period in ms for PID processing. */
-    static const uint32_t PID_PROCESS_PERIOD = 10;
-
-    SimpleTimer            m_observationTimer; /**< Observation timer to observe the max. time per challenge. */
-    SimpleTimer            m_lapTime;          /**< Timer used to calculate the lap time. */
-    SimpleTimer            m_pidProcessTime;   /**< Timer used for periodically PID processing. */
-    PIDController<int16_t> m_pidCtrl;          /**< PID controller, used for driving. */
-    int16_t                m_topSpeed;    /**< Top speed in [steps/s]. It might be lower or equal to the max. speed! */
-    LineStatus             m_lineStatus;  /**< Status of start-/end line detection */
-    TrackStatus            m_trackStatus; /**< Status of track which means on track or track lost, etc. */
-    uint8_t m_startEndLineDebounce;       /**< Counter used for easys debouncing of the start-/end line detection. */
+    SimpleTimer          m_observationTimer; /**< Observation timer to observe the max. time per challenge. */
+    SimpleTimer          m_lapTime;          /**< Timer used to calculate the lap time. */
+    LineFollowController m_lineFollowCtrl;   /**< Line follow control law, used for driving. */
+    LineStatus           m_lineStatus;       /**< Status of start-/end line detection */
+    TrackStatus          m_trackStatus;      /**< Status of track which means on track or track lost, etc. */
+    uint8_t m_startEndLineDebounce;          /**< Counter used for easys debouncing of the start-/end line detection. */
 
     /**
      * Default constructor.
@@ -137,9 +145,7 @@ private:
     DrivingState() :
         m_observationTimer(),
         m_lapTime(),
-        m_pidProcessTime(),
-        m_pidCtrl(),
-        m_topSpeed(0),
+        m_lineFollowCtrl(),
         m_lineStatus(LINE_STATUS_FIND_START_LINE),
         m_trackStatus(TRACK_STATUS_ON_TRACK),
         m_startEndLineDebounce(0)
@@ -196,7 +202,7 @@ private:
 
     /**
      * Adapt driving by using a PID algorithm, depended on the position
-     * input.
+     * input. The wheel speeds are updated every PID process cycle.
      *
      * @param[in] position  Position in digits
      */
@@ -36,6 +36,7 @@
 #include <Board.h>
 #include <StateMachine.h>
 #include "MotorSpeedCalibrationState.h"
+#include <Diagnostics.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -63,17 +64,19 @@
 
 void ErrorState::entry()
 {
-    IDisplay& display = Board::getInstance().getDisplay();
+    Diagnostics& diagnostics = Diagnostics::getInstance();
 
-    display.clear();
-    display.print("Error");
-    display.gotoXY(0, 1);
-    display.print(m_errorMsg);
+    /* The error has priority over a selected diagnostics page. */
+    diagnostics.unselectPage();
+    diagnostics.enable(Diagnostics::REFRESH_PERIOD);
+
+    showErrorMsg();
 }
 
 void ErrorState::process(StateMachine& sm)
 {
     IButton& buttonA = Board::getInstance().getButtonA();
+    IButton& buttonB = Board::getInstance().getButtonB();
 
     /* Restart calibration? */
     if (true == buttonA.isPressed())
@@ -81,11 +84,25 @@ void ErrorState::process(StateMachine& sm)
         buttonA.waitForRelease();
         sm.setState(&MotorSpeedCalibrationState::getInstance());
     }
+    /* Show next diagnostics page? */
+    else if (true == buttonB.isPressed())
+    {
+        buttonB.waitForRelease();
+
+        if (false == Diagnostics::getInstance().nextPage())
+        {
+            showErrorMsg();
+        }
+    }
+    else
+    {
+        ;
+    }
 }
 
 void ErrorState::exit()
 {
-    /* Nothing to do. */
+    Diagnostics::getInstance().disable();
 }
 
 void ErrorState::setErrorMsg(const char* msg)
@@ -109,6 +126,16 @@ void ErrorState::setErrorMsg(const char* msg)
  * Private Methods
  *****************************************************************************/
 
+void ErrorState::showErrorMsg() const
+{
+    IDisplay& display = Board::getInstance().getDisplay();
+
+    display.clear();
+    display.print(F("Error"));
+    display.gotoXY(0, 1);
+    display.print(m_errorMsg);
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
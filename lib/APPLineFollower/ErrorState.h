@@ -106,6 +106,11 @@ private:
 
     char m_errorMsg[ERROR_MSG_SIZE]; /**< Error message, which to show. */
 
+    /**
+     * Show the error message on the display.
+     */
+    void showErrorMsg() const;
+
     /**
      * Default constructor.
      */
@@ -52,6 +52,11 @@
 #include <IMotors.h>
 #include <ILed.h>
 #include <IProximitySensors.h>
+#include <IWatchdog.h>
+#include <IControlTimer.h>
+#include <IIdle.h>
+#include <IBattery.h>
+#include <ISettings.h>
 
 /******************************************************************************
  * Macros
@@ -164,6 +169,41 @@ public:
      */
     virtual IProximitySensors& getProximitySensors() = 0;
 
+    /**
+     * Get watchdog driver.
+     *
+     * @return Watchdog driver
+     */
+    virtual IWatchdog& getWatchdog() = 0;
+
+    /**
+     * Get control timer driver.
+     *
+     * @return Control timer driver
+     */
+    virtual IControlTimer& getControlTimer() = 0;
+
+    /**
+     * Get CPU idle driver.
+     *
+     * @return CPU idle driver
+     */
+    virtual IIdle& getIdle() = 0;
+
+    /**
+     * Get battery driver.
+     *
+     * @return Battery driver
+     */
+    virtual IBattery& getBattery() = 0;
+
+    /**
+     * Get non-volatile settings driver.
+     *
+     * @return Settings driver
+     */
+    virtual ISettings& getSettings() = 0;
+
 protected:
 
     /**
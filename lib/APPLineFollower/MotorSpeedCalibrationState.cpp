@@ -76,9 +76,9 @@ void MotorSpeedCalibrationState::entry()
     IDisplay& display = Board::getInstance().getDisplay();
 
     display.clear();
-    display.print("Calib");
+    display.print(F("Calib"));
     display.gotoXY(0, 1);
-    display.print("MSpeed");
+    display.print(F("MSpeed"));
 
     /* Setup relative encoders */
     m_relEncoders.clear();
@@ -54,6 +54,50 @@
  * Local Variables
  *****************************************************************************/
 
+/**
+ * Names of the parameter sets.
+ */
+static const char gParSetName0[] PROGMEM = "PID Slow";
+static const char gParSetName1[] PROGMEM = "PID Fast";
+static const char gParSetName2[] PROGMEM = "PD Fast";
+
+/**
+ * All parameter sets. They are kept in program memory and only the current
+ * selected set is copied to RAM.
+ */
+static const ParameterSets::ParameterSet gParSets[ParameterSets::MAX_SETS] PROGMEM = {
+    {
+        gParSetName0, /* Name */
+        1920,         /* Top speed in steps/s */
+        3,            /* Kp Numerator */
+        2,            /* Kp Denominator */
+        1,            /* Ki Numerator */
+        60,           /* Ki Denominator */
+        4,            /* Kd Numerator */
+        1             /* Kd Denominator */
+    },
+    {
+        gParSetName1, /* Name */
+        2400,         /* Top speed in steps/s */
+        3,            /* Kp Numerator */
+        2,            /* Kp Denominator */
+        1,            /* Ki Numerator */
+        40,           /* Ki Denominator */
+        40,           /* Kd Numerator */
+        1             /* Kd Denominator */
+    },
+    {
+        gParSetName2, /* Name */
+        2400,         /* Top speed in steps/s */
+        3,            /* Kp Numerator */
+        1,            /* Kp Denominator */
+        0,            /* Ki Numerator */
+        1,            /* Ki Denominator */
+        40,           /* Kd Numerator */
+        1             /* Kd Denominator */
+    }
+};
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -63,6 +107,7 @@ void ParameterSets::choose(uint8_t setId)
     if (MAX_SETS > setId)
     {
         m_currentSetId = setId;
+        load();
     }
 }
 
@@ -70,6 +115,7 @@ void ParameterSets::next()
 {
     ++m_currentSetId;
     m_currentSetId %= MAX_SETS;
+    load();
 }
 
 uint8_t ParameterSets::getCurrentSetId() const
@@ -79,7 +125,23 @@ uint8_t ParameterSets::getCurrentSetId() const
 
 const ParameterSets::ParameterSet& ParameterSets::getParameterSet() const
 {
-    return m_parSets[m_currentSetId];
+    return m_parSet;
+}
+
+void ParameterSets::save(Snapshot& snapshot) const
+{
+    (void)snapshot.put(m_currentSetId);
+}
+
+void ParameterSets::restore(Snapshot& snapshot)
+{
+    uint8_t setId = m_currentSetId;
+
+    /* The set itself is loaded from program memory. */
+    if (true == snapshot.get(setId))
+    {
+        choose(setId);
+    }
 }
 
 /******************************************************************************
@@ -90,46 +152,20 @@ const ParameterSets::ParameterSet& ParameterSets::getParameterSet() const
  * Private Methods
  *****************************************************************************/
 
-ParameterSets::ParameterSets() : m_currentSetId(0), m_parSets()
+ParameterSets::ParameterSets() : m_currentSetId(0), m_parSet()
 {
-    m_parSets[0] = {
-        "PID Slow", /* Name */
-        1920,       /* Top speed in steps/s */
-        3,          /* Kp Numerator */
-        2,          /* Kp Denominator */
-        1,          /* Ki Numerator */
-        60,         /* Ki Denominator */
-        4,          /* Kd Numerator */
-        1           /* Kd Denominator */
-    };
-
-    m_parSets[1] = {
-        "PID Fast", /* Name */
-        2400,       /* Top speed in steps/s */
-        3,          /* Kp Numerator */
-        2,          /* Kp Denominator */
-        1,          /* Ki Numerator */
-        40,         /* Ki Denominator */
-        40,         /* Kd Numerator */
-        1           /* Kd Denominator */
-    };
-
-    m_parSets[2] = {
-        "PD Fast", /* Name */
-        2400,      /* Top speed in steps/s */
-        3,         /* Kp Numerator */
-        1,         /* Kp Denominator */
-        0,         /* Ki Numerator */
-        1,         /* Ki Denominator */
-        40,        /* Kd Numerator */
-        1          /* Kd Denominator */
-    };
+    load();
 }
 
 ParameterSets::~ParameterSets()
 {
 }
 
+void ParameterSets::load()
+{
+    memcpy_P(&m_parSet, &gParSets[m_currentSetId], sizeof(m_parSet));
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -44,6 +44,8 @@
  * Includes
  *****************************************************************************/
 #include <stdint.h>
+#include <Arduino.h>
+#include <Snapshot.h>
 
 /******************************************************************************
  * Macros
@@ -62,7 +64,7 @@ public:
      */
     struct ParameterSet
     {
-        const char* name;          /**< Name of the parameter set */
+        const char* name;          /**< Name of the parameter set in program memory */
         int16_t     topSpeed;      /**< Top speed in steps/s */
         int16_t     kPNumerator;   /**< Kp numerator value */
         int16_t     kPDenominator; /**< Kp denominator value */
@@ -114,13 +116,27 @@ public:
      */
     const ParameterSet& getParameterSet() const;
 
+    /**
+     * Save the selected parameter set to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the selected parameter set from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
     /** Max. number of parameter sets. */
     static const uint8_t MAX_SETS = 3;
 
 protected:
 private:
-    uint8_t      m_currentSetId;      /**< Set id of current selected set. */
-    ParameterSet m_parSets[MAX_SETS]; /**< All parameter sets */
+    uint8_t      m_currentSetId; /**< Set id of current selected set. */
+    ParameterSet m_parSet;       /**< Current selected set, copied from program memory. */
 
     /**
      * Default constructor.
@@ -132,6 +148,11 @@ private:
      */
     ~ParameterSets();
 
+    /**
+     * Load the current selected set from program memory.
+     */
+    void load();
+
     /* Not allowed. */
     ParameterSets(const ParameterSets& set);            /**< Copy construction of an instance. */
     ParameterSets& operator=(const ParameterSets& set); /**< Assignment of an instance. */
@@ -36,6 +36,8 @@
 #include <Board.h>
 #include <StateMachine.h>
 #include "ReleaseTrackState.h"
+#include "SystemIdentificationState.h"
+#include <Diagnostics.h>
 #include <Logging.h>
 #include <Util.h>
 
@@ -70,18 +72,17 @@ LOG_TAG("RState");
 
 void ReadyState::entry()
 {
-    IDisplay&     display                 = Board::getInstance().getDisplay();
+    Diagnostics&  diagnostics             = Diagnostics::getInstance();
     const int32_t SENSOR_VALUE_OUT_PERIOD = 1000; /* ms */
 
-    display.clear();
-    display.print("Rdy.");
-
-    if (true == m_isLapTimeAvailable)
+    /* A selected diagnostics page is kept, otherwise the operator info is shown. */
+    if (false == diagnostics.isPageSelected())
     {
-        display.gotoXY(0, 1);
-        display.print(m_lapTime);
+        showInfo();
     }
 
+    diagnostics.enable(Diagnostics::REFRESH_PERIOD);
+
     /* The line sensor value shall be output on console cyclic. */
     m_timer.start(SENSOR_VALUE_OUT_PERIOD);
 }
@@ -89,6 +90,8 @@ void ReadyState::entry()
 void ReadyState::process(StateMachine& sm)
 {
     IButton& buttonA = Board::getInstance().getButtonA();
+    IButton& buttonB = Board::getInstance().getButtonB();
+    IButton& buttonC = Board::getInstance().getButtonC();
 
     /* Shall track be released? */
     if (true == buttonA.isPressed())
@@ -96,6 +99,22 @@ void ReadyState::process(StateMachine& sm)
         buttonA.waitForRelease();
         sm.setState(&ReleaseTrackState::getInstance());
     }
+    /* Show next diagnostics page? */
+    else if (true == buttonB.isPressed())
+    {
+        buttonB.waitForRelease();
+
+        if (false == Diagnostics::getInstance().nextPage())
+        {
+            showInfo();
+        }
+    }
+    /* Shall the system identification be started? */
+    else if (true == buttonC.isPressed())
+    {
+        buttonC.waitForRelease();
+        sm.setState(&SystemIdentificationState::getInstance());
+    }
     /* Shall the line sensor values be printed out on console? */
     else if (true == m_timer.isTimeout())
     {
@@ -112,7 +131,7 @@ void ReadyState::process(StateMachine& sm)
         {
             if (0 < index)
             {
-                LOG_DEBUG_MSG(" / ");
+                LOG_DEBUG_MSG(F(" / "));
             }
 
             Util::uintToStr(valueStr, sizeof(valueStr), sensorValues[index]);
@@ -120,7 +139,7 @@ void ReadyState::process(StateMachine& sm)
             LOG_DEBUG_MSG(valueStr);
         }
 
-        LOG_DEBUG_MSG(" -> ");
+        LOG_DEBUG_MSG(F(" -> "));
 
         Util::intToStr(valueStr, sizeof(valueStr), position);
         LOG_DEBUG_MSG(valueStr);
@@ -135,6 +154,7 @@ void ReadyState::exit()
 {
     m_timer.stop();
     m_isLapTimeAvailable = false;
+    Diagnostics::getInstance().disable();
 }
 
 void ReadyState::setLapTime(uint32_t lapTime)
@@ -143,6 +163,20 @@ void ReadyState::setLapTime(uint32_t lapTime)
     m_lapTime            = lapTime;
 }
 
+void ReadyState::save(Snapshot& snapshot) const
+{
+    m_timer.save(snapshot);
+    (void)snapshot.put(m_isLapTimeAvailable);
+    (void)snapshot.put(m_lapTime);
+}
+
+void ReadyState::restore(Snapshot& snapshot)
+{
+    m_timer.restore(snapshot);
+    (void)snapshot.get(m_isLapTimeAvailable);
+    (void)snapshot.get(m_lapTime);
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -151,6 +185,20 @@ void ReadyState::setLapTime(uint32_t lapTime)
  * Private Methods
  *****************************************************************************/
 
+void ReadyState::showInfo() const
+{
+    IDisplay& display = Board::getInstance().getDisplay();
+
+    display.clear();
+    display.print(F("Rdy."));
+
+    if (true == m_isLapTimeAvailable)
+    {
+        display.gotoXY(0, 1);
+        display.print(m_lapTime);
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include <IState.h>
 #include <SimpleTimer.h>
+#include <Snapshot.h>
 
 /******************************************************************************
  * Macros
@@ -96,12 +97,31 @@ public:
      */
     void setLapTime(uint32_t lapTime);
 
+    /**
+     * Save the ready state to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the ready state from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
 protected:
 private:
     SimpleTimer m_timer;              /**< Timer used for cyclic debug output. */
     bool        m_isLapTimeAvailable; /**< Is set (true), if a lap time is available. */
     uint32_t    m_lapTime;            /**< Lap time in ms of the last successful driven round. */
 
+    /**
+     * Show the operator information and the last lap time on the display.
+     */
+    void showInfo() const;
+
     /**
      * Default constructor.
      */
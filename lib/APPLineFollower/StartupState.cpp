@@ -74,16 +74,16 @@ void StartupState::entry()
 
     /* Show team id / team name */
     display.clear();
-    display.print(TEAM_NAME_LINE_1);
+    display.print(F(TEAM_NAME_LINE_1));
     display.gotoXY(0, 1);
-    display.print(TEAM_NAME_LINE_2);
+    display.print(F(TEAM_NAME_LINE_2));
     delay(TEAM_NAME_DURATION);
 
     /* Show operator info on LCD */
     display.clear();
-    display.print("Press A");
+    display.print(F("Press A"));
     display.gotoXY(0, 1);
-    display.print("to calib");
+    display.print(F("to calib"));
 }
 
 void StartupState::process(StateMachine& sm)
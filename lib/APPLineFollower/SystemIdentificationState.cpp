@@ -0,0 +1,261 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System identification state
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SystemIdentificationState.h"
+#include <Board.h>
+#include <DifferentialDrive.h>
+#include <StateMachine.h>
+#include <Logging.h>
+#include <Util.h>
+#include <string.h>
+#include "ReadyState.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void appendValue(char* line, size_t size, int32_t value);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Name of the step excitation signal. */
+static const char gExcitationNameStep[] PROGMEM = "Step";
+
+/** Name of the PRBS excitation signal. */
+static const char gExcitationNamePrbs[] PROGMEM = "PRBS";
+
+/** Name of the chirp excitation signal. */
+static const char gExcitationNameChirp[] PROGMEM = "Chirp";
+
+/**
+ * Names of the excitation signals in program memory, shown on the LCD.
+ */
+static const char* const gExcitationNames[SystemIdentification::EXCITATION_MAX] PROGMEM = {
+    gExcitationNameStep, gExcitationNamePrbs, gExcitationNameChirp};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SystemIdentificationState::entry()
+{
+    /* The motors are driven directly, the closed-loop control would interfere. */
+    DifferentialDrive::getInstance().disable();
+
+    m_phase = PHASE_1_SELECT;
+    showExcitation();
+    m_timer.start(SELECT_DURATION);
+}
+
+void SystemIdentificationState::process(StateMachine& sm)
+{
+    IButton& buttonA = Board::getInstance().getButtonA();
+
+    switch (m_phase)
+    {
+    case PHASE_1_SELECT:
+        /* Choose next excitation signal (round-robin) */
+        if (true == buttonA.isPressed())
+        {
+            m_excitation = static_cast<SystemIdentification::Excitation>((m_excitation + 1) %
+                                                                         SystemIdentification::EXCITATION_MAX);
+            showExcitation();
+
+            buttonA.waitForRelease();
+            m_timer.restart();
+        }
+        else if (true == m_timer.isTimeout())
+        {
+            SystemIdentification::Config config;
+
+            SystemIdentification::getDefaultConfig(config, m_excitation);
+
+            if (true == m_sysId.start(config))
+            {
+                m_timer.stop();
+                m_phase = PHASE_2_RUN;
+            }
+            else
+            {
+                sm.setState(&ReadyState::getInstance());
+            }
+        }
+        else
+        {
+            ;
+        }
+        break;
+
+    case PHASE_2_RUN:
+        if (false == m_sysId.process())
+        {
+            IDisplay& display = Board::getInstance().getDisplay();
+
+            display.gotoXY(0, 1);
+            display.print(F("Stream"));
+
+            printConfig();
+            m_streamIdx = 0U;
+            m_timer.start(STREAM_PERIOD);
+            m_phase = PHASE_3_STREAM;
+        }
+        break;
+
+    case PHASE_3_STREAM:
+        if (true == m_timer.isTimeout())
+        {
+            if (false == printNextSample())
+            {
+                sm.setState(&ReadyState::getInstance());
+            }
+            else
+            {
+                m_timer.restart();
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void SystemIdentificationState::exit()
+{
+    m_sysId.abort();
+    m_timer.stop();
+
+    DifferentialDrive::getInstance().enable();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SystemIdentificationState::showExcitation() const
+{
+    IDisplay& display = Board::getInstance().getDisplay();
+
+    display.clear();
+    display.print(F("SysId"));
+    display.gotoXY(0, 1);
+    display.print(static_cast<const __FlashStringHelper*>(pgm_read_ptr(&gExcitationNames[m_excitation])));
+}
+
+void SystemIdentificationState::printConfig() const
+{
+    const SystemIdentification::Config& config = m_sysId.getConfig();
+    char                                line[48];
+
+    /* SYSID_CFG,<excitation>,<mode>,<sample period>,<number of samples> */
+    strncpy_P(line, PSTR("SYSID_CFG"), sizeof(line));
+    appendValue(line, sizeof(line), config.excitation);
+    appendValue(line, sizeof(line), config.mode);
+    appendValue(line, sizeof(line), config.samplePeriod);
+    appendValue(line, sizeof(line), m_sysId.getNumSamples());
+
+    Logging::getOutput().println(line);
+}
+
+bool SystemIdentificationState::printNextSample()
+{
+    bool                         isPrinted = false;
+    SystemIdentification::Sample sample;
+
+    if (true == m_sysId.getSample(m_streamIdx, sample))
+    {
+        char line[48];
+
+        /* SYSID,<index>,<timestamp>,<pwm>,<delta left>,<delta right> */
+        strncpy_P(line, PSTR("SYSID"), sizeof(line));
+        appendValue(line, sizeof(line), m_streamIdx);
+        appendValue(line, sizeof(line), sample.timestamp);
+        appendValue(line, sizeof(line), sample.pwm);
+        appendValue(line, sizeof(line), sample.deltaLeft);
+        appendValue(line, sizeof(line), sample.deltaRight);
+
+        Logging::getOutput().println(line);
+
+        ++m_streamIdx;
+        isPrinted = true;
+    }
+
+    return isPrinted;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Append a comma separated value to a CSV line.
+ *
+ * @param[in,out] line  CSV line, which is always null-terminated.
+ * @param[in]     size  Size of the line buffer in byte.
+ * @param[in]     value Value to append.
+ */
+static void appendValue(char* line, size_t size, int32_t value)
+{
+    size_t length = strlen(line);
+
+    if ((length + 1U) < size)
+    {
+        line[length] = ',';
+        ++length;
+
+        Util::intToStr(&line[length], size - length, value);
+    }
+}
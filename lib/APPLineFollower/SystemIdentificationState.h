@@ -0,0 +1,170 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System identification state
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Application
+ *
+ * @{
+ */
+
+#ifndef SYSTEM_IDENTIFICATION_STATE_H
+#define SYSTEM_IDENTIFICATION_STATE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IState.h>
+#include <SimpleTimer.h>
+#include <SystemIdentification.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The system identification state. The operator selects the excitation
+ * signal, the robot drives open-loop with it and the captured samples are
+ * printed afterwards as CSV lines on the serial.
+ */
+class SystemIdentificationState : public IState
+{
+public:
+    /**
+     * Get state instance.
+     *
+     * @return State instance.
+     */
+    static SystemIdentificationState& getInstance()
+    {
+        static SystemIdentificationState instance;
+
+        /* Singleton idiom to force initialization during first usage. */
+
+        return instance;
+    }
+
+    /**
+     * If the state is entered, this method will called once.
+     */
+    void entry() final;
+
+    /**
+     * Processing the state.
+     *
+     * @param[in] sm State machine, which is calling this state.
+     */
+    void process(StateMachine& sm) final;
+
+    /**
+     * If the state is left, this method will be called once.
+     */
+    void exit() final;
+
+protected:
+private:
+    /** Identification phases */
+    enum Phase
+    {
+        PHASE_1_SELECT = 0, /**< Operator selects the excitation signal. */
+        PHASE_2_RUN,        /**< Drive with the excitation signal. */
+        PHASE_3_STREAM      /**< Print the captured samples. */
+    };
+
+    /**
+     * Duration in ms after the last button press, until the run starts.
+     */
+    static const uint32_t SELECT_DURATION = 3000;
+
+    /**
+     * Period in ms for printing one sample, which keeps the serial load low.
+     */
+    static const uint32_t STREAM_PERIOD = 10;
+
+    SimpleTimer                      m_timer;      /**< Timer for selection and streaming. */
+    Phase                            m_phase;      /**< Current phase */
+    SystemIdentification::Excitation m_excitation; /**< Selected excitation signal */
+    SystemIdentification             m_sysId;      /**< System identification */
+    uint16_t                         m_streamIdx;  /**< Index of the next sample to print. */
+
+    /**
+     * Default constructor.
+     */
+    SystemIdentificationState() :
+        m_timer(),
+        m_phase(PHASE_1_SELECT),
+        m_excitation(SystemIdentification::EXCITATION_STEP),
+        m_sysId(),
+        m_streamIdx(0U)
+    {
+    }
+
+    /**
+     * Default destructor.
+     */
+    ~SystemIdentificationState()
+    {
+    }
+
+    /* Not allowed. */
+    SystemIdentificationState(const SystemIdentificationState& state); /**< Copy construction of an instance. */
+    SystemIdentificationState& operator=(const SystemIdentificationState& state); /**< Assignment of an instance. */
+
+    /**
+     * Show selected excitation signal on LCD.
+     */
+    void showExcitation() const;
+
+    /**
+     * Print the configuration of the run as CSV line.
+     */
+    void printConfig() const;
+
+    /**
+     * Print the next captured sample as CSV line.
+     *
+     * @return If there was a sample to print, it will return true otherwise false.
+     */
+    bool printNextSample();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SYSTEM_IDENTIFICATION_STATE_H */
+/** @} */
@@ -35,10 +35,13 @@
 #include "App.h"
 #include "StartupState.h"
 #include "RemoteCtrlState.h"
+#include "SystemIdentificationState.h"
+#include "PathFollowingState.h"
 #include <Board.h>
 #include <Speedometer.h>
 #include <DifferentialDrive.h>
 #include <Odometry.h>
+#include <RobotConstants.h>
 #include <Board.h>
 #include <Util.h>
 #include <Logging.h>
@@ -61,6 +64,15 @@
 
 static void App_cmdChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData);
 static void App_motorSpeedsChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData);
+static void App_sysIdConfigChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData);
+static void App_waypointsChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData);
+static int32_t App_speedLeftGetter();
+static int32_t App_speedRightGetter();
+static void App_poseSampler();
+static int32_t App_posXGetter();
+static int32_t App_posYGetter();
+static int32_t App_orientationGetter();
+static int32_t App_mileageGetter();
 
 /******************************************************************************
  * Local Variables
@@ -69,30 +81,78 @@ static void App_motorSpeedsChannelCallback(const uint8_t* payload, const uint8_t
 /** Only in remote control state its possible to control the robot. */
 static bool gIsRemoteCtrlActive = false;
 
+/** Position x-coordinate of the telemetry snapshot [mm]. */
+static int32_t gTelemetryPosX = 0;
+
+/** Position y-coordinate of the telemetry snapshot [mm]. */
+static int32_t gTelemetryPosY = 0;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
 
 void App::setup()
 {
+    /* The channel names are kept in program memory. The SerialMuxProt server
+     * copies a name, therefore it is only temporary needed in RAM.
+     */
+    char channelName[CHANNEL_NAME_BUFFER_SIZE];
+
     Serial.begin(SERIAL_BAUDRATE);
+    /* The log messages would disturb the SerialMuxProt frames, therefore logging
+     * is disabled. If it is enabled for debugging, it doesn't block the loop.
+     */
+    Logging::setOutput(m_txQueue);
     Logging::disable();
     Board::getInstance().init();
 
     m_systemStateMachine.setState(&StartupState::getInstance());
     m_controlInterval.start(DIFFERENTIAL_DRIVE_CONTROL_PERIOD);
     m_sendLineSensorsDataInterval.start(SEND_LINE_SENSORS_DATA_PERIOD);
+    m_sendPathStatusInterval.start(SEND_PATH_STATUS_PERIOD);
 
     /* Remote control commands/responses */
-    m_smpServer.subscribeToChannel(COMMAND_CHANNEL_NAME, App_cmdChannelCallback);
-    m_smpChannelIdRemoteCtrlRsp =
-        m_smpServer.createChannel(COMMAND_RESPONSE_CHANNEL_NAME, COMMAND_RESPONSE_CHANNEL_DLC);
+    Util::copyStr(channelName, sizeof(channelName), F(COMMAND_CHANNEL_NAME));
+    m_smpServer.subscribeToChannel(channelName, App_cmdChannelCallback);
+    Util::copyStr(channelName, sizeof(channelName), F(COMMAND_RESPONSE_CHANNEL_NAME));
+    m_smpChannelIdRemoteCtrlRsp = m_smpServer.createChannel(channelName, COMMAND_RESPONSE_CHANNEL_DLC);
+
+    /* Every response answers a different request, they shall never replace each other. */
+    m_txQueue.setCoalescable(m_smpChannelIdRemoteCtrlRsp, false);
 
     /* Receiving linear motor speed left/right */
-    m_smpServer.subscribeToChannel(SPEED_SETPOINT_CHANNEL_NAME, App_motorSpeedsChannelCallback);
+    Util::copyStr(channelName, sizeof(channelName), F(SPEED_SETPOINT_CHANNEL_NAME));
+    m_smpServer.subscribeToChannel(channelName, App_motorSpeedsChannelCallback);
 
     /* Providing line sensor data */
-    m_smpChannelIdLineSensors = m_smpServer.createChannel(LINE_SENSOR_CHANNEL_NAME, LINE_SENSOR_CHANNEL_DLC);
+    Util::copyStr(channelName, sizeof(channelName), F(LINE_SENSOR_CHANNEL_NAME));
+    m_smpChannelIdLineSensors = m_smpServer.createChannel(channelName, LINE_SENSOR_CHANNEL_DLC);
+
+    /* System identification configuration and captured samples */
+    Util::copyStr(channelName, sizeof(channelName), F(SYSID_CONFIG_CHANNEL_NAME));
+    m_smpServer.subscribeToChannel(channelName, App_sysIdConfigChannelCallback);
+    Util::copyStr(channelName, sizeof(channelName), F(SYSID_DATA_CHANNEL_NAME));
+    m_smpChannelIdSysIdData = m_smpServer.createChannel(channelName, SYSID_DATA_CHANNEL_DLC);
+
+    /* Every sample frame is needed by the host, they shall never replace each other. */
+    m_txQueue.setCoalescable(m_smpChannelIdSysIdData, false);
+
+    /* Waypoint path upload and path following status */
+    Util::copyStr(channelName, sizeof(channelName), F(WAYPOINTS_CHANNEL_NAME));
+    m_smpServer.subscribeToChannel(channelName, App_waypointsChannelCallback);
+    Util::copyStr(channelName, sizeof(channelName), F(PATH_STATUS_CHANNEL_NAME));
+    m_smpChannelIdPathStatus = m_smpServer.createChannel(channelName, PATH_STATUS_CHANNEL_DLC);
+
+    /* Telemetry data frames and the schema, which describes them. */
+    Util::copyStr(channelName, sizeof(channelName), F(TELEMETRY_CHANNEL_NAME));
+    m_smpChannelIdTelemetry = m_smpServer.createChannel(channelName, TELEMETRY_CHANNEL_DLC);
+    Util::copyStr(channelName, sizeof(channelName), F(TELEMETRY_SCHEMA_CHANNEL_NAME));
+    m_smpChannelIdTelemetrySchema = m_smpServer.createChannel(channelName, TELEMETRY_SCHEMA_CHANNEL_DLC);
+
+    /* Every schema frame describes a different signal, they shall never replace each other. */
+    m_txQueue.setCoalescable(m_smpChannelIdTelemetrySchema, false);
+
+    setupTelemetry();
 }
 
 void App::loop()
@@ -110,11 +170,20 @@ void App::loop()
          */
         Odometry::getInstance().process();
 
+        /* The telemetry samples the signals synchronous to the control. */
+        sendTelemetryData();
+
         m_controlInterval.restart();
     }
 
     m_systemStateMachine.process();
 
+    /* The cancellation of a command in execution completes by returning to the remote control state. */
+    if (true == RemoteCtrlState::getInstance().isCancelRequested())
+    {
+        m_systemStateMachine.setState(&RemoteCtrlState::getInstance());
+    }
+
     /* Determine whether the robot can be remote controlled or not. */
     if (&RemoteCtrlState::getInstance() == m_systemStateMachine.getState())
     {
@@ -135,6 +204,18 @@ void App::loop()
 
     /* Send remote control command responses. */
     sendRemoteControlResponses();
+
+    /* Stream captured system identification samples. */
+    sendSystemIdentificationData();
+
+    /* Report path following progress. */
+    sendPathStatus();
+
+    /* Describe the telemetry data frames to the host. */
+    sendTelemetrySchema();
+
+    /* Send pending data without blocking. */
+    (void)m_txQueue.process(SERIAL_TX_BUDGET);
 }
 
 /******************************************************************************
@@ -147,16 +228,27 @@ void App::loop()
 
 void App::sendRemoteControlResponses()
 {
-    RemoteCtrlState::RspId remoteControlRspId = RemoteCtrlState::getInstance().getCmdRsp();
+    RemoteCtrlState&          remoteCtrlState = RemoteCtrlState::getInstance();
+    RemoteCtrlState::Response rsp;
+    bool                      isSent = true;
 
-    /* Send only on change. */
-    if (remoteControlRspId != m_lastRemoteControlRspId)
+    /* Send all pending responses. A response is kept, until it was sent. */
+    while ((true == isSent) && (true == remoteCtrlState.getResponse(rsp)))
     {
-        const CommandResponse* payload = reinterpret_cast<const CommandResponse*>(&remoteControlRspId);
+        CommandResponse payload;
 
-        (void)m_smpServer.sendData(m_smpChannelIdRemoteCtrlRsp, reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
+        payload.requestId = rsp.requestId;
+        payload.commandId = rsp.cmdId;
+        payload.response  = rsp.rspId;
+        payload.result    = rsp.result;
 
-        m_lastRemoteControlRspId = remoteControlRspId;
+        isSent = m_smpServer.sendData(m_smpChannelIdRemoteCtrlRsp, reinterpret_cast<uint8_t*>(&payload),
+                                      sizeof(payload));
+
+        if (true == isSent)
+        {
+            remoteCtrlState.removeResponse();
+        }
     }
 }
 
@@ -181,6 +273,106 @@ void App::sendLineSensorsData() const
     (void)m_smpServer.sendData(m_smpChannelIdLineSensors, reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
 }
 
+void App::sendSystemIdentificationData()
+{
+    if (0U == m_txQueue.getPendingBytes())
+    {
+        SysIdData payload;
+
+        if (true == SystemIdentificationState::getInstance().getFrame(payload))
+        {
+            (void)m_smpServer.sendData(m_smpChannelIdSysIdData, reinterpret_cast<uint8_t*>(&payload),
+                                       sizeof(payload));
+        }
+    }
+}
+
+void App::sendPathStatus()
+{
+    const PathFollower&  pathFollower = PathFollowingState::getInstance().getPathFollower();
+    PathFollower::Status status       = pathFollower.getStatus();
+    bool                 isDue        = m_sendPathStatusInterval.isTimeout();
+
+    if ((status != m_lastPathStatus) || ((PathFollower::STATUS_RUNNING == status) && (true == isDue)))
+    {
+        PathStatusData payload;
+
+        payload.status          = static_cast<uint8_t>(status);
+        payload.waypointIdx     = pathFollower.getWaypointIdx();
+        payload.numWaypoints    = pathFollower.getNumWaypoints();
+        payload.progress        = pathFollower.getProgress();
+        payload.crossTrackError = pathFollower.getCrossTrackError();
+        payload.speed           = pathFollower.getSpeed();
+
+        (void)m_smpServer.sendData(m_smpChannelIdPathStatus, reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
+
+        m_lastPathStatus = status;
+    }
+
+    if (true == isDue)
+    {
+        m_sendPathStatusInterval.restart();
+    }
+}
+
+void App::setupTelemetry()
+{
+    const int16_t STEPS_PER_MM = static_cast<int16_t>(RobotConstants::ENCODER_STEPS_PER_MM);
+
+    /* The signal names are kept in program memory. The speeds are scaled by the host from steps/s to mm/s. */
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("SPEED_L"), Telemetry::TYPE_INT16, App_speedLeftGetter, 1, STEPS_PER_MM));
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("SPEED_R"), Telemetry::TYPE_INT16, App_speedRightGetter, 1, STEPS_PER_MM));
+    (void)m_telemetry.select(m_telemetry.registerSignal(PSTR("POS_X"), Telemetry::TYPE_INT32, App_posXGetter));
+    (void)m_telemetry.select(m_telemetry.registerSignal(PSTR("POS_Y"), Telemetry::TYPE_INT32, App_posYGetter));
+    (void)m_telemetry.select(
+        m_telemetry.registerSignal(PSTR("ORIENT"), Telemetry::TYPE_INT16, App_orientationGetter));
+    (void)m_telemetry.select(m_telemetry.registerSignal(PSTR("MILEAGE"), Telemetry::TYPE_UINT32, App_mileageGetter));
+
+    /* Both coordinates are read at once per data frame. */
+    m_telemetry.setSampler(App_poseSampler);
+    m_telemetry.setDecimation(TELEMETRY_DECIMATION);
+}
+
+void App::sendTelemetryData()
+{
+    Telemetry::DataFrame frame;
+
+    if (true == m_telemetry.process(frame))
+    {
+        (void)m_smpServer.sendData(m_smpChannelIdTelemetry, reinterpret_cast<uint8_t*>(&frame), sizeof(frame));
+    }
+}
+
+void App::sendTelemetrySchema()
+{
+    bool isSynced = m_smpServer.isSynced();
+
+    /* Start over, if the host connected or the layout changed. */
+    if (((true == isSynced) && (false == m_isSmpSynced)) || (m_telemetry.getLayoutId() != m_telemetrySchemaLayoutId))
+    {
+        m_telemetrySchemaIdx      = 0U;
+        m_telemetrySchemaLayoutId = m_telemetry.getLayoutId();
+    }
+
+    m_isSmpSynced = isSynced;
+
+    if ((true == isSynced) && (m_telemetry.getNumSchemaFrames() > m_telemetrySchemaIdx) &&
+        (0U == m_txQueue.getPendingBytes()))
+    {
+        Telemetry::SchemaFrame frame;
+
+        if (true == m_telemetry.getSchemaFrame(m_telemetrySchemaIdx, frame))
+        {
+            (void)m_smpServer.sendData(m_smpChannelIdTelemetrySchema, reinterpret_cast<uint8_t*>(&frame),
+                                       sizeof(frame));
+        }
+
+        ++m_telemetrySchemaIdx;
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -192,18 +384,19 @@ void App::sendLineSensorsData() const
 /**
  * Receives remote control commands over SerialMuxProt channel.
  *
- * @param[in] payload       Command id
- * @param[in] payloadSize   Size of command id
+ * @param[in] payload       Command with request id
+ * @param[in] payloadSize   Size of command
  * @param[in] userData      User data
  */
 static void App_cmdChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData)
 {
     (void)userData;
-    if ((nullptr != payload) && (sizeof(RemoteCtrlState::CmdId) == payloadSize))
+    if ((nullptr != payload) && (COMMAND_CHANNEL_DLC == payloadSize))
     {
-        RemoteCtrlState::CmdId cmdId = *reinterpret_cast<const RemoteCtrlState::CmdId*>(payload);
+        const Command* cmd = reinterpret_cast<const Command*>(payload);
 
-        RemoteCtrlState::getInstance().execute(cmdId);
+        RemoteCtrlState::getInstance().execute(cmd->requestId, static_cast<RemoteCtrlState::CmdId>(cmd->commandId),
+                                               cmd->argument);
     }
 }
 
@@ -223,3 +416,142 @@ static void App_motorSpeedsChannelCallback(const uint8_t* payload, const uint8_t
         DifferentialDrive::getInstance().setLinearSpeed(motorSpeedData->left, motorSpeedData->right);
     }
 }
+
+/**
+ * Receives the system identification configuration over SerialMuxProt channel.
+ *
+ * @param[in] payload       System identification configuration
+ * @param[in] payloadSize   Size of the configuration
+ * @param[in] userData      User data
+ */
+static void App_sysIdConfigChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData)
+{
+    (void)userData;
+    if ((nullptr != payload) && (SYSID_CONFIG_CHANNEL_DLC == payloadSize) && (true == gIsRemoteCtrlActive))
+    {
+        const SysIdConfig*           sysIdConfig = reinterpret_cast<const SysIdConfig*>(payload);
+        SystemIdentification::Config config;
+
+        /* Out of range enumeration values are rejected by the validation before the run. */
+        config.excitation     = static_cast<SystemIdentification::Excitation>(sysIdConfig->excitation);
+        config.mode           = static_cast<SystemIdentification::Mode>(sysIdConfig->mode);
+        config.samplePeriod   = sysIdConfig->samplePeriod;
+        config.numSamples     = sysIdConfig->numSamples;
+        config.offset         = sysIdConfig->offset;
+        config.amplitude      = sysIdConfig->amplitude;
+        config.stepDelay      = sysIdConfig->stepDelay;
+        config.prbsHold       = sysIdConfig->prbsHold;
+        config.chirpFreqStart = sysIdConfig->chirpFreqStart;
+        config.chirpFreqEnd   = sysIdConfig->chirpFreqEnd;
+
+        SystemIdentificationState::getInstance().setConfig(config);
+    }
+}
+
+/**
+ * Receives the waypoints of a path over SerialMuxProt channel.
+ * A frame with total 0 clears the path and stops a running one.
+ *
+ * @param[in] payload       Waypoints
+ * @param[in] payloadSize   Size of the waypoints frame
+ * @param[in] userData      User data
+ */
+static void App_waypointsChannelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData)
+{
+    (void)userData;
+    if ((nullptr != payload) && (WAYPOINTS_CHANNEL_DLC == payloadSize))
+    {
+        const WaypointData*    waypointData = reinterpret_cast<const WaypointData*>(payload);
+        PathFollower&          pathFollower = PathFollowingState::getInstance().getPathFollower();
+        PathFollower::Waypoint waypoints[WAYPOINTS_PER_FRAME];
+        uint8_t                idx;
+
+        if (0U == waypointData->total)
+        {
+            pathFollower.clear();
+        }
+        else if (WAYPOINTS_PER_FRAME >= waypointData->count)
+        {
+            for (idx = 0U; idx < waypointData->count; ++idx)
+            {
+                waypoints[idx].xPos = waypointData->waypoints[idx].xPos;
+                waypoints[idx].yPos = waypointData->waypoints[idx].yPos;
+            }
+
+            pathFollower.setMaxSpeed(waypointData->maxSpeed);
+            (void)pathFollower.addWaypoints(waypointData->index, waypointData->total, waypoints, waypointData->count);
+        }
+        else
+        {
+            ;
+        }
+    }
+}
+
+/**
+ * Provides the linear speed left for the telemetry.
+ *
+ * @return Linear speed left [steps/s]
+ */
+static int32_t App_speedLeftGetter()
+{
+    return static_cast<int32_t>(Speedometer::getInstance().getLinearSpeedLeft());
+}
+
+/**
+ * Provides the linear speed right for the telemetry.
+ *
+ * @return Linear speed right [steps/s]
+ */
+static int32_t App_speedRightGetter()
+{
+    return static_cast<int32_t>(Speedometer::getInstance().getLinearSpeedRight());
+}
+
+/**
+ * Takes the position snapshot for the telemetry data frame.
+ */
+static void App_poseSampler()
+{
+    Odometry::getInstance().getPosition(gTelemetryPosX, gTelemetryPosY);
+}
+
+/**
+ * Provides the x-coordinate of the snapshot for the telemetry.
+ *
+ * @return x-coordinate [mm]
+ */
+static int32_t App_posXGetter()
+{
+    return gTelemetryPosX;
+}
+
+/**
+ * Provides the y-coordinate of the snapshot for the telemetry.
+ *
+ * @return y-coordinate [mm]
+ */
+static int32_t App_posYGetter()
+{
+    return gTelemetryPosY;
+}
+
+/**
+ * Provides the orientation for the telemetry.
+ *
+ * @return Orientation [mrad]
+ */
+static int32_t App_orientationGetter()
+{
+    return Odometry::getInstance().getOrientation();
+}
+
+/**
+ * Provides the mileage for the telemetry.
+ *
+ * @return Mileage [mm]
+ */
+static int32_t App_mileageGetter()
+{
+    return static_cast<int32_t>(Odometry::getInstance().getMileageCenter());
+}
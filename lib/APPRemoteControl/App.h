@@ -45,9 +45,12 @@
  *****************************************************************************/
 #include <StateMachine.h>
 #include <SimpleTimer.h>
+#include <SerialTxQueue.h>
+#include <Telemetry.h>
 #include <SerialMuxProtServer.hpp>
 #include "SerialMuxChannels.h"
 #include "RemoteCtrlState.h"
+#include "PathFollower.h"
 
 /******************************************************************************
  * Macros
@@ -68,10 +71,20 @@ public:
         m_systemStateMachine(),
         m_controlInterval(),
         m_sendLineSensorsDataInterval(),
-        m_smpServer(Serial),
+        m_sendPathStatusInterval(),
+        m_txQueue(Serial, SerialTxQueue::POLICY_COALESCE),
+        m_smpServer(m_txQueue),
         m_smpChannelIdRemoteCtrlRsp(0U),
         m_smpChannelIdLineSensors(0U),
-        m_lastRemoteControlRspId(RemoteCtrlState::RSP_ID_OK)
+        m_smpChannelIdSysIdData(0U),
+        m_smpChannelIdPathStatus(0U),
+        m_smpChannelIdTelemetry(0U),
+        m_smpChannelIdTelemetrySchema(0U),
+        m_lastPathStatus(PathFollower::STATUS_EMPTY),
+        m_telemetry(),
+        m_isSmpSynced(false),
+        m_telemetrySchemaIdx(0U),
+        m_telemetrySchemaLayoutId(0U)
     {
     }
 
@@ -96,12 +109,21 @@ private:
     /** Baudrate for Serial Communication */
     static const uint32_t SERIAL_BAUDRATE = 115200U;
 
+    /** Maximum number of bytes, which are sent to the serial driver per loop. */
+    static const size_t SERIAL_TX_BUDGET = 64U;
+
     /** Differential drive control period in ms. */
     static const uint32_t DIFFERENTIAL_DRIVE_CONTROL_PERIOD = 5;
 
     /** Sending Data period in ms. */
     static const uint32_t SEND_LINE_SENSORS_DATA_PERIOD = 20;
 
+    /** Sending path following status period in ms, while a path is followed. */
+    static const uint32_t SEND_PATH_STATUS_PERIOD = 100;
+
+    /** Number of differential drive control periods per telemetry data frame. */
+    static const uint8_t TELEMETRY_DECIMATION = 4U;
+
     /** The system state machine. */
     StateMachine m_systemStateMachine;
 
@@ -111,6 +133,16 @@ private:
     /** Timer used for sending data periodically. */
     SimpleTimer m_sendLineSensorsDataInterval;
 
+    /** Timer used for sending the path following status periodically. */
+    SimpleTimer m_sendPathStatusInterval;
+
+    /**
+     * Transmit queue between SerialMuxProt and the serial driver, which decouples
+     * the application from a slow or absent host. Only the latest frame per
+     * channel is kept.
+     */
+    SerialTxQueue m_txQueue;
+
     /**
      * SerialMuxProt Server Instance
      *
@@ -124,15 +156,39 @@ private:
     /** Channel id sending line sensors data. */
     uint8_t m_smpChannelIdLineSensors;
 
-    /** Last remote control response id */
-    RemoteCtrlState::RspId m_lastRemoteControlRspId;
+    /** Channel id sending captured system identification samples. */
+    uint8_t m_smpChannelIdSysIdData;
+
+    /** Channel id sending the path following status. */
+    uint8_t m_smpChannelIdPathStatus;
+
+    /** Channel id sending the telemetry data frames. */
+    uint8_t m_smpChannelIdTelemetry;
+
+    /** Channel id sending the telemetry schema frames. */
+    uint8_t m_smpChannelIdTelemetrySchema;
+
+    /** Last sent path following status */
+    PathFollower::Status m_lastPathStatus;
+
+    /** Composes the telemetry data frames from the registered signals. */
+    Telemetry m_telemetry;
+
+    /** Was the SerialMuxProt server synchronized with the host last loop? */
+    bool m_isSmpSynced;
+
+    /** Index of the next telemetry schema frame to send. */
+    uint8_t m_telemetrySchemaIdx;
+
+    /** Layout id of the last sent telemetry schema. */
+    uint8_t m_telemetrySchemaLayoutId;
 
     /* Not allowed. */
     App(const App& app);            /**< Copy construction of an instance. */
     App& operator=(const App& app); /**< Assignment of an instance. */
 
     /**
-     * Send remote control command responses on change.
+     * Send the pending remote control command responses.
      */
     void sendRemoteControlResponses();
 
@@ -140,6 +196,36 @@ private:
      * Send line sensors data via SerialMuxProt.
      */
     void sendLineSensorsData() const;
+
+    /**
+     * Stream the captured system identification samples via SerialMuxProt.
+     * A frame is only sent, if the transmit queue is empty, so the stream
+     * doesn't displace other data.
+     */
+    void sendSystemIdentificationData();
+
+    /**
+     * Send the path following status via SerialMuxProt on change and
+     * periodically while a path is followed.
+     */
+    void sendPathStatus();
+
+    /**
+     * Register the telemetry signals and select them for the data frame.
+     */
+    void setupTelemetry();
+
+    /**
+     * Send a telemetry data frame every n-th call.
+     * Call it once per differential drive control period.
+     */
+    void sendTelemetryData();
+
+    /**
+     * Send the telemetry schema after the host connected or the layout changed.
+     * One schema frame is sent per call, if the transmit queue is empty.
+     */
+    void sendTelemetrySchema();
 };
 
 /******************************************************************************
@@ -36,6 +36,7 @@
 #include <Board.h>
 #include <StateMachine.h>
 #include "MotorSpeedCalibrationState.h"
+#include "RemoteCtrlState.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -66,9 +67,12 @@ void ErrorState::entry()
     IDisplay& display = Board::getInstance().getDisplay();
 
     display.clear();
-    display.print("Error");
+    display.print(F("Error"));
     display.gotoXY(0, 1);
     display.print(m_errorMsg);
+
+    /* The remote commands can't be continued, the user has to recover the robot. */
+    RemoteCtrlState::getInstance().abort();
 }
 
 void ErrorState::process(StateMachine& sm)
@@ -0,0 +1,530 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Waypoint path follower
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PathFollower.h"
+#include <Arduino.h>
+#include <math.h>
+#include <DifferentialDrive.h>
+#include <RobotConstants.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int16_t toWheelSpeed(float speed, int16_t maxMotorSpeed);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+PathFollower::PathFollower() :
+    m_status(STATUS_EMPTY),
+    m_waypoints(),
+    m_speedLimits(),
+    m_numWaypoints(0U),
+    m_totalWaypoints(0U),
+    m_maxSpeedRequested(0U),
+    m_maxSpeed(0.0F),
+    m_startX(0),
+    m_startY(0),
+    m_segmentIdx(0U),
+    m_travelled(0.0F),
+    m_pathLength(0.0F),
+    m_speed(0.0F),
+    m_progress(0U),
+    m_crossTrackError(0)
+{
+}
+
+void PathFollower::clear()
+{
+    if (STATUS_RUNNING == m_status)
+    {
+        abort();
+    }
+    else
+    {
+        m_status = STATUS_EMPTY;
+    }
+
+    m_numWaypoints   = 0U;
+    m_totalWaypoints = 0U;
+}
+
+bool PathFollower::addWaypoints(uint8_t index, uint8_t total, const Waypoint* waypoints, uint8_t count)
+{
+    bool isAdded = false;
+
+    /* A new path starts with index 0 and replaces the current one. */
+    if (0U == index)
+    {
+        clear();
+        m_totalWaypoints = total;
+    }
+
+    /* Waypoints are accepted only in order and not while running. */
+    if ((STATUS_RUNNING != m_status) && (nullptr != waypoints) && (m_totalWaypoints == total) &&
+        (MAX_WAYPOINTS >= total) && (m_numWaypoints == index) && ((total - index) >= count))
+    {
+        uint8_t idx;
+
+        for (idx = 0U; idx < count; ++idx)
+        {
+            m_waypoints[index + idx] = waypoints[idx];
+        }
+
+        m_numWaypoints += count;
+
+        if (true == isPathComplete())
+        {
+            m_status = STATUS_READY;
+        }
+        else
+        {
+            m_status = STATUS_EMPTY;
+        }
+
+        isAdded = true;
+    }
+
+    return isAdded;
+}
+
+bool PathFollower::start(int32_t posX, int32_t posY)
+{
+    bool    isStarted     = false;
+    int16_t maxMotorSpeed = DifferentialDrive::getInstance().getMaxMotorSpeed(); /* [steps/s] */
+
+    /* A finished or aborted path can be started again. */
+    if ((true == isPathComplete()) && (STATUS_RUNNING != m_status) && (0 < maxMotorSpeed))
+    {
+        uint8_t segmentIdx;
+
+        m_maxSpeed = static_cast<float>(maxMotorSpeed) / static_cast<float>(RobotConstants::ENCODER_STEPS_PER_MM);
+
+        if ((0U < m_maxSpeedRequested) && (m_maxSpeed > static_cast<float>(m_maxSpeedRequested)))
+        {
+            m_maxSpeed = static_cast<float>(m_maxSpeedRequested);
+        }
+
+        m_startX          = posX;
+        m_startY          = posY;
+        m_segmentIdx      = 0U;
+        m_travelled       = 0.0F;
+        m_speed           = 0.0F;
+        m_progress        = 0U;
+        m_crossTrackError = 0;
+        m_pathLength      = 0.0F;
+
+        for (segmentIdx = 0U; segmentIdx < m_numWaypoints; ++segmentIdx)
+        {
+            m_pathLength += getSegmentLength(segmentIdx);
+        }
+
+        planSpeedProfile();
+
+        m_status  = STATUS_RUNNING;
+        isStarted = true;
+    }
+
+    return isStarted;
+}
+
+bool PathFollower::process(uint32_t period, int32_t posX, int32_t posY, int32_t orientation, int16_t& speedLeft,
+                           int16_t& speedRight)
+{
+    speedLeft  = 0;
+    speedRight = 0;
+
+    if (STATUS_RUNNING == m_status)
+    {
+        float robotX  = static_cast<float>(posX);
+        float robotY  = static_cast<float>(posY);
+        float startX  = 0.0F;
+        float startY  = 0.0F;
+        float endX    = 0.0F;
+        float endY    = 0.0F;
+        float dirX    = 0.0F;
+        float dirY    = 0.0F;
+        float length  = 0.0F;
+        float param   = 0.0F;
+        bool  isFound = false;
+
+        /* Project the robot on the current segment and switch to the next
+         * segment, as soon as the projection passed the segment end.
+         */
+        while (false == isFound)
+        {
+            getPoint(m_segmentIdx, startX, startY);
+            getPoint(m_segmentIdx + 1U, endX, endY);
+
+            dirX   = endX - startX;
+            dirY   = endY - startY;
+            length = sqrtf(dirX * dirX + dirY * dirY);
+
+            if (0.0F < length)
+            {
+                param = ((robotX - startX) * dirX + (robotY - startY) * dirY) / (length * length);
+            }
+            else
+            {
+                param = 1.0F;
+            }
+
+            if ((1.0F <= param) && ((m_segmentIdx + 1U) < m_numWaypoints))
+            {
+                m_travelled += length;
+                ++m_segmentIdx;
+            }
+            else
+            {
+                isFound = true;
+            }
+        }
+
+        if (0.0F > param)
+        {
+            param = 0.0F;
+        }
+
+        {
+            float toEndX      = endX - robotX;
+            float toEndY      = endY - robotY;
+            float distanceEnd = sqrtf(toEndX * toEndX + toEndY * toEndY);
+            bool  isLast      = ((m_segmentIdx + 1U) >= m_numWaypoints);
+
+            m_crossTrackError =
+                (0.0F < length)
+                    ? static_cast<int16_t>((dirX * (robotY - startY) - dirY * (robotX - startX)) / length)
+                    : 0;
+
+            if (0.0F < m_pathLength)
+            {
+                float travelled = m_travelled + ((1.0F < param) ? 1.0F : param) * length;
+
+                m_progress = static_cast<uint16_t>((travelled * 1000.0F) / m_pathLength);
+            }
+
+            /* Last waypoint reached? */
+            if ((true == isLast) && ((static_cast<float>(GOAL_TOLERANCE) >= distanceEnd) || (1.0F <= param)))
+            {
+                m_status   = STATUS_FINISHED;
+                m_speed    = 0.0F;
+                m_progress = 1000U;
+            }
+            else
+            {
+                float   targetX       = 0.0F;
+                float   targetY       = 0.0F;
+                float   angle         = static_cast<float>(orientation) / 1000.0F; /* [rad] */
+                float   curvature     = 0.0F;                                      /* [1/mm] */
+                float   speedLimit    = static_cast<float>(m_speedLimits[m_segmentIdx]);
+                float   maxSpeedDelta = static_cast<float>(MAX_ACCELERATION) * static_cast<float>(period) / 1000.0F;
+                float   halfWheelBase = static_cast<float>(RobotConstants::WHEEL_BASE) / 2.0F;
+                int16_t maxMotorSpeed = DifferentialDrive::getInstance().getMaxMotorSpeed();
+
+                getLookaheadPoint(param, targetX, targetY);
+
+                /* Pure pursuit: The circle through the robot position, tangent to
+                 * its heading, which hits the lookahead point.
+                 */
+                {
+                    float deltaX   = targetX - robotX;
+                    float deltaY   = targetY - robotY;
+                    float localY   = -sinf(angle) * deltaX + cosf(angle) * deltaY;
+                    float distance = deltaX * deltaX + deltaY * deltaY;
+
+                    if (0.0F < distance)
+                    {
+                        curvature = (2.0F * localY) / distance;
+                    }
+                }
+
+                /* Brake in time for the waypoint ahead. */
+                speedLimit = sqrtf(speedLimit * speedLimit + 2.0F * static_cast<float>(MAX_DECELERATION) * distanceEnd);
+
+                if (m_maxSpeed < speedLimit)
+                {
+                    speedLimit = m_maxSpeed;
+                }
+
+                if (getCurvatureSpeedLimit(fabsf(curvature)) < speedLimit)
+                {
+                    speedLimit = getCurvatureSpeedLimit(fabsf(curvature));
+                }
+
+                if (static_cast<float>(MIN_SPEED) > speedLimit)
+                {
+                    speedLimit = static_cast<float>(MIN_SPEED);
+                }
+
+                /* Accelerate smoothly, the deceleration is part of the profile. */
+                if ((m_speed + maxSpeedDelta) < speedLimit)
+                {
+                    m_speed += maxSpeedDelta;
+                }
+                else
+                {
+                    m_speed = speedLimit;
+                }
+
+                speedLeft  = toWheelSpeed(m_speed * (1.0F - curvature * halfWheelBase), maxMotorSpeed);
+                speedRight = toWheelSpeed(m_speed * (1.0F + curvature * halfWheelBase), maxMotorSpeed);
+            }
+        }
+    }
+
+    return (STATUS_RUNNING == m_status);
+}
+
+void PathFollower::abort()
+{
+    if (STATUS_RUNNING == m_status)
+    {
+        m_status = STATUS_ABORTED;
+        m_speed  = 0.0F;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void PathFollower::getPoint(uint8_t idx, float& posX, float& posY) const
+{
+    if (0U == idx)
+    {
+        posX = static_cast<float>(m_startX);
+        posY = static_cast<float>(m_startY);
+    }
+    else
+    {
+        posX = static_cast<float>(m_waypoints[idx - 1U].xPos);
+        posY = static_cast<float>(m_waypoints[idx - 1U].yPos);
+    }
+}
+
+float PathFollower::getSegmentLength(uint8_t segmentIdx) const
+{
+    float startX = 0.0F;
+    float startY = 0.0F;
+    float endX   = 0.0F;
+    float endY   = 0.0F;
+
+    getPoint(segmentIdx, startX, startY);
+    getPoint(segmentIdx + 1U, endX, endY);
+
+    return sqrtf((endX - startX) * (endX - startX) + (endY - startY) * (endY - startY));
+}
+
+float PathFollower::getCurvatureSpeedLimit(float curvature) const
+{
+    float halfWheelBase = static_cast<float>(RobotConstants::WHEEL_BASE) / 2.0F;
+    float speedLimit    = m_maxSpeed / (1.0F + curvature * halfWheelBase);
+
+    if (0.0F < curvature)
+    {
+        float lateralLimit = sqrtf(static_cast<float>(MAX_LATERAL_ACCELERATION) / curvature);
+
+        if (lateralLimit < speedLimit)
+        {
+            speedLimit = lateralLimit;
+        }
+    }
+
+    return speedLimit;
+}
+
+void PathFollower::planSpeedProfile()
+{
+    uint8_t idx;
+
+    /* Speed limit by the curvature, which pure pursuit drives to cut the
+     * corner at a waypoint: kappa = 2 * sin(turn angle / 2) / lookahead distance.
+     */
+    for (idx = 0U; idx < m_numWaypoints; ++idx)
+    {
+        float speedLimit = 0.0F;
+
+        /* The last waypoint is reached with standstill. */
+        if ((idx + 1U) < m_numWaypoints)
+        {
+            float prevX    = 0.0F;
+            float prevY    = 0.0F;
+            float currX    = 0.0F;
+            float currY    = 0.0F;
+            float nextX    = 0.0F;
+            float nextY    = 0.0F;
+            float lengthIn = getSegmentLength(idx);
+            float lengthOut = getSegmentLength(idx + 1U);
+
+            getPoint(idx, prevX, prevY);
+            getPoint(idx + 1U, currX, currY);
+            getPoint(idx + 2U, nextX, nextY);
+
+            if ((0.0F < lengthIn) && (0.0F < lengthOut))
+            {
+                float cosTurn =
+                    ((currX - prevX) * (nextX - currX) + (currY - prevY) * (nextY - currY)) / (lengthIn * lengthOut);
+                float sinHalfTurn = (1.0F > cosTurn) ? sqrtf((1.0F - cosTurn) / 2.0F) : 0.0F;
+                float curvature   = (2.0F * sinHalfTurn) / static_cast<float>(LOOKAHEAD_DISTANCE);
+
+                speedLimit = getCurvatureSpeedLimit(curvature);
+            }
+            else
+            {
+                speedLimit = m_maxSpeed;
+            }
+        }
+
+        m_speedLimits[idx] = static_cast<uint16_t>(speedLimit);
+    }
+
+    /* Backward pass: Every waypoint must allow to brake down to the speed
+     * limits of the following ones.
+     */
+    idx = m_numWaypoints;
+
+    while (1U < idx)
+    {
+        float nextLimit = static_cast<float>(m_speedLimits[idx - 1U]);
+        float reachable =
+            sqrtf(nextLimit * nextLimit + 2.0F * static_cast<float>(MAX_DECELERATION) * getSegmentLength(idx - 1U));
+
+        --idx;
+
+        if (reachable < static_cast<float>(m_speedLimits[idx - 1U]))
+        {
+            m_speedLimits[idx - 1U] = static_cast<uint16_t>(reachable);
+        }
+    }
+}
+
+void PathFollower::getLookaheadPoint(float param, float& posX, float& posY) const
+{
+    uint8_t segmentIdx = m_segmentIdx;
+    float   remaining  = static_cast<float>(LOOKAHEAD_DISTANCE);
+    float   startX     = 0.0F;
+    float   startY     = 0.0F;
+    float   endX       = 0.0F;
+    float   endY       = 0.0F;
+    float   length     = getSegmentLength(segmentIdx);
+    float   available  = (1.0F - ((1.0F < param) ? 1.0F : param)) * length;
+
+    /* Walk along the path, starting at the robot projection. */
+    while ((remaining > available) && ((segmentIdx + 1U) < m_numWaypoints))
+    {
+        remaining -= available;
+        ++segmentIdx;
+
+        length    = getSegmentLength(segmentIdx);
+        available = length;
+        param     = 0.0F;
+    }
+
+    getPoint(segmentIdx, startX, startY);
+    getPoint(segmentIdx + 1U, endX, endY);
+
+    if ((remaining >= available) || (0.0F >= length))
+    {
+        /* Lookahead point is beyond the path end. */
+        posX = endX;
+        posY = endY;
+    }
+    else
+    {
+        float ratio = param + remaining / length;
+
+        posX = startX + ratio * (endX - startX);
+        posY = startY + ratio * (endY - startY);
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Convert a wheel speed to the differential drive unit and limit it to the
+ * max. motor speed.
+ *
+ * @param[in] speed         Wheel speed [mm/s]
+ * @param[in] maxMotorSpeed Max. motor speed [steps/s]
+ *
+ * @return Wheel speed [steps/s]
+ */
+static int16_t toWheelSpeed(float speed, int16_t maxMotorSpeed)
+{
+    float stepsPerSecond = speed * static_cast<float>(RobotConstants::ENCODER_STEPS_PER_MM);
+    float maxSpeed       = static_cast<float>(maxMotorSpeed);
+
+    if (maxSpeed < stepsPerSecond)
+    {
+        stepsPerSecond = maxSpeed;
+    }
+    else if (-maxSpeed > stepsPerSecond)
+    {
+        stepsPerSecond = -maxSpeed;
+    }
+    else
+    {
+        ;
+    }
+
+    return static_cast<int16_t>(stepsPerSecond);
+}
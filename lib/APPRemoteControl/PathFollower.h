@@ -0,0 +1,323 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Waypoint path follower
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Application
+ *
+ * @{
+ */
+
+#ifndef PATH_FOLLOWER_H
+#define PATH_FOLLOWER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Follows a path of waypoints with a pure-pursuit controller.
+ *
+ * The path starts at the pose where the run is started and leads through all
+ * waypoints. Every control period the robot steers on a circle to the point,
+ * which lies the lookahead distance ahead on the path.
+ *
+ * The speed profile is planned once at start: Every waypoint gets a max.
+ * speed, derived from the curvature the robot drives around it and limited
+ * by the deceleration to the following waypoints. The last waypoint is
+ * reached with standstill. During the run the speed is additionally limited
+ * by the current curvature and the max. acceleration.
+ */
+class PathFollower
+{
+public:
+    /** Path follower status */
+    enum Status
+    {
+        STATUS_EMPTY = 0, /**< No or incomplete path. */
+        STATUS_READY,     /**< Path is complete and can be started. */
+        STATUS_RUNNING,   /**< Path is followed. */
+        STATUS_FINISHED,  /**< Last waypoint reached. */
+        STATUS_ABORTED    /**< Run was aborted. */
+    };
+
+    /** A waypoint in the odometry coordinate system. */
+    struct Waypoint
+    {
+        int16_t xPos; /**< x-coordinate [mm] */
+        int16_t yPos; /**< y-coordinate [mm] */
+    };
+
+    /** Max. number of waypoints of a path. */
+    static const uint8_t MAX_WAYPOINTS = 32U;
+
+    /** Lookahead distance of the pure-pursuit controller in mm. */
+    static const int16_t LOOKAHEAD_DISTANCE = 100;
+
+    /** Distance to the last waypoint in mm, which counts as reached. */
+    static const int16_t GOAL_TOLERANCE = 10;
+
+    /** Min. speed in mm/s, so the last waypoint is reached despite braking. */
+    static const int16_t MIN_SPEED = 30;
+
+    /** Max. acceleration in mm/s^2. */
+    static const int16_t MAX_ACCELERATION = 1000;
+
+    /** Max. deceleration in mm/s^2. */
+    static const int16_t MAX_DECELERATION = 1000;
+
+    /** Max. lateral acceleration in mm/s^2. */
+    static const int16_t MAX_LATERAL_ACCELERATION = 1500;
+
+    /**
+     * Constructs the path follower.
+     */
+    PathFollower();
+
+    /**
+     * Destroys the path follower.
+     */
+    ~PathFollower()
+    {
+    }
+
+    /**
+     * Clear the path. A run in progress is aborted.
+     */
+    void clear();
+
+    /**
+     * Add waypoints to the path. The waypoints have to be added in order,
+     * adding waypoints with index 0 starts a new path.
+     *
+     * @param[in] index     Index of the first waypoint.
+     * @param[in] total     Total number of waypoints of the path.
+     * @param[in] waypoints Waypoints
+     * @param[in] count     Number of waypoints.
+     *
+     * @return If the waypoints are added, it will return true otherwise false.
+     */
+    bool addWaypoints(uint8_t index, uint8_t total, const Waypoint* waypoints, uint8_t count);
+
+    /**
+     * Is a complete path available, which can be started?
+     *
+     * @return If a complete path is available, it will return true otherwise false.
+     */
+    bool isPathComplete() const
+    {
+        return ((0U < m_numWaypoints) && (m_totalWaypoints == m_numWaypoints));
+    }
+
+    /**
+     * Set the max. speed for the next run.
+     *
+     * @param[in] maxSpeed  Max. speed in mm/s. With 0 the calibrated max. motor speed is used.
+     */
+    void setMaxSpeed(uint16_t maxSpeed)
+    {
+        m_maxSpeedRequested = maxSpeed;
+    }
+
+    /**
+     * Start following the path from the given position.
+     *
+     * @param[in] posX  Current x-coordinate [mm]
+     * @param[in] posY  Current y-coordinate [mm]
+     *
+     * @return If the run started, it will return true otherwise false.
+     */
+    bool start(int32_t posX, int32_t posY);
+
+    /**
+     * Process the pure-pursuit controller.
+     *
+     * @param[in]  period       Calling period [ms]
+     * @param[in]  posX         Current x-coordinate [mm]
+     * @param[in]  posY         Current y-coordinate [mm]
+     * @param[in]  orientation  Current orientation [mrad]
+     * @param[out] speedLeft    Left wheel speed set point [steps/s]
+     * @param[out] speedRight   Right wheel speed set point [steps/s]
+     *
+     * @return If the run is in progress, it will return true otherwise false.
+     */
+    bool process(uint32_t period, int32_t posX, int32_t posY, int32_t orientation, int16_t& speedLeft,
+                 int16_t& speedRight);
+
+    /**
+     * Abort a run in progress.
+     */
+    void abort();
+
+    /**
+     * Get status.
+     *
+     * @return Status
+     */
+    Status getStatus() const
+    {
+        return m_status;
+    }
+
+    /**
+     * Get number of waypoints of the path.
+     *
+     * @return Number of waypoints
+     */
+    uint8_t getNumWaypoints() const
+    {
+        return m_numWaypoints;
+    }
+
+    /**
+     * Get index of the waypoint, which is approached.
+     *
+     * @return Waypoint index
+     */
+    uint8_t getWaypointIdx() const
+    {
+        /* The current segment ends at the waypoint with the same index. */
+        return m_segmentIdx;
+    }
+
+    /**
+     * Get progress along the path.
+     *
+     * @return Progress in permille of the path length.
+     */
+    uint16_t getProgress() const
+    {
+        return m_progress;
+    }
+
+    /**
+     * Get the cross-track error, which is the distance of the robot to the
+     * path. Positive if the robot is left of the path.
+     *
+     * @return Cross-track error [mm]
+     */
+    int16_t getCrossTrackError() const
+    {
+        return m_crossTrackError;
+    }
+
+    /**
+     * Get the commanded linear speed.
+     *
+     * @return Linear speed [mm/s]
+     */
+    int16_t getSpeed() const
+    {
+        return static_cast<int16_t>(m_speed);
+    }
+
+private:
+    Status   m_status;                       /**< Status */
+    Waypoint m_waypoints[MAX_WAYPOINTS];     /**< Waypoints of the path. */
+    uint16_t m_speedLimits[MAX_WAYPOINTS];   /**< Planned max. speed per waypoint [mm/s]. */
+    uint8_t  m_numWaypoints;                 /**< Number of received waypoints. */
+    uint8_t  m_totalWaypoints;               /**< Total number of waypoints of the path. */
+    uint16_t m_maxSpeedRequested;            /**< Requested max. speed [mm/s], 0 for calibrated max. speed. */
+    float    m_maxSpeed;                     /**< Max. speed of the run [mm/s]. */
+    int32_t  m_startX;                       /**< x-coordinate of the start position [mm]. */
+    int32_t  m_startY;                       /**< y-coordinate of the start position [mm]. */
+    uint8_t  m_segmentIdx;                   /**< Index of the current segment, which ends at the waypoint with the same index. */
+    float    m_travelled;                    /**< Path length of the completed segments [mm]. */
+    float    m_pathLength;                   /**< Total path length [mm]. */
+    float    m_speed;                        /**< Commanded linear speed [mm/s]. */
+    uint16_t m_progress;                     /**< Progress [permille]. */
+    int16_t  m_crossTrackError;              /**< Cross-track error [mm]. */
+
+    /* Not allowed. */
+    PathFollower(const PathFollower& follower);            /**< Copy construction of an instance. */
+    PathFollower& operator=(const PathFollower& follower); /**< Assignment of an instance. */
+
+    /**
+     * Get a point of the path. Point 0 is the start position, the following
+     * ones are the waypoints.
+     *
+     * @param[in]  idx  Point index
+     * @param[out] posX x-coordinate [mm]
+     * @param[out] posY y-coordinate [mm]
+     */
+    void getPoint(uint8_t idx, float& posX, float& posY) const;
+
+    /**
+     * Get the length of a segment.
+     *
+     * @param[in] segmentIdx    Segment index, the segment ends at point index + 1.
+     *
+     * @return Length [mm]
+     */
+    float getSegmentLength(uint8_t segmentIdx) const;
+
+    /**
+     * Get the max. speed for driving with the given curvature, considering
+     * the lateral acceleration and that the outer wheel can't exceed the
+     * max. speed.
+     *
+     * @param[in] curvature Absolute curvature [1/mm]
+     *
+     * @return Max. speed [mm/s]
+     */
+    float getCurvatureSpeedLimit(float curvature) const;
+
+    /**
+     * Plan the max. speed per waypoint.
+     */
+    void planSpeedProfile();
+
+    /**
+     * Determine the lookahead point on the path.
+     *
+     * @param[in]  param    Position of the robot projection on the current segment [0; 1].
+     * @param[out] posX     x-coordinate [mm]
+     * @param[out] posY     y-coordinate [mm]
+     */
+    void getLookaheadPoint(float param, float& posX, float& posY) const;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PATH_FOLLOWER_H */
+/** @} */
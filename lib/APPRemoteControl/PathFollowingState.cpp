@@ -0,0 +1,137 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Path following state
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PathFollowingState.h"
+#include <Board.h>
+#include <DifferentialDrive.h>
+#include <Odometry.h>
+#include <StateMachine.h>
+#include "RemoteCtrlState.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void PathFollowingState::entry()
+{
+    IDisplay& display = Board::getInstance().getDisplay();
+    int32_t   posX    = 0;
+    int32_t   posY    = 0;
+
+    display.clear();
+    display.print(F("Path"));
+
+    DifferentialDrive::getInstance().enable();
+
+    Odometry::getInstance().getPosition(posX, posY);
+
+    /* The remote control state checked that a complete path is available. */
+    (void)m_pathFollower.start(posX, posY);
+
+    m_timer.start(CONTROL_PERIOD);
+}
+
+void PathFollowingState::process(StateMachine& sm)
+{
+    if (true == m_timer.isTimeout())
+    {
+        Odometry& odometry   = Odometry::getInstance();
+        int32_t   posX       = 0;
+        int32_t   posY       = 0;
+        int16_t   speedLeft  = 0;
+        int16_t   speedRight = 0;
+        bool      isRunning  = false;
+
+        odometry.getPosition(posX, posY);
+
+        isRunning = m_pathFollower.process(CONTROL_PERIOD, posX, posY, odometry.getOrientation(), speedLeft,
+                                           speedRight);
+
+        DifferentialDrive::getInstance().setLinearSpeed(speedLeft, speedRight);
+
+        /* Finished or aborted, e.g. by uploading a new path. */
+        if (false == isRunning)
+        {
+            sm.setState(&RemoteCtrlState::getInstance());
+        }
+        else
+        {
+            m_timer.restart();
+        }
+    }
+}
+
+void PathFollowingState::exit()
+{
+    m_timer.stop();
+    m_pathFollower.abort();
+
+    DifferentialDrive::getInstance().disable();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
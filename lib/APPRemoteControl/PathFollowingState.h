@@ -0,0 +1,139 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Path following state
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Application
+ *
+ * @{
+ */
+
+#ifndef PATH_FOLLOWING_STATE_H
+#define PATH_FOLLOWING_STATE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IState.h>
+#include <SimpleTimer.h>
+#include "PathFollower.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The path following state drives the uploaded waypoint path autonomously,
+ * independent of the link latency to the host.
+ */
+class PathFollowingState : public IState
+{
+public:
+    /**
+     * Get state instance.
+     *
+     * @return State instance.
+     */
+    static PathFollowingState& getInstance()
+    {
+        static PathFollowingState instance;
+
+        /* Singleton idiom to force initialization during first usage. */
+
+        return instance;
+    }
+
+    /**
+     * If the state is entered, this method will called once.
+     */
+    void entry() final;
+
+    /**
+     * Processing the state.
+     *
+     * @param[in] sm State machine, which is calling this state.
+     */
+    void process(StateMachine& sm) final;
+
+    /**
+     * If the state is left, this method will be called once.
+     */
+    void exit() final;
+
+    /**
+     * Get the path follower, e.g. to upload a path or to report its progress.
+     *
+     * @return Path follower
+     */
+    PathFollower& getPathFollower()
+    {
+        return m_pathFollower;
+    }
+
+protected:
+private:
+    /** Path following control period in ms. */
+    static const uint32_t CONTROL_PERIOD = 10U;
+
+    SimpleTimer  m_timer;        /**< Timer for the control period. */
+    PathFollower m_pathFollower; /**< Pure-pursuit path follower */
+
+    /**
+     * Default constructor.
+     */
+    PathFollowingState() : m_timer(), m_pathFollower()
+    {
+    }
+
+    /**
+     * Default destructor.
+     */
+    ~PathFollowingState()
+    {
+    }
+
+    /* Not allowed. */
+    PathFollowingState(const PathFollowingState& state);            /**< Copy construction of an instance. */
+    PathFollowingState& operator=(const PathFollowingState& state); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PATH_FOLLOWING_STATE_H */
+/** @} */
@@ -38,6 +38,8 @@
 #include <DifferentialDrive.h>
 #include "LineSensorsCalibrationState.h"
 #include "MotorSpeedCalibrationState.h"
+#include "SystemIdentificationState.h"
+#include "PathFollowingState.h"
 
 /******************************************************************************
  * Compiler Switches
@@ -67,47 +69,163 @@ void RemoteCtrlState::entry()
 {
     DifferentialDrive::getInstance().enable();
 
-    /* It is assumed that by entering this state, that a pending command will be complete. */
-    finishCommand(RSP_ID_OK);
+    /* It is assumed that by entering this state, that a command in execution will be complete. */
+    if (true == m_isCmdActive)
+    {
+        completeCommand();
+    }
 }
 
 void RemoteCtrlState::process(StateMachine& sm)
 {
-    switch(m_cmdId)
+    /* Execute the next queued command? */
+    if ((false == m_isCmdActive) && (0U < m_cmdQueueCnt))
     {
-    case CMD_ID_IDLE:
-        /* Nothing to do. */
-        break;
+        m_activeCmd         = m_cmdQueue[m_cmdQueueIdx];
+        m_isCmdActive       = true;
+        m_isCancelRequested = false;
 
-    case CMD_ID_START_LINE_SENSOR_CALIB:
-        sm.setState(&LineSensorsCalibrationState::getInstance());
-        break;
+        m_cmdQueueIdx = (m_cmdQueueIdx + 1U) % CMD_QUEUE_SIZE;
+        --m_cmdQueueCnt;
+
+        switch (m_activeCmd.cmdId)
+        {
+        case CMD_ID_START_LINE_SENSOR_CALIB:
+            sm.setState(&LineSensorsCalibrationState::getInstance());
+            break;
+
+        case CMD_ID_START_MOTOR_SPEED_CALIB:
+            sm.setState(&MotorSpeedCalibrationState::getInstance());
+            break;
+
+        case CMD_ID_REINIT_BOARD:
+            /* Ensure that the motors are stopped, before re-initialize the board. */
+            DifferentialDrive::getInstance().setLinearSpeed(0, 0);
+
+            /* Re-initialize the board. This is required for the webots simulation in
+             * case the world is reset by a supervisor without restarting the RadonUlzer
+             * controller executable.
+             */
+            Board::getInstance().init();
+
+            finishCommand(RSP_ID_OK, 0);
+            break;
+
+        case CMD_ID_START_SYSTEM_IDENT:
+            if (true == SystemIdentificationState::getInstance().isConfigValid())
+            {
+                sm.setState(&SystemIdentificationState::getInstance());
+            }
+            else
+            {
+                finishCommand(RSP_ID_ERROR, 0);
+            }
+            break;
+
+        case CMD_ID_START_PATH:
+            if (true == PathFollowingState::getInstance().getPathFollower().isPathComplete())
+            {
+                sm.setState(&PathFollowingState::getInstance());
+            }
+            else
+            {
+                finishCommand(RSP_ID_ERROR, 0);
+            }
+            break;
 
-    case CMD_ID_START_MOTOR_SPEED_CALIB:
-        sm.setState(&MotorSpeedCalibrationState::getInstance());
+        default:
+            /* Unknown command. */
+            finishCommand(RSP_ID_ERROR, 0);
+            break;
+        }
+    }
+}
+
+void RemoteCtrlState::exit()
+{
+    DifferentialDrive::getInstance().disable();
+}
+
+void RemoteCtrlState::execute(uint8_t requestId, CmdId cmdId, uint8_t argument)
+{
+    switch (cmdId)
+    {
+    case CMD_ID_IDLE:
+        /* Nothing to do and no response. */
         break;
 
-    case CMD_ID_REINIT_BOARD:
-        /* Ensure that the motors are stopped, before re-initialize the board. */
-        DifferentialDrive::getInstance().setLinearSpeed(0, 0);
-
-        /* Re-initialize the board. This is required for the webots simulation in
-         * case the world is reset by a supervisor without restarting the RadonUlzer
-         * controller executable.
-         */
-        Board::getInstance().init();
-        
-        finishCommand(RSP_ID_OK);
+    case CMD_ID_CANCEL:
+        if (true == cancelCommand(argument))
+        {
+            addImmediateResponse(requestId, cmdId, RSP_ID_OK, argument);
+        }
+        else
+        {
+            addImmediateResponse(requestId, cmdId, RSP_ID_ERROR, argument);
+        }
         break;
 
     default:
+        /* Queue the command only, if there is room for the pending and the final response. */
+        if ((CMD_QUEUE_SIZE <= m_cmdQueueCnt) || (RSP_SLOTS_PER_CMD > getFreeResponseSlots()))
+        {
+            addImmediateResponse(requestId, cmdId, RSP_ID_REJECTED, 0);
+        }
+        else
+        {
+            Command& cmd = m_cmdQueue[(m_cmdQueueIdx + m_cmdQueueCnt) % CMD_QUEUE_SIZE];
+
+            cmd.requestId = requestId;
+            cmd.cmdId     = cmdId;
+            ++m_cmdQueueCnt;
+
+            /* The result tells the host how many further commands can be queued.
+             * The pending response uses one of the free slots, which were checked above.
+             */
+            addResponse(requestId, cmdId, RSP_ID_PENDING, static_cast<int16_t>(CMD_QUEUE_SIZE - m_cmdQueueCnt));
+        }
         break;
     }
 }
 
-void RemoteCtrlState::exit()
+void RemoteCtrlState::abort()
 {
-    DifferentialDrive::getInstance().disable();
+    if (true == m_isCmdActive)
+    {
+        finishCommand(RSP_ID_ERROR, 0);
+    }
+
+    while (0U < m_cmdQueueCnt)
+    {
+        const Command& cmd = m_cmdQueue[m_cmdQueueIdx];
+
+        addResponse(cmd.requestId, cmd.cmdId, RSP_ID_CANCELED, 0);
+
+        m_cmdQueueIdx = (m_cmdQueueIdx + 1U) % CMD_QUEUE_SIZE;
+        --m_cmdQueueCnt;
+    }
+}
+
+bool RemoteCtrlState::getResponse(Response& rsp) const
+{
+    bool isAvailable = false;
+
+    if (0U < m_rspQueueCnt)
+    {
+        rsp         = m_rspQueue[m_rspQueueIdx];
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+void RemoteCtrlState::removeResponse()
+{
+    if (0U < m_rspQueueCnt)
+    {
+        m_rspQueueIdx = (m_rspQueueIdx + 1U) % RSP_QUEUE_SIZE;
+        --m_rspQueueCnt;
+    }
 }
 
 /******************************************************************************
@@ -118,6 +236,136 @@ void RemoteCtrlState::exit()
  * Private Methods
  *****************************************************************************/
 
+void RemoteCtrlState::finishCommand(RspId rsp, int16_t result)
+{
+    addResponse(m_activeCmd.requestId, m_activeCmd.cmdId, rsp, result);
+
+    m_isCmdActive       = false;
+    m_isCancelRequested = false;
+}
+
+void RemoteCtrlState::completeCommand()
+{
+    RspId   rsp    = RSP_ID_OK;
+    int16_t result = 0;
+
+    if (true == m_isCancelRequested)
+    {
+        rsp = RSP_ID_CANCELED;
+    }
+    else
+    {
+        switch (m_activeCmd.cmdId)
+        {
+        case CMD_ID_START_LINE_SENSOR_CALIB:
+            result = static_cast<int16_t>(Board::getInstance().getLineSensors().getCalibErrorInfo());
+            break;
+
+        case CMD_ID_START_MOTOR_SPEED_CALIB:
+            result = DifferentialDrive::getInstance().getMaxMotorSpeed();
+            break;
+
+        case CMD_ID_START_PATH:
+        {
+            const PathFollower& pathFollower = PathFollowingState::getInstance().getPathFollower();
+
+            result = static_cast<int16_t>(pathFollower.getWaypointIdx());
+
+            /* The run might be aborted, e.g. by uploading a new path. */
+            if (PathFollower::STATUS_FINISHED != pathFollower.getStatus())
+            {
+                rsp = RSP_ID_ERROR;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    finishCommand(rsp, result);
+}
+
+bool RemoteCtrlState::cancelCommand(uint8_t requestId)
+{
+    bool isFound = false;
+
+    if ((true == m_isCmdActive) && (requestId == m_activeCmd.requestId))
+    {
+        /* The response follows, if the command in execution is left. */
+        m_isCancelRequested = true;
+        isFound             = true;
+    }
+    else
+    {
+        uint8_t idx = 0U;
+
+        while ((false == isFound) && (m_cmdQueueCnt > idx))
+        {
+            uint8_t pos = (m_cmdQueueIdx + idx) % CMD_QUEUE_SIZE;
+
+            if (requestId == m_cmdQueue[pos].requestId)
+            {
+                addResponse(requestId, m_cmdQueue[pos].cmdId, RSP_ID_CANCELED, 0);
+
+                /* Close the gap, to keep the order of the remaining commands. */
+                while ((m_cmdQueueCnt - 1U) > idx)
+                {
+                    uint8_t next = (pos + 1U) % CMD_QUEUE_SIZE;
+
+                    m_cmdQueue[pos] = m_cmdQueue[next];
+                    pos             = next;
+                    ++idx;
+                }
+
+                --m_cmdQueueCnt;
+                isFound = true;
+            }
+            else
+            {
+                ++idx;
+            }
+        }
+    }
+
+    return isFound;
+}
+
+uint8_t RemoteCtrlState::getFreeResponseSlots() const
+{
+    uint8_t reservedCnt = m_cmdQueueCnt;
+
+    if (true == m_isCmdActive)
+    {
+        ++reservedCnt;
+    }
+
+    return RSP_QUEUE_SIZE - m_rspQueueCnt - reservedCnt;
+}
+
+void RemoteCtrlState::addImmediateResponse(uint8_t requestId, CmdId cmdId, RspId rspId, int16_t result)
+{
+    if (0U < getFreeResponseSlots())
+    {
+        addResponse(requestId, cmdId, rspId, result);
+    }
+}
+
+void RemoteCtrlState::addResponse(uint8_t requestId, CmdId cmdId, RspId rspId, int16_t result)
+{
+    if (RSP_QUEUE_SIZE > m_rspQueueCnt)
+    {
+        Response& rsp = m_rspQueue[(m_rspQueueIdx + m_rspQueueCnt) % RSP_QUEUE_SIZE];
+
+        rsp.requestId = requestId;
+        rsp.cmdId     = cmdId;
+        rsp.rspId     = rspId;
+        rsp.result    = result;
+        ++m_rspQueueCnt;
+    }
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
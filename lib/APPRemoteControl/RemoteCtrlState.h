@@ -54,7 +54,15 @@
  * Types and Classes
  *****************************************************************************/
 
-/** The system remote control state. */
+/**
+ * The system remote control state.
+ *
+ * The remote commands are tagged with a request id by the host. They are queued
+ * and executed one after another in the order of reception, so the host can
+ * send the next commands without waiting. Every command is answered with a
+ * response, which carries the request id: first when it is queued or rejected,
+ * finally when it is completed, failed or canceled.
+ */
 class RemoteCtrlState : public IState
 {
 public:
@@ -64,19 +72,43 @@ public:
         CMD_ID_IDLE = 0,                /**< Nothing to do. */
         CMD_ID_START_LINE_SENSOR_CALIB, /**< Start line sensor calibration. */
         CMD_ID_START_MOTOR_SPEED_CALIB, /**< Start motor speed calibration. */
-        CMD_ID_REINIT_BOARD             /**< Re-initialize the board. Required for webots simulation. */
+        CMD_ID_REINIT_BOARD,            /**< Re-initialize the board. Required for webots simulation. */
+        CMD_ID_START_SYSTEM_IDENT,      /**< Start system identification with the last received configuration. */
+        CMD_ID_START_PATH,              /**< Start following the uploaded waypoint path. */
+        CMD_ID_CANCEL                   /**< Cancel the command with the request id given by the argument. */
 
     } CmdId;
 
     /** Remote control command responses. */
     typedef enum : uint8_t
     {
-        RSP_ID_OK = 0,  /**< Command successful executed. */
-        RSP_ID_PENDING, /**< Command is pending. */
-        RSP_ID_ERROR    /**< Command failed. */
+        RSP_ID_OK = 0,   /**< Command successful executed. */
+        RSP_ID_PENDING,  /**< Command is queued and pending. */
+        RSP_ID_ERROR,    /**< Command failed. */
+        RSP_ID_REJECTED, /**< Command rejected, because the command queue is full. */
+        RSP_ID_CANCELED  /**< Command canceled. */
 
     } RspId;
 
+    /** A command response. */
+    typedef struct
+    {
+        uint8_t requestId; /**< Request id of the command, given by the host. */
+        CmdId   cmdId;     /**< Command id */
+        RspId   rspId;     /**< Response id */
+        int16_t result;    /**< Command specific result */
+
+    } Response;
+
+    /** Max. number of queued commands, without the one in execution. */
+    static const uint8_t CMD_QUEUE_SIZE = 4U;
+
+    /** Number of responses per command: pending and final response. */
+    static const uint8_t RSP_SLOTS_PER_CMD = 2U;
+
+    /** Max. number of pending responses, enough for every queued command and the one in execution. */
+    static const uint8_t RSP_QUEUE_SIZE = RSP_SLOTS_PER_CMD * (CMD_QUEUE_SIZE + 1U);
+
     /**
      * Get state instance.
      *
@@ -110,38 +142,81 @@ public:
 
     /**
      * Execute command.
-     * If a command is pending, it won't be executed.
+     * The command is queued and answered with a pending response. If the queue
+     * is full or the response queue has no room for both of its responses, it
+     * will be rejected. A cancel command is handled immediately.
      *
-     * @param[in] cmdId The id of the command which to execute.
+     * @param[in] requestId The request id, given by the host.
+     * @param[in] cmdId     The id of the command which to execute.
+     * @param[in] argument  Command specific argument, e.g. the request id to cancel.
      */
-    void execute(CmdId cmdId)
-    {
-        if (CMD_ID_IDLE == m_cmdId)
-        {
-            m_cmdId = cmdId;
-            m_rspId = RSP_ID_PENDING;
-        }
-    }
+    void execute(uint8_t requestId, CmdId cmdId, uint8_t argument);
 
     /**
-     * Get command response of current command.
+     * Is the cancellation of the command in execution requested?
+     * If so, the application shall bring the state machine back to this state,
+     * which completes the cancellation.
      *
-     * @return Command response
+     * @return If cancellation is requested, it will return true otherwise false.
      */
-    RspId getCmdRsp() const
+    bool isCancelRequested() const
     {
-        return m_rspId;
+        return (true == m_isCmdActive) && (true == m_isCancelRequested);
     }
 
+    /**
+     * Abort the command in execution with an error and cancel all queued
+     * commands, e.g. if the robot runs into the error state.
+     */
+    void abort();
+
+    /**
+     * Get the oldest pending command response.
+     *
+     * @param[out] rsp  Command response
+     *
+     * @return If a response is pending, it will return true otherwise false.
+     */
+    bool getResponse(Response& rsp) const;
+
+    /**
+     * Remove the oldest pending command response, after it was sent.
+     */
+    void removeResponse();
+
 protected:
 private:
-    CmdId m_cmdId; /**< Current pending command. */
-    RspId m_rspId; /**< Current command response. */
+    /** A queued command. */
+    typedef struct
+    {
+        uint8_t requestId; /**< Request id of the command, given by the host. */
+        CmdId   cmdId;     /**< Command id */
+
+    } Command;
+
+    Command  m_cmdQueue[CMD_QUEUE_SIZE]; /**< Command queue */
+    uint8_t  m_cmdQueueIdx;              /**< Index of the oldest queued command. */
+    uint8_t  m_cmdQueueCnt;              /**< Number of queued commands. */
+    Command  m_activeCmd;                /**< Command in execution. */
+    bool     m_isCmdActive;              /**< Is a command in execution? */
+    bool     m_isCancelRequested;        /**< Is the cancellation of the command in execution requested? */
+    Response m_rspQueue[RSP_QUEUE_SIZE]; /**< Response queue */
+    uint8_t  m_rspQueueIdx;              /**< Index of the oldest pending response. */
+    uint8_t  m_rspQueueCnt;              /**< Number of pending responses. */
 
     /**
      * Default constructor.
      */
-    RemoteCtrlState() : m_cmdId(CMD_ID_IDLE), m_rspId(RSP_ID_OK)
+    RemoteCtrlState() :
+        m_cmdQueue(),
+        m_cmdQueueIdx(0U),
+        m_cmdQueueCnt(0U),
+        m_activeCmd(),
+        m_isCmdActive(false),
+        m_isCancelRequested(false),
+        m_rspQueue(),
+        m_rspQueueIdx(0U),
+        m_rspQueueCnt(0U)
     {
     }
 
@@ -158,13 +233,57 @@ private:
     /**
      * Set command response and finish the command execution.
      *
-     * @param[in] rsp   Command response
+     * @param[in] rsp       Command response
+     * @param[in] result    Command specific result
      */
-    void finishCommand(RspId rsp)
-    {
-        m_rspId = rsp;
-        m_cmdId = CMD_ID_IDLE;
-    }
+    void finishCommand(RspId rsp, int16_t result);
+
+    /**
+     * Complete the command in execution, after the state, which executed it,
+     * returned to the remote control state. The response depends on the outcome.
+     */
+    void completeCommand();
+
+    /**
+     * Cancel the command with the given request id.
+     *
+     * @param[in] requestId Request id of the command, which to cancel.
+     *
+     * @return If the command was found, it will return true otherwise false.
+     */
+    bool cancelCommand(uint8_t requestId);
+
+    /**
+     * Get the number of free slots in the response queue. The slots for the
+     * final responses of the queued commands and the one in execution are
+     * reserved and not free.
+     *
+     * @return Number of free response slots.
+     */
+    uint8_t getFreeResponseSlots() const;
+
+    /**
+     * Add a response, which answers a command immediately and has no reserved
+     * slot, e.g. a rejection. If no response slot is free, because the host
+     * doesn't read the responses, it is dropped.
+     *
+     * @param[in] requestId Request id of the command.
+     * @param[in] cmdId     Command id
+     * @param[in] rspId     Response id
+     * @param[in] result    Command specific result
+     */
+    void addImmediateResponse(uint8_t requestId, CmdId cmdId, RspId rspId, int16_t result);
+
+    /**
+     * Add a response to the response queue. Call it only with a free or a
+     * reserved response slot.
+     *
+     * @param[in] requestId Request id of the command.
+     * @param[in] cmdId     Command id
+     * @param[in] rspId     Response id
+     * @param[in] result    Command specific result
+     */
+    void addResponse(uint8_t requestId, CmdId cmdId, RspId rspId, int16_t result);
 };
 
 /******************************************************************************
@@ -37,6 +37,7 @@
  *****************************************************************************/
 
 #include <Arduino.h>
+#include <Telemetry.h>
 
 /******************************************************************************
  * Macros
@@ -45,6 +46,12 @@
 /** Maximum number of SerialMuxProt Channels. */
 #define MAX_CHANNELS (10U)
 
+/**
+ * Size of a buffer for a channel name in RAM. It considers the max. channel name
+ * length of 10 characters, given by the SerialMuxProt, and the termination.
+ */
+#define CHANNEL_NAME_BUFFER_SIZE (11U)
+
 /** Name of Channel to send Commands to. */
 #define COMMAND_CHANNEL_NAME "CMD"
 
@@ -69,6 +76,48 @@
 /** DLC of Line Sensor Channel */
 #define LINE_SENSOR_CHANNEL_DLC (sizeof(LineSensorData))
 
+/** Name of the Channel to receive the System Identification Configuration from. */
+#define SYSID_CONFIG_CHANNEL_NAME "SYSID_CFG"
+
+/** DLC of System Identification Configuration Channel */
+#define SYSID_CONFIG_CHANNEL_DLC (sizeof(SysIdConfig))
+
+/** Name of the Channel to send the captured System Identification Samples to. */
+#define SYSID_DATA_CHANNEL_NAME "SYSID"
+
+/** DLC of System Identification Data Channel */
+#define SYSID_DATA_CHANNEL_DLC (sizeof(SysIdData))
+
+/** Number of samples in one System Identification Data frame. */
+#define SYSID_SAMPLES_PER_FRAME (3U)
+
+/** Name of the Channel to receive the Waypoints of a Path from. */
+#define WAYPOINTS_CHANNEL_NAME "WAYPOINTS"
+
+/** DLC of Waypoints Channel */
+#define WAYPOINTS_CHANNEL_DLC (sizeof(WaypointData))
+
+/** Number of waypoints in one Waypoints frame. */
+#define WAYPOINTS_PER_FRAME (4U)
+
+/** Name of the Channel to send the Path Following Status to. */
+#define PATH_STATUS_CHANNEL_NAME "PATH_STAT"
+
+/** DLC of Path Following Status Channel */
+#define PATH_STATUS_CHANNEL_DLC (sizeof(PathStatusData))
+
+/** Name of the Channel to send the Telemetry Data frames to. */
+#define TELEMETRY_CHANNEL_NAME "TELEMETRY"
+
+/** DLC of Telemetry Data Channel */
+#define TELEMETRY_CHANNEL_DLC (sizeof(Telemetry::DataFrame))
+
+/** Name of the Channel to send the Telemetry Schema frames to. */
+#define TELEMETRY_SCHEMA_CHANNEL_NAME "TLM_SCHEMA"
+
+/** DLC of Telemetry Schema Channel */
+#define TELEMETRY_SCHEMA_CHANNEL_DLC (sizeof(Telemetry::SchemaFrame))
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
@@ -76,13 +125,18 @@
 /** Struct of the "Command" channel payload. */
 typedef struct _Command
 {
+    uint8_t requestId; /**< Request ID, chosen by the host and echoed in the responses */
     uint8_t commandId; /**< Command ID */
+    uint8_t argument;  /**< Command specific argument, e.g. the request ID to cancel */
 } __attribute__((packed)) Command;
 
 /** Struct of the "Command Response" channel payload. */
 typedef struct _CommandResponse
 {
-    uint8_t response; /**< Response to the command */
+    uint8_t requestId; /**< Request ID of the answered command */
+    uint8_t commandId; /**< Command ID of the answered command */
+    uint8_t response;  /**< Response to the command */
+    int16_t result;    /**< Command specific result */
 } __attribute__((packed)) CommandResponse;
 
 /** Struct of the "Speed" channel payload. */
@@ -98,6 +152,67 @@ typedef struct _LineSensorData
     uint16_t lineSensorData[5U]; /**< Line sensor data [digits] normalized to max 1000 digits. */
 } __attribute__((packed)) LineSensorData;
 
+/** Struct of the "System Identification Configuration" channel payload. */
+typedef struct _SysIdConfig
+{
+    uint8_t  excitation;     /**< Excitation signal: 0 = step, 1 = PRBS, 2 = chirp */
+    uint8_t  mode;           /**< Excited motion: 0 = linear, 1 = rotation */
+    uint16_t samplePeriod;   /**< Sample period [ms] */
+    uint16_t numSamples;     /**< Number of samples to capture */
+    int16_t  offset;         /**< PWM offset [digits] */
+    int16_t  amplitude;      /**< PWM amplitude [digits] */
+    uint16_t stepDelay;      /**< Number of samples before the step */
+    uint8_t  prbsHold;       /**< Number of samples per PRBS bit */
+    uint16_t chirpFreqStart; /**< Chirp start frequency [mHz] */
+    uint16_t chirpFreqEnd;   /**< Chirp end frequency [mHz] */
+} __attribute__((packed)) SysIdConfig;
+
+/** A captured system identification sample. */
+typedef struct _SysIdSample
+{
+    uint16_t timestamp;  /**< Time since start of the run, when the PWM was applied [ms] */
+    int16_t  pwm;        /**< Applied PWM of the left motor [digits] */
+    int16_t  deltaLeft;  /**< Left encoder steps during the sample */
+    int16_t  deltaRight; /**< Right encoder steps during the sample */
+} __attribute__((packed)) SysIdSample;
+
+/** Struct of the "System Identification Data" channel payload. */
+typedef struct _SysIdData
+{
+    uint16_t    index;                            /**< Index of the first sample in this frame */
+    uint16_t    total;                            /**< Total number of captured samples */
+    uint8_t     count;                            /**< Number of valid samples in this frame */
+    SysIdSample samples[SYSID_SAMPLES_PER_FRAME]; /**< Samples */
+} __attribute__((packed)) SysIdData;
+
+/** A waypoint of a path. */
+typedef struct _WaypointPos
+{
+    int16_t xPos; /**< X coordinate [mm] */
+    int16_t yPos; /**< Y coordinate [mm] */
+} __attribute__((packed)) WaypointPos;
+
+/** Struct of the "Waypoints" channel payload. */
+typedef struct _WaypointData
+{
+    uint8_t     index;                          /**< Index of the first waypoint in this frame, 0 starts a new path */
+    uint8_t     count;                          /**< Number of valid waypoints in this frame */
+    uint8_t     total;                          /**< Total number of waypoints of the path, 0 clears the path */
+    uint16_t    maxSpeed;                       /**< Max. speed [mm/s], 0 for the calibrated max. speed */
+    WaypointPos waypoints[WAYPOINTS_PER_FRAME]; /**< Waypoints */
+} __attribute__((packed)) WaypointData;
+
+/** Struct of the "Path Following Status" channel payload. */
+typedef struct _PathStatusData
+{
+    uint8_t  status;          /**< 0 = empty, 1 = ready, 2 = running, 3 = finished, 4 = aborted */
+    uint8_t  waypointIdx;     /**< Index of the approached waypoint */
+    uint8_t  numWaypoints;    /**< Number of waypoints of the path */
+    uint16_t progress;        /**< Progress along the path [permille] */
+    int16_t  crossTrackError; /**< Distance to the path, positive if left of it [mm] */
+    int16_t  speed;           /**< Commanded linear speed [mm/s] */
+} __attribute__((packed)) PathStatusData;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
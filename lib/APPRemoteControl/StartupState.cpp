@@ -69,9 +69,9 @@ void StartupState::entry()
     Board::getInstance().init();
 
     display.clear();
-    display.print("Remote");
+    display.print(F("Remote"));
     display.gotoXY(0, 1);
-    display.print("Ctrl");
+    display.print(F("Ctrl"));
     delay(APP_NAME_DURATION);
 }
 
@@ -0,0 +1,158 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System identification state
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SystemIdentificationState.h"
+#include <Board.h>
+#include <DifferentialDrive.h>
+#include <StateMachine.h>
+#include "RemoteCtrlState.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SystemIdentificationState::entry()
+{
+    IDisplay& display = Board::getInstance().getDisplay();
+
+    display.clear();
+    display.print(F("SysId"));
+
+    /* The motors are driven directly, the closed-loop control would interfere. */
+    DifferentialDrive::getInstance().disable();
+
+    /* Samples of a previous run are overwritten. */
+    m_isStreamPending = false;
+    m_streamIdx       = 0U;
+
+    /* The remote control state checked the configuration already. */
+    (void)m_sysId.start(m_config);
+}
+
+void SystemIdentificationState::process(StateMachine& sm)
+{
+    if (false == m_sysId.process())
+    {
+        sm.setState(&RemoteCtrlState::getInstance());
+    }
+}
+
+void SystemIdentificationState::exit()
+{
+    m_sysId.abort();
+
+    m_isStreamPending = true;
+}
+
+bool SystemIdentificationState::getFrame(SysIdData& frame)
+{
+    bool     isAvailable = false;
+    uint16_t numSamples  = m_sysId.getNumSamples();
+
+    if ((true == m_isStreamPending) && (numSamples > m_streamIdx))
+    {
+        SystemIdentification::Sample sample;
+
+        frame.index = m_streamIdx;
+        frame.total = numSamples;
+        frame.count = 0U;
+
+        while ((SYSID_SAMPLES_PER_FRAME > frame.count) && (true == m_sysId.getSample(m_streamIdx, sample)))
+        {
+            SysIdSample& dst = frame.samples[frame.count];
+
+            dst.timestamp  = sample.timestamp;
+            dst.pwm        = sample.pwm;
+            dst.deltaLeft  = sample.deltaLeft;
+            dst.deltaRight = sample.deltaRight;
+
+            ++frame.count;
+            ++m_streamIdx;
+        }
+
+        /* Unused samples shall not carry stale data. */
+        for (uint8_t idx = frame.count; idx < SYSID_SAMPLES_PER_FRAME; ++idx)
+        {
+            frame.samples[idx].timestamp  = 0U;
+            frame.samples[idx].pwm        = 0;
+            frame.samples[idx].deltaLeft  = 0;
+            frame.samples[idx].deltaRight = 0;
+        }
+
+        if (numSamples <= m_streamIdx)
+        {
+            m_isStreamPending = false;
+        }
+
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,159 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System identification state
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Application
+ *
+ * @{
+ */
+
+#ifndef SYSTEM_IDENTIFICATION_STATE_H
+#define SYSTEM_IDENTIFICATION_STATE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <IState.h>
+#include <SystemIdentification.h>
+#include "SerialMuxChannels.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The system identification state drives the motors open-loop with the
+ * configured excitation. The captured samples are provided afterwards
+ * frame by frame for streaming.
+ */
+class SystemIdentificationState : public IState
+{
+public:
+    /**
+     * Get state instance.
+     *
+     * @return State instance.
+     */
+    static SystemIdentificationState& getInstance()
+    {
+        static SystemIdentificationState instance;
+
+        /* Singleton idiom to force initialization during first usage. */
+
+        return instance;
+    }
+
+    /**
+     * If the state is entered, this method will called once.
+     */
+    void entry() final;
+
+    /**
+     * Processing the state.
+     *
+     * @param[in] sm State machine, which is calling this state.
+     */
+    void process(StateMachine& sm) final;
+
+    /**
+     * If the state is left, this method will be called once.
+     */
+    void exit() final;
+
+    /**
+     * Set the configuration for the next run.
+     *
+     * @param[in] config    Configuration
+     */
+    void setConfig(const SystemIdentification::Config& config)
+    {
+        m_config = config;
+    }
+
+    /**
+     * Is the configuration for the next run valid?
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    bool isConfigValid() const
+    {
+        return SystemIdentification::isValid(m_config);
+    }
+
+    /**
+     * Get the next frame of captured samples, which was not streamed yet.
+     *
+     * @param[out] frame    Frame with samples.
+     *
+     * @return If a frame is available, it will return true otherwise false.
+     */
+    bool getFrame(SysIdData& frame);
+
+protected:
+private:
+    SystemIdentification         m_sysId;     /**< System identification */
+    SystemIdentification::Config m_config;    /**< Configuration for the next run. */
+    uint16_t                     m_streamIdx; /**< Index of the next sample to stream. */
+    bool                         m_isStreamPending; /**< Are there captured samples to stream? */
+
+    /**
+     * Default constructor.
+     */
+    SystemIdentificationState() : m_sysId(), m_config(), m_streamIdx(0U), m_isStreamPending(false)
+    {
+        SystemIdentification::getDefaultConfig(m_config, SystemIdentification::EXCITATION_STEP);
+    }
+
+    /**
+     * Default destructor.
+     */
+    ~SystemIdentificationState()
+    {
+    }
+
+    /* Not allowed. */
+    SystemIdentificationState(const SystemIdentificationState& state); /**< Copy construction of an instance. */
+    SystemIdentificationState& operator=(const SystemIdentificationState& state); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SYSTEM_IDENTIFICATION_STATE_H */
+/** @} */
@@ -45,7 +45,11 @@
 #include <webots/Robot.hpp>
 #include <Keyboard.h>
 #include "SocketServer.h"
+#include "SessionRecorder.h"
+#include "SessionReplay.h"
+#include "Checkpoint.h"
 #include <getopt.h>
+#include <stdlib.h>
 #include <Logging.h>
 
 #endif
@@ -70,6 +74,11 @@ typedef struct
     const char* socketServerPort;   /**< Socket server port */
     const char* robotName;          /**< Robot name */
     bool        isSerialOverSocket; /**< Is serial communication over socket? */
+    const char* sessionRecordFile;  /**< File to record the host session to or nullptr */
+    const char* sessionReplayFile;  /**< File to replay the host session from or nullptr */
+    const char* checkpointSaveFile; /**< File to save the checkpoint to or nullptr */
+    uint32_t    checkpointTime;     /**< Simulation time of the checkpoint to save in [ms] */
+    const char* checkpointLoadFile; /**< File to continue the run from or nullptr */
     bool        verbose;            /**< Show verbose information */
 
 } PrgArguments;
@@ -165,6 +174,13 @@ extern unsigned long millis()
     return (now * 1000UL) / CLOCKS_PER_SEC;
 }
 
+extern unsigned long micros()
+{
+    clock_t now = clock();
+
+    return (now * 1000000UL) / CLOCKS_PER_SEC;
+}
+
 extern void delay(unsigned long ms)
 {
     unsigned long timestamp = millis();
@@ -182,7 +198,11 @@ extern int main(int argc, char** argv)
     int          status   = 0;
     Keyboard&    keyboard = Board::getInstance().getKeyboard();
     PrgArguments prgArguments;
-    SocketServer socketStream;
+    SocketServer    socketStream;
+    SessionRecorder sessionRecorder(socketStream);
+    SessionReplay   sessionReplay;
+    bool            isReplay   = false;
+    Checkpoint&     checkpoint = Checkpoint::getInstance();
 
     printf("\n*** Radon Ulzer ***\n");
 
@@ -220,11 +240,62 @@ extern int main(int argc, char** argv)
             }
         }
 
+        /* Record the session with the host? */
+        if ((0 == status) && (nullptr != prgArguments.sessionRecordFile))
+        {
+            if (false == sessionRecorder.open(prgArguments.sessionRecordFile))
+            {
+                printf("Error opening session record file %s.\n", prgArguments.sessionRecordFile);
+                status = -1;
+            }
+            else
+            {
+                Serial.setStream(sessionRecorder);
+            }
+        }
+
+        /* Replay a recorded session instead of the host? */
+        if ((0 == status) && (nullptr != prgArguments.sessionReplayFile))
+        {
+            if (false == sessionReplay.load(prgArguments.sessionReplayFile))
+            {
+                printf("Error loading session replay file %s.\n", prgArguments.sessionReplayFile);
+                status = -1;
+            }
+            else
+            {
+                Serial.setStream(sessionReplay);
+                Logging::disable();
+                isReplay = true;
+            }
+        }
+
         if (0 == status)
         {
             /* Get simulation time handler. It will be used by millis() and delay(). */
             gSimTime = &Board::getInstance().getSimTime();
         }
+
+        /* Continue a checkpointed run? Its virtual clock is set before any timestamp is taken. */
+        if ((0 == status) && (nullptr != prgArguments.checkpointLoadFile))
+        {
+            uint32_t timestamp = 0U;
+
+            if (false == checkpoint.load(prgArguments.checkpointLoadFile, timestamp))
+            {
+                printf("Error loading checkpoint file %s.\n", prgArguments.checkpointLoadFile);
+                status = -1;
+            }
+            else
+            {
+                gSimTime->setElapsedTimeSinceReset(timestamp);
+            }
+        }
+
+        if ((0 == status) && (nullptr != prgArguments.checkpointSaveFile))
+        {
+            checkpoint.requestSave(prgArguments.checkpointSaveFile, prgArguments.checkpointTime);
+        }
     }
 
     if (0 != status)
@@ -261,11 +332,34 @@ extern int main(int argc, char** argv)
         {
             setup();
 
-            while (true == gSimTime->step())
+            /* The application state is restored after the setup, which overwrites it. */
+            if ((nullptr != prgArguments.checkpointLoadFile) && (false == checkpoint.restore()))
             {
+                status = -1;
+            }
+
+            while ((0 == status) && (true == gSimTime->step()))
+            {
+                /* The session bytes get the time of the application loop. */
+                sessionRecorder.process(millis());
+                sessionReplay.process(millis());
+
                 keyboard.getPressedButtons();
                 loop();
                 socketStream.process();
+                checkpoint.process(millis());
+
+                if ((true == isReplay) && (true == sessionReplay.isFinished()))
+                {
+                    break;
+                }
+            }
+
+            sessionRecorder.close();
+
+            if ((true == isReplay) && (false == sessionReplay.report()))
+            {
+                status = 1;
             }
         }
     }
@@ -278,6 +372,11 @@ extern unsigned long millis()
     return gSimTime->getElapsedTimeSinceReset();
 }
 
+extern unsigned long micros()
+{
+    return gSimTime->getElapsedTimeSinceReset() * 1000UL;
+}
+
 extern void delay(unsigned long ms)
 {
     unsigned long timestamp = millis();
@@ -308,7 +407,7 @@ extern void delay(unsigned long ms)
 static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char** argv)
 {
     int         status           = 0;
-    const char* availableOptions = "p:n:hs";
+    const char* availableOptions = "p:n:r:R:c:t:C:hs";
     const char* programName      = argv[0];
     int         option           = getopt(argc, argv, availableOptions);
 
@@ -317,6 +416,11 @@ static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char
     prgArguments.robotName          = PRG_ARG_ROBOT_NAME_DEFAULT;
     prgArguments.verbose            = PRG_ARG_VERBOSE_DEFAULT;
     prgArguments.isSerialOverSocket = PRG_ARG_IS_SERIAL_OVER_SOCKET_DEFAULT;
+    prgArguments.sessionRecordFile  = nullptr;
+    prgArguments.sessionReplayFile  = nullptr;
+    prgArguments.checkpointSaveFile = nullptr;
+    prgArguments.checkpointTime     = 0U;
+    prgArguments.checkpointLoadFile = nullptr;
 
     while ((-1 != option) && (0 == status))
     {
@@ -334,6 +438,26 @@ static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char
             prgArguments.isSerialOverSocket = true;
             break;
 
+        case 'r': /* Record session */
+            prgArguments.sessionRecordFile = optarg;
+            break;
+
+        case 'R': /* Replay session */
+            prgArguments.sessionReplayFile = optarg;
+            break;
+
+        case 'c': /* Save checkpoint */
+            prgArguments.checkpointSaveFile = optarg;
+            break;
+
+        case 't': /* Checkpoint time */
+            prgArguments.checkpointTime = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'C': /* Continue from checkpoint */
+            prgArguments.checkpointLoadFile = optarg;
+            break;
+
         case 'v': /* Verbose */
             prgArguments.verbose = true;
             break;
@@ -352,6 +476,20 @@ static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char
         option = getopt(argc, argv, availableOptions);
     }
 
+    /* A session can only be recorded from the socket. */
+    if ((0 == status) && (nullptr != prgArguments.sessionRecordFile) && (false == prgArguments.isSerialOverSocket))
+    {
+        printf("Session recording requires serial over socket.\n");
+        status = -1;
+    }
+
+    /* The session replay replaces the socket. */
+    if ((0 == status) && (nullptr != prgArguments.sessionReplayFile) && (true == prgArguments.isSerialOverSocket))
+    {
+        printf("Session replay excludes serial over socket.\n");
+        status = -1;
+    }
+
     /* Does the user need help? */
     if (0 > status)
     {
@@ -361,6 +499,11 @@ static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char
         printf("\t-p <PORT NUMBER>\tSet SocketServer port.");         /* SocketServer Port */
         printf(" Default: %s\n", PRG_ARG_SOCKET_SERVER_PORT_DEFAULT); /* SocketServer port default value */
         printf("\t-s\t\t\tEnable serial over socket.\n");             /* Flag */
+        printf("\t-r <FILE>\t\tRecord the session over socket.\n");    /* Session record file */
+        printf("\t-R <FILE>\t\tReplay a recorded session.\n");         /* Session replay file */
+        printf("\t-c <FILE>\t\tSave a checkpoint of the run.\n");      /* Checkpoint save file */
+        printf("\t-t <MS>\t\t\tSimulation time of the checkpoint.\n"); /* Checkpoint time */
+        printf("\t-C <FILE>\t\tContinue the run from a checkpoint.\n"); /* Checkpoint load file */
         printf("\t-v\t\t\tVerbose mode.\n");                          /* Flag */
     }
 
@@ -377,6 +520,11 @@ static void showPrgArguments(const PrgArguments& prgArgs)
     printf("Robot name        : %s\n", prgArgs.robotName);
     printf("SocketServer Port : %s\n", prgArgs.socketServerPort);
     printf("Serial over socket: %s\n", (false == prgArgs.isSerialOverSocket) ? "disabled" : "enabled");
+    printf("Session record    : %s\n", (nullptr == prgArgs.sessionRecordFile) ? "-" : prgArgs.sessionRecordFile);
+    printf("Session replay    : %s\n", (nullptr == prgArgs.sessionReplayFile) ? "-" : prgArgs.sessionReplayFile);
+    printf("Checkpoint save   : %s\n", (nullptr == prgArgs.checkpointSaveFile) ? "-" : prgArgs.checkpointSaveFile);
+    printf("Checkpoint time   : %u ms\n", prgArgs.checkpointTime);
+    printf("Checkpoint load   : %s\n", (nullptr == prgArgs.checkpointLoadFile) ? "-" : prgArgs.checkpointLoadFile);
     /* Skip verbose flag. */
 }
 
@@ -59,12 +59,44 @@
 #define PSTR
 #endif
 
+/*
+ * There is no separate program memory on the native platform. Flash strings
+ * and tables are plain pointers and are read directly.
+ */
+
+/** Place data in program memory. */
+#define PROGMEM
+
+/** String literal in program memory. */
+#define F(_str) (_str)
+
+/** Read a byte from program memory. */
+#define pgm_read_byte(_addr) (*reinterpret_cast<const uint8_t*>(_addr))
+
+/** Read a word from program memory. */
+#define pgm_read_word(_addr) (*reinterpret_cast<const uint16_t*>(_addr))
+
+/** Read a pointer from program memory. */
+#define pgm_read_ptr(_addr) (*reinterpret_cast<const void* const*>(_addr))
+
+/** Get the length of a string in program memory. */
+#define strlen_P strlen
+
+/** Copy a string from program memory. */
+#define strncpy_P strncpy
+
+/** Copy data from program memory. */
+#define memcpy_P memcpy
+
 #define PI  M_PI
 
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
 
+/** Type of a string in program memory, used to select the flash aware overloads. */
+class __FlashStringHelper;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
@@ -76,6 +108,14 @@
  */
 extern unsigned long millis();
 
+/**
+ * Returns the number of microseconds passed since the system start.
+ * In the simulation the resolution is limited to the simulation time step.
+ * 
+ * @return The number of microseconds.
+ */
+extern unsigned long micros();
+
 /**
  * Delays the program for the specified amount of milliseconds. In the mean time the 
  * simulation still steps to prevent an endless loop.
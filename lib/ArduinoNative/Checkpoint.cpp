@@ -0,0 +1,196 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Checkpoint, which saves and restores a run of the simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Checkpoint.h"
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void Checkpoint::setCallbacks(Callback saveCallback, Callback restoreCallback, void* userData)
+{
+    m_saveCallback    = saveCallback;
+    m_restoreCallback = restoreCallback;
+    m_userData        = userData;
+}
+
+void Checkpoint::requestSave(const char* fileName, uint32_t timestamp)
+{
+    m_saveFileName  = fileName;
+    m_saveTimestamp = timestamp;
+}
+
+bool Checkpoint::load(const char* fileName, uint32_t& timestamp)
+{
+    bool  isSuccessful = false;
+    FILE* file         = (nullptr != fileName) ? fopen(fileName, "rb") : nullptr;
+
+    if (nullptr != file)
+    {
+        uint8_t data[Snapshot::MAX_SIZE];
+        size_t  size        = fread(data, 1U, sizeof(data), file);
+        bool    isTruncated = (sizeof(data) == size) && (EOF != fgetc(file));
+
+        /* A file, which exceeds the snapshot capacity, would be restored truncated.
+         * The virtual clock is the first entry.
+         */
+        if ((0 == ferror(file)) && (false == isTruncated) && (true == m_snapshot.load(data, size)) &&
+            (true == m_snapshot.get(timestamp)))
+        {
+            isSuccessful = true;
+        }
+
+        (void)fclose(file);
+    }
+
+    if (false == isSuccessful)
+    {
+        printf("Invalid checkpoint file.\n");
+    }
+
+    return isSuccessful;
+}
+
+bool Checkpoint::restore()
+{
+    bool isSuccessful = false;
+
+    if (nullptr == m_restoreCallback)
+    {
+        printf("The application doesn't support checkpoints.\n");
+    }
+    else if ((true == m_restoreCallback(m_snapshot, m_userData)) && (true == m_snapshot.isValid()) &&
+             (0U == m_snapshot.getUnreadSize()))
+    {
+        /* Every byte was consumed, so the checkpoint fits to the application. */
+        isSuccessful = true;
+    }
+    else
+    {
+        printf("Restoring the checkpoint failed.\n");
+    }
+
+    return isSuccessful;
+}
+
+void Checkpoint::process(uint32_t timestamp)
+{
+    if ((nullptr != m_saveFileName) && (m_saveTimestamp <= timestamp))
+    {
+        if (true == save(timestamp))
+        {
+            printf("Checkpoint saved at %u ms to %s.\n", timestamp, m_saveFileName);
+        }
+        else
+        {
+            printf("Saving the checkpoint to %s failed.\n", m_saveFileName);
+        }
+
+        /* Only one checkpoint per run. */
+        m_saveFileName = nullptr;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+Checkpoint::Checkpoint() :
+    m_snapshot(),
+    m_saveCallback(nullptr),
+    m_restoreCallback(nullptr),
+    m_userData(nullptr),
+    m_saveFileName(nullptr),
+    m_saveTimestamp(0U)
+{
+}
+
+Checkpoint::~Checkpoint()
+{
+}
+
+bool Checkpoint::save(uint32_t timestamp)
+{
+    bool isSuccessful = false;
+
+    m_snapshot.clear();
+
+    /* The virtual clock is the first entry, followed by the application state. */
+    if ((nullptr != m_saveCallback) && (true == m_snapshot.put(timestamp)) &&
+        (true == m_saveCallback(m_snapshot, m_userData)))
+    {
+        FILE* file = fopen(m_saveFileName, "wb");
+
+        if (nullptr != file)
+        {
+            isSuccessful = (m_snapshot.getSize() == fwrite(m_snapshot.getData(), 1U, m_snapshot.getSize(), file));
+            (void)fclose(file);
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
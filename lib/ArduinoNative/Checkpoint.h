@@ -0,0 +1,174 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Checkpoint, which saves and restores a run of the simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <Snapshot.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The checkpoint saves the virtual clock and the application state to a file
+ * at a given simulation time. Another simulation process continues the run
+ * from this file, e.g. to fork many variants from the same instant.
+ *
+ * The application registers its snapshot callbacks. Without them, no
+ * checkpoint can be saved or restored.
+ */
+class Checkpoint
+{
+public:
+    /**
+     * Callback, which saves or restores the application state.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] userData  User data
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    typedef bool (*Callback)(Snapshot& snapshot, void* userData);
+
+    /**
+     * Get the checkpoint instance.
+     *
+     * @return Checkpoint
+     */
+    static Checkpoint& getInstance()
+    {
+        static Checkpoint instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Set the callbacks of the application.
+     *
+     * @param[in] saveCallback      Callback, which saves the application state.
+     * @param[in] restoreCallback   Callback, which restores the application state.
+     * @param[in] userData          User data, which is passed to the callbacks.
+     */
+    void setCallbacks(Callback saveCallback, Callback restoreCallback, void* userData);
+
+    /**
+     * Request to save a checkpoint at the given simulation time.
+     *
+     * @param[in] fileName  Name of the checkpoint file
+     * @param[in] timestamp Simulation time in [ms]
+     */
+    void requestSave(const char* fileName, uint32_t timestamp);
+
+    /**
+     * Load a checkpoint file and get its virtual clock. The application
+     * state is restored later by restore(). A file, which exceeds the
+     * snapshot capacity, is rejected.
+     *
+     * @param[in]  fileName  Name of the checkpoint file
+     * @param[out] timestamp Simulation time of the checkpoint in [ms]
+     *
+     * @return If successful loaded, it will return true otherwise false.
+     */
+    bool load(const char* fileName, uint32_t& timestamp);
+
+    /**
+     * Restore the application state of the loaded checkpoint.
+     * Call it once after the application setup. It fails, if the application
+     * doesn't consume the whole checkpoint.
+     *
+     * @return If successful restored, it will return true otherwise false.
+     */
+    bool restore();
+
+    /**
+     * Save the checkpoint, if its simulation time is reached.
+     * Call it after the application loop.
+     *
+     * @param[in] timestamp Simulation time in [ms]
+     */
+    void process(uint32_t timestamp);
+
+private:
+    Snapshot    m_snapshot;        /**< Snapshot of the checkpoint */
+    Callback    m_saveCallback;    /**< Callback, which saves the application state */
+    Callback    m_restoreCallback; /**< Callback, which restores the application state */
+    void*       m_userData;        /**< User data of the callbacks */
+    const char* m_saveFileName;    /**< Name of the checkpoint file to save or nullptr */
+    uint32_t    m_saveTimestamp;   /**< Simulation time of the checkpoint to save in [ms] */
+
+    /**
+     * Constructs the checkpoint.
+     */
+    Checkpoint();
+
+    /**
+     * Destroys the checkpoint.
+     */
+    ~Checkpoint();
+
+    /* Not allowed. */
+    Checkpoint(const Checkpoint& checkpoint);            /**< Copy construction of an instance. */
+    Checkpoint& operator=(const Checkpoint& checkpoint); /**< Assignment of an instance. */
+
+    /**
+     * Save the checkpoint to the file.
+     *
+     * @param[in] timestamp Simulation time in [ms]
+     *
+     * @return If successful saved, it will return true otherwise false.
+     */
+    bool save(uint32_t timestamp);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* CHECKPOINT_H */
+/** @} */
@@ -34,6 +34,7 @@
  *****************************************************************************/
 
 #include "Serial.h"
+#include <limits.h>
 
 /******************************************************************************
  * Macros
@@ -55,7 +56,7 @@
  * Public Methods
  *****************************************************************************/
 
-Serial_::Serial_(Stream& stream) : Stream(), m_stream(&stream)
+Serial_::Serial_(Stream& stream) : Stream(), m_stream(&stream), m_txSpace(TX_SPACE_UNLIMITED)
 {
 }
 
@@ -149,7 +150,51 @@ void Serial_::println(int32_t value)
 
 size_t Serial_::write(const uint8_t* buffer, size_t length)
 {
-    return m_stream->write(buffer, length);
+    size_t written = 0U;
+
+    if (TX_SPACE_UNLIMITED == m_txSpace)
+    {
+        written = m_stream->write(buffer, length);
+    }
+    else
+    {
+        if (static_cast<size_t>(m_txSpace) < length)
+        {
+            length = static_cast<size_t>(m_txSpace);
+        }
+
+        if (0U < length)
+        {
+            written = m_stream->write(buffer, length);
+            m_txSpace -= static_cast<int>(written);
+        }
+    }
+
+    return written;
+}
+
+int Serial_::availableForWrite() const
+{
+    int space = m_txSpace;
+
+    if (TX_SPACE_UNLIMITED == m_txSpace)
+    {
+        space = INT_MAX;
+    }
+
+    return space;
+}
+
+void Serial_::setTxSpace(int space)
+{
+    if (0 > space)
+    {
+        m_txSpace = TX_SPACE_UNLIMITED;
+    }
+    else
+    {
+        m_txSpace = space;
+    }
 }
 
 int Serial_::available() const
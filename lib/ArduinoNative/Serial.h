@@ -58,6 +58,9 @@
 class Serial_ : public Stream
 {
 public:
+    /** Transmit space value, which means the transmit space is unlimited. */
+    static const int TX_SPACE_UNLIMITED = -1;
+
     /**
      * Construct Serial_.
      *
@@ -204,6 +207,22 @@ public:
      */
     size_t write(const uint8_t* buffer, size_t length) final;
 
+    /**
+     * Get number of bytes, which can be written without blocking.
+     * If the transmit space is unlimited, the maximum int value is returned.
+     *
+     * @returns Number of bytes, which can be written.
+     */
+    int availableForWrite() const;
+
+    /**
+     * Set the transmit space to emulate a slow or stalled host, like the USB CDC
+     * on the target. Every write consumes the space, data beyond it is not accepted.
+     *
+     * @param[in] space Transmit space in byte or TX_SPACE_UNLIMITED.
+     */
+    void setTxSpace(int space);
+
     /**
      * Check if there are available bytes in the Stream.
      *
@@ -227,6 +246,11 @@ private:
      */
     Stream* m_stream;
 
+    /**
+     * Emulated transmit space in byte or TX_SPACE_UNLIMITED.
+     */
+    int m_txSpace;
+
     /* Prevent empty constructor*/
     Serial_();
 };
@@ -0,0 +1,287 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Session recorder, which records the serial communication with the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SessionRecorder.h"
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SessionRecorder::SessionRecorder(Stream& stream) :
+    Stream(),
+    m_stream(stream),
+    m_file(nullptr),
+    m_timestamp(0U),
+    m_pendingDirection(DIRECTION_INBOUND),
+    m_pendingData(),
+    m_pendingLength(0U)
+{
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+bool SessionRecorder::open(const char* fileName)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if (nullptr != fileName)
+    {
+        m_file = fopen(fileName, "wb");
+
+        if (nullptr != m_file)
+        {
+            FileHeader header;
+
+            header.magic    = MAGIC;
+            header.version  = VERSION;
+            header.reserved = 0U;
+
+            if (1U == fwrite(&header, sizeof(header), 1U, m_file))
+            {
+                isSuccessful = true;
+            }
+            else
+            {
+                close();
+            }
+        }
+    }
+
+    return isSuccessful;
+}
+
+void SessionRecorder::close()
+{
+    if (nullptr != m_file)
+    {
+        flush();
+        (void)fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void SessionRecorder::process(uint32_t timestamp)
+{
+    /* Bytes of different times are never merged. */
+    if (m_timestamp != timestamp)
+    {
+        flush();
+        m_timestamp = timestamp;
+    }
+}
+
+void SessionRecorder::print(const char str[])
+{
+    m_stream.print(str);
+}
+
+void SessionRecorder::print(uint8_t value)
+{
+    m_stream.print(value);
+}
+
+void SessionRecorder::print(uint16_t value)
+{
+    m_stream.print(value);
+}
+
+void SessionRecorder::print(uint32_t value)
+{
+    m_stream.print(value);
+}
+
+void SessionRecorder::print(int8_t value)
+{
+    m_stream.print(value);
+}
+
+void SessionRecorder::print(int16_t value)
+{
+    m_stream.print(value);
+}
+
+void SessionRecorder::print(int32_t value)
+{
+    m_stream.print(value);
+}
+
+void SessionRecorder::println(const char str[])
+{
+    m_stream.println(str);
+}
+
+void SessionRecorder::println(uint8_t value)
+{
+    m_stream.println(value);
+}
+
+void SessionRecorder::println(uint16_t value)
+{
+    m_stream.println(value);
+}
+
+void SessionRecorder::println(uint32_t value)
+{
+    m_stream.println(value);
+}
+
+void SessionRecorder::println(int8_t value)
+{
+    m_stream.println(value);
+}
+
+void SessionRecorder::println(int16_t value)
+{
+    m_stream.println(value);
+}
+
+void SessionRecorder::println(int32_t value)
+{
+    m_stream.println(value);
+}
+
+size_t SessionRecorder::write(const uint8_t* buffer, size_t length)
+{
+    size_t written = m_stream.write(buffer, length);
+
+    append(DIRECTION_OUTBOUND, buffer, written);
+
+    return written;
+}
+
+int SessionRecorder::available() const
+{
+    return m_stream.available();
+}
+
+size_t SessionRecorder::readBytes(uint8_t* buffer, size_t length)
+{
+    size_t read = m_stream.readBytes(buffer, length);
+
+    append(DIRECTION_INBOUND, buffer, read);
+
+    return read;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SessionRecorder::append(Direction direction, const uint8_t* data, size_t length)
+{
+    if (nullptr != m_file)
+    {
+        if (m_pendingDirection != direction)
+        {
+            flush();
+            m_pendingDirection = direction;
+        }
+
+        while (0U < length)
+        {
+            size_t space = MAX_RECORD_LENGTH - m_pendingLength;
+            size_t count = (length < space) ? length : space;
+
+            memcpy(&m_pendingData[m_pendingLength], data, count);
+            m_pendingLength += static_cast<uint16_t>(count);
+            data += count;
+            length -= count;
+
+            if (MAX_RECORD_LENGTH == m_pendingLength)
+            {
+                flush();
+            }
+        }
+    }
+}
+
+void SessionRecorder::flush()
+{
+    if ((nullptr != m_file) && (0U < m_pendingLength))
+    {
+        RecordHeader header;
+
+        header.timestamp = m_timestamp;
+        header.direction = static_cast<uint8_t>(m_pendingDirection);
+        header.length    = m_pendingLength;
+
+        if ((1U != fwrite(&header, sizeof(header), 1U, m_file)) ||
+            (1U != fwrite(m_pendingData, m_pendingLength, 1U, m_file)))
+        {
+            printf("Session recording failed.\n");
+            (void)fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    m_pendingLength = 0U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
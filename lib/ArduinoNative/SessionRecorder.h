@@ -0,0 +1,287 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Session recorder, which records the serial communication with the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <stdio.h>
+#include "Stream.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The session recorder is put between the serial driver and the stream to
+ * the host, e.g. the socket server. It records the inbound bytes, when the
+ * application reads them, and the outbound bytes, when the application
+ * writes them, with the simulation time. The recorded session can be
+ * replayed with the SessionReplay.
+ *
+ * The session file starts with the file header, followed by the records.
+ * Every record consists of the record header and the recorded bytes. All
+ * bytes of the same direction, which are transferred at the same time, are
+ * merged into one record.
+ */
+class SessionRecorder : public Stream
+{
+public:
+    /** Session file magic "RSES". */
+    static const uint32_t MAGIC = 0x53455352U;
+
+    /** Session file format version. */
+    static const uint16_t VERSION = 1U;
+
+    /** Max. number of bytes in a record. */
+    static const uint16_t MAX_RECORD_LENGTH = 1024U;
+
+    /** Direction of the recorded bytes. */
+    enum Direction
+    {
+        DIRECTION_INBOUND = 0, /**< Host to robot */
+        DIRECTION_OUTBOUND     /**< Robot to host */
+    };
+
+    /** Session file header. */
+    typedef struct _FileHeader
+    {
+        uint32_t magic;    /**< File magic */
+        uint16_t version;  /**< File format version */
+        uint16_t reserved; /**< Reserved, always 0 */
+
+    } __attribute__((packed)) FileHeader;
+
+    /** Record header. */
+    typedef struct _RecordHeader
+    {
+        uint32_t timestamp; /**< Simulation time in [ms] */
+        uint8_t  direction; /**< Direction, see Direction */
+        uint16_t length;    /**< Number of recorded bytes */
+
+    } __attribute__((packed)) RecordHeader;
+
+    /**
+     * Constructs the session recorder.
+     *
+     * @param[in] stream    Stream to the host
+     */
+    SessionRecorder(Stream& stream);
+
+    /**
+     * Destroys the session recorder. A opened session file is closed.
+     */
+    ~SessionRecorder();
+
+    /**
+     * Open the session file and start recording.
+     *
+     * @param[in] fileName  Name of the session file
+     *
+     * @return If successful opened, it will return true otherwise false.
+     */
+    bool open(const char* fileName);
+
+    /**
+     * Stop recording and close the session file.
+     */
+    void close();
+
+    /**
+     * Set the current simulation time. Call it before the application
+     * loop, so the recorded bytes get the time of the loop.
+     *
+     * @param[in] timestamp Simulation time in [ms]
+     */
+    void process(uint32_t timestamp);
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] str Argument to print.
+     */
+    void print(const char str[]) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] str Argument to print.
+     */
+    void println(const char str[]) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int32_t value) final;
+
+    /**
+     * Send bytes to the host and record them.
+     * @param[in] buffer Byte buffer to send
+     * @param[in] length Number of bytes to send
+     * @returns Number of bytes written
+     */
+    size_t write(const uint8_t* buffer, size_t length) final;
+
+    /**
+     * Check if any data has been received.
+     * @returns number of available bytes.
+     */
+    int available() const final;
+
+    /**
+     * Read bytes from the host and record them.
+     * @param[in] buffer Array to write bytes to.
+     * @param[in] length number of bytes to be read.
+     * @returns Number of bytes read from Stream.
+     */
+    size_t readBytes(uint8_t* buffer, size_t length) final;
+
+private:
+    Stream&   m_stream;                         /**< Stream to the host */
+    FILE*     m_file;                           /**< Session file */
+    uint32_t  m_timestamp;                      /**< Current simulation time in [ms] */
+    Direction m_pendingDirection;               /**< Direction of the pending record */
+    uint8_t   m_pendingData[MAX_RECORD_LENGTH]; /**< Bytes of the pending record */
+    uint16_t  m_pendingLength;                  /**< Number of bytes in the pending record */
+
+    /**
+     * Append bytes to the pending record. The pending record is written
+     * before, if the direction changes or it is full.
+     *
+     * @param[in] direction Direction
+     * @param[in] data      Bytes
+     * @param[in] length    Number of bytes
+     */
+    void append(Direction direction, const uint8_t* data, size_t length);
+
+    /**
+     * Write the pending record to the session file.
+     */
+    void flush();
+
+    /* Not allowed. */
+    SessionRecorder(const SessionRecorder& recorder);
+    SessionRecorder& operator=(const SessionRecorder& recorder);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SESSION_RECORDER_H */
+/** @} */
@@ -0,0 +1,403 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Session replay, which replays a recorded serial communication with the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SessionReplay.h"
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SessionReplay::SessionReplay() :
+    Stream(),
+    m_inbound(),
+    m_outbound(),
+    m_timestamp(0U),
+    m_lastTimestamp(0U),
+    m_inChunkIdx(0U),
+    m_inAvailableEnd(0U),
+    m_inReadIdx(0U),
+    m_outChunkIdx(0U),
+    m_outIdx(0U),
+    m_isMismatch(false),
+    m_mismatchIdx(0U),
+    m_mismatchByte(0U),
+    m_mismatchTime(0U),
+    m_numShifted(0U),
+    m_maxShift(0U),
+    m_firstShiftedIdx(0U),
+    m_firstShiftedTime(0U)
+{
+}
+
+SessionReplay::~SessionReplay()
+{
+}
+
+bool SessionReplay::load(const char* fileName)
+{
+    bool  isSuccessful = false;
+    FILE* file         = (nullptr != fileName) ? fopen(fileName, "rb") : nullptr;
+
+    reset();
+
+    if (nullptr != file)
+    {
+        SessionRecorder::FileHeader   fileHeader;
+        SessionRecorder::RecordHeader recordHeader;
+
+        if ((1U == fread(&fileHeader, sizeof(fileHeader), 1U, file)) &&
+            (SessionRecorder::MAGIC == fileHeader.magic) && (SessionRecorder::VERSION == fileHeader.version))
+        {
+            isSuccessful = true;
+
+            while ((true == isSuccessful) && (1U == fread(&recordHeader, sizeof(recordHeader), 1U, file)))
+            {
+                Recording* recording = (SessionRecorder::DIRECTION_INBOUND == recordHeader.direction)
+                                           ? &m_inbound
+                                           : &m_outbound;
+                size_t     offset    = recording->data.size();
+
+                recording->data.resize(offset + recordHeader.length);
+
+                if ((SessionRecorder::DIRECTION_OUTBOUND < recordHeader.direction) ||
+                    (0U == recordHeader.length) ||
+                    (1U != fread(&recording->data[offset], recordHeader.length, 1U, file)))
+                {
+                    isSuccessful = false;
+                }
+                else
+                {
+                    Chunk chunk;
+
+                    chunk.timestamp = recordHeader.timestamp;
+                    chunk.end       = recording->data.size();
+                    recording->chunks.push_back(chunk);
+
+                    m_lastTimestamp = recordHeader.timestamp;
+                }
+            }
+        }
+
+        (void)fclose(file);
+    }
+
+    if (false == isSuccessful)
+    {
+        printf("Invalid session file.\n");
+    }
+
+    return isSuccessful;
+}
+
+void SessionReplay::process(uint32_t timestamp)
+{
+    m_timestamp = timestamp;
+
+    /* Inject all bytes, which the application read until now. */
+    while ((m_inbound.chunks.size() > m_inChunkIdx) && (m_timestamp >= m_inbound.chunks[m_inChunkIdx].timestamp))
+    {
+        m_inAvailableEnd = m_inbound.chunks[m_inChunkIdx].end;
+        ++m_inChunkIdx;
+    }
+}
+
+bool SessionReplay::isFinished() const
+{
+    return ((m_lastTimestamp + FINISH_DELAY) <= m_timestamp);
+}
+
+bool SessionReplay::report() const
+{
+    bool isEqual = true;
+
+    printf("Session replay: %u of %u inbound bytes read, %u of %u outbound bytes written.\n",
+           static_cast<unsigned int>(m_inReadIdx), static_cast<unsigned int>(m_inbound.data.size()),
+           static_cast<unsigned int>(m_outIdx), static_cast<unsigned int>(m_outbound.data.size()));
+
+    if (true == m_isMismatch)
+    {
+        printf("Outbound byte %u differs: expected 0x%02X, got 0x%02X at %u ms.\n",
+               static_cast<unsigned int>(m_mismatchIdx), m_outbound.data[m_mismatchIdx], m_mismatchByte,
+               m_mismatchTime);
+        isEqual = false;
+    }
+
+    if (m_outbound.data.size() > m_outIdx)
+    {
+        printf("%u outbound bytes are missing.\n", static_cast<unsigned int>(m_outbound.data.size() - m_outIdx));
+        isEqual = false;
+    }
+    else if (m_outbound.data.size() < m_outIdx)
+    {
+        printf("%u additional outbound bytes.\n", static_cast<unsigned int>(m_outIdx - m_outbound.data.size()));
+        isEqual = false;
+    }
+    else
+    {
+        ;
+    }
+
+    if (0U < m_numShifted)
+    {
+        printf("%u of %u outbound records shifted in time, max. %u ms.\n", static_cast<unsigned int>(m_numShifted),
+               static_cast<unsigned int>(m_outbound.chunks.size()), m_maxShift);
+        printf("First shifted record %u: recorded at %u ms, written at %u ms.\n",
+               static_cast<unsigned int>(m_firstShiftedIdx), m_outbound.chunks[m_firstShiftedIdx].timestamp,
+               m_firstShiftedTime);
+        isEqual = false;
+    }
+
+    printf("Session replay %s.\n", (true == isEqual) ? "passed" : "failed");
+
+    return isEqual;
+}
+
+void SessionReplay::print(const char str[])
+{
+    /* Not implemented */
+    (void)str;
+}
+
+void SessionReplay::print(uint8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::print(uint16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::print(uint32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::print(int8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::print(int16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::print(int32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::println(const char str[])
+{
+    /* Not implemented */
+    (void)str;
+}
+
+void SessionReplay::println(uint8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::println(uint16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::println(uint32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::println(int8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::println(int16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void SessionReplay::println(int32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+size_t SessionReplay::write(const uint8_t* buffer, size_t length)
+{
+    size_t idx;
+
+    for (idx = 0U; idx < length; ++idx)
+    {
+        if ((m_outbound.data.size() > m_outIdx) && (false == m_isMismatch) &&
+            (m_outbound.data[m_outIdx] != buffer[idx]))
+        {
+            m_isMismatch   = true;
+            m_mismatchIdx  = m_outIdx;
+            m_mismatchByte = buffer[idx];
+            m_mismatchTime = m_timestamp;
+        }
+
+        ++m_outIdx;
+
+        /* Compare the time, when a recorded chunk is complete. */
+        if ((m_outbound.chunks.size() > m_outChunkIdx) && (m_outbound.chunks[m_outChunkIdx].end == m_outIdx))
+        {
+            uint32_t recorded = m_outbound.chunks[m_outChunkIdx].timestamp;
+            uint32_t shift    = (m_timestamp > recorded) ? (m_timestamp - recorded) : (recorded - m_timestamp);
+
+            if (0U < shift)
+            {
+                if (0U == m_numShifted)
+                {
+                    m_firstShiftedIdx  = m_outChunkIdx;
+                    m_firstShiftedTime = m_timestamp;
+                }
+
+                if (m_maxShift < shift)
+                {
+                    m_maxShift = shift;
+                }
+
+                ++m_numShifted;
+            }
+
+            ++m_outChunkIdx;
+        }
+    }
+
+    return length;
+}
+
+int SessionReplay::available() const
+{
+    return static_cast<int>(m_inAvailableEnd - m_inReadIdx);
+}
+
+size_t SessionReplay::readBytes(uint8_t* buffer, size_t length)
+{
+    size_t count = m_inAvailableEnd - m_inReadIdx;
+
+    if (length < count)
+    {
+        count = length;
+    }
+
+    if ((nullptr != buffer) && (0U < count))
+    {
+        memcpy(buffer, &m_inbound.data[m_inReadIdx], count);
+        m_inReadIdx += count;
+    }
+    else
+    {
+        count = 0U;
+    }
+
+    return count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SessionReplay::reset()
+{
+    m_inbound.chunks.clear();
+    m_inbound.data.clear();
+    m_outbound.chunks.clear();
+    m_outbound.data.clear();
+
+    m_timestamp        = 0U;
+    m_lastTimestamp    = 0U;
+    m_inChunkIdx       = 0U;
+    m_inAvailableEnd   = 0U;
+    m_inReadIdx        = 0U;
+    m_outChunkIdx      = 0U;
+    m_outIdx           = 0U;
+    m_isMismatch       = false;
+    m_mismatchIdx      = 0U;
+    m_mismatchByte     = 0U;
+    m_mismatchTime     = 0U;
+    m_numShifted       = 0U;
+    m_maxShift         = 0U;
+    m_firstShiftedIdx  = 0U;
+    m_firstShiftedTime = 0U;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,278 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Session replay, which replays a recorded serial communication with the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef SESSION_REPLAY_H
+#define SESSION_REPLAY_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <vector>
+#include "Stream.h"
+#include "SessionRecorder.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The session replay replaces the stream to the host. It injects the
+ * recorded inbound bytes at the recorded simulation time and compares the
+ * outbound bytes of the application with the recorded ones.
+ *
+ * Differences in content are reported with the first different byte.
+ * Differences in timing are reported per recorded outbound record, whose
+ * last byte was written at another simulation time.
+ */
+class SessionReplay : public Stream
+{
+public:
+    /** Time after the last record, until the replay is finished in [ms]. */
+    static const uint32_t FINISH_DELAY = 1000U;
+
+    /**
+     * Constructs the session replay.
+     */
+    SessionReplay();
+
+    /**
+     * Destroys the session replay.
+     */
+    ~SessionReplay();
+
+    /**
+     * Load a recorded session. A previous replay is discarded.
+     *
+     * @param[in] fileName  Name of the session file
+     *
+     * @return If successful loaded, it will return true otherwise false.
+     */
+    bool load(const char* fileName);
+
+    /**
+     * Set the current simulation time and inject the inbound bytes, which
+     * were read by the application until then. Call it before the
+     * application loop.
+     *
+     * @param[in] timestamp Simulation time in [ms]
+     */
+    void process(uint32_t timestamp);
+
+    /**
+     * Is the replay finished? It is finished, after the last recorded byte
+     * plus FINISH_DELAY.
+     *
+     * @return If finished, it will return true otherwise false.
+     */
+    bool isFinished() const;
+
+    /**
+     * Print the comparison result.
+     *
+     * @return If the outbound bytes and their timing are equal, it will return true otherwise false.
+     */
+    bool report() const;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] str Argument to print.
+     */
+    void print(const char str[]) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] str Argument to print.
+     */
+    void println(const char str[]) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int32_t value) final;
+
+    /**
+     * Compare the bytes with the recorded outbound bytes.
+     * @param[in] buffer Byte buffer to send
+     * @param[in] length Number of bytes to send
+     * @returns Number of bytes written
+     */
+    size_t write(const uint8_t* buffer, size_t length) final;
+
+    /**
+     * Check if any injected data is available.
+     * @returns number of available bytes.
+     */
+    int available() const final;
+
+    /**
+     * Read injected bytes into a buffer.
+     * @param[in] buffer Array to write bytes to.
+     * @param[in] length number of bytes to be read.
+     * @returns Number of bytes read from Stream.
+     */
+    size_t readBytes(uint8_t* buffer, size_t length) final;
+
+private:
+    /** Recorded bytes of one direction at one time. */
+    struct Chunk
+    {
+        uint32_t timestamp; /**< Simulation time in [ms] */
+        size_t   end;       /**< Offset after the last byte in the byte stream */
+    };
+
+    /** Recorded byte stream of one direction. */
+    struct Recording
+    {
+        std::vector<Chunk>   chunks; /**< Chunks in recorded order */
+        std::vector<uint8_t> data;   /**< Bytes of all chunks */
+    };
+
+    Recording m_inbound;          /**< Recorded inbound bytes */
+    Recording m_outbound;         /**< Recorded outbound bytes */
+    uint32_t  m_timestamp;        /**< Current simulation time in [ms] */
+    uint32_t  m_lastTimestamp;    /**< Simulation time of the last record in [ms] */
+    size_t    m_inChunkIdx;       /**< Index of the next inbound chunk to inject */
+    size_t    m_inAvailableEnd;   /**< Offset after the last injected inbound byte */
+    size_t    m_inReadIdx;        /**< Offset of the next inbound byte to read */
+    size_t    m_outChunkIdx;      /**< Index of the next outbound chunk to compare the timing */
+    size_t    m_outIdx;           /**< Number of written outbound bytes */
+    bool      m_isMismatch;       /**< Is a different outbound byte detected? */
+    size_t    m_mismatchIdx;      /**< Offset of the first different outbound byte */
+    uint8_t   m_mismatchByte;     /**< First different outbound byte */
+    uint32_t  m_mismatchTime;     /**< Simulation time of the first different outbound byte in [ms] */
+    size_t    m_numShifted;       /**< Number of outbound chunks, written at another time */
+    uint32_t  m_maxShift;         /**< Max. absolute time shift of an outbound chunk in [ms] */
+    size_t    m_firstShiftedIdx;  /**< Index of the first outbound chunk, written at another time */
+    uint32_t  m_firstShiftedTime; /**< Simulation time of the first shifted outbound chunk in [ms] */
+
+    /**
+     * Discard the recorded session and the comparison result.
+     */
+    void reset();
+
+    /* Not allowed. */
+    SessionReplay(const SessionReplay& replay);
+    SessionReplay& operator=(const SessionReplay& replay);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SESSION_REPLAY_H */
+/** @} */
@@ -35,6 +35,7 @@
 
 #include <stdio.h>
 #include "Terminal.h"
+#include <Format.h>
 
 /******************************************************************************
  * Macros
@@ -44,6 +45,9 @@
  * Types and classes
  *****************************************************************************/
 
+/** Buffer for a single formatted value with line feed. */
+typedef FormatBuffer<Format::MAX_VALUE_LENGTH + 2U> ValueBuffer;
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -66,72 +70,85 @@ Terminal::~Terminal()
 
 void Terminal::print(const char str[])
 {
-    printf("%s", str);
+    (void)fputs(str, stdout);
 }
 
 void Terminal::print(uint8_t value)
 {
-    printf("%u", value);
+    print(static_cast<uint32_t>(value));
 }
 
 void Terminal::print(uint16_t value)
 {
-    printf("%u", value);
+    print(static_cast<uint32_t>(value));
 }
 
 void Terminal::print(uint32_t value)
 {
-    printf("%u", value);
+    ValueBuffer buffer;
+
+    (void)buffer.add(value);
+    (void)write(reinterpret_cast<const uint8_t*>(buffer.getString()), buffer.getLength());
 }
 
 void Terminal::print(int8_t value)
 {
-    printf("%d", value);
+    print(static_cast<int32_t>(value));
 }
 
 void Terminal::print(int16_t value)
 {
-    printf("%d", value);
+    print(static_cast<int32_t>(value));
 }
 
 void Terminal::print(int32_t value)
 {
-    printf("%d", value);
+    ValueBuffer buffer;
+
+    (void)buffer.add(value);
+    (void)write(reinterpret_cast<const uint8_t*>(buffer.getString()), buffer.getLength());
 }
 
 void Terminal::println(const char str[])
 {
-    printf("%s\n", str);
+    (void)fputs(str, stdout);
+    (void)fputc('\n', stdout);
 }
 
 void Terminal::println(uint8_t value)
 {
-    printf("%u\n", value);
+    println(static_cast<uint32_t>(value));
 }
 
 void Terminal::println(uint16_t value)
 {
-    printf("%u\n", value);
+    println(static_cast<uint32_t>(value));
 }
 
 void Terminal::println(uint32_t value)
 {
-    printf("%u\n", value);
+    ValueBuffer buffer;
+
+    (void)buffer.add(value).add('\n');
+    (void)write(reinterpret_cast<const uint8_t*>(buffer.getString()), buffer.getLength());
 }
 
 void Terminal::println(int8_t value)
 {
-    printf("%d\n", value);
+    println(static_cast<int32_t>(value));
 }
 
 void Terminal::println(int16_t value)
 {
-    printf("%d\n", value);
+    println(static_cast<int32_t>(value));
 }
 
 void Terminal::println(int32_t value)
 {
-    printf("%d\n", value);
+    ValueBuffer buffer;
+
+    (void)buffer.add(value).add('\n');
+    (void)write(reinterpret_cast<const uint8_t*>(buffer.getString()), buffer.getLength());
 }
 
 size_t Terminal::write(const uint8_t* buffer, size_t length)
@@ -140,10 +157,8 @@ size_t Terminal::write(const uint8_t* buffer, size_t length)
 
     if ((nullptr != buffer) && (0U != length))
     {
-        for (count = 0; count < length; count++)
-        {
-            printf("%u", buffer[count]);
-        }
+        /* Raw data, e.g. a complete log line, is written at once. */
+        count = fwrite(buffer, 1U, length, stdout);
     }
 
     return count;
@@ -88,6 +88,14 @@ Board::Board() :
     m_ledYellow(),
     m_ledGreen(),
     m_proximitySensors()
+#if (0 != HAL_PROFILER_ENABLE)
+    ,
+    m_profiledDisplay(m_display),
+    m_profiledEncoders(m_encoders),
+    m_profiledLineSensors(m_lineSensors),
+    m_profiledMotors(m_motors),
+    m_profiledProximitySensors(m_proximitySensors)
+#endif /* (0 != HAL_PROFILER_ENABLE) */
 {
 }
 
@@ -56,6 +56,12 @@
 #include <LedYellow.h>
 #include <LedGreen.h>
 #include <ProximitySensors.h>
+#include <HALProfiler.h>
+#include <ProfiledDisplay.h>
+#include <ProfiledEncoders.h>
+#include <ProfiledLineSensors.h>
+#include <ProfiledMotors.h>
+#include <ProfiledProximitySensors.h>
 
 /******************************************************************************
  * Macros
@@ -136,7 +142,11 @@ public:
      */
     IDisplay& getDisplay() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledDisplay;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_display;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -146,7 +156,11 @@ public:
      */
     IEncoders& getEncoders() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledEncoders;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_encoders;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -156,7 +170,11 @@ public:
      */
     ILineSensors& getLineSensors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledLineSensors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_lineSensors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -166,7 +184,11 @@ public:
      */
     IMotors& getMotors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledMotors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_motors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -206,7 +228,11 @@ public:
      */
     IProximitySensors& getProximitySensors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledProximitySensors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_proximitySensors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
 protected:
@@ -249,6 +275,25 @@ private:
     /** Proximity sensors */
     ProximitySensors m_proximitySensors;
 
+#if (0 != HAL_PROFILER_ENABLE)
+
+    /** Profiling decorator of the display */
+    ProfiledDisplay m_profiledDisplay;
+
+    /** Profiling decorator of the encoders */
+    ProfiledEncoders m_profiledEncoders;
+
+    /** Profiling decorator of the line sensors */
+    ProfiledLineSensors m_profiledLineSensors;
+
+    /** Profiling decorator of the motors */
+    ProfiledMotors m_profiledMotors;
+
+    /** Profiling decorator of the proximity sensors */
+    ProfiledProximitySensors m_profiledProximitySensors;
+
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
     /**
      * Constructs the concrete board.
      */
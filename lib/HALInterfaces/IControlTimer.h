@@ -0,0 +1,104 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Abstract control timer interface
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALInterfaces
+ *
+ * @{
+ */
+#ifndef ICONTROLTIMER_H
+#define ICONTROLTIMER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The abstract control timer interface.
+ * The timer calls a callback periodically in interrupt context, independent
+ * of the main loop. It is used for fast control loops with low jitter.
+ */
+class IControlTimer
+{
+public:
+    /**
+     * Callback, which is called periodically in interrupt context.
+     */
+    typedef void (*Callback)();
+
+    /**
+     * Destroys the interface.
+     */
+    virtual ~IControlTimer()
+    {
+    }
+
+    /**
+     * Start the timer.
+     *
+     * @param[in] period    Period in ms.
+     * @param[in] callback  Callback, which is called periodically.
+     */
+    virtual void start(uint8_t period, Callback callback) = 0;
+
+    /**
+     * Stop the timer.
+     */
+    virtual void stop() = 0;
+
+protected:
+    /**
+     * Constructs the interface.
+     */
+    IControlTimer()
+    {
+    }
+
+private:
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* ICONTROLTIMER_H */
+/** @} */
@@ -85,6 +85,15 @@ public:
      */
     virtual size_t print(const char str[]) = 0;
 
+    /**
+     * Print the string from program memory to the display at the current cursor position.
+     *
+     * @param[in] str   String in program memory
+     *
+     * @return Printed number of characters
+     */
+    virtual size_t print(const __FlashStringHelper* str) = 0;
+
     /**
      * Print the unsigned 8-bit value to the display at the current cursor position.
      *
@@ -0,0 +1,97 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Abstract CPU idle interface
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALInterfaces
+ *
+ * @{
+ */
+#ifndef IIDLE_H
+#define IIDLE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** The abstract CPU idle interface. */
+class IIdle
+{
+public:
+    /**
+     * Destroys the interface.
+     */
+    virtual ~IIdle()
+    {
+    }
+
+    /**
+     * Sleeps the CPU until the next interrupt wakes it up.
+     * The peripherals and timers keep running.
+     */
+    virtual void sleep() = 0;
+
+    /**
+     * Get the scheduling quantum of the main loop. The main loop can't be
+     * called more often, e.g. in a simulation it is called once per
+     * simulation step.
+     *
+     * @return Scheduling quantum in us, 0 if the main loop runs continuously.
+     */
+    virtual uint32_t getLoopQuantum() const = 0;
+
+protected:
+    /**
+     * Constructs the interface.
+     */
+    IIdle()
+    {
+    }
+
+private:
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* IIDLE_H */
+/** @} */
@@ -136,6 +136,33 @@ public:
      */
     virtual uint16_t getSensorValueMax() const = 0;
 
+    /**
+     * Get the calibrated min. raw value of a line sensor, which means white.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Min. raw value. If calibration was not done yet or the index is invalid, it will return 0.
+     */
+    virtual uint16_t getCalibMinValue(uint8_t index) const = 0;
+
+    /**
+     * Get the calibrated max. raw value of a line sensor, which means black.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Max. raw value. If calibration was not done yet or the index is invalid, it will return 0.
+     */
+    virtual uint16_t getCalibMaxValue(uint8_t index) const = 0;
+
+    /**
+     * Set the calibration, e.g. to continue with the calibration of a saved run.
+     * If every max. value is 0, the calibration is cleared.
+     *
+     * @param[in] minValues Calibrated min. raw values, one per sensor, see getCalibMinValue().
+     * @param[in] maxValues Calibrated max. raw values, one per sensor, see getCalibMaxValue().
+     */
+    virtual void setCalibration(const uint16_t* minValues, const uint16_t* maxValues) = 0;
+
     /**
      * Calibration error information: Calibration successful.
      */
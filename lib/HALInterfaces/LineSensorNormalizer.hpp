@@ -0,0 +1,344 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Line sensor normalizer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HALInterfaces
+ *
+ * @{
+ */
+
+#ifndef LINESENSORNORMALIZER_H
+#define LINESENSORNORMALIZER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Normalizes raw line sensor values to 0 (white) .. 1000 (black) by the
+ * calibrated min. and max. value of every sensor and estimates the line
+ * position. It is shared by all HALs, so that the line sensors behave in the
+ * simulation like on the target.
+ *
+ * The offset and a fixed-point reciprocal of the calibrated range are
+ * precomputed during calibration. A read costs one multiplication and one
+ * shift per sensor instead of a division.
+ *
+ * @tparam numSensors The number of line sensors.
+ */
+template<uint8_t numSensors>
+class LineSensorNormalizer
+{
+public:
+    /** Max. normalized sensor value, which means black. */
+    static const uint16_t NORMALIZED_MAX = 1000U;
+
+    /**
+     * Constructs the line sensor normalizer in not calibrated state.
+     */
+    LineSensorNormalizer() : m_minValues(), m_maxValues(), m_scales(), m_isCalibrated(false), m_lastPosition(0)
+    {
+        clear();
+    }
+
+    /**
+     * Destroys the line sensor normalizer.
+     */
+    ~LineSensorNormalizer()
+    {
+    }
+
+    /**
+     * Clears the calibration.
+     */
+    void clear()
+    {
+        uint8_t idx = 0U;
+
+        for (idx = 0U; idx < numSensors; ++idx)
+        {
+            m_minValues[idx] = UINT16_MAX;
+            m_maxValues[idx] = 0U;
+            m_scales[idx]    = 0U;
+        }
+
+        m_isCalibrated = false;
+        m_lastPosition = 0;
+    }
+
+    /**
+     * Consider raw sensor values for calibration. Call it several times during
+     * turning the sensors over the line to determine the minimum and maximum
+     * values. The scale of every sensor is updated right away.
+     *
+     * @param[in] rawValues Raw sensor values, one per sensor.
+     */
+    void calibrate(const uint16_t* rawValues)
+    {
+        calibrate(rawValues, rawValues);
+    }
+
+    /**
+     * Consider separate candidates for the min. and the max. values. This
+     * allows to reject noise by several reads, like the Pololu library does:
+     * The min. value is only lowered by the highest read and the max. value
+     * is only raised by the lowest read.
+     *
+     * @param[in] minCandidates Raw values, which may lower the min. values, one per sensor.
+     * @param[in] maxCandidates Raw values, which may raise the max. values, one per sensor.
+     */
+    void calibrate(const uint16_t* minCandidates, const uint16_t* maxCandidates)
+    {
+        uint8_t idx = 0U;
+
+        for (idx = 0U; idx < numSensors; ++idx)
+        {
+            if (m_minValues[idx] > minCandidates[idx])
+            {
+                m_minValues[idx] = minCandidates[idx];
+            }
+
+            if (m_maxValues[idx] < maxCandidates[idx])
+            {
+                m_maxValues[idx] = maxCandidates[idx];
+            }
+
+            /* Precompute the reciprocal of the range here, to avoid a division per read. */
+            if (m_maxValues[idx] > m_minValues[idx])
+            {
+                uint32_t range = m_maxValues[idx] - m_minValues[idx];
+
+                m_scales[idx] = ((static_cast<uint32_t>(NORMALIZED_MAX) << SCALE_SHIFT) + range - 1U) / range;
+            }
+            else
+            {
+                m_scales[idx] = 0U;
+            }
+        }
+
+        m_isCalibrated = true;
+    }
+
+    /**
+     * Set the calibration, e.g. to continue with the calibration of a saved run.
+     * If every max. value is 0, no sensor saw any value and the calibration is
+     * cleared.
+     *
+     * @param[in] minValues Calibrated min. raw values, one per sensor.
+     * @param[in] maxValues Calibrated max. raw values, one per sensor.
+     */
+    void setCalibration(const uint16_t* minValues, const uint16_t* maxValues)
+    {
+        bool    isCalibrated = false;
+        uint8_t idx          = 0U;
+
+        clear();
+
+        for (idx = 0U; idx < numSensors; ++idx)
+        {
+            if (0U < maxValues[idx])
+            {
+                isCalibrated = true;
+            }
+        }
+
+        /* The min. and max. values span the same range and scale like the samples did. */
+        if (true == isCalibrated)
+        {
+            calibrate(minValues);
+            calibrate(maxValues);
+        }
+    }
+
+    /**
+     * Is calibration started?
+     *
+     * @return If at least one calibration value was considered, it will return true otherwise false.
+     */
+    bool isCalibrated() const
+    {
+        return m_isCalibrated;
+    }
+
+    /**
+     * Get calibrated min. raw value of a sensor.
+     *
+     * @param[in] idx   Sensor index
+     *
+     * @return Min. raw value
+     */
+    uint16_t getMinValue(uint8_t idx) const
+    {
+        return (numSensors > idx) ? m_minValues[idx] : 0U;
+    }
+
+    /**
+     * Get calibrated max. raw value of a sensor.
+     *
+     * @param[in] idx   Sensor index
+     *
+     * @return Max. raw value
+     */
+    uint16_t getMaxValue(uint8_t idx) const
+    {
+        return (numSensors > idx) ? m_maxValues[idx] : 0U;
+    }
+
+    /**
+     * Normalize raw sensor values to 0 .. NORMALIZED_MAX.
+     * If not calibrated yet, the raw values are passed through.
+     *
+     * @param[in]  rawValues    Raw sensor values, one per sensor.
+     * @param[out] values       Normalized sensor values, one per sensor.
+     */
+    void normalize(const uint16_t* rawValues, uint16_t* values) const
+    {
+        uint8_t idx = 0U;
+
+        for (idx = 0U; idx < numSensors; ++idx)
+        {
+            if (false == m_isCalibrated)
+            {
+                values[idx] = rawValues[idx];
+            }
+            else if (m_minValues[idx] >= rawValues[idx])
+            {
+                values[idx] = 0U;
+            }
+            else if (m_maxValues[idx] <= rawValues[idx])
+            {
+                values[idx] = (0U == m_scales[idx]) ? 0U : NORMALIZED_MAX;
+            }
+            else
+            {
+                uint32_t offset = rawValues[idx] - m_minValues[idx];
+
+                values[idx] = static_cast<uint16_t>((offset * m_scales[idx]) >> SCALE_SHIFT);
+
+                /* The rounded up reciprocal may exceed the max. value slightly. */
+                if (NORMALIZED_MAX < values[idx])
+                {
+                    values[idx] = NORMALIZED_MAX;
+                }
+            }
+        }
+    }
+
+    /**
+     * Estimates the position of a dark line on a white surface by the weighted
+     * average of the normalized sensor values. Sensor 0 is weighted with 0,
+     * sensor 1 with 1000, sensor 2 with 2000, etc.
+     *
+     * If no sensor sees the line, the position of the sensor which saw the line
+     * at last is returned, which is 0 for the most left sensor or
+     * (numSensors - 1) * 1000 for the most right sensor.
+     *
+     * @param[in] values    Normalized sensor values, one per sensor.
+     *
+     * @return Estimated line position
+     */
+    int16_t estimatePosition(const uint16_t* values)
+    {
+        const int16_t POS_MAX   = (numSensors - 1) * NORMALIZED_MAX;
+        bool          isOnLine  = false;
+        uint32_t      numerator = 0U;
+        uint16_t      sum       = 0U;
+        uint8_t       idx       = 0U;
+
+        for (idx = 0U; idx < numSensors; ++idx)
+        {
+            if (ON_LINE_THRESHOLD < values[idx])
+            {
+                isOnLine = true;
+            }
+
+            /* Only values above the noise threshold are considered. */
+            if (NOISE_THRESHOLD < values[idx])
+            {
+                numerator += static_cast<uint32_t>(values[idx]) * idx * NORMALIZED_MAX;
+                sum += values[idx];
+            }
+        }
+
+        if (false == isOnLine)
+        {
+            /* The line was lost. Report the side where it was seen last. */
+            if ((POS_MAX / 2) > m_lastPosition)
+            {
+                m_lastPosition = 0;
+            }
+            else
+            {
+                m_lastPosition = POS_MAX;
+            }
+        }
+        else
+        {
+            m_lastPosition = static_cast<int16_t>(numerator / sum);
+        }
+
+        return m_lastPosition;
+    }
+
+private:
+    /** Number of fractional bits of the fixed-point scales. */
+    static const uint8_t SCALE_SHIFT = 16U;
+
+    /** Normalized value above which a sensor sees the line. */
+    static const uint16_t ON_LINE_THRESHOLD = 200U;
+
+    /** Normalized value up to which a sensor value is considered as noise. */
+    static const uint16_t NOISE_THRESHOLD = 50U;
+
+    uint16_t m_minValues[numSensors]; /**< Calibrated min. raw value per sensor. */
+    uint16_t m_maxValues[numSensors]; /**< Calibrated max. raw value per sensor. */
+    uint32_t m_scales[numSensors];    /**< Reciprocal of the calibrated range per sensor in Q16. */
+    bool     m_isCalibrated;          /**< Is at least one calibration value considered? */
+    int16_t  m_lastPosition;          /**< Last estimated line position. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LINESENSORNORMALIZER_H */
+/** @} */
@@ -142,25 +142,39 @@ Board::Board() :
     IBoard(),
     m_robot(),
     m_simTime(m_robot),
-    m_keyboard(m_simTime, m_robot.getKeyboard()),
+    m_keyboard(m_simTime, KEYBOARD_READ_PERIOD, m_robot.getKeyboard()),
     m_buttonA(m_keyboard),
     m_buttonB(m_keyboard),
     m_buttonC(m_keyboard),
     m_buzzer(m_robot.getSpeaker(SPEAKER_NAME)),
     m_display(m_robot.getDisplay(DISPLAY_NAME)),
-    m_encoders(m_simTime, m_robot.getPositionSensor(POS_SENSOR_LEFT_NAME),
+    m_encoders(m_simTime, ENCODERS_READ_PERIOD, m_robot.getPositionSensor(POS_SENSOR_LEFT_NAME),
                m_robot.getPositionSensor(POS_SENSOR_RIGHT_NAME)),
-    m_lineSensors(m_simTime, m_robot.getEmitter(EMITTER_0_NAME), m_robot.getEmitter(EMITTER_1_NAME),
-                  m_robot.getEmitter(EMITTER_2_NAME), m_robot.getEmitter(EMITTER_3_NAME),
-                  m_robot.getEmitter(EMITTER_4_NAME), m_robot.getDistanceSensor(LIGHT_SENSOR_0_NAME),
+    m_lineSensors(m_simTime, LINE_SENSORS_READ_PERIOD, m_robot.getEmitter(EMITTER_0_NAME),
+                  m_robot.getEmitter(EMITTER_1_NAME), m_robot.getEmitter(EMITTER_2_NAME),
+                  m_robot.getEmitter(EMITTER_3_NAME), m_robot.getEmitter(EMITTER_4_NAME), m_robot.getDistanceSensor(LIGHT_SENSOR_0_NAME),
                   m_robot.getDistanceSensor(LIGHT_SENSOR_1_NAME), m_robot.getDistanceSensor(LIGHT_SENSOR_2_NAME),
                   m_robot.getDistanceSensor(LIGHT_SENSOR_3_NAME), m_robot.getDistanceSensor(LIGHT_SENSOR_4_NAME)),
     m_motors(m_robot.getMotor(LEFT_MOTOR_NAME), m_robot.getMotor(RIGHT_MOTOR_NAME)),
     m_ledRed(m_robot.getLED(LED_RED_NAME)),
     m_ledYellow(m_robot.getLED(LED_YELLOW_NAME)),
     m_ledGreen(m_robot.getLED(LED_GREEN_NAME)),
-    m_proximitySensors(m_simTime, m_robot.getDistanceSensor(PROXIMITY_SENSOR_FRONT_LEFT_NAME),
-                       m_robot.getDistanceSensor(PROXIMITY_SENSOR_FRONT_RIGHT_NAME))
+    m_proximitySensors(m_simTime, PROXIMITY_SENSORS_READ_PERIOD,
+                       m_robot.getDistanceSensor(PROXIMITY_SENSOR_FRONT_LEFT_NAME),
+                       m_robot.getDistanceSensor(PROXIMITY_SENSOR_FRONT_RIGHT_NAME)),
+    m_watchdog(),
+    m_controlTimer(m_simTime),
+    m_idle(m_simTime),
+    m_battery(),
+    m_settings()
+#if (0 != HAL_PROFILER_ENABLE)
+    ,
+    m_profiledDisplay(m_display),
+    m_profiledEncoders(m_encoders),
+    m_profiledLineSensors(m_lineSensors),
+    m_profiledMotors(m_motors),
+    m_profiledProximitySensors(m_proximitySensors)
+#endif /* (0 != HAL_PROFILER_ENABLE) */
 {
 }
 
@@ -56,6 +56,17 @@
 #include <LedYellow.h>
 #include <LedGreen.h>
 #include <ProximitySensors.h>
+#include <HALProfiler.h>
+#include <ProfiledDisplay.h>
+#include <ProfiledEncoders.h>
+#include <ProfiledLineSensors.h>
+#include <ProfiledMotors.h>
+#include <ProfiledProximitySensors.h>
+#include <Watchdog.h>
+#include <ControlTimer.h>
+#include <Idle.h>
+#include <Battery.h>
+#include <Settings.h>
 
 #include <math.h>
 #include <webots/Robot.hpp>
@@ -140,7 +151,11 @@ public:
      */
     IDisplay& getDisplay() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledDisplay;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_display;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -150,7 +165,11 @@ public:
      */
     IEncoders& getEncoders() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledEncoders;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_encoders;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -160,7 +179,11 @@ public:
      */
     ILineSensors& getLineSensors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledLineSensors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_lineSensors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -170,7 +193,11 @@ public:
      */
     IMotors& getMotors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledMotors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_motors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -210,7 +237,61 @@ public:
      */
     IProximitySensors& getProximitySensors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledProximitySensors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_proximitySensors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+    }
+
+    /**
+     * Get watchdog driver.
+     *
+     * @return Watchdog driver
+     */
+    IWatchdog& getWatchdog() final
+    {
+        return m_watchdog;
+    }
+
+    /**
+     * Get control timer driver.
+     *
+     * @return Control timer driver
+     */
+    IControlTimer& getControlTimer() final
+    {
+        return m_controlTimer;
+    }
+
+    /**
+     * Get CPU idle driver.
+     *
+     * @return CPU idle driver
+     */
+    IIdle& getIdle() final
+    {
+        return m_idle;
+    }
+
+    /**
+     * Get battery driver.
+     *
+     * @return Battery driver
+     */
+    IBattery& getBattery() final
+    {
+        return m_battery;
+    }
+
+    /**
+     * Get non-volatile settings driver.
+     *
+     * @return Settings driver
+     */
+    ISettings& getSettings() final
+    {
+        return m_settings;
     }
 
 protected:
@@ -278,6 +359,18 @@ private:
     /** Name of the front right proximity sensor in the robot simulation. */
     static const char* PROXIMITY_SENSOR_FRONT_RIGHT_NAME;
 
+    /** Keyboard read period in ms. Button presses are handled by a human, so polling is throttled. */
+    static const uint32_t KEYBOARD_READ_PERIOD = 32U;
+
+    /** Encoders read period in ms. The application reads them every loop cycle, so sample every step. */
+    static const uint32_t ENCODERS_READ_PERIOD = 0U;
+
+    /** Line sensors read period in ms. The application reads them every control period. */
+    static const uint32_t LINE_SENSORS_READ_PERIOD = 5U;
+
+    /** Proximity sensors read period in ms. Enabled lazily on first read only. */
+    static const uint32_t PROXIMITY_SENSORS_READ_PERIOD = 50U;
+
     /** Simulated roboter instance. */
     webots::Robot m_robot;
 
@@ -323,6 +416,40 @@ private:
     /** Proximity sensors */
     ProximitySensors m_proximitySensors;
 
+    /** Watchdog driver */
+    Watchdog m_watchdog;
+
+    /** Control timer driver */
+    ControlTimer m_controlTimer;
+
+    /** CPU idle driver */
+    Idle m_idle;
+
+    /** Battery driver */
+    Battery m_battery;
+
+    /** Non-volatile settings driver */
+    Settings m_settings;
+
+#if (0 != HAL_PROFILER_ENABLE)
+
+    /** Profiling decorator of the display */
+    ProfiledDisplay m_profiledDisplay;
+
+    /** Profiling decorator of the encoders */
+    ProfiledEncoders m_profiledEncoders;
+
+    /** Profiling decorator of the line sensors */
+    ProfiledLineSensors m_profiledLineSensors;
+
+    /** Profiling decorator of the motors */
+    ProfiledMotors m_profiledMotors;
+
+    /** Profiling decorator of the proximity sensors */
+    ProfiledProximitySensors m_profiledProximitySensors;
+
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
     /**
      * Constructs the concrete board.
      */
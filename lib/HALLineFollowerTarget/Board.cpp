@@ -87,7 +87,20 @@ Board::Board() :
     m_ledRed(),
     m_ledYellow(),
     m_ledGreen(),
-    m_proximitySensors()
+    m_proximitySensors(),
+    m_watchdog(),
+    m_controlTimer(),
+    m_idle(),
+    m_battery(),
+    m_settings()
+#if (0 != HAL_PROFILER_ENABLE)
+    ,
+    m_profiledDisplay(m_display),
+    m_profiledEncoders(m_encoders),
+    m_profiledLineSensors(m_lineSensors),
+    m_profiledMotors(m_motors),
+    m_profiledProximitySensors(m_proximitySensors)
+#endif /* (0 != HAL_PROFILER_ENABLE) */
 {
 }
 
@@ -0,0 +1,244 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HAL access profiler
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HALProfiler.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Name of IEncoders::getCountsLeft() */
+static const char gNameEncGetCountsLeft[] PROGMEM = "Enc.getCountsLeft";
+
+/** Name of IEncoders::getCountsRight() */
+static const char gNameEncGetCountsRight[] PROGMEM = "Enc.getCountsRight";
+
+/** Name of IEncoders::getCountsAndResetLeft() */
+static const char gNameEncGetCountsAndResetLeft[] PROGMEM = "Enc.getCountsAndResetLeft";
+
+/** Name of IEncoders::getCountsAndResetRight() */
+static const char gNameEncGetCountsAndResetRight[] PROGMEM = "Enc.getCountsAndResetRight";
+
+/** Name of ILineSensors::calibrate() */
+static const char gNameLsCalibrate[] PROGMEM = "LS.calibrate";
+
+/** Name of ILineSensors::readLine() */
+static const char gNameLsReadLine[] PROGMEM = "LS.readLine";
+
+/** Name of ILineSensors::getSensorValues() */
+static const char gNameLsGetSensorValues[] PROGMEM = "LS.getSensorValues";
+
+/** Name of ILineSensors::isCalibrationSuccessful() */
+static const char gNameLsIsCalibrationSuccessful[] PROGMEM = "LS.isCalibrationSuccessful";
+
+/** Name of ILineSensors::getCalibErrorInfo() */
+static const char gNameLsGetCalibErrorInfo[] PROGMEM = "LS.getCalibErrorInfo";
+
+/** Name of IMotors::setSpeeds() */
+static const char gNameMotSetSpeeds[] PROGMEM = "Mot.setSpeeds";
+
+/** Name of IMotors::getLeftSpeed() */
+static const char gNameMotGetLeftSpeed[] PROGMEM = "Mot.getLeftSpeed";
+
+/** Name of IMotors::getRightSpeed() */
+static const char gNameMotGetRightSpeed[] PROGMEM = "Mot.getRightSpeed";
+
+/** Name of IProximitySensors::read() */
+static const char gNamePsRead[] PROGMEM = "PS.read";
+
+/** Name of IProximitySensors::countsFrontWithLeftLeds() */
+static const char gNamePsCountsFrontWithLeftLeds[] PROGMEM = "PS.countsFrontWithLeftLeds";
+
+/** Name of IProximitySensors::countsFrontWithRightLeds() */
+static const char gNamePsCountsFrontWithRightLeds[] PROGMEM = "PS.countsFrontWithRightLeds";
+
+/** Name of IDisplay::clear() */
+static const char gNameDispClear[] PROGMEM = "Disp.clear";
+
+/** Name of IDisplay::gotoXY() */
+static const char gNameDispGotoXY[] PROGMEM = "Disp.gotoXY";
+
+/** Name of all IDisplay::print() overloads */
+static const char gNameDispPrint[] PROGMEM = "Disp.print";
+
+/** Method names in the order of HALProfiler::Method. */
+static const char* const gMethodNames[HALProfiler::METHOD_MAX] PROGMEM = {
+    gNameEncGetCountsLeft,
+    gNameEncGetCountsRight,
+    gNameEncGetCountsAndResetLeft,
+    gNameEncGetCountsAndResetRight,
+    gNameLsCalibrate,
+    gNameLsReadLine,
+    gNameLsGetSensorValues,
+    gNameLsIsCalibrationSuccessful,
+    gNameLsGetCalibErrorInfo,
+    gNameMotSetSpeeds,
+    gNameMotGetLeftSpeed,
+    gNameMotGetRightSpeed,
+    gNamePsRead,
+    gNamePsCountsFrontWithLeftLeds,
+    gNamePsCountsFrontWithRightLeds,
+    gNameDispClear,
+    gNameDispGotoXY,
+    gNameDispPrint
+};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void HALProfiler::record(Method method, uint32_t duration)
+{
+    if (METHOD_MAX > method)
+    {
+        Statistics& statistics = m_statistics[method];
+
+        if (UINT8_MAX > statistics.loopCalls)
+        {
+            ++statistics.loopCalls;
+        }
+
+        /* Saturate the loop time instead of wrapping around. */
+        if (static_cast<uint32_t>(UINT16_MAX - statistics.loopTime) < duration)
+        {
+            statistics.loopTime = UINT16_MAX;
+        }
+        else
+        {
+            statistics.loopTime += static_cast<uint16_t>(duration);
+        }
+
+        ++statistics.totalCalls;
+        statistics.totalTime += duration;
+    }
+}
+
+void HALProfiler::endLoop()
+{
+    uint8_t method;
+
+    for (method = 0U; method < METHOD_MAX; ++method)
+    {
+        Statistics& statistics = m_statistics[method];
+        uint8_t     bin        = statistics.loopCalls;
+
+        if (HISTOGRAM_BINS <= bin)
+        {
+            bin = HISTOGRAM_BINS - 1U;
+        }
+
+        if (UINT16_MAX > statistics.histogram[bin])
+        {
+            ++statistics.histogram[bin];
+        }
+
+        if (statistics.maxLoopTime < statistics.loopTime)
+        {
+            statistics.maxLoopTime = statistics.loopTime;
+        }
+
+        statistics.loopCalls = 0U;
+        statistics.loopTime  = 0U;
+    }
+
+    ++m_loopCount;
+}
+
+void HALProfiler::clear()
+{
+    uint8_t method;
+
+    for (method = 0U; method < METHOD_MAX; ++method)
+    {
+        Statistics& statistics = m_statistics[method];
+        uint8_t     bin;
+
+        statistics.loopCalls   = 0U;
+        statistics.loopTime    = 0U;
+        statistics.maxLoopTime = 0U;
+        statistics.totalCalls  = 0U;
+        statistics.totalTime   = 0U;
+
+        for (bin = 0U; bin < HISTOGRAM_BINS; ++bin)
+        {
+            statistics.histogram[bin] = 0U;
+        }
+    }
+
+    m_loopCount = 0U;
+}
+
+const __FlashStringHelper* HALProfiler::getName(Method method)
+{
+    const __FlashStringHelper* name = nullptr;
+
+    if (METHOD_MAX > method)
+    {
+        name = static_cast<const __FlashStringHelper*>(pgm_read_ptr(&gMethodNames[method]));
+    }
+
+    return name;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,250 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  HAL access profiler
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef HALPROFILER_H
+#define HALPROFILER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef HAL_PROFILER_ENABLE
+/**
+ * Enable/disable the HAL access profiler. If enabled, the board hands out
+ * profiling decorators instead of the encoders, line sensors, motors,
+ * proximity sensors and display drivers.
+ */
+#define HAL_PROFILER_ENABLE (0)
+#endif /* HAL_PROFILER_ENABLE */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The HAL access profiler counts the calls and accumulates the time per
+ * profiled HAL method and loop iteration. At the end of every loop the number
+ * of calls is added to a histogram per method, which shows how often a method
+ * is called per loop.
+ *
+ * The profiler is not interrupt safe. HAL methods, which are called in
+ * interrupt context, shall not be profiled.
+ */
+class HALProfiler
+{
+public:
+    /**
+     * The profiled HAL methods. Methods, which only return constants, and the
+     * initialization are not profiled.
+     */
+    enum Method
+    {
+        ENCODERS_GET_COUNTS_LEFT = 0,                   /**< IEncoders::getCountsLeft() */
+        ENCODERS_GET_COUNTS_RIGHT,                      /**< IEncoders::getCountsRight() */
+        ENCODERS_GET_COUNTS_AND_RESET_LEFT,             /**< IEncoders::getCountsAndResetLeft() */
+        ENCODERS_GET_COUNTS_AND_RESET_RIGHT,            /**< IEncoders::getCountsAndResetRight() */
+        LINE_SENSORS_CALIBRATE,                         /**< ILineSensors::calibrate() */
+        LINE_SENSORS_READ_LINE,                         /**< ILineSensors::readLine() */
+        LINE_SENSORS_GET_SENSOR_VALUES,                 /**< ILineSensors::getSensorValues() */
+        LINE_SENSORS_IS_CALIBRATION_SUCCESSFUL,         /**< ILineSensors::isCalibrationSuccessful() */
+        LINE_SENSORS_GET_CALIB_ERROR_INFO,              /**< ILineSensors::getCalibErrorInfo() */
+        MOTORS_SET_SPEEDS,                              /**< IMotors::setSpeeds() */
+        MOTORS_GET_LEFT_SPEED,                          /**< IMotors::getLeftSpeed() */
+        MOTORS_GET_RIGHT_SPEED,                         /**< IMotors::getRightSpeed() */
+        PROXIMITY_SENSORS_READ,                         /**< IProximitySensors::read() */
+        PROXIMITY_SENSORS_COUNTS_FRONT_WITH_LEFT_LEDS,  /**< IProximitySensors::countsFrontWithLeftLeds() */
+        PROXIMITY_SENSORS_COUNTS_FRONT_WITH_RIGHT_LEDS, /**< IProximitySensors::countsFrontWithRightLeds() */
+        DISPLAY_CLEAR,                                  /**< IDisplay::clear() */
+        DISPLAY_GOTO_XY,                                /**< IDisplay::gotoXY() */
+        DISPLAY_PRINT,                                  /**< All IDisplay::print() overloads */
+        METHOD_MAX                                      /**< Number of profiled methods */
+    };
+
+    /**
+     * Number of histogram bins. The bins count the loops with 0, 1, 2 and
+     * 3 or more calls of a method.
+     */
+    static const uint8_t HISTOGRAM_BINS = 4U;
+
+    /**
+     * Statistics of a single profiled method.
+     */
+    struct Statistics
+    {
+        uint8_t  loopCalls;                 /**< Number of calls in the current loop. */
+        uint16_t loopTime;                  /**< Accumulated time in the current loop in us. */
+        uint16_t maxLoopTime;               /**< Max. accumulated time of a loop in us. */
+        uint32_t totalCalls;                /**< Number of calls since clear. */
+        uint32_t totalTime;                 /**< Accumulated time since clear in us. */
+        uint16_t histogram[HISTOGRAM_BINS]; /**< Number of loops per number of calls. */
+    };
+
+    /**
+     * Measures the time of a single HAL method call from construction to
+     * destruction and records it in the profiler.
+     */
+    class Probe
+    {
+    public:
+        /**
+         * Constructs the probe and starts the measurement.
+         *
+         * @param[in] method    The profiled method.
+         */
+        Probe(Method method) : m_method(method), m_startTimestamp(micros())
+        {
+        }
+
+        /**
+         * Destroys the probe and records the call.
+         */
+        ~Probe()
+        {
+            HALProfiler::getInstance().record(m_method, micros() - m_startTimestamp);
+        }
+
+    private:
+        Method   m_method;         /**< The profiled method. */
+        uint32_t m_startTimestamp; /**< Timestamp of the call in us. */
+
+        /* Not allowed. */
+        Probe();                              /**< Default construction of an instance. */
+        Probe(const Probe& probe);            /**< Copy construction of an instance. */
+        Probe& operator=(const Probe& probe); /**< Assignment of an instance. */
+    };
+
+    /**
+     * Get the HAL profiler instance.
+     *
+     * @return HAL profiler instance
+     */
+    static HALProfiler& getInstance()
+    {
+        static HALProfiler instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Record a single call of a method.
+     *
+     * @param[in] method    The profiled method.
+     * @param[in] duration  Duration of the call in us.
+     */
+    void record(Method method, uint32_t duration);
+
+    /**
+     * Close the current loop iteration: The calls per method are added to
+     * the histogram and the per loop counters are reset.
+     * Call it once at the end of every loop.
+     */
+    void endLoop();
+
+    /**
+     * Clear all statistics.
+     */
+    void clear();
+
+    /**
+     * Get the number of loops since clear.
+     *
+     * @return Number of loops
+     */
+    uint32_t getLoopCount() const
+    {
+        return m_loopCount;
+    }
+
+    /**
+     * Get the statistics of a method.
+     *
+     * @param[in] method    The profiled method.
+     *
+     * @return Statistics
+     */
+    const Statistics& getStatistics(Method method) const
+    {
+        return m_statistics[method];
+    }
+
+    /**
+     * Get the name of a method.
+     *
+     * @param[in] method    The profiled method.
+     *
+     * @return Name in program memory
+     */
+    static const __FlashStringHelper* getName(Method method);
+
+protected:
+private:
+    uint32_t   m_loopCount;              /**< Number of loops since clear. */
+    Statistics m_statistics[METHOD_MAX]; /**< Statistics per method. */
+
+    /**
+     * Constructs the HAL profiler.
+     */
+    HALProfiler() : m_loopCount(0U), m_statistics()
+    {
+        clear();
+    }
+
+    /**
+     * Destroys the HAL profiler.
+     */
+    ~HALProfiler()
+    {
+    }
+
+    /* Not allowed. */
+    HALProfiler(const HALProfiler& profiler);            /**< Copy construction of an instance. */
+    HALProfiler& operator=(const HALProfiler& profiler); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* HALPROFILER_H */
+/** @} */
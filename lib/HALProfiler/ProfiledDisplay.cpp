@@ -0,0 +1,145 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the display
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ProfiledDisplay.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ProfiledDisplay::clear()
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_CLEAR);
+
+    m_display.clear();
+}
+
+void ProfiledDisplay::gotoXY(uint8_t xCoord, uint8_t yCoord)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_GOTO_XY);
+
+    m_display.gotoXY(xCoord, yCoord);
+}
+
+size_t ProfiledDisplay::print(const char str[])
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(str);
+}
+
+size_t ProfiledDisplay::print(const __FlashStringHelper* str)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(str);
+}
+
+size_t ProfiledDisplay::print(uint8_t value)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(value);
+}
+
+size_t ProfiledDisplay::print(uint16_t value)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(value);
+}
+
+size_t ProfiledDisplay::print(uint32_t value)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(value);
+}
+
+size_t ProfiledDisplay::print(int8_t value)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(value);
+}
+
+size_t ProfiledDisplay::print(int16_t value)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(value);
+}
+
+size_t ProfiledDisplay::print(int32_t value)
+{
+    HALProfiler::Probe probe(HALProfiler::DISPLAY_PRINT);
+
+    return m_display.print(value);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
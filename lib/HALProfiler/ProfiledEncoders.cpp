@@ -0,0 +1,108 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the encoders
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ProfiledEncoders.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ProfiledEncoders::init()
+{
+    m_encoders.init();
+}
+
+int16_t ProfiledEncoders::getCountsLeft()
+{
+    HALProfiler::Probe probe(HALProfiler::ENCODERS_GET_COUNTS_LEFT);
+
+    return m_encoders.getCountsLeft();
+}
+
+int16_t ProfiledEncoders::getCountsRight()
+{
+    HALProfiler::Probe probe(HALProfiler::ENCODERS_GET_COUNTS_RIGHT);
+
+    return m_encoders.getCountsRight();
+}
+
+int16_t ProfiledEncoders::getCountsAndResetLeft()
+{
+    HALProfiler::Probe probe(HALProfiler::ENCODERS_GET_COUNTS_AND_RESET_LEFT);
+
+    return m_encoders.getCountsAndResetLeft();
+}
+
+int16_t ProfiledEncoders::getCountsAndResetRight()
+{
+    HALProfiler::Probe probe(HALProfiler::ENCODERS_GET_COUNTS_AND_RESET_RIGHT);
+
+    return m_encoders.getCountsAndResetRight();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,127 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the encoders
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef PROFILEDENCODERS_H
+#define PROFILEDENCODERS_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <IEncoders.h>
+#include "HALProfiler.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decorates the encoders and profiles every access with the HAL profiler.
+ */
+class ProfiledEncoders : public IEncoders
+{
+public:
+    /**
+     * Constructs the profiling decorator.
+     *
+     * @param[in] encoders The decorated encoders.
+     */
+    ProfiledEncoders(IEncoders& encoders) : IEncoders(), m_encoders(encoders)
+    {
+    }
+
+    /**
+     * Destroys the profiling decorator.
+     */
+    ~ProfiledEncoders()
+    {
+    }
+
+    /**
+     * Initialize the encoders. It is not profiled.
+     */
+    void init() final;
+
+    /**
+     * Returns the number of counts of the left-side encoder.
+     *
+     * @return Encoder steps left
+     */
+    int16_t getCountsLeft() final;
+
+    /**
+     * Returns the number of counts of the right-side encoder.
+     *
+     * @return Encoder steps right
+     */
+    int16_t getCountsRight() final;
+
+    /**
+     * Returns the number of counts of the left-side encoder and clears them.
+     *
+     * @return Encoder steps left
+     */
+    int16_t getCountsAndResetLeft() final;
+
+    /**
+     * Returns the number of counts of the right-side encoder and clears them.
+     *
+     * @return Encoder steps right
+     */
+    int16_t getCountsAndResetRight() final;
+
+protected:
+private:
+    IEncoders& m_encoders; /**< The decorated encoders. */
+
+    /* Not allowed. */
+    ProfiledEncoders();                                             /**< Default construction of an instance. */
+    ProfiledEncoders(const ProfiledEncoders& decorator);            /**< Copy construction of an instance. */
+    ProfiledEncoders& operator=(const ProfiledEncoders& decorator); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PROFILEDENCODERS_H */
+/** @} */
@@ -0,0 +1,140 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the line sensors
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ProfiledLineSensors.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ProfiledLineSensors::init()
+{
+    m_lineSensors.init();
+}
+
+void ProfiledLineSensors::calibrate()
+{
+    HALProfiler::Probe probe(HALProfiler::LINE_SENSORS_CALIBRATE);
+
+    m_lineSensors.calibrate();
+}
+
+int16_t ProfiledLineSensors::readLine()
+{
+    HALProfiler::Probe probe(HALProfiler::LINE_SENSORS_READ_LINE);
+
+    return m_lineSensors.readLine();
+}
+
+const uint16_t* ProfiledLineSensors::getSensorValues()
+{
+    HALProfiler::Probe probe(HALProfiler::LINE_SENSORS_GET_SENSOR_VALUES);
+
+    return m_lineSensors.getSensorValues();
+}
+
+bool ProfiledLineSensors::isCalibrationSuccessful()
+{
+    HALProfiler::Probe probe(HALProfiler::LINE_SENSORS_IS_CALIBRATION_SUCCESSFUL);
+
+    return m_lineSensors.isCalibrationSuccessful();
+}
+
+uint8_t ProfiledLineSensors::getCalibErrorInfo() const
+{
+    HALProfiler::Probe probe(HALProfiler::LINE_SENSORS_GET_CALIB_ERROR_INFO);
+
+    return m_lineSensors.getCalibErrorInfo();
+}
+
+uint8_t ProfiledLineSensors::getNumLineSensors() const
+{
+    return m_lineSensors.getNumLineSensors();
+}
+
+uint16_t ProfiledLineSensors::getSensorValueMax() const
+{
+    return m_lineSensors.getSensorValueMax();
+}
+
+uint16_t ProfiledLineSensors::getCalibMinValue(uint8_t index) const
+{
+    return m_lineSensors.getCalibMinValue(index);
+}
+
+uint16_t ProfiledLineSensors::getCalibMaxValue(uint8_t index) const
+{
+    return m_lineSensors.getCalibMaxValue(index);
+}
+
+void ProfiledLineSensors::setCalibration(const uint16_t* minValues, const uint16_t* maxValues)
+{
+    m_lineSensors.setCalibration(minValues, maxValues);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,172 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the line sensors
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef PROFILEDLINESENSORS_H
+#define PROFILEDLINESENSORS_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <ILineSensors.h>
+#include "HALProfiler.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decorates the line sensors and profiles every access with the HAL profiler.
+ */
+class ProfiledLineSensors : public ILineSensors
+{
+public:
+    /**
+     * Constructs the profiling decorator.
+     *
+     * @param[in] lineSensors The decorated line sensors.
+     */
+    ProfiledLineSensors(ILineSensors& lineSensors) : ILineSensors(), m_lineSensors(lineSensors)
+    {
+    }
+
+    /**
+     * Destroys the profiling decorator.
+     */
+    ~ProfiledLineSensors()
+    {
+    }
+
+    /**
+     * Initialize the line sensors. It is not profiled.
+     */
+    void init() final;
+
+    /**
+     * Calibrate the line sensors.
+     */
+    void calibrate() final;
+
+    /**
+     * Determines the deviation and returns an estimated position of the line.
+     *
+     * @return Estimated line position
+     */
+    int16_t readLine() final;
+
+    /**
+     * Get last line sensor values.
+     *
+     * @return Line sensor values
+     */
+    const uint16_t* getSensorValues() final;
+
+    /**
+     * Is the calibration successful?
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool isCalibrationSuccessful() final;
+
+    /**
+     * Get the calibration error information.
+     *
+     * @return Calibration error information
+     */
+    uint8_t getCalibErrorInfo() const final;
+
+    /**
+     * Get number of used line sensors. It is not profiled.
+     *
+     * @return Number of line sensors
+     */
+    uint8_t getNumLineSensors() const final;
+
+    /**
+     * Get max. value of a line sensor. It is not profiled.
+     *
+     * @return Max. line sensor value
+     */
+    uint16_t getSensorValueMax() const final;
+
+    /**
+     * Get the calibrated min. raw value of a line sensor. It is not profiled.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Min. raw value
+     */
+    uint16_t getCalibMinValue(uint8_t index) const final;
+
+    /**
+     * Get the calibrated max. raw value of a line sensor. It is not profiled.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Max. raw value
+     */
+    uint16_t getCalibMaxValue(uint8_t index) const final;
+
+    /**
+     * Set the calibration. It is not profiled.
+     *
+     * @param[in] minValues Calibrated min. raw values, one per sensor.
+     * @param[in] maxValues Calibrated max. raw values, one per sensor.
+     */
+    void setCalibration(const uint16_t* minValues, const uint16_t* maxValues) final;
+
+protected:
+private:
+    ILineSensors& m_lineSensors; /**< The decorated line sensors. */
+
+    /* Not allowed. */
+    ProfiledLineSensors();                                                /**< Default construction of an instance. */
+    ProfiledLineSensors(const ProfiledLineSensors& decorator);            /**< Copy construction of an instance. */
+    ProfiledLineSensors& operator=(const ProfiledLineSensors& decorator); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PROFILEDLINESENSORS_H */
+/** @} */
@@ -0,0 +1,128 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the motors
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef PROFILEDMOTORS_H
+#define PROFILEDMOTORS_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <IMotors.h>
+#include "HALProfiler.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decorates the motors and profiles every access with the HAL profiler.
+ */
+class ProfiledMotors : public IMotors
+{
+public:
+    /**
+     * Constructs the profiling decorator.
+     *
+     * @param[in] motors The decorated motors.
+     */
+    ProfiledMotors(IMotors& motors) : IMotors(), m_motors(motors)
+    {
+    }
+
+    /**
+     * Destroys the profiling decorator.
+     */
+    ~ProfiledMotors()
+    {
+    }
+
+    /**
+     * Initialize the motors. It is not profiled.
+     */
+    void init() final;
+
+    /**
+     * Set the speeds for both motors.
+     *
+     * @param[in] leftSpeed   Left motor speed
+     * @param[in] rightSpeed  Right motor speed
+     */
+    void setSpeeds(int16_t leftSpeed, int16_t rightSpeed) final;
+
+    /**
+     * Get maximum speed of the motors. It is not profiled.
+     *
+     * @return Max. speed
+     */
+    int16_t getMaxSpeed() const final;
+
+    /**
+     * Get the current speed of the left motor.
+     *
+     * @return Left motor speed
+     */
+    int16_t getLeftSpeed() final;
+
+    /**
+     * Get the current speed of the right motor.
+     *
+     * @return Right motor speed
+     */
+    int16_t getRightSpeed() final;
+
+protected:
+private:
+    IMotors& m_motors; /**< The decorated motors. */
+
+    /* Not allowed. */
+    ProfiledMotors();                                           /**< Default construction of an instance. */
+    ProfiledMotors(const ProfiledMotors& decorator);            /**< Copy construction of an instance. */
+    ProfiledMotors& operator=(const ProfiledMotors& decorator); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PROFILEDMOTORS_H */
+/** @} */
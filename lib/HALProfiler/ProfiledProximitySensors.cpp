@@ -0,0 +1,111 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the proximity sensors
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ProfiledProximitySensors.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ProfiledProximitySensors::initFrontSensor()
+{
+    m_proximitySensors.initFrontSensor();
+}
+
+uint8_t ProfiledProximitySensors::getNumSensors() const
+{
+    return m_proximitySensors.getNumSensors();
+}
+
+void ProfiledProximitySensors::read()
+{
+    HALProfiler::Probe probe(HALProfiler::PROXIMITY_SENSORS_READ);
+
+    m_proximitySensors.read();
+}
+
+uint8_t ProfiledProximitySensors::countsFrontWithLeftLeds() const
+{
+    HALProfiler::Probe probe(HALProfiler::PROXIMITY_SENSORS_COUNTS_FRONT_WITH_LEFT_LEDS);
+
+    return m_proximitySensors.countsFrontWithLeftLeds();
+}
+
+uint8_t ProfiledProximitySensors::countsFrontWithRightLeds() const
+{
+    HALProfiler::Probe probe(HALProfiler::PROXIMITY_SENSORS_COUNTS_FRONT_WITH_RIGHT_LEDS);
+
+    return m_proximitySensors.countsFrontWithRightLeds();
+}
+
+uint8_t ProfiledProximitySensors::getNumBrightnessLevels() const
+{
+    return m_proximitySensors.getNumBrightnessLevels();
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,132 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Profiling decorator of the proximity sensors
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HAL
+ *
+ * @{
+ */
+
+#ifndef PROFILEDPROXIMITYSENSORS_H
+#define PROFILEDPROXIMITYSENSORS_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <IProximitySensors.h>
+#include "HALProfiler.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Decorates the proximity sensors and profiles every access with the HAL profiler.
+ */
+class ProfiledProximitySensors : public IProximitySensors
+{
+public:
+    /**
+     * Constructs the profiling decorator.
+     *
+     * @param[in] proximitySensors The decorated proximity sensors.
+     */
+    ProfiledProximitySensors(IProximitySensors& proximitySensors) : IProximitySensors(), m_proximitySensors(proximitySensors)
+    {
+    }
+
+    /**
+     * Destroys the profiling decorator.
+     */
+    ~ProfiledProximitySensors()
+    {
+    }
+
+    /**
+     * Initialize the front proximity sensor. It is not profiled.
+     */
+    void initFrontSensor() final;
+
+    /**
+     * Get the number of sensors. It is not profiled.
+     *
+     * @return Number of sensors
+     */
+    uint8_t getNumSensors() const final;
+
+    /**
+     * Read the proximity sensors.
+     */
+    void read() final;
+
+    /**
+     * Get the front sensor counts with the left LEDs.
+     *
+     * @return Counts
+     */
+    uint8_t countsFrontWithLeftLeds() const final;
+
+    /**
+     * Get the front sensor counts with the right LEDs.
+     *
+     * @return Counts
+     */
+    uint8_t countsFrontWithRightLeds() const final;
+
+    /**
+     * Get the number of brightness levels. It is not profiled.
+     *
+     * @return Number of brightness levels
+     */
+    uint8_t getNumBrightnessLevels() const final;
+
+protected:
+private:
+    IProximitySensors& m_proximitySensors; /**< The decorated proximity sensors. */
+
+    /* Not allowed. */
+    ProfiledProximitySensors();                                                     /**< Default construction of an instance. */
+    ProfiledProximitySensors(const ProfiledProximitySensors& decorator);            /**< Copy construction of an instance. */
+    ProfiledProximitySensors& operator=(const ProfiledProximitySensors& decorator); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PROFILEDPROXIMITYSENSORS_H */
+/** @} */
@@ -56,6 +56,12 @@
 #include <LedYellow.h>
 #include <LedGreen.h>
 #include <ProximitySensors.h>
+#include <HALProfiler.h>
+#include <ProfiledDisplay.h>
+#include <ProfiledEncoders.h>
+#include <ProfiledLineSensors.h>
+#include <ProfiledMotors.h>
+#include <ProfiledProximitySensors.h>
 
 #include <math.h>
 #include <webots/Robot.hpp>
@@ -140,7 +146,11 @@ public:
      */
     IDisplay& getDisplay() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledDisplay;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_display;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -150,7 +160,11 @@ public:
      */
     IEncoders& getEncoders() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledEncoders;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_encoders;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -160,7 +174,11 @@ public:
      */
     ILineSensors& getLineSensors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledLineSensors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_lineSensors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -170,7 +188,11 @@ public:
      */
     IMotors& getMotors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledMotors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_motors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
     /**
@@ -210,7 +232,11 @@ public:
      */
     IProximitySensors& getProximitySensors() final
     {
+#if (0 != HAL_PROFILER_ENABLE)
+        return m_profiledProximitySensors;
+#else /* (0 != HAL_PROFILER_ENABLE) */
         return m_proximitySensors;
+#endif /* (0 != HAL_PROFILER_ENABLE) */
     }
 
 protected:
@@ -278,6 +304,18 @@ private:
     /** Name of the front right proximity sensor in the robot simulation. */
     static const char* PROXIMITY_SENSOR_FRONT_RIGHT_NAME;
 
+    /** Keyboard read period in ms. Button presses are handled by a human, so polling is throttled. */
+    static const uint32_t KEYBOARD_READ_PERIOD = 32U;
+
+    /** Encoders read period in ms. The application reads them every loop cycle, so sample every step. */
+    static const uint32_t ENCODERS_READ_PERIOD = 0U;
+
+    /** Line sensors read period in ms. The application reads them when the line sensor data is sent. */
+    static const uint32_t LINE_SENSORS_READ_PERIOD = 20U;
+
+    /** Proximity sensors read period in ms. Enabled lazily on first read only. */
+    static const uint32_t PROXIMITY_SENSORS_READ_PERIOD = 50U;
+
     /** Simulated roboter instance. */
     webots::Robot m_robot;
 
@@ -323,6 +361,25 @@ private:
     /** Proximity sensors */
     ProximitySensors m_proximitySensors;
 
+#if (0 != HAL_PROFILER_ENABLE)
+
+    /** Profiling decorator of the display */
+    ProfiledDisplay m_profiledDisplay;
+
+    /** Profiling decorator of the encoders */
+    ProfiledEncoders m_profiledEncoders;
+
+    /** Profiling decorator of the line sensors */
+    ProfiledLineSensors m_profiledLineSensors;
+
+    /** Profiling decorator of the motors */
+    ProfiledMotors m_profiledMotors;
+
+    /** Profiling decorator of the proximity sensors */
+    ProfiledProximitySensors m_profiledProximitySensors;
+
+#endif /* (0 != HAL_PROFILER_ENABLE) */
+
     /**
      * Constructs the concrete board.
      */
@@ -0,0 +1,97 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Battery realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALSim
+ *
+ * @{
+ */
+
+#ifndef BATTERY_H
+#define BATTERY_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IBattery.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The simulated battery. The simulated robot has no battery model, therefore
+ * it always provides the nominal voltage of four NiMH cells.
+ */
+class Battery : public IBattery
+{
+public:
+    /**
+     * Constructs the battery adapter.
+     */
+    Battery() : IBattery()
+    {
+    }
+
+    /**
+     * Destroys the battery adapter.
+     */
+    ~Battery()
+    {
+    }
+
+    /**
+     * Get the battery voltage.
+     *
+     * @return Battery voltage in mV
+     */
+    uint16_t getVoltage() final
+    {
+        return NOMINAL_VOLTAGE;
+    }
+
+private:
+    /** Nominal voltage in mV of four NiMH cells. */
+    static const uint16_t NOMINAL_VOLTAGE = 4800U;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* BATTERY_H */
+/** @} */
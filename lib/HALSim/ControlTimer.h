@@ -0,0 +1,123 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Control timer realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALSim
+ *
+ * @{
+ */
+
+#ifndef CONTROLTIMER_H
+#define CONTROLTIMER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IControlTimer.h"
+#include "SimTime.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The simulated control timer runs in the virtual simulation time.
+ * The callback is called after a simulation step, if its period elapsed.
+ * Sensor values change only with a simulation step, therefore the period
+ * can't be shorter than the simulation time step.
+ */
+class ControlTimer : public IControlTimer
+{
+public:
+    /**
+     * Constructs the control timer adapter.
+     *
+     * @param[in] simTime   Simulation time
+     */
+    ControlTimer(SimTime& simTime) :
+        IControlTimer(),
+        m_simTime(simTime),
+        m_period(0U),
+        m_callback(nullptr),
+        m_timestamp(0U)
+    {
+    }
+
+    /**
+     * Destroys the control timer adapter.
+     */
+    ~ControlTimer()
+    {
+    }
+
+    /**
+     * Start the timer.
+     *
+     * @param[in] period    Period in ms.
+     * @param[in] callback  Callback, which is called periodically.
+     */
+    void start(uint8_t period, Callback callback) final;
+
+    /**
+     * Stop the timer.
+     */
+    void stop() final;
+
+private:
+    SimTime&      m_simTime;   /**< Simulation time */
+    uint8_t       m_period;    /**< Period in ms */
+    Callback      m_callback;  /**< Callback, which is called periodically. */
+    unsigned long m_timestamp; /**< Simulation time of the last callback in ms. */
+
+    /**
+     * Called after every simulation step.
+     *
+     * @param[in] userData  The control timer instance.
+     */
+    static void onStep(void* userData);
+
+    /* Not allowed. */
+    ControlTimer(const ControlTimer& timer);            /**< Copy construction of an instance. */
+    ControlTimer& operator=(const ControlTimer& timer); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* CONTROLTIMER_H */
+/** @} */
@@ -46,7 +46,8 @@
 #include "IDisplay.h"
 
 #include <webots/Display.hpp>
-#include <string>
+#include <Format.h>
+#include <string.h>
 
 /******************************************************************************
  * Macros
@@ -128,18 +129,35 @@ public:
      */
     size_t print(const char str[]) final
     {
-        std::string text;
-        text = str;
+        size_t length = 0U;
 
-        if (nullptr != m_display)
+        if (nullptr != str)
         {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
+            length = strlen(str);
+
+            if (nullptr != m_display)
+            {
+                m_display->setColor(WHITE);
+                m_display->drawText(str, m_currX, m_currY);
+            }
+
+            gotoXY((m_lastX + length), m_lastY);
         }
 
-        gotoXY((m_lastX + text.length()), m_lastY);
+        return length;
+    }
 
-        return text.length();
+    /**
+     * Print the string from program memory to the display at the current cursor position.
+     * In the simulation there is no separate program memory.
+     *
+     * @param[in] str   String in program memory
+     *
+     * @return Printed number of characters
+     */
+    size_t print(const __FlashStringHelper* str) final
+    {
+        return print(reinterpret_cast<const char*>(str));
     }
 
     /**
@@ -151,18 +169,11 @@ public:
      */
     size_t print(uint8_t value) final
     {
-        std::string text;
-        text = std::to_string(value);
-
-        if (nullptr != m_display)
-        {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
-        }
+        char text[Format::MAX_VALUE_LENGTH + 1U];
 
-        gotoXY((m_lastX + text.length()), m_lastY);
+        (void)Format::uintToStr(text, sizeof(text), value);
 
-        return text.length();
+        return print(text);
     }
 
     /**
@@ -174,18 +185,11 @@ public:
      */
     size_t print(uint16_t value) final
     {
-        std::string text;
-        text = std::to_string(value);
+        char text[Format::MAX_VALUE_LENGTH + 1U];
 
-        if (nullptr != m_display)
-        {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
-        }
+        (void)Format::uintToStr(text, sizeof(text), value);
 
-        gotoXY((m_lastX + text.length()), m_lastY);
-
-        return text.length();
+        return print(text);
     }
 
     /**
@@ -197,18 +201,11 @@ public:
      */
     size_t print(uint32_t value) final
     {
-        std::string text;
-        text = std::to_string(value);
-
-        if (nullptr != m_display)
-        {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
-        }
+        char text[Format::MAX_VALUE_LENGTH + 1U];
 
-        gotoXY((m_lastX + text.length()), m_lastY);
+        (void)Format::uintToStr(text, sizeof(text), value);
 
-        return text.length();
+        return print(text);
     }
 
     /**
@@ -220,18 +217,11 @@ public:
      */
     size_t print(int8_t value) final
     {
-        std::string text;
-        text = std::to_string(value);
-
-        if (nullptr != m_display)
-        {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
-        }
+        char text[Format::MAX_VALUE_LENGTH + 1U];
 
-        gotoXY((m_lastX + text.length()), m_lastY);
+        (void)Format::intToStr(text, sizeof(text), value);
 
-        return text.length();
+        return print(text);
     }
 
     /**
@@ -243,18 +233,11 @@ public:
      */
     size_t print(int16_t value) final
     {
-        std::string text;
-        text = std::to_string(value);
-
-        if (nullptr != m_display)
-        {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
-        }
+        char text[Format::MAX_VALUE_LENGTH + 1U];
 
-        gotoXY((m_lastX + text.length()), m_lastY);
+        (void)Format::intToStr(text, sizeof(text), value);
 
-        return text.length();
+        return print(text);
     }
 
     /**
@@ -266,18 +249,11 @@ public:
      */
     size_t print(int32_t value) final
     {
-        std::string text;
-        text = std::to_string(value);
+        char text[Format::MAX_VALUE_LENGTH + 1U];
 
-        if (nullptr != m_display)
-        {
-            m_display->setColor(WHITE);
-            m_display->drawText(text, m_currX, m_currY);
-        }
+        (void)Format::intToStr(text, sizeof(text), value);
 
-        gotoXY((m_lastX + text.length()), m_lastY);
-        
-        return text.length();
+        return print(text);
     }
 
 private:
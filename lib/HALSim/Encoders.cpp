@@ -61,9 +61,12 @@
 
 void Encoders::init()
 {
+    /* The encoders are enabled right away, because the reference position is needed. */
+    int samplingPeriod = m_sampling.enable();
+
     if (nullptr != m_posSensorLeft)
     {
-        m_posSensorLeft->enable(m_simTime.getTimeStep());
+        m_posSensorLeft->enable(samplingPeriod);
         
         /* If robot reconnets, the position sensor will provide its position.
          * Ensure that the left encoder will start at 0.
@@ -73,7 +76,7 @@ void Encoders::init()
 
     if (nullptr != m_posSensorRight)
     {
-        m_posSensorRight->enable(m_simTime.getTimeStep());
+        m_posSensorRight->enable(samplingPeriod);
 
         /* If robot reconnets, the position sensor will provide its position.
          * Ensure that the right encoder will start at 0.
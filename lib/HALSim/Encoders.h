@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include "IEncoders.h"
 #include "SimTime.h"
+#include "SensorSampling.h"
 
 #include <webots/PositionSensor.hpp>
 
@@ -64,12 +65,14 @@ public:
      * Constructs the encoders adapter.
      *
      * @param[in] simTime               Simulation time
+     * @param[in] readPeriod            Period in ms, in which the application reads the encoders.
      * @param[in] posSensorLeft         The left position sensor
      * @param[in] posSensorRight        The right position sensor
      */
-    Encoders(const SimTime& simTime, webots::PositionSensor* posSensorLeft, webots::PositionSensor* posSensorRight) :
+    Encoders(const SimTime& simTime, uint32_t readPeriod, webots::PositionSensor* posSensorLeft,
+             webots::PositionSensor* posSensorRight) :
         IEncoders(),
-        m_simTime(simTime),
+        m_sampling(simTime, readPeriod),
         m_posSensorLeft(posSensorLeft),
         m_posSensorRight(posSensorRight),
         m_lastResetValueLeft(0.0f),
@@ -130,8 +133,8 @@ public:
     int16_t getCountsAndResetRight() final;
 
 private:
-    /** Simulation time */
-    const SimTime& m_simTime;
+    /** Sampling of the position sensors */
+    SensorSampling m_sampling;
 
     /** The position sensor of the left motor in the robot simulation. */
     webots::PositionSensor* m_posSensorLeft;
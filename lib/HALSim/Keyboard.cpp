@@ -62,7 +62,7 @@ void Keyboard::init()
 {
     if (nullptr != m_keyboard)
     {
-        m_keyboard->enable(m_simTime.getTimeStep());
+        m_keyboard->enable(m_sampling.enable());
     }
 }
 
@@ -48,6 +48,7 @@
 #include <webots/Robot.hpp>
 
 #include "SimTime.h"
+#include "SensorSampling.h"
 
 /******************************************************************************
  * Macros
@@ -62,13 +63,19 @@ class Keyboard
 {
 public:
     /**
-     * Constructs the encoders adapter and initialize it.
+     * Constructs the keyboard adapter and initialize it.
+     *
+     * @param[in] simTime       Simulation time
+     * @param[in] readPeriod    Period in ms, in which the keyboard is polled for new keys.
+     * @param[in] keyboard      Robot keyboard
      */
-    Keyboard(SimTime& simTime, webots::Keyboard* keyboard) :
+    Keyboard(SimTime& simTime, uint32_t readPeriod, webots::Keyboard* keyboard) :
         m_oldKeys(),
         m_newKeys(),
+        m_keyboard(keyboard),
         m_simTime(simTime),
-        m_keyboard(keyboard)
+        m_sampling(simTime, readPeriod),
+        m_lastPollTimestamp(0U)
     {
         init();
     }
@@ -93,18 +100,48 @@ public:
      */
     void getPressedButtons()
     {
-        /* Copying the new values into the old values array. */
+        unsigned long int timestamp = m_simTime.getElapsedTimeSinceReset();
+
+        /* Copying the new values into the old values array. This is done every
+         * call, so a key press or release is reported only once.
+         */
         for (uint8_t arrayIndex = 0; arrayIndex < (sizeof(m_oldKeys) / sizeof(*m_oldKeys)); ++arrayIndex)
         {
             m_oldKeys[arrayIndex] = m_newKeys[arrayIndex];
         }
 
-        /* Getting the new values. Currently the limit of the simulation is seven
-         * keypresses that can be detected simultaniously.
-         */
-        for (uint8_t keyIndex = 0; keyIndex < (sizeof(m_oldKeys) / sizeof(*m_oldKeys)); ++keyIndex)
+        /* Webots updates the keys only once per sampling period, poll them only then. */
+        if (static_cast<unsigned long int>(m_sampling.getSamplingPeriod()) <= (timestamp - m_lastPollTimestamp))
         {
-            m_newKeys[keyIndex] = m_keyboard->getKey();
+            bool isLastKey = false;
+
+            m_lastPollTimestamp = timestamp;
+
+            /* Getting the new values. Currently the limit of the simulation is seven
+             * keypresses that can be detected simultaniously. After the last pressed
+             * key, the keyboard is not asked anymore.
+             */
+            for (uint8_t keyIndex = 0; keyIndex < (sizeof(m_oldKeys) / sizeof(*m_oldKeys)); ++keyIndex)
+            {
+                if (true == isLastKey)
+                {
+                    m_newKeys[keyIndex] = NO_KEY;
+                }
+                else
+                {
+                    int key = m_keyboard->getKey();
+
+                    if (0 > key)
+                    {
+                        m_newKeys[keyIndex] = NO_KEY;
+                        isLastKey           = true;
+                    }
+                    else
+                    {
+                        m_newKeys[keyIndex] = static_cast<uint16_t>(key);
+                    }
+                }
+            }
         }
     }
 
@@ -244,6 +281,9 @@ private:
     /** The maximum number of keys pressed simultaniously, that the simulation can process. */
     static const uint8_t MAX_KEY_NUMBER = 7;
 
+    /** Value of a key slot without pressed key. */
+    static const uint16_t NO_KEY = UINT16_MAX;
+
     /** The keys presses during the last update. */
     uint16_t m_oldKeys[MAX_KEY_NUMBER];
 
@@ -254,6 +294,10 @@ private:
 
     SimTime& m_simTime; /**< Simulation time */
 
+    SensorSampling m_sampling; /**< Sampling of the keyboard. */
+
+    unsigned long int m_lastPollTimestamp; /**< Simulation time in ms of the last keyboard poll. */
+
     /**
      * Is the button pressed?
      *
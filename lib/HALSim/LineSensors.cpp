@@ -62,81 +62,33 @@ void LineSensors::init()
 {
     for (uint8_t sensorIndex = 0; sensorIndex < MAX_SENSORS; ++sensorIndex)
     {
+        m_rawValuesU16[sensorIndex]    = 0;
         m_sensorValuesU16[sensorIndex] = 0;
-        m_sensorMaxValues[sensorIndex] = 0;
-        m_sensorMinValues[sensorIndex] = SENSOR_MAX_VALUE;
-
-        if (nullptr != m_lightSensors[sensorIndex])
-        {
-            m_lightSensors[sensorIndex]->enable(m_simTime.getTimeStep());
-        }
     }
+
+    m_normalizer.clear();
 }
 
 void LineSensors::calibrate()
 {
-    (void)getSensorValues();
-
-    for (uint8_t sensorIndex = 0; sensorIndex < MAX_SENSORS; ++sensorIndex)
+    /* Calibrate only with real samples, otherwise the min. values would be wrong. */
+    if (true == readRawValues())
     {
-        if (m_sensorValuesU16[sensorIndex] < m_sensorMinValues[sensorIndex])
-        {
-            m_sensorMinValues[sensorIndex] = m_sensorValuesU16[sensorIndex];
-        }
-
-        if (m_sensorValuesU16[sensorIndex] > m_sensorMaxValues[sensorIndex])
-        {
-            m_sensorMaxValues[sensorIndex] = m_sensorValuesU16[sensorIndex];
-        }
+        m_normalizer.calibrate(m_rawValuesU16);
     }
-
-    m_sensorCalibStarted = true;
 }
 
 int16_t LineSensors::readLine()
 {
-    const uint32_t WEIGHT0      = 0;
-    const uint32_t WEIGHT1      = 1000;
-    const uint32_t WEIGHT2      = 2000;
-    const uint32_t WEIGHT3      = 3000;
-    const uint32_t WEIGHT4      = 4000;
-    uint32_t       estimatedPos = 0;
-
     (void)getSensorValues();
 
-    {
-        uint32_t numerator =    (WEIGHT0 * m_sensorValuesU16[0] +
-                                 WEIGHT1 * m_sensorValuesU16[1] +
-                                 WEIGHT2 * m_sensorValuesU16[2] +
-                                 WEIGHT3 * m_sensorValuesU16[3] +
-                                 WEIGHT4 * m_sensorValuesU16[4]);
-        uint32_t denominator = (m_sensorValuesU16[0] +
-                                m_sensorValuesU16[1] +
-                                m_sensorValuesU16[2] +
-                                m_sensorValuesU16[3] +
-                                m_sensorValuesU16[4]);
-
-        /* Check to avoid division by zero. */
-        if (0 == denominator)
-        {
-            denominator = 1;
-        }
-
-        estimatedPos = numerator / denominator;
-    }
-
-    return static_cast<int16_t>(estimatedPos);
+    return m_normalizer.estimatePosition(m_sensorValuesU16);
 }
 
 const uint16_t* LineSensors::getSensorValues()
 {
-    for (uint8_t sensorIndex = 0; sensorIndex < MAX_SENSORS; ++sensorIndex)
-    {
-        if (nullptr != m_lightSensors[sensorIndex])
-        {
-            m_sensorValuesU16[sensorIndex] = static_cast<uint16_t>(m_lightSensors[sensorIndex]->getValue());
-        }
-    }
+    (void)readRawValues();
+    m_normalizer.normalize(m_rawValuesU16, m_sensorValuesU16);
 
     return m_sensorValuesU16;
 }
@@ -147,7 +99,7 @@ bool LineSensors::isCalibrationSuccessful()
 
     m_calibErrorInfo = CALIB_ERROR_NOT_CALIBRATED;
 
-    if (true == m_sensorCalibStarted)
+    if (true == m_normalizer.isCalibrated())
     {
         uint8_t index = 0;
 
@@ -155,13 +107,15 @@ bool LineSensors::isCalibrationSuccessful()
         while ((MAX_SENSORS > index) && (true == isSuccessful))
         {
             uint16_t distance = 0;
+            uint16_t maxValue = m_normalizer.getMaxValue(index);
+            uint16_t minValue = m_normalizer.getMinValue(index);
 
             /* Check whether the max. value is really greater than the min. value.
              * It can happen that someone try to calibrate over a blank surface.
              */
-            if (m_sensorMaxValues[index] > m_sensorMinValues[index])
+            if (maxValue > minValue)
             {
-                distance = m_sensorMaxValues[index] - m_sensorMinValues[index];
+                distance = maxValue - minValue;
             }
 
             /* The assumption here is, that the distance (max. value - min. value) must be
@@ -188,6 +142,39 @@ bool LineSensors::isCalibrationSuccessful()
  * Private Methods
  *****************************************************************************/
 
+bool LineSensors::readRawValues()
+{
+    bool isUpdated = false;
+
+    if (false == m_sampling.isEnabled())
+    {
+        int samplingPeriod = m_sampling.enable();
+
+        for (uint8_t sensorIndex = 0; sensorIndex < MAX_SENSORS; ++sensorIndex)
+        {
+            if (nullptr != m_lightSensors[sensorIndex])
+            {
+                m_lightSensors[sensorIndex]->enable(samplingPeriod);
+            }
+        }
+    }
+
+    if (true == m_sampling.isSampleAvailable())
+    {
+        for (uint8_t sensorIndex = 0; sensorIndex < MAX_SENSORS; ++sensorIndex)
+        {
+            if (nullptr != m_lightSensors[sensorIndex])
+            {
+                m_rawValuesU16[sensorIndex] = static_cast<uint16_t>(m_lightSensors[sensorIndex]->getValue());
+            }
+        }
+
+        isUpdated = true;
+    }
+
+    return isUpdated;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
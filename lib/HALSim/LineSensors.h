@@ -45,7 +45,9 @@
  *****************************************************************************/
 #include "ILineSensors.h"
 #include "SimTime.h"
+#include "SensorSampling.h"
 
+#include <LineSensorNormalizer.hpp>
 #include <webots/Emitter.hpp>
 #include <webots/DistanceSensor.hpp>
 
@@ -65,6 +67,7 @@ public:
      * Constructs the line sensors adapter.
      *
      * @param[in] simTime       Simulation time
+     * @param[in] readPeriod    Period in ms, in which the application reads the line sensors.
      * @param[in] emitter0      The most left infrared emitter 0
      * @param[in] emitter1      The infrared emitter 1
      * @param[in] emitter2      The infrared emitter 2
@@ -76,20 +79,20 @@ public:
      * @param[in] lightSensor3  The light sensor 3
      * @param[in] lightSensor4  The most right light sensor 4
      */
-    LineSensors(const SimTime& simTime, webots::Emitter* emitter0, webots::Emitter* emitter1, webots::Emitter* emitter2,
-                webots::Emitter* emitter3, webots::Emitter* emitter4, webots::DistanceSensor* lightSensor0,
-                webots::DistanceSensor* lightSensor1, webots::DistanceSensor* lightSensor2,
-                webots::DistanceSensor* lightSensor3, webots::DistanceSensor* lightSensor4) :
+    LineSensors(const SimTime& simTime, uint32_t readPeriod, webots::Emitter* emitter0, webots::Emitter* emitter1,
+                webots::Emitter* emitter2, webots::Emitter* emitter3, webots::Emitter* emitter4,
+                webots::DistanceSensor* lightSensor0, webots::DistanceSensor* lightSensor1,
+                webots::DistanceSensor* lightSensor2, webots::DistanceSensor* lightSensor3,
+                webots::DistanceSensor* lightSensor4) :
         ILineSensors(),
-        m_simTime(simTime),
+        m_sampling(simTime, readPeriod),
+        m_rawValuesU16(),
         m_sensorValuesU16(),
         m_emitters{emitter0, emitter1, emitter2, emitter3, emitter4},
         m_lightSensors{lightSensor0, lightSensor1, lightSensor2, lightSensor3, lightSensor4},
         m_sensorCalibSuccessfull(false),
-        m_sensorCalibStarted(false),
         m_calibErrorInfo(CALIB_ERROR_NOT_CALIBRATED),
-        m_sensorMinValues(),
-        m_sensorMaxValues()
+        m_normalizer()
     {
     }
 
@@ -101,7 +104,7 @@ public:
     }
 
     /**
-     * Initializes the line sensors.
+     * Initializes the line sensors. The light sensors are enabled on first use.
      */
     void init() final;
 
@@ -135,7 +138,7 @@ public:
     int16_t readLine() final;
 
     /**
-     * Get last line sensor values.
+     * Get line sensor values, normalized by the calibration to 0 .. 1000.
      *
      * @return Line sensor values
      */
@@ -182,6 +185,45 @@ public:
         return SENSOR_MAX_VALUE;
     }
 
+    /**
+     * Get the calibrated min. raw value of a line sensor, which means white.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Min. raw value. If calibration was not done yet or the index is invalid, it will return 0.
+     */
+    uint16_t getCalibMinValue(uint8_t index) const final
+    {
+        return (true == m_normalizer.isCalibrated()) ? m_normalizer.getMinValue(index) : 0U;
+    }
+
+    /**
+     * Get the calibrated max. raw value of a line sensor, which means black.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Max. raw value. If calibration was not done yet or the index is invalid, it will return 0.
+     */
+    uint16_t getCalibMaxValue(uint8_t index) const final
+    {
+        return m_normalizer.getMaxValue(index);
+    }
+
+    /**
+     * Set the calibration, e.g. to continue with the calibration of a saved run.
+     * If every max. value is 0, the calibration is cleared.
+     *
+     * @param[in] minValues Calibrated min. raw values, one per sensor, see getCalibMinValue().
+     * @param[in] maxValues Calibrated max. raw values, one per sensor, see getCalibMaxValue().
+     */
+    void setCalibration(const uint16_t* minValues, const uint16_t* maxValues) final
+    {
+        m_normalizer.setCalibration(minValues, maxValues);
+
+        /* Update the calibration error information. */
+        (void)isCalibrationSuccessful();
+    }
+
 private:
     /**
      * Number of used line sensors. This depends on the Zumo hardware configuration.
@@ -194,18 +236,25 @@ private:
      */
     static const int16_t SENSOR_MAX_VALUE = 1000;
 
-    const SimTime&   m_simTime;                      /**< Simulation time */
+    SensorSampling   m_sampling;                     /**< Sampling of the light sensors. */
+    uint16_t         m_rawValuesU16[MAX_SENSORS];    /**< The last raw value of each sensor. */
     uint16_t         m_sensorValuesU16[MAX_SENSORS]; /**< The last value of each sensor as unsigned 16-bit values. */
     webots::Emitter* m_emitters[MAX_SENSORS];        /**< The infrared emitters (0: most left) */
     webots::DistanceSensor* m_lightSensors[MAX_SENSORS]; /**< The light sensors (0: most left) */
     bool                    m_sensorCalibSuccessfull; /**< Indicates weather the calibration was successfull or not. */
-    bool                    m_sensorCalibStarted;     /**< Indicates weather the calibration has started or not. */
     uint8_t  m_calibErrorInfo; /**< Indicates which sensor failed the calibration, if the calibration failed. */
-    uint16_t m_sensorMinValues[MAX_SENSORS]; /**< Stores the minimal calibration values for the sensors. */
-    uint16_t m_sensorMaxValues[MAX_SENSORS]; /**< Stores the minimal calibration values for the sensors. */
+    LineSensorNormalizer<MAX_SENSORS> m_normalizer; /**< Normalizes the sensor values, same as on the target. */
 
     /* Default constructor not allowed. */
     LineSensors();
+
+    /**
+     * Read the raw values of all light sensors. The light sensors are enabled
+     * on the first call.
+     *
+     * @return If the raw values are updated, it will return true otherwise false.
+     */
+    bool readRawValues();
 };
 
 /******************************************************************************
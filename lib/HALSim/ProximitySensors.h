@@ -44,6 +44,7 @@
  *****************************************************************************/
 #include "IProximitySensors.h"
 #include "SimTime.h"
+#include "SensorSampling.h"
 
 #include <webots/DistanceSensor.hpp>
 
@@ -61,10 +62,16 @@ class ProximitySensors : public IProximitySensors
 public:
     /**
      * Constructs the interface.
+     *
+     * @param[in] simTime       Simulation time
+     * @param[in] readPeriod    Period in ms, in which the application reads the proximity sensors.
+     * @param[in] proxSensor0   The front left proximity sensor
+     * @param[in] proxSensor1   The front right proximity sensor
      */
-    ProximitySensors(const SimTime& simTime, webots::DistanceSensor* proxSensor0, webots::DistanceSensor* proxSensor1) :
+    ProximitySensors(const SimTime& simTime, uint32_t readPeriod, webots::DistanceSensor* proxSensor0,
+                     webots::DistanceSensor* proxSensor1) :
         IProximitySensors(),
-        m_simTime(simTime),
+        m_sampling(simTime, readPeriod),
         m_proximitySensors{proxSensor0, proxSensor1},
         m_sensorValuesU8{0U}
     {
@@ -78,7 +85,7 @@ public:
     }
 
     /**
-     * Initialize only the front proximity sensor.
+     * Initialize only the front proximity sensor. The sensors are enabled on first read.
      */
     void initFrontSensor() final;
 
@@ -98,11 +105,27 @@ public:
      */
     void read() final
     {
-        for (uint8_t sensorIndex = 0U; sensorIndex < MAX_SENSORS; ++sensorIndex)
+        if (false == m_sampling.isEnabled())
+        {
+            int samplingPeriod = m_sampling.enable();
+
+            for (uint8_t sensorIndex = 0U; sensorIndex < MAX_SENSORS; ++sensorIndex)
+            {
+                if (nullptr != m_proximitySensors[sensorIndex])
+                {
+                    m_proximitySensors[sensorIndex]->enable(samplingPeriod);
+                }
+            }
+        }
+
+        if (true == m_sampling.isSampleAvailable())
         {
-            if (nullptr != m_proximitySensors[sensorIndex])
+            for (uint8_t sensorIndex = 0U; sensorIndex < MAX_SENSORS; ++sensorIndex)
             {
-                m_sensorValuesU8[sensorIndex] = static_cast<uint8_t>(m_proximitySensors[sensorIndex]->getValue());
+                if (nullptr != m_proximitySensors[sensorIndex])
+                {
+                    m_sensorValuesU8[sensorIndex] = static_cast<uint8_t>(m_proximitySensors[sensorIndex]->getValue());
+                }
             }
         }
     }
@@ -164,9 +187,9 @@ private:
     };
 
     /**
-     * Simulation time
+     * Sampling of the proximity sensors
      */
-    const SimTime& m_simTime;
+    SensorSampling m_sampling;
 
     /**
      * The frontal proximity sensors
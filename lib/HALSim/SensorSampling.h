@@ -0,0 +1,159 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sampling of a simulated sensor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup HALSim
+ *
+ * @{
+ */
+
+#ifndef SENSOR_SAMPLING_H
+#define SENSOR_SAMPLING_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "SimTime.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Keeps the sampling state of a simulated sensor, which is enabled lazy on
+ * first use with a sampling period derived from the application read period.
+ * A sensor, which the application never reads, is never computed by Webots.
+ *
+ * After enabling, Webots provides the first sample after one sampling period.
+ * Until then the sensor values are not available.
+ */
+class SensorSampling
+{
+public:
+    /**
+     * Constructs the sensor sampling.
+     *
+     * @param[in] simTime       Simulation time
+     * @param[in] readPeriod    Period in ms, in which the application reads the sensor.
+     */
+    SensorSampling(const SimTime& simTime, uint32_t readPeriod) :
+        m_simTime(simTime),
+        m_readPeriod(readPeriod),
+        m_isEnabled(false),
+        m_enableTimestamp(0U)
+    {
+    }
+
+    /**
+     * Destroys the sensor sampling.
+     */
+    ~SensorSampling()
+    {
+    }
+
+    /**
+     * Is the sensor enabled?
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isEnabled() const
+    {
+        return m_isEnabled;
+    }
+
+    /**
+     * Mark the sensor as enabled. The caller shall enable the Webots devices
+     * with the returned sampling period.
+     *
+     * @return Sampling period in ms
+     */
+    int enable()
+    {
+        m_isEnabled       = true;
+        m_enableTimestamp = m_simTime.getElapsedTimeSinceReset();
+
+        return getSamplingPeriod();
+    }
+
+    /**
+     * Get the sampling period.
+     *
+     * @return Sampling period in ms
+     */
+    int getSamplingPeriod() const
+    {
+        return m_simTime.getSamplingPeriod(m_readPeriod);
+    }
+
+    /**
+     * Is a sample available? This is the case one sampling period after enabling.
+     *
+     * @return If available, it will return true otherwise false.
+     */
+    bool isSampleAvailable() const
+    {
+        bool isAvailable = false;
+
+        if (true == m_isEnabled)
+        {
+            unsigned long int elapsed = m_simTime.getElapsedTimeSinceReset() - m_enableTimestamp;
+
+            isAvailable = (static_cast<unsigned long int>(getSamplingPeriod()) <= elapsed);
+        }
+
+        return isAvailable;
+    }
+
+private:
+    const SimTime&    m_simTime;         /**< Simulation time */
+    uint32_t          m_readPeriod;      /**< Period in ms, in which the application reads the sensor. */
+    bool              m_isEnabled;       /**< Is the sensor enabled? */
+    unsigned long int m_enableTimestamp; /**< Simulation time in ms, when the sensor was enabled. */
+
+    /* Not allowed. */
+    SensorSampling();                                          /**< Default construction of an instance. */
+    SensorSampling(const SensorSampling& sampling);            /**< Copy construction of an instance. */
+    SensorSampling& operator=(const SensorSampling& sampling); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SENSOR_SAMPLING_H */
+/** @} */
@@ -0,0 +1,135 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Non-volatile settings realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Settings.h"
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+const char* Settings::FILE_NAME = "settings.bin";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool Settings::read(uint16_t address, void* data, uint16_t size)
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != data) && (SIZE >= size) && ((SIZE - size) >= address))
+    {
+        load();
+        memcpy(data, &m_image[address], size);
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool Settings::write(uint16_t address, const void* data, uint16_t size)
+{
+    bool isSuccessful = false;
+
+    if ((nullptr != data) && (SIZE >= size) && ((SIZE - size) >= address))
+    {
+        FILE* file = nullptr;
+
+        load();
+        memcpy(&m_image[address], data, size);
+
+        file = fopen(FILE_NAME, "wb");
+
+        if (nullptr != file)
+        {
+            isSuccessful = (SIZE == fwrite(m_image, 1U, SIZE, file));
+            (void)fclose(file);
+        }
+    }
+
+    return isSuccessful;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void Settings::load()
+{
+    if (false == m_isLoaded)
+    {
+        FILE* file = fopen(FILE_NAME, "rb");
+
+        /* Like an erased EEPROM. */
+        memset(m_image, 0xFF, sizeof(m_image));
+
+        if (nullptr != file)
+        {
+            (void)fread(m_image, 1U, SIZE, file);
+            (void)fclose(file);
+        }
+
+        m_isLoaded = true;
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
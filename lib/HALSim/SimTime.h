@@ -43,6 +43,7 @@
 /******************************************************************************
  * Includes
  *****************************************************************************/
+#include <stdint.h>
 #include <webots/Robot.hpp>
 
 /******************************************************************************
@@ -61,6 +62,13 @@
 class SimTime
 {
 public:
+    /**
+     * Callback, which is called after every simulation step.
+     *
+     * @param[in] userData  User data
+     */
+    typedef void (*StepCallback)(void* userData);
+
     /**
      * Construct simulation time handler.
      *
@@ -69,7 +77,9 @@ public:
     SimTime(webots::Robot& robot) :
         m_robot(robot),
         m_timeStep(static_cast<int>(m_robot.getBasicTimeStep())),
-        m_elapsedTimeSinceReset(0)
+        m_elapsedTimeSinceReset(0),
+        m_stepCallback(nullptr),
+        m_stepUserData(nullptr)
     {
     }
 
@@ -92,6 +102,11 @@ public:
         int result = m_robot.step(m_timeStep);
         m_elapsedTimeSinceReset += m_timeStep;
 
+        if (nullptr != m_stepCallback)
+        {
+            m_stepCallback(m_stepUserData);
+        }
+
         return (-1 != result);
     }
 
@@ -105,6 +120,29 @@ public:
         return m_timeStep;
     }
 
+    /**
+     * Get the sampling period of a sensor, which the application reads with
+     * the given period. It is the longest multiple of the basic time step,
+     * which is not longer than the read period, but at least one time step.
+     * Webots computes the sensor only once per sampling period, which speeds
+     * up the simulation for sensors the application reads rarely.
+     *
+     * @param[in] readPeriod    Period in [ms], in which the application reads the sensor.
+     *
+     * @return Sampling period [ms]
+     */
+    int getSamplingPeriod(uint32_t readPeriod) const
+    {
+        uint32_t steps = readPeriod / static_cast<uint32_t>(m_timeStep);
+
+        if (0U == steps)
+        {
+            steps = 1U;
+        }
+
+        return static_cast<int>(steps) * m_timeStep;
+    }
+
     /**
      * Get the elapsed time since reset in [ms].
      *
@@ -115,10 +153,36 @@ public:
         return m_elapsedTimeSinceReset;
     }
 
+    /**
+     * Set the elapsed time since reset in [ms].
+     * It is used to continue a checkpointed run at its virtual time.
+     *
+     * @param[in] elapsedTimeSinceReset Elapsed time since reset [ms]
+     */
+    void setElapsedTimeSinceReset(unsigned long int elapsedTimeSinceReset)
+    {
+        m_elapsedTimeSinceReset = elapsedTimeSinceReset;
+    }
+
+    /**
+     * Set the callback, which is called after every simulation step.
+     * It emulates timer interrupts in the virtual simulation time.
+     *
+     * @param[in] callback  Callback, use nullptr to remove it.
+     * @param[in] userData  User data, which is passed to the callback.
+     */
+    void setStepCallback(StepCallback callback, void* userData)
+    {
+        m_stepCallback = callback;
+        m_stepUserData = userData;
+    }
+
 private:
     webots::Robot&    m_robot;                 /**< Simulation environment, used to step the simulation forward. */
     int               m_timeStep;              /**< Time in ms of one simulation step. */
     unsigned long int m_elapsedTimeSinceReset; /**< Elapsed time since reset in [ms] */
+    StepCallback      m_stepCallback;          /**< Callback, which is called after every simulation step. */
+    void*             m_stepUserData;          /**< User data of the step callback. */
 };
 
 /******************************************************************************
@@ -0,0 +1,125 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Watchdog realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALSim
+ *
+ * @{
+ */
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IWatchdog.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The simulated watchdog. If the main loop hangs in the simulation, the simulation
+ * time stops too and the robot doesn't move anymore. Therefore it just keeps
+ * whether it is enabled.
+ */
+class Watchdog : public IWatchdog
+{
+public:
+    /**
+     * Constructs the watchdog adapter.
+     */
+    Watchdog() : IWatchdog(), m_isEnabled(false)
+    {
+    }
+
+    /**
+     * Destroys the watchdog adapter.
+     */
+    ~Watchdog()
+    {
+    }
+
+    /**
+     * Enables the watchdog. If it is not triggered within the timeout,
+     * the motors are stopped and the robot is reset.
+     *
+     * @param[in] timeout   Min. timeout in ms.
+     */
+    void enable(uint16_t timeout) final
+    {
+        (void)timeout;
+        m_isEnabled = true;
+    }
+
+    /**
+     * Disables the watchdog.
+     */
+    void disable() final
+    {
+        m_isEnabled = false;
+    }
+
+    /**
+     * Triggers the watchdog, which restarts its timeout.
+     */
+    void trigger() final
+    {
+        /* Nothing to do. */
+    }
+
+    /**
+     * Is the watchdog enabled?
+     *
+     * @return If enabled, it will return true otherwise false.
+     */
+    bool isEnabled() const
+    {
+        return m_isEnabled;
+    }
+
+private:
+    bool m_isEnabled; /**< Is the watchdog enabled? */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* WATCHDOG_H */
+/** @} */
@@ -0,0 +1,148 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Control timer realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ControlTimer.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Callback, which is called periodically. */
+static volatile IControlTimer::Callback gCallback = nullptr;
+
+/** Period in timer 0 overflows. */
+static volatile uint8_t gPeriod = 0U;
+
+/** Number of timer 0 overflows since the last callback. */
+static volatile uint8_t gTickCnt = 0U;
+
+/**
+ * Compare value of timer 0 for the interrupt. It is half way between two
+ * overflows to keep the millis() interrupt and the callback apart.
+ */
+static const uint8_t COMPARE_VALUE = 128U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void ControlTimer::start(uint8_t period, Callback callback)
+{
+    uint8_t sreg = SREG;
+
+    cli();
+
+    gCallback = callback;
+    gPeriod   = period;
+    gTickCnt  = 0U;
+
+    OCR0B = COMPARE_VALUE;
+    TIFR0 = _BV(OCF0B);
+    TIMSK0 |= _BV(OCIE0B);
+
+    SREG = sreg;
+}
+
+void ControlTimer::stop()
+{
+    uint8_t sreg = SREG;
+
+    cli();
+
+    TIMSK0 &= ~_BV(OCIE0B);
+    gCallback = nullptr;
+
+    SREG = sreg;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Timer 0 compare match B interrupt service routine.
+ */
+ISR(TIMER0_COMPB_vect)
+{
+    IControlTimer::Callback callback = gCallback;
+
+    ++gTickCnt;
+
+    if ((gPeriod <= gTickCnt) && (nullptr != callback))
+    {
+        gTickCnt = 0U;
+
+        /* The callback may take a while. Other interrupts, e.g. of the encoders and
+         * millis(), shall not be delayed by it. This interrupt is disabled meanwhile,
+         * so it doesn't nest itself.
+         */
+        TIMSK0 &= ~_BV(OCIE0B);
+        sei();
+
+        callback();
+
+        cli();
+        TIMSK0 |= _BV(OCIE0B);
+    }
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
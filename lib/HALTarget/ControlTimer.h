@@ -0,0 +1,101 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Control timer realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALTarget
+ *
+ * @{
+ */
+
+#ifndef CONTROLTIMER_H
+#define CONTROLTIMER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IControlTimer.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * This class provides a control timer on the ATmega32U4.
+ * Timer 0 is already used by millis() and overflows every 1.024 ms. The
+ * control timer shares it by its compare match B interrupt, so no other
+ * timer is used. Timer 1 drives the motors, timer 3 the IR pulses of the
+ * proximity sensors and timer 4 the buzzer.
+ */
+class ControlTimer : public IControlTimer
+{
+public:
+    /**
+     * Constructs the control timer adapter.
+     */
+    ControlTimer() : IControlTimer()
+    {
+    }
+
+    /**
+     * Destroys the control timer adapter.
+     */
+    ~ControlTimer()
+    {
+    }
+
+    /**
+     * Start the timer.
+     *
+     * @param[in] period    Period in ms. One ms is 1.024 ms on target.
+     * @param[in] callback  Callback, which is called periodically.
+     */
+    void start(uint8_t period, Callback callback) final;
+
+    /**
+     * Stop the timer.
+     */
+    void stop() final;
+
+private:
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* CONTROLTIMER_H */
+/** @} */
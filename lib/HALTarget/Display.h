@@ -103,6 +103,18 @@ public:
         return m_lcd.print(str);
     }
 
+    /**
+     * Print the string from program memory to the display at the current cursor position.
+     *
+     * @param[in] str   String in program memory
+     *
+     * @return Printed number of characters
+     */
+    size_t print(const __FlashStringHelper* str) final
+    {
+        return m_lcd.print(str);
+    }
+
     /**
      * Print the unsigned 8-bit value to the display at the current cursor position.
      *
@@ -0,0 +1,103 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  CPU idle realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALTarget
+ *
+ * @{
+ */
+
+#ifndef IDLE_H
+#define IDLE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IIdle.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * This class puts the ATmega32U4 in idle sleep mode. The CPU clock is halted,
+ * while the timers, USB and pin change interrupts keep running. The timer 0
+ * overflow, which drives millis(), wakes it up at the latest after ~1 ms.
+ */
+class Idle : public IIdle
+{
+public:
+    /**
+     * Constructs the idle adapter.
+     */
+    Idle() : IIdle()
+    {
+    }
+
+    /**
+     * Destroys the idle adapter.
+     */
+    ~Idle()
+    {
+    }
+
+    /**
+     * Sleeps the CPU until the next interrupt wakes it up.
+     * The peripherals and timers keep running.
+     */
+    void sleep() final;
+
+    /**
+     * Get the scheduling quantum of the main loop.
+     * On the target the main loop runs continuously.
+     *
+     * @return Scheduling quantum in us, 0 if the main loop runs continuously.
+     */
+    uint32_t getLoopQuantum() const final
+    {
+        return 0U;
+    }
+
+private:
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* IDLE_H */
+/** @} */
@@ -58,16 +58,48 @@
  * Public Methods
  *****************************************************************************/
 
+void LineSensors::calibrate()
+{
+    uint16_t highestValues[MAX_SENSORS];
+    uint16_t lowestValues[MAX_SENSORS];
+    uint8_t  readIdx = 0;
+    uint8_t  index   = 0;
+
+    for (readIdx = 0; readIdx < CALIB_READS; ++readIdx)
+    {
+        /* The environment brightness compensation is enabled and must be considered
+         * during calibration as well.
+         * See LineSensors::readLine()
+         */
+        readRawValues();
+
+        for (index = 0; index < MAX_SENSORS; ++index)
+        {
+            if ((0 == readIdx) || (highestValues[index] < m_rawValuesU16[index]))
+            {
+                highestValues[index] = m_rawValuesU16[index];
+            }
+
+            if ((0 == readIdx) || (lowestValues[index] > m_rawValuesU16[index]))
+            {
+                lowestValues[index] = m_rawValuesU16[index];
+            }
+        }
+    }
+
+    /* The min. value is only lowered, if even the highest read is lower and
+     * the max. value is only raised, if even the lowest read is higher.
+     */
+    m_normalizer.calibrate(highestValues, lowestValues);
+}
+
 bool LineSensors::isCalibrationSuccessful()
 {
     bool isSuccessful = false;
 
     m_calibErrorInfo = CALIB_ERROR_NOT_CALIBRATED;
 
-    if ((nullptr != m_lineSensors.calibratedMinimumOn) &&
-        (nullptr != m_lineSensors.calibratedMaximumOn) &&
-        (nullptr != m_lineSensors.calibratedMinimumOff) &&
-        (nullptr != m_lineSensors.calibratedMaximumOff))
+    if (true == m_normalizer.isCalibrated())
     {
         uint8_t index = 0;
 
@@ -75,13 +107,15 @@ bool LineSensors::isCalibrationSuccessful()
         while((MAX_SENSORS > index) && (true == isSuccessful))
         {
             uint16_t distance = 0;
+            uint16_t maxValue = m_normalizer.getMaxValue(index);
+            uint16_t minValue = m_normalizer.getMinValue(index);
             
             /* Check whether the max. value is really greater than the min. value.
              * It can happen that someone try to calibrate over a blank surface.
              */
-            if (m_lineSensors.calibratedMaximumOn[index] > m_lineSensors.calibratedMinimumOn[index])
+            if (maxValue > minValue)
             {
-                distance = m_lineSensors.calibratedMaximumOn[index] - m_lineSensors.calibratedMinimumOn[index];
+                distance = maxValue - minValue;
             }
 
             /* The assumption here is, that the distance (max. value - min. value) must be
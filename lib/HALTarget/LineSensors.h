@@ -45,6 +45,7 @@
  *****************************************************************************/
 #include "ILineSensors.h"
 #include "Zumo32U4.h"
+#include <LineSensorNormalizer.hpp>
 
 /******************************************************************************
  * Macros
@@ -61,7 +62,14 @@ public:
     /**
      * Constructs the line sensors adapter.
      */
-    LineSensors() : ILineSensors(), m_sensorValues(), m_sensorValuesU16(), m_calibErrorInfo(CALIB_ERROR_NOT_CALIBRATED)
+    LineSensors() :
+        ILineSensors(),
+        m_lineSensors(),
+        m_sensorValues(),
+        m_rawValuesU16(),
+        m_sensorValuesU16(),
+        m_calibErrorInfo(CALIB_ERROR_NOT_CALIBRATED),
+        m_normalizer()
     {
     }
 
@@ -78,6 +86,7 @@ public:
     void init() final
     {
         m_lineSensors.initFiveSensors();
+        m_normalizer.clear();
     }
 
     /**
@@ -85,16 +94,13 @@ public:
      * turning the sensors over the line to determine the minimum and maximum
      * values.
      *
+     * Like the Pololu library, every call reads the sensors several times.
+     * A calibration limit is only moved, if all reads agree, which rejects
+     * single noisy reads.
+     *
      * The calibration factors are stored internally.
      */
-    void calibrate() final
-    {
-        /* The environment brightness compensation is enabled and must be considered
-         * during calibration as well.
-         * See LineSensors::readLine()
-         */
-        m_lineSensors.calibrate(QTR_EMITTERS_ON_AND_OFF);
-    }
+    void calibrate() final;
 
     /**
      * Determines the deviation and returns an estimated position of the robot
@@ -116,29 +122,19 @@ public:
      */
     int16_t readLine() final
     {
-        /* The environment brightness compensation is enabled by using QTR_EMITTERS_ON_AND_OFF.
-         * This is done by measuring the sensor on values with enabled IR emitters. After that
-         * the IR emitters are disabled and the sensor off values are measured.
-         * The compensation is quite simple: compenstated value = on value - off value
-         */
-        return m_lineSensors.readLine(m_sensorValues, QTR_EMITTERS_ON_AND_OFF);
+        readRawValues();
+        m_normalizer.normalize(m_rawValuesU16, m_sensorValuesU16);
+
+        return m_normalizer.estimatePosition(m_sensorValuesU16);
     }
 
     /**
-     * Get last line sensor values.
+     * Get last line sensor values, normalized by the calibration to 0 .. 1000.
      *
      * @return Line sensor values
      */
     const uint16_t* getSensorValues() final
     {
-        uint8_t index = 0;
-
-        /* This is only done to be able to provide a platform independed data type. */
-        for (index = 0; index < MAX_SENSORS; ++index)
-        {
-            m_sensorValuesU16[index] = static_cast<uint16_t>(m_sensorValues[index]);
-        }
-
         return m_sensorValuesU16;
     }
 
@@ -183,6 +179,45 @@ public:
         return SENSOR_MAX_VALUE;
     }
 
+    /**
+     * Get the calibrated min. raw value of a line sensor, which means white.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Min. raw value. If calibration was not done yet or the index is invalid, it will return 0.
+     */
+    uint16_t getCalibMinValue(uint8_t index) const final
+    {
+        return (true == m_normalizer.isCalibrated()) ? m_normalizer.getMinValue(index) : 0U;
+    }
+
+    /**
+     * Get the calibrated max. raw value of a line sensor, which means black.
+     *
+     * @param[in] index Sensor index, starting with 0.
+     *
+     * @return Max. raw value. If calibration was not done yet or the index is invalid, it will return 0.
+     */
+    uint16_t getCalibMaxValue(uint8_t index) const final
+    {
+        return m_normalizer.getMaxValue(index);
+    }
+
+    /**
+     * Set the calibration, e.g. to continue with the calibration of a saved run.
+     * If every max. value is 0, the calibration is cleared.
+     *
+     * @param[in] minValues Calibrated min. raw values, one per sensor, see getCalibMinValue().
+     * @param[in] maxValues Calibrated max. raw values, one per sensor, see getCalibMaxValue().
+     */
+    void setCalibration(const uint16_t* minValues, const uint16_t* maxValues) final
+    {
+        m_normalizer.setCalibration(minValues, maxValues);
+
+        /* Update the calibration error information. */
+        (void)isCalibrationSuccessful();
+    }
+
 private:
     /**
      * Number of used line sensors. This depends on the Zumo hardware configuration.
@@ -191,8 +226,7 @@ private:
 
     /**
      * Max. value of a single line sensor in digits (calibration already considered).
-     * It depends on the Zumo32U4LineSensors implementation.
-     * See Zumo32U4\QTRSensors.cpp @ readCalibrated()
+     * See LineSensorNormalizer::NORMALIZED_MAX
      */
     static const int16_t    SENSOR_MAX_VALUE    = 1000;
 
@@ -204,10 +238,41 @@ private:
      */
     static const uint16_t   MEASURE_DURATION    = 2000;
 
+    /**
+     * Number of reads per calibration step.
+     * See Zumo32U4\QTRSensors.cpp @ calibrateOnOrOff()
+     */
+    static const uint8_t    CALIB_READS         = 10;
+
     Zumo32U4LineSensors m_lineSensors;                  /**< Zumo line sensors driver from Pololu */
-    unsigned int        m_sensorValues[MAX_SENSORS];    /**< The last value of each sensor. */
+    unsigned int        m_sensorValues[MAX_SENSORS];    /**< The last raw value of each sensor. */
+    uint16_t            m_rawValuesU16[MAX_SENSORS];    /**< The last raw value of each sensor as 16-bit value. */
     uint16_t            m_sensorValuesU16[MAX_SENSORS]; /**< The last value of each sensor as unsigned 16-bit values. */
     uint8_t             m_calibErrorInfo;               /**< Calibration error information. */
+
+    /** Normalizes the sensor values, same as in the simulation. */
+    LineSensorNormalizer<MAX_SENSORS> m_normalizer;
+
+    /**
+     * Read the raw values of all sensors.
+     *
+     * The environment brightness compensation is enabled by using QTR_EMITTERS_ON_AND_OFF.
+     * This is done by measuring the sensor on values with enabled IR emitters. After that
+     * the IR emitters are disabled and the sensor off values are measured.
+     * The compensation is quite simple: compenstated value = on value - off value
+     */
+    void readRawValues()
+    {
+        uint8_t index = 0;
+
+        m_lineSensors.read(m_sensorValues, QTR_EMITTERS_ON_AND_OFF);
+
+        /* This is only done to be able to provide a platform independed data type. */
+        for (index = 0; index < MAX_SENSORS; ++index)
+        {
+            m_rawValuesU16[index] = static_cast<uint16_t>(m_sensorValues[index]);
+        }
+    }
 };
 
 /******************************************************************************
@@ -0,0 +1,120 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Non-volatile settings realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALTarget
+ *
+ * @{
+ */
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ISettings.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * This class stores the settings in the ATmega32U4 EEPROM.
+ * Only changed bytes are written, which saves EEPROM write cycles.
+ */
+class Settings : public ISettings
+{
+public:
+    /**
+     * Constructs the settings adapter.
+     */
+    Settings() : ISettings()
+    {
+    }
+
+    /**
+     * Destroys the settings adapter.
+     */
+    ~Settings()
+    {
+    }
+
+    /**
+     * Get the size of the settings memory.
+     *
+     * @return Size in byte
+     */
+    uint16_t getSize() const final
+    {
+        return SIZE;
+    }
+
+    /**
+     * Read data from the settings memory.
+     *
+     * @param[in]   address Address of the first byte
+     * @param[out]  data    Data buffer
+     * @param[in]   size    Number of bytes to read
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool read(uint16_t address, void* data, uint16_t size) final;
+
+    /**
+     * Write data to the settings memory.
+     * Note, the write may block for several milliseconds.
+     *
+     * @param[in] address   Address of the first byte
+     * @param[in] data      Data
+     * @param[in] size      Number of bytes to write
+     *
+     * @return If successful, it will return true otherwise false.
+     */
+    bool write(uint16_t address, const void* data, uint16_t size) final;
+
+private:
+    /** EEPROM size in byte. */
+    static const uint16_t SIZE = 1024U;
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SETTINGS_H */
+/** @} */
@@ -0,0 +1,180 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Watchdog realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Watchdog.h"
+#include "Zumo32U4.h"
+#include <avr/wdt.h>
+#include <avr/interrupt.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint8_t getPrescaler(uint16_t timeout);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void Watchdog::enable(uint16_t timeout)
+{
+    uint8_t sreg = SREG;
+
+    cli();
+    wdt_reset();
+    wdt_enable(getPrescaler(timeout));
+
+    /* The first timeout calls the interrupt service routine, which stops the
+     * motors. The hardware clears the interrupt enable with it, so the next
+     * timeout resets the robot. A trigger re-arms the interrupt.
+     */
+    WDTCSR |= _BV(WDIE);
+    SREG = sreg;
+}
+
+void Watchdog::disable()
+{
+    wdt_disable();
+}
+
+void Watchdog::trigger()
+{
+    wdt_reset();
+
+    /* The main loop is alive again after a timeout interrupt, e.g. after a long
+     * blocking call. Re-arm the interrupt, so the next hang stops the motors
+     * again before the reset. Only in reset mode, otherwise the interrupt would
+     * enable the watchdog.
+     */
+    if (0U != (WDTCSR & _BV(WDE)))
+    {
+        WDTCSR |= _BV(WDIE);
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Watchdog timeout interrupt service routine.
+ * The main loop hangs, therefore stop the motors immediately.
+ */
+ISR(WDT_vect)
+{
+    Zumo32U4Motors::setSpeeds(0, 0);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get the watchdog prescaler for the timeout.
+ *
+ * @param[in] timeout   Min. timeout in ms
+ *
+ * @return Watchdog prescaler, see WDTO_xxx.
+ */
+static uint8_t getPrescaler(uint16_t timeout)
+{
+    uint8_t prescaler = WDTO_8S;
+
+    if (15U >= timeout)
+    {
+        prescaler = WDTO_15MS;
+    }
+    else if (30U >= timeout)
+    {
+        prescaler = WDTO_30MS;
+    }
+    else if (60U >= timeout)
+    {
+        prescaler = WDTO_60MS;
+    }
+    else if (120U >= timeout)
+    {
+        prescaler = WDTO_120MS;
+    }
+    else if (250U >= timeout)
+    {
+        prescaler = WDTO_250MS;
+    }
+    else if (500U >= timeout)
+    {
+        prescaler = WDTO_500MS;
+    }
+    else if (1000U >= timeout)
+    {
+        prescaler = WDTO_1S;
+    }
+    else if (2000U >= timeout)
+    {
+        prescaler = WDTO_2S;
+    }
+    else if (4000U >= timeout)
+    {
+        prescaler = WDTO_4S;
+    }
+    else
+    {
+        ;
+    }
+
+    return prescaler;
+}
@@ -0,0 +1,105 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Watchdog realization
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup HALTarget
+ *
+ * @{
+ */
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "IWatchdog.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * This class provides access to the ATmega32U4 watchdog.
+ * It runs in interrupt and system reset mode: the first timeout stops the motors
+ * in the interrupt, the next one resets the robot.
+ */
+class Watchdog : public IWatchdog
+{
+public:
+    /**
+     * Constructs the watchdog adapter.
+     */
+    Watchdog() : IWatchdog()
+    {
+    }
+
+    /**
+     * Destroys the watchdog adapter.
+     */
+    ~Watchdog()
+    {
+    }
+
+    /**
+     * Enables the watchdog. If it is not triggered within the timeout,
+     * the motors are stopped and the robot is reset.
+     *
+     * @param[in] timeout   Min. timeout in ms. It is rounded up to the next timeout the hardware supports.
+     */
+    void enable(uint16_t timeout) final;
+
+    /**
+     * Disables the watchdog.
+     */
+    void disable() final;
+
+    /**
+     * Triggers the watchdog, which restarts its timeout. If the timeout
+     * interrupt stopped the motors before, it is re-armed.
+     */
+    void trigger() final;
+
+private:
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* WATCHDOG_H */
+/** @} */
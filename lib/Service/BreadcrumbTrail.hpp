@@ -0,0 +1,303 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Breadcrumb trail of the travelled path
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef BREADCRUMB_TRAIL_HPP
+#define BREADCRUMB_TRAIL_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <FPMath.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Records the travelled path as breadcrumb trail. A breadcrumb is the pose,
+ * sampled every time the robot travelled a fixed distance. The breadcrumbs
+ * are collected in path frames, where the first one is absolute and the
+ * following are delta encoded.
+ *
+ * Every breadcrumb gets a sequence number, which allows the receiver to
+ * detect lost frames.
+ *
+ * The path frame is defined by the application protocol. It needs the fields
+ * sequenceNumber, count, xPos, yPos, orientation and the array deltas, whose
+ * elements have the fields xPos, yPos (int8_t) and orientation (int16_t).
+ *
+ * @tparam TFrame       The path frame type.
+ * @tparam tMaxDeltas   The number of delta encoded breadcrumbs in a path frame.
+ */
+template<typename TFrame, uint8_t tMaxDeltas>
+class BreadcrumbTrail
+{
+public:
+    /** Travelled distance between two breadcrumbs in mm. */
+    static const uint32_t SAMPLE_DISTANCE = 20U;
+
+    /** Maximum number of breadcrumbs in a path frame. */
+    static const uint8_t MAX_BREADCRUMBS = 1U + tMaxDeltas;
+
+    /**
+     * Constructs the breadcrumb trail.
+     */
+    BreadcrumbTrail() :
+        m_frame(),
+        m_readyFrame(),
+        m_isFrameReady(false),
+        m_isStarted(false),
+        m_sequenceNumber(0U),
+        m_lastMileage(0U),
+        m_lastXPos(0),
+        m_lastYPos(0),
+        m_lastOrientation(0)
+    {
+    }
+
+    /**
+     * Destroys the breadcrumb trail.
+     */
+    ~BreadcrumbTrail()
+    {
+    }
+
+    /**
+     * Discard the current path frame and start a new trail with the next pose.
+     * The sequence numbering continues.
+     */
+    void restart()
+    {
+        m_frame.count = 0U;
+        m_isStarted   = false;
+    }
+
+    /**
+     * Process the current pose. Drops a breadcrumb if the robot travelled
+     * the sample distance since the last one.
+     *
+     * @param[in] mileage       Travelled distance [mm].
+     * @param[in] xPos          X position [mm].
+     * @param[in] yPos          Y position [mm].
+     * @param[in] orientation   Orientation [mrad].
+     */
+    void process(uint32_t mileage, int32_t xPos, int32_t yPos, int32_t orientation)
+    {
+        /* The mileage may be cleared in the meantime. */
+        if (mileage < m_lastMileage)
+        {
+            m_lastMileage = mileage;
+        }
+
+        if ((false == m_isStarted) || (SAMPLE_DISTANCE <= (mileage - m_lastMileage)))
+        {
+            addBreadcrumb(xPos, yPos, orientation);
+
+            m_lastMileage = mileage;
+            m_isStarted   = true;
+        }
+    }
+
+    /**
+     * Complete the path frame in progress, even if it is not full.
+     * Call it when the robot stops driving, otherwise the last breadcrumbs
+     * are published only after it drives again. The next breadcrumb starts
+     * a new path frame.
+     */
+    void flush()
+    {
+        if (0U < m_frame.count)
+        {
+            completeFrame();
+        }
+    }
+
+    /**
+     * Get the next completed path frame.
+     *
+     * @param[out] frame    Path frame.
+     *
+     * @return If a path frame was completed, it will return true otherwise false.
+     */
+    bool getFrame(TFrame& frame)
+    {
+        bool isAvailable = m_isFrameReady;
+
+        if (true == m_isFrameReady)
+        {
+            frame          = m_readyFrame;
+            m_isFrameReady = false;
+        }
+
+        return isAvailable;
+    }
+
+private:
+    TFrame   m_frame;           /**< Path frame, which is in progress. */
+    TFrame   m_readyFrame;      /**< Completed path frame, ready to be sent. */
+    bool     m_isFrameReady;    /**< Is a completed path frame available? */
+    bool     m_isStarted;       /**< Is the first breadcrumb dropped? */
+    uint16_t m_sequenceNumber;  /**< Sequence number of the next breadcrumb. */
+    uint32_t m_lastMileage;     /**< Mileage of the last breadcrumb [mm]. */
+    int32_t  m_lastXPos;        /**< X position of the last breadcrumb [mm]. */
+    int32_t  m_lastYPos;        /**< Y position of the last breadcrumb [mm]. */
+    int32_t  m_lastOrientation; /**< Orientation of the last breadcrumb [mrad]. */
+
+    /**
+     * Add a breadcrumb to the path frame in progress.
+     *
+     * @param[in] xPos          X position [mm].
+     * @param[in] yPos          Y position [mm].
+     * @param[in] orientation   Orientation [mrad].
+     */
+    void addBreadcrumb(int32_t xPos, int32_t yPos, int32_t orientation)
+    {
+        if (0U < m_frame.count)
+        {
+            int32_t deltaX           = xPos - m_lastXPos;
+            int32_t deltaY           = yPos - m_lastYPos;
+            int32_t deltaOrientation = (orientation - m_lastOrientation) % FP_2PI();
+
+            /* Use the shortest rotation, which fits into the delta. */
+            if (FP_PI() < deltaOrientation)
+            {
+                deltaOrientation -= FP_2PI();
+            }
+            else if (-FP_PI() > deltaOrientation)
+            {
+                deltaOrientation += FP_2PI();
+            }
+            else
+            {
+                ;
+            }
+
+            if ((true == isInRange(deltaX, INT8_MIN, INT8_MAX)) && (true == isInRange(deltaY, INT8_MIN, INT8_MAX)))
+            {
+                uint8_t deltaIdx = m_frame.count - 1U;
+
+                m_frame.deltas[deltaIdx].xPos        = static_cast<int8_t>(deltaX);
+                m_frame.deltas[deltaIdx].yPos        = static_cast<int8_t>(deltaY);
+                m_frame.deltas[deltaIdx].orientation = static_cast<int16_t>(deltaOrientation);
+
+                ++m_frame.count;
+            }
+            else
+            {
+                /* The jump is too far for a delta, e.g. because the position was
+                 * cleared. Complete the frame and start a new one with an
+                 * absolute breadcrumb.
+                 */
+                completeFrame();
+            }
+        }
+
+        if (0U == m_frame.count)
+        {
+            m_frame.sequenceNumber = m_sequenceNumber;
+            m_frame.xPos           = xPos;
+            m_frame.yPos           = yPos;
+            m_frame.orientation    = orientation;
+            m_frame.count          = 1U;
+        }
+
+        ++m_sequenceNumber;
+        m_lastXPos        = xPos;
+        m_lastYPos        = yPos;
+        m_lastOrientation = orientation;
+
+        if (MAX_BREADCRUMBS <= m_frame.count)
+        {
+            completeFrame();
+        }
+    }
+
+    /**
+     * Complete the path frame in progress. A not yet fetched frame is overwritten,
+     * which the receiver detects by the sequence number.
+     */
+    void completeFrame()
+    {
+        uint8_t deltaIdx = m_frame.count - 1U;
+
+        /* Unused deltas shall not contain old data. */
+        while (tMaxDeltas > deltaIdx)
+        {
+            m_frame.deltas[deltaIdx].xPos        = 0;
+            m_frame.deltas[deltaIdx].yPos        = 0;
+            m_frame.deltas[deltaIdx].orientation = 0;
+
+            ++deltaIdx;
+        }
+
+        m_readyFrame   = m_frame;
+        m_isFrameReady = true;
+        m_frame.count  = 0U;
+    }
+
+    /**
+     * Is the value in the range [min; max]?
+     *
+     * @param[in] value Value
+     * @param[in] min   Minimum
+     * @param[in] max   Maximum
+     *
+     * @return If in range, it will return true otherwise false.
+     */
+    static bool isInRange(int32_t value, int32_t min, int32_t max)
+    {
+        return ((min <= value) && (max >= value));
+    }
+
+    /* Not allowed. */
+    BreadcrumbTrail(const BreadcrumbTrail& trail);            /**< Copy construction of an instance. */
+    BreadcrumbTrail& operator=(const BreadcrumbTrail& trail); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* BREADCRUMB_TRAIL_HPP */
+/** @} */
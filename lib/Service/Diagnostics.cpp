@@ -0,0 +1,326 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Diagnostics pages on the display
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Diagnostics.h"
+#include <Board.h>
+#include <DifferentialDrive.h>
+#include <Util.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool Diagnostics::nextPage()
+{
+    ILineSensors& lineSensors = Board::getInstance().getLineSensors();
+
+    /* The calibration page is shown once per line sensor. */
+    if ((PAGE_CALIB == m_page) && ((m_sensorIdx + 1U) < lineSensors.getNumLineSensors()))
+    {
+        ++m_sensorIdx;
+    }
+    else
+    {
+        m_page      = static_cast<Page>((m_page + 1) % PAGE_MAX);
+        m_sensorIdx = 0U;
+    }
+
+    m_isRenderRequested = true;
+
+    return isPageSelected();
+}
+
+void Diagnostics::unselectPage()
+{
+    m_page      = PAGE_NONE;
+    m_sensorIdx = 0U;
+    m_nextLine  = NUM_LINES;
+}
+
+void Diagnostics::enable(uint32_t refreshPeriod)
+{
+    m_isEnabled         = true;
+    m_isRenderRequested = true;
+    m_refreshTimer.start(refreshPeriod);
+}
+
+void Diagnostics::disable()
+{
+    m_isEnabled = false;
+    m_nextLine  = NUM_LINES;
+    m_refreshTimer.stop();
+}
+
+void Diagnostics::setLoopStatistics(uint32_t maxPeriod, uint32_t avgPeriod, uint32_t overruns)
+{
+    m_maxLoopPeriod = maxPeriod;
+    m_avgLoopPeriod = avgPeriod;
+    m_overruns      = overruns;
+}
+
+void Diagnostics::addLap(uint32_t lapTime)
+{
+    if (UINT16_MAX > m_lapCount)
+    {
+        ++m_lapCount;
+    }
+
+    if ((1U == m_lapCount) || (m_bestLapTime > lapTime))
+    {
+        m_bestLapTime = lapTime;
+    }
+
+    m_lastLapTime = lapTime;
+}
+
+void Diagnostics::process()
+{
+    if ((false == m_isEnabled) || (PAGE_NONE == m_page))
+    {
+        ;
+    }
+    /* Rendering and display update are done in different calls to keep each one short. */
+    else if ((true == m_isRenderRequested) || (true == m_refreshTimer.isTimeout()))
+    {
+        render();
+
+        m_isRenderRequested = false;
+        m_refreshTimer.restart();
+    }
+    else if (NUM_LINES > m_nextLine)
+    {
+        IDisplay& display = Board::getInstance().getDisplay();
+
+        /* The lines are padded to the full width, which avoids a slow display clear. */
+        display.gotoXY(0, m_nextLine);
+        (void)display.print(m_lines[m_nextLine]);
+
+        ++m_nextLine;
+    }
+    else
+    {
+        ;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void Diagnostics::render()
+{
+    char valueStr[12];
+
+    switch (m_page)
+    {
+    case PAGE_LOOP:
+        setLine(0U, PSTR("Lmx"), m_maxLoopPeriod);
+        setLine(1U, PSTR("Lav"), m_avgLoopPeriod);
+        break;
+
+    case PAGE_OVERRUNS:
+        setLine(0U, PSTR("Overrun"), "");
+        setLine(1U, PSTR(""), m_overruns);
+        break;
+
+    case PAGE_BATTERY:
+        setLine(0U, PSTR("Bat. mV"), "");
+
+        if (nullptr == m_battery)
+        {
+            setLine(1U, PSTR(""), "-");
+        }
+        else
+        {
+            setLine(1U, PSTR(""), m_battery->getVoltage());
+        }
+        break;
+
+    case PAGE_MAX_SPEED:
+        setLine(0U, PSTR("Vmax"), "");
+        Util::intToStr(valueStr, sizeof(valueStr), DifferentialDrive::getInstance().getMaxMotorSpeed());
+        setLine(1U, PSTR(""), valueStr);
+        break;
+
+    case PAGE_CALIB:
+    {
+        ILineSensors& lineSensors = Board::getInstance().getLineSensors();
+        size_t        length      = 0U;
+
+        setLine(0U, PSTR("Cal"), m_sensorIdx);
+
+        /* Calibrated range as "min-max" */
+        Util::uintToStr(valueStr, sizeof(valueStr), lineSensors.getCalibMinValue(m_sensorIdx));
+        length = strlen(valueStr);
+
+        if ((sizeof(valueStr) - 1U) > length)
+        {
+            valueStr[length] = '-';
+            ++length;
+            Util::uintToStr(&valueStr[length], sizeof(valueStr) - length, lineSensors.getCalibMaxValue(m_sensorIdx));
+        }
+
+        setLine(1U, PSTR(""), valueStr);
+    }
+    break;
+
+    case PAGE_LAP:
+        setLine(0U, PSTR("Lap"), m_lapCount);
+
+        if (0U == m_lapCount)
+        {
+            setLine(1U, PSTR(""), "-");
+        }
+        else
+        {
+            setLine(1U, PSTR(""), m_lastLapTime);
+        }
+        break;
+
+    case PAGE_BEST_LAP:
+        setLine(0U, PSTR("Best"), "");
+
+        if (0U == m_lapCount)
+        {
+            setLine(1U, PSTR(""), "-");
+        }
+        else
+        {
+            setLine(1U, PSTR(""), m_bestLapTime);
+        }
+        break;
+
+    case PAGE_WHEEL_GAINS:
+    {
+        WheelTuner::Gains gainsLeft;
+        WheelTuner::Gains gainsRight;
+
+        /* Gains are 1 / divisor, shown as left/right divisor. */
+        DifferentialDrive::getInstance().getWheelGains(gainsLeft, gainsRight);
+        setLine(0U, PSTR("P"), gainsLeft.pDivisor, gainsRight.pDivisor);
+        setLine(1U, PSTR("I"), gainsLeft.iDivisor, gainsRight.iDivisor);
+    }
+    break;
+
+    default:
+        setLine(0U, PSTR(""), "");
+        setLine(1U, PSTR(""), "");
+        break;
+    }
+
+    m_nextLine = 0U;
+}
+
+void Diagnostics::setLine(uint8_t line, const char* label, const char* valueStr)
+{
+    char*  lineStr     = m_lines[line];
+    size_t valueLength = strlen(valueStr);
+    size_t idx         = 0U;
+
+    Util::copyStr(lineStr, LINE_LENGTH + 1U, reinterpret_cast<const __FlashStringHelper*>(label));
+
+    /* Pad with spaces up to the full line width. */
+    for (idx = strlen(lineStr); idx < LINE_LENGTH; ++idx)
+    {
+        lineStr[idx] = ' ';
+    }
+
+    lineStr[LINE_LENGTH] = '\0';
+
+    if (LINE_LENGTH < valueLength)
+    {
+        valueLength = LINE_LENGTH;
+    }
+
+    (void)memcpy(&lineStr[LINE_LENGTH - valueLength], valueStr, valueLength);
+}
+
+void Diagnostics::setLine(uint8_t line, const char* label, uint32_t value)
+{
+    char valueStr[12];
+
+    Util::uintToStr(valueStr, sizeof(valueStr), value);
+    setLine(line, label, valueStr);
+}
+
+void Diagnostics::setLine(uint8_t line, const char* label, uint32_t left, uint32_t right)
+{
+    char   valueStr[LINE_LENGTH + 1U];
+    size_t length = 0U;
+
+    Util::uintToStr(valueStr, sizeof(valueStr), left);
+    length = strlen(valueStr);
+
+    if ((sizeof(valueStr) - 1U) > length)
+    {
+        valueStr[length] = '/';
+        ++length;
+        Util::uintToStr(&valueStr[length], sizeof(valueStr) - length, right);
+    }
+
+    setLine(line, label, valueStr);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
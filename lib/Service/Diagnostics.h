@@ -0,0 +1,289 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Diagnostics pages on the display
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef DIAGNOSTICS_LIVE_ENABLE
+/**
+ * Show the selected diagnostics page live while driving, with a low refresh rate.
+ */
+#define DIAGNOSTICS_LIVE_ENABLE (0)
+#endif /* DIAGNOSTICS_LIVE_ENABLE */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Arduino.h>
+#include <SimpleTimer.h>
+#include <IBattery.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Shows performance metrics on diagnostics pages of the display, which are
+ * cycled by the operator. A page is rendered periodically into a line buffer,
+ * which is written to the display at most one line per call. This keeps the
+ * display update short, so it doesn't disturb the control.
+ */
+class Diagnostics
+{
+public:
+    /** Refresh period in ms, if the robot doesn't drive. */
+    static const uint32_t REFRESH_PERIOD = 250U;
+
+    /** Refresh period in ms, if the robot drives. */
+    static const uint32_t LIVE_REFRESH_PERIOD = 1000U;
+
+    /** Number of display lines. */
+    static const uint8_t NUM_LINES = 2U;
+
+    /** Number of characters per display line. */
+    static const uint8_t LINE_LENGTH = 8U;
+
+    /**
+     * Get diagnostics instance.
+     *
+     * @return Diagnostics instance.
+     */
+    static Diagnostics& getInstance()
+    {
+        static Diagnostics instance;
+
+        /* Singleton idiom to force initialization during first usage. */
+
+        return instance;
+    }
+
+    /**
+     * Set the battery, whose voltage is shown. Not every board has one,
+     * without the voltage is shown as "-".
+     *
+     * @param[in] battery   Battery
+     */
+    void setBattery(IBattery& battery)
+    {
+        m_battery = &battery;
+    }
+
+    /**
+     * Select the next diagnostics page. After the last page, no page is
+     * selected anymore and the caller shall show its own information again.
+     *
+     * @return If a page is selected, it will return true otherwise false.
+     */
+    bool nextPage();
+
+    /**
+     * Unselect the page, e.g. to show important information instead.
+     */
+    void unselectPage();
+
+    /**
+     * Is a diagnostics page selected?
+     *
+     * @return If a page is selected, it will return true otherwise false.
+     */
+    bool isPageSelected() const
+    {
+        return PAGE_NONE != m_page;
+    }
+
+    /**
+     * Enable the display update of the selected page. The page is rendered
+     * with the next processing.
+     *
+     * @param[in] refreshPeriod Refresh period in ms.
+     */
+    void enable(uint32_t refreshPeriod);
+
+    /**
+     * Disable the display update.
+     */
+    void disable();
+
+    /**
+     * Set the loop statistics, which are shown.
+     *
+     * @param[in] maxPeriod Max. loop period in us.
+     * @param[in] avgPeriod Average loop period in us.
+     * @param[in] overruns  Number of control overruns.
+     */
+    void setLoopStatistics(uint32_t maxPeriod, uint32_t avgPeriod, uint32_t overruns);
+
+    /**
+     * Add a successful driven lap to the lap statistics.
+     *
+     * @param[in] lapTime   Lap time in ms.
+     */
+    void addLap(uint32_t lapTime);
+
+    /**
+     * Get a line of the last rendered page, as it is written to the display.
+     *
+     * @param[in] line  Line index
+     *
+     * @return Line, which is padded to the full line length. If the line index is invalid, it will be empty.
+     */
+    const char* getLine(uint8_t line) const
+    {
+        return (NUM_LINES > line) ? m_lines[line] : "";
+    }
+
+    /**
+     * Process the diagnostics once per control period, outside of the control
+     * chain. It either renders the selected page or writes one line of it to
+     * the display.
+     */
+    void process();
+
+protected:
+private:
+    /**
+     * The diagnostics pages in the order they are cycled.
+     */
+    enum Page
+    {
+        PAGE_NONE = 0,    /**< No page selected. */
+        PAGE_LOOP,        /**< Loop period max. and average. */
+        PAGE_OVERRUNS,    /**< Control overruns. */
+        PAGE_BATTERY,     /**< Battery voltage. */
+        PAGE_MAX_SPEED,   /**< Calibrated max. motor speed. */
+        PAGE_CALIB,       /**< Calibration range, one page per line sensor. */
+        PAGE_LAP,         /**< Number of laps and last lap time. */
+        PAGE_BEST_LAP,    /**< Best lap time. */
+        PAGE_WHEEL_GAINS, /**< Wheel speed controller gain divisors, left and right. */
+        PAGE_MAX          /**< Number of pages. */
+    };
+
+    Page        m_page;                               /**< Selected page. */
+    uint8_t     m_sensorIdx;                          /**< Line sensor index of the calibration page. */
+    bool        m_isEnabled;                          /**< Is the display update enabled? */
+    bool        m_isRenderRequested;                  /**< Shall the page be rendered with the next processing? */
+    SimpleTimer m_refreshTimer;                       /**< Timer used to refresh the page. */
+    char        m_lines[NUM_LINES][LINE_LENGTH + 1U]; /**< Rendered page lines. */
+    uint8_t     m_nextLine;                           /**< Index of the next line, which to write to the display. */
+    uint32_t    m_maxLoopPeriod;                      /**< Max. loop period in us. */
+    uint32_t    m_avgLoopPeriod;                      /**< Average loop period in us. */
+    uint32_t    m_overruns;                           /**< Number of control overruns. */
+    uint16_t    m_lapCount;                           /**< Number of successful driven laps. */
+    uint32_t    m_lastLapTime;                        /**< Last lap time in ms. */
+    uint32_t    m_bestLapTime;                        /**< Best lap time in ms. */
+    IBattery*   m_battery;                            /**< Battery, whose voltage is shown. */
+
+    /**
+     * Default constructor.
+     */
+    Diagnostics() :
+        m_page(PAGE_NONE),
+        m_sensorIdx(0U),
+        m_isEnabled(false),
+        m_isRenderRequested(false),
+        m_refreshTimer(),
+        m_lines(),
+        m_nextLine(NUM_LINES),
+        m_maxLoopPeriod(0U),
+        m_avgLoopPeriod(0U),
+        m_overruns(0U),
+        m_lapCount(0U),
+        m_lastLapTime(0U),
+        m_bestLapTime(0U),
+        m_battery(nullptr)
+    {
+    }
+
+    /**
+     * Default destructor.
+     */
+    ~Diagnostics()
+    {
+    }
+
+    /**
+     * Render the selected page into the line buffer.
+     */
+    void render();
+
+    /**
+     * Set a line with a left aligned label and a right aligned value.
+     * If both don't fit, the value overwrites the end of the label.
+     *
+     * @param[in] line      Line index
+     * @param[in] label     Label in program memory
+     * @param[in] valueStr  Value as string, may be empty.
+     */
+    void setLine(uint8_t line, const char* label, const char* valueStr);
+
+    /**
+     * Set a line with a left aligned label and a right aligned unsigned value.
+     *
+     * @param[in] line  Line index
+     * @param[in] label Label in program memory
+     * @param[in] value Value
+     */
+    void setLine(uint8_t line, const char* label, uint32_t value);
+
+    /**
+     * Set a line with a left aligned label and a right aligned pair of unsigned values as "left/right".
+     *
+     * @param[in] line  Line index
+     * @param[in] label Label in program memory
+     * @param[in] left  Left value
+     * @param[in] right Right value
+     */
+    void setLine(uint8_t line, const char* label, uint32_t left, uint32_t right);
+
+    /* Not allowed. */
+    Diagnostics(const Diagnostics& diagnostics);            /**< Copy construction of an instance. */
+    Diagnostics& operator=(const Diagnostics& diagnostics); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* DIAGNOSTICS_H */
+/** @} */
@@ -68,10 +68,11 @@ void DifferentialDrive::enable()
     m_linearSpeedRightSetPoint  = 0;
     m_angularSpeedSetPoint      = 0;
 
-    m_motorSpeedLeftPID.clear();
-    m_motorSpeedRightPID.clear();
-
+    /* The wheel speed control resets the PID controllers by itself. */
+    ++m_enableCnt;
     m_isEnabled = true;
+
+    publish();
 }
 
 void DifferentialDrive::disable()
@@ -89,6 +90,8 @@ void DifferentialDrive::disable()
     m_angularSpeedSetPoint      = 0;
 
     m_isEnabled = false;
+
+    publish();
 }
 
 int16_t DifferentialDrive::getMaxMotorSpeed() const
@@ -100,8 +103,8 @@ void DifferentialDrive::setMaxMotorSpeed(int16_t maxMotorSpeed)
 {
     m_maxMotorSpeed = maxMotorSpeed;
 
-    m_motorSpeedLeftPID.setLimits(-m_maxMotorSpeed, m_maxMotorSpeed);
-    m_motorSpeedRightPID.setLimits(-m_maxMotorSpeed, m_maxMotorSpeed);
+    /* The wheel speed control sets the PID controller limits by itself. */
+    publish();
 }
 
 int16_t DifferentialDrive::getLinearSpeed() const
@@ -114,6 +117,7 @@ void DifferentialDrive::setLinearSpeed(int16_t linearSpeed)
     m_linearSpeedCenterSetPoint = constrain(linearSpeed, -m_maxMotorSpeed, m_maxMotorSpeed);
     calculateLinearSpeedLeftRight(m_linearSpeedCenterSetPoint, m_angularSpeedSetPoint, m_linearSpeedLeftSetPoint,
                                   m_linearSpeedRightSetPoint);
+    publish();
 }
 
 void DifferentialDrive::getLinearSpeed(int16_t& linearSpeedLeft, int16_t& linearSpeedRight)
@@ -128,6 +132,7 @@ void DifferentialDrive::setLinearSpeed(int16_t linearSpeedLeft, int16_t linearSp
     m_linearSpeedRightSetPoint = constrain(linearSpeedRight, -m_maxMotorSpeed, m_maxMotorSpeed);
     calculateLinearAndAngularSpeedCenter(m_linearSpeedLeftSetPoint, m_linearSpeedRightSetPoint,
                                          m_linearSpeedCenterSetPoint, m_angularSpeedSetPoint);
+    publish();
 }
 
 int16_t DifferentialDrive::getAngularSpeed() const
@@ -140,29 +145,81 @@ void DifferentialDrive::setAngularSpeed(int16_t angularSpeed)
     m_angularSpeedSetPoint = constrain(angularSpeed, -m_maxMotorSpeed, m_maxMotorSpeed);
     calculateLinearSpeedLeftRight(m_linearSpeedCenterSetPoint, m_angularSpeedSetPoint, m_linearSpeedLeftSetPoint,
                                   m_linearSpeedRightSetPoint);
+    publish();
+}
+
+void DifferentialDrive::enableWheelTuning(bool isEnabled)
+{
+    m_isTuningEnabled = isEnabled;
+
+    publish();
+}
+
+void DifferentialDrive::setWheelGains(const WheelTuner::Gains& gainsLeft, const WheelTuner::Gains& gainsRight)
+{
+    m_gainsLeft  = gainsLeft;
+    m_gainsRight = gainsRight;
+
+    /* The wheel speed control applies the gains by itself. */
+    ++m_gainsCnt;
+
+    publish();
+}
+
+void DifferentialDrive::getWheelGains(WheelTuner::Gains& gainsLeft, WheelTuner::Gains& gainsRight) const
+{
+    /* The wheel speed control may interrupt the read, therefore retry. */
+    TunedGains tunedGains = m_tunedGains.read();
+
+    gainsLeft  = tunedGains.left;
+    gainsRight = tunedGains.right;
 }
 
 void DifferentialDrive::process(uint32_t period)
 {
+    applySetPoints();
+
     /* The differential drive must be enabled.
      * The calibration is essential! The max. motor speed in [steps/s] is needed for closed-loop-control.
      */
-    if ((true == m_isEnabled) && (0 < m_maxMotorSpeed))
+    if ((true == m_appliedSetPoints.isEnabled) && (0 < m_appliedSetPoints.maxMotorSpeed))
     {
         Speedometer& speedometer        = Speedometer::getInstance();
         IMotors&     motors             = Board::getInstance().getMotors();
-        int32_t      maxMotorSpeed      = static_cast<int32_t>(m_maxMotorSpeed);      /* [steps/s] */
-        int32_t      pwmMaxMotorSpeed   = static_cast<int32_t>(motors.getMaxSpeed()); /* [digits] */
-        int16_t      pwmMotorSpeedLeft  = 0;                                          /* [digits] */
-        int16_t      pwmMotorSpeedRight = 0;                                          /* [digits] */
-        int16_t      linearSpeedLeft    = speedometer.getLinearSpeedLeft();           /* [steps/s] */
-        int16_t      linearSpeedRight   = speedometer.getLinearSpeedRight();          /* [steps/s] */
+        int16_t      maxMotorSpeed      = m_appliedSetPoints.maxMotorSpeed;  /* [steps/s] */
+        int16_t      pwmMaxMotorSpeed   = motors.getMaxSpeed();              /* [digits] */
+        int16_t      pwmMotorSpeedLeft  = 0;                                 /* [digits] */
+        int16_t      pwmMotorSpeedRight = 0;                                 /* [digits] */
+        int16_t      linearSpeedLeft    = speedometer.getLinearSpeedLeft();  /* [steps/s] */
+        int16_t      linearSpeedRight   = speedometer.getLinearSpeedRight(); /* [steps/s] */
 
         m_motorSpeedLeftPID.setSampleTime(period);
         m_motorSpeedRightPID.setSampleTime(period);
 
+        /* The tuners see the stopped wheels too, otherwise they would miss the steps from standstill. */
+        if (true == m_appliedSetPoints.isTuningEnabled)
+        {
+            bool isLeftTuned  = m_wheelTunerLeft.process(m_appliedSetPoints.left, linearSpeedLeft, period);
+            bool isRightTuned = m_wheelTunerRight.process(m_appliedSetPoints.right, linearSpeedRight, period);
+
+            if (true == isLeftTuned)
+            {
+                applyGains(m_motorSpeedLeftPID, m_wheelTunerLeft.getGains());
+            }
+
+            if (true == isRightTuned)
+            {
+                applyGains(m_motorSpeedRightPID, m_wheelTunerRight.getGains());
+            }
+
+            if ((true == isLeftTuned) || (true == isRightTuned))
+            {
+                publishTunedGains();
+            }
+        }
+
         /* If left motor is stopped, the PID controller shall be cleared. */
-        if (0 == m_linearSpeedLeftSetPoint)
+        if (0 == m_appliedSetPoints.left)
         {
             m_motorSpeedLeftPID.clear();
             m_lastLinearSpeedLeft = 0;
@@ -170,22 +227,17 @@ void DifferentialDrive::process(uint32_t period)
         /* Handle left motor PID control. */
         else
         {
-            int32_t motorSpeedLeft =
-                m_lastLinearSpeedLeft +
-                m_motorSpeedLeftPID.calculate(m_linearSpeedLeftSetPoint, linearSpeedLeft); /* [steps/s] */
-
-            /* Limit to max. motor speed in [steps/s] */
-            motorSpeedLeft = constrain(motorSpeedLeft, -m_maxMotorSpeed, m_maxMotorSpeed);
+            int16_t pidOutput = m_motorSpeedLeftPID.calculate(m_appliedSetPoints.left, linearSpeedLeft); /* [steps/s] */
 
             /* For the velocity PID remember the last PID output value. */
-            m_lastLinearSpeedLeft = motorSpeedLeft;
+            m_lastLinearSpeedLeft = calculateMotorSpeed(m_lastLinearSpeedLeft, pidOutput, maxMotorSpeed);
 
             /* Convert speed from [steps/s] to [digits]. */
-            pwmMotorSpeedLeft = static_cast<int16_t>(motorSpeedLeft * pwmMaxMotorSpeed / maxMotorSpeed); /* [digits] */
+            pwmMotorSpeedLeft = convertToPwm(m_lastLinearSpeedLeft, pwmMaxMotorSpeed, maxMotorSpeed);
         }
 
         /* If right motor is stopped, the PID controller shall be cleared. */
-        if (0 == m_linearSpeedRightSetPoint)
+        if (0 == m_appliedSetPoints.right)
         {
             m_motorSpeedRightPID.clear();
             m_lastLinearSpeedRight = 0;
@@ -193,25 +245,65 @@ void DifferentialDrive::process(uint32_t period)
         /* Handle right motor PID control. */
         else
         {
-            int32_t motorSpeedRight =
-                m_lastLinearSpeedRight +
-                m_motorSpeedRightPID.calculate(m_linearSpeedRightSetPoint, linearSpeedRight); /* [steps/s] */
-
-            /* Limit to max. motor speed in [steps/s] */
-            motorSpeedRight = constrain(motorSpeedRight, -m_maxMotorSpeed, m_maxMotorSpeed);
+            int16_t pidOutput =
+                m_motorSpeedRightPID.calculate(m_appliedSetPoints.right, linearSpeedRight); /* [steps/s] */
 
             /* For the velocity PID remember the last PID output value. */
-            m_lastLinearSpeedRight = motorSpeedRight;
+            m_lastLinearSpeedRight = calculateMotorSpeed(m_lastLinearSpeedRight, pidOutput, maxMotorSpeed);
 
             /* Convert speed from [steps/s] to [digits]. */
-            pwmMotorSpeedRight =
-                static_cast<int16_t>(motorSpeedRight * pwmMaxMotorSpeed / maxMotorSpeed); /* [digits] */
+            pwmMotorSpeedRight = convertToPwm(m_lastLinearSpeedRight, pwmMaxMotorSpeed, maxMotorSpeed);
         }
 
         motors.setSpeeds(pwmMotorSpeedLeft, pwmMotorSpeedRight);
     }
 }
 
+void DifferentialDrive::save(Snapshot& snapshot) const
+{
+    (void)snapshot.put(m_isInit);
+    (void)snapshot.put(m_isEnabled);
+    (void)snapshot.put(m_maxMotorSpeed);
+    (void)snapshot.put(m_linearSpeedCenterSetPoint);
+    (void)snapshot.put(m_angularSpeedSetPoint);
+    (void)snapshot.put(m_linearSpeedLeftSetPoint);
+    (void)snapshot.put(m_linearSpeedRightSetPoint);
+    m_motorSpeedLeftPID.save(snapshot);
+    m_motorSpeedRightPID.save(snapshot);
+    (void)snapshot.put(m_lastLinearSpeedLeft);
+    (void)snapshot.put(m_lastLinearSpeedRight);
+    (void)snapshot.put(m_isTuningEnabled);
+    (void)snapshot.put(m_gainsLeft);
+    (void)snapshot.put(m_gainsRight);
+    m_wheelTunerLeft.save(snapshot);
+    m_wheelTunerRight.save(snapshot);
+}
+
+void DifferentialDrive::restore(Snapshot& snapshot)
+{
+    (void)snapshot.get(m_isInit);
+    (void)snapshot.get(m_isEnabled);
+    (void)snapshot.get(m_maxMotorSpeed);
+    (void)snapshot.get(m_linearSpeedCenterSetPoint);
+    (void)snapshot.get(m_angularSpeedSetPoint);
+    (void)snapshot.get(m_linearSpeedLeftSetPoint);
+    (void)snapshot.get(m_linearSpeedRightSetPoint);
+    m_motorSpeedLeftPID.restore(snapshot);
+    m_motorSpeedRightPID.restore(snapshot);
+    (void)snapshot.get(m_lastLinearSpeedLeft);
+    (void)snapshot.get(m_lastLinearSpeedRight);
+    (void)snapshot.get(m_isTuningEnabled);
+    (void)snapshot.get(m_gainsLeft);
+    (void)snapshot.get(m_gainsRight);
+    m_wheelTunerLeft.restore(snapshot);
+    m_wheelTunerRight.restore(snapshot);
+
+    /* The restored PID controllers and tuners belong to the restored set points. */
+    publish();
+    (void)m_wheelSetPoints.tryRead(m_appliedSetPoints);
+    publishTunedGains();
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -223,38 +315,144 @@ void DifferentialDrive::process(uint32_t period)
 void DifferentialDrive::calculateLinearSpeedLeftRight(int16_t linearSpeedCenter, int16_t angularSpeed,
                                                       int16_t& linearSpeedLeft, int16_t& linearSpeedRight)
 {
-    int32_t linearSpeedCenter32 = static_cast<int32_t>(linearSpeedCenter);          /* [steps/s] */
-    int32_t angularSpeed32      = static_cast<int32_t>(angularSpeed);               /* [mrad/s] */
-    int32_t wheelBase32         = static_cast<int32_t>(RobotConstants::WHEEL_BASE); /* [mm] */
+    Units::LinearSpeed  center(linearSpeedCenter); /* [steps/s] */
+    Units::AngularSpeed angular(angularSpeed);     /* [mrad/s] */
 
     /* angular speed = 2 * (linear speed right - linear speed left ) / wheel base
      * linear speed right - linear speed left = angular speed * wheel base / 2
      *
      * linear speed right = - linear speed left
+     *
+     * The results saturate instead of overflowing the 16 bit range.
      */
 
-    linearSpeedLeft  = linearSpeedCenter32 - (angularSpeed32 * wheelBase32) / 2;
-    linearSpeedRight = linearSpeedCenter32 + (angularSpeed32 * wheelBase32) / 2;
+    linearSpeedLeft  = (center - angular.convert<Units::StepsPerSecond, RobotConstants::WHEEL_BASE, 2>())
+                          .clamp<INT16_MIN, INT16_MAX>()
+                          .value();
+    linearSpeedRight = (center + angular.convert<Units::StepsPerSecond, RobotConstants::WHEEL_BASE, 2>())
+                           .clamp<INT16_MIN, INT16_MAX>()
+                           .value();
 }
 
 void DifferentialDrive::calculateLinearAndAngularSpeedCenter(int16_t linearSpeedLeft, int16_t linearSpeedRight,
                                                              int16_t& linearSpeedCenter, int16_t& angularSpeed)
 {
-    int32_t linearSpeedLeft32   = static_cast<int32_t>(linearSpeedLeft);                            /* [steps/s] */
-    int32_t linearSpeedRight32  = static_cast<int32_t>(linearSpeedRight);                           /* [steps/s] */
-    int32_t wheelDiameter32     = static_cast<int32_t>(RobotConstants::WHEEL_DIAMETER);             /* [mm] */
-    int32_t wheelBase32         = static_cast<int32_t>(RobotConstants::WHEEL_BASE);                 /* [mm] */
-    int32_t linearSpeedCenter32 = (wheelDiameter32 * (linearSpeedRight32 + linearSpeedLeft32)) / 2; /* [steps/s] */
-    int32_t angularSpeed32      = (2 * (linearSpeedRight32 - linearSpeedLeft32)) / wheelBase32;     /* [mrad/s] */
+    Units::LinearSpeed left(linearSpeedLeft);   /* [steps/s] */
+    Units::LinearSpeed right(linearSpeedRight); /* [steps/s] */
 
     /* linear speed = (wheel radius / 2) * (linear speed right + linear speed left)
      * linear speed = (wheel radius * (linear speed right + linear speed left)) / 2
      *
      * angular speed = 2 * (linear speed right - linear speed left ) / wheel base
+     *
+     * The linear speed saturates instead of overflowing the 16 bit range.
+     */
+
+    linearSpeedCenter =
+        (right + left).scale<RobotConstants::WHEEL_DIAMETER, 2>().clamp<INT16_MIN, INT16_MAX>().value();
+    angularSpeed = (right - left).convert<Units::MilliradianPerSecond, 2, RobotConstants::WHEEL_BASE>().value();
+}
+
+int16_t DifferentialDrive::calculateMotorSpeed(int16_t lastLinearSpeed, int16_t pidOutput, int16_t maxMotorSpeed)
+{
+    /* The sum exceeds 16 bit, but after the limitation it fits again. */
+    return (Units::LinearSpeed(lastLinearSpeed) + Units::LinearSpeed(pidOutput))
+        .limit<-INT16_MAX, INT16_MAX>(-maxMotorSpeed, maxMotorSpeed)
+        .value(); /* [steps/s] */
+}
+
+int16_t DifferentialDrive::convertToPwm(int16_t motorSpeed, int16_t pwmMaxMotorSpeed, int16_t maxMotorSpeed)
+{
+    int32_t product = static_cast<int32_t>(motorSpeed) * static_cast<int32_t>(pwmMaxMotorSpeed);
+
+    /* The motor speed is limited to the max. motor speed, therefore the result fits into 16 bit. */
+    return static_cast<int16_t>(product / static_cast<int32_t>(maxMotorSpeed)); /* [digits] */
+}
+
+void DifferentialDrive::applyGains(PIDController<int16_t>& pid, const WheelTuner::Gains& gains)
+{
+    /* The numerators stay 1, which keeps the controller calculation in 16 bit. */
+    pid.setPFactor(1, gains.pDivisor);
+    pid.setIFactor(1, gains.iDivisor);
+}
+
+void DifferentialDrive::publish()
+{
+    WheelSetPoints setPoints;
+
+    setPoints.isEnabled       = m_isEnabled;
+    setPoints.enableCnt       = m_enableCnt;
+    setPoints.maxMotorSpeed   = m_maxMotorSpeed;
+    setPoints.left            = m_linearSpeedLeftSetPoint;
+    setPoints.right           = m_linearSpeedRightSetPoint;
+    setPoints.isTuningEnabled = m_isTuningEnabled;
+    setPoints.gainsCnt        = m_gainsCnt;
+    setPoints.gainsLeft       = m_gainsLeft;
+    setPoints.gainsRight      = m_gainsRight;
+
+    m_wheelSetPoints.write(setPoints);
+}
+
+void DifferentialDrive::publishTunedGains()
+{
+    TunedGains tunedGains;
+
+    tunedGains.left  = m_wheelTunerLeft.getGains();
+    tunedGains.right = m_wheelTunerRight.getGains();
+
+    m_tunedGains.write(tunedGains);
+}
+
+void DifferentialDrive::applySetPoints()
+{
+    WheelSetPoints setPoints;
+
+    /* If the set points are written just now, the wheel speed control interrupted
+     * the setter. It shall not wait and continues with the last set points.
      */
+    if (true == m_wheelSetPoints.tryRead(setPoints))
+    {
+        if (setPoints.maxMotorSpeed != m_appliedSetPoints.maxMotorSpeed)
+        {
+            m_motorSpeedLeftPID.setLimits(-setPoints.maxMotorSpeed, setPoints.maxMotorSpeed);
+            m_motorSpeedRightPID.setLimits(-setPoints.maxMotorSpeed, setPoints.maxMotorSpeed);
+        }
+
+        if (setPoints.enableCnt != m_appliedSetPoints.enableCnt)
+        {
+            m_motorSpeedLeftPID.clear();
+            m_motorSpeedRightPID.clear();
+        }
+
+        /* The tuners limit the gains to their bounds. */
+        if (setPoints.gainsCnt != m_appliedSetPoints.gainsCnt)
+        {
+            m_wheelTunerLeft.setGains(setPoints.gainsLeft);
+            m_wheelTunerRight.setGains(setPoints.gainsRight);
+
+            applyGains(m_motorSpeedLeftPID, m_wheelTunerLeft.getGains());
+            applyGains(m_motorSpeedRightPID, m_wheelTunerRight.getGains());
 
-    linearSpeedCenter = static_cast<int16_t>(linearSpeedCenter32);
-    angularSpeed      = static_cast<int16_t>(angularSpeed32);
+            publishTunedGains();
+        }
+
+        /* A step response, which was interrupted by disabling the tuning, isn't evaluated. */
+        if ((true == setPoints.isTuningEnabled) && (false == m_appliedSetPoints.isTuningEnabled))
+        {
+            m_wheelTunerLeft.reset();
+            m_wheelTunerRight.reset();
+        }
+
+        /* The setter stops the motors too, but the wheel speed control might have
+         * interrupted it. Ensure that the motors stay stopped.
+         */
+        if ((false == setPoints.isEnabled) && (true == m_appliedSetPoints.isEnabled))
+        {
+            Board::getInstance().getMotors().setSpeeds(0, 0);
+        }
+
+        m_appliedSetPoints = setPoints;
+    }
 }
 
 /******************************************************************************
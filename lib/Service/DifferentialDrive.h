@@ -46,6 +46,10 @@
 #include <stdint.h>
 #include <SimpleTimer.h>
 #include <PIDController.h>
+#include <Snapshot.h>
+#include <SeqLock.hpp>
+#include <Units.hpp>
+#include <WheelTuner.h>
 
 /******************************************************************************
  * Macros
@@ -66,6 +70,12 @@
  * All values used for control and measurement are in [steps/s] or [mrad/s].
  *
  * Calculations are performed in fixed point arithmetic for better performance.
+ *
+ * The wheel speed control in process() may run in an interrupt. Therefore the
+ * setters publish the wheel set points consistently for it.
+ *
+ * If enabled, the gains of the wheel speed controllers are adapted online per
+ * wheel by evaluating their step responses.
  */
 class DifferentialDrive
 {
@@ -170,33 +180,53 @@ public:
     void setAngularSpeed(int16_t angularSpeed);
 
     /**
-     * Process the differential drive periodically.
+     * Enable or disable the online adaptation of the wheel speed controller gains.
+     * It is disabled by default.
      *
-     * @param[in] period    Calling period in [ms]
+     * @param[in] isEnabled Enable (true) or disable (false) the adaptation.
      */
-    void process(uint32_t period);
+    void enableWheelTuning(bool isEnabled);
 
-private:
     /**
-     * The PID proportional factor numerator for the speed control.
+     * Set the gains of the wheel speed controllers, e.g. restored ones.
+     * They are limited to the bounds of the wheel tuner.
+     *
+     * @param[in] gainsLeft     Gains of the left wheel speed controller
+     * @param[in] gainsRight    Gains of the right wheel speed controller
      */
-    static const int16_t PID_P_NUMERATOR = 1;
+    void setWheelGains(const WheelTuner::Gains& gainsLeft, const WheelTuner::Gains& gainsRight);
 
     /**
-     * The PID proportional factor denominator for the speed control.
+     * Get the gains, which the wheel speed controllers work with.
+     *
+     * @param[out] gainsLeft    Gains of the left wheel speed controller
+     * @param[out] gainsRight   Gains of the right wheel speed controller
      */
-    static const int16_t PID_P_DENOMINATOR = 10;
+    void getWheelGains(WheelTuner::Gains& gainsLeft, WheelTuner::Gains& gainsRight) const;
 
     /**
-     * The PID integral factor numerator for the speed control.
+     * Process the differential drive periodically.
+     *
+     * @param[in] period    Calling period in [ms]
      */
-    static const int16_t PID_I_NUMERATOR = 1;
+    void process(uint32_t period);
 
     /**
-     * The PID integral factor denominator for the speed control.
+     * Save the set points and the speed controller state to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
      */
-    static const int16_t PID_I_DENOMINATOR = 100;
+    void save(Snapshot& snapshot) const;
 
+    /**
+     * Restore the set points and the speed controller state from a snapshot.
+     * The motors get the restored speed with the next process() call.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
+private:
     /**
      * The PID derivative factor numerator for the speed control.
      */
@@ -207,6 +237,33 @@ private:
      */
     static const int16_t PID_D_DENOMINATOR = 400;
 
+    /**
+     * The set points of the wheel speed control, which are exchanged between
+     * the setters and process().
+     */
+    struct WheelSetPoints
+    {
+        bool    isEnabled;     /**< Is the wheel speed control enabled? */
+        uint8_t enableCnt;     /**< Incremented with every enable, to reset the PID controllers. */
+        int16_t maxMotorSpeed; /**< Max. motor speed in [steps/s] */
+        int16_t left;          /**< Linear speed left in [steps/s] set point */
+        int16_t right;         /**< Linear speed right in [steps/s] set point */
+
+        bool              isTuningEnabled; /**< Is the wheel speed controller gain adaptation enabled? */
+        uint8_t           gainsCnt;        /**< Incremented with every set of the gains, to apply them. */
+        WheelTuner::Gains gainsLeft;       /**< Gains of the left wheel speed controller */
+        WheelTuner::Gains gainsRight;      /**< Gains of the right wheel speed controller */
+    };
+
+    /**
+     * The gains, which the wheel speed controllers work with, published by process().
+     */
+    struct TunedGains
+    {
+        WheelTuner::Gains left;  /**< Gains of the left wheel speed controller */
+        WheelTuner::Gains right; /**< Gains of the right wheel speed controller */
+    };
+
     int16_t m_isInit;    /**< Used to determine the initialization in the first time process() is called. */
     bool    m_isEnabled; /**< Enable/Disable the differential drive control. */
 
@@ -221,8 +278,20 @@ private:
     PIDController<int16_t> m_motorSpeedLeftPID;  /**< PID controller for the left motor speed. */
     PIDController<int16_t> m_motorSpeedRightPID; /**< PID controller for the right motor speed. */
 
-    int32_t m_lastLinearSpeedLeft;  /**< Last linear speed left PID output in [steps/s]. */
-    int32_t m_lastLinearSpeedRight; /**< Last linear speed right PID output in [steps/s]. */
+    int16_t m_lastLinearSpeedLeft;  /**< Last linear speed left PID output in [steps/s]. */
+    int16_t m_lastLinearSpeedRight; /**< Last linear speed right PID output in [steps/s]. */
+
+    uint8_t                 m_enableCnt;        /**< Number of enables, published with the set points. */
+    SeqLock<WheelSetPoints> m_wheelSetPoints;   /**< Set points published for the wheel speed control. */
+    WheelSetPoints          m_appliedSetPoints; /**< Set points, which the wheel speed control works with. */
+
+    bool                m_isTuningEnabled; /**< Enable/Disable the wheel speed controller gain adaptation. */
+    uint8_t             m_gainsCnt;        /**< Number of gain sets, published with the set points. */
+    WheelTuner::Gains   m_gainsLeft;       /**< Gains of the left wheel speed controller, set by the application. */
+    WheelTuner::Gains   m_gainsRight;      /**< Gains of the right wheel speed controller, set by the application. */
+    WheelTuner          m_wheelTunerLeft;  /**< Gain adaptation of the left wheel speed controller. */
+    WheelTuner          m_wheelTunerRight; /**< Gain adaptation of the right wheel speed controller. */
+    SeqLock<TunedGains> m_tunedGains;      /**< Gains published by the wheel speed control. */
 
     /**
      * Construct differential drive control.
@@ -239,15 +308,27 @@ private:
         m_motorSpeedLeftPID(),
         m_motorSpeedRightPID(),
         m_lastLinearSpeedLeft(0),
-        m_lastLinearSpeedRight(0)
+        m_lastLinearSpeedRight(0),
+        m_enableCnt(0U),
+        m_wheelSetPoints(),
+        m_appliedSetPoints(),
+        m_isTuningEnabled(false),
+        m_gainsCnt(0U),
+        m_gainsLeft(WheelTuner::getDefaultGains()),
+        m_gainsRight(WheelTuner::getDefaultGains()),
+        m_wheelTunerLeft(),
+        m_wheelTunerRight(),
+        m_tunedGains()
     {
-        m_motorSpeedLeftPID.setPFactor(PID_P_NUMERATOR, PID_P_DENOMINATOR);
-        m_motorSpeedLeftPID.setIFactor(PID_I_NUMERATOR, PID_I_DENOMINATOR);
+        applyGains(m_motorSpeedLeftPID, m_gainsLeft);
         m_motorSpeedLeftPID.setDFactor(PID_D_NUMERATOR, PID_D_DENOMINATOR);
 
-        m_motorSpeedRightPID.setPFactor(PID_P_NUMERATOR, PID_P_DENOMINATOR);
-        m_motorSpeedRightPID.setIFactor(PID_I_NUMERATOR, PID_I_DENOMINATOR);
+        applyGains(m_motorSpeedRightPID, m_gainsRight);
         m_motorSpeedRightPID.setDFactor(PID_D_NUMERATOR, PID_D_DENOMINATOR);
+
+        publish();
+        (void)m_wheelSetPoints.tryRead(m_appliedSetPoints);
+        publishTunedGains();
     }
 
     /**
@@ -285,6 +366,53 @@ private:
      */
     void calculateLinearAndAngularSpeedCenter(int16_t linearSpeedLeft, int16_t linearSpeedRight,
                                               int16_t& linearSpeedCenter, int16_t& angularSpeed);
+
+    /**
+     * Calculate the motor speed from the last motor speed and the PID output.
+     * It is limited to the max. motor speed.
+     *
+     * @param[in] lastLinearSpeed   Last motor speed in [steps/s]
+     * @param[in] pidOutput         PID output in [steps/s]
+     * @param[in] maxMotorSpeed     Max. motor speed in [steps/s], shall be positive.
+     *
+     * @return Motor speed in [steps/s]
+     */
+    static int16_t calculateMotorSpeed(int16_t lastLinearSpeed, int16_t pidOutput, int16_t maxMotorSpeed);
+
+    /**
+     * Convert a motor speed to PWM digits.
+     *
+     * @param[in] motorSpeed        Motor speed in [steps/s], limited to the max. motor speed.
+     * @param[in] pwmMaxMotorSpeed  Max. motor speed in [digits]
+     * @param[in] maxMotorSpeed     Max. motor speed in [steps/s], shall be positive.
+     *
+     * @return Motor speed in [digits]
+     */
+    static int16_t convertToPwm(int16_t motorSpeed, int16_t pwmMaxMotorSpeed, int16_t maxMotorSpeed);
+
+    /**
+     * Apply gains to a wheel speed controller.
+     *
+     * @param[in] pid   Wheel speed controller
+     * @param[in] gains Gains
+     */
+    static void applyGains(PIDController<int16_t>& pid, const WheelTuner::Gains& gains);
+
+    /**
+     * Publish the wheel set points for the wheel speed control.
+     */
+    void publish();
+
+    /**
+     * Publish the gains of the wheel tuners, which the wheel speed control works with.
+     */
+    void publishTunedGains();
+
+    /**
+     * Apply changed wheel set points in the wheel speed control.
+     * If the set points are just written, the last ones are kept.
+     */
+    void applySetPoints();
 };
 
 /******************************************************************************
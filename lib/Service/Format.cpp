@@ -0,0 +1,198 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Allocation-free string formatting
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Format.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static size_t formatNumber(char* str, size_t size, bool isNegative, uint32_t magnitude, uint8_t decimals,
+                           uint8_t width, char padding, bool isSignForced);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+size_t Format::uintToStr(char* str, size_t size, uint32_t value, uint8_t width, char padding)
+{
+    return formatNumber(str, size, false, value, 0U, width, padding, false);
+}
+
+size_t Format::intToStr(char* str, size_t size, int32_t value, uint8_t width, char padding, bool isSignForced)
+{
+    /* The magnitude is calculated unsigned, which handles INT32_MIN too. */
+    uint32_t magnitude = (0 > value) ? (0U - static_cast<uint32_t>(value)) : static_cast<uint32_t>(value);
+
+    return formatNumber(str, size, (0 > value), magnitude, 0U, width, padding, isSignForced);
+}
+
+size_t Format::fixedToStr(char* str, size_t size, int32_t value, uint8_t decimals, uint8_t width, char padding)
+{
+    uint32_t magnitude = (0 > value) ? (0U - static_cast<uint32_t>(value)) : static_cast<uint32_t>(value);
+
+    return formatNumber(str, size, (0 > value), magnitude, decimals, width, padding, false);
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Format a number into the destination string.
+ *
+ * @param[out]  str             Destination string
+ * @param[in]   size            Size of the destination string in byte
+ * @param[in]   isNegative      Is the value negative?
+ * @param[in]   magnitude       Absolute value, scaled by 10^decimals.
+ * @param[in]   decimals        Number of decimal places.
+ * @param[in]   width           Min. width, which is filled up with padding characters in front.
+ * @param[in]   padding         Padding character
+ * @param[in]   isSignForced    If true, a positive value gets a '+' sign.
+ *
+ * @return Length of the string without termination.
+ */
+static size_t formatNumber(char* str, size_t size, bool isNegative, uint32_t magnitude, uint8_t decimals,
+                           uint8_t width, char padding, bool isSignForced)
+{
+    size_t length = 0U;
+
+    if ((nullptr != str) && (0U < size))
+    {
+        char    digits[Format::MAX_VALUE_LENGTH]; /* Reversed digits and decimal point */
+        uint8_t numDigits = 0U;
+        char    sign      = '\0';
+        size_t  fieldLength;
+
+        if (Format::MAX_DECIMALS < decimals)
+        {
+            decimals = Format::MAX_DECIMALS;
+        }
+
+        /* Create the digits from the lowest one. A fixed-point value has
+         * at least one digit in front of the decimal point.
+         */
+        do
+        {
+            if ((0U < decimals) && (decimals == numDigits))
+            {
+                digits[numDigits] = '.';
+                ++numDigits;
+                decimals = 0U;
+            }
+
+            digits[numDigits] = static_cast<char>('0' + (magnitude % 10U));
+            ++numDigits;
+            magnitude /= 10U;
+        } while ((0U < magnitude) || (0U < decimals));
+
+        if (true == isNegative)
+        {
+            sign = '-';
+        }
+        else if (true == isSignForced)
+        {
+            sign = '+';
+        }
+        else
+        {
+            ;
+        }
+
+        fieldLength = numDigits + (('\0' != sign) ? 1U : 0U);
+
+        /* Blanks are placed in front of the sign, zeros behind it. */
+        if ('0' != padding)
+        {
+            while ((width > fieldLength) && ((size - 1U) > length))
+            {
+                str[length] = padding;
+                ++length;
+                --width;
+            }
+        }
+
+        if (('\0' != sign) && ((size - 1U) > length))
+        {
+            str[length] = sign;
+            ++length;
+        }
+
+        while ((width > fieldLength) && ((size - 1U) > length))
+        {
+            str[length] = '0';
+            ++length;
+            --width;
+        }
+
+        while ((0U < numDigits) && ((size - 1U) > length))
+        {
+            --numDigits;
+            str[length] = digits[numDigits];
+            ++length;
+        }
+
+        str[length] = '\0';
+    }
+
+    return length;
+}
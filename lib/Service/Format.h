@@ -0,0 +1,505 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Allocation-free string formatting
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <Arduino.h>
+
+/**
+ * Allocation-free formatting of integer and fixed-point values.
+ *
+ * All functions write into a caller provided buffer, which is always
+ * terminated. If the buffer is too small, the result is cut at its end.
+ */
+namespace Format
+{
+
+    /******************************************************************************
+     * Macros
+     *****************************************************************************/
+
+    /******************************************************************************
+     * Types and Classes
+     *****************************************************************************/
+
+    /** Max. length of a formatted 32-bit value without width padding: sign, 10 digits and decimal point. */
+    static const size_t MAX_VALUE_LENGTH = 12U;
+
+    /** Max. number of decimal places of a fixed-point value. */
+    static const uint8_t MAX_DECIMALS = 9U;
+
+    /******************************************************************************
+     * Functions
+     *****************************************************************************/
+
+    /**
+     * Unsigned integer to string.
+     *
+     * @param[out]  str     Destination string
+     * @param[in]   size    Size of the destination string in byte
+     * @param[in]   value   Value
+     * @param[in]   width   Min. width, which is filled up with padding characters in front.
+     * @param[in]   padding Padding character, e.g. ' ' or '0'.
+     *
+     * @return Length of the string without termination.
+     */
+    size_t uintToStr(char* str, size_t size, uint32_t value, uint8_t width = 0U, char padding = ' ');
+
+    /**
+     * Signed integer to string.
+     * With '0' as padding, the sign is placed in front of the zeros.
+     *
+     * @param[out]  str             Destination string
+     * @param[in]   size            Size of the destination string in byte
+     * @param[in]   value           Value
+     * @param[in]   width           Min. width, which is filled up with padding characters in front.
+     * @param[in]   padding         Padding character, e.g. ' ' or '0'.
+     * @param[in]   isSignForced    If true, a positive value gets a '+' sign.
+     *
+     * @return Length of the string without termination.
+     */
+    size_t intToStr(char* str, size_t size, int32_t value, uint8_t width = 0U, char padding = ' ',
+                    bool isSignForced = false);
+
+    /**
+     * Fixed-point value to string, e.g. -1234 with 2 decimals results in "-12.34".
+     *
+     * @param[out]  str         Destination string
+     * @param[in]   size        Size of the destination string in byte
+     * @param[in]   value       Value, scaled by 10^decimals.
+     * @param[in]   decimals    Number of decimal places [0; MAX_DECIMALS].
+     * @param[in]   width       Min. width, which is filled up with padding characters in front.
+     * @param[in]   padding     Padding character, e.g. ' ' or '0'.
+     *
+     * @return Length of the string without termination.
+     */
+    size_t fixedToStr(char* str, size_t size, int32_t value, uint8_t decimals, uint8_t width = 0U,
+                      char padding = ' ');
+
+} // namespace Format
+
+/**
+ * String builder with a static buffer, which fills one complete line or
+ * display update before it is written at once.
+ *
+ * There is no format string. Every field is added by a typed method,
+ * which is checked by the compiler, and the buffer size is a compile-time
+ * constant.
+ *
+ * @tparam SIZE Buffer size in byte, including the string termination.
+ */
+template<size_t SIZE>
+class FormatBuffer
+{
+public:
+    static_assert(Format::MAX_VALUE_LENGTH < SIZE, "Buffer too small for a single value.");
+
+    /**
+     * Constructs a empty buffer.
+     */
+    FormatBuffer() : m_length(0U), m_isTruncated(false)
+    {
+        m_buffer[0U] = '\0';
+    }
+
+    /**
+     * Destroys the buffer.
+     */
+    ~FormatBuffer()
+    {
+    }
+
+    /**
+     * Clear the buffer.
+     */
+    void clear()
+    {
+        m_length      = 0U;
+        m_isTruncated = false;
+        m_buffer[0U]  = '\0';
+    }
+
+    /**
+     * Add a string.
+     *
+     * @param[in] str   String
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(const char* str)
+    {
+        if (nullptr != str)
+        {
+            while ('\0' != *str)
+            {
+                add(*str);
+                ++str;
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * Add a string, which is located in program memory.
+     *
+     * @param[in] str   String in program memory
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(const __FlashStringHelper* str)
+    {
+        const char* flashStr = reinterpret_cast<const char*>(str);
+
+        if (nullptr != flashStr)
+        {
+            char chr = static_cast<char>(pgm_read_byte(flashStr));
+
+            while ('\0' != chr)
+            {
+                add(chr);
+                ++flashStr;
+                chr = static_cast<char>(pgm_read_byte(flashStr));
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * Add a single character.
+     *
+     * @param[in] chr   Character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(char chr)
+    {
+        if ((SIZE - 1U) > m_length)
+        {
+            m_buffer[m_length] = chr;
+            ++m_length;
+            m_buffer[m_length] = '\0';
+        }
+        else
+        {
+            m_isTruncated = true;
+        }
+
+        return *this;
+    }
+
+    /**
+     * Add a character, which terminates the content, e.g. a line feed.
+     * If the buffer is full, it replaces the last character, so it is never cut.
+     *
+     * @param[in] chr   Character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& addLast(char chr)
+    {
+        if ((SIZE - 1U) > m_length)
+        {
+            m_buffer[m_length] = chr;
+            ++m_length;
+            m_buffer[m_length] = '\0';
+        }
+        else
+        {
+            m_buffer[m_length - 1U] = chr;
+            m_isTruncated           = true;
+        }
+
+        return *this;
+    }
+
+    /*
+     * The unsigned integers are added by their fundamental types instead of
+     * uint8_t, uint16_t and uint32_t. Every fixed width type and size_t maps
+     * to one of them on every platform, so no call is ambiguous.
+     */
+
+    /**
+     * Add a unsigned integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(unsigned char value, uint8_t width = 0U, char padding = ' ')
+    {
+        return addUnsigned(value, width, padding);
+    }
+
+    /**
+     * Add a unsigned integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(unsigned short value, uint8_t width = 0U, char padding = ' ')
+    {
+        return addUnsigned(value, width, padding);
+    }
+
+    /**
+     * Add a unsigned integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(unsigned int value, uint8_t width = 0U, char padding = ' ')
+    {
+        return addUnsigned(value, width, padding);
+    }
+
+    /**
+     * Add a unsigned integer, e.g. a size_t on a 64-bit platform.
+     * Values above UINT32_MAX are limited to UINT32_MAX.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(unsigned long value, uint8_t width = 0U, char padding = ' ')
+    {
+        return addUnsigned(limitToUint32(value), width, padding);
+    }
+
+    /**
+     * Add a unsigned integer.
+     * Values above UINT32_MAX are limited to UINT32_MAX.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(unsigned long long value, uint8_t width = 0U, char padding = ' ')
+    {
+        return addUnsigned(limitToUint32(value), width, padding);
+    }
+
+    /**
+     * Add a signed integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(int32_t value, uint8_t width = 0U, char padding = ' ')
+    {
+        return addFixed(value, 0U, width, padding);
+    }
+
+    /**
+     * Add a signed integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(int16_t value, uint8_t width = 0U, char padding = ' ')
+    {
+        return add(static_cast<int32_t>(value), width, padding);
+    }
+
+    /**
+     * Add a signed integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& add(int8_t value, uint8_t width = 0U, char padding = ' ')
+    {
+        return add(static_cast<int32_t>(value), width, padding);
+    }
+
+    /**
+     * Add a fixed-point value.
+     *
+     * @param[in] value     Value, scaled by 10^decimals.
+     * @param[in] decimals  Number of decimal places.
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& addFixed(int32_t value, uint8_t decimals, uint8_t width = 0U, char padding = ' ')
+    {
+        char str[Format::MAX_VALUE_LENGTH + 1U];
+
+        (void)Format::fixedToStr(str, sizeof(str), value, decimals, limitWidth(width), padding);
+
+        return addPadded(str, width, padding);
+    }
+
+    /**
+     * Get the string.
+     *
+     * @return Terminated string
+     */
+    const char* getString() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     * Get the string length without termination.
+     *
+     * @return String length
+     */
+    size_t getLength() const
+    {
+        return m_length;
+    }
+
+    /**
+     * Was something cut, because the buffer was too small?
+     *
+     * @return If truncated, it will return true otherwise false.
+     */
+    bool isTruncated() const
+    {
+        return m_isTruncated;
+    }
+
+private:
+    char   m_buffer[SIZE]; /**< String buffer */
+    size_t m_length;       /**< String length without termination */
+    bool   m_isTruncated;  /**< Is string truncated? */
+
+    /**
+     * Add a unsigned integer.
+     *
+     * @param[in] value     Value
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& addUnsigned(uint32_t value, uint8_t width, char padding)
+    {
+        char str[Format::MAX_VALUE_LENGTH + 1U];
+
+        (void)Format::uintToStr(str, sizeof(str), value, limitWidth(width), padding);
+
+        return addPadded(str, width, padding);
+    }
+
+    /**
+     * Limit a unsigned integer to the 32-bit range, which can be formatted.
+     *
+     * @param[in] value Value
+     *
+     * @return Value limited to UINT32_MAX.
+     */
+    static uint32_t limitToUint32(unsigned long long value)
+    {
+        return (static_cast<unsigned long long>(UINT32_MAX) < value) ? UINT32_MAX : static_cast<uint32_t>(value);
+    }
+
+    /**
+     * Limit the width to the temporary value buffer. A wider field is
+     * filled up by addPadded().
+     *
+     * @param[in] width Min. width
+     *
+     * @return Width, which fits into the temporary value buffer.
+     */
+    static uint8_t limitWidth(uint8_t width)
+    {
+        return (Format::MAX_VALUE_LENGTH < width) ? static_cast<uint8_t>(Format::MAX_VALUE_LENGTH) : width;
+    }
+
+    /**
+     * Add a string, which is filled up with padding characters in front.
+     *
+     * @param[in] str       String
+     * @param[in] width     Min. width
+     * @param[in] padding   Padding character
+     *
+     * @return Format buffer
+     */
+    FormatBuffer& addPadded(const char* str, uint8_t width, char padding)
+    {
+        size_t length = 0U;
+
+        while ('\0' != str[length])
+        {
+            ++length;
+        }
+
+        while (width > length)
+        {
+            add(padding);
+            --width;
+        }
+
+        return add(str);
+    }
+};
+
+#endif /* FORMAT_H */
+/** @} */
@@ -0,0 +1,224 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Idle manager
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <IdleManager.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void IdleManager::start(uint32_t period)
+{
+    m_period      = period;
+    m_state       = STATE_STARTED;
+    m_hasDeadline = false;
+
+    clear();
+}
+
+void IdleManager::clear()
+{
+    m_busyTime     = 0U;
+    m_idleTime     = 0U;
+    m_minLatency   = 0U;
+    m_maxLatency   = 0U;
+    m_latencySum   = 0U;
+    m_latencyCount = 0U;
+    m_missedCount  = 0U;
+}
+
+void IdleManager::beginLoop(uint32_t timestamp)
+{
+    if (STATE_IDLE == m_state)
+    {
+        addTime(m_idleTime, timestamp - m_timestamp);
+    }
+    else if (STATE_BUSY == m_state)
+    {
+        /* The CPU didn't sleep, because a task was already due again. */
+        addTime(m_busyTime, timestamp - m_timestamp);
+    }
+    else
+    {
+        ;
+    }
+
+    if (STATE_STOPPED != m_state)
+    {
+        m_state     = STATE_BUSY;
+        m_timestamp = timestamp;
+    }
+}
+
+void IdleManager::beginIdle(uint32_t timestamp)
+{
+    if (STATE_BUSY == m_state)
+    {
+        addTime(m_busyTime, timestamp - m_timestamp);
+
+        m_state     = STATE_IDLE;
+        m_timestamp = timestamp;
+    }
+}
+
+void IdleManager::markDeadline(uint32_t timestamp)
+{
+    if (STATE_STOPPED == m_state)
+    {
+        ;
+    }
+    else if (false == m_hasDeadline)
+    {
+        m_deadline    = timestamp + m_period;
+        m_hasDeadline = true;
+    }
+    else
+    {
+        /* The deadlines may be a little bit ahead, because the periodic task
+         * is scheduled with a coarser clock. Starting early is no latency.
+         */
+        int32_t  lateness = static_cast<int32_t>(timestamp - m_deadline);
+        uint32_t latency  = (0 > lateness) ? 0U : static_cast<uint32_t>(lateness);
+
+        addLatency(latency);
+
+        if (m_period <= latency)
+        {
+            /* Missed a whole period, synchronize to the current start again. */
+            if (UINT32_MAX > m_missedCount)
+            {
+                ++m_missedCount;
+            }
+
+            m_deadline = timestamp + m_period;
+        }
+        else
+        {
+            m_deadline += m_period;
+        }
+    }
+}
+
+uint16_t IdleManager::getUtilization() const
+{
+    uint16_t utilization = 0U;
+    uint64_t total       = static_cast<uint64_t>(m_busyTime) + m_idleTime;
+
+    if (0U < total)
+    {
+        utilization = static_cast<uint16_t>((static_cast<uint64_t>(m_busyTime) * 1000U) / total);
+    }
+
+    return utilization;
+}
+
+uint32_t IdleManager::getAvgLatency() const
+{
+    uint32_t avgLatency = 0U;
+
+    if (0U < m_latencyCount)
+    {
+        avgLatency = m_latencySum / m_latencyCount;
+    }
+
+    return avgLatency;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void IdleManager::addTime(uint32_t& sum, uint32_t time)
+{
+    if ((UINT32_MAX - sum) < time)
+    {
+        sum = UINT32_MAX;
+    }
+    else
+    {
+        sum += time;
+    }
+}
+
+void IdleManager::addLatency(uint32_t latency)
+{
+    if ((0U == m_latencyCount) || (m_minLatency > latency))
+    {
+        m_minLatency = latency;
+    }
+
+    if (m_maxLatency < latency)
+    {
+        m_maxLatency = latency;
+    }
+
+    addTime(m_latencySum, latency);
+
+    if (UINT32_MAX > m_latencyCount)
+    {
+        ++m_latencyCount;
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
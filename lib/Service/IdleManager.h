@@ -0,0 +1,226 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Idle manager
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef IDLEMANAGER_H
+#define IDLEMANAGER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Keeps track of the time the main loop is busy and the time it sleeps until
+ * the next interrupt, which results in the CPU utilization. Additional it
+ * measures the wake-up latency of a periodic task: how late it starts compared
+ * to its ideal deadlines, which follow each other in a fixed period.
+ *
+ * The sleep itself is done by the application via the HAL, the manager only
+ * needs the timestamps.
+ */
+class IdleManager
+{
+public:
+    /**
+     * Constructs the idle manager.
+     */
+    IdleManager() :
+        m_period(0U),
+        m_state(STATE_STOPPED),
+        m_timestamp(0U),
+        m_hasDeadline(false),
+        m_deadline(0U),
+        m_busyTime(0U),
+        m_idleTime(0U),
+        m_minLatency(0U),
+        m_maxLatency(0U),
+        m_latencySum(0U),
+        m_latencyCount(0U),
+        m_missedCount(0U)
+    {
+    }
+
+    /**
+     * Destroys the idle manager.
+     */
+    ~IdleManager()
+    {
+    }
+
+    /**
+     * Start the measurement and clear the statistics.
+     *
+     * @param[in] period    Period of the supervised periodic task in us.
+     */
+    void start(uint32_t period);
+
+    /**
+     * Clear the statistics, e.g. after they were reported.
+     * The measurement itself continues.
+     */
+    void clear();
+
+    /**
+     * Call at the begin of each loop, after the CPU woke up.
+     *
+     * @param[in] timestamp Current timestamp in us.
+     */
+    void beginLoop(uint32_t timestamp);
+
+    /**
+     * Call after all due tasks have run, right before the CPU sleeps.
+     *
+     * @param[in] timestamp Current timestamp in us.
+     */
+    void beginIdle(uint32_t timestamp);
+
+    /**
+     * Call when the periodic task starts. The first call defines the phase of
+     * the deadlines. If a deadline was missed by a whole period, the deadlines
+     * are synchronized to the current start again.
+     *
+     * @param[in] timestamp Current timestamp in us.
+     */
+    void markDeadline(uint32_t timestamp);
+
+    /**
+     * Get the CPU utilization since the statistics were cleared.
+     *
+     * @return CPU utilization in permille
+     */
+    uint16_t getUtilization() const;
+
+    /**
+     * Get the min. wake-up latency since the statistics were cleared.
+     *
+     * @return Wake-up latency in us
+     */
+    uint32_t getMinLatency() const
+    {
+        return m_minLatency;
+    }
+
+    /**
+     * Get the average wake-up latency since the statistics were cleared.
+     *
+     * @return Wake-up latency in us
+     */
+    uint32_t getAvgLatency() const;
+
+    /**
+     * Get the max. wake-up latency since the statistics were cleared.
+     *
+     * @return Wake-up latency in us
+     */
+    uint32_t getMaxLatency() const
+    {
+        return m_maxLatency;
+    }
+
+    /**
+     * Get the number of deadlines, which were missed by a whole period,
+     * since the statistics were cleared.
+     *
+     * @return Number of missed deadlines
+     */
+    uint32_t getMissedCount() const
+    {
+        return m_missedCount;
+    }
+
+protected:
+private:
+    /**
+     * The state of the loop.
+     */
+    enum State
+    {
+        STATE_STOPPED = 0, /**< Measurement not started yet. */
+        STATE_STARTED,     /**< Started, but no timestamp available yet. */
+        STATE_BUSY,        /**< Loop is busy with the due tasks. */
+        STATE_IDLE         /**< CPU sleeps until the next interrupt. */
+    };
+
+    uint32_t m_period;       /**< Period of the periodic task in us. */
+    State    m_state;        /**< Current state of the loop. */
+    uint32_t m_timestamp;    /**< Timestamp of the last state change in us. */
+    bool     m_hasDeadline;  /**< Is the next deadline available? */
+    uint32_t m_deadline;     /**< Next deadline of the periodic task in us. */
+    uint32_t m_busyTime;     /**< Busy time in us. */
+    uint32_t m_idleTime;     /**< Idle time in us. */
+    uint32_t m_minLatency;   /**< Min. wake-up latency in us. */
+    uint32_t m_maxLatency;   /**< Max. wake-up latency in us. */
+    uint32_t m_latencySum;   /**< Sum of all wake-up latencies in us. */
+    uint32_t m_latencyCount; /**< Number of measured wake-up latencies. */
+    uint32_t m_missedCount;  /**< Number of missed deadlines. */
+
+    /**
+     * Add time to a time sum. The sum saturates instead of overflowing.
+     *
+     * @param[in,out]   sum     Time sum in us
+     * @param[in]       time    Time in us
+     */
+    static void addTime(uint32_t& sum, uint32_t time);
+
+    /**
+     * Add a wake-up latency to the statistics.
+     *
+     * @param[in] latency   Wake-up latency in us
+     */
+    void addLatency(uint32_t latency);
+
+    /* Not allowed. */
+    IdleManager(const IdleManager& manager);            /**< Copy construction of an instance. */
+    IdleManager& operator=(const IdleManager& manager); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* IDLEMANAGER_H */
+/** @} */
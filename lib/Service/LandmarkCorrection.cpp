@@ -0,0 +1,229 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Landmark based odometry drift correction
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "LandmarkCorrection.h"
+#include <Arduino.h>
+#include <FPMath.h>
+#include <Odometry.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/**
+ * Logging source.
+ */
+LOG_TAG("LMC");
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool LandmarkCorrection::addLandmark(Type type, int32_t posX, int32_t posY, int32_t orientation)
+{
+    bool isAdded = false;
+
+    if (MAX_LANDMARKS > m_numLandmarks)
+    {
+        Landmark& landmark = m_landmarks[m_numLandmarks];
+
+        landmark.type        = type;
+        landmark.posX        = posX;
+        landmark.posY        = posY;
+        landmark.orientation = orientation;
+
+        ++m_numLandmarks;
+        isAdded = true;
+    }
+
+    return isAdded;
+}
+
+void LandmarkCorrection::clear()
+{
+    m_numLandmarks = 0U;
+    m_statistics   = Statistics();
+}
+
+LandmarkCorrection::Result LandmarkCorrection::observe(Type type)
+{
+    Result    result      = RESULT_UNKNOWN;
+    Odometry& odometry    = Odometry::getInstance();
+    int32_t   posX        = 0;
+    int32_t   posY        = 0;
+    int32_t   orientation = odometry.getOrientation();
+    int32_t   minDistance = INT32_MAX;
+    uint8_t   matchIdx    = MAX_LANDMARKS;
+    bool      isTypeKnown = false;
+    uint8_t   idx;
+
+    odometry.getPosition(posX, posY);
+
+    /* Find the nearest landmark of the observed type. */
+    for (idx = 0U; idx < m_numLandmarks; ++idx)
+    {
+        if (type == m_landmarks[idx].type)
+        {
+            int32_t distance = abs(m_landmarks[idx].posX - posX) + abs(m_landmarks[idx].posY - posY);
+
+            isTypeKnown = true;
+
+            if (minDistance > distance)
+            {
+                minDistance = distance;
+                matchIdx    = idx;
+            }
+        }
+    }
+
+    if (MAX_LANDMARKS > matchIdx)
+    {
+        const Landmark& landmark            = m_landmarks[matchIdx];
+        int32_t         residualX           = landmark.posX - posX;
+        int32_t         residualY           = landmark.posY - posY;
+        int32_t         residualOrientation = wrapAngle(landmark.orientation - orientation);
+
+        /* The Manhattan distance is used for the gate, which avoids a square root. */
+        if (GATE_DISTANCE < minDistance)
+        {
+            ++m_statistics.rejections;
+
+            LOG_WARNING_VAL("Landmark rejected, residual (mm): ", minDistance);
+
+            result = RESULT_REJECTED;
+        }
+        else if (GATE_ORIENTATION < abs(residualOrientation))
+        {
+            ++m_statistics.rejections;
+
+            LOG_WARNING_VAL("Landmark rejected, orientation residual (mrad): ", residualOrientation);
+
+            result = RESULT_REJECTED;
+        }
+        else
+        {
+            int32_t deltaX           = (residualX * GAIN_NUMERATOR) / GAIN_DENOMINATOR;
+            int32_t deltaY           = (residualY * GAIN_NUMERATOR) / GAIN_DENOMINATOR;
+            int32_t deltaOrientation = (residualOrientation * GAIN_NUMERATOR) / GAIN_DENOMINATOR;
+
+            odometry.setPosition(posX + deltaX, posY + deltaY);
+            odometry.setOrientation(orientation + deltaOrientation);
+
+            ++m_statistics.corrections;
+            m_statistics.lastDeltaX           = deltaX;
+            m_statistics.lastDeltaY           = deltaY;
+            m_statistics.lastDeltaOrientation = deltaOrientation;
+
+            if (m_statistics.maxResidual < minDistance)
+            {
+                m_statistics.maxResidual = minDistance;
+            }
+
+            LOG_INFO_VAL("Landmark dx (mm): ", deltaX);
+            LOG_INFO_VAL("Landmark dy (mm): ", deltaY);
+            LOG_INFO_VAL("Landmark do (mrad): ", deltaOrientation);
+
+            result = RESULT_CORRECTED;
+        }
+    }
+
+    /* An unknown landmark type is learned at the current pose. Landmarks
+     * of a known type, which are outside the gate, are not learned, because
+     * it could be a false detection.
+     */
+    if ((false == isTypeKnown) && (true == m_isLearningEnabled))
+    {
+        if (true == addLandmark(type, posX, posY, orientation))
+        {
+            LOG_INFO_VAL("Landmark learned: ", type);
+
+            result = RESULT_LEARNED;
+        }
+    }
+
+    return result;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+int32_t LandmarkCorrection::wrapAngle(int32_t angle)
+{
+    angle %= FP_2PI();
+
+    if (FP_PI() < angle)
+    {
+        angle -= FP_2PI();
+    }
+    else if (-FP_PI() >= angle)
+    {
+        angle += FP_2PI();
+    }
+    else
+    {
+        ;
+    }
+
+    return angle;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
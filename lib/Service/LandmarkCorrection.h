@@ -0,0 +1,232 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Landmark based odometry drift correction
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef LANDMARK_CORRECTION_H
+#define LANDMARK_CORRECTION_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Corrects the odometry pose at landmarks with a known pose.
+ *
+ * If the application detects a landmark, e.g. the start line, it reports
+ * the landmark type. The landmark of this type, which is nearest to the
+ * current odometry position, is matched. If it is within the gate, the
+ * odometry pose is moved by a part of the residual towards it. A residual
+ * outside the gate is considered as false detection and rejected.
+ *
+ * The landmark poses are either known in advance or learned: With learning
+ * enabled, a detected landmark without a match is stored with the current
+ * pose, e.g. during the first lap.
+ */
+class LandmarkCorrection
+{
+public:
+    /** Landmark types, which the application can detect. */
+    enum Type
+    {
+        TYPE_START_LINE = 0, /**< Start line */
+        TYPE_END_LINE,       /**< End line */
+        TYPE_MARKER          /**< Marker on the playfield */
+    };
+
+    /** Result of a landmark observation. */
+    enum Result
+    {
+        RESULT_CORRECTED = 0, /**< Pose corrected. */
+        RESULT_LEARNED,       /**< New landmark learned. */
+        RESULT_REJECTED,      /**< No landmark of this type within the gate. */
+        RESULT_UNKNOWN        /**< No landmark of this type and nothing learned. */
+    };
+
+    /** Correction statistics */
+    struct Statistics
+    {
+        uint16_t corrections;          /**< Number of pose corrections. */
+        uint16_t rejections;           /**< Number of rejected observations. */
+        int32_t  lastDeltaX;           /**< Last applied x correction [mm]. */
+        int32_t  lastDeltaY;           /**< Last applied y correction [mm]. */
+        int32_t  lastDeltaOrientation; /**< Last applied orientation correction [mrad]. */
+        int32_t  maxResidual;          /**< Largest position residual of an accepted observation [mm]. */
+    };
+
+    /** Max. number of landmarks. */
+    static const uint8_t MAX_LANDMARKS = 8U;
+
+    /** Max. position residual in mm, which is accepted. */
+    static const int32_t GATE_DISTANCE = 250;
+
+    /** Max. orientation residual in mrad, which is accepted. */
+    static const int32_t GATE_ORIENTATION = 600;
+
+    /** Part of the residual, which is corrected per observation: numerator. */
+    static const int32_t GAIN_NUMERATOR = 1;
+
+    /** Part of the residual, which is corrected per observation: denominator. */
+    static const int32_t GAIN_DENOMINATOR = 2;
+
+    /**
+     * Get landmark correction instance.
+     *
+     * @return Landmark correction instance.
+     */
+    static LandmarkCorrection& getInstance()
+    {
+        static LandmarkCorrection instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Add a landmark with known pose.
+     *
+     * @param[in] type          Landmark type
+     * @param[in] posX          x-coordinate [mm]
+     * @param[in] posY          y-coordinate [mm]
+     * @param[in] orientation   Orientation of the robot, when it detects the landmark [mrad].
+     *
+     * @return If the landmark is added, it will return true otherwise false.
+     */
+    bool addLandmark(Type type, int32_t posX, int32_t posY, int32_t orientation);
+
+    /**
+     * Remove all landmarks and clear the statistics.
+     */
+    void clear();
+
+    /**
+     * Enable or disable learning of unknown landmarks.
+     *
+     * @param[in] isEnabled Enable (true) or disable (false)
+     */
+    void enableLearning(bool isEnabled)
+    {
+        m_isLearningEnabled = isEnabled;
+    }
+
+    /**
+     * Handle a detected landmark. Call it once per detection, e.g. on the
+     * rising edge of a line detection.
+     *
+     * @param[in] type  Landmark type
+     *
+     * @return Result of the observation.
+     */
+    Result observe(Type type);
+
+    /**
+     * Get number of landmarks.
+     *
+     * @return Number of landmarks
+     */
+    uint8_t getNumLandmarks() const
+    {
+        return m_numLandmarks;
+    }
+
+    /**
+     * Get the correction statistics.
+     *
+     * @return Statistics
+     */
+    const Statistics& getStatistics() const
+    {
+        return m_statistics;
+    }
+
+private:
+    /** A landmark */
+    struct Landmark
+    {
+        Type    type;        /**< Landmark type */
+        int32_t posX;        /**< x-coordinate [mm] */
+        int32_t posY;        /**< y-coordinate [mm] */
+        int32_t orientation; /**< Orientation [mrad] */
+    };
+
+    Landmark   m_landmarks[MAX_LANDMARKS]; /**< Landmarks */
+    uint8_t    m_numLandmarks;             /**< Number of landmarks */
+    bool       m_isLearningEnabled;        /**< Are unknown landmarks learned? */
+    Statistics m_statistics;               /**< Correction statistics */
+
+    /**
+     * Construct the landmark correction instance.
+     */
+    LandmarkCorrection() : m_landmarks(), m_numLandmarks(0U), m_isLearningEnabled(false), m_statistics()
+    {
+    }
+
+    /**
+     * Destroy the landmark correction instance.
+     */
+    ~LandmarkCorrection()
+    {
+    }
+
+    /* Not allowed. */
+    LandmarkCorrection(const LandmarkCorrection& value);            /**< Copy construction of an instance. */
+    LandmarkCorrection& operator=(const LandmarkCorrection& value); /**< Assignment of an instance. */
+
+    /**
+     * Wrap an angle into ]-PI; PI].
+     *
+     * @param[in] angle Angle [mrad]
+     *
+     * @return Wrapped angle [mrad]
+     */
+    static int32_t wrapAngle(int32_t angle);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LANDMARK_CORRECTION_H */
+/** @} */
@@ -0,0 +1,127 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Latency meter
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <LatencyMeter.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void LatencyMeter::start()
+{
+    m_startTimestamp = micros();
+}
+
+void LatencyMeter::stop()
+{
+    m_last = micros() - m_startTimestamp;
+
+    if ((0U == m_count) || (m_min > m_last))
+    {
+        m_min = m_last;
+    }
+
+    if (m_max < m_last)
+    {
+        m_max = m_last;
+    }
+
+    /* Restart the statistics before the sum overflows. */
+    if ((UINT32_MAX - m_sum) < m_last)
+    {
+        m_sum   = 0U;
+        m_count = 0U;
+    }
+
+    m_sum += m_last;
+    ++m_count;
+}
+
+void LatencyMeter::clear()
+{
+    m_last  = 0U;
+    m_min   = 0U;
+    m_max   = 0U;
+    m_sum   = 0U;
+    m_count = 0U;
+}
+
+uint32_t LatencyMeter::getAverage() const
+{
+    uint32_t average = 0U;
+
+    if (0U < m_count)
+    {
+        average = m_sum / m_count;
+    }
+
+    return average;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,159 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Latency meter
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef LATENCYMETER_H
+#define LATENCYMETER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Measures the latency of a processing chain in microseconds, e.g. from
+ * sensor acquisition to actuation, and keeps the statistics about it.
+ */
+class LatencyMeter
+{
+public:
+    /**
+     * Constructs the latency meter.
+     */
+    LatencyMeter() : m_startTimestamp(0U), m_last(0U), m_min(0U), m_max(0U), m_sum(0U), m_count(0U)
+    {
+    }
+
+    /**
+     * Destroys the latency meter.
+     */
+    ~LatencyMeter()
+    {
+    }
+
+    /**
+     * Start a measurement at the begin of the processing chain.
+     */
+    void start();
+
+    /**
+     * Stop the measurement at the end of the processing chain and
+     * update the statistics.
+     */
+    void stop();
+
+    /**
+     * Clear the statistics.
+     */
+    void clear();
+
+    /**
+     * Get the latency of the last measurement.
+     *
+     * @return Latency in us
+     */
+    uint32_t getLast() const
+    {
+        return m_last;
+    }
+
+    /**
+     * Get the min. latency since the statistics were cleared.
+     *
+     * @return Latency in us
+     */
+    uint32_t getMin() const
+    {
+        return m_min;
+    }
+
+    /**
+     * Get the max. latency since the statistics were cleared.
+     *
+     * @return Latency in us
+     */
+    uint32_t getMax() const
+    {
+        return m_max;
+    }
+
+    /**
+     * Get the average latency since the statistics were cleared.
+     *
+     * @return Latency in us
+     */
+    uint32_t getAverage() const;
+
+    /**
+     * Get the number of measurements since the statistics were cleared.
+     *
+     * @return Number of measurements
+     */
+    uint32_t getCount() const
+    {
+        return m_count;
+    }
+
+protected:
+private:
+    uint32_t m_startTimestamp; /**< Timestamp in us at start of the measurement. */
+    uint32_t m_last;           /**< Latency of the last measurement in us. */
+    uint32_t m_min;            /**< Min. latency in us. */
+    uint32_t m_max;            /**< Max. latency in us. */
+    uint32_t m_sum;            /**< Sum of all latencies in us, used for the average. */
+    uint32_t m_count;          /**< Number of measurements. */
+
+    /* Not allowed. */
+    LatencyMeter(const LatencyMeter& meter);            /**< Copy construction of an instance. */
+    LatencyMeter& operator=(const LatencyMeter& meter); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LATENCYMETER_H */
+/** @} */
@@ -0,0 +1,272 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Line follow control law
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef LINE_FOLLOW_CONTROLLER_HPP
+#define LINE_FOLLOW_CONTROLLER_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+#include <PIDController.h>
+#include <Snapshot.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The control law of the line follower: the PID controller calculates the
+ * wheel speed difference from the line position every second control period
+ * and the track is lost, if the line is beside the outer sensors.
+ *
+ * It is independent of the board, so the same law runs on the robot and in
+ * the batch simulation. Board dependent values are passed with every call,
+ * because they are not part of a snapshot.
+ *
+ * The parameter set is defined by the application. It needs the fields
+ * topSpeed, kPNumerator, kPDenominator, kINumerator, kIDenominator,
+ * kDNumerator and kDDenominator.
+ */
+class LineFollowController
+{
+public:
+    /** Max. distance in mm after a lost track must be found again. */
+    static const uint32_t MAX_DISTANCE = 200U;
+
+    /**
+     * Number of control cycles per PID processing. The controller is processed
+     * once per application control period of 5 ms.
+     */
+    static const uint8_t PID_PROCESS_CYCLES = 2U;
+
+    /** Period in ms for PID processing, which results from the PID process cycles. */
+    static const uint32_t PID_PROCESS_PERIOD = 10U;
+
+    /**
+     * Constructs the line follow controller.
+     */
+    LineFollowController() : m_pidCycleCnt(0U), m_pidCtrl(), m_topSpeed(0)
+    {
+    }
+
+    /**
+     * Destroys the line follow controller.
+     */
+    ~LineFollowController()
+    {
+    }
+
+    /**
+     * Start a new run with the parameter set.
+     * The first process() call calculates the wheel speeds immediately.
+     *
+     * @tparam TParameterSet    The parameter set type.
+     *
+     * @param[in] parSet        Parameter set
+     * @param[in] maxMotorSpeed Max. motor speed in [steps/s]
+     */
+    template<typename TParameterSet>
+    void start(const TParameterSet& parSet, int16_t maxMotorSpeed)
+    {
+        m_pidCycleCnt = 0U; /* Immediate */
+        m_topSpeed    = parSet.topSpeed;
+
+        m_pidCtrl.clear();
+        m_pidCtrl.setPFactor(parSet.kPNumerator, parSet.kPDenominator);
+        m_pidCtrl.setIFactor(parSet.kINumerator, parSet.kIDenominator);
+        m_pidCtrl.setDFactor(parSet.kDNumerator, parSet.kDDenominator);
+        m_pidCtrl.setSampleTime(PID_PROCESS_PERIOD);
+        m_pidCtrl.setLimits(-maxMotorSpeed, maxMotorSpeed);
+        m_pidCtrl.setDerivativeOnMeasurement(true);
+    }
+
+    /**
+     * Process one control period on track.
+     *
+     * The PID runs in phase with the control cycle, therefore the new wheel
+     * speed set points shall be taken over right after and not one control
+     * period later.
+     *
+     * @param[in]  position         Line position
+     * @param[in]  sensorValueMax   Max. line sensor value
+     * @param[in]  maxMotorSpeed    Max. motor speed in [steps/s]
+     * @param[out] speedLeft        Linear speed set point left in [steps/s]
+     * @param[out] speedRight       Linear speed set point right in [steps/s]
+     *
+     * @return If new wheel speed set points are calculated, it will return true otherwise false.
+     */
+    bool process(int16_t position, uint16_t sensorValueMax, int16_t maxMotorSpeed, int16_t& speedLeft,
+                 int16_t& speedRight)
+    {
+        bool isCalculated = false;
+
+        if (0U == m_pidCycleCnt)
+        {
+            /* Our "error" is how far we are away from the center of the
+             * line, which corresponds to position (max. line sensor value multiplied
+             * with sensor index).
+             *
+             * Get motor speed difference using PID terms.
+             */
+            int16_t speedDifference = m_pidCtrl.calculate(sensorValueMax * 2, position); /* [steps/s] */
+
+            /* Get individual motor speeds.  The sign of speedDifference
+             * determines if the robot turns left or right.
+             */
+            int16_t leftSpeed  = m_topSpeed - speedDifference; /* [steps/s] */
+            int16_t rightSpeed = m_topSpeed + speedDifference; /* [steps/s] */
+
+            /* Constrain our motor speeds to be between 0 and maxSpeed.
+             * One motor will always be turning at maxSpeed, and the other
+             * will be at maxSpeed-|speedDifference| if that is positive,
+             * else it will be stationary. For some applications, you
+             * might want to allow the motor speed to go negative so that
+             * it can spin in reverse.
+             */
+            speedLeft  = constrain(leftSpeed, 0, maxMotorSpeed);
+            speedRight = constrain(rightSpeed, 0, maxMotorSpeed);
+
+            m_pidCycleCnt = PID_PROCESS_CYCLES;
+            isCalculated  = true;
+        }
+
+        --m_pidCycleCnt;
+
+        return isCalculated;
+    }
+
+    /**
+     * Resynchronize the PID controller, after the robot is back on track.
+     * This avoids a output bump.
+     */
+    void resync()
+    {
+        m_pidCtrl.resync();
+    }
+
+    /**
+     * Set the top speed, e.g. by a speed governor.
+     *
+     * @param[in] topSpeed  Top speed in [steps/s]
+     */
+    void setTopSpeed(int16_t topSpeed)
+    {
+        m_topSpeed = topSpeed;
+    }
+
+    /**
+     * Get the top speed.
+     *
+     * @return Top speed in [steps/s]
+     */
+    int16_t getTopSpeed() const
+    {
+        return m_topSpeed;
+    }
+
+    /**
+     * Is the track lost?
+     * Note, no debouncing is done here. If necessary, it shall be done
+     * outside this method.
+     *
+     * @param[in] position          Line position
+     * @param[in] numLineSensors    Number of line sensors
+     *
+     * @return If the track is lost, it will return true otherwise false.
+     */
+    static bool isTrackGapDetected(int16_t position, uint8_t numLineSensors)
+    {
+        /* Position value after loosing the track and sensor 0 saw it as last.
+         * It depends on the Zumo32U4LineSensors::readLine() implementation.
+         */
+        const int16_t POS_MIN = 0;
+
+        /* Position value after loosing the track and sensor N saw it as last.
+         * It depends on the Zumo32U4LineSensors::readLine() implementation.
+         */
+        const int16_t POS_MAX = (numLineSensors - 1) * 1000;
+
+        return ((POS_MIN >= position) || (POS_MAX <= position));
+    }
+
+    /**
+     * Save the state to a snapshot.
+     *
+     * @param[in,out] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const
+    {
+        (void)snapshot.put(m_pidCycleCnt);
+        m_pidCtrl.save(snapshot);
+        (void)snapshot.put(m_topSpeed);
+    }
+
+    /**
+     * Restore the state from a snapshot.
+     *
+     * @param[in,out] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot)
+    {
+        (void)snapshot.get(m_pidCycleCnt);
+        m_pidCtrl.restore(snapshot);
+        (void)snapshot.get(m_topSpeed);
+    }
+
+private:
+    uint8_t                m_pidCycleCnt; /**< Control periods till the next PID calculation. */
+    PIDController<int16_t> m_pidCtrl;     /**< PID controller of the line position. */
+    int16_t                m_topSpeed;    /**< Top speed in [steps/s]. It might be lower or equal to the max. speed! */
+
+    /* Not allowed. */
+    LineFollowController(const LineFollowController& ctrl);            /**< Copy construction of an instance. */
+    LineFollowController& operator=(const LineFollowController& ctrl); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LINE_FOLLOW_CONTROLLER_HPP */
+/** @} */
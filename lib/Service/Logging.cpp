@@ -59,6 +59,22 @@
  */
 static bool gIsLogEnabled = true;
 
+/**
+ * Output, where the log messages are printed to.
+ */
+static Print* gOutput = &Serial;
+
+/**
+ * Transmit queue, if the output is a queue, otherwise nullptr.
+ */
+static SerialTxQueue* gTxQueue = nullptr;
+
+/**
+ * Log record, which is assembled by printHead(), printMsg() and printTail().
+ * It is written at once, so a record is never interleaved or partially dropped.
+ */
+static Logging::LineBuffer gRecord;
+
 /******************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -90,46 +106,84 @@ void Logging::disable()
     gIsLogEnabled = false;
 }
 
-void Logging::printHead(const char* filename, int lineNumber, Logging::LogLevel level)
+void Logging::setOutput(Print& output)
+{
+    gOutput  = &output;
+    gTxQueue = nullptr;
+}
+
+void Logging::setOutput(SerialTxQueue& queue)
+{
+    gOutput  = &queue;
+    gTxQueue = &queue;
+}
+
+Print& Logging::getOutput()
+{
+    return *gOutput;
+}
+
+void Logging::printHead(const __FlashStringHelper* filename, int lineNumber, Logging::LogLevel level)
 {
     if (true == isEnabled())
     {
-        const char* levelStr = "U";
-
-        switch (level)
-        {
-        case Logging::LOG_LEVEL_FATAL:
-            levelStr = "F";
-            break;
-
-        case Logging::LOG_LEVEL_ERROR:
-            levelStr = "E";
-            break;
-
-        case Logging::LOG_LEVEL_WARNING:
-            levelStr = "W";
-            break;
-
-        case Logging::LOG_LEVEL_INFO:
-            levelStr = "I";
-            break;
-
-        case Logging::LOG_LEVEL_DEBUG:
-            levelStr = "D";
-            break;
-
-        default:
-            break;
-        }
-
-        Serial.print(static_cast<uint32_t>(millis()));
-        Serial.print(" ");
-        Serial.print(levelStr);
-        Serial.print(" ");
-        Serial.print(filename);
-        Serial.print(":");
-        Serial.print(lineNumber);
-        Serial.print(" ");
+        gRecord.clear();
+        addHead(gRecord, filename, lineNumber, level);
+    }
+}
+
+void Logging::addHead(LineBuffer& line, const __FlashStringHelper* filename, int lineNumber, Logging::LogLevel level)
+{
+    char levelChr = 'U';
+
+    switch (level)
+    {
+    case Logging::LOG_LEVEL_FATAL:
+        levelChr = 'F';
+        break;
+
+    case Logging::LOG_LEVEL_ERROR:
+        levelChr = 'E';
+        break;
+
+    case Logging::LOG_LEVEL_WARNING:
+        levelChr = 'W';
+        break;
+
+    case Logging::LOG_LEVEL_INFO:
+        levelChr = 'I';
+        break;
+
+    case Logging::LOG_LEVEL_DEBUG:
+        levelChr = 'D';
+        break;
+
+    default:
+        break;
+    }
+
+    (void)line.add(static_cast<uint32_t>(millis()))
+        .add(' ')
+        .add(levelChr)
+        .add(' ')
+        .add(filename)
+        .add(':')
+        .add(static_cast<int32_t>(lineNumber))
+        .add(' ');
+}
+
+void Logging::writeLine(const LineBuffer& line)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(line.getString());
+
+    /* The first byte of a log line is no channel, therefore it must never be coalesced. */
+    if (nullptr != gTxQueue)
+    {
+        (void)gTxQueue->enqueue(SerialTxQueue::KEY_NONE, data, line.getLength());
+    }
+    else
+    {
+        (void)gOutput->write(data, line.getLength());
     }
 }
 
@@ -137,7 +191,15 @@ void Logging::printMsg(const char* message)
 {
     if (true == isEnabled())
     {
-        Serial.print(message);
+        (void)gRecord.add(message);
+    }
+}
+
+void Logging::printMsg(const __FlashStringHelper* message)
+{
+    if (true == isEnabled())
+    {
+        (void)gRecord.add(message);
     }
 }
 
@@ -145,16 +207,34 @@ void Logging::printTail()
 {
     if (true == isEnabled())
     {
-        Serial.print("\n");
+        (void)gRecord.addLast('\n');
+        writeLine(gRecord);
+        gRecord.clear();
     }
 }
 
-void Logging::print(const char* filename, int lineNumber, Logging::LogLevel level, const char* message)
+void Logging::print(const __FlashStringHelper* filename, int lineNumber, Logging::LogLevel level, const char* message)
 {
     if (true == isEnabled())
     {
-        printHead(filename, lineNumber, level);
-        Serial.println(message);
+        LineBuffer line;
+
+        addHead(line, filename, lineNumber, level);
+        (void)line.add(message).addLast('\n');
+        writeLine(line);
+    }
+}
+
+void Logging::print(const __FlashStringHelper* filename, int lineNumber, Logging::LogLevel level,
+                    const __FlashStringHelper* message)
+{
+    if (true == isEnabled())
+    {
+        LineBuffer line;
+
+        addHead(line, filename, lineNumber, level);
+        (void)line.add(message).addLast('\n');
+        writeLine(line);
     }
 }
 
@@ -69,6 +69,8 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <Format.h>
+#include <SerialTxQueue.h>
 
 /******************************************************************************
  * Macros
@@ -76,8 +78,11 @@
 
 #if LOG_FATAL_ENABLE || LOG_ERROR_ENABLE || LOG_WARNING_ENABLE || LOG_INFO_ENABLE || LOG_DEBUG_ENABLE
 
-/** Define the logging tag to know in which file the log message is located. */
-#define LOG_TAG(_tag) static const char* LOG_TAG = _tag
+/** Define the logging tag to know in which file the log message is located. It is stored in program memory. */
+#define LOG_TAG(_tag) static const char LOG_TAG[] PROGMEM = _tag
+
+/** The logging tag as string in program memory. */
+#define LOG_FLASH_TAG (reinterpret_cast<const __FlashStringHelper*>(LOG_TAG))
 
 #else /* LOG_FATAL_ENABLE || LOG_ERROR_ENABLE || LOG_WARNING_ENABLE || LOG_INFO_ENABLE || LOG_DEBUG_ENABLE */
 
@@ -86,6 +91,12 @@
 
 #endif /* LOG_FATAL_ENABLE || LOG_ERROR_ENABLE || LOG_WARNING_ENABLE || LOG_INFO_ENABLE || LOG_DEBUG_ENABLE */
 
+/*
+ * The messages of LOG_xxx() and LOG_xxx_VAL() must be string literals, because
+ * they are stored in program memory. LOG_xxx_MSG() takes a string in RAM or a
+ * string in program memory, created with F().
+ */
+
 #if (0 == LOG_FATAL_ENABLE)
 
 /** Log fatal error message. */
@@ -102,13 +113,13 @@
 #else /* (0 == LOG_FATAL_ENABLE) */
 
 /** Log fatal error message. */
-#define LOG_FATAL(_msg)           Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_FATAL, (_msg))
+#define LOG_FATAL(_msg)           Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_FATAL, F(_msg))
 
 /** Log fatal error message with additional value. */
-#define LOG_FATAL_VAL(_msg, _val) Logging::print<_val>(LOG_TAG, __LINE__, Logging::LOG_LEVEL_FATAL, (_msg), (_val))
+#define LOG_FATAL_VAL(_msg, _val) Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_FATAL, F(_msg), (_val))
 
 /** Log fatal error header. */
-#define LOG_FATAL_HEAD()          Logging::printHead(LOG_TAG, __LINE__, Logging::LOG_LEVEL_FATAL)
+#define LOG_FATAL_HEAD()          Logging::printHead(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_FATAL)
 
 /** Log fatal error message, without line feed. */
 #define LOG_FATAL_MSG(_msg)       Logging::printMsg(_msg)
@@ -134,13 +145,13 @@
 #else /* (0 == LOG_ERROR_ENABLE) */
 
 /** Log error message. */
-#define LOG_ERROR(_msg)           Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_ERROR, (_msg))
+#define LOG_ERROR(_msg)           Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_ERROR, F(_msg))
 
 /** Log error message with additional value. */
-#define LOG_ERROR_VAL(_msg, _val) Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_ERROR, (_msg), (_val))
+#define LOG_ERROR_VAL(_msg, _val) Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_ERROR, F(_msg), (_val))
 
 /** Log error header. */
-#define LOG_ERROR_HEAD()          Logging::printHead(LOG_TAG, __LINE__, Logging::LOG_LEVEL_ERROR)
+#define LOG_ERROR_HEAD()          Logging::printHead(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_ERROR)
 
 /** Log error error message, without line feed. */
 #define LOG_ERROR_MSG(_msg)       Logging::printMsg(_msg)
@@ -166,13 +177,13 @@
 #else /* (0 == LOG_WARNING_ENABLE) */
 
 /** Log warning message. */
-#define LOG_WARNING(_msg)           Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_WARNING, (_msg))
+#define LOG_WARNING(_msg)           Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_WARNING, F(_msg))
 
 /** Log warning message with additional value. */
-#define LOG_WARNING_VAL(_msg, _val) Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_WARNING, (_msg), (_val))
+#define LOG_WARNING_VAL(_msg, _val) Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_WARNING, F(_msg), (_val))
 
 /** Log warning header. */
-#define LOG_WARNING_HEAD()          Logging::printHead(LOG_TAG, __LINE__, Logging::LOG_LEVEL_WARNING)
+#define LOG_WARNING_HEAD()          Logging::printHead(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_WARNING)
 
 /** Log warning message, without line feed. */
 #define LOG_WARNING_MSG(_msg)       Logging::printMsg(_msg)
@@ -198,13 +209,13 @@
 #else /* (0 == LOG_INFO_ENABLE) */
 
 /** Log info message. */
-#define LOG_INFO(_msg)           Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_INFO, (_msg))
+#define LOG_INFO(_msg)           Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_INFO, F(_msg))
 
 /** Log info message with additional value. */
-#define LOG_INFO_VAL(_msg, _val) Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_INFO, (_msg), (_val))
+#define LOG_INFO_VAL(_msg, _val) Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_INFO, F(_msg), (_val))
 
 /** Log info header. */
-#define LOG_INFO_HEAD()          Logging::printHead(LOG_TAG, __LINE__, Logging::LOG_LEVEL_INFO)
+#define LOG_INFO_HEAD()          Logging::printHead(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_INFO)
 
 /** Log info message, without line feed. */
 #define LOG_INFO_MSG(_msg)       Logging::printMsg(_msg)
@@ -230,13 +241,13 @@
 #else /* (0 == LOG_DEBUG_ENABLE) */
 
 /** Log debug message. */
-#define LOG_DEBUG(_msg)           Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_DEBUG, (_msg))
+#define LOG_DEBUG(_msg)           Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_DEBUG, F(_msg))
 
 /** Log debug message with additional value. */
-#define LOG_DEBUG_VAL(_msg, _val) Logging::print(LOG_TAG, __LINE__, Logging::LOG_LEVEL_DEBUG, (_msg), (_val))
+#define LOG_DEBUG_VAL(_msg, _val) Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_DEBUG, F(_msg), (_val))
 
 /** Log debug header. */
-#define LOG_DEBUG_HEAD()          Logging::printHead(LOG_TAG, __LINE__, Logging::LOG_LEVEL_DEBUG)
+#define LOG_DEBUG_HEAD()          Logging::printHead(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_DEBUG)
 
 /** Log debug message, without line feed. */
 #define LOG_DEBUG_MSG(_msg)       Logging::printMsg(_msg)
@@ -268,6 +279,15 @@ namespace Logging
         LOG_LEVEL_DEBUG,   /**< A diagnostic message helpful for the developer. */
     };
 
+    /**
+     * Max. size of a log line in byte, including the termination.
+     * Longer lines are cut, but always keep their line feed.
+     */
+    static const size_t LINE_SIZE = 80U;
+
+    /** A log line is filled completely before it is written to the output at once. */
+    typedef FormatBuffer<LINE_SIZE> LineBuffer;
+
     /**
      * Is logging enabled?
      *
@@ -285,56 +305,121 @@ namespace Logging
      */
     void disable();
 
+    /**
+     * Set the output, where the log messages are printed to.
+     * By default it is the Serial driver.
+     *
+     * @param[in] output    Output for the log messages.
+     */
+    void setOutput(Print& output);
+
+    /**
+     * Set a transmit queue as output, where the log messages are printed to.
+     * Every log record is queued as one record, so it is either sent
+     * completely or dropped completely on overflow.
+     *
+     * @param[in] queue Transmit queue for the log messages.
+     */
+    void setOutput(SerialTxQueue& queue);
+
+    /**
+     * Get the output, where the log messages are printed to.
+     *
+     * @return Output for the log messages.
+     */
+    Print& getOutput();
+
     /**
      * Print log message header.
-     * Use printMsg() to log the message itself.
+     * Use printMsg() to log the message itself and printTail() to finish the record.
+     * The record is assembled in a line and written by printTail() at once.
      *
-     * @param[in] filename      The name of the file, where the log message is located.
+     * @param[in] filename      The name of the file in program memory, where the log message is located.
      * @param[in] lineNumber    The line number in the file, where the log message is located.
      * @param[in] level         The severity level.
      */
-    void printHead(const char* filename, int lineNumber, LogLevel level);
+    void printHead(const __FlashStringHelper* filename, int lineNumber, LogLevel level);
+
+    /**
+     * Add log message header to a log line.
+     *
+     * @param[out] line         The log line.
+     * @param[in]  filename     The name of the file in program memory, where the log message is located.
+     * @param[in]  lineNumber   The line number in the file, where the log message is located.
+     * @param[in]  level        The severity level.
+     */
+    void addHead(LineBuffer& line, const __FlashStringHelper* filename, int lineNumber, LogLevel level);
+
+    /**
+     * Write a log line to the output.
+     *
+     * @param[in] line  The log line.
+     */
+    void writeLine(const LineBuffer& line);
 
     /**
      * Print message without line feed.
-     * It can be used several times to concatenate a message without additional buffering.
+     * It can be used several times to concatenate a message. It is cut at the end of the line.
      *
      * @param[in] message The message itself.
      */
     void printMsg(const char* message);
 
     /**
-     * Print tail of log message.
+     * Print message from program memory without line feed.
+     * It can be used several times to concatenate a message. It is cut at the end of the line.
+     *
+     * @param[in] message The message itself in program memory.
+     */
+    void printMsg(const __FlashStringHelper* message);
+
+    /**
+     * Print tail of log message and write the whole record to the output.
      */
     void printTail();
 
     /**
      * Print log message.
      *
-     * @param[in] filename      The name of the file, where the log message is located.
+     * @param[in] filename      The name of the file in program memory, where the log message is located.
      * @param[in] lineNumber    The line number in the file, where the log message is located.
      * @param[in] level         The severity level.
      * @param[in] message       The message itself.
      */
-    void print(const char* filename, int lineNumber, LogLevel level, const char* message);
+    void print(const __FlashStringHelper* filename, int lineNumber, LogLevel level, const char* message);
+
+    /**
+     * Print log message from program memory.
+     *
+     * @param[in] filename      The name of the file in program memory, where the log message is located.
+     * @param[in] lineNumber    The line number in the file, where the log message is located.
+     * @param[in] level         The severity level.
+     * @param[in] message       The message itself in program memory.
+     */
+    void print(const __FlashStringHelper* filename, int lineNumber, LogLevel level,
+               const __FlashStringHelper* message);
 
     /**
      * Print log message.
      *
-     * @param[in] filename      The name of the file, where the log message is located.
+     * @tparam    TMsg          The message type, which is either a string in RAM or in program memory.
+     * @tparam    T             The value type.
+     * @param[in] filename      The name of the file in program memory, where the log message is located.
      * @param[in] lineNumber    The line number in the file, where the log message is located.
      * @param[in] level         The severity level.
      * @param[in] message       The message itself.
      * @param[in] value         The value to print after the message.
      */
-    template<typename T>
-    void print(const char* filename, int lineNumber, LogLevel level, const char* message, T value)
+    template<typename TMsg, typename T>
+    void print(const __FlashStringHelper* filename, int lineNumber, LogLevel level, TMsg message, T value)
     {
         if (true == isEnabled())
         {
-            printHead(filename, lineNumber, level);
-            Serial.print(message);
-            Serial.println(value);
+            LineBuffer line;
+
+            addHead(line, filename, lineNumber, level);
+            (void)line.add(message).add(value).addLast('\n');
+            writeLine(line);
         }
     }
 
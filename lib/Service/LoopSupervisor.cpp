@@ -0,0 +1,190 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Loop health supervisor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <LoopSupervisor.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void LoopSupervisor::start(uint32_t maxLoopPeriod, uint32_t loopQuantum)
+{
+    m_maxLoopPeriod = (maxLoopPeriod < loopQuantum) ? loopQuantum : maxLoopPeriod;
+    m_isRunning     = true;
+    m_lastPeriod    = 0U;
+    m_maxPeriod     = 0U;
+    m_avgPeriodSum  = 0U;
+    m_overrunCount  = 0U;
+
+    reset();
+}
+
+void LoopSupervisor::reset()
+{
+    /* The loop period is measured from the next call on. */
+    m_hasTimestamp   = false;
+    m_level          = LEVEL_NORMAL;
+    m_overrunStreak  = 0U;
+    m_recoveryStreak = 0U;
+}
+
+bool LoopSupervisor::process(uint32_t timestamp)
+{
+    bool isChanged = false;
+
+    if (false == m_isRunning)
+    {
+        ;
+    }
+    else if (false == m_hasTimestamp)
+    {
+        m_lastTimestamp = timestamp;
+        m_hasTimestamp  = true;
+    }
+    else
+    {
+        m_lastPeriod    = timestamp - m_lastTimestamp;
+        m_lastTimestamp = timestamp;
+
+        if (m_maxPeriod < m_lastPeriod)
+        {
+            m_maxPeriod = m_lastPeriod;
+        }
+
+        /* The first period initializes the moving average. */
+        if (0U == m_avgPeriodSum)
+        {
+            m_avgPeriodSum = m_lastPeriod << AVG_PERIOD_SHIFT;
+        }
+        else
+        {
+            m_avgPeriodSum = m_avgPeriodSum - (m_avgPeriodSum >> AVG_PERIOD_SHIFT) + m_lastPeriod;
+        }
+
+        if (m_maxLoopPeriod < m_lastPeriod)
+        {
+            isChanged = handleOverrun();
+        }
+        else
+        {
+            isChanged = handleInTime();
+        }
+    }
+
+    return isChanged;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+bool LoopSupervisor::handleOverrun()
+{
+    bool isChanged = false;
+
+    if (UINT32_MAX > m_overrunCount)
+    {
+        ++m_overrunCount;
+    }
+
+    m_recoveryStreak = 0U;
+    ++m_overrunStreak;
+
+    if (ESCALATION_STREAK <= m_overrunStreak)
+    {
+        m_overrunStreak = 0U;
+
+        if (LEVEL_STOP != m_level)
+        {
+            m_level   = static_cast<Level>(m_level + 1);
+            isChanged = true;
+        }
+    }
+
+    return isChanged;
+}
+
+bool LoopSupervisor::handleInTime()
+{
+    bool isChanged = false;
+
+    m_overrunStreak = 0U;
+    ++m_recoveryStreak;
+
+    if (RECOVERY_STREAK <= m_recoveryStreak)
+    {
+        m_recoveryStreak = 0U;
+
+        /* The stop is latched, only a reset leaves it. */
+        if ((LEVEL_NORMAL != m_level) && (LEVEL_STOP != m_level))
+        {
+            m_level   = static_cast<Level>(m_level - 1);
+            isChanged = true;
+        }
+    }
+
+    return isChanged;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,234 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Loop health supervisor
+ * @author Andreas Merkle <web@blue-andi.de>
+ * 
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef LOOPSUPERVISOR_H
+#define LOOPSUPERVISOR_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Supervises the period of the main loop. If the loop overruns several times
+ * in a row, the supervisor steps to the next degradation level. The application
+ * decides what each level means, e.g. shed output, limit the speed or stop.
+ * After a long enough streak of loops in time, it steps back one level.
+ * The stop level is latched until the supervisor is reset.
+ */
+class LoopSupervisor
+{
+public:
+    /**
+     * The degradation levels, ordered by severity.
+     */
+    enum Level
+    {
+        LEVEL_NORMAL = 0,  /**< The loop runs in time. */
+        LEVEL_SHED_OUTPUT, /**< Shed output, which is not necessary for driving, e.g. telemetry and logging. */
+        LEVEL_LIMIT_SPEED, /**< Limit the driving speed. */
+        LEVEL_STOP         /**< Stop driving in a controlled way. */
+    };
+
+    /**
+     * Number of overruns in a row, which step to the next degradation level.
+     */
+    static const uint8_t ESCALATION_STREAK = 3U;
+
+    /**
+     * Number of loops in time in a row, which step back one degradation level.
+     */
+    static const uint16_t RECOVERY_STREAK = 500U;
+
+    /**
+     * Constructs the loop supervisor.
+     */
+    LoopSupervisor() :
+        m_maxLoopPeriod(0U),
+        m_isRunning(false),
+        m_hasTimestamp(false),
+        m_lastTimestamp(0U),
+        m_level(LEVEL_NORMAL),
+        m_overrunStreak(0U),
+        m_recoveryStreak(0U),
+        m_lastPeriod(0U),
+        m_maxPeriod(0U),
+        m_avgPeriodSum(0U),
+        m_overrunCount(0U)
+    {
+    }
+
+    /**
+     * Destroys the loop supervisor.
+     */
+    ~LoopSupervisor()
+    {
+    }
+
+    /**
+     * Start the supervision with normal level.
+     *
+     * The loop can't run faster than it is scheduled, e.g. once per simulation
+     * step. If the loop quantum is longer than the max. loop period, a loop
+     * period is only an overrun, if it is longer than the loop quantum.
+     *
+     * @param[in] maxLoopPeriod Max. loop period in us, a longer period is an overrun.
+     * @param[in] loopQuantum   Scheduling quantum of the loop in us, 0 if none.
+     */
+    void start(uint32_t maxLoopPeriod, uint32_t loopQuantum);
+
+    /**
+     * Reset to normal level, e.g. after a stop was handled by the application.
+     * The statistics are kept.
+     */
+    void reset();
+
+    /**
+     * Process the supervision once per loop.
+     *
+     * @param[in] timestamp Current timestamp in us.
+     *
+     * @return If the degradation level changed, it will return true otherwise false.
+     */
+    bool process(uint32_t timestamp);
+
+    /**
+     * Get the current degradation level.
+     *
+     * @return Degradation level
+     */
+    Level getLevel() const
+    {
+        return m_level;
+    }
+
+    /**
+     * Get the last loop period.
+     *
+     * @return Loop period in us
+     */
+    uint32_t getLastPeriod() const
+    {
+        return m_lastPeriod;
+    }
+
+    /**
+     * Get the max. loop period since start.
+     *
+     * @return Loop period in us
+     */
+    uint32_t getMaxPeriod() const
+    {
+        return m_maxPeriod;
+    }
+
+    /**
+     * Get the average loop period. It is a moving average, which weights the
+     * last loop periods most.
+     *
+     * @return Loop period in us
+     */
+    uint32_t getAvgPeriod() const
+    {
+        return m_avgPeriodSum >> AVG_PERIOD_SHIFT;
+    }
+
+    /**
+     * Get the number of overruns since start.
+     *
+     * @return Number of overruns
+     */
+    uint32_t getOverrunCount() const
+    {
+        return m_overrunCount;
+    }
+
+protected:
+private:
+    /**
+     * Weight of a new loop period in the moving average as power of two,
+     * e.g. 4 means 1/16.
+     */
+    static const uint8_t AVG_PERIOD_SHIFT = 4U;
+
+    uint32_t m_maxLoopPeriod;  /**< Max. loop period in us. */
+    bool     m_isRunning;      /**< Is supervision running? */
+    bool     m_hasTimestamp;   /**< Is the timestamp of the last loop available? */
+    uint32_t m_lastTimestamp;  /**< Timestamp of the last loop in us. */
+    Level    m_level;          /**< Current degradation level. */
+    uint8_t  m_overrunStreak;  /**< Number of overruns in a row. */
+    uint16_t m_recoveryStreak; /**< Number of loops in time in a row. */
+    uint32_t m_lastPeriod;     /**< Last loop period in us. */
+    uint32_t m_maxPeriod;      /**< Max. loop period in us. */
+    uint32_t m_avgPeriodSum;   /**< Average loop period in us, scaled by 2^AVG_PERIOD_SHIFT. */
+    uint32_t m_overrunCount;   /**< Number of overruns. */
+
+    /**
+     * Handle a loop, which overran.
+     *
+     * @return If the degradation level changed, it will return true otherwise false.
+     */
+    bool handleOverrun();
+
+    /**
+     * Handle a loop, which was in time.
+     *
+     * @return If the degradation level changed, it will return true otherwise false.
+     */
+    bool handleInTime();
+
+    /* Not allowed. */
+    LoopSupervisor(const LoopSupervisor& supervisor);            /**< Copy construction of an instance. */
+    LoopSupervisor& operator=(const LoopSupervisor& supervisor); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* LOOPSUPERVISOR_H */
+/** @} */
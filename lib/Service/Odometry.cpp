@@ -87,9 +87,9 @@ void Odometry::process()
          */
         if ((STEPS_THRESHOLD <= absStepsLeft) || (STEPS_THRESHOLD <= absStepsRight))
         {
-            int16_t stepsCenter = (relStepsLeft + relStepsRight) / 2; /* [steps] */
-            int16_t dXSteps     = 0;                                  /* [steps] */
-            int16_t dYSteps     = 0;                                  /* [steps] */
+            int16_t stepsCenter = calculateStepsCenter(relStepsLeft, relStepsRight); /* [steps] */
+            int16_t dXSteps     = 0;                                                 /* [steps] */
+            int16_t dYSteps     = 0;                                                 /* [steps] */
 
             /* Mileage accuracy depends on STEPS_THRESHOLD. */
             m_mileage = calculateMileage(m_mileage, stepsCenter);
@@ -135,11 +135,49 @@ void Odometry::clearPosition()
     m_countingYSteps = 0;
 }
 
+void Odometry::setPosition(int32_t posX, int32_t posY)
+{
+    m_posX           = posX;
+    m_posY           = posY;
+    m_countingXSteps = 0;
+    m_countingYSteps = 0;
+}
+
 void Odometry::clearMileage()
 {
     m_mileage = 0;
 }
 
+void Odometry::save(Snapshot& snapshot) const
+{
+    (void)snapshot.put(m_lastAbsRelEncStepsLeft);
+    (void)snapshot.put(m_lastAbsRelEncStepsRight);
+    (void)snapshot.put(m_mileage);
+    m_relEncoders.save(snapshot);
+    (void)snapshot.put(m_orientation);
+    (void)snapshot.put(m_posX);
+    (void)snapshot.put(m_posY);
+    (void)snapshot.put(m_countingXSteps);
+    (void)snapshot.put(m_countingYSteps);
+    m_timer.save(snapshot);
+    (void)snapshot.put(m_isStandstill);
+}
+
+void Odometry::restore(Snapshot& snapshot)
+{
+    (void)snapshot.get(m_lastAbsRelEncStepsLeft);
+    (void)snapshot.get(m_lastAbsRelEncStepsRight);
+    (void)snapshot.get(m_mileage);
+    m_relEncoders.restore(snapshot);
+    (void)snapshot.get(m_orientation);
+    (void)snapshot.get(m_posX);
+    (void)snapshot.get(m_posY);
+    (void)snapshot.get(m_countingXSteps);
+    (void)snapshot.get(m_countingYSteps);
+    m_timer.restore(snapshot);
+    (void)snapshot.get(m_isStandstill);
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -191,27 +229,40 @@ bool Odometry::detectStandStill(uint16_t absStepsLeft, uint16_t absStepsRight)
     return m_isStandstill;
 }
 
-int32_t Odometry::calculateMileage(uint32_t mileage, int16_t stepsCenter)
+uint32_t Odometry::calculateMileage(uint32_t mileage, int16_t stepsCenter)
 {
     return mileage + static_cast<uint32_t>(abs(stepsCenter));
 }
 
-int32_t Odometry::calculateOrientation(int32_t orientation, int16_t stepsLeft, int16_t stepsRight) const
+int16_t Odometry::calculateStepsCenter(int16_t stepsLeft, int16_t stepsRight) const
 {
-    /* The alpha is approximated for performance reason. */
-    int32_t stepsLeft32  = static_cast<int32_t>(stepsLeft);
-    int32_t stepsRight32 = static_cast<int32_t>(stepsRight);
-    int32_t alpha        = (stepsRight32 - stepsLeft32) * 1000; /* 1000 * [steps] */
+    /* The sum exceeds 16 bit, the unit types widen it automatically. */
+    Units::EncoderSteps left(stepsLeft);   /* [steps] */
+    Units::EncoderSteps right(stepsRight); /* [steps] */
 
-    alpha /= static_cast<int32_t>(RobotConstants::ENCODER_STEPS_PER_MM); /* 1000 * [mm] */
-    alpha /= static_cast<int32_t>(RobotConstants::WHEEL_BASE);           /* [mrad] */
-    alpha %= FP_2PI();                                                   /* -2*PI < alpha < +2*PI */
+    return (left + right).scale<1, 2>().value();
+}
 
-    /* Calculate orientation */
-    orientation += alpha;
-    orientation %= FP_2PI(); /* -2*PI < orientation < +2*PI */
+int32_t Odometry::calculateOrientation(int32_t orientation, int16_t stepsLeft, int16_t stepsRight) const
+{
+    typedef Units::Quantity<Units::Milliradian, -FP_2PI() + 1, FP_2PI() - 1> Orientation;
 
-    return orientation;
+    /* The alpha is approximated for performance reason.
+     * alpha = 1000 * (steps right - steps left) / steps per mm / wheel base
+     * The factor is reduced at compile time. After the first wrap around, the
+     * sum and its wrap around need only 16 bit, which replaces a 32 bit modulo
+     * by a 16 bit modulo on the target.
+     */
+    Units::EncoderSteps left(stepsLeft);   /* [steps] */
+    Units::EncoderSteps right(stepsRight); /* [steps] */
+    Orientation         alpha =
+        (right - left)
+            .convert<Units::Milliradian, 1000,
+                     static_cast<int64_t>(RobotConstants::ENCODER_STEPS_PER_MM * RobotConstants::WHEEL_BASE)>()
+            .wrap<FP_2PI()>(); /* -2*PI < alpha < +2*PI */
+
+    /* Calculate orientation, -2*PI < orientation < +2*PI */
+    return (Orientation(static_cast<Orientation::Type>(orientation)) + alpha).wrap<FP_2PI()>().value();
 }
 
 void Odometry::calculateDeltaPos(int16_t stepsCenter, int32_t orientation, int16_t& dXSteps, int16_t& dYSteps) const
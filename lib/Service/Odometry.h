@@ -48,6 +48,8 @@
 #include <RelativeEncoders.h>
 #include <SimpleTimer.h>
 #include <FPMath.h>
+#include <Snapshot.h>
+#include <Units.hpp>
 
 /******************************************************************************
  * Macros
@@ -143,6 +145,15 @@ public:
      */
     void clearPosition();
 
+    /**
+     * Set absolute position in coordinate system, e.g. to correct the drift
+     * at a landmark with known position.
+     *
+     * @param[in] posX  x-coordinate [mm]
+     * @param[in] posY  y-coordinate [mm]
+     */
+    void setPosition(int32_t posX, int32_t posY);
+
     /**
      * Clear mileage by setting it to 0 mm.
      */
@@ -158,6 +169,20 @@ public:
         return m_isStandstill;
     }
 
+    /**
+     * Save the odometry state to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the odometry state from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
 private:
     /**
      * If at least one side moved about 2 mm, a new calculation shall be done.
@@ -252,14 +277,24 @@ private:
     bool detectStandStill(uint16_t absStepsLeft, uint16_t absStepsRight);
 
     /**
-     * Calculate the mileage in mm.
+     * Calculate the mileage in encoder steps.
      *
-     * @param[in]   mileage     Mileage in mm
+     * @param[in]   mileage     Mileage in encoder steps
      * @param[in]   stepsCenter Number of steps center
      *
-     * @return Mileage in mm
+     * @return Mileage in encoder steps
+     */
+    uint32_t calculateMileage(uint32_t mileage, int16_t stepsCenter);
+
+    /**
+     * Calculate the number of steps center.
+     *
+     * @param[in] stepsLeft     Number of encoder steps left
+     * @param[in] stepsRight    Number of encoder steps right
+     *
+     * @return Number of steps center
      */
-    int32_t calculateMileage(uint32_t mileage, int16_t stepsCenter);
+    int16_t calculateStepsCenter(int16_t stepsLeft, int16_t stepsRight) const;
 
     /**
      * Calculate the orientation in mrad.
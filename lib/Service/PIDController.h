@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <Snapshot.h>
 
 /******************************************************************************
  * Macros
@@ -551,6 +552,63 @@ public:
         m_isDerivativeOnMeasurement = enable;
     }
 
+    /**
+     * Save the parameters and the internal state to a snapshot.
+     * Change the parameters after a restore to fork a variant.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const
+    {
+        (void)snapshot.put(m_kPNumerator);
+        (void)snapshot.put(m_kPDenominator);
+        (void)snapshot.put(m_kINumerator);
+        (void)snapshot.put(m_kIDenominator);
+        (void)snapshot.put(m_kDNumerator);
+        (void)snapshot.put(m_kDDenominator);
+        (void)snapshot.put(m_kINumeratorDT);
+        (void)snapshot.put(m_kIDenominatorDT);
+        (void)snapshot.put(m_kDNumeratorDT);
+        (void)snapshot.put(m_kDDenominatorDT);
+        (void)snapshot.put(m_min);
+        (void)snapshot.put(m_max);
+        (void)snapshot.put(m_lastError);
+        (void)snapshot.put(m_integral);
+        (void)snapshot.put(m_lastOutput);
+        (void)snapshot.put(m_sampleTime);
+        (void)snapshot.put(m_resync);
+        (void)snapshot.put(m_isDerivativeOnMeasurement);
+        (void)snapshot.put(m_lastProcessValue);
+    }
+
+    /**
+     * Restore the parameters and the internal state from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot)
+    {
+        (void)snapshot.get(m_kPNumerator);
+        (void)snapshot.get(m_kPDenominator);
+        (void)snapshot.get(m_kINumerator);
+        (void)snapshot.get(m_kIDenominator);
+        (void)snapshot.get(m_kDNumerator);
+        (void)snapshot.get(m_kDDenominator);
+        (void)snapshot.get(m_kINumeratorDT);
+        (void)snapshot.get(m_kIDenominatorDT);
+        (void)snapshot.get(m_kDNumeratorDT);
+        (void)snapshot.get(m_kDDenominatorDT);
+        (void)snapshot.get(m_min);
+        (void)snapshot.get(m_max);
+        (void)snapshot.get(m_lastError);
+        (void)snapshot.get(m_integral);
+        (void)snapshot.get(m_lastOutput);
+        (void)snapshot.get(m_sampleTime);
+        (void)snapshot.get(m_resync);
+        (void)snapshot.get(m_isDerivativeOnMeasurement);
+        (void)snapshot.get(m_lastProcessValue);
+    }
+
     /**
      * Default sample time in ms.
      * Keep value lower than 128 to avoid conflict in case T is int8_t.
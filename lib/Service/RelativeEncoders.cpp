@@ -84,6 +84,24 @@ int16_t RelativeEncoders::getCountsRight() const
     return m_absEncoders.getCountsRight() - m_referencePointRight;
 }
 
+void RelativeEncoders::save(Snapshot& snapshot) const
+{
+    (void)snapshot.put(getCountsLeft());
+    (void)snapshot.put(getCountsRight());
+}
+
+void RelativeEncoders::restore(Snapshot& snapshot)
+{
+    int16_t countsLeft  = 0;
+    int16_t countsRight = 0;
+
+    if ((true == snapshot.get(countsLeft)) && (true == snapshot.get(countsRight)))
+    {
+        m_referencePointLeft  = m_absEncoders.getCountsLeft() - countsLeft;
+        m_referencePointRight = m_absEncoders.getCountsRight() - countsRight;
+    }
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <Board.h>
+#include <Snapshot.h>
 
 /******************************************************************************
  * Macros
@@ -112,6 +113,21 @@ public:
      */
     int16_t getCountsRight() const;
 
+    /**
+     * Save the relative encoder steps to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the relative encoder steps from a snapshot.
+     * The reference points are recalculated from the current absolute steps.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
 private:
     /**
      *  Absolute encoders
@@ -0,0 +1,174 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Sequence lock
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Compiler barrier, memory accesses are not moved across it. */
+#define SEQLOCK_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Exchanges data lock-free between a single writer and a reader, which run in
+ * different contexts on a single core, e.g. the main loop and an interrupt.
+ * The writer marks a write in progress with an odd sequence number. The reader
+ * copies the data and detects by the sequence number, whether the data was
+ * written meanwhile.
+ *
+ * If the writer can interrupt the reader, the reader may retry with read().
+ * If the reader can interrupt the writer, it must not wait for it and shall
+ * use tryRead() and keep its last data on failure.
+ *
+ * @tparam T    The type of the exchanged data.
+ */
+template<typename T>
+class SeqLock
+{
+public:
+    /**
+     * Constructs the sequence lock with default data.
+     */
+    SeqLock() : m_sequence(0U), m_data()
+    {
+    }
+
+    /**
+     * Constructs the sequence lock with initial data.
+     *
+     * @param[in] data  Initial data
+     */
+    explicit SeqLock(const T& data) : m_sequence(0U), m_data(data)
+    {
+    }
+
+    /**
+     * Destroys the sequence lock.
+     */
+    ~SeqLock()
+    {
+    }
+
+    /**
+     * Write the data. Only one writer is allowed.
+     *
+     * @param[in] data  Data
+     */
+    void write(const T& data)
+    {
+        /* Odd, the write is in progress. */
+        ++m_sequence;
+        SEQLOCK_BARRIER();
+
+        m_data = data;
+
+        /* Even, the write is finished. */
+        SEQLOCK_BARRIER();
+        ++m_sequence;
+    }
+
+    /**
+     * Try to read consistent data once.
+     *
+     * @param[out] data Data, only valid if successful.
+     *
+     * @return If the data is consistent, it will return true otherwise false.
+     */
+    bool tryRead(T& data) const
+    {
+        bool    isConsistent = false;
+        uint8_t sequence     = m_sequence;
+
+        if (0U == (sequence & 1U))
+        {
+            SEQLOCK_BARRIER();
+            data = m_data;
+            SEQLOCK_BARRIER();
+
+            isConsistent = (sequence == m_sequence);
+        }
+
+        return isConsistent;
+    }
+
+    /**
+     * Read consistent data. It retries until no write interfered.
+     * Use it only, if the writer can interrupt the reader or runs in the
+     * same context.
+     *
+     * @return Data
+     */
+    T read() const
+    {
+        T data;
+
+        while (false == tryRead(data))
+        {
+            ;
+        }
+
+        return data;
+    }
+
+private:
+    volatile uint8_t m_sequence; /**< Sequence number, odd while a write is in progress. */
+    T                m_data;     /**< Exchanged data. */
+
+    /* Not allowed. */
+    SeqLock(const SeqLock& lock);            /**< Copy construction of an instance. */
+    SeqLock& operator=(const SeqLock& lock); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SEQLOCK_HPP */
+/** @} */
@@ -0,0 +1,485 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Bounded non-blocking serial transmit queue
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SerialTxQueue.h"
+#include "Util.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void SerialTxQueue::setCoalescable(uint8_t key, bool isCoalescable)
+{
+    if (MAX_EXCLUDABLE_KEYS > key)
+    {
+        uint32_t mask = (1UL << key);
+
+        if (true == isCoalescable)
+        {
+            m_nonCoalescableKeys &= ~mask;
+        }
+        else
+        {
+            m_nonCoalescableKeys |= mask;
+        }
+    }
+}
+
+bool SerialTxQueue::enqueue(uint8_t key, const uint8_t* data, size_t length)
+{
+    bool isQueued = false;
+
+    if ((nullptr == data) || (0U == length))
+    {
+        ;
+    }
+    else if ((UINT8_MAX < length) || ((BUFFER_SIZE - RECORD_HEADER_SIZE) < length))
+    {
+        /* The record will never fit into the queue. */
+        ++m_statistics.droppedRecords;
+        m_statistics.droppedBytes += length;
+    }
+    else
+    {
+        uint16_t recordSize = RECORD_HEADER_SIZE + length;
+        uint16_t dataIdx    = 0U;
+
+        if ((POLICY_COALESCE == m_policy) && (true == isCoalescable(key)) &&
+            (true == findRecord(key, static_cast<uint8_t>(length), dataIdx)))
+        {
+            copyToBuffer(dataIdx, data, length);
+            ++m_statistics.coalescedRecords;
+            isQueued = true;
+        }
+        else
+        {
+            if (POLICY_DROP_NEWEST != m_policy)
+            {
+                while (((BUFFER_SIZE - m_usedBytes) < recordSize) && (true == dropOldest()))
+                {
+                    ;
+                }
+            }
+
+            if ((BUFFER_SIZE - m_usedBytes) >= recordSize)
+            {
+                m_buffer[m_writeIdx]              = key;
+                m_buffer[advance(m_writeIdx, 1U)] = static_cast<uint8_t>(length);
+                copyToBuffer(advance(m_writeIdx, RECORD_HEADER_SIZE), data, length);
+
+                m_writeIdx = advance(m_writeIdx, recordSize);
+                m_usedBytes += recordSize;
+
+                if (m_statistics.maxPendingBytes < m_usedBytes)
+                {
+                    m_statistics.maxPendingBytes = m_usedBytes;
+                }
+
+                isQueued = true;
+            }
+            else
+            {
+                ++m_statistics.droppedRecords;
+                m_statistics.droppedBytes += length;
+            }
+        }
+    }
+
+    return isQueued;
+}
+
+size_t SerialTxQueue::process(size_t budget)
+{
+    size_t sentBytes = 0U;
+    size_t limit     = budget;
+    int    space     = m_serial.availableForWrite();
+    bool   isStalled = false;
+
+    /* Never hand over more than the serial driver accepts without blocking. */
+    if (0 >= space)
+    {
+        limit = 0U;
+    }
+    else if (static_cast<size_t>(space) < limit)
+    {
+        limit = static_cast<size_t>(space);
+    }
+    else
+    {
+        ;
+    }
+
+    while ((0U < m_usedBytes) && (sentBytes < limit) && (false == isStalled))
+    {
+        uint8_t  length    = m_buffer[advance(m_readIdx, 1U)];
+        uint16_t dataIdx   = advance(m_readIdx, RECORD_HEADER_SIZE + m_headSentBytes);
+        size_t   chunkSize = length - m_headSentBytes;
+        size_t   written   = 0U;
+
+        /* Limit to the remaining budget and to the contiguous part of the ring buffer. */
+        if ((limit - sentBytes) < chunkSize)
+        {
+            chunkSize = limit - sentBytes;
+        }
+
+        if (static_cast<size_t>(BUFFER_SIZE - dataIdx) < chunkSize)
+        {
+            chunkSize = static_cast<size_t>(BUFFER_SIZE - dataIdx);
+        }
+
+        written = m_serial.write(&m_buffer[dataIdx], chunkSize);
+
+        sentBytes += written;
+        m_headSentBytes += static_cast<uint8_t>(written);
+
+        if (length == m_headSentBytes)
+        {
+            m_readIdx = advance(m_readIdx, RECORD_HEADER_SIZE + length);
+            m_usedBytes -= RECORD_HEADER_SIZE + length;
+            m_headSentBytes = 0U;
+        }
+
+        if (written < chunkSize)
+        {
+            isStalled = true;
+        }
+    }
+
+    m_statistics.sentBytes += sentBytes;
+
+    return sentBytes;
+}
+
+void SerialTxQueue::clear()
+{
+    m_readIdx       = 0U;
+    m_writeIdx      = 0U;
+    m_usedBytes     = 0U;
+    m_headSentBytes = 0U;
+}
+
+void SerialTxQueue::clearStatistics()
+{
+    m_statistics.sentBytes        = 0U;
+    m_statistics.droppedRecords   = 0U;
+    m_statistics.droppedBytes     = 0U;
+    m_statistics.coalescedRecords = 0U;
+    m_statistics.maxPendingBytes  = m_usedBytes;
+}
+
+size_t SerialTxQueue::write(const uint8_t* buffer, size_t length)
+{
+    size_t  queuedBytes = 0U;
+    uint8_t key         = KEY_NONE;
+
+    if (nullptr != buffer)
+    {
+        key = buffer[0U];
+    }
+
+    if (true == enqueue(key, buffer, length))
+    {
+        queuedBytes = length;
+    }
+
+    return queuedBytes;
+}
+
+#ifdef TARGET_NATIVE
+
+void SerialTxQueue::print(const char str[])
+{
+    (void)write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+}
+
+void SerialTxQueue::print(uint8_t value)
+{
+    print(static_cast<uint32_t>(value));
+}
+
+void SerialTxQueue::print(uint16_t value)
+{
+    print(static_cast<uint32_t>(value));
+}
+
+void SerialTxQueue::print(uint32_t value)
+{
+    char str[11U];
+
+    Util::uintToStr(str, sizeof(str), value);
+    print(str);
+}
+
+void SerialTxQueue::print(int8_t value)
+{
+    print(static_cast<int32_t>(value));
+}
+
+void SerialTxQueue::print(int16_t value)
+{
+    print(static_cast<int32_t>(value));
+}
+
+void SerialTxQueue::print(int32_t value)
+{
+    char str[12U];
+
+    Util::intToStr(str, sizeof(str), value);
+    print(str);
+}
+
+void SerialTxQueue::println(const char str[])
+{
+    print(str);
+    print("\n");
+}
+
+void SerialTxQueue::println(uint8_t value)
+{
+    print(value);
+    print("\n");
+}
+
+void SerialTxQueue::println(uint16_t value)
+{
+    print(value);
+    print("\n");
+}
+
+void SerialTxQueue::println(uint32_t value)
+{
+    print(value);
+    print("\n");
+}
+
+void SerialTxQueue::println(int8_t value)
+{
+    print(value);
+    print("\n");
+}
+
+void SerialTxQueue::println(int16_t value)
+{
+    print(value);
+    print("\n");
+}
+
+void SerialTxQueue::println(int32_t value)
+{
+    print(value);
+    print("\n");
+}
+
+int SerialTxQueue::available() const
+{
+    return m_serial.available();
+}
+
+size_t SerialTxQueue::readBytes(uint8_t* buffer, size_t length)
+{
+    return m_serial.readBytes(buffer, length);
+}
+
+#else /* TARGET_NATIVE */
+
+size_t SerialTxQueue::write(uint8_t value)
+{
+    return write(&value, 1U);
+}
+
+int SerialTxQueue::availableForWrite()
+{
+    int freeBytes = BUFFER_SIZE - m_usedBytes;
+
+    if (RECORD_HEADER_SIZE < freeBytes)
+    {
+        freeBytes -= RECORD_HEADER_SIZE;
+    }
+    else
+    {
+        freeBytes = 0;
+    }
+
+    return freeBytes;
+}
+
+int SerialTxQueue::available()
+{
+    return m_serial.available();
+}
+
+int SerialTxQueue::read()
+{
+    return m_serial.read();
+}
+
+int SerialTxQueue::peek()
+{
+    return m_serial.peek();
+}
+
+void SerialTxQueue::flush()
+{
+    /* Nothing to do, because it would block. */
+}
+
+#endif /* TARGET_NATIVE */
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SerialTxQueue::copyToBuffer(uint16_t idx, const uint8_t* data, uint16_t length)
+{
+    uint16_t dataIdx = 0U;
+
+    while (length > dataIdx)
+    {
+        m_buffer[advance(idx, dataIdx)] = data[dataIdx];
+        ++dataIdx;
+    }
+}
+
+bool SerialTxQueue::findRecord(uint8_t key, uint8_t length, uint16_t& dataIdx) const
+{
+    bool     isFound   = false;
+    bool     isHead    = true;
+    uint16_t idx       = m_readIdx;
+    uint16_t remaining = m_usedBytes;
+
+    while ((false == isFound) && (0U < remaining))
+    {
+        uint8_t  recordKey    = m_buffer[idx];
+        uint8_t  recordLength = m_buffer[advance(idx, 1U)];
+        uint16_t recordSize   = RECORD_HEADER_SIZE + recordLength;
+
+        /* A record in transmission must not be changed anymore. */
+        if (((false == isHead) || (0U == m_headSentBytes)) && (key == recordKey) && (length == recordLength))
+        {
+            dataIdx = advance(idx, RECORD_HEADER_SIZE);
+            isFound = true;
+        }
+        else
+        {
+            idx = advance(idx, recordSize);
+            remaining -= recordSize;
+            isHead = false;
+        }
+    }
+
+    return isFound;
+}
+
+bool SerialTxQueue::dropOldest()
+{
+    bool isDropped = false;
+
+    if (0U < m_usedBytes)
+    {
+        uint8_t  headLength = m_buffer[advance(m_readIdx, 1U)];
+        uint16_t headSize   = RECORD_HEADER_SIZE + headLength;
+
+        if (0U == m_headSentBytes)
+        {
+            m_readIdx = advance(m_readIdx, headSize);
+            m_usedBytes -= headSize;
+
+            ++m_statistics.droppedRecords;
+            m_statistics.droppedBytes += headLength;
+            isDropped = true;
+        }
+        else if (headSize < m_usedBytes)
+        {
+            /* The oldest record is in transmission and must be completed, otherwise
+             * the receiver gets a corrupt frame. Drop the next one instead by moving
+             * the oldest record over it.
+             */
+            uint16_t nextIdx    = advance(m_readIdx, headSize);
+            uint8_t  nextLength = m_buffer[advance(nextIdx, 1U)];
+            uint16_t nextSize   = RECORD_HEADER_SIZE + nextLength;
+            uint16_t offset     = headSize;
+
+            while (0U < offset)
+            {
+                --offset;
+                m_buffer[advance(m_readIdx, nextSize + offset)] = m_buffer[advance(m_readIdx, offset)];
+            }
+
+            m_readIdx = advance(m_readIdx, nextSize);
+            m_usedBytes -= nextSize;
+
+            ++m_statistics.droppedRecords;
+            m_statistics.droppedBytes += nextLength;
+            isDropped = true;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return isDropped;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
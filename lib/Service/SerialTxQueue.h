@@ -0,0 +1,490 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Bounded non-blocking serial transmit queue
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef SERIAL_TX_QUEUE_H
+#define SERIAL_TX_QUEUE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef SERIAL_TX_QUEUE_SIZE
+/** Size of the transmit queue buffer in byte, including the record headers. */
+#define SERIAL_TX_QUEUE_SIZE (128U)
+#endif /* SERIAL_TX_QUEUE_SIZE */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Arduino.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Bounded transmit queue between the application and the serial driver.
+ *
+ * Every write to the queue is stored as one record. The records are sent
+ * by process() only as far as the serial driver accepts them without
+ * blocking, limited by a byte budget per call. If the queue is full, the
+ * configured overflow policy decides which data is lost.
+ *
+ * The coalesce policy expects frame oriented writes, where the first byte
+ * identifies the channel, like the SerialMuxProt frames do. A pending frame
+ * of the same channel and size is replaced by the latest one.
+ *
+ * Reading is forwarded to the serial driver, so the queue can be used as
+ * stream for the SerialMuxProt server.
+ */
+class SerialTxQueue : public Stream
+{
+public:
+    /** Overflow policy, which is applied if a record doesn't fit into the queue. */
+    enum Policy
+    {
+        POLICY_DROP_NEWEST = 0, /**< The record to be queued is dropped. */
+        POLICY_DROP_OLDEST,     /**< The oldest pending records are dropped until the new one fits. */
+        POLICY_COALESCE         /**< A pending record of the same channel is replaced, otherwise drop oldest. */
+    };
+
+    /** Transmit queue statistics. */
+    struct Statistics
+    {
+        uint32_t sentBytes;        /**< Number of bytes handed over to the serial driver. */
+        uint32_t droppedRecords;   /**< Number of records lost by overflow. */
+        uint32_t droppedBytes;     /**< Number of payload bytes lost by overflow. */
+        uint32_t coalescedRecords; /**< Number of pending records, which were replaced by a newer one. */
+        uint16_t maxPendingBytes;  /**< Highest fill level of the queue in byte. */
+    };
+
+    /** Key of records, which shall never be coalesced. */
+    static const uint8_t KEY_NONE = 0xFFU;
+
+    /**
+     * Key of the SerialMuxProt control channel. Its frames, e.g. the subscription
+     * responses of different channels, have all the same size and must never be coalesced.
+     */
+    static const uint8_t KEY_CONTROL_CHANNEL = 0U;
+
+    /** Size of the queue buffer in byte. */
+    static const uint16_t BUFFER_SIZE = SERIAL_TX_QUEUE_SIZE;
+
+    /** Size of the record header (key and length) in byte. */
+    static const uint8_t RECORD_HEADER_SIZE = 2U;
+
+    /** Number of keys, which can be excluded from coalescing. */
+    static const uint8_t MAX_EXCLUDABLE_KEYS = 32U;
+
+    /**
+     * Constructs the transmit queue.
+     *
+     * @param[in] serial    Serial driver, which is used for sending and receiving.
+     * @param[in] policy    Overflow policy.
+     */
+    SerialTxQueue(Serial_& serial, Policy policy) :
+        Stream(),
+        m_serial(serial),
+        m_policy(policy),
+        m_readIdx(0U),
+        m_writeIdx(0U),
+        m_usedBytes(0U),
+        m_headSentBytes(0U),
+        m_nonCoalescableKeys(1UL << KEY_CONTROL_CHANNEL),
+        m_statistics(),
+        m_buffer()
+    {
+    }
+
+    /**
+     * Destroys the transmit queue.
+     */
+    ~SerialTxQueue()
+    {
+    }
+
+    /**
+     * Set overflow policy.
+     *
+     * @param[in] policy    Overflow policy.
+     */
+    void setPolicy(Policy policy)
+    {
+        m_policy = policy;
+    }
+
+    /**
+     * Get overflow policy.
+     *
+     * @return Overflow policy.
+     */
+    Policy getPolicy() const
+    {
+        return m_policy;
+    }
+
+    /**
+     * Enable or disable coalescing of records with the given key.
+     * Use it for channels, where every frame matters, e.g. a data stream.
+     * By default all keys except the control channel are coalesced by the coalesce policy.
+     *
+     * @param[in] key               Record key, lower than MAX_EXCLUDABLE_KEYS.
+     * @param[in] isCoalescable     If records may be coalesced, it shall be true otherwise false.
+     */
+    void setCoalescable(uint8_t key, bool isCoalescable);
+
+    /**
+     * Queue a record for transmission.
+     *
+     * @param[in] key       Record key, used by the coalesce policy. Use KEY_NONE to disable coalescing.
+     * @param[in] data      Record data.
+     * @param[in] length    Record data length in byte.
+     *
+     * @return If the record is queued or coalesced, it will return true otherwise false.
+     */
+    bool enqueue(uint8_t key, const uint8_t* data, size_t length);
+
+    /**
+     * Send pending data to the serial driver, without blocking.
+     * Call it once per loop.
+     *
+     * @param[in] budget    Maximum number of bytes to send in this call.
+     *
+     * @return Number of bytes handed over to the serial driver.
+     */
+    size_t process(size_t budget);
+
+    /**
+     * Discard all pending records.
+     * A partially sent record is discarded too, which corrupts it on the receiver side.
+     */
+    void clear();
+
+    /**
+     * Get number of pending bytes, including the record headers.
+     *
+     * @return Number of pending bytes.
+     */
+    uint16_t getPendingBytes() const
+    {
+        return m_usedBytes;
+    }
+
+    /**
+     * Get transmit queue statistics.
+     *
+     * @return Statistics
+     */
+    const Statistics& getStatistics() const
+    {
+        return m_statistics;
+    }
+
+    /**
+     * Clear transmit queue statistics.
+     */
+    void clearStatistics();
+
+    /**
+     * Queue the data as one record. The first byte is used as key.
+     *
+     * @param[in] buffer    Data to send.
+     * @param[in] length    Data length in byte.
+     *
+     * @return Number of bytes queued. On overflow 0 is returned.
+     */
+    size_t write(const uint8_t* buffer, size_t length) final;
+
+#ifdef TARGET_NATIVE
+
+    /**
+     * Print argument.
+     *
+     * @param[in] str Argument to print.
+     */
+    void print(const char str[]) final;
+
+    /**
+     * Print argument.
+     *
+     * @param[in] value Argument to print.
+     */
+    void print(uint8_t value) final;
+
+    /**
+     * Print argument.
+     *
+     * @param[in] value Argument to print.
+     */
+    void print(uint16_t value) final;
+
+    /**
+     * Print argument.
+     *
+     * @param[in] value Argument to print.
+     */
+    void print(uint32_t value) final;
+
+    /**
+     * Print argument.
+     *
+     * @param[in] value Argument to print.
+     */
+    void print(int8_t value) final;
+
+    /**
+     * Print argument.
+     *
+     * @param[in] value Argument to print.
+     */
+    void print(int16_t value) final;
+
+    /**
+     * Print argument.
+     *
+     * @param[in] value Argument to print.
+     */
+    void print(int32_t value) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] str Argument to print.
+     */
+    void println(const char str[]) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] value Argument to print.
+     */
+    void println(uint8_t value) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] value Argument to print.
+     */
+    void println(uint16_t value) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] value Argument to print.
+     */
+    void println(uint32_t value) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] value Argument to print.
+     */
+    void println(int8_t value) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] value Argument to print.
+     */
+    void println(int16_t value) final;
+
+    /**
+     * Print argument and a line feed.
+     *
+     * @param[in] value Argument to print.
+     */
+    void println(int32_t value) final;
+
+    /**
+     * Get number of bytes, which can be read from the serial driver.
+     *
+     * @return Number of available bytes.
+     */
+    int available() const final;
+
+    /**
+     * Read bytes from the serial driver.
+     *
+     * @param[in] buffer Destination buffer.
+     * @param[in] length Number of bytes to read.
+     *
+     * @return Number of bytes read.
+     */
+    size_t readBytes(uint8_t* buffer, size_t length) final;
+
+#else /* TARGET_NATIVE */
+
+    /* Make the Print::write() overloads visible. */
+    using Print::write;
+
+    /**
+     * Queue a single byte as one record.
+     *
+     * @param[in] value Byte to send.
+     *
+     * @return Number of bytes queued. On overflow 0 is returned.
+     */
+    size_t write(uint8_t value) final;
+
+    /**
+     * Get number of bytes, which can be queued.
+     *
+     * @return Number of free bytes, regarding the record header.
+     */
+    int availableForWrite() final;
+
+    /**
+     * Get number of bytes, which can be read from the serial driver.
+     *
+     * @return Number of available bytes.
+     */
+    int available() final;
+
+    /**
+     * Read one byte from the serial driver.
+     *
+     * @return Byte or -1 if no data is available.
+     */
+    int read() final;
+
+    /**
+     * Peek one byte from the serial driver.
+     *
+     * @return Byte or -1 if no data is available.
+     */
+    int peek() final;
+
+    /**
+     * Flushing would block until all data is sent, therefore it does nothing.
+     * Pending data is sent by process().
+     */
+    void flush() final;
+
+#endif /* TARGET_NATIVE */
+
+private:
+    Serial_&   m_serial;              /**< Serial driver. */
+    Policy     m_policy;              /**< Overflow policy. */
+    uint16_t   m_readIdx;             /**< Buffer index of the oldest record header. */
+    uint16_t   m_writeIdx;            /**< Buffer index, where the next record will be written. */
+    uint16_t   m_usedBytes;           /**< Number of used bytes in the buffer. */
+    uint8_t    m_headSentBytes;       /**< Number of already sent data bytes of the oldest record. */
+    uint32_t   m_nonCoalescableKeys;  /**< Bitfield of the keys, which are excluded from coalescing. */
+    Statistics m_statistics;          /**< Statistics */
+    uint8_t    m_buffer[BUFFER_SIZE]; /**< Ring buffer with the records. */
+
+    /**
+     * Get buffer index, which is the given number of bytes behind the index.
+     *
+     * @param[in] idx       Buffer index.
+     * @param[in] offset    Offset in byte.
+     *
+     * @return Buffer index
+     */
+    uint16_t advance(uint16_t idx, uint16_t offset) const
+    {
+        return (idx + offset) % BUFFER_SIZE;
+    }
+
+    /**
+     * Is the record with the given key coalescable?
+     *
+     * @param[in] key   Record key.
+     *
+     * @return If coalescable, it will return true otherwise false.
+     */
+    bool isCoalescable(uint8_t key) const
+    {
+        bool isCoalescable = false;
+
+        if (KEY_NONE == key)
+        {
+            isCoalescable = false;
+        }
+        else if (MAX_EXCLUDABLE_KEYS > key)
+        {
+            isCoalescable = (0U == (m_nonCoalescableKeys & (1UL << key)));
+        }
+        else
+        {
+            isCoalescable = true;
+        }
+
+        return isCoalescable;
+    }
+
+    /**
+     * Copy data into the ring buffer, considering the wrap-around.
+     *
+     * @param[in] idx       Destination buffer index.
+     * @param[in] data      Data to copy.
+     * @param[in] length    Data length in byte.
+     */
+    void copyToBuffer(uint16_t idx, const uint8_t* data, uint16_t length);
+
+    /**
+     * Find a pending record with the given key and length, which is not in transmission.
+     *
+     * @param[in]  key      Record key.
+     * @param[in]  length   Record data length in byte.
+     * @param[out] dataIdx  Buffer index of the record data.
+     *
+     * @return If found, it will return true otherwise false.
+     */
+    bool findRecord(uint8_t key, uint8_t length, uint16_t& dataIdx) const;
+
+    /**
+     * Drop the oldest record, which is not in transmission.
+     *
+     * @return If a record was dropped, it will return true otherwise false.
+     */
+    bool dropOldest();
+
+    /* Not allowed. */
+    SerialTxQueue();                                      /**< Default construction of an instance. */
+    SerialTxQueue(const SerialTxQueue& queue);            /**< Copy construction of an instance. */
+    SerialTxQueue& operator=(const SerialTxQueue& queue); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIAL_TX_QUEUE_H */
+/** @} */
@@ -73,6 +73,23 @@ void SimpleTimer::restart()
     m_isRunning      = true;
 }
 
+void SimpleTimer::advance()
+{
+    uint32_t elapsedTime = getCurrentDuration();
+
+    if ((m_duration > elapsedTime) || ((2U * m_duration) <= elapsedTime))
+    {
+        m_startTimestamp = millis();
+    }
+    else
+    {
+        m_startTimestamp += m_duration;
+    }
+
+    m_isTimeout = false;
+    m_isRunning = true;
+}
+
 void SimpleTimer::stop()
 {
     m_isTimeout = false;
@@ -111,6 +128,28 @@ uint32_t SimpleTimer::getCurrentDuration() const
     return millis() - m_startTimestamp;
 }
 
+void SimpleTimer::save(Snapshot& snapshot) const
+{
+    (void)snapshot.put(m_isRunning);
+    (void)snapshot.put(m_isTimeout);
+    (void)snapshot.put(m_duration);
+    (void)snapshot.put(getCurrentDuration());
+}
+
+void SimpleTimer::restore(Snapshot& snapshot)
+{
+    uint32_t elapsedTime = 0U;
+
+    (void)snapshot.get(m_isRunning);
+    (void)snapshot.get(m_isTimeout);
+    (void)snapshot.get(m_duration);
+
+    if (true == snapshot.get(elapsedTime))
+    {
+        m_startTimestamp = millis() - elapsedTime;
+    }
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include <Arduino.h>
+#include <Snapshot.h>
 
 /******************************************************************************
  * Macros
@@ -115,6 +116,17 @@ public:
      */
     void restart();
 
+    /**
+     * Restart timer phase-locked after a timeout. The next period starts when
+     * the previous one was due, not when its timeout was noticed. This way a
+     * periodic task keeps a fixed phase and does not drift by the latency of
+     * the timeout polling.
+     *
+     * If the timer is not yet timed out or more than one period was missed,
+     * it will be restarted like restart() to avoid a burst of catch-up timeouts.
+     */
+    void advance();
+
     /**
      * Stop timer.
      */
@@ -141,6 +153,22 @@ public:
      */
     uint32_t getCurrentDuration() const;
 
+    /**
+     * Save the timer state to a snapshot.
+     * The elapsed time is stored instead of the start timestamp, which keeps
+     * the timer consistent if the clock is not restored.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the timer state from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
 protected:
 private:
     bool     m_isRunning;      /**< Is timer running (true) or not (false). */
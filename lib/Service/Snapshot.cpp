@@ -0,0 +1,133 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  State snapshot
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Snapshot.h"
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void Snapshot::clear()
+{
+    m_size    = 0U;
+    m_readIdx = 0U;
+    m_isValid = true;
+}
+
+void Snapshot::rewind()
+{
+    m_readIdx = 0U;
+}
+
+bool Snapshot::write(const void* data, size_t size)
+{
+    bool isSuccessful = false;
+
+    if ((true == m_isValid) && (nullptr != data) && ((MAX_SIZE - m_size) >= size))
+    {
+        memcpy(&m_data[m_size], data, size);
+        m_size += size;
+
+        isSuccessful = true;
+    }
+    else
+    {
+        m_isValid = false;
+    }
+
+    return isSuccessful;
+}
+
+bool Snapshot::read(void* data, size_t size)
+{
+    bool isSuccessful = false;
+
+    if ((true == m_isValid) && (nullptr != data) && ((m_size - m_readIdx) >= size))
+    {
+        memcpy(data, &m_data[m_readIdx], size);
+        m_readIdx += size;
+
+        isSuccessful = true;
+    }
+    else
+    {
+        m_isValid = false;
+    }
+
+    return isSuccessful;
+}
+
+bool Snapshot::load(const uint8_t* data, size_t size)
+{
+    clear();
+
+    return write(data, size);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
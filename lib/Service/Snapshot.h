@@ -0,0 +1,212 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  State snapshot
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A snapshot holds the serialized mutable state of the application and its
+ * services. It is used in the simulation to checkpoint a run and to fork
+ * variants from the same instant, e.g. with different PID parameters.
+ *
+ * Every component writes its state in save() and reads it back in the same
+ * order in restore(). References, like the current state of a state machine,
+ * are stored as index. Therefore a snapshot can be written to a file and be
+ * loaded by another process of the same application.
+ */
+class Snapshot
+{
+public:
+    /** Max. size of a snapshot in byte. */
+    static const size_t MAX_SIZE = 1024U;
+
+    /**
+     * Constructs a empty snapshot.
+     */
+    Snapshot() : m_data(), m_size(0U), m_readIdx(0U), m_isValid(true)
+    {
+    }
+
+    /**
+     * Destroys the snapshot.
+     */
+    ~Snapshot()
+    {
+    }
+
+    /**
+     * Clear the snapshot to write a new one.
+     */
+    void clear();
+
+    /**
+     * Rewind to read the snapshot from its begin.
+     */
+    void rewind();
+
+    /**
+     * Write raw data to the snapshot.
+     *
+     * @param[in] data  Data
+     * @param[in] size  Data size in byte
+     *
+     * @return If successful written, it will return true otherwise false.
+     */
+    bool write(const void* data, size_t size);
+
+    /**
+     * Read raw data from the snapshot.
+     *
+     * @param[out] data Data buffer
+     * @param[in]  size Data size in byte
+     *
+     * @return If successful read, it will return true otherwise false.
+     */
+    bool read(void* data, size_t size);
+
+    /**
+     * Write a value to the snapshot.
+     *
+     * @tparam T Value type, which must be trivially copyable.
+     *
+     * @param[in] value Value
+     *
+     * @return If successful written, it will return true otherwise false.
+     */
+    template<typename T>
+    bool put(const T& value)
+    {
+        return write(&value, sizeof(value));
+    }
+
+    /**
+     * Read a value from the snapshot.
+     *
+     * @tparam T Value type, which must be trivially copyable.
+     *
+     * @param[out] value Value
+     *
+     * @return If successful read, it will return true otherwise false.
+     */
+    template<typename T>
+    bool get(T& value)
+    {
+        return read(&value, sizeof(value));
+    }
+
+    /**
+     * Load a snapshot from external data, e.g. from a file.
+     *
+     * @param[in] data  Snapshot data
+     * @param[in] size  Snapshot size in byte
+     *
+     * @return If successful loaded, it will return true otherwise false.
+     */
+    bool load(const uint8_t* data, size_t size);
+
+    /**
+     * Get the snapshot data, e.g. to store it in a file.
+     *
+     * @return Snapshot data
+     */
+    const uint8_t* getData() const
+    {
+        return m_data;
+    }
+
+    /**
+     * Get the snapshot size in byte.
+     *
+     * @return Snapshot size in byte
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Get the number of bytes, which are not read yet. After a complete
+     * restore it is 0, otherwise the snapshot doesn't fit to the reader.
+     *
+     * @return Number of unread bytes
+     */
+    size_t getUnreadSize() const
+    {
+        return m_size - m_readIdx;
+    }
+
+    /**
+     * Is the snapshot valid?
+     * A snapshot becomes invalid, if a write exceeds the capacity or a read
+     * exceeds the written data.
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    bool isValid() const
+    {
+        return m_isValid;
+    }
+
+private:
+    uint8_t m_data[MAX_SIZE]; /**< Serialized state */
+    size_t  m_size;           /**< Number of written bytes */
+    size_t  m_readIdx;        /**< Read index */
+    bool    m_isValid;        /**< Is snapshot valid? */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SNAPSHOT_H */
+/** @} */
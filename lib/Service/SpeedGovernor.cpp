@@ -0,0 +1,293 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Platoon aware speed governor
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SpeedGovernor.h"
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool SpeedGovernor::reportFollower(uint8_t followerId, int16_t gap, uint8_t health)
+{
+    Follower* follower = nullptr;
+    uint8_t   idx      = 0U;
+
+    expireFollowers();
+
+    /* Known follower? */
+    while ((MAX_FOLLOWERS > idx) && (nullptr == follower))
+    {
+        if ((true == m_followers[idx].isActive) && (followerId == m_followers[idx].id))
+        {
+            follower = &m_followers[idx];
+        }
+
+        ++idx;
+    }
+
+    /* New follower? */
+    idx = 0U;
+    while ((MAX_FOLLOWERS > idx) && (nullptr == follower))
+    {
+        if (false == m_followers[idx].isActive)
+        {
+            follower           = &m_followers[idx];
+            follower->isActive = true;
+            follower->id       = followerId;
+            m_isPlatoonChanged = true;
+        }
+
+        ++idx;
+    }
+
+    if (nullptr != follower)
+    {
+        follower->gap       = gap;
+        follower->health    = health;
+        follower->timestamp = millis();
+    }
+
+    return (nullptr != follower);
+}
+
+void SpeedGovernor::resync(int16_t speed)
+{
+    m_speedLimit         = speed;
+    m_lastLimitTimestamp = millis();
+}
+
+int16_t SpeedGovernor::limitSpeed(int16_t topSpeed)
+{
+    uint32_t timestamp   = millis();
+    uint32_t duration    = timestamp - m_lastLimitTimestamp; /* [ms] */
+    int32_t  targetSpeed = topSpeed;                         /* [steps/s] */
+    int32_t  maxIncrease = (static_cast<int32_t>(MAX_ACCELERATION) * duration) / 1000; /* [steps/s] */
+    int32_t  maxDecrease = (static_cast<int32_t>(MAX_DECELERATION) * duration) / 1000; /* [steps/s] */
+    uint8_t  idx         = 0U;
+
+    expireFollowers();
+
+    /* The followers shall keep up: Reduce the speed linear between the nominal
+     * and the max. gap and consider the health of the weakest follower.
+     */
+    for (idx = 0U; idx < MAX_FOLLOWERS; ++idx)
+    {
+        const Follower& follower = m_followers[idx];
+
+        if (true == follower.isActive)
+        {
+            int32_t gap         = follower.gap;    /* [mm] */
+            int32_t health      = follower.health; /* [%] */
+            int32_t followSpeed = 0;               /* [steps/s] */
+
+            if (GAP_NOMINAL > gap)
+            {
+                gap = GAP_NOMINAL;
+            }
+            else if (GAP_MAX < gap)
+            {
+                gap = GAP_MAX;
+            }
+            else
+            {
+                ;
+            }
+
+            if (HEALTH_FULL < health)
+            {
+                health = HEALTH_FULL;
+            }
+
+            followSpeed = (static_cast<int32_t>(topSpeed) * (GAP_MAX - gap)) / (GAP_MAX - GAP_NOMINAL);
+            followSpeed = (followSpeed * health) / HEALTH_FULL;
+
+            if (targetSpeed > followSpeed)
+            {
+                targetSpeed = followSpeed;
+            }
+        }
+    }
+
+    /* Avoid abrupt speed changes, which the followers can't follow. */
+    targetSpeed = constrain(targetSpeed, m_speedLimit - maxDecrease, m_speedLimit + maxIncrease);
+
+    /* Note, a reduced top speed shall be applied immediately. */
+    if (topSpeed < targetSpeed)
+    {
+        targetSpeed = topSpeed;
+    }
+
+    /* If the duration is too short for a change, wait for the next call. */
+    if ((0 < maxIncrease) || (0 < maxDecrease))
+    {
+        m_lastLimitTimestamp = timestamp;
+    }
+
+    m_speedLimit = static_cast<int16_t>(targetSpeed);
+
+    return m_speedLimit;
+}
+
+int16_t SpeedGovernor::getWorstGap() const
+{
+    int16_t worstGap = 0;
+    uint8_t idx      = 0U;
+
+    for (idx = 0U; idx < MAX_FOLLOWERS; ++idx)
+    {
+        if ((true == m_followers[idx].isActive) && (worstGap < m_followers[idx].gap))
+        {
+            worstGap = m_followers[idx].gap;
+        }
+    }
+
+    return worstGap;
+}
+
+int32_t SpeedGovernor::getPlatoonLength() const
+{
+    int32_t length = 0;
+    uint8_t idx    = 0U;
+
+    for (idx = 0U; idx < MAX_FOLLOWERS; ++idx)
+    {
+        if (true == m_followers[idx].isActive)
+        {
+            length += m_followers[idx].gap;
+        }
+    }
+
+    return length;
+}
+
+uint8_t SpeedGovernor::getNumFollowers() const
+{
+    uint8_t count = 0U;
+    uint8_t idx   = 0U;
+
+    for (idx = 0U; idx < MAX_FOLLOWERS; ++idx)
+    {
+        if (true == m_followers[idx].isActive)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+uint16_t SpeedGovernor::calculateThroughput(uint32_t mileage)
+{
+    uint32_t timestamp    = millis();
+    uint32_t duration     = timestamp - m_lastThroughputTimestamp; /* [ms] */
+    int32_t  tailDistance = 0;                                      /* [mm] */
+    int32_t  throughput   = 0;                                      /* [mm/s] */
+
+    expireFollowers();
+
+    /* The platoon tail is behind the leader by the whole platoon length. */
+    tailDistance = static_cast<int32_t>(mileage) - getPlatoonLength();
+
+    /* A joining or leaving follower moves the tail abruptly, which is no travelled distance. */
+    if (true == m_isPlatoonChanged)
+    {
+        m_isPlatoonChanged = false;
+    }
+    else if (0U < duration)
+    {
+        throughput       = ((tailDistance - m_lastTailDistance) * 1000) / static_cast<int32_t>(duration);
+        m_lastThroughput = static_cast<uint16_t>(constrain(throughput, 0, UINT16_MAX));
+    }
+    else
+    {
+        ;
+    }
+
+    m_lastTailDistance        = tailDistance;
+    m_lastThroughputTimestamp = timestamp;
+
+    return m_lastThroughput;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SpeedGovernor::expireFollowers()
+{
+    uint32_t timestamp = millis();
+    uint8_t  idx       = 0U;
+
+    for (idx = 0U; idx < MAX_FOLLOWERS; ++idx)
+    {
+        if ((true == m_followers[idx].isActive) && (REPORT_TIMEOUT < (timestamp - m_followers[idx].timestamp)))
+        {
+            m_followers[idx].isActive = false;
+            m_isPlatoonChanged        = true;
+        }
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
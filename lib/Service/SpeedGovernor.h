@@ -0,0 +1,230 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Platoon aware speed governor
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef SPEED_GOVERNOR_H
+#define SPEED_GOVERNOR_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The speed governor limits the leader speed, so that the followers are able
+ * to keep up. The followers report their gap to the predecessor and their
+ * health. The worst of them determines the speed limit, which changes only
+ * with limited acceleration and deceleration.
+ *
+ * Without any follower reports, the speed is not limited.
+ */
+class SpeedGovernor
+{
+public:
+    /** Max. number of followers, which are considered. */
+    static const uint8_t MAX_FOLLOWERS = 4U;
+
+    /** Duration in ms, after a follower without a new report is not considered anymore. */
+    static const uint32_t REPORT_TIMEOUT = 500U;
+
+    /** Gap in mm up to the speed is not limited. */
+    static const int16_t GAP_NOMINAL = 150;
+
+    /** Gap in mm, where the leader stops to wait for the followers. */
+    static const int16_t GAP_MAX = 450;
+
+    /** Max. increase of the speed limit in steps/s^2. */
+    static const int16_t MAX_ACCELERATION = 4000;
+
+    /** Max. decrease of the speed limit in steps/s^2. */
+    static const int16_t MAX_DECELERATION = 8000;
+
+    /** Follower health in %, which is considered as full health. */
+    static const uint8_t HEALTH_FULL = 100U;
+
+    /**
+     * Get speed governor instance.
+     *
+     * @return Speed governor instance.
+     */
+    static SpeedGovernor& getInstance()
+    {
+        static SpeedGovernor instance; /* idiom */
+
+        return instance;
+    }
+
+    /**
+     * Handle the report of a follower.
+     *
+     * @param[in] followerId    Unique id of the follower.
+     * @param[in] gap           Gap to the predecessor along the path [mm].
+     * @param[in] health        Follower health [%].
+     *
+     * @return If the report is considered, it will return true otherwise false.
+     */
+    bool reportFollower(uint8_t followerId, int16_t gap, uint8_t health);
+
+    /**
+     * Set the speed limit immediately, without rate limitation.
+     * Use it e.g. when starting to drive.
+     *
+     * @param[in] speed Speed limit [steps/s].
+     */
+    void resync(int16_t speed);
+
+    /**
+     * Limit the top speed, depended on the worst follower. The limit is
+     * changed with limited acceleration and deceleration since the last call.
+     *
+     * @param[in] topSpeed  Requested top speed [steps/s].
+     *
+     * @return Governed top speed [steps/s].
+     */
+    int16_t limitSpeed(int16_t topSpeed);
+
+    /**
+     * Get the current speed limit.
+     *
+     * @return Speed limit [steps/s].
+     */
+    int16_t getSpeedLimit() const
+    {
+        return m_speedLimit;
+    }
+
+    /**
+     * Get the largest gap of all followers, which reported in time.
+     *
+     * @return Gap [mm]. If no follower is available, it will return 0.
+     */
+    int16_t getWorstGap() const;
+
+    /**
+     * Get the length of the platoon behind the leader, which is the sum of the
+     * gaps of all followers, which reported in time. Every follower reports the
+     * gap to its predecessor, so the last one is behind the leader by all of them.
+     *
+     * @return Platoon length [mm]. If no follower is available, it will return 0.
+     */
+    int32_t getPlatoonLength() const;
+
+    /**
+     * Get the number of followers, which reported in time.
+     *
+     * @return Number of followers.
+     */
+    uint8_t getNumFollowers() const;
+
+    /**
+     * Calculate the throughput of the whole platoon since the last call.
+     * It is the distance per second, which the last member of the platoon travelled.
+     * If a follower joined or left the platoon since the last call, the tail
+     * moved abruptly. Then the last throughput is kept and the next call
+     * measures from here on.
+     *
+     * @param[in] mileage   Travelled distance of the leader [mm].
+     *
+     * @return Throughput [mm/s].
+     */
+    uint16_t calculateThroughput(uint32_t mileage);
+
+private:
+    /** A follower, which reported its state. */
+    struct Follower
+    {
+        bool     isActive;  /**< Is the follower reporting in time? */
+        uint8_t  id;        /**< Unique id of the follower. */
+        uint8_t  health;    /**< Follower health [%]. */
+        int16_t  gap;       /**< Gap to the predecessor [mm]. */
+        uint32_t timestamp; /**< Timestamp of the last report [ms]. */
+    };
+
+    Follower m_followers[MAX_FOLLOWERS]; /**< The followers of the leader. */
+    int16_t  m_speedLimit;               /**< Current speed limit [steps/s]. */
+    uint32_t m_lastLimitTimestamp;       /**< Timestamp of the last speed limitation [ms]. */
+    int32_t  m_lastTailDistance;         /**< Travelled distance of the platoon tail at the last calculation [mm]. */
+    uint32_t m_lastThroughputTimestamp;  /**< Timestamp of the last throughput calculation [ms]. */
+    uint16_t m_lastThroughput;           /**< Last calculated throughput [mm/s]. */
+    bool     m_isPlatoonChanged;         /**< Did a follower join or leave since the last throughput calculation? */
+
+    /**
+     * Constructs the speed governor.
+     */
+    SpeedGovernor() :
+        m_followers(),
+        m_speedLimit(0),
+        m_lastLimitTimestamp(0U),
+        m_lastTailDistance(0),
+        m_lastThroughputTimestamp(0U),
+        m_lastThroughput(0U),
+        m_isPlatoonChanged(true)
+    {
+    }
+
+    /**
+     * Destroys the speed governor.
+     */
+    ~SpeedGovernor()
+    {
+    }
+
+    /**
+     * Deactivate all followers, which didn't report in time.
+     */
+    void expireFollowers();
+
+    /* Not allowed. */
+    SpeedGovernor(const SpeedGovernor& governor);            /**< Copy construction of an instance. */
+    SpeedGovernor& operator=(const SpeedGovernor& governor); /**< Assignment of an instance. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SPEED_GOVERNOR_H */
+/** @} */
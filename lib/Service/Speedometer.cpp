@@ -64,13 +64,14 @@ Speedometer Speedometer::m_instance;
 
 void Speedometer::process()
 {
-    IMotors&      motors         = Board::getInstance().getMotors();
-    uint32_t      timestamp      = millis();                       /* [ms] */
-    int32_t       diffStepsLeft  = m_relEncoders.getCountsLeft();  /* [steps] */
-    int32_t       diffStepsRight = m_relEncoders.getCountsRight(); /* [steps] */
-    const int32_t ONE_SECOND     = 1000;                           /* 1s in ms */
-    bool          resetLeft      = false;
-    bool          resetRight     = false;
+    IMotors&            motors         = Board::getInstance().getMotors();
+    uint32_t            timestamp      = micros();                                            /* [us] */
+    Units::EncoderSteps diffStepsLeft  = Units::EncoderSteps(m_relEncoders.getCountsLeft());  /* [steps] */
+    Units::EncoderSteps diffStepsRight = Units::EncoderSteps(m_relEncoders.getCountsRight()); /* [steps] */
+    int32_t             dTimeLeft      = static_cast<int32_t>((timestamp - m_timestampLeft) / TIME_RESOLUTION);
+    int32_t             dTimeRight     = static_cast<int32_t>((timestamp - m_timestampRight) / TIME_RESOLUTION);
+    bool                resetLeft      = false;
+    bool                resetRight     = false;
 
     if (0 == motors.getLeftSpeed())
     {
@@ -121,11 +122,9 @@ void Speedometer::process()
         m_relEncoders.clearLeft();
     }
     /* Moved long enough to be able to calculate the linear speed? */
-    else if (MIN_ENCODER_COUNT <= abs(diffStepsLeft))
+    else if ((MIN_ENCODER_COUNT <= abs(diffStepsLeft.value())) && (0 < dTimeLeft))
     {
-        uint32_t dTimeLeft = timestamp - m_timestampLeft; /* [ms] */
-
-        m_linearSpeedLeft = diffStepsLeft * ONE_SECOND / static_cast<int32_t>(dTimeLeft);
+        m_linearSpeedLeft = calculateLinearSpeed(diffStepsLeft, dTimeLeft);
         m_timestampLeft   = timestamp;
 
         m_relEncoders.clearLeft();
@@ -143,11 +142,9 @@ void Speedometer::process()
         m_relEncoders.clearRight();
     }
     /* Moved long enough to be able to calculate the linear speed? */
-    else if (MIN_ENCODER_COUNT <= abs(diffStepsRight))
+    else if ((MIN_ENCODER_COUNT <= abs(diffStepsRight.value())) && (0 < dTimeRight))
     {
-        uint32_t dTimeRight = timestamp - m_timestampRight; /* [ms] */
-
-        m_linearSpeedRight = diffStepsRight * ONE_SECOND / static_cast<int32_t>(dTimeRight);
+        m_linearSpeedRight = calculateLinearSpeed(diffStepsRight, dTimeRight);
         m_timestampRight   = timestamp;
 
         m_relEncoders.clearRight();
@@ -156,25 +153,63 @@ void Speedometer::process()
     {
         ;
     }
-    }
+
+    publish();
+}
 
 int16_t Speedometer::getLinearSpeedCenter() const
 {
-    int32_t linearSpeedLeft   = static_cast<int32_t>(m_linearSpeedLeft);
-    int32_t linearSpeedRight  = static_cast<int32_t>(m_linearSpeedRight);
-    int32_t linearSpeedCenter = (linearSpeedLeft + linearSpeedRight) / 2;
+    LinearSpeeds       linearSpeeds = m_linearSpeeds.read();
+    Units::LinearSpeed linearSpeedLeft(linearSpeeds.left);   /* [steps/s] */
+    Units::LinearSpeed linearSpeedRight(linearSpeeds.right); /* [steps/s] */
 
-    return linearSpeedCenter;
+    return (linearSpeedLeft + linearSpeedRight).scale<1, 2>().value();
 }
 
 int16_t Speedometer::getLinearSpeedLeft() const
 {
-    return m_linearSpeedLeft;
+    return m_linearSpeeds.read().left;
 }
 
 int16_t Speedometer::getLinearSpeedRight() const
 {
-    return m_linearSpeedRight;
+    return m_linearSpeeds.read().right;
+}
+
+void Speedometer::save(Snapshot& snapshot) const
+{
+    uint32_t timestamp = micros(); /* [us] */
+
+    /* The measurement timestamps are stored relative to now. */
+    m_relEncoders.save(snapshot);
+    (void)snapshot.put(timestamp - m_timestampLeft);
+    (void)snapshot.put(timestamp - m_timestampRight);
+    (void)snapshot.put(m_linearSpeedLeft);
+    (void)snapshot.put(m_linearSpeedRight);
+    (void)snapshot.put(m_lastDirectionLeft);
+    (void)snapshot.put(m_lastDirectionRight);
+}
+
+void Speedometer::restore(Snapshot& snapshot)
+{
+    uint32_t timestamp    = micros(); /* [us] */
+    uint32_t elapsedLeft  = 0U;       /* [us] */
+    uint32_t elapsedRight = 0U;       /* [us] */
+
+    m_relEncoders.restore(snapshot);
+
+    if ((true == snapshot.get(elapsedLeft)) && (true == snapshot.get(elapsedRight)))
+    {
+        m_timestampLeft  = timestamp - elapsedLeft;
+        m_timestampRight = timestamp - elapsedRight;
+    }
+
+    (void)snapshot.get(m_linearSpeedLeft);
+    (void)snapshot.get(m_linearSpeedRight);
+    (void)snapshot.get(m_lastDirectionLeft);
+    (void)snapshot.get(m_lastDirectionRight);
+
+    publish();
 }
 
 /******************************************************************************
@@ -221,6 +256,25 @@ Speedometer::Direction Speedometer::getDirectionByMotorSpeed(int16_t motorSpeed)
     return direction;
 }
 
+int16_t Speedometer::calculateLinearSpeed(const Units::EncoderSteps& steps, int32_t dTime)
+{
+    /* steps * 1 s / dTime, where the product exceeds 16 bit. */
+    return steps.convert<Units::StepsPerSecond, ONE_SECOND, 1>()
+        .divide(dTime)
+        .clamp<INT16_MIN, INT16_MAX>()
+        .value(); /* [steps/s] */
+}
+
+void Speedometer::publish()
+{
+    LinearSpeeds linearSpeeds;
+
+    linearSpeeds.left  = m_linearSpeedLeft;
+    linearSpeeds.right = m_linearSpeedRight;
+
+    m_linearSpeeds.write(linearSpeeds);
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -47,6 +47,9 @@
 #include <Board.h>
 #include <RelativeEncoders.h>
 #include <RobotConstants.h>
+#include <Snapshot.h>
+#include <SeqLock.hpp>
+#include <Units.hpp>
 
 /******************************************************************************
  * Macros
@@ -56,7 +59,10 @@
  * Types and Classes
  *****************************************************************************/
 
-/** This class provides the linear speed in [steps/s], based on the encoder informations. */
+/**
+ * This class provides the linear speed in [steps/s], based on the encoder informations.
+ * The speed may be processed in an interrupt, the getters read it consistently.
+ */
 class Speedometer
 {
 public:
@@ -97,6 +103,20 @@ public:
      */
     int16_t getLinearSpeedRight() const;
 
+    /**
+     * Save the speedometer state to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the speedometer state from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
 private:
     /**
      * Direction of movement.
@@ -114,16 +134,32 @@ private:
      */
     static const int16_t MIN_ENCODER_COUNT = RobotConstants::ENCODER_RESOLUTION / 2;
 
+    /**
+     * Duration in us, which is the resolution of the speed calculation.
+     * It avoids an overflow in the calculation.
+     */
+    static const uint32_t TIME_RESOLUTION = 100U;
+
+    /** One second in TIME_RESOLUTION. */
+    static const int32_t ONE_SECOND = static_cast<int32_t>(1000000U / TIME_RESOLUTION);
+
+    /** Linear speed left and right. */
+    struct LinearSpeeds
+    {
+        int16_t left;  /**< Linear speed left in steps/s */
+        int16_t right; /**< Linear speed right in steps/s */
+    };
+
     /** Speedometer instance */
     static Speedometer m_instance;
 
     /** Relative encoder left/right */
     RelativeEncoders m_relEncoders;
 
-    /** Timestamp of last left speed calculation. */
+    /** Timestamp in us of last left speed calculation. */
     uint32_t m_timestampLeft;
 
-    /** Timestamp of last right speed calculation. */
+    /** Timestamp in us of last right speed calculation. */
     uint32_t m_timestampRight;
 
     /** Linear speed left in steps/s */
@@ -138,6 +174,9 @@ private:
     /** Last determined driving direction left. */
     Direction m_lastDirectionRight;
 
+    /** Linear speeds for the getters, which may run in another context than process(). */
+    SeqLock<LinearSpeeds> m_linearSpeeds;
+
     /**
      * Construct the mileage instance.
      */
@@ -148,7 +187,8 @@ private:
         m_linearSpeedLeft(0),
         m_linearSpeedRight(0),
         m_lastDirectionLeft(DIRECTION_STOPPED),
-        m_lastDirectionRight(DIRECTION_STOPPED)
+        m_lastDirectionRight(DIRECTION_STOPPED),
+        m_linearSpeeds()
     {
     }
 
@@ -185,6 +225,22 @@ private:
      * @return Direction of movement.
      */
     Direction getDirectionByMotorSpeed(int16_t motorSpeed);
+
+    /**
+     * Calculate the linear speed from the driven encoder steps.
+     * The linear speed saturates, if it exceeds the 16 bit range.
+     *
+     * @param[in] steps Driven encoder steps
+     * @param[in] dTime Duration in TIME_RESOLUTION, shall be positive.
+     *
+     * @return Linear speed in steps/s
+     */
+    static int16_t calculateLinearSpeed(const Units::EncoderSteps& steps, int32_t dTime);
+
+    /**
+     * Publish the linear speeds for the getters.
+     */
+    void publish();
 };
 
 /******************************************************************************
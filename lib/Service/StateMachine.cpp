@@ -83,6 +83,33 @@ void StateMachine::process()
     }
 }
 
+void StateMachine::save(Snapshot& snapshot, IState* const states[], uint8_t numStates) const
+{
+    (void)snapshot.put(getStateIdx(m_currentState, states, numStates));
+    (void)snapshot.put(getStateIdx(m_nextState, states, numStates));
+}
+
+bool StateMachine::restore(Snapshot& snapshot, IState* const states[], uint8_t numStates)
+{
+    bool    isRestored      = false;
+    uint8_t currentStateIdx = STATE_IDX_NONE;
+    uint8_t nextStateIdx    = STATE_IDX_NONE;
+    IState* currentState    = nullptr;
+    IState* nextState       = nullptr;
+
+    /* Keep the states untouched on a invalid snapshot or unknown states. */
+    if ((true == snapshot.get(currentStateIdx)) && (true == snapshot.get(nextStateIdx)) &&
+        (true == getState(currentStateIdx, states, numStates, currentState)) &&
+        (true == getState(nextStateIdx, states, numStates, nextState)))
+    {
+        m_currentState = currentState;
+        m_nextState    = nextState;
+        isRestored     = true;
+    }
+
+    return isRestored;
+}
+
 /******************************************************************************
  * Protected Methods
  *****************************************************************************/
@@ -91,6 +118,52 @@ void StateMachine::process()
  * Private Methods
  *****************************************************************************/
 
+uint8_t StateMachine::getStateIdx(const IState* state, IState* const states[], uint8_t numStates)
+{
+    uint8_t stateIdx = STATE_IDX_NONE;
+
+    if (nullptr != state)
+    {
+        uint8_t idx = 0U;
+
+        stateIdx = STATE_IDX_UNKNOWN;
+
+        while ((STATE_IDX_UNKNOWN == stateIdx) && (numStates > idx))
+        {
+            if (state == states[idx])
+            {
+                stateIdx = idx;
+            }
+
+            ++idx;
+        }
+    }
+
+    return stateIdx;
+}
+
+bool StateMachine::getState(uint8_t stateIdx, IState* const states[], uint8_t numStates, IState*& state)
+{
+    bool isValid = false;
+
+    if (STATE_IDX_NONE == stateIdx)
+    {
+        state   = nullptr;
+        isValid = true;
+    }
+    else if (numStates > stateIdx)
+    {
+        state   = states[stateIdx];
+        isValid = true;
+    }
+    else
+    {
+        ;
+    }
+
+    return isValid;
+}
+
 /******************************************************************************
  * External Functions
  *****************************************************************************/
@@ -44,6 +44,7 @@
  * Includes
  *****************************************************************************/
 #include "IState.h"
+#include "Snapshot.h"
 
 /******************************************************************************
  * Macros
@@ -96,14 +97,67 @@ public:
      */
     void process();
 
+    /**
+     * Save the current and next state to a snapshot.
+     * The states are saved as index in the state table, which keeps the
+     * snapshot valid in another process of the same application.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] states    Table of all states of the application
+     * @param[in] numStates Number of states in the table
+     */
+    void save(Snapshot& snapshot, IState* const states[], uint8_t numStates) const;
+
+    /**
+     * Restore the current and next state from a snapshot.
+     * The entry and exit of the states are not called, because their own
+     * members are restored separately.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] states    Table of all states of the application, same as used by save().
+     * @param[in] numStates Number of states in the table
+     *
+     * @return If the states are restored, it will return true otherwise false.
+     */
+    bool restore(Snapshot& snapshot, IState* const states[], uint8_t numStates);
+
 protected:
 private:
+    /** Index of no state in a snapshot. */
+    static const uint8_t STATE_IDX_NONE = 0xFFU;
+
+    /** Index of a state in a snapshot, which is not part of the state table. */
+    static const uint8_t STATE_IDX_UNKNOWN = 0xFEU;
+
     IState* m_currentState; /**< Current active state */
     IState* m_nextState;    /**< Next state */
 
     /* Not allowed. */
     StateMachine(const StateMachine& sm);            /**< Copy construction of an instance. */
     StateMachine& operator=(const StateMachine& sm); /**< Assignment of an instance. */
+
+    /**
+     * Get the index of a state in the state table.
+     *
+     * @param[in] state     State or nullptr
+     * @param[in] states    Table of all states
+     * @param[in] numStates Number of states in the table
+     *
+     * @return State index, STATE_IDX_NONE for nullptr or STATE_IDX_UNKNOWN if not found.
+     */
+    static uint8_t getStateIdx(const IState* state, IState* const states[], uint8_t numStates);
+
+    /**
+     * Get the state by its index in the state table.
+     *
+     * @param[in]  stateIdx  State index
+     * @param[in]  states    Table of all states
+     * @param[in]  numStates Number of states in the table
+     * @param[out] state     State or nullptr
+     *
+     * @return If the index is valid, it will return true otherwise false.
+     */
+    static bool getState(uint8_t stateIdx, IState* const states[], uint8_t numStates, IState*& state);
 };
 
 /******************************************************************************
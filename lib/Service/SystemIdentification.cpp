@@ -0,0 +1,371 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System identification by open-loop motor excitation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SystemIdentification.h"
+#include <Arduino.h>
+#include <Board.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int16_t scaledSine(uint16_t phase, int16_t amplitude);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SystemIdentification::SystemIdentification() :
+    m_config(),
+    m_isRunning(false),
+    m_startTimestamp(0U),
+    m_sampleIdx(0U),
+    m_lastCountsLeft(0),
+    m_lastCountsRight(0),
+    m_prbsRegister(PRBS_SEED),
+    m_chirpPhase(0U),
+    m_chirpPhaseFraction(0U),
+    m_samples()
+{
+    getDefaultConfig(m_config, EXCITATION_STEP);
+}
+
+void SystemIdentification::getDefaultConfig(Config& config, Excitation excitation)
+{
+    int16_t maxSpeed = Board::getInstance().getMotors().getMaxSpeed();
+
+    config.excitation     = excitation;
+    config.mode           = MODE_LINEAR;
+    config.samplePeriod   = 2U * DEFAULT_SAMPLE_PERIOD;
+    config.numSamples     = MAX_SAMPLES;
+    config.stepDelay      = MAX_SAMPLES / 5U;
+    config.prbsHold       = 3U;
+    config.chirpFreqStart = 500U;   /* 0.5 Hz */
+    config.chirpFreqEnd   = 10000U; /* 10 Hz */
+
+    if (EXCITATION_STEP == excitation)
+    {
+        /* Step from standstill to half speed. */
+        config.offset    = 0;
+        config.amplitude = maxSpeed / 2;
+    }
+    else
+    {
+        /* Keep the motors turning around 40% speed, so the static friction
+         * doesn't dominate the response.
+         */
+        config.offset    = (maxSpeed * 2) / 5;
+        config.amplitude = maxSpeed / 8;
+    }
+}
+
+bool SystemIdentification::start(const Config& config)
+{
+    bool isSuccessful = false;
+
+    if ((false == m_isRunning) && (true == isValid(config)))
+    {
+        IEncoders& encoders = Board::getInstance().getEncoders();
+
+        m_config             = config;
+        m_sampleIdx          = 0U;
+        m_prbsRegister       = PRBS_SEED;
+        m_chirpPhase         = 0U;
+        m_chirpPhaseFraction = 0U;
+        m_lastCountsLeft     = encoders.getCountsLeft();
+        m_lastCountsRight    = encoders.getCountsRight();
+        m_startTimestamp     = millis();
+        m_isRunning          = true;
+
+        applySample(0U);
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool SystemIdentification::process()
+{
+    if (true == m_isRunning)
+    {
+        uint32_t elapsed = millis() - m_startTimestamp;
+        uint32_t nextDue = static_cast<uint32_t>(m_sampleIdx + 1U) * m_config.samplePeriod;
+
+        /* The sample points are derived from the start timestamp, so a late
+         * call doesn't shift all following samples.
+         */
+        if (nextDue <= elapsed)
+        {
+            captureSample();
+            ++m_sampleIdx;
+
+            if (m_config.numSamples <= m_sampleIdx)
+            {
+                Board::getInstance().getMotors().setSpeeds(0, 0);
+                m_isRunning = false;
+            }
+            else
+            {
+                applySample(static_cast<uint16_t>(elapsed));
+            }
+        }
+    }
+
+    return m_isRunning;
+}
+
+void SystemIdentification::abort()
+{
+    if (true == m_isRunning)
+    {
+        Board::getInstance().getMotors().setSpeeds(0, 0);
+        m_isRunning = false;
+    }
+}
+
+uint16_t SystemIdentification::getNumSamples() const
+{
+    /* The sample, which PWM is currently applied, is not complete yet. */
+    return m_sampleIdx;
+}
+
+bool SystemIdentification::getSample(uint16_t index, Sample& sample) const
+{
+    bool isAvailable = false;
+
+    if (getNumSamples() > index)
+    {
+        sample      = m_samples[index];
+        isAvailable = true;
+    }
+
+    return isAvailable;
+}
+
+bool SystemIdentification::isValid(const Config& config)
+{
+    bool isValid = true;
+
+    if ((EXCITATION_MAX <= config.excitation) || (MODE_MAX <= config.mode))
+    {
+        isValid = false;
+    }
+    else if ((0U == config.samplePeriod) || (0U == config.numSamples) || (MAX_SAMPLES < config.numSamples))
+    {
+        isValid = false;
+    }
+    else if ((EXCITATION_PRBS == config.excitation) && (0U == config.prbsHold))
+    {
+        isValid = false;
+    }
+    else if ((EXCITATION_CHIRP == config.excitation) &&
+             ((CHIRP_NYQUIST_LIMIT <= (static_cast<uint32_t>(config.chirpFreqStart) * config.samplePeriod)) ||
+              (CHIRP_NYQUIST_LIMIT <= (static_cast<uint32_t>(config.chirpFreqEnd) * config.samplePeriod))))
+    {
+        isValid = false;
+    }
+    else
+    {
+        ;
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+int16_t SystemIdentification::calculateExcitation()
+{
+    int16_t pwm = m_config.offset;
+
+    switch (m_config.excitation)
+    {
+    case EXCITATION_STEP:
+        if (m_config.stepDelay <= m_sampleIdx)
+        {
+            pwm += m_config.amplitude;
+        }
+        break;
+
+    case EXCITATION_PRBS:
+        /* 7 bit maximum length sequence (x^7 + x^6 + 1), which repeats after 127 bits. */
+        if ((0U < m_sampleIdx) && (0U == (m_sampleIdx % m_config.prbsHold)))
+        {
+            uint8_t feedback = ((m_prbsRegister >> 6U) ^ (m_prbsRegister >> 5U)) & 1U;
+
+            m_prbsRegister = ((m_prbsRegister << 1U) | feedback) & 0x7FU;
+        }
+
+        if (0U != (m_prbsRegister & 1U))
+        {
+            pwm += m_config.amplitude;
+        }
+        else
+        {
+            pwm -= m_config.amplitude;
+        }
+        break;
+
+    case EXCITATION_CHIRP:
+    {
+        int32_t freqStart = static_cast<int32_t>(m_config.chirpFreqStart); /* [mHz] */
+        int32_t freqEnd   = static_cast<int32_t>(m_config.chirpFreqEnd);   /* [mHz] */
+        int32_t freq      = freqStart + ((freqEnd - freqStart) * m_sampleIdx) / m_config.numSamples; /* [mHz] */
+        uint32_t phaseInc = (static_cast<uint32_t>(freq) * m_config.samplePeriod * 1024U) + m_chirpPhaseFraction;
+
+        pwm += scaledSine(m_chirpPhase, m_config.amplitude);
+
+        /* Phase increment in 1/65536 periods = f [mHz] * T [ms] * 65536 / 10^6 = f * T * 1024 / 15625 */
+        m_chirpPhase += static_cast<uint16_t>(phaseInc / 15625U);
+        m_chirpPhaseFraction = phaseInc % 15625U;
+    }
+    break;
+
+    default:
+        break;
+    }
+
+    return pwm;
+}
+
+void SystemIdentification::applySample(uint16_t timestamp)
+{
+    IMotors& motors   = Board::getInstance().getMotors();
+    int16_t  maxSpeed = motors.getMaxSpeed();
+    int16_t  pwm      = calculateExcitation();
+    Sample&  sample   = m_samples[m_sampleIdx];
+
+    if (maxSpeed < pwm)
+    {
+        pwm = maxSpeed;
+    }
+    else if (-maxSpeed > pwm)
+    {
+        pwm = -maxSpeed;
+    }
+    else
+    {
+        ;
+    }
+
+    if (MODE_ROTATION == m_config.mode)
+    {
+        motors.setSpeeds(pwm, -pwm);
+    }
+    else
+    {
+        motors.setSpeeds(pwm, pwm);
+    }
+
+    sample.timestamp  = timestamp;
+    sample.pwm        = pwm;
+    sample.deltaLeft  = 0;
+    sample.deltaRight = 0;
+}
+
+void SystemIdentification::captureSample()
+{
+    IEncoders& encoders    = Board::getInstance().getEncoders();
+    int16_t    countsLeft  = encoders.getCountsLeft();
+    int16_t    countsRight = encoders.getCountsRight();
+    Sample&    sample      = m_samples[m_sampleIdx];
+
+    /* The encoder counters may overflow, which the 16 bit difference handles. */
+    sample.deltaLeft  = static_cast<int16_t>(countsLeft - m_lastCountsLeft);
+    sample.deltaRight = static_cast<int16_t>(countsRight - m_lastCountsRight);
+
+    m_lastCountsLeft  = countsLeft;
+    m_lastCountsRight = countsRight;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Calculate amplitude * sin(phase) without floating point, using the
+ * Bhaskara I approximation (max. error below 0.5% of the amplitude).
+ *
+ * @param[in] phase     Phase, a full period is 65536.
+ * @param[in] amplitude Amplitude
+ *
+ * @return Scaled sine value
+ */
+static int16_t scaledSine(uint16_t phase, int16_t amplitude)
+{
+    const uint32_t HALF_PERIOD = 32768U;
+    uint32_t       halfPhase   = phase % HALF_PERIOD;
+
+    /* sin(x) ~ 16 x (pi - x) / (5 pi^2 - 4 x (pi - x)) for 0 <= x <= pi
+     * With x = pi * p / 2^15 and q = p * (2^15 - p) this is 4 q / (5 * 2^28 - q),
+     * which scaled by 2^15 becomes q / ((5 * 2^28 - q) / 2^17).
+     */
+    uint32_t q      = halfPhase * (HALF_PERIOD - halfPhase);
+    uint32_t sine15 = q / ((5U * 268435456U - q) >> 17U);
+    int32_t  value  = (static_cast<int32_t>(amplitude) * static_cast<int32_t>(sine15)) / 32768;
+
+    if (HALF_PERIOD <= phase)
+    {
+        value = -value;
+    }
+
+    return static_cast<int16_t>(value);
+}
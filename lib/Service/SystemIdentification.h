@@ -0,0 +1,266 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  System identification by open-loop motor excitation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef SYSTEM_IDENTIFICATION_H
+#define SYSTEM_IDENTIFICATION_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+#ifndef SYSTEM_IDENTIFICATION_MAX_SAMPLES
+/** Max. number of samples, which can be captured in one run. Every sample takes 8 byte RAM. */
+#define SYSTEM_IDENTIFICATION_MAX_SAMPLES (100U)
+#endif /* SYSTEM_IDENTIFICATION_MAX_SAMPLES */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * System identification of the drive.
+ *
+ * The motors are driven directly with a step, PRBS or chirp sequence, without
+ * any closed-loop control in between. Every sample period the applied PWM and
+ * the encoder steps, which were counted while it was applied, are captured
+ * together with a timestamp into a RAM buffer. After the run the samples can
+ * be read out and streamed to a host, which fits a model to them.
+ *
+ * The differential drive must be disabled during a run, otherwise it will
+ * overwrite the motor speeds.
+ */
+class SystemIdentification
+{
+public:
+    /** Excitation signal */
+    enum Excitation
+    {
+        EXCITATION_STEP = 0, /**< Step from offset to offset + amplitude. */
+        EXCITATION_PRBS,     /**< Pseudo random binary sequence around the offset. */
+        EXCITATION_CHIRP,    /**< Sine with linear frequency sweep around the offset. */
+        EXCITATION_MAX       /**< Number of excitation signals. */
+    };
+
+    /** Which motion is excited. */
+    enum Mode
+    {
+        MODE_LINEAR = 0, /**< Both motors get the same PWM. */
+        MODE_ROTATION,   /**< The right motor gets the negated PWM, the robot turns on the spot. */
+        MODE_MAX         /**< Number of modes. */
+    };
+
+    /** Configuration of a run. */
+    struct Config
+    {
+        Excitation excitation;     /**< Excitation signal */
+        Mode       mode;           /**< Excited motion */
+        uint16_t   samplePeriod;   /**< Sample period in ms. */
+        uint16_t   numSamples;     /**< Number of samples to capture. */
+        int16_t    offset;         /**< PWM offset in digits. */
+        int16_t    amplitude;      /**< PWM amplitude in digits. */
+        uint16_t   stepDelay;      /**< Step: Number of samples before the step. */
+        uint8_t    prbsHold;       /**< PRBS: Number of samples per sequence bit. */
+        uint16_t   chirpFreqStart; /**< Chirp: Start frequency in mHz. */
+        uint16_t   chirpFreqEnd;   /**< Chirp: End frequency in mHz. */
+    };
+
+    /** A captured sample. */
+    struct Sample
+    {
+        uint16_t timestamp;  /**< Time since start of the run in ms, when the PWM was applied. */
+        int16_t  pwm;        /**< Applied PWM of the left motor in digits. The right one depends on the mode. */
+        int16_t  deltaLeft;  /**< Left encoder steps, counted while the PWM was applied. */
+        int16_t  deltaRight; /**< Right encoder steps, counted while the PWM was applied. */
+    };
+
+    /** Max. number of samples, which can be captured in one run. */
+    static const uint16_t MAX_SAMPLES = SYSTEM_IDENTIFICATION_MAX_SAMPLES;
+
+    /** Default sample period in ms, same as the differential drive control period. */
+    static const uint16_t DEFAULT_SAMPLE_PERIOD = 5U;
+
+    /**
+     * Constructs the system identification.
+     */
+    SystemIdentification();
+
+    /**
+     * Destroys the system identification.
+     */
+    ~SystemIdentification()
+    {
+    }
+
+    /**
+     * Get a default configuration for the given excitation, which uses the
+     * whole sample buffer.
+     *
+     * @param[out] config       Default configuration
+     * @param[in]  excitation   Excitation signal
+     */
+    static void getDefaultConfig(Config& config, Excitation excitation);
+
+    /**
+     * Start a run. The first PWM value is applied immediately.
+     *
+     * @param[in] config    Configuration of the run.
+     *
+     * @return If the configuration is valid and the run started, it will return true otherwise false.
+     */
+    bool start(const Config& config);
+
+    /**
+     * Process the run. Call it at least once per sample period, better more often.
+     * If the run is finished, the motors are stopped.
+     *
+     * @return If the run is still in progress, it will return true otherwise false.
+     */
+    bool process();
+
+    /**
+     * Abort a run in progress and stop the motors.
+     * The samples, which are complete so far, are kept.
+     */
+    void abort();
+
+    /**
+     * Is a run in progress?
+     *
+     * @return If a run is in progress, it will return true otherwise false.
+     */
+    bool isRunning() const
+    {
+        return m_isRunning;
+    }
+
+    /**
+     * Get the configuration of the last run.
+     *
+     * @return Configuration
+     */
+    const Config& getConfig() const
+    {
+        return m_config;
+    }
+
+    /**
+     * Get number of complete samples.
+     *
+     * @return Number of samples
+     */
+    uint16_t getNumSamples() const;
+
+    /**
+     * Get a complete sample.
+     *
+     * @param[in]  index    Sample index
+     * @param[out] sample   Sample
+     *
+     * @return If the sample is available, it will return true otherwise false.
+     */
+    bool getSample(uint16_t index, Sample& sample) const;
+
+    /**
+     * Check whether the configuration can be used for a run.
+     *
+     * @param[in] config    Configuration
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    static bool isValid(const Config& config);
+
+private:
+    /** Seed of the PRBS shift register, must not be 0. */
+    static const uint8_t PRBS_SEED = 0x7FU;
+
+    /**
+     * The chirp frequency multiplied with the sample period must be lower
+     * than this, to stay below the Nyquist frequency. [mHz * ms]
+     */
+    static const uint32_t CHIRP_NYQUIST_LIMIT = 500000U;
+
+    Config   m_config;             /**< Configuration of the current/last run. */
+    bool     m_isRunning;          /**< Is a run in progress? */
+    uint32_t m_startTimestamp;     /**< Timestamp in ms at start of the run. */
+    uint16_t m_sampleIdx;          /**< Index of the sample, which PWM is currently applied. */
+    int16_t  m_lastCountsLeft;     /**< Left encoder counts at begin of the current sample. */
+    int16_t  m_lastCountsRight;    /**< Right encoder counts at begin of the current sample. */
+    uint8_t  m_prbsRegister;       /**< PRBS shift register */
+    uint16_t m_chirpPhase;         /**< Chirp phase, a full period is 65536. */
+    uint32_t m_chirpPhaseFraction; /**< Chirp phase remainder, to avoid accumulating rounding errors. */
+    Sample   m_samples[MAX_SAMPLES]; /**< Captured samples */
+
+    /* Not allowed. */
+    SystemIdentification(const SystemIdentification& sysId);            /**< Copy construction of an instance. */
+    SystemIdentification& operator=(const SystemIdentification& sysId); /**< Assignment of an instance. */
+
+    /**
+     * Calculate the excitation PWM of the current sample and advance the
+     * signal generator.
+     *
+     * @return PWM in digits
+     */
+    int16_t calculateExcitation();
+
+    /**
+     * Apply the excitation of the current sample to the motors and remember
+     * it together with the timestamp and encoder counts.
+     *
+     * @param[in] timestamp Timestamp in ms since start of the run.
+     */
+    void applySample(uint16_t timestamp);
+
+    /**
+     * Store the encoder steps into the current sample, which were counted
+     * since it was applied.
+     */
+    void captureSample();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SYSTEM_IDENTIFICATION_H */
+/** @} */
@@ -0,0 +1,268 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Self-describing telemetry frame composer
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Telemetry.h"
+#include <Arduino.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+uint8_t Telemetry::registerSignal(const char* name, Type type, Getter getter, int16_t scaleNumerator,
+                                  int16_t scaleDenominator)
+{
+    uint8_t signalIdx = INVALID_SIGNAL;
+
+    if ((MAX_SIGNALS > m_numSignals) && (nullptr != name) && (nullptr != getter) && (0 != scaleDenominator))
+    {
+        Signal& signal = m_signals[m_numSignals];
+
+        signal.name             = name;
+        signal.type             = type;
+        signal.getter           = getter;
+        signal.scaleNumerator   = scaleNumerator;
+        signal.scaleDenominator = scaleDenominator;
+
+        signalIdx = m_numSignals;
+        ++m_numSignals;
+    }
+
+    return signalIdx;
+}
+
+bool Telemetry::select(uint8_t signalIdx)
+{
+    bool isSelected = false;
+
+    if ((m_numSignals > signalIdx) && (MAX_SIGNALS > m_numSelected))
+    {
+        uint8_t size = getTypeSize(m_signals[signalIdx].type);
+
+        if ((sizeof(DataFrame::values) - m_valuesSize) >= size)
+        {
+            m_selection[m_numSelected] = signalIdx;
+            ++m_numSelected;
+            m_valuesSize += size;
+
+            /* The host needs the new schema. */
+            ++m_layoutId;
+
+            isSelected = true;
+        }
+    }
+
+    return isSelected;
+}
+
+void Telemetry::unselectAll()
+{
+    m_numSelected = 0U;
+    m_valuesSize  = 0U;
+    ++m_layoutId;
+}
+
+void Telemetry::setDecimation(uint8_t decimation)
+{
+    if (0U == decimation)
+    {
+        decimation = 1U;
+    }
+
+    if (m_decimation != decimation)
+    {
+        m_decimation = decimation;
+        m_tickCnt    = 0U;
+
+        /* The decimation is part of the schema. */
+        ++m_layoutId;
+    }
+}
+
+bool Telemetry::process(DataFrame& frame)
+{
+    bool isComposed = false;
+
+    ++m_tickCnt;
+
+    if ((m_decimation <= m_tickCnt) && (0U < m_numSelected))
+    {
+        uint8_t offset = 0U;
+        uint8_t idx;
+
+        frame.layoutId = m_layoutId;
+        frame.sequence = m_sequence;
+
+        if (nullptr != m_sampler)
+        {
+            m_sampler();
+        }
+
+        for (idx = 0U; idx < m_numSelected; ++idx)
+        {
+            const Signal& signal = m_signals[m_selection[idx]];
+            uint32_t      value  = static_cast<uint32_t>(signal.getter());
+            uint8_t       size   = getTypeSize(signal.type);
+
+            /* Little endian, independent of the platform. */
+            while (0U < size)
+            {
+                frame.values[offset] = static_cast<uint8_t>(value & 0xFFU);
+                value >>= 8U;
+                ++offset;
+                --size;
+            }
+        }
+
+        /* Unused bytes are cleared to keep the frame deterministic. */
+        memset(&frame.values[offset], 0, sizeof(frame.values) - offset);
+
+        ++m_sequence;
+        m_tickCnt  = 0U;
+        isComposed = true;
+    }
+    else if (m_decimation <= m_tickCnt)
+    {
+        m_tickCnt = 0U;
+    }
+    else
+    {
+        ;
+    }
+
+    return isComposed;
+}
+
+bool Telemetry::getSchemaFrame(uint8_t index, SchemaFrame& frame) const
+{
+    bool isValid = false;
+
+    if (m_numSelected > index)
+    {
+        uint8_t offset = 0U;
+        uint8_t idx;
+
+        for (idx = 0U; idx < index; ++idx)
+        {
+            offset += getTypeSize(m_signals[m_selection[idx]].type);
+        }
+
+        {
+            const Signal& signal = m_signals[m_selection[index]];
+
+            frame.layoutId         = m_layoutId;
+            frame.index            = index;
+            frame.count            = m_numSelected;
+            frame.type             = static_cast<uint8_t>(signal.type);
+            frame.offset           = offset;
+            frame.decimation       = m_decimation;
+            frame.scaleNumerator   = signal.scaleNumerator;
+            frame.scaleDenominator = signal.scaleDenominator;
+
+            /* Zero padded, without termination if the name has the max. length. */
+            strncpy_P(frame.name, signal.name, sizeof(frame.name));
+        }
+
+        isValid = true;
+    }
+
+    return isValid;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+uint8_t Telemetry::getTypeSize(Type type)
+{
+    uint8_t size = 0U;
+
+    switch (type)
+    {
+    case TYPE_INT8:
+        /* fallthrough */
+    case TYPE_UINT8:
+        size = 1U;
+        break;
+
+    case TYPE_INT16:
+        /* fallthrough */
+    case TYPE_UINT16:
+        size = 2U;
+        break;
+
+    case TYPE_INT32:
+        /* fallthrough */
+    case TYPE_UINT32:
+        size = 4U;
+        break;
+
+    default:
+        break;
+    }
+
+    return size;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
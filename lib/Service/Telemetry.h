@@ -0,0 +1,293 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Self-describing telemetry frame composer
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Telemetry frame composer.
+ *
+ * Modules register named signals with their type and scaling. The selected
+ * signals are packed in selection order into one data frame, which is
+ * composed every n-th tick (decimation). A host decodes the data frames
+ * generically with the schema frames, one per selected signal, which
+ * describe the layout. The layout id in every frame changes with the
+ * selection, so the host can detect a outdated schema.
+ *
+ * Multi-byte values are packed little endian.
+ */
+class Telemetry
+{
+public:
+    /** Signal types on the wire. */
+    enum Type
+    {
+        TYPE_INT8 = 0, /**< Signed 8-bit */
+        TYPE_UINT8,    /**< Unsigned 8-bit */
+        TYPE_INT16,    /**< Signed 16-bit */
+        TYPE_UINT16,   /**< Unsigned 16-bit */
+        TYPE_INT32,    /**< Signed 32-bit */
+        TYPE_UINT32    /**< Unsigned 32-bit */
+    };
+
+    /**
+     * Function, which provides the current signal value.
+     *
+     * @return Signal value
+     */
+    typedef int32_t (*Getter)(void);
+
+    /**
+     * Function, which is called once per data frame before the getters.
+     * It takes a snapshot of values, which are provided together, e.g. both
+     * coordinates of the position. The getters return the snapshot then.
+     */
+    typedef void (*Sampler)(void);
+
+    /** Max. number of registered signals. */
+    static const uint8_t MAX_SIGNALS = 16U;
+
+    /** Returned by registerSignal(), if the signal could not be registered. */
+    static const uint8_t INVALID_SIGNAL = 0xFFU;
+
+    /** Max. length of a signal name in the schema. */
+    static const uint8_t MAX_NAME_LENGTH = 8U;
+
+    /** Data frame size in byte. It is limited by the max. SerialMuxProt payload. */
+    static const uint8_t DATA_FRAME_SIZE = 32U;
+
+    /** Size of the data frame header in byte. */
+    static const uint8_t DATA_FRAME_HEADER_SIZE = 2U;
+
+    /** Data frame, which contains the values of the selected signals. */
+    typedef struct _DataFrame
+    {
+        uint8_t layoutId;                                          /**< Layout id */
+        uint8_t sequence;                                          /**< Sequence number to detect lost frames */
+        uint8_t values[DATA_FRAME_SIZE - DATA_FRAME_HEADER_SIZE]; /**< Packed signal values */
+    } __attribute__((packed)) DataFrame;
+
+    /** Schema frame, which describes one selected signal in the data frame. */
+    typedef struct _SchemaFrame
+    {
+        uint8_t layoutId;               /**< Layout id */
+        uint8_t index;                  /**< Index of the signal in the data frame */
+        uint8_t count;                  /**< Number of signals in the data frame */
+        uint8_t type;                   /**< Signal type, see Type. */
+        uint8_t offset;                 /**< Byte offset of the value in the data frame values */
+        uint8_t decimation;             /**< Number of ticks per data frame */
+        int16_t scaleNumerator;         /**< Physical value = raw value * numerator / denominator */
+        int16_t scaleDenominator;       /**< Physical value = raw value * numerator / denominator */
+        char    name[MAX_NAME_LENGTH];  /**< Signal name, not terminated if it has the max. length. */
+    } __attribute__((packed)) SchemaFrame;
+
+    /**
+     * Constructs the telemetry composer without signals.
+     */
+    Telemetry() :
+        m_signals(),
+        m_numSignals(0U),
+        m_sampler(nullptr),
+        m_selection(),
+        m_numSelected(0U),
+        m_valuesSize(0U),
+        m_layoutId(0U),
+        m_sequence(0U),
+        m_decimation(1U),
+        m_tickCnt(0U)
+    {
+    }
+
+    /**
+     * Destroys the telemetry composer.
+     */
+    ~Telemetry()
+    {
+    }
+
+    /**
+     * Register a signal.
+     *
+     * @param[in] name              Signal name in program memory, e.g. by PSTR(). It must be valid during the
+     *                              whole lifetime.
+     * @param[in] type              Signal type on the wire.
+     * @param[in] getter            Function, which provides the current signal value.
+     * @param[in] scaleNumerator    Scaling numerator to the physical value.
+     * @param[in] scaleDenominator  Scaling denominator to the physical value.
+     *
+     * @return Signal index or INVALID_SIGNAL, if the signal could not be registered.
+     */
+    uint8_t registerSignal(const char* name, Type type, Getter getter, int16_t scaleNumerator = 1,
+                           int16_t scaleDenominator = 1);
+
+    /**
+     * Set the sampler, which is called once per data frame before the getters.
+     *
+     * @param[in] sampler   Sampler or nullptr, if no sampler is needed.
+     */
+    void setSampler(Sampler sampler)
+    {
+        m_sampler = sampler;
+    }
+
+    /**
+     * Select a signal for the data frame. It is appended to the already selected ones.
+     *
+     * @param[in] signalIdx Signal index
+     *
+     * @return If the signal fits into the data frame, it will return true otherwise false.
+     */
+    bool select(uint8_t signalIdx);
+
+    /**
+     * Remove all signals from the data frame.
+     */
+    void unselectAll();
+
+    /**
+     * Set the decimation.
+     *
+     * @param[in] decimation    Number of ticks per data frame, at least 1.
+     */
+    void setDecimation(uint8_t decimation);
+
+    /**
+     * Get the decimation.
+     *
+     * @return Number of ticks per data frame.
+     */
+    uint8_t getDecimation() const
+    {
+        return m_decimation;
+    }
+
+    /**
+     * Get the layout id, which changes with the signal selection.
+     *
+     * @return Layout id
+     */
+    uint8_t getLayoutId() const
+    {
+        return m_layoutId;
+    }
+
+    /**
+     * Process one tick. Every n-th tick, the data frame is composed.
+     *
+     * @param[out] frame    Data frame
+     *
+     * @return If a data frame is composed, it will return true otherwise false.
+     */
+    bool process(DataFrame& frame);
+
+    /**
+     * Get the number of schema frames, which is the number of selected signals.
+     *
+     * @return Number of schema frames
+     */
+    uint8_t getNumSchemaFrames() const
+    {
+        return m_numSelected;
+    }
+
+    /**
+     * Get a schema frame.
+     *
+     * @param[in]  index    Index of the selected signal.
+     * @param[out] frame    Schema frame
+     *
+     * @return If the index is valid, it will return true otherwise false.
+     */
+    bool getSchemaFrame(uint8_t index, SchemaFrame& frame) const;
+
+private:
+    /** A registered signal. */
+    struct Signal
+    {
+        const char* name;             /**< Signal name in program memory */
+        Type        type;             /**< Signal type */
+        Getter      getter;           /**< Provides the signal value. */
+        int16_t     scaleNumerator;   /**< Scaling numerator */
+        int16_t     scaleDenominator; /**< Scaling denominator */
+    };
+
+    Signal  m_signals[MAX_SIGNALS];   /**< Registered signals */
+    uint8_t m_numSignals;             /**< Number of registered signals */
+    Sampler m_sampler;                /**< Takes the snapshot before the getters are called. */
+    uint8_t m_selection[MAX_SIGNALS]; /**< Indices of the selected signals in data frame order */
+    uint8_t m_numSelected;            /**< Number of selected signals */
+    uint8_t m_valuesSize;             /**< Size of the packed values in byte */
+    uint8_t m_layoutId;               /**< Layout id */
+    uint8_t m_sequence;               /**< Data frame sequence number */
+    uint8_t m_decimation;             /**< Number of ticks per data frame */
+    uint8_t m_tickCnt;                /**< Ticks since the last data frame */
+
+    /* Not allowed. */
+    Telemetry(const Telemetry& telemetry);            /**< Copy construction of an instance. */
+    Telemetry& operator=(const Telemetry& telemetry); /**< Assignment of an instance. */
+
+    /**
+     * Get the size of a signal type on the wire.
+     *
+     * @param[in] type  Signal type
+     *
+     * @return Size in byte
+     */
+    static uint8_t getTypeSize(Type type);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* TELEMETRY_H */
+/** @} */
@@ -0,0 +1,533 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Fixed point unit types
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef UNITS_HPP
+#define UNITS_HPP
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Fixed point physical units with compile time range tracking.
+ *
+ * A quantity carries its unit and its value range as template parameters.
+ * Every operation derives the range of its result at compile time and the
+ * value is stored in the narrowest integer type, which covers this range.
+ * This way the calculation is only widened to 32 bit, where it is really
+ * necessary, and a missing widening can not overflow silently.
+ */
+namespace Units
+{
+    /** Unit encoder steps. */
+    struct Steps
+    {
+    };
+
+    /** Unit mm. */
+    struct Millimeter
+    {
+    };
+
+    /** Unit mrad. */
+    struct Milliradian
+    {
+    };
+
+    /** Unit steps/s. */
+    struct StepsPerSecond
+    {
+    };
+
+    /** Unit mrad/s. */
+    struct MilliradianPerSecond
+    {
+    };
+
+    /** Unit PWM digits of the motors. */
+    struct Digits
+    {
+    };
+
+    /**
+     * Compile time helpers for the range calculation.
+     */
+    namespace Detail
+    {
+        /**
+         * Select a type by a condition.
+         *
+         * @tparam COND     Condition
+         * @tparam TTrue    Type, if the condition is true.
+         * @tparam TFalse   Type, if the condition is false.
+         */
+        template<bool COND, typename TTrue, typename TFalse>
+        struct Select
+        {
+            typedef TTrue Type; /**< Selected type */
+        };
+
+        /**
+         * Select a type by a condition, which is false.
+         *
+         * @tparam TTrue    Type, if the condition is true.
+         * @tparam TFalse   Type, if the condition is false.
+         */
+        template<typename TTrue, typename TFalse>
+        struct Select<false, TTrue, TFalse>
+        {
+            typedef TFalse Type; /**< Selected type */
+        };
+
+        /**
+         * Get the minimum of two values.
+         *
+         * @param[in] lhs   Left hand side value
+         * @param[in] rhs   Right hand side value
+         *
+         * @return Minimum
+         */
+        constexpr int64_t min(int64_t lhs, int64_t rhs)
+        {
+            return (lhs < rhs) ? lhs : rhs;
+        }
+
+        /**
+         * Get the maximum of two values.
+         *
+         * @param[in] lhs   Left hand side value
+         * @param[in] rhs   Right hand side value
+         *
+         * @return Maximum
+         */
+        constexpr int64_t max(int64_t lhs, int64_t rhs)
+        {
+            return (lhs > rhs) ? lhs : rhs;
+        }
+
+        /**
+         * Get the absolute value.
+         *
+         * @param[in] value Value
+         *
+         * @return Absolute value
+         */
+        constexpr int64_t abs(int64_t value)
+        {
+            return (0 > value) ? -value : value;
+        }
+
+        /**
+         * Get the greatest common divisor of two positive values.
+         *
+         * @param[in] lhs   Left hand side value
+         * @param[in] rhs   Right hand side value
+         *
+         * @return Greatest common divisor
+         */
+        constexpr int64_t gcd(int64_t lhs, int64_t rhs)
+        {
+            return (0 == rhs) ? lhs : gcd(rhs, lhs % rhs);
+        }
+
+    } /* namespace Detail */
+
+    /**
+     * The narrowest integer type, which covers a value range.
+     *
+     * @tparam MIN  Minimum value
+     * @tparam MAX  Maximum value
+     */
+    template<int64_t MIN, int64_t MAX>
+    struct Storage
+    {
+        static_assert(MIN <= MAX, "Invalid value range.");
+        static_assert((INT32_MIN <= MIN) && (UINT32_MAX >= MAX), "Value range exceeds 32 bit.");
+        static_assert((0 <= MIN) || (INT32_MAX >= MAX), "Signed value range exceeds 32 bit.");
+
+        /** Narrowest unsigned integer type. */
+        typedef typename Detail::Select<
+            (UINT8_MAX >= MAX), uint8_t,
+            typename Detail::Select<(UINT16_MAX >= MAX), uint16_t, uint32_t>::Type>::Type UnsignedType;
+
+        /** Narrowest signed integer type. */
+        typedef typename Detail::Select<
+            ((INT8_MIN <= MIN) && (INT8_MAX >= MAX)), int8_t,
+            typename Detail::Select<((INT16_MIN <= MIN) && (INT16_MAX >= MAX)), int16_t, int32_t>::Type>::Type
+            SignedType;
+
+        /** Narrowest integer type, which covers the value range. */
+        typedef typename Detail::Select<(0 <= MIN), UnsignedType, SignedType>::Type Type;
+    };
+
+    /**
+     * Value range after the scaling with a rational factor.
+     * The factor is reduced at compile time, which may save a division.
+     *
+     * @tparam MIN  Minimum value
+     * @tparam MAX  Maximum value
+     * @tparam NUM  Numerator of the factor
+     * @tparam DEN  Denominator of the factor, shall be positive.
+     */
+    template<int64_t MIN, int64_t MAX, int64_t NUM, int64_t DEN>
+    struct ScaledRange
+    {
+        static_assert(0 < DEN, "Denominator shall be positive.");
+
+        /** Greatest common divisor of numerator and denominator. */
+        static const int64_t GCD = Detail::gcd(Detail::abs(NUM), DEN);
+
+        /** Reduced numerator. */
+        static const int64_t NUM_REDUCED = NUM / GCD;
+
+        /** Reduced denominator. */
+        static const int64_t DEN_REDUCED = DEN / GCD;
+
+        /** Minimum of the product with the numerator. */
+        static const int64_t PRODUCT_MIN = Detail::min(MIN * NUM_REDUCED, MAX * NUM_REDUCED);
+
+        /** Maximum of the product with the numerator. */
+        static const int64_t PRODUCT_MAX = Detail::max(MIN * NUM_REDUCED, MAX * NUM_REDUCED);
+
+        /** Minimum of the result. */
+        static const int64_t RESULT_MIN = PRODUCT_MIN / DEN_REDUCED;
+
+        /** Maximum of the result. */
+        static const int64_t RESULT_MAX = PRODUCT_MAX / DEN_REDUCED;
+
+        /** Type of the intermediate product. */
+        typedef typename Storage<PRODUCT_MIN, PRODUCT_MAX>::Type Intermediate;
+    };
+
+    /**
+     * Value range after the scaling with a positive Q-format factor.
+     * The division is replaced by a multiplication and a shift. Rounding is
+     * towards zero, but the factor itself is rounded to FRAC_BITS.
+     *
+     * @tparam MIN          Minimum value
+     * @tparam MAX          Maximum value
+     * @tparam NUM          Numerator of the factor, shall be positive.
+     * @tparam DEN          Denominator of the factor, shall be positive.
+     * @tparam FRAC_BITS    Number of fractional bits of the factor
+     */
+    template<int64_t MIN, int64_t MAX, int64_t NUM, int64_t DEN, uint8_t FRAC_BITS>
+    struct QRange
+    {
+        static_assert((0 < NUM) && (0 < DEN), "Q-format factor shall be positive.");
+        static_assert(31U > FRAC_BITS, "Too many fractional bits.");
+
+        /** Factor in Q-format, rounded to nearest. */
+        static const int64_t FACTOR = ((NUM << FRAC_BITS) + (DEN / 2)) / DEN;
+
+        /** Maximum absolute value of the product with the factor. */
+        static const int64_t PRODUCT_ABS_MAX = Detail::max(Detail::abs(MIN), Detail::abs(MAX)) * FACTOR;
+
+        /** Minimum of the result. */
+        static const int64_t RESULT_MIN = (MIN * FACTOR) / (static_cast<int64_t>(1) << FRAC_BITS);
+
+        /** Maximum of the result. */
+        static const int64_t RESULT_MAX = (MAX * FACTOR) / (static_cast<int64_t>(1) << FRAC_BITS);
+
+        /** Type of the intermediate product, symmetric for the sign handling. */
+        typedef typename Storage<(0 > MIN) ? -PRODUCT_ABS_MAX : 0, PRODUCT_ABS_MAX>::Type Intermediate;
+    };
+
+    /**
+     * A fixed point quantity of a unit with a value range.
+     *
+     * @tparam TUnit    The unit tag.
+     * @tparam MIN      Minimum value
+     * @tparam MAX      Maximum value
+     */
+    template<typename TUnit, int64_t MIN, int64_t MAX>
+    class Quantity
+    {
+    public:
+        /** Type of the value. */
+        typedef typename Storage<MIN, MAX>::Type Type;
+
+        /**
+         * Constructs a quantity with the value 0.
+         */
+        constexpr Quantity() : m_value(0)
+        {
+        }
+
+        /**
+         * Constructs a quantity with a value, which shall be in range.
+         *
+         * @param[in] value Value
+         */
+        constexpr explicit Quantity(Type value) : m_value(value)
+        {
+        }
+
+        /**
+         * Constructs a quantity from a quantity of the same unit with a
+         * narrower range. Narrowing shall be done explicit with clamp() or limit().
+         *
+         * @param[in] other Other quantity
+         */
+        template<int64_t OTHER_MIN, int64_t OTHER_MAX>
+        constexpr Quantity(const Quantity<TUnit, OTHER_MIN, OTHER_MAX>& other) :
+            m_value(static_cast<Type>(other.value()))
+        {
+            static_assert((MIN <= OTHER_MIN) && (OTHER_MAX <= MAX), "Narrowing conversion, use clamp() or limit().");
+        }
+
+        /**
+         * Get the value.
+         *
+         * @return Value
+         */
+        constexpr Type value() const
+        {
+            return m_value;
+        }
+
+        /**
+         * Scale with a rational factor and convert to another unit.
+         * The factor is reduced at compile time and the result is rounded
+         * towards zero.
+         *
+         * @tparam TOtherUnit   The unit of the result.
+         * @tparam NUM          Numerator of the factor
+         * @tparam DEN          Denominator of the factor, shall be positive.
+         *
+         * @return Converted quantity
+         */
+        template<typename TOtherUnit, int64_t NUM, int64_t DEN, typename TRange = ScaledRange<MIN, MAX, NUM, DEN>>
+        constexpr Quantity<TOtherUnit, TRange::RESULT_MIN, TRange::RESULT_MAX> convert() const
+        {
+            return Quantity<TOtherUnit, TRange::RESULT_MIN, TRange::RESULT_MAX>(
+                static_cast<typename Quantity<TOtherUnit, TRange::RESULT_MIN, TRange::RESULT_MAX>::Type>(
+                    (static_cast<typename TRange::Intermediate>(m_value) *
+                     static_cast<typename TRange::Intermediate>(TRange::NUM_REDUCED)) /
+                    static_cast<typename TRange::Intermediate>(TRange::DEN_REDUCED)));
+        }
+
+        /**
+         * Scale with a rational factor. The result is rounded towards zero.
+         *
+         * @tparam NUM  Numerator of the factor
+         * @tparam DEN  Denominator of the factor, shall be positive.
+         *
+         * @return Scaled quantity
+         */
+        template<int64_t NUM, int64_t DEN, typename TRange = ScaledRange<MIN, MAX, NUM, DEN>>
+        constexpr Quantity<TUnit, TRange::RESULT_MIN, TRange::RESULT_MAX> scale() const
+        {
+            return convert<TUnit, NUM, DEN>();
+        }
+
+        /**
+         * Scale with a positive factor in Q-format. Use it instead of scale(),
+         * if the division is too expensive and the rounding of the factor
+         * to FRAC_BITS is acceptable.
+         *
+         * @tparam NUM          Numerator of the factor, shall be positive.
+         * @tparam DEN          Denominator of the factor, shall be positive.
+         * @tparam FRAC_BITS    Number of fractional bits of the factor
+         *
+         * @return Scaled quantity
+         */
+        template<int64_t NUM, int64_t DEN, uint8_t FRAC_BITS, typename TRange = QRange<MIN, MAX, NUM, DEN, FRAC_BITS>>
+        constexpr Quantity<TUnit, TRange::RESULT_MIN, TRange::RESULT_MAX> scaleQ() const
+        {
+            return Quantity<TUnit, TRange::RESULT_MIN, TRange::RESULT_MAX>(
+                static_cast<typename Quantity<TUnit, TRange::RESULT_MIN, TRange::RESULT_MAX>::Type>(
+                    (0 <= m_value)
+                        ? ((static_cast<typename TRange::Intermediate>(m_value) *
+                            static_cast<typename TRange::Intermediate>(TRange::FACTOR)) >>
+                           FRAC_BITS)
+                        : -((-static_cast<typename TRange::Intermediate>(m_value) *
+                             static_cast<typename TRange::Intermediate>(TRange::FACTOR)) >>
+                            FRAC_BITS)));
+        }
+
+        /**
+         * Divide by a positive runtime divisor. The result is rounded towards zero.
+         *
+         * @tparam TDivisor The type of the divisor.
+         *
+         * @param[in] divisor   Divisor, shall be positive.
+         *
+         * @return Divided quantity
+         */
+        template<typename TDivisor>
+        constexpr Quantity<TUnit, Detail::min(MIN, 0), Detail::max(MAX, 0)> divide(TDivisor divisor) const
+        {
+            static_assert((0 <= MIN) || (static_cast<TDivisor>(-1) < static_cast<TDivisor>(0)),
+                          "Divisor type shall be signed for a signed quantity.");
+
+            return Quantity<TUnit, Detail::min(MIN, 0), Detail::max(MAX, 0)>(
+                static_cast<typename Quantity<TUnit, Detail::min(MIN, 0), Detail::max(MAX, 0)>::Type>(m_value /
+                                                                                                     divisor));
+        }
+
+        /**
+         * Saturate to a narrower compile time range.
+         *
+         * @tparam NEW_MIN  Minimum value of the result
+         * @tparam NEW_MAX  Maximum value of the result
+         *
+         * @return Saturated quantity
+         */
+        template<int64_t NEW_MIN, int64_t NEW_MAX,
+                 typename TWide = typename Storage<Detail::min(MIN, NEW_MIN), Detail::max(MAX, NEW_MAX)>::Type>
+        constexpr Quantity<TUnit, NEW_MIN, NEW_MAX> clamp() const
+        {
+            return Quantity<TUnit, NEW_MIN, NEW_MAX>(static_cast<typename Quantity<TUnit, NEW_MIN, NEW_MAX>::Type>(
+                (static_cast<TWide>(NEW_MIN) > static_cast<TWide>(m_value))
+                    ? static_cast<TWide>(NEW_MIN)
+                    : ((static_cast<TWide>(NEW_MAX) < static_cast<TWide>(m_value)) ? static_cast<TWide>(NEW_MAX)
+                                                                                   : static_cast<TWide>(m_value))));
+        }
+
+        /**
+         * Saturate to runtime limits, which are within a narrower compile time range.
+         *
+         * @tparam NEW_MIN  Minimum value of the result
+         * @tparam NEW_MAX  Maximum value of the result
+         *
+         * @param[in] lower Lower limit, shall be in [NEW_MIN; NEW_MAX].
+         * @param[in] upper Upper limit, shall be in [NEW_MIN; NEW_MAX].
+         *
+         * @return Saturated quantity
+         */
+        template<int64_t NEW_MIN, int64_t NEW_MAX,
+                 typename TWide = typename Storage<Detail::min(MIN, NEW_MIN), Detail::max(MAX, NEW_MAX)>::Type>
+        constexpr Quantity<TUnit, NEW_MIN, NEW_MAX> limit(typename Quantity<TUnit, NEW_MIN, NEW_MAX>::Type lower,
+                                                         typename Quantity<TUnit, NEW_MIN, NEW_MAX>::Type upper) const
+        {
+            return Quantity<TUnit, NEW_MIN, NEW_MAX>(static_cast<typename Quantity<TUnit, NEW_MIN, NEW_MAX>::Type>(
+                (static_cast<TWide>(lower) > static_cast<TWide>(m_value))
+                    ? static_cast<TWide>(lower)
+                    : ((static_cast<TWide>(upper) < static_cast<TWide>(m_value)) ? static_cast<TWide>(upper)
+                                                                                 : static_cast<TWide>(m_value))));
+        }
+
+        /**
+         * Wrap around by the remainder of a division with a modulus.
+         * The sign of the value is kept.
+         *
+         * @tparam MOD  Modulus, shall be positive.
+         *
+         * @return Wrapped quantity
+         */
+        template<int64_t MOD, typename TWide = typename Storage<(0 > MIN) ? Detail::min(MIN, -MOD) : 0,
+                                                                Detail::max(MAX, MOD)>::Type>
+        constexpr Quantity<TUnit, (0 > MIN) ? Detail::max(MIN, 1 - MOD) : ((MOD > MAX) ? MIN : 0),
+                           Detail::min(MAX, MOD - 1)>
+        wrap() const
+        {
+            return Quantity<TUnit, (0 > MIN) ? Detail::max(MIN, 1 - MOD) : ((MOD > MAX) ? MIN : 0),
+                            Detail::min(MAX, MOD - 1)>(
+                static_cast<typename Quantity<TUnit, (0 > MIN) ? Detail::max(MIN, 1 - MOD) : ((MOD > MAX) ? MIN : 0),
+                                              Detail::min(MAX, MOD - 1)>::Type>(static_cast<TWide>(m_value) %
+                                                                                static_cast<TWide>(MOD)));
+        }
+
+    private:
+        Type m_value; /**< Value in the unit */
+    };
+
+    /**
+     * Add two quantities of the same unit.
+     *
+     * @param[in] lhs   Left hand side quantity
+     * @param[in] rhs   Right hand side quantity
+     *
+     * @return Sum with a range, which covers all sums.
+     */
+    template<typename TUnit, int64_t LHS_MIN, int64_t LHS_MAX, int64_t RHS_MIN, int64_t RHS_MAX>
+    constexpr Quantity<TUnit, LHS_MIN + RHS_MIN, LHS_MAX + RHS_MAX>
+    operator+(const Quantity<TUnit, LHS_MIN, LHS_MAX>& lhs, const Quantity<TUnit, RHS_MIN, RHS_MAX>& rhs)
+    {
+        return Quantity<TUnit, LHS_MIN + RHS_MIN, LHS_MAX + RHS_MAX>(
+            static_cast<typename Quantity<TUnit, LHS_MIN + RHS_MIN, LHS_MAX + RHS_MAX>::Type>(
+                static_cast<typename Quantity<TUnit, LHS_MIN + RHS_MIN, LHS_MAX + RHS_MAX>::Type>(lhs.value()) +
+                static_cast<typename Quantity<TUnit, LHS_MIN + RHS_MIN, LHS_MAX + RHS_MAX>::Type>(rhs.value())));
+    }
+
+    /**
+     * Subtract two quantities of the same unit.
+     *
+     * @param[in] lhs   Left hand side quantity
+     * @param[in] rhs   Right hand side quantity
+     *
+     * @return Difference with a range, which covers all differences.
+     */
+    template<typename TUnit, int64_t LHS_MIN, int64_t LHS_MAX, int64_t RHS_MIN, int64_t RHS_MAX>
+    constexpr Quantity<TUnit, LHS_MIN - RHS_MAX, LHS_MAX - RHS_MIN>
+    operator-(const Quantity<TUnit, LHS_MIN, LHS_MAX>& lhs, const Quantity<TUnit, RHS_MIN, RHS_MAX>& rhs)
+    {
+        return Quantity<TUnit, LHS_MIN - RHS_MAX, LHS_MAX - RHS_MIN>(
+            static_cast<typename Quantity<TUnit, LHS_MIN - RHS_MAX, LHS_MAX - RHS_MIN>::Type>(
+                static_cast<typename Quantity<TUnit, LHS_MIN - RHS_MAX, LHS_MAX - RHS_MIN>::Type>(lhs.value()) -
+                static_cast<typename Quantity<TUnit, LHS_MIN - RHS_MAX, LHS_MAX - RHS_MIN>::Type>(rhs.value())));
+    }
+
+    /** Encoder steps, as provided by the relative encoders. */
+    typedef Quantity<Steps, INT16_MIN, INT16_MAX> EncoderSteps;
+
+    /** Linear speed in steps/s, as provided by the speedometer. */
+    typedef Quantity<StepsPerSecond, INT16_MIN, INT16_MAX> LinearSpeed;
+
+    /** Angular speed in mrad/s. */
+    typedef Quantity<MilliradianPerSecond, INT16_MIN, INT16_MAX> AngularSpeed;
+
+} /* namespace Units */
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* UNITS_HPP */
+/** @} */
@@ -33,6 +33,8 @@
  * Includes
  *****************************************************************************/
 #include <Util.h>
+#include <Format.h>
+#include <Arduino.h>
 
 /******************************************************************************
  * Compiler Switches
@@ -72,81 +74,43 @@
 
 void Util::uintToStr(char* str, size_t size, uint32_t value)
 {
-    if ((nullptr != str) && (0 < size))
-    {
-        size_t   idx     = 0;
-        uint8_t  digits  = 10; /* 0 - 4294967295 */
-        uint32_t divisor = 1000000000;
+    (void)Format::uintToStr(str, size, value);
+}
+
+void Util::intToStr(char* str, size_t size, int32_t value)
+{
+    (void)Format::intToStr(str, size, value);
+}
 
-        while (((size - 1) > idx) && (0 < digits))
+void Util::copyStr(char* dst, size_t size, const char* src)
+{
+    if ((nullptr != dst) && (0U < size))
+    {
+        if (nullptr == src)
         {
-            char digit = static_cast<char>(value / divisor);
-
-            /* No preceeding zeros. */
-            if (0 == idx)
-            {
-                if ((0 < digit) || (1 == digits))
-                {
-                    str[idx] = digit + '0';
-                    ++idx;
-                }
-            }
-            else
-            {
-                str[idx] = digit + '0';
-                ++idx;
-            }
-
-            --digits;
-            value %= divisor;
-            divisor /= 10;
+            memset(dst, 0, size);
+        }
+        else
+        {
+            (void)strncpy(dst, src, size - 1U);
+            dst[size - 1U] = '\0';
         }
-
-        str[idx] = '\0';
     }
 }
 
-void Util::intToStr(char* str, size_t size, int32_t value)
+void Util::copyStr(char* dst, size_t size, const __FlashStringHelper* src)
 {
-    if ((nullptr != str) && (0 < size))
+    if ((nullptr != dst) && (0U < size))
     {
-        size_t   idx     = 0;
-        uint8_t  digits  = 10; /* -2147483648 - 2147483647 */
-        uint32_t divisor = 1000000000;
-
-        if (0 > value)
+        if (nullptr == src)
         {
-            str[idx] = '-';
-            ++idx;
-
-            value *= -1;
+            memset(dst, 0, size);
         }
-
-        while (((size - 1) > idx) && (0 < digits))
+        else
         {
-            char digit = static_cast<char>(value / divisor);
-
-            /* No preceeding zeros. */
-            if (0 == idx)
-            {
-                if ((0 < digit) || (1 == digits))
-                {
-                    str[idx] = digit + '0';
-                    ++idx;
-                }
-            }
-            else
-            {
-                str[idx] = digit + '0';
-                ++idx;
-            }
-
-            --digits;
-            value %= divisor;
-            divisor /= 10;
+            (void)strncpy_P(dst, reinterpret_cast<const char*>(src), size - 1U);
+            dst[size - 1U] = '\0';
         }
-
-        str[idx] = '\0';
     }
 }
 
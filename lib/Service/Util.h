@@ -46,6 +46,9 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+/** Type of a string in program memory. */
+class __FlashStringHelper;
+
 /**
  * Utilities
  */
@@ -66,6 +69,7 @@ namespace Util
 
     /**
      * Unsigned integer to string, without preceeding zeros.
+     * See Format for width, padding and fixed-point support.
      *
      * @param[out]  str     Destination string
      * @param[in]   size    Size of the destination string in byte
@@ -82,6 +86,26 @@ namespace Util
      */
     void intToStr(char* str, size_t size, int32_t value);
 
+    /**
+     * Copy a string. The destination is always terminated and the rest of it
+     * is filled with zeros. A longer string is cut.
+     *
+     * @param[out]  dst     Destination string
+     * @param[in]   size    Size of the destination string in byte
+     * @param[in]   src     Source string
+     */
+    void copyStr(char* dst, size_t size, const char* src);
+
+    /**
+     * Copy a string from program memory to RAM. The destination is always
+     * terminated and the rest of it is filled with zeros. A longer string is cut.
+     *
+     * @param[out]  dst     Destination string
+     * @param[in]   size    Size of the destination string in byte
+     * @param[in]   src     Source string in program memory
+     */
+    void copyStr(char* dst, size_t size, const __FlashStringHelper* src);
+
 } // namespace Util
 
 #endif /* UTIL_H */
@@ -0,0 +1,310 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Online tuner of a wheel speed controller
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <WheelTuner.h>
+#include <Arduino.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+WheelTuner::WheelTuner() :
+    m_gains(getDefaultGains()),
+    m_response(),
+    m_numResponses(0U),
+    m_lastSetPoint(0),
+    m_isEvaluating(false),
+    m_start(0),
+    m_target(0),
+    m_elapsed(0U),
+    m_riseTime(0U),
+    m_peak(0),
+    m_errorSum(0U),
+    m_setPointSum(0U)
+{
+}
+
+WheelTuner::Gains WheelTuner::getDefaultGains()
+{
+    Gains gains;
+
+    gains.pDivisor = P_DIVISOR_DEFAULT;
+    gains.iDivisor = I_DIVISOR_DEFAULT;
+
+    return gains;
+}
+
+void WheelTuner::setGains(const Gains& gains)
+{
+    m_gains = gains;
+    limit(m_gains);
+
+    reset();
+}
+
+void WheelTuner::reset()
+{
+    m_isEvaluating = false;
+}
+
+bool WheelTuner::process(int16_t setPoint, int16_t speed, uint32_t period)
+{
+    bool isChanged = false;
+
+    if (true == m_isEvaluating)
+    {
+        int32_t step      = static_cast<int32_t>(m_target) - static_cast<int32_t>(m_start);
+        int32_t direction = (0 < step) ? 1 : -1;
+        int32_t stepSize  = step * direction;
+        int32_t deviation = static_cast<int32_t>(setPoint) - static_cast<int32_t>(m_target);
+
+        if (0 > deviation)
+        {
+            deviation = -deviation;
+        }
+
+        /* The set point left the step target, e.g. by the next step. The response can't be evaluated. */
+        if ((deviation * 1000) > (stepSize * SET_POINT_TOLERANCE))
+        {
+            m_isEvaluating = false;
+        }
+        else
+        {
+            int32_t progress  = (static_cast<int32_t>(speed) - static_cast<int32_t>(m_start)) * direction;
+            int32_t overshoot = (static_cast<int32_t>(speed) - static_cast<int32_t>(setPoint)) * direction;
+            int32_t error     = static_cast<int32_t>(setPoint) - static_cast<int32_t>(speed);
+
+            if (EVALUATION_TIME < (static_cast<uint32_t>(m_elapsed) + period))
+            {
+                m_elapsed = EVALUATION_TIME;
+            }
+            else
+            {
+                m_elapsed += static_cast<uint16_t>(period);
+            }
+
+            /* Rise time until 90 % of the step */
+            if ((0U == m_riseTime) && ((progress * 10) >= (stepSize * 9)))
+            {
+                m_riseTime = m_elapsed;
+            }
+
+            if (m_peak < overshoot)
+            {
+                m_peak = overshoot;
+            }
+
+            if (SETTLE_TIME < m_elapsed)
+            {
+                m_errorSum += static_cast<uint32_t>((0 > error) ? -error : error);
+                m_setPointSum += static_cast<uint32_t>((0 > setPoint) ? -static_cast<int32_t>(setPoint) : setPoint);
+            }
+
+            if (EVALUATION_TIME <= m_elapsed)
+            {
+                evaluate();
+                isChanged = adapt();
+
+                m_isEvaluating = false;
+            }
+        }
+    }
+    else
+    {
+        int32_t jump = static_cast<int32_t>(setPoint) - static_cast<int32_t>(m_lastSetPoint);
+        int32_t step = static_cast<int32_t>(setPoint) - static_cast<int32_t>(speed);
+
+        /* Only a set point jump is a step. A wheel, which doesn't reach a constant set point, is none. */
+        if ((0 != setPoint) && ((STEP_MIN <= jump) || (-STEP_MIN >= jump)) &&
+            ((STEP_MIN <= step) || (-STEP_MIN >= step)))
+        {
+            m_isEvaluating = true;
+            m_start        = speed;
+            m_target       = setPoint;
+            m_elapsed      = 0U;
+            m_riseTime     = 0U;
+            m_peak         = 0;
+            m_errorSum     = 0U;
+            m_setPointSum  = 0U;
+        }
+    }
+
+    m_lastSetPoint = setPoint;
+
+    return isChanged;
+}
+
+void WheelTuner::save(Snapshot& snapshot) const
+{
+    (void)snapshot.put(m_gains);
+    (void)snapshot.put(m_response);
+    (void)snapshot.put(m_numResponses);
+    (void)snapshot.put(m_lastSetPoint);
+    (void)snapshot.put(m_isEvaluating);
+    (void)snapshot.put(m_start);
+    (void)snapshot.put(m_target);
+    (void)snapshot.put(m_elapsed);
+    (void)snapshot.put(m_riseTime);
+    (void)snapshot.put(m_peak);
+    (void)snapshot.put(m_errorSum);
+    (void)snapshot.put(m_setPointSum);
+}
+
+void WheelTuner::restore(Snapshot& snapshot)
+{
+    (void)snapshot.get(m_gains);
+    (void)snapshot.get(m_response);
+    (void)snapshot.get(m_numResponses);
+    (void)snapshot.get(m_lastSetPoint);
+    (void)snapshot.get(m_isEvaluating);
+    (void)snapshot.get(m_start);
+    (void)snapshot.get(m_target);
+    (void)snapshot.get(m_elapsed);
+    (void)snapshot.get(m_riseTime);
+    (void)snapshot.get(m_peak);
+    (void)snapshot.get(m_errorSum);
+    (void)snapshot.get(m_setPointSum);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void WheelTuner::limit(Gains& gains)
+{
+    gains.pDivisor = constrain(gains.pDivisor, P_DIVISOR_MIN, P_DIVISOR_MAX);
+    gains.iDivisor = constrain(gains.iDivisor, I_DIVISOR_MIN, I_DIVISOR_MAX);
+}
+
+void WheelTuner::evaluate()
+{
+    int32_t  step      = static_cast<int32_t>(m_target) - static_cast<int32_t>(m_start);
+    uint32_t stepSize  = static_cast<uint32_t>((0 > step) ? -step : step);
+    uint32_t overshoot = (static_cast<uint32_t>(m_peak) * 1000U) / stepSize;
+    uint32_t error     = 0U;
+
+    /* Keep the permille calculation in 32 bit. */
+    while ((UINT32_MAX / 1000U) < m_errorSum)
+    {
+        m_errorSum >>= 1U;
+        m_setPointSum >>= 1U;
+    }
+
+    if (0U < m_setPointSum)
+    {
+        error = (m_errorSum * 1000U) / m_setPointSum;
+    }
+
+    m_response.riseTime         = (0U == m_riseTime) ? m_elapsed : m_riseTime;
+    m_response.overshoot        = static_cast<uint16_t>((UINT16_MAX < overshoot) ? UINT16_MAX : overshoot);
+    m_response.steadyStateError = static_cast<uint16_t>((UINT16_MAX < error) ? UINT16_MAX : error);
+
+    if (UINT16_MAX > m_numResponses)
+    {
+        ++m_numResponses;
+    }
+}
+
+bool WheelTuner::adapt()
+{
+    Gains gains          = m_gains;
+    bool  isOvershooting = (OVERSHOOT_MAX < m_response.overshoot);
+    bool  isInaccurate   = (STEADY_STATE_ERROR_MAX < m_response.steadyStateError);
+    bool  isChanged      = false;
+
+    /* A higher divisor is a lower gain. */
+    if (true == isOvershooting)
+    {
+        ++gains.pDivisor;
+
+        if (false == isInaccurate)
+        {
+            gains.iDivisor += I_DIVISOR_NOTCH;
+        }
+    }
+    else
+    {
+        if (RISE_TIME_MAX < m_response.riseTime)
+        {
+            --gains.pDivisor;
+        }
+
+        if (true == isInaccurate)
+        {
+            gains.iDivisor -= I_DIVISOR_NOTCH;
+        }
+    }
+
+    limit(gains);
+
+    if ((gains.pDivisor != m_gains.pDivisor) || (gains.iDivisor != m_gains.iDivisor))
+    {
+        m_gains   = gains;
+        isChanged = true;
+    }
+
+    return isChanged;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,257 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Online tuner of a wheel speed controller
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Service
+ *
+ * @{
+ */
+
+#ifndef WHEELTUNER_H
+#define WHEELTUNER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <Snapshot.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Adapts the proportional and integral gain of a wheel speed controller
+ * during normal driving.
+ *
+ * Every set point step of at least STEP_MIN is observed as step response for
+ * EVALUATION_TIME, as long as the set point stays near the step target:
+ * - The rise time until the speed reached 90 % of the step.
+ * - The overshoot of the speed above the set point, relative to the step.
+ * - The steady-state error after SETTLE_TIME, relative to the set point.
+ *
+ * After every evaluated step response the gains are changed by one notch only,
+ * so a single disturbed response has little effect. The gains always stay in
+ * safe bounds around the default gains.
+ */
+class WheelTuner
+{
+public:
+    /** Wheel speed controller gains. Every gain is 1 / divisor, which keeps the controller calculation in 16 bit. */
+    struct Gains
+    {
+        int16_t pDivisor; /**< Proportional gain divisor */
+        int16_t iDivisor; /**< Integral gain divisor */
+    };
+
+    /** Measured step response. */
+    struct Response
+    {
+        uint16_t riseTime;         /**< Rise time in ms. */
+        uint16_t overshoot;        /**< Overshoot in permille of the step. */
+        uint16_t steadyStateError; /**< Mean steady-state error in permille of the set point. */
+    };
+
+    /** Default proportional gain divisor. */
+    static const int16_t P_DIVISOR_DEFAULT = 10;
+
+    /** Min. proportional gain divisor, which is the max. gain. */
+    static const int16_t P_DIVISOR_MIN = 5;
+
+    /** Max. proportional gain divisor, which is the min. gain. */
+    static const int16_t P_DIVISOR_MAX = 20;
+
+    /** Default integral gain divisor. */
+    static const int16_t I_DIVISOR_DEFAULT = 100;
+
+    /** Min. integral gain divisor, which is the max. gain. */
+    static const int16_t I_DIVISOR_MIN = 50;
+
+    /** Max. integral gain divisor, which is the min. gain. */
+    static const int16_t I_DIVISOR_MAX = 200;
+
+    /** Change of the integral gain divisor per adaptation. */
+    static const int16_t I_DIVISOR_NOTCH = 5;
+
+    /** Min. set point step in steps/s, which is evaluated. */
+    static const int16_t STEP_MIN = 400;
+
+    /** Max. deviation of the set point from the step target in permille of the step, during the evaluation. */
+    static const int32_t SET_POINT_TOLERANCE = 100;
+
+    /** Duration in ms after the step, when the steady-state error is measured. */
+    static const uint16_t SETTLE_TIME = 300U;
+
+    /** Duration in ms of a step response evaluation. */
+    static const uint16_t EVALUATION_TIME = 500U;
+
+    /** Max. rise time in ms, above the proportional gain is increased. */
+    static const uint16_t RISE_TIME_MAX = 150U;
+
+    /** Max. overshoot in permille, above the gains are decreased. */
+    static const uint16_t OVERSHOOT_MAX = 100U;
+
+    /** Max. steady-state error in permille, above the integral gain is increased. */
+    static const uint16_t STEADY_STATE_ERROR_MAX = 30U;
+
+    /**
+     * Constructs the tuner with the default gains.
+     */
+    WheelTuner();
+
+    /**
+     * Destroys the tuner.
+     */
+    ~WheelTuner()
+    {
+    }
+
+    /**
+     * Get the default gains.
+     *
+     * @return Default gains
+     */
+    static Gains getDefaultGains();
+
+    /**
+     * Set the gains, e.g. restored from persistent storage. They are limited
+     * to the bounds. A running evaluation is aborted.
+     *
+     * @param[in] gains Gains
+     */
+    void setGains(const Gains& gains);
+
+    /**
+     * Get the current gains.
+     *
+     * @return Gains
+     */
+    const Gains& getGains() const
+    {
+        return m_gains;
+    }
+
+    /**
+     * Abort a running evaluation, e.g. if the controller was reset.
+     */
+    void reset();
+
+    /**
+     * Observe the wheel speed control once per control period.
+     *
+     * @param[in] setPoint  Speed set point in steps/s
+     * @param[in] speed     Measured speed in steps/s
+     * @param[in] period    Control period in ms
+     *
+     * @return If the gains changed, it will return true otherwise false.
+     */
+    bool process(int16_t setPoint, int16_t speed, uint32_t period);
+
+    /**
+     * Get the last evaluated step response.
+     *
+     * @return Step response
+     */
+    const Response& getResponse() const
+    {
+        return m_response;
+    }
+
+    /**
+     * Get the number of evaluated step responses.
+     *
+     * @return Number of step responses
+     */
+    uint16_t getNumResponses() const
+    {
+        return m_numResponses;
+    }
+
+    /**
+     * Save the gains and the evaluation state to a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void save(Snapshot& snapshot) const;
+
+    /**
+     * Restore the gains and the evaluation state from a snapshot.
+     *
+     * @param[in] snapshot  Snapshot
+     */
+    void restore(Snapshot& snapshot);
+
+private:
+    Gains    m_gains;        /**< Current gains */
+    Response m_response;     /**< Last evaluated step response */
+    uint16_t m_numResponses; /**< Number of evaluated step responses, saturated. */
+    int16_t  m_lastSetPoint; /**< Set point of the last control period in steps/s */
+    bool     m_isEvaluating; /**< Is a step response evaluated? */
+    int16_t  m_start;        /**< Speed at the step in steps/s */
+    int16_t  m_target;       /**< Set point after the step in steps/s */
+    uint16_t m_elapsed;      /**< Elapsed time since the step in ms */
+    uint16_t m_riseTime;     /**< Rise time in ms, 0 if not reached yet. */
+    int32_t  m_peak;         /**< Max. speed above the set point in steps/s */
+    uint32_t m_errorSum;     /**< Sum of the absolute errors after the settle time in steps/s */
+    uint32_t m_setPointSum;  /**< Sum of the absolute set points after the settle time in steps/s */
+
+    /**
+     * Limit the gains to the bounds.
+     *
+     * @param[in,out] gains Gains
+     */
+    static void limit(Gains& gains);
+
+    /**
+     * Calculate the step response of the finished evaluation.
+     */
+    void evaluate();
+
+    /**
+     * Adapt the gains by one notch, depended on the last step response.
+     *
+     * @return If the gains changed, it will return true otherwise false.
+     */
+    bool adapt();
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* WHEELTUNER_H */
+/** @} */
@@ -0,0 +1,392 @@
+""" Fit drive models to captured system identification samples and suggest controller gains """
+
+# MIT License
+#
+# Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+# Usage:
+#   python scripts/sysid_fit.py <log file> [--max-speed <steps/s>] [--lambda <s>]
+#
+# The log file is the serial output of the LineFollower system identification
+# ("SYSID_CFG,..." and "SYSID,..." lines, any other line is ignored) or a CSV
+# file with the columns timestamp, pwm, delta left and delta right, e.g. decoded
+# from the RemoteControl "SYSID" channel.
+
+################################################################################
+# Imports
+################################################################################
+import argparse
+import math
+import sys
+from fractions import Fraction
+
+################################################################################
+# Variables
+################################################################################
+
+MODE_LINEAR     = 0
+MODE_ROTATION   = 1
+
+# Max. motor PWM in digits (Zumo32U4).
+MAX_PWM         = 400
+
+# Differential drive control period in ms.
+CONTROL_PERIOD  = 5
+
+################################################################################
+# Classes
+################################################################################
+
+class Capture:
+    """Captured system identification run."""
+
+    def __init__(self):
+        self.mode           = MODE_LINEAR
+        self.sample_period  = None
+        self.timestamps     = []
+        self.pwm            = []
+        self.delta_left     = []
+        self.delta_right    = []
+
+    def add_sample(self, timestamp, pwm, delta_left, delta_right):
+        """Add a sample.
+
+        Args:
+            timestamp (int): Time since start of the run in ms, when the PWM was applied.
+            pwm (int): Applied PWM of the left motor in digits.
+            delta_left (int): Left encoder steps while the PWM was applied.
+            delta_right (int): Right encoder steps while the PWM was applied.
+        """
+        self.timestamps.append(timestamp)
+        self.pwm.append(pwm)
+        self.delta_left.append(delta_left)
+        self.delta_right.append(delta_right)
+
+    def get_period(self):
+        """Get the mean sample period in s."""
+        if self.sample_period is not None:
+            return self.sample_period / 1000.0
+
+        return (self.timestamps[-1] - self.timestamps[0]) / (1000.0 * (len(self.timestamps) - 1))
+
+    def get_speeds(self):
+        """Get the measured speed per sample in steps/s. In rotation mode the
+        right motor turns backwards, so its steps are negated.
+        """
+        speeds = []
+        period = self.get_period()
+
+        for idx, timestamp in enumerate(self.timestamps):
+            if (idx + 1) < len(self.timestamps):
+                duration = (self.timestamps[idx + 1] - timestamp) / 1000.0
+            else:
+                duration = period
+
+            if self.mode == MODE_ROTATION:
+                steps = (self.delta_left[idx] - self.delta_right[idx]) / 2.0
+            else:
+                steps = (self.delta_left[idx] + self.delta_right[idx]) / 2.0
+
+            speeds.append(steps / duration if duration > 0 else 0.0)
+
+        return speeds
+
+################################################################################
+# Functions
+################################################################################
+
+def parse_capture(file_name):
+    """Parse the captured samples from a log or CSV file.
+
+    Args:
+        file_name (str): Name of the file.
+
+    Returns:
+        Capture: Captured samples
+    """
+    capture = Capture()
+
+    with open(file_name, 'r', encoding="utf-8", errors="ignore") as fd:
+        for line in fd:
+            line = line.strip()
+
+            if 'SYSID_CFG,' in line:
+                fields = line[line.index('SYSID_CFG,'):].split(',')
+                capture.mode            = int(fields[2])
+                capture.sample_period   = int(fields[3])
+
+            elif 'SYSID,' in line:
+                fields = line[line.index('SYSID,'):].split(',')
+                capture.add_sample(int(fields[2]), int(fields[3]), int(fields[4]), int(fields[5]))
+
+            else:
+                fields = line.split(',')
+
+                if len(fields) == 4:
+                    try:
+                        capture.add_sample(*[int(field) for field in fields])
+                    except ValueError:
+                        pass # Header line
+
+    return capture
+
+def solve(matrix, vector):
+    """Solve the linear equation system by Gaussian elimination with pivoting.
+
+    Args:
+        matrix (list): Square matrix
+        vector (list): Right hand side
+
+    Returns:
+        list: Solution
+    """
+    size    = len(vector)
+    rows    = [list(matrix[idx]) + [vector[idx]] for idx in range(size)]
+
+    for col in range(size):
+        pivot = max(range(col, size), key=lambda row: abs(rows[row][col]))
+
+        if abs(rows[pivot][col]) < 1e-12:
+            raise ValueError("Excitation is not sufficient, the equation system is singular.")
+
+        rows[col], rows[pivot] = rows[pivot], rows[col]
+
+        for row in range(col + 1, size):
+            factor = rows[row][col] / rows[col][col]
+            for idx in range(col, size + 1):
+                rows[row][idx] -= factor * rows[col][idx]
+
+    solution = [0.0] * size
+
+    for row in reversed(range(size)):
+        acc = rows[row][size] - sum(rows[row][idx] * solution[idx] for idx in range(row + 1, size))
+        solution[row] = acc / rows[row][row]
+
+    return solution
+
+def least_squares(regressors, targets):
+    """Least squares fit via the normal equations.
+
+    Args:
+        regressors (list): One regressor row per target.
+        targets (list): Targets
+
+    Returns:
+        list: Parameters
+    """
+    size    = len(regressors[0])
+    matrix  = [[sum(row[i] * row[j] for row in regressors) for j in range(size)] for i in range(size)]
+    vector  = [sum(row[i] * target for row, target in zip(regressors, targets)) for i in range(size)]
+
+    return solve(matrix, vector)
+
+def fit_first_order(pwm, speeds):
+    """Fit y[k] = a * y[k-1] + b * u[k] + c.
+
+    Returns:
+        list: Parameters a, b, c
+    """
+    regressors  = [[speeds[k - 1], pwm[k], 1.0] for k in range(1, len(speeds))]
+    targets     = speeds[1:]
+
+    return least_squares(regressors, targets)
+
+def fit_second_order(pwm, speeds):
+    """Fit y[k] = a1 * y[k-1] + a2 * y[k-2] + b1 * u[k] + b2 * u[k-1] + c.
+
+    Returns:
+        list: Parameters a1, a2, b1, b2, c
+    """
+    regressors  = [[speeds[k - 1], speeds[k - 2], pwm[k], pwm[k - 1], 1.0] for k in range(2, len(speeds))]
+    targets     = speeds[2:]
+
+    return least_squares(regressors, targets)
+
+def simulate(params, pwm, speeds):
+    """Simulate the model free-running from the measured initial values.
+
+    Args:
+        params (list): Model parameters of the first or second order model.
+        pwm (list): Applied PWM
+        speeds (list): Measured speeds, only the initial values are used.
+
+    Returns:
+        list: Simulated speeds
+    """
+    simulated = list(speeds[:2])
+
+    for k in range(2, len(pwm)):
+        if len(params) == 3:
+            value = params[0] * simulated[k - 1] + params[1] * pwm[k] + params[2]
+        else:
+            value = params[0] * simulated[k - 1] + params[1] * simulated[k - 2] + \
+                    params[2] * pwm[k] + params[3] * pwm[k - 1] + params[4]
+        simulated.append(value)
+
+    return simulated
+
+def fit_quality(measured, simulated):
+    """Normalized root mean square fit in percent, 100 % is a perfect fit."""
+    mean    = sum(measured) / len(measured)
+    error   = math.sqrt(sum((m - s) ** 2 for m, s in zip(measured, simulated)))
+    spread  = math.sqrt(sum((m - mean) ** 2 for m in measured))
+
+    return 100.0 * (1.0 - error / spread) if spread > 0 else 0.0
+
+def as_fraction(value):
+    """Express a factor as numerator / denominator, like the PID factors in the code."""
+    fraction = Fraction(value).limit_denominator(1000)
+
+    return f"{fraction.numerator} / {fraction.denominator}"
+
+def report_first_order(params, period, quality):
+    """Report the first order model and return its gain and time constant."""
+    a, b, c = params
+
+    if (a <= 0.0) or (a >= 1.0):
+        print(f"First order: pole a = {a:.4f} is not stable/physical, the fit is not usable.")
+        return None, None
+
+    gain    = b / (1.0 - a)
+    tau     = -period / math.log(a)
+    offset  = c / (1.0 - a)
+
+    print("First order model: y[k] = a * y[k-1] + b * u[k] + c")
+    print(f"  a = {a:.5f}, b = {b:.5f}, c = {c:.3f}")
+    print(f"  Gain K = {gain:.3f} (steps/s) / digit")
+    print(f"  Time constant tau = {tau * 1000.0:.1f} ms")
+    print(f"  Friction offset = {offset:.1f} steps/s")
+    print(f"  Fit = {quality:.1f} %")
+
+    return gain, tau
+
+def report_second_order(params, period, quality):
+    """Report the second order model."""
+    a1, a2, b1, b2, c = params
+    denominator = 1.0 - a1 - a2
+
+    print("Second order model: y[k] = a1 * y[k-1] + a2 * y[k-2] + b1 * u[k] + b2 * u[k-1] + c")
+    print(f"  a1 = {a1:.5f}, a2 = {a2:.5f}, b1 = {b1:.5f}, b2 = {b2:.5f}, c = {c:.3f}")
+
+    if abs(denominator) > 1e-9:
+        print(f"  Gain K = {(b1 + b2) / denominator:.3f} (steps/s) / digit")
+
+    # Poles are the roots of z^2 - a1 z - a2.
+    discriminant = a1 * a1 + 4.0 * a2
+
+    if discriminant >= 0.0:
+        poles = [(a1 + math.sqrt(discriminant)) / 2.0, (a1 - math.sqrt(discriminant)) / 2.0]
+
+        for pole in poles:
+            if 0.0 < pole < 1.0:
+                print(f"  Real pole z = {pole:.4f}, time constant = {-period / math.log(pole) * 1000.0:.1f} ms")
+            else:
+                print(f"  Real pole z = {pole:.4f}")
+    else:
+        radius  = math.sqrt(-a2)
+        angle   = math.atan2(math.sqrt(-discriminant), a1)
+        sigma   = math.log(radius) / period
+        omega   = angle / period
+        omega_n = math.sqrt(sigma * sigma + omega * omega)
+
+        print(f"  Complex poles, natural frequency = {omega_n / (2.0 * math.pi):.2f} Hz, "
+              f"damping = {-sigma / omega_n:.3f}")
+
+    print(f"  Fit = {quality:.1f} %")
+
+def report_gains(gain, tau, max_speed, closed_loop_tau):
+    """Suggest speed controller gains by lambda tuning of a PI controller.
+
+    The differential drive adds the PID output to its last output, so its
+    P factor acts as integral gain and its D factor as proportional gain.
+
+    Args:
+        gain (float): Plant gain in (steps/s) / digit.
+        tau (float): Plant time constant in s.
+        max_speed (float): Calibrated max. motor speed in steps/s.
+        closed_loop_tau (float): Desired closed loop time constant in s.
+    """
+    # The controller output in steps/s is scaled to PWM by max. PWM / max. speed.
+    plant_gain  = gain * MAX_PWM / max_speed
+    kp          = tau / (plant_gain * closed_loop_tau)
+    ki          = kp / tau
+    period_ms   = CONTROL_PERIOD
+
+    print(f"Speed controller (lambda tuning, closed loop tau = {closed_loop_tau * 1000.0:.1f} ms):")
+    print(f"  Max. motor speed = {max_speed:.0f} steps/s, plant gain seen by the controller = {plant_gain:.3f}")
+    print(f"  PI: Kp = {kp:.4f}, Ki = {ki:.3f} 1/s")
+    print(f"  DifferentialDrive with {period_ms} ms control period:")
+    print(f"    PID_P = {as_fraction(ki * period_ms / 1000.0)} (integral action)")
+    print(f"    PID_I = 0 / 1")
+    print(f"    PID_D = {as_fraction(kp * period_ms)} (proportional action)")
+
+def main():
+    """The program entry point function."""
+    parser = argparse.ArgumentParser(description="Fit drive models to system identification samples.")
+    parser.add_argument("file", help="Serial log or CSV file with the captured samples.")
+    parser.add_argument("--mode", type=int, choices=[MODE_LINEAR, MODE_ROTATION], default=None,
+                        help="Excited motion, if not in the file: 0 = linear, 1 = rotation.")
+    parser.add_argument("--max-speed", type=float, default=None,
+                        help="Calibrated max. motor speed in steps/s. Default: Derived from the model.")
+    parser.add_argument("--lambda", dest="closed_loop_tau", type=float, default=None,
+                        help="Desired closed loop time constant in s. Default: Plant time constant.")
+    args = parser.parse_args()
+
+    capture = parse_capture(args.file)
+
+    if args.mode is not None:
+        capture.mode = args.mode
+
+    if len(capture.timestamps) < 10:
+        print("Not enough samples found.")
+        return 1
+
+    period  = capture.get_period()
+    speeds  = capture.get_speeds()
+    pwm     = [float(value) for value in capture.pwm]
+
+    print(f"{len(speeds)} samples, sample period {period * 1000.0:.1f} ms, "
+          f"{'rotation' if capture.mode == MODE_ROTATION else 'linear'} mode")
+    print()
+
+    params  = fit_first_order(pwm, speeds)
+    gain, tau = report_first_order(params, period, fit_quality(speeds, simulate(params, pwm, speeds)))
+    print()
+
+    params  = fit_second_order(pwm, speeds)
+    report_second_order(params, period, fit_quality(speeds, simulate(params, pwm, speeds)))
+    print()
+
+    if gain is not None:
+        max_speed       = args.max_speed if args.max_speed is not None else gain * MAX_PWM
+        closed_loop_tau = args.closed_loop_tau if args.closed_loop_tau is not None else tau
+
+        report_gains(gain, tau, max_speed, closed_loop_tau)
+
+    return 0
+
+################################################################################
+# Main
+################################################################################
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,227 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <BreadcrumbTrail.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Number of delta encoded breadcrumbs in one test path frame. */
+#define TEST_DELTAS_PER_FRAME (3U)
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Breadcrumb, relative to the previous one. */
+typedef struct _TestDelta
+{
+    int8_t  xPos;        /**< X position delta [mm]. */
+    int8_t  yPos;        /**< Y position delta [mm]. */
+    int16_t orientation; /**< Orientation delta [mrad]. */
+} TestDelta;
+
+/** Path frame, like the one of the application protocol. */
+typedef struct _TestFrame
+{
+    uint16_t  sequenceNumber;                /**< Sequence number of the first breadcrumb. */
+    uint8_t   count;                         /**< Number of valid breadcrumbs in the frame. */
+    int32_t   xPos;                          /**< X position of the first breadcrumb [mm]. */
+    int32_t   yPos;                          /**< Y position of the first breadcrumb [mm]. */
+    int32_t   orientation;                   /**< Orientation of the first breadcrumb [mrad]. */
+    TestDelta deltas[TEST_DELTAS_PER_FRAME]; /**< Following breadcrumbs. */
+} TestFrame;
+
+/** Breadcrumb trail with the test path frame. */
+typedef BreadcrumbTrail<TestFrame, TEST_DELTAS_PER_FRAME> TestTrail;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testFullFrame();
+static void testFlush();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testFullFrame);
+    RUN_TEST(testFlush);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test that a path frame is completed, when it is full.
+ */
+static void testFullFrame()
+{
+    TestTrail trail;
+    TestFrame frame;
+    uint32_t  mileage = 0U;
+    uint8_t   idx     = 0U;
+
+    /* Only the first breadcrumb is dropped at the start, the next one after the sample distance. */
+    trail.process(mileage, 100, 200, 0);
+    trail.process(mileage + 1U, 101, 200, 0);
+    TEST_ASSERT_FALSE(trail.getFrame(frame));
+
+    while (TEST_DELTAS_PER_FRAME > idx)
+    {
+        mileage += TestTrail::SAMPLE_DISTANCE;
+        trail.process(mileage, 100 + static_cast<int32_t>(mileage), 200, 10);
+        ++idx;
+    }
+
+    TEST_ASSERT_TRUE(trail.getFrame(frame));
+    TEST_ASSERT_FALSE(trail.getFrame(frame));
+    TEST_ASSERT_EQUAL_UINT16(0U, frame.sequenceNumber);
+    TEST_ASSERT_EQUAL_UINT8(TestTrail::MAX_BREADCRUMBS, frame.count);
+    TEST_ASSERT_EQUAL_INT32(100, frame.xPos);
+    TEST_ASSERT_EQUAL_INT32(200, frame.yPos);
+    TEST_ASSERT_EQUAL_INT8(TestTrail::SAMPLE_DISTANCE, frame.deltas[0U].xPos);
+    TEST_ASSERT_EQUAL_INT8(0, frame.deltas[0U].yPos);
+    TEST_ASSERT_EQUAL_INT16(10, frame.deltas[0U].orientation);
+    TEST_ASSERT_EQUAL_INT16(0, frame.deltas[1U].orientation);
+}
+
+/**
+ * Test that the trailing breadcrumbs are published, when the path frame is flushed.
+ */
+static void testFlush()
+{
+    TestTrail trail;
+    TestFrame frame;
+
+    /* Nothing to flush. */
+    trail.flush();
+    TEST_ASSERT_FALSE(trail.getFrame(frame));
+
+    trail.process(0U, 0, 0, 0);
+    trail.process(TestTrail::SAMPLE_DISTANCE, 20, 0, 0);
+    TEST_ASSERT_FALSE(trail.getFrame(frame));
+
+    /* The robot stops, the partial frame shall be completed. */
+    trail.flush();
+    TEST_ASSERT_TRUE(trail.getFrame(frame));
+    TEST_ASSERT_EQUAL_UINT16(0U, frame.sequenceNumber);
+    TEST_ASSERT_EQUAL_UINT8(2U, frame.count);
+    TEST_ASSERT_EQUAL_INT8(20, frame.deltas[0U].xPos);
+    TEST_ASSERT_EQUAL_INT8(0, frame.deltas[1U].xPos);
+    TEST_ASSERT_EQUAL_INT8(0, frame.deltas[2U].xPos);
+
+    /* A flushed frame is sent only once. */
+    trail.flush();
+    TEST_ASSERT_FALSE(trail.getFrame(frame));
+
+    /* The next breadcrumb starts a new frame with an absolute one, the numbering continues. */
+    trail.process(2U * TestTrail::SAMPLE_DISTANCE, 40, 0, 0);
+    trail.flush();
+    TEST_ASSERT_TRUE(trail.getFrame(frame));
+    TEST_ASSERT_EQUAL_UINT16(2U, frame.sequenceNumber);
+    TEST_ASSERT_EQUAL_UINT8(1U, frame.count);
+    TEST_ASSERT_EQUAL_INT32(40, frame.xPos);
+}
@@ -0,0 +1,353 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <stdio.h>
+#include <Checkpoint.h>
+#include <SimpleTimer.h>
+#include <LineSensorNormalizer.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Application, whose state is checkpointed like the one of the line follower:
+ * line sensor calibration, selected parameter set and a running timer.
+ */
+class TestApp
+{
+public:
+    /** Number of line sensors. */
+    static const uint8_t NUM_SENSORS = 3U;
+
+    LineSensorNormalizer<NUM_SENSORS> m_normalizer;    /**< Line sensor calibration */
+    uint8_t                           m_parameterSetId; /**< Selected parameter set */
+    SimpleTimer                       m_timer;          /**< Running timer */
+
+    /**
+     * Constructs the application in the state after its setup.
+     */
+    TestApp() : m_normalizer(), m_parameterSetId(0U), m_timer()
+    {
+    }
+
+    /**
+     * Destroys the application.
+     */
+    ~TestApp()
+    {
+    }
+
+    /**
+     * Save the application state.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] userData  Application
+     *
+     * @return If successful saved, it will return true otherwise false.
+     */
+    static bool onSave(Snapshot& snapshot, void* userData)
+    {
+        const TestApp* app = static_cast<const TestApp*>(userData);
+        uint8_t        idx = 0U;
+
+        for (idx = 0U; idx < NUM_SENSORS; ++idx)
+        {
+            (void)snapshot.put(app->m_normalizer.getMinValue(idx));
+            (void)snapshot.put(app->m_normalizer.getMaxValue(idx));
+        }
+
+        (void)snapshot.put(app->m_parameterSetId);
+        app->m_timer.save(snapshot);
+
+        return snapshot.isValid();
+    }
+
+    /**
+     * Restore the application state.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] userData  Application
+     *
+     * @return If successful restored, it will return true otherwise false.
+     */
+    static bool onRestore(Snapshot& snapshot, void* userData)
+    {
+        TestApp* app = static_cast<TestApp*>(userData);
+        uint16_t minValues[NUM_SENSORS];
+        uint16_t maxValues[NUM_SENSORS];
+        uint8_t  idx = 0U;
+
+        for (idx = 0U; idx < NUM_SENSORS; ++idx)
+        {
+            (void)snapshot.get(minValues[idx]);
+            (void)snapshot.get(maxValues[idx]);
+        }
+
+        app->m_normalizer.setCalibration(minValues, maxValues);
+        (void)snapshot.get(app->m_parameterSetId);
+        app->m_timer.restore(snapshot);
+
+        return snapshot.isValid();
+    }
+
+    /**
+     * Restore only a part of the application state, like an application,
+     * which doesn't fit to the checkpoint.
+     *
+     * @param[in] snapshot  Snapshot
+     * @param[in] userData  Application
+     *
+     * @return If successful restored, it will return true otherwise false.
+     */
+    static bool onRestorePartial(Snapshot& snapshot, void* userData)
+    {
+        TestApp* app = static_cast<TestApp*>(userData);
+        uint16_t value = 0U;
+
+        (void)app;
+        (void)snapshot.get(value);
+
+        return snapshot.isValid();
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void saveCheckpoint(TestApp& app);
+static void testRoundTrip();
+static void testOversizedFile();
+static void testUnreadData();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Name of the checkpoint file. */
+static const char* CHECKPOINT_FILE_NAME = "test_checkpoint.bin";
+
+/** Simulation time in ms, when the checkpoint is saved. */
+static const uint32_t CHECKPOINT_TIME = 100U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testRoundTrip);
+    RUN_TEST(testOversizedFile);
+    RUN_TEST(testUnreadData);
+
+    (void)remove(CHECKPOINT_FILE_NAME);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Calibrate the application, select a parameter set and save a checkpoint.
+ *
+ * @param[in] app   Application
+ */
+static void saveCheckpoint(TestApp& app)
+{
+    const uint16_t WHITE[TestApp::NUM_SENSORS] = {100U, 120U, 90U};
+    const uint16_t BLACK[TestApp::NUM_SENSORS] = {900U, 850U, 950U};
+    Checkpoint&    checkpoint                  = Checkpoint::getInstance();
+
+    app.m_normalizer.calibrate(WHITE);
+    app.m_normalizer.calibrate(BLACK);
+    app.m_parameterSetId = 2U;
+    app.m_timer.start(1000U);
+
+    (void)remove(CHECKPOINT_FILE_NAME);
+    checkpoint.setCallbacks(TestApp::onSave, TestApp::onRestore, &app);
+    checkpoint.requestSave(CHECKPOINT_FILE_NAME, CHECKPOINT_TIME);
+
+    /* Not due yet. */
+    checkpoint.process(CHECKPOINT_TIME - 1U);
+    TEST_ASSERT_NULL(fopen(CHECKPOINT_FILE_NAME, "rb"));
+
+    checkpoint.process(CHECKPOINT_TIME);
+}
+
+/**
+ * Test that a checkpoint restores a freshly set up application to the saved run.
+ */
+static void testRoundTrip()
+{
+    const uint16_t RAW[TestApp::NUM_SENSORS] = {500U, 120U, 1000U};
+    TestApp        original;
+    TestApp        fork;
+    Checkpoint&    checkpoint = Checkpoint::getInstance();
+    uint32_t       timestamp  = 0U;
+    uint16_t       valuesOriginal[TestApp::NUM_SENSORS];
+    uint16_t       valuesFork[TestApp::NUM_SENSORS];
+    uint8_t        idx = 0U;
+
+    saveCheckpoint(original);
+
+    /* The fork is uncalibrated, which passes the raw values through. */
+    fork.m_normalizer.normalize(RAW, valuesFork);
+    TEST_ASSERT_EQUAL_UINT16(RAW[0U], valuesFork[0U]);
+
+    checkpoint.setCallbacks(TestApp::onSave, TestApp::onRestore, &fork);
+    TEST_ASSERT_TRUE(checkpoint.load(CHECKPOINT_FILE_NAME, timestamp));
+    TEST_ASSERT_EQUAL_UINT32(CHECKPOINT_TIME, timestamp);
+    TEST_ASSERT_TRUE(checkpoint.restore());
+
+    TEST_ASSERT_TRUE(fork.m_normalizer.isCalibrated());
+    TEST_ASSERT_EQUAL_UINT8(original.m_parameterSetId, fork.m_parameterSetId);
+    TEST_ASSERT_TRUE(fork.m_timer.isRunning());
+
+    original.m_normalizer.normalize(RAW, valuesOriginal);
+    fork.m_normalizer.normalize(RAW, valuesFork);
+
+    for (idx = 0U; idx < TestApp::NUM_SENSORS; ++idx)
+    {
+        TEST_ASSERT_EQUAL_UINT16(original.m_normalizer.getMinValue(idx), fork.m_normalizer.getMinValue(idx));
+        TEST_ASSERT_EQUAL_UINT16(original.m_normalizer.getMaxValue(idx), fork.m_normalizer.getMaxValue(idx));
+        TEST_ASSERT_EQUAL_UINT16(valuesOriginal[idx], valuesFork[idx]);
+    }
+}
+
+/**
+ * Test that a file, which exceeds the snapshot capacity, isn't loaded truncated.
+ */
+static void testOversizedFile()
+{
+    FILE*       file       = fopen(CHECKPOINT_FILE_NAME, "wb");
+    uint32_t    timestamp  = 0U;
+    size_t      idx        = 0U;
+    Checkpoint& checkpoint = Checkpoint::getInstance();
+
+    TEST_ASSERT_NOT_NULL(file);
+
+    for (idx = 0U; idx < (Snapshot::MAX_SIZE + 1U); ++idx)
+    {
+        (void)fputc(0, file);
+    }
+
+    (void)fclose(file);
+
+    TEST_ASSERT_FALSE(checkpoint.load(CHECKPOINT_FILE_NAME, timestamp));
+}
+
+/**
+ * Test that a checkpoint, which is not consumed completely, isn't restored.
+ */
+static void testUnreadData()
+{
+    TestApp     original;
+    TestApp     fork;
+    Checkpoint& checkpoint = Checkpoint::getInstance();
+    uint32_t    timestamp  = 0U;
+
+    saveCheckpoint(original);
+
+    checkpoint.setCallbacks(TestApp::onSave, TestApp::onRestorePartial, &fork);
+    TEST_ASSERT_TRUE(checkpoint.load(CHECKPOINT_FILE_NAME, timestamp));
+    TEST_ASSERT_FALSE(checkpoint.restore());
+}
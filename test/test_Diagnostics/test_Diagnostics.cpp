@@ -0,0 +1,281 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <Diagnostics.h>
+#include <Board.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Battery with a constant voltage.
+ */
+class TestBattery : public IBattery
+{
+public:
+    /** Battery voltage in mV. */
+    static const uint16_t VOLTAGE = 4800U;
+
+    /**
+     * Constructs the test battery.
+     */
+    TestBattery() : IBattery()
+    {
+    }
+
+    /**
+     * Destroys the test battery.
+     */
+    ~TestBattery()
+    {
+    }
+
+    /**
+     * Get the battery voltage.
+     *
+     * @return Battery voltage in mV
+     */
+    uint16_t getVoltage() final
+    {
+        return VOLTAGE;
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testPageCycle();
+static void testReport();
+static void showNextPage();
+static void assertPage(const char* line0, const char* line1);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Battery of the test. */
+static TestBattery gBattery;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testPageCycle);
+    RUN_TEST(testReport);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    Diagnostics::getInstance().unselectPage();
+    Diagnostics::getInstance().enable(Diagnostics::REFRESH_PERIOD);
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    Diagnostics::getInstance().disable();
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the page cycle, like the operator does it with the button.
+ * The calibration page is shown once per line sensor. After the last page,
+ * no page is selected anymore, so the state shows its own information again.
+ */
+static void testPageCycle()
+{
+    Diagnostics& diagnostics = Diagnostics::getInstance();
+    uint8_t      numSensors  = Board::getInstance().getLineSensors().getNumLineSensors();
+    uint8_t      numPages    = 0U;
+
+    TEST_ASSERT_FALSE(diagnostics.isPageSelected());
+
+    while (true == diagnostics.nextPage())
+    {
+        TEST_ASSERT_TRUE(diagnostics.isPageSelected());
+        ++numPages;
+    }
+
+    /* Loop, overruns, battery, max. speed, calibration per sensor, lap, best lap and wheel gains. */
+    TEST_ASSERT_EQUAL_UINT8(7U + numSensors, numPages);
+    TEST_ASSERT_FALSE(diagnostics.isPageSelected());
+
+    /* The cycle starts again. */
+    TEST_ASSERT_TRUE(diagnostics.nextPage());
+    diagnostics.unselectPage();
+    TEST_ASSERT_FALSE(diagnostics.isPageSelected());
+}
+
+/**
+ * Test the rendered pages.
+ */
+static void testReport()
+{
+    Diagnostics& diagnostics = Diagnostics::getInstance();
+
+    diagnostics.setLoopStatistics(1234U, 567U, 3U);
+
+    /* Nothing is rendered, as long as no page is selected. */
+    diagnostics.process();
+
+    showNextPage();
+    assertPage("Lmx 1234", "Lav  567");
+
+    /* The rendered lines are written one per call to the display. */
+    diagnostics.process();
+    diagnostics.process();
+    assertPage("Lmx 1234", "Lav  567");
+
+    showNextPage();
+    assertPage("Overrun ", "       3");
+
+    /* Without a battery, its voltage is unknown. */
+    showNextPage();
+    assertPage("Bat. mV ", "       -");
+
+    diagnostics.setBattery(gBattery);
+    diagnostics.unselectPage();
+    showNextPage();
+    showNextPage();
+    showNextPage();
+    assertPage("Bat. mV ", "    4800");
+
+    /* Skip max. speed and the calibration pages. */
+    while (0 != strncmp("Lap", diagnostics.getLine(0U), 3U))
+    {
+        showNextPage();
+    }
+
+    assertPage("Lap    0", "       -");
+
+    diagnostics.addLap(12345U);
+    diagnostics.addLap(13000U);
+    diagnostics.unselectPage();
+
+    do
+    {
+        showNextPage();
+    } while (0 != strncmp("Lap", diagnostics.getLine(0U), 3U));
+
+    assertPage("Lap    2", "   13000");
+
+    showNextPage();
+    assertPage("Best    ", "   12345");
+
+    /* An invalid line is empty. */
+    TEST_ASSERT_EQUAL_STRING("", diagnostics.getLine(Diagnostics::NUM_LINES));
+}
+
+/**
+ * Select the next page, like the button does, and render it.
+ */
+static void showNextPage()
+{
+    TEST_ASSERT_TRUE(Diagnostics::getInstance().nextPage());
+    Diagnostics::getInstance().process();
+}
+
+/**
+ * Assert the rendered lines of the selected page.
+ *
+ * @param[in] line0 Expected first line
+ * @param[in] line1 Expected second line
+ */
+static void assertPage(const char* line0, const char* line1)
+{
+    TEST_ASSERT_EQUAL_STRING(line0, Diagnostics::getInstance().getLine(0U));
+    TEST_ASSERT_EQUAL_STRING(line1, Diagnostics::getInstance().getLine(1U));
+}
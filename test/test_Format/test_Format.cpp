@@ -0,0 +1,238 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Format.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testIntegers();
+static void testFixedPoint();
+static void testFormatBuffer();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testIntegers);
+    RUN_TEST(testFixedPoint);
+    RUN_TEST(testFormatBuffer);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test integer formatting with width, padding and sign.
+ */
+static void testIntegers()
+{
+    char str[Format::MAX_VALUE_LENGTH + 1U];
+    char shortStr[4U];
+
+    TEST_ASSERT_EQUAL(1U, Format::uintToStr(str, sizeof(str), 0U));
+    TEST_ASSERT_EQUAL_STRING("0", str);
+    TEST_ASSERT_EQUAL(10U, Format::uintToStr(str, sizeof(str), UINT32_MAX));
+    TEST_ASSERT_EQUAL_STRING("4294967295", str);
+    TEST_ASSERT_EQUAL(5U, Format::uintToStr(str, sizeof(str), 42U, 5U));
+    TEST_ASSERT_EQUAL_STRING("   42", str);
+    TEST_ASSERT_EQUAL(5U, Format::uintToStr(str, sizeof(str), 42U, 5U, '0'));
+    TEST_ASSERT_EQUAL_STRING("00042", str);
+
+    TEST_ASSERT_EQUAL(11U, Format::intToStr(str, sizeof(str), INT32_MIN));
+    TEST_ASSERT_EQUAL_STRING("-2147483648", str);
+    TEST_ASSERT_EQUAL(5U, Format::intToStr(str, sizeof(str), -42, 5U));
+    TEST_ASSERT_EQUAL_STRING("  -42", str);
+    TEST_ASSERT_EQUAL(5U, Format::intToStr(str, sizeof(str), -42, 5U, '0'));
+    TEST_ASSERT_EQUAL_STRING("-0042", str);
+    TEST_ASSERT_EQUAL(3U, Format::intToStr(str, sizeof(str), 42, 0U, ' ', true));
+    TEST_ASSERT_EQUAL_STRING("+42", str);
+
+    /* A too small buffer cuts the end. */
+    TEST_ASSERT_EQUAL(3U, Format::uintToStr(shortStr, sizeof(shortStr), 123456U));
+    TEST_ASSERT_EQUAL_STRING("123", shortStr);
+}
+
+/**
+ * Test fixed-point formatting.
+ */
+static void testFixedPoint()
+{
+    char str[Format::MAX_VALUE_LENGTH + 1U];
+
+    (void)Format::fixedToStr(str, sizeof(str), -1234, 2U);
+    TEST_ASSERT_EQUAL_STRING("-12.34", str);
+    (void)Format::fixedToStr(str, sizeof(str), -5, 2U);
+    TEST_ASSERT_EQUAL_STRING("-0.05", str);
+    (void)Format::fixedToStr(str, sizeof(str), 0, 1U);
+    TEST_ASSERT_EQUAL_STRING("0.0", str);
+    (void)Format::fixedToStr(str, sizeof(str), 5, 3U, 7U, '0');
+    TEST_ASSERT_EQUAL_STRING("000.005", str);
+    (void)Format::fixedToStr(str, sizeof(str), INT32_MIN, Format::MAX_DECIMALS);
+    TEST_ASSERT_EQUAL_STRING("-2.147483648", str);
+    (void)Format::fixedToStr(str, sizeof(str), 123, 0U);
+    TEST_ASSERT_EQUAL_STRING("123", str);
+}
+
+/**
+ * Test the format buffer.
+ */
+static void testFormatBuffer()
+{
+    FormatBuffer<16U> buffer;
+
+    (void)buffer.add("x=").add(static_cast<int16_t>(-7), 4U).add(',').addFixed(1234, 1U);
+    TEST_ASSERT_EQUAL_STRING("x=  -7,123.4", buffer.getString());
+    TEST_ASSERT_EQUAL(12U, buffer.getLength());
+    TEST_ASSERT_FALSE(buffer.isTruncated());
+
+    /* The buffer keeps its termination, if it is full. */
+    (void)buffer.add("abcdef");
+    TEST_ASSERT_EQUAL_STRING("x=  -7,123.4abc", buffer.getString());
+    TEST_ASSERT_EQUAL(15U, buffer.getLength());
+    TEST_ASSERT_TRUE(buffer.isTruncated());
+
+    buffer.clear();
+    TEST_ASSERT_EQUAL_STRING("", buffer.getString());
+    TEST_ASSERT_FALSE(buffer.isTruncated());
+
+    /* Width beyond a single value. */
+    (void)buffer.add(static_cast<uint8_t>(7U), 14U, '0');
+    TEST_ASSERT_EQUAL_STRING("00000000000007", buffer.getString());
+
+    /* String in program memory. */
+    {
+        static const char FLASH_STR[] PROGMEM = "flash";
+
+        buffer.clear();
+        (void)buffer.add(reinterpret_cast<const __FlashStringHelper*>(FLASH_STR)).add('!');
+        TEST_ASSERT_EQUAL_STRING("flash!", buffer.getString());
+    }
+
+    /* Every unsigned type, like size_t, shall be accepted without a cast. */
+    buffer.clear();
+    (void)buffer.add(sizeof(uint32_t)).add(',').add(7UL).add(',').add(0xFFFFFFFFFFULL);
+    TEST_ASSERT_EQUAL_STRING("4,7,4294967295", buffer.getString());
+
+    /* The last character is never cut. */
+    buffer.clear();
+    (void)buffer.add("abcdefghijklmnopq").addLast('\n');
+    TEST_ASSERT_EQUAL_STRING("abcdefghijklmn\n", buffer.getString());
+    TEST_ASSERT_EQUAL(15U, buffer.getLength());
+    TEST_ASSERT_TRUE(buffer.isTruncated());
+
+    buffer.clear();
+    (void)buffer.add("abc").addLast('\n');
+    TEST_ASSERT_EQUAL_STRING("abc\n", buffer.getString());
+    TEST_ASSERT_FALSE(buffer.isTruncated());
+}
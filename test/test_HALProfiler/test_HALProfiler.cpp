@@ -0,0 +1,263 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the HAL profiler tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <HALProfiler.h>
+#include <ProfiledEncoders.h>
+#include <ProfiledMotors.h>
+#include <ProfiledDisplay.h>
+#include <Encoders.h>
+#include <Motors.h>
+#include <Display.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testRecord();
+static void testHistogram();
+static void testDecorators();
+static void testNames();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testRecord);
+    RUN_TEST(testHistogram);
+    RUN_TEST(testDecorators);
+    RUN_TEST(testNames);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    HALProfiler::getInstance().clear();
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test recording calls within a loop.
+ */
+static void testRecord()
+{
+    HALProfiler&                   profiler   = HALProfiler::getInstance();
+    const HALProfiler::Statistics& statistics = profiler.getStatistics(HALProfiler::MOTORS_SET_SPEEDS);
+
+    profiler.record(HALProfiler::MOTORS_SET_SPEEDS, 10U);
+    profiler.record(HALProfiler::MOTORS_SET_SPEEDS, 20U);
+    TEST_ASSERT_EQUAL_UINT8(2U, statistics.loopCalls);
+    TEST_ASSERT_EQUAL_UINT16(30U, statistics.loopTime);
+    TEST_ASSERT_EQUAL_UINT32(2U, statistics.totalCalls);
+    TEST_ASSERT_EQUAL_UINT32(30U, statistics.totalTime);
+
+    /* Other methods are not affected. */
+    TEST_ASSERT_EQUAL_UINT32(0U, profiler.getStatistics(HALProfiler::MOTORS_GET_LEFT_SPEED).totalCalls);
+
+    /* The loop counters are reset by the end of the loop, the totals are kept. */
+    profiler.endLoop();
+    TEST_ASSERT_EQUAL_UINT8(0U, statistics.loopCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, statistics.loopTime);
+    TEST_ASSERT_EQUAL_UINT16(30U, statistics.maxLoopTime);
+    TEST_ASSERT_EQUAL_UINT32(2U, statistics.totalCalls);
+    TEST_ASSERT_EQUAL_UINT32(1U, profiler.getLoopCount());
+
+    /* The loop time saturates. */
+    profiler.record(HALProfiler::MOTORS_SET_SPEEDS, 60000U);
+    profiler.record(HALProfiler::MOTORS_SET_SPEEDS, 60000U);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, statistics.loopTime);
+    TEST_ASSERT_EQUAL_UINT32(120030U, statistics.totalTime);
+    profiler.endLoop();
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, statistics.maxLoopTime);
+
+    /* Invalid methods are ignored. */
+    profiler.record(HALProfiler::METHOD_MAX, 10U);
+
+    profiler.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, statistics.totalCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, statistics.maxLoopTime);
+    TEST_ASSERT_EQUAL_UINT32(0U, profiler.getLoopCount());
+}
+
+/**
+ * Test the histogram of calls per loop.
+ */
+static void testHistogram()
+{
+    HALProfiler&                   profiler   = HALProfiler::getInstance();
+    const HALProfiler::Statistics& statistics = profiler.getStatistics(HALProfiler::LINE_SENSORS_READ_LINE);
+    uint8_t                        calls;
+
+    /* Loops with 0, 1, 2, ..., 5 calls. */
+    for (calls = 0U; calls <= 5U; ++calls)
+    {
+        uint8_t idx;
+
+        for (idx = 0U; idx < calls; ++idx)
+        {
+            profiler.record(HALProfiler::LINE_SENSORS_READ_LINE, 1U);
+        }
+
+        profiler.endLoop();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(6U, profiler.getLoopCount());
+    TEST_ASSERT_EQUAL_UINT16(1U, statistics.histogram[0]);
+    TEST_ASSERT_EQUAL_UINT16(1U, statistics.histogram[1]);
+    TEST_ASSERT_EQUAL_UINT16(1U, statistics.histogram[2]);
+    TEST_ASSERT_EQUAL_UINT16(3U, statistics.histogram[HALProfiler::HISTOGRAM_BINS - 1U]);
+    TEST_ASSERT_EQUAL_UINT16(5U, statistics.maxLoopTime);
+
+    /* A method, which is never called, counts every loop in the first bin. */
+    TEST_ASSERT_EQUAL_UINT16(6U, profiler.getStatistics(HALProfiler::DISPLAY_CLEAR).histogram[0]);
+}
+
+/**
+ * Test that the decorators forward to the decorated drivers and count the calls.
+ */
+static void testDecorators()
+{
+    HALProfiler&     profiler = HALProfiler::getInstance();
+    Encoders         encoders;
+    Motors           motors;
+    Display          display;
+    ProfiledEncoders profiledEncoders(encoders);
+    ProfiledMotors   profiledMotors(motors);
+    ProfiledDisplay  profiledDisplay(display);
+
+    encoders.setCountsLeft(5);
+    TEST_ASSERT_EQUAL_INT16(5, profiledEncoders.getCountsAndResetLeft());
+    TEST_ASSERT_EQUAL_INT16(0, encoders.getCountsLeft());
+    TEST_ASSERT_EQUAL_UINT32(1U, profiler.getStatistics(HALProfiler::ENCODERS_GET_COUNTS_AND_RESET_LEFT).totalCalls);
+
+    profiledMotors.setSpeeds(100, -100);
+    TEST_ASSERT_EQUAL_INT16(100, motors.getLeftSpeed());
+    TEST_ASSERT_EQUAL_INT16(-100, profiledMotors.getRightSpeed());
+    TEST_ASSERT_EQUAL_UINT32(1U, profiler.getStatistics(HALProfiler::MOTORS_SET_SPEEDS).totalCalls);
+    TEST_ASSERT_EQUAL_UINT32(1U, profiler.getStatistics(HALProfiler::MOTORS_GET_RIGHT_SPEED).totalCalls);
+    TEST_ASSERT_EQUAL_UINT32(0U, profiler.getStatistics(HALProfiler::MOTORS_GET_LEFT_SPEED).totalCalls);
+
+    /* Constants are not profiled. */
+    TEST_ASSERT_EQUAL_INT16(motors.getMaxSpeed(), profiledMotors.getMaxSpeed());
+
+    /* All print overloads are counted together. */
+    (void)profiledDisplay.print("A");
+    (void)profiledDisplay.print(static_cast<uint8_t>(1U));
+    (void)profiledDisplay.print(static_cast<int32_t>(-1));
+    TEST_ASSERT_EQUAL_UINT8(3U, profiler.getStatistics(HALProfiler::DISPLAY_PRINT).loopCalls);
+}
+
+/**
+ * Test the method names.
+ */
+static void testNames()
+{
+    TEST_ASSERT_EQUAL_STRING("Enc.getCountsLeft",
+                             reinterpret_cast<const char*>(HALProfiler::getName(HALProfiler::ENCODERS_GET_COUNTS_LEFT)));
+    TEST_ASSERT_EQUAL_STRING("Disp.print",
+                             reinterpret_cast<const char*>(HALProfiler::getName(HALProfiler::DISPLAY_PRINT)));
+    TEST_ASSERT_NULL(HALProfiler::getName(HALProfiler::METHOD_MAX));
+}
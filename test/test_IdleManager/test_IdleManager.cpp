@@ -0,0 +1,258 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the idle manager tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <IdleManager.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void runLoops(IdleManager& manager, uint32_t& timestamp, uint32_t busyTime, uint32_t idleTime, uint32_t count);
+static void testUtilization();
+static void testLatency();
+static void testMissedDeadline();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Period of the periodic task in us. */
+static const uint32_t PERIOD = 5000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testUtilization);
+    RUN_TEST(testLatency);
+    RUN_TEST(testMissedDeadline);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Run loops, which are busy and sleep afterwards.
+ *
+ * @param[in]       manager     Idle manager
+ * @param[in,out]   timestamp   Timestamp in us
+ * @param[in]       busyTime    Busy time per loop in us
+ * @param[in]       idleTime    Idle time per loop in us
+ * @param[in]       count       Number of loops
+ */
+static void runLoops(IdleManager& manager, uint32_t& timestamp, uint32_t busyTime, uint32_t idleTime, uint32_t count)
+{
+    while (0U < count)
+    {
+        manager.beginLoop(timestamp);
+        timestamp += busyTime;
+        manager.beginIdle(timestamp);
+        timestamp += idleTime;
+
+        --count;
+    }
+}
+
+/**
+ * Test the CPU utilization.
+ */
+static void testUtilization()
+{
+    IdleManager manager;
+    uint32_t    timestamp = 0U;
+
+    /* Not started, nothing is measured. */
+    runLoops(manager, timestamp, 100U, 900U, 10U);
+    TEST_ASSERT_EQUAL_UINT16(0U, manager.getUtilization());
+
+    /* 10% busy */
+    manager.start(PERIOD);
+    runLoops(manager, timestamp, 100U, 900U, 10U);
+    manager.beginLoop(timestamp);
+    TEST_ASSERT_EQUAL_UINT16(100U, manager.getUtilization());
+
+    /* Loops, which don't sleep, are busy all the time. */
+    manager.clear();
+    timestamp += 1000U;
+    manager.beginLoop(timestamp);
+    timestamp += 1000U;
+    manager.beginLoop(timestamp);
+    TEST_ASSERT_EQUAL_UINT16(1000U, manager.getUtilization());
+
+    /* 25% busy, even across a timestamp overflow. */
+    timestamp = UINT32_MAX - 1000U;
+    manager.start(PERIOD);
+    runLoops(manager, timestamp, 250U, 750U, 4U);
+    manager.beginLoop(timestamp);
+    TEST_ASSERT_EQUAL_UINT16(250U, manager.getUtilization());
+}
+
+/**
+ * Test the wake-up latency.
+ */
+static void testLatency()
+{
+    IdleManager manager;
+    uint32_t    timestamp = 1000U;
+
+    manager.start(PERIOD);
+
+    /* The first start defines the phase and has no latency. */
+    manager.markDeadline(timestamp);
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getMaxLatency());
+
+    timestamp += PERIOD + 100U;
+    manager.markDeadline(timestamp);
+
+    /* A late start doesn't shift the following deadlines. */
+    timestamp += PERIOD - 100U + 300U;
+    manager.markDeadline(timestamp);
+
+    /* Starting early is no latency. */
+    timestamp += PERIOD - 300U - 200U;
+    manager.markDeadline(timestamp);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getMinLatency());
+    TEST_ASSERT_EQUAL_UINT32(133U, manager.getAvgLatency());
+    TEST_ASSERT_EQUAL_UINT32(300U, manager.getMaxLatency());
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getMissedCount());
+
+    manager.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getMinLatency());
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getAvgLatency());
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getMaxLatency());
+
+    /* The deadlines keep their phase after clearing the statistics. */
+    timestamp += 200U + PERIOD + 50U;
+    manager.markDeadline(timestamp);
+    TEST_ASSERT_EQUAL_UINT32(50U, manager.getMinLatency());
+    TEST_ASSERT_EQUAL_UINT32(50U, manager.getMaxLatency());
+}
+
+/**
+ * Test a deadline, which is missed by a whole period.
+ */
+static void testMissedDeadline()
+{
+    IdleManager manager;
+    uint32_t    timestamp = 0U;
+
+    manager.start(PERIOD);
+    manager.markDeadline(timestamp);
+
+    timestamp += 3U * PERIOD;
+    manager.markDeadline(timestamp);
+    TEST_ASSERT_EQUAL_UINT32(2U * PERIOD, manager.getMaxLatency());
+    TEST_ASSERT_EQUAL_UINT32(1U, manager.getMissedCount());
+
+    /* The deadlines are synchronized to the late start. */
+    manager.clear();
+    timestamp += PERIOD + 10U;
+    manager.markDeadline(timestamp);
+    TEST_ASSERT_EQUAL_UINT32(10U, manager.getMaxLatency());
+    TEST_ASSERT_EQUAL_UINT32(0U, manager.getMissedCount());
+}
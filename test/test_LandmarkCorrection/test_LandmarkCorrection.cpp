@@ -0,0 +1,251 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <FPMath.h>
+#include <Odometry.h>
+#include <LandmarkCorrection.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testLearning();
+static void testCorrection();
+static void testRejection();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testLearning);
+    RUN_TEST(testCorrection);
+    RUN_TEST(testRejection);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    LandmarkCorrection& landmarkCorrection = LandmarkCorrection::getInstance();
+
+    landmarkCorrection.clear();
+    landmarkCorrection.enableLearning(false);
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test learning of unknown landmarks.
+ */
+static void testLearning()
+{
+    LandmarkCorrection& landmarkCorrection = LandmarkCorrection::getInstance();
+    Odometry&           odometry           = Odometry::getInstance();
+    uint8_t             idx;
+
+    odometry.setPosition(100, 200);
+    odometry.setOrientation(FP_PI() / 2);
+
+    /* Without learning, a unknown landmark is ignored. */
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_UNKNOWN,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_START_LINE));
+    TEST_ASSERT_EQUAL_UINT8(0U, landmarkCorrection.getNumLandmarks());
+
+    /* With learning, the first observation of a type is learned. */
+    landmarkCorrection.enableLearning(true);
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_LEARNED,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_START_LINE));
+    TEST_ASSERT_EQUAL_UINT8(1U, landmarkCorrection.getNumLandmarks());
+
+    /* A second observation at the same pose matches without correction. */
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_CORRECTED,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_START_LINE));
+    TEST_ASSERT_EQUAL_UINT8(1U, landmarkCorrection.getNumLandmarks());
+    TEST_ASSERT_EQUAL_INT32(0, landmarkCorrection.getStatistics().lastDeltaX);
+    TEST_ASSERT_EQUAL_INT32(0, landmarkCorrection.getStatistics().lastDeltaY);
+
+    /* Capacity is limited. */
+    for (idx = 1U; idx < LandmarkCorrection::MAX_LANDMARKS; ++idx)
+    {
+        TEST_ASSERT_TRUE(landmarkCorrection.addLandmark(LandmarkCorrection::TYPE_MARKER, idx * 300, 0, 0));
+    }
+
+    TEST_ASSERT_FALSE(landmarkCorrection.addLandmark(LandmarkCorrection::TYPE_MARKER, 0, 0, 0));
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_UNKNOWN,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_END_LINE));
+}
+
+/**
+ * Test the partial correction towards the nearest landmark.
+ */
+static void testCorrection()
+{
+    LandmarkCorrection& landmarkCorrection = LandmarkCorrection::getInstance();
+    Odometry&           odometry           = Odometry::getInstance();
+    int32_t             posX               = 0;
+    int32_t             posY               = 0;
+
+    TEST_ASSERT_TRUE(landmarkCorrection.addLandmark(LandmarkCorrection::TYPE_MARKER, 0, 0, 0));
+    TEST_ASSERT_TRUE(landmarkCorrection.addLandmark(LandmarkCorrection::TYPE_MARKER, 300, 0, 0));
+
+    /* Drifted pose near the second marker. */
+    odometry.setPosition(340, -20);
+    odometry.setOrientation(100);
+
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_CORRECTED,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_MARKER));
+
+    odometry.getPosition(posX, posY);
+    TEST_ASSERT_EQUAL_INT32(320, posX);
+    TEST_ASSERT_EQUAL_INT32(-10, posY);
+    TEST_ASSERT_EQUAL_INT32(50, odometry.getOrientation());
+    TEST_ASSERT_EQUAL_UINT16(1U, landmarkCorrection.getStatistics().corrections);
+    TEST_ASSERT_EQUAL_INT32(60, landmarkCorrection.getStatistics().maxResidual);
+
+    /* The orientation residual is corrected the short way around. */
+    odometry.setPosition(300, 0);
+    odometry.setOrientation(FP_2PI() - 100);
+
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_CORRECTED,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_MARKER));
+    TEST_ASSERT_EQUAL_INT32(50, landmarkCorrection.getStatistics().lastDeltaOrientation);
+    TEST_ASSERT_EQUAL_INT32(FP_2PI() - 50, odometry.getOrientation());
+}
+
+/**
+ * Test the rejection of observations outside the gate.
+ */
+static void testRejection()
+{
+    LandmarkCorrection& landmarkCorrection = LandmarkCorrection::getInstance();
+    Odometry&           odometry           = Odometry::getInstance();
+    int32_t             posX               = 0;
+    int32_t             posY               = 0;
+
+    landmarkCorrection.enableLearning(true);
+    TEST_ASSERT_TRUE(landmarkCorrection.addLandmark(LandmarkCorrection::TYPE_START_LINE, 0, 0, FP_PI() / 2));
+
+    /* Too far away. A known type is not learned again. */
+    odometry.setPosition(LandmarkCorrection::GATE_DISTANCE, 100);
+    odometry.setOrientation(FP_PI() / 2);
+
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_REJECTED,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_START_LINE));
+    TEST_ASSERT_EQUAL_UINT8(1U, landmarkCorrection.getNumLandmarks());
+
+    odometry.getPosition(posX, posY);
+    TEST_ASSERT_EQUAL_INT32(LandmarkCorrection::GATE_DISTANCE, posX);
+    TEST_ASSERT_EQUAL_INT32(100, posY);
+
+    /* Wrong heading, e.g. the line is crossed in the opposite direction. */
+    odometry.setPosition(0, 0);
+    odometry.setOrientation(-FP_PI() / 2);
+
+    TEST_ASSERT_EQUAL(LandmarkCorrection::RESULT_REJECTED,
+                      landmarkCorrection.observe(LandmarkCorrection::TYPE_START_LINE));
+    TEST_ASSERT_EQUAL_UINT16(2U, landmarkCorrection.getStatistics().rejections);
+    TEST_ASSERT_EQUAL_UINT16(0U, landmarkCorrection.getStatistics().corrections);
+}
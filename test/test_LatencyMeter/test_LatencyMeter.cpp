@@ -0,0 +1,188 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <LatencyMeter.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testInitial();
+static void testStatistics();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Tolerance of a measured latency in us, because the delays are busy waiting. */
+static const uint32_t LATENCY_TOLERANCE = 1000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testInitial);
+    RUN_TEST(testStatistics);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the latency meter without any measurement.
+ */
+static void testInitial()
+{
+    LatencyMeter meter;
+
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getLast());
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getMin());
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getAverage());
+}
+
+/**
+ * Test the min, max and average latency.
+ */
+static void testStatistics()
+{
+    LatencyMeter meter;
+
+    /* 2 ms */
+    meter.start();
+    delay(2U);
+    meter.stop();
+    TEST_ASSERT_EQUAL_UINT32(1U, meter.getCount());
+    TEST_ASSERT_UINT32_WITHIN(LATENCY_TOLERANCE, 2000U, meter.getLast());
+    TEST_ASSERT_EQUAL_UINT32(meter.getLast(), meter.getMin());
+    TEST_ASSERT_EQUAL_UINT32(meter.getLast(), meter.getMax());
+    TEST_ASSERT_EQUAL_UINT32(meter.getLast(), meter.getAverage());
+
+    /* 6 ms */
+    meter.start();
+    delay(6U);
+    meter.stop();
+    TEST_ASSERT_EQUAL_UINT32(2U, meter.getCount());
+    TEST_ASSERT_UINT32_WITHIN(LATENCY_TOLERANCE, 2000U, meter.getMin());
+    TEST_ASSERT_UINT32_WITHIN(LATENCY_TOLERANCE, 6000U, meter.getMax());
+    TEST_ASSERT_EQUAL_UINT32((meter.getMin() + meter.getMax()) / 2U, meter.getAverage());
+
+    /* A new measurement may be started without a stop, e.g. if the chain was aborted. */
+    meter.start();
+    meter.start();
+    meter.stop();
+    TEST_ASSERT_EQUAL_UINT32(3U, meter.getCount());
+    TEST_ASSERT_EQUAL_UINT32(meter.getLast(), meter.getMin());
+    TEST_ASSERT_UINT32_WITHIN(LATENCY_TOLERANCE, 0U, meter.getMin());
+
+    meter.clear();
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0U, meter.getAverage());
+}
@@ -0,0 +1,297 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <LineFollowController.hpp>
+#include <Snapshot.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Parameter set, like the one of the LineFollower application. */
+typedef struct
+{
+    int16_t topSpeed;      /**< Top speed in steps/s */
+    int16_t kPNumerator;   /**< Kp numerator value */
+    int16_t kPDenominator; /**< Kp denominator value */
+    int16_t kINumerator;   /**< Ki numerator value */
+    int16_t kIDenominator; /**< Ki denominator value */
+    int16_t kDNumerator;   /**< Kd numerator value */
+    int16_t kDDenominator; /**< Kd denominator value */
+
+} ParameterSet;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testPidCycle();
+static void testSteering();
+static void testTrackGap();
+static void testSnapshot();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Number of line sensors of the robot. */
+static const uint8_t NUM_LINE_SENSORS = 5U;
+
+/** Max. line sensor value. */
+static const uint16_t SENSOR_VALUE_MAX = 1000U;
+
+/** Line position in the center of the robot. */
+static const int16_t POSITION_CENTER = SENSOR_VALUE_MAX * 2;
+
+/** Max. motor speed in [steps/s]. */
+static const int16_t MAX_MOTOR_SPEED = 2000;
+
+/** Proportional only parameter set. */
+static const ParameterSet PAR_SET_P = {1000, 1, 1, 0, 1, 0, 1};
+
+/** Parameter set with all PID terms. */
+static const ParameterSet PAR_SET_PID = {1500, 2, 1, 1, 10, 1, 2};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testPidCycle);
+    RUN_TEST(testSteering);
+    RUN_TEST(testTrackGap);
+    RUN_TEST(testSnapshot);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test that the wheel speeds are calculated immediately after the start and
+ * afterwards every PID process cycle.
+ */
+static void testPidCycle()
+{
+    LineFollowController ctrl;
+    int16_t              speedLeft  = -1;
+    int16_t              speedRight = -1;
+    uint8_t              cycle;
+
+    ctrl.start(PAR_SET_P, MAX_MOTOR_SPEED);
+    TEST_ASSERT_EQUAL_INT16(PAR_SET_P.topSpeed, ctrl.getTopSpeed());
+
+    TEST_ASSERT_TRUE(ctrl.process(POSITION_CENTER, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+    TEST_ASSERT_EQUAL_INT16(PAR_SET_P.topSpeed, speedLeft);
+    TEST_ASSERT_EQUAL_INT16(PAR_SET_P.topSpeed, speedRight);
+
+    /* The set points are not touched between the PID calculations. */
+    speedLeft  = -1;
+    speedRight = -1;
+
+    for (cycle = 1U; cycle < LineFollowController::PID_PROCESS_CYCLES; ++cycle)
+    {
+        TEST_ASSERT_FALSE(ctrl.process(0, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+        TEST_ASSERT_EQUAL_INT16(-1, speedLeft);
+        TEST_ASSERT_EQUAL_INT16(-1, speedRight);
+    }
+
+    TEST_ASSERT_TRUE(ctrl.process(POSITION_CENTER, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+
+    /* A restart calculates immediately again. */
+    ctrl.start(PAR_SET_P, MAX_MOTOR_SPEED);
+    TEST_ASSERT_TRUE(ctrl.process(POSITION_CENTER, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+}
+
+/**
+ * Test the wheel speeds depended on the line position, including the limitation
+ * to 0 .. max. motor speed.
+ */
+static void testSteering()
+{
+    LineFollowController ctrl;
+    int16_t              speedLeft  = 0;
+    int16_t              speedRight = 0;
+
+    /* Line on the left side: turn left. */
+    ctrl.start(PAR_SET_P, MAX_MOTOR_SPEED);
+    TEST_ASSERT_TRUE(ctrl.process(POSITION_CENTER - 500, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+    TEST_ASSERT_EQUAL_INT16(500, speedLeft);
+    TEST_ASSERT_EQUAL_INT16(1500, speedRight);
+
+    /* Line on the right side: turn right, the inner wheel stops. */
+    ctrl.start(PAR_SET_P, MAX_MOTOR_SPEED);
+    TEST_ASSERT_TRUE(ctrl.process(POSITION_CENTER + 1500, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+    TEST_ASSERT_EQUAL_INT16(MAX_MOTOR_SPEED, speedLeft);
+    TEST_ASSERT_EQUAL_INT16(0, speedRight);
+
+    /* A lower top speed, e.g. by a speed governor. */
+    ctrl.start(PAR_SET_P, MAX_MOTOR_SPEED);
+    ctrl.setTopSpeed(600);
+    TEST_ASSERT_EQUAL_INT16(600, ctrl.getTopSpeed());
+    TEST_ASSERT_TRUE(ctrl.process(POSITION_CENTER + 100, SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight));
+    TEST_ASSERT_EQUAL_INT16(700, speedLeft);
+    TEST_ASSERT_EQUAL_INT16(500, speedRight);
+}
+
+/**
+ * Test the track gap detection at the outer line sensors.
+ */
+static void testTrackGap()
+{
+    const int16_t POS_MAX = (NUM_LINE_SENSORS - 1) * 1000;
+
+    TEST_ASSERT_TRUE(LineFollowController::isTrackGapDetected(0, NUM_LINE_SENSORS));
+    TEST_ASSERT_TRUE(LineFollowController::isTrackGapDetected(-1, NUM_LINE_SENSORS));
+    TEST_ASSERT_FALSE(LineFollowController::isTrackGapDetected(1, NUM_LINE_SENSORS));
+    TEST_ASSERT_FALSE(LineFollowController::isTrackGapDetected(POSITION_CENTER, NUM_LINE_SENSORS));
+    TEST_ASSERT_FALSE(LineFollowController::isTrackGapDetected(POS_MAX - 1, NUM_LINE_SENSORS));
+    TEST_ASSERT_TRUE(LineFollowController::isTrackGapDetected(POS_MAX, NUM_LINE_SENSORS));
+
+    /* Less line sensors */
+    TEST_ASSERT_TRUE(LineFollowController::isTrackGapDetected(2000, 3U));
+    TEST_ASSERT_FALSE(LineFollowController::isTrackGapDetected(1999, 3U));
+}
+
+/**
+ * Test that a restored controller continues exactly like the saved one,
+ * including the PID cycle and the PID terms.
+ */
+static void testSnapshot()
+{
+    const int16_t        POSITIONS[] = {2300, 2600, 2900, 2500, 1800, 1200, 1700, 2100};
+    const uint8_t        NUM_STEPS   = sizeof(POSITIONS) / sizeof(POSITIONS[0]);
+    LineFollowController ctrl;
+    LineFollowController restoredCtrl;
+    Snapshot             snapshot;
+    uint8_t              step;
+    int16_t              speedLeft  = 0;
+    int16_t              speedRight = 0;
+
+    ctrl.start(PAR_SET_PID, MAX_MOTOR_SPEED);
+
+    /* Odd number of steps, to save in the middle of a PID cycle. */
+    for (step = 0U; step < 3U; ++step)
+    {
+        (void)ctrl.process(POSITIONS[step], SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight);
+    }
+
+    ctrl.save(snapshot);
+    snapshot.rewind();
+    restoredCtrl.restore(snapshot);
+
+    TEST_ASSERT_EQUAL_UINT32(0U, snapshot.getUnreadSize());
+    TEST_ASSERT_EQUAL_INT16(PAR_SET_PID.topSpeed, restoredCtrl.getTopSpeed());
+
+    for (step = 3U; step < NUM_STEPS; ++step)
+    {
+        int16_t restoredSpeedLeft  = 0;
+        int16_t restoredSpeedRight = 0;
+        bool    isCalculated = ctrl.process(POSITIONS[step], SENSOR_VALUE_MAX, MAX_MOTOR_SPEED, speedLeft, speedRight);
+
+        TEST_ASSERT_EQUAL(isCalculated, restoredCtrl.process(POSITIONS[step], SENSOR_VALUE_MAX, MAX_MOTOR_SPEED,
+                                                             restoredSpeedLeft, restoredSpeedRight));
+
+        if (true == isCalculated)
+        {
+            TEST_ASSERT_EQUAL_INT16(speedLeft, restoredSpeedLeft);
+            TEST_ASSERT_EQUAL_INT16(speedRight, restoredSpeedRight);
+        }
+    }
+}
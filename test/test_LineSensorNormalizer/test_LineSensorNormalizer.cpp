@@ -0,0 +1,301 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the SimpleTimer tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <LineSensorNormalizer.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testNotCalibrated();
+static void testNormalize();
+static void testPosition();
+static void testSetCalibration();
+static void testCalibrationCandidates();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testNotCalibrated);
+    RUN_TEST(testNormalize);
+    RUN_TEST(testPosition);
+    RUN_TEST(testSetCalibration);
+    RUN_TEST(testCalibrationCandidates);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the behaviour without calibration.
+ */
+static void testNotCalibrated()
+{
+    LineSensorNormalizer<3> normalizer;
+    const uint16_t          raw[3] = {0U, 1234U, 2000U};
+    uint16_t                values[3];
+
+    TEST_ASSERT_FALSE(normalizer.isCalibrated());
+
+    /* Without calibration the raw values are passed through. */
+    normalizer.normalize(raw, values);
+    TEST_ASSERT_EQUAL_UINT16(0U, values[0]);
+    TEST_ASSERT_EQUAL_UINT16(1234U, values[1]);
+    TEST_ASSERT_EQUAL_UINT16(2000U, values[2]);
+}
+
+/**
+ * Test the normalization of calibrated sensors.
+ */
+static void testNormalize()
+{
+    LineSensorNormalizer<3> normalizer;
+    const uint16_t          white[3] = {100U, 200U, 500U};
+    const uint16_t          black[3] = {1100U, 2200U, 500U};
+    uint16_t                raw[3];
+    uint16_t                values[3];
+    uint16_t                value;
+
+    normalizer.calibrate(white);
+    normalizer.calibrate(black);
+    TEST_ASSERT_TRUE(normalizer.isCalibrated());
+    TEST_ASSERT_EQUAL_UINT16(100U, normalizer.getMinValue(0));
+    TEST_ASSERT_EQUAL_UINT16(2200U, normalizer.getMaxValue(1));
+
+    /* Calibrated limits and values beyond them. */
+    normalizer.normalize(white, values);
+    TEST_ASSERT_EQUAL_UINT16(0U, values[0]);
+    TEST_ASSERT_EQUAL_UINT16(0U, values[1]);
+    normalizer.normalize(black, values);
+    TEST_ASSERT_EQUAL_UINT16(1000U, values[0]);
+    TEST_ASSERT_EQUAL_UINT16(1000U, values[1]);
+
+    /* A sensor without range delivers always 0. */
+    TEST_ASSERT_EQUAL_UINT16(0U, values[2]);
+
+    /* The fixed-point result shall match the exact division within one digit. */
+    for (value = 100U; value <= 1100U; ++value)
+    {
+        uint16_t expected = value - 100U; /* Sensor 0 has a range of 1000 digits. */
+
+        raw[0] = value;
+        raw[1] = 200U + 2U * (value - 100U);
+        raw[2] = value;
+        normalizer.normalize(raw, values);
+
+        TEST_ASSERT_UINT16_WITHIN(1U, expected, values[0]);
+        TEST_ASSERT_UINT16_WITHIN(1U, expected, values[1]);
+    }
+
+    /* Clearing resets the calibration. */
+    normalizer.clear();
+    TEST_ASSERT_FALSE(normalizer.isCalibrated());
+}
+
+/**
+ * Test the line position estimation.
+ */
+static void testPosition()
+{
+    LineSensorNormalizer<5> normalizer;
+    const uint16_t          center[5]    = {0U, 0U, 1000U, 0U, 0U};
+    const uint16_t          between[5]   = {0U, 0U, 500U, 500U, 0U};
+    const uint16_t          right[5]     = {0U, 0U, 0U, 300U, 1000U};
+    const uint16_t          noise[5]     = {40U, 0U, 1000U, 0U, 40U};
+    const uint16_t          lost[5]      = {0U, 0U, 0U, 0U, 0U};
+    const uint16_t          leftEdge[5]  = {1000U, 300U, 0U, 0U, 0U};
+
+    TEST_ASSERT_EQUAL_INT16(2000, normalizer.estimatePosition(center));
+    TEST_ASSERT_EQUAL_INT16(2500, normalizer.estimatePosition(between));
+    TEST_ASSERT_EQUAL_INT16(2000, normalizer.estimatePosition(noise));
+
+    /* If the line is lost, the side where it was seen at last is reported. */
+    TEST_ASSERT_EQUAL_INT16(3769, normalizer.estimatePosition(right));
+    TEST_ASSERT_EQUAL_INT16(4000, normalizer.estimatePosition(lost));
+    TEST_ASSERT_EQUAL_INT16(230, normalizer.estimatePosition(leftEdge));
+    TEST_ASSERT_EQUAL_INT16(0, normalizer.estimatePosition(lost));
+}
+
+/**
+ * Test that a set calibration normalizes like the calibration it was taken from.
+ */
+static void testSetCalibration()
+{
+    LineSensorNormalizer<3> original;
+    LineSensorNormalizer<3> restored;
+    const uint16_t          white[3]   = {100U, 200U, 500U};
+    const uint16_t          black[3]   = {1100U, 2200U, 500U};
+    const uint16_t          raw[3]     = {600U, 900U, 700U};
+    const uint16_t          noValue[3] = {0U, 0U, 0U};
+    uint16_t                minValues[3];
+    uint16_t                maxValues[3];
+    uint16_t                valuesOriginal[3];
+    uint16_t                valuesRestored[3];
+    uint8_t                 idx = 0U;
+
+    original.calibrate(white);
+    original.calibrate(black);
+
+    for (idx = 0U; idx < 3U; ++idx)
+    {
+        minValues[idx] = original.getMinValue(idx);
+        maxValues[idx] = original.getMaxValue(idx);
+    }
+
+    restored.setCalibration(minValues, maxValues);
+    TEST_ASSERT_TRUE(restored.isCalibrated());
+
+    original.normalize(raw, valuesOriginal);
+    restored.normalize(raw, valuesRestored);
+
+    for (idx = 0U; idx < 3U; ++idx)
+    {
+        TEST_ASSERT_EQUAL_UINT16(minValues[idx], restored.getMinValue(idx));
+        TEST_ASSERT_EQUAL_UINT16(maxValues[idx], restored.getMaxValue(idx));
+        TEST_ASSERT_EQUAL_UINT16(valuesOriginal[idx], valuesRestored[idx]);
+    }
+
+    /* A sensor, which never saw a value, means not calibrated. */
+    restored.setCalibration(noValue, noValue);
+    TEST_ASSERT_FALSE(restored.isCalibrated());
+}
+
+/**
+ * Test the calibration with separate min. and max. candidates, which are
+ * the highest and the lowest of several reads on the target.
+ */
+static void testCalibrationCandidates()
+{
+    LineSensorNormalizer<2> normalizer;
+    const uint16_t          highestWhite[2] = {150U, 300U};
+    const uint16_t          lowestWhite[2]  = {100U, 200U};
+    const uint16_t          highestBlack[2] = {1900U, 2200U};
+    const uint16_t          lowestBlack[2]  = {1100U, 2100U};
+
+    /* The first step sets both limits, every one by its own candidate. */
+    normalizer.calibrate(highestWhite, lowestWhite);
+    TEST_ASSERT_EQUAL_UINT16(150U, normalizer.getMinValue(0));
+    TEST_ASSERT_EQUAL_UINT16(300U, normalizer.getMinValue(1));
+    TEST_ASSERT_EQUAL_UINT16(100U, normalizer.getMaxValue(0));
+    TEST_ASSERT_EQUAL_UINT16(200U, normalizer.getMaxValue(1));
+
+    /* A noisy high read over black doesn't raise the max. value. */
+    normalizer.calibrate(highestBlack, lowestBlack);
+    TEST_ASSERT_EQUAL_UINT16(150U, normalizer.getMinValue(0));
+    TEST_ASSERT_EQUAL_UINT16(1100U, normalizer.getMaxValue(0));
+    TEST_ASSERT_EQUAL_UINT16(2100U, normalizer.getMaxValue(1));
+
+    /* A noisy low read over white doesn't lower the min. value. */
+    normalizer.calibrate(highestWhite, lowestWhite);
+    TEST_ASSERT_EQUAL_UINT16(150U, normalizer.getMinValue(0));
+    TEST_ASSERT_EQUAL_UINT16(300U, normalizer.getMinValue(1));
+}
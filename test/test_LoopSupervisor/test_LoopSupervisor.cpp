@@ -0,0 +1,292 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the loop supervisor tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <LoopSupervisor.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static uint32_t runLoops(LoopSupervisor& supervisor, uint32_t& timestamp, uint32_t period, uint32_t count);
+static void     testInTime();
+static void     testEscalation();
+static void     testRecovery();
+static void     testLoopQuantum();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. loop period in us. */
+static const uint32_t PERIOD = 5000U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testInTime);
+    RUN_TEST(testEscalation);
+    RUN_TEST(testRecovery);
+    RUN_TEST(testLoopQuantum);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Run loops with a constant period.
+ *
+ * @param[in]       supervisor  Loop supervisor
+ * @param[in,out]   timestamp   Timestamp in us
+ * @param[in]       period      Loop period in us
+ * @param[in]       count       Number of loops
+ *
+ * @return Number of degradation level changes.
+ */
+static uint32_t runLoops(LoopSupervisor& supervisor, uint32_t& timestamp, uint32_t period, uint32_t count)
+{
+    uint32_t changes = 0U;
+
+    while (0U < count)
+    {
+        timestamp += period;
+
+        if (true == supervisor.process(timestamp))
+        {
+            ++changes;
+        }
+
+        --count;
+    }
+
+    return changes;
+}
+
+/**
+ * Test loops, which are in time.
+ */
+static void testInTime()
+{
+    LoopSupervisor supervisor;
+    uint32_t       timestamp = 0U;
+
+    /* Not started, nothing is supervised. */
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, 100000U, 10U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(0U, supervisor.getOverrunCount());
+
+    supervisor.start(PERIOD, 0U);
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, 1000U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(PERIOD, supervisor.getLastPeriod());
+    TEST_ASSERT_EQUAL_UINT32(PERIOD, supervisor.getMaxPeriod());
+    TEST_ASSERT_EQUAL_UINT32(PERIOD, supervisor.getAvgPeriod());
+    TEST_ASSERT_EQUAL_UINT32(0U, supervisor.getOverrunCount());
+
+    /* A single overrun, e.g. by a blocking call, doesn't degrade. */
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, 10U * PERIOD, 1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, 1U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(10U * PERIOD, supervisor.getMaxPeriod());
+    TEST_ASSERT_EQUAL_UINT32(1U, supervisor.getOverrunCount());
+
+    /* The moving average is raised by the overrun, but settles again. */
+    TEST_ASSERT_TRUE(PERIOD < supervisor.getAvgPeriod());
+    TEST_ASSERT_TRUE((2U * PERIOD) > supervisor.getAvgPeriod());
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, 200U));
+    TEST_ASSERT_EQUAL_UINT32(PERIOD, supervisor.getAvgPeriod());
+}
+
+/**
+ * Test the escalation by overrun streaks.
+ */
+static void testEscalation()
+{
+    LoopSupervisor supervisor;
+    uint32_t       timestamp = 0U;
+
+    supervisor.start(PERIOD, 0U);
+    (void)supervisor.process(timestamp);
+
+    /* One streak less than necessary. */
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD + 1U, LoopSupervisor::ESCALATION_STREAK - 1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, 1U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+
+    /* Every streak steps one level up. */
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, 2U * PERIOD, LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_SHED_OUTPUT, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, 2U * PERIOD, LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_LIMIT_SPEED, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, 2U * PERIOD, LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_STOP, supervisor.getLevel());
+
+    /* Stop is the last level. */
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, 2U * PERIOD, LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_STOP, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(5U * LoopSupervisor::ESCALATION_STREAK - 1U, supervisor.getOverrunCount());
+}
+
+/**
+ * Test the recovery from degradation.
+ */
+static void testRecovery()
+{
+    LoopSupervisor supervisor;
+    uint32_t       timestamp = 0U;
+
+    supervisor.start(PERIOD, 0U);
+    (void)supervisor.process(timestamp);
+
+    TEST_ASSERT_EQUAL_UINT32(2U, runLoops(supervisor, timestamp, 2U * PERIOD, 2U * LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_LIMIT_SPEED, supervisor.getLevel());
+
+    /* Every recovery streak steps one level down. */
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, LoopSupervisor::RECOVERY_STREAK - 1U));
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, PERIOD, 1U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_SHED_OUTPUT, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, PERIOD, LoopSupervisor::RECOVERY_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+
+    /* The stop is latched. */
+    TEST_ASSERT_EQUAL_UINT32(3U, runLoops(supervisor, timestamp, 2U * PERIOD, 3U * LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_STOP, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, 2U * LoopSupervisor::RECOVERY_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_STOP, supervisor.getLevel());
+
+    /* Only a reset leaves it. The period across the reset is not measured. */
+    supervisor.reset();
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, 100U * PERIOD, 1U));
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, PERIOD, 1U));
+    TEST_ASSERT_EQUAL_UINT32(PERIOD, supervisor.getLastPeriod());
+}
+
+/**
+ * Test a loop, which is scheduled with a longer quantum than the max. loop
+ * period, e.g. once per simulation step of 8 ms.
+ */
+static void testLoopQuantum()
+{
+    const uint32_t SIM_STEP  = 8000U;
+    LoopSupervisor supervisor;
+    uint32_t       timestamp = 0U;
+
+    supervisor.start(PERIOD, SIM_STEP);
+    TEST_ASSERT_EQUAL_UINT32(0U, runLoops(supervisor, timestamp, SIM_STEP, 1000U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_NORMAL, supervisor.getLevel());
+    TEST_ASSERT_EQUAL_UINT32(0U, supervisor.getOverrunCount());
+
+    /* A missed simulation step is still an overrun. */
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, 2U * SIM_STEP, LoopSupervisor::ESCALATION_STREAK));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_SHED_OUTPUT, supervisor.getLevel());
+
+    /* A quantum shorter than the max. loop period doesn't change it. */
+    supervisor.start(PERIOD, 1000U);
+    TEST_ASSERT_EQUAL_UINT32(1U, runLoops(supervisor, timestamp, PERIOD + 1U, LoopSupervisor::ESCALATION_STREAK + 1U));
+    TEST_ASSERT_EQUAL(LoopSupervisor::LEVEL_SHED_OUTPUT, supervisor.getLevel());
+}
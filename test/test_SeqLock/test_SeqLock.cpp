@@ -0,0 +1,274 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the sequence lock tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <SeqLock.hpp>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Test data, which calls a hook while it is copied. It simulates an
+ * interrupt in the middle of a read or write.
+ */
+struct Data
+{
+    uint16_t first;  /**< First value */
+    uint16_t second; /**< Second value */
+
+    /** Construct test data. */
+    Data() : first(0U), second(0U)
+    {
+    }
+
+    /**
+     * Construct test data.
+     *
+     * @param[in] value Value for both members
+     */
+    explicit Data(uint16_t value) : first(value), second(value)
+    {
+    }
+
+    /**
+     * Copy the test data and call the hook in the middle.
+     *
+     * @param[in] other Test data
+     *
+     * @return Test data
+     */
+    Data& operator=(const Data& other);
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void hookWrite();
+static void hookRead();
+static void testReadWrite();
+static void testInterruptedRead();
+static void testInterruptedWrite();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Hook, which is called in the middle of a copy. */
+static void (*gHook)() = nullptr;
+
+/** Sequence lock under test. */
+static SeqLock<Data> gLock;
+
+/** Result of the read in the hook. */
+static bool gHookReadResult = false;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Data& Data::operator=(const Data& other)
+{
+    void (*hook)() = gHook;
+
+    first = other.first;
+
+    /* Call the hook only once, because it may copy too. */
+    gHook = nullptr;
+
+    if (nullptr != hook)
+    {
+        hook();
+    }
+
+    second = other.second;
+
+    return *this;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testReadWrite);
+    RUN_TEST(testInterruptedRead);
+    RUN_TEST(testInterruptedWrite);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Write while a read is in progress.
+ */
+static void hookWrite()
+{
+    gLock.write(Data(2U));
+}
+
+/**
+ * Read while a write is in progress.
+ */
+static void hookRead()
+{
+    Data data;
+
+    gHookReadResult = gLock.tryRead(data);
+}
+
+/**
+ * Test reading and writing without interruption.
+ */
+static void testReadWrite()
+{
+    SeqLock<Data> lock(Data(1U));
+    Data          data;
+
+    TEST_ASSERT_TRUE(lock.tryRead(data));
+    TEST_ASSERT_EQUAL_UINT16(1U, data.first);
+    TEST_ASSERT_EQUAL_UINT16(1U, data.second);
+
+    lock.write(Data(5U));
+    data = lock.read();
+    TEST_ASSERT_EQUAL_UINT16(5U, data.first);
+    TEST_ASSERT_EQUAL_UINT16(5U, data.second);
+}
+
+/**
+ * Test a read, which is interrupted by a write.
+ */
+static void testInterruptedRead()
+{
+    Data data;
+
+    gLock.write(Data(1U));
+
+    /* The single try detects the torn copy. */
+    gHook = hookWrite;
+    TEST_ASSERT_FALSE(gLock.tryRead(data));
+    TEST_ASSERT_EQUAL_UINT16(1U, data.first);
+    TEST_ASSERT_EQUAL_UINT16(2U, data.second);
+
+    /* The read retries and gets the new data. */
+    gLock.write(Data(1U));
+    gHook = hookWrite;
+    data  = gLock.read();
+    TEST_ASSERT_EQUAL_UINT16(2U, data.first);
+    TEST_ASSERT_EQUAL_UINT16(2U, data.second);
+}
+
+/**
+ * Test a read, which interrupts a write.
+ */
+static void testInterruptedWrite()
+{
+    Data data;
+
+    gLock.write(Data(1U));
+
+    gHookReadResult = true;
+    gHook           = hookRead;
+    gLock.write(Data(3U));
+    TEST_ASSERT_FALSE(gHookReadResult);
+
+    /* Afterwards the data is consistent again. */
+    TEST_ASSERT_TRUE(gLock.tryRead(data));
+    TEST_ASSERT_EQUAL_UINT16(3U, data.first);
+    TEST_ASSERT_EQUAL_UINT16(3U, data.second);
+}
@@ -0,0 +1,544 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the SerialTxQueue tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <SerialTxQueue.h>
+#include <Logging.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Stream, which captures the written data.
+ */
+class CaptureStream : public Stream
+{
+public:
+    /** Size of the capture buffer in byte. */
+    static const size_t BUFFER_SIZE = 256U;
+
+    /**
+     * Constructs the capture stream.
+     */
+    CaptureStream() : Stream(), m_length(0U), m_buffer()
+    {
+    }
+
+    /**
+     * Destroys the capture stream.
+     */
+    ~CaptureStream()
+    {
+    }
+
+    /**
+     * Clear captured data.
+     */
+    void clear()
+    {
+        m_length = 0U;
+    }
+
+    /**
+     * Get number of captured bytes.
+     *
+     * @return Number of captured bytes.
+     */
+    size_t getLength() const
+    {
+        return m_length;
+    }
+
+    /**
+     * Get captured data.
+     *
+     * @return Captured data.
+     */
+    const uint8_t* getData() const
+    {
+        return m_buffer;
+    }
+
+    void print(const char str[]) final
+    {
+        (void)write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+    }
+
+    void print(uint8_t value) final
+    {
+        (void)value;
+    }
+
+    void print(uint16_t value) final
+    {
+        (void)value;
+    }
+
+    void print(uint32_t value) final
+    {
+        (void)value;
+    }
+
+    void print(int8_t value) final
+    {
+        (void)value;
+    }
+
+    void print(int16_t value) final
+    {
+        (void)value;
+    }
+
+    void print(int32_t value) final
+    {
+        (void)value;
+    }
+
+    void println(const char str[]) final
+    {
+        print(str);
+    }
+
+    void println(uint8_t value) final
+    {
+        (void)value;
+    }
+
+    void println(uint16_t value) final
+    {
+        (void)value;
+    }
+
+    void println(uint32_t value) final
+    {
+        (void)value;
+    }
+
+    void println(int8_t value) final
+    {
+        (void)value;
+    }
+
+    void println(int16_t value) final
+    {
+        (void)value;
+    }
+
+    void println(int32_t value) final
+    {
+        (void)value;
+    }
+
+    size_t write(const uint8_t* buffer, size_t length) final
+    {
+        size_t idx = 0U;
+
+        while ((length > idx) && (BUFFER_SIZE > m_length))
+        {
+            m_buffer[m_length] = buffer[idx];
+            ++m_length;
+            ++idx;
+        }
+
+        return idx;
+    }
+
+    int available() const final
+    {
+        return 0;
+    }
+
+    size_t readBytes(uint8_t* buffer, size_t length) final
+    {
+        (void)buffer;
+        (void)length;
+        return 0U;
+    }
+
+private:
+    size_t  m_length;              /**< Number of captured bytes. */
+    uint8_t m_buffer[BUFFER_SIZE]; /**< Captured data. */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testDropNewest();
+static void testDropOldest();
+static void testCoalesce();
+static void testCoalesceControlChannel();
+static void testByteBudget();
+static void testLogRecord();
+static void testLogLineCut();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Logging source. */
+LOG_TAG("Test");
+
+/** Stream, which captures the data sent by the serial driver. */
+static CaptureStream gCaptureStream;
+
+/** Serial driver with emulated transmit space. */
+static Serial_ gSerial(gCaptureStream);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testDropNewest);
+    RUN_TEST(testDropOldest);
+    RUN_TEST(testCoalesce);
+    RUN_TEST(testCoalesceControlChannel);
+    RUN_TEST(testByteBudget);
+    RUN_TEST(testLogRecord);
+    RUN_TEST(testLogLineCut);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    gCaptureStream.clear();
+    gSerial.setTxSpace(Serial_::TX_SPACE_UNLIMITED);
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the drop newest overflow policy.
+ */
+static void testDropNewest()
+{
+    const uint8_t RECORD_SIZE = 30U;
+    const uint8_t RECORD_NUM  = SerialTxQueue::BUFFER_SIZE / (SerialTxQueue::RECORD_HEADER_SIZE + RECORD_SIZE);
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_DROP_NEWEST);
+    uint8_t       record[RECORD_SIZE];
+    uint8_t       idx = 0U;
+
+    /* Fill the queue completely. */
+    while (RECORD_NUM > idx)
+    {
+        memset(record, idx, sizeof(record));
+        TEST_ASSERT_TRUE(testQueue.enqueue(SerialTxQueue::KEY_NONE, record, sizeof(record)));
+        ++idx;
+    }
+
+    /* The next record doesn't fit and shall be dropped. */
+    memset(record, idx, sizeof(record));
+    TEST_ASSERT_FALSE(testQueue.enqueue(SerialTxQueue::KEY_NONE, record, sizeof(record)));
+    TEST_ASSERT_EQUAL_UINT32(1U, testQueue.getStatistics().droppedRecords);
+    TEST_ASSERT_EQUAL_UINT32(RECORD_SIZE, testQueue.getStatistics().droppedBytes);
+
+    /* A record which can never fit into the queue shall be dropped too. */
+    TEST_ASSERT_FALSE(testQueue.enqueue(SerialTxQueue::KEY_NONE, record, SerialTxQueue::BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(2U, testQueue.getStatistics().droppedRecords);
+
+    /* The oldest records shall be sent, without the record headers. */
+    TEST_ASSERT_EQUAL(RECORD_NUM * RECORD_SIZE, testQueue.process(SerialTxQueue::BUFFER_SIZE));
+    TEST_ASSERT_EQUAL(RECORD_NUM * RECORD_SIZE, gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8(0U, gCaptureStream.getData()[0U]);
+    TEST_ASSERT_EQUAL_UINT8(RECORD_NUM - 1U, gCaptureStream.getData()[gCaptureStream.getLength() - 1U]);
+    TEST_ASSERT_EQUAL_UINT16(0U, testQueue.getPendingBytes());
+}
+
+/**
+ * Test the drop oldest overflow policy.
+ */
+static void testDropOldest()
+{
+    const uint8_t RECORD_SIZE = 30U;
+    const uint8_t RECORD_NUM  = SerialTxQueue::BUFFER_SIZE / (SerialTxQueue::RECORD_HEADER_SIZE + RECORD_SIZE);
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_DROP_OLDEST);
+    uint8_t       record[RECORD_SIZE];
+    uint8_t       idx = 0U;
+
+    /* Fill the queue and overflow it by one record. */
+    while (RECORD_NUM >= idx)
+    {
+        memset(record, idx, sizeof(record));
+        TEST_ASSERT_TRUE(testQueue.enqueue(SerialTxQueue::KEY_NONE, record, sizeof(record)));
+        ++idx;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1U, testQueue.getStatistics().droppedRecords);
+
+    /* The first record shall be lost. */
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(RECORD_NUM * RECORD_SIZE, gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8(1U, gCaptureStream.getData()[0U]);
+    TEST_ASSERT_EQUAL_UINT8(RECORD_NUM, gCaptureStream.getData()[gCaptureStream.getLength() - 1U]);
+
+    /* A partially sent record shall be completed, even if newer records overflow the queue. */
+    gCaptureStream.clear();
+    idx = 0U;
+    while (RECORD_NUM > idx)
+    {
+        memset(record, idx, sizeof(record));
+        TEST_ASSERT_TRUE(testQueue.enqueue(SerialTxQueue::KEY_NONE, record, sizeof(record)));
+        ++idx;
+    }
+
+    TEST_ASSERT_EQUAL(RECORD_SIZE / 2U, testQueue.process(RECORD_SIZE / 2U));
+
+    memset(record, 0xAAU, sizeof(record));
+    TEST_ASSERT_TRUE(testQueue.enqueue(SerialTxQueue::KEY_NONE, record, sizeof(record)));
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(RECORD_NUM * RECORD_SIZE, gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8(0U, gCaptureStream.getData()[RECORD_SIZE - 1U]);
+    TEST_ASSERT_EQUAL_UINT8(2U, gCaptureStream.getData()[RECORD_SIZE]);
+    TEST_ASSERT_EQUAL_UINT8(0xAAU, gCaptureStream.getData()[gCaptureStream.getLength() - 1U]);
+}
+
+/**
+ * Test the coalesce overflow policy.
+ */
+static void testCoalesce()
+{
+    const uint8_t FRAME_A1[] = {1U, 10U, 11U};
+    const uint8_t FRAME_B[]  = {2U, 20U, 21U};
+    const uint8_t FRAME_A2[] = {1U, 12U, 13U};
+    const uint8_t EXPECTED[] = {1U, 12U, 13U, 2U, 20U, 21U};
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_COALESCE);
+
+    /* The first byte is the key, like the channel id of a SerialMuxProt frame. */
+    TEST_ASSERT_EQUAL(sizeof(FRAME_A1), testQueue.write(FRAME_A1, sizeof(FRAME_A1)));
+    TEST_ASSERT_EQUAL(sizeof(FRAME_B), testQueue.write(FRAME_B, sizeof(FRAME_B)));
+    TEST_ASSERT_EQUAL(sizeof(FRAME_A2), testQueue.write(FRAME_A2, sizeof(FRAME_A2)));
+    TEST_ASSERT_EQUAL_UINT32(1U, testQueue.getStatistics().coalescedRecords);
+
+    /* The latest frame shall replace the pending one at its position. */
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), testQueue.process(SerialTxQueue::BUFFER_SIZE));
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED, gCaptureStream.getData(), sizeof(EXPECTED));
+}
+
+/**
+ * Test that frames of the SerialMuxProt control channel are never coalesced.
+ */
+static void testCoalesceControlChannel()
+{
+    const uint8_t FRAME_SCRB_RSP_1[] = {0U, 1U, 1U};
+    const uint8_t FRAME_SCRB_RSP_2[] = {0U, 1U, 2U};
+    const uint8_t EXPECTED[]         = {0U, 1U, 1U, 0U, 1U, 2U};
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_COALESCE);
+
+    TEST_ASSERT_EQUAL(sizeof(FRAME_SCRB_RSP_1), testQueue.write(FRAME_SCRB_RSP_1, sizeof(FRAME_SCRB_RSP_1)));
+    TEST_ASSERT_EQUAL(sizeof(FRAME_SCRB_RSP_2), testQueue.write(FRAME_SCRB_RSP_2, sizeof(FRAME_SCRB_RSP_2)));
+    TEST_ASSERT_EQUAL_UINT32(0U, testQueue.getStatistics().coalescedRecords);
+
+    /* Both control frames shall be sent in order. */
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), testQueue.process(SerialTxQueue::BUFFER_SIZE));
+    TEST_ASSERT_EQUAL(sizeof(EXPECTED), gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(EXPECTED, gCaptureStream.getData(), sizeof(EXPECTED));
+}
+
+/**
+ * Test that the queue never hands over more data than the serial driver accepts.
+ */
+static void testByteBudget()
+{
+    const uint8_t RECORD[] = {1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U};
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_DROP_NEWEST);
+
+    TEST_ASSERT_TRUE(testQueue.enqueue(SerialTxQueue::KEY_NONE, RECORD, sizeof(RECORD)));
+
+    /* A stalled host shall not block. */
+    gSerial.setTxSpace(0);
+    TEST_ASSERT_EQUAL(0U, testQueue.process(SerialTxQueue::BUFFER_SIZE));
+
+    /* Limited by the transmit space of the serial driver. */
+    gSerial.setTxSpace(3);
+    TEST_ASSERT_EQUAL(3U, testQueue.process(SerialTxQueue::BUFFER_SIZE));
+
+    /* Limited by the budget. */
+    gSerial.setTxSpace(Serial_::TX_SPACE_UNLIMITED);
+    TEST_ASSERT_EQUAL(2U, testQueue.process(2U));
+    TEST_ASSERT_EQUAL(3U, testQueue.process(SerialTxQueue::BUFFER_SIZE));
+
+    TEST_ASSERT_EQUAL(sizeof(RECORD), gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(RECORD, gCaptureStream.getData(), sizeof(RECORD));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(RECORD), testQueue.getStatistics().sentBytes);
+    TEST_ASSERT_EQUAL_UINT16(0U, testQueue.getPendingBytes());
+}
+
+/**
+ * Test that a log record, which is printed in several parts, is queued
+ * as one record and is therefore never dropped partially.
+ */
+static void testLogRecord()
+{
+    const char    TAIL[]      = "part 1 part 2\n";
+    const size_t  TAIL_LENGTH = sizeof(TAIL) - 1U;
+    const uint8_t FILLER_SIZE = 100U;
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_DROP_NEWEST);
+    uint8_t       filler[FILLER_SIZE];
+    uint16_t      pendingBytes = 0U;
+
+    Logging::setOutput(testQueue);
+
+    /* The queue has space for the head only, so the whole record shall be dropped. */
+    memset(filler, 0, sizeof(filler));
+    TEST_ASSERT_TRUE(testQueue.enqueue(SerialTxQueue::KEY_NONE, filler, sizeof(filler)));
+    pendingBytes = testQueue.getPendingBytes();
+
+    LOG_INFO_HEAD();
+    LOG_INFO_MSG("part 1 ");
+    LOG_INFO_MSG(F("part 2"));
+    TEST_ASSERT_EQUAL_UINT16(pendingBytes, testQueue.getPendingBytes());
+    LOG_INFO_TAIL();
+    TEST_ASSERT_EQUAL_UINT16(pendingBytes, testQueue.getPendingBytes());
+    TEST_ASSERT_EQUAL_UINT32(1U, testQueue.getStatistics().droppedRecords);
+
+    /* With enough space, the record shall be queued and sent completely. */
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    gCaptureStream.clear();
+
+    LOG_INFO_HEAD();
+    LOG_INFO_MSG("part 1 ");
+    LOG_INFO_MSG(F("part 2"));
+    LOG_INFO_TAIL();
+    TEST_ASSERT_EQUAL_UINT32(1U, testQueue.getStatistics().droppedRecords);
+
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    TEST_ASSERT_TRUE(TAIL_LENGTH < gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(TAIL, &gCaptureStream.getData()[gCaptureStream.getLength() - TAIL_LENGTH],
+                                  TAIL_LENGTH);
+    TEST_ASSERT_EQUAL_UINT16(0U, testQueue.getPendingBytes());
+
+    Logging::setOutput(Serial);
+}
+
+/**
+ * Test that a log message, which is longer than a log line, is cut but
+ * keeps its line feed, so the next record starts in a new line.
+ */
+static void testLogLineCut()
+{
+    SerialTxQueue testQueue(gSerial, SerialTxQueue::POLICY_DROP_NEWEST);
+    char          message[2U * Logging::LINE_SIZE];
+
+    memset(message, 'x', sizeof(message) - 1U);
+    message[sizeof(message) - 1U] = '\0';
+
+    Logging::setOutput(testQueue);
+
+    Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_INFO, message);
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(Logging::LINE_SIZE - 1U, gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8('x', gCaptureStream.getData()[gCaptureStream.getLength() - 2U]);
+    TEST_ASSERT_EQUAL_UINT8('\n', gCaptureStream.getData()[gCaptureStream.getLength() - 1U]);
+
+    gCaptureStream.clear();
+    LOG_INFO_HEAD();
+    LOG_INFO_MSG(message);
+    LOG_INFO_TAIL();
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(Logging::LINE_SIZE - 1U, gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8('\n', gCaptureStream.getData()[gCaptureStream.getLength() - 1U]);
+
+    gCaptureStream.clear();
+    Logging::print(LOG_FLASH_TAG, __LINE__, Logging::LOG_LEVEL_INFO, message, static_cast<uint32_t>(1U));
+    (void)testQueue.process(SerialTxQueue::BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(Logging::LINE_SIZE - 1U, gCaptureStream.getLength());
+    TEST_ASSERT_EQUAL_UINT8('\n', gCaptureStream.getData()[gCaptureStream.getLength() - 1U]);
+
+    Logging::setOutput(Serial);
+}
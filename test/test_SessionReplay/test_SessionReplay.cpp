@@ -0,0 +1,378 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SessionRecorder.h>
+#include <SessionReplay.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Host stream, which provides prepared inbound bytes and counts the outbound bytes.
+ */
+class TestStream : public Stream
+{
+public:
+    /**
+     * Constructs the test stream.
+     */
+    TestStream() : Stream(), m_inbound(nullptr), m_inboundLength(0U), m_outboundLength(0U)
+    {
+    }
+
+    /**
+     * Set the inbound bytes, which are available to read.
+     *
+     * @param[in] data      Inbound bytes
+     * @param[in] length    Number of inbound bytes
+     */
+    void setInbound(const uint8_t* data, size_t length)
+    {
+        m_inbound       = data;
+        m_inboundLength = length;
+    }
+
+    void print(const char str[]) final
+    {
+        (void)str;
+    }
+
+    void print(uint8_t value) final
+    {
+        (void)value;
+    }
+
+    void print(uint16_t value) final
+    {
+        (void)value;
+    }
+
+    void print(uint32_t value) final
+    {
+        (void)value;
+    }
+
+    void print(int8_t value) final
+    {
+        (void)value;
+    }
+
+    void print(int16_t value) final
+    {
+        (void)value;
+    }
+
+    void print(int32_t value) final
+    {
+        (void)value;
+    }
+
+    void println(const char str[]) final
+    {
+        (void)str;
+    }
+
+    void println(uint8_t value) final
+    {
+        (void)value;
+    }
+
+    void println(uint16_t value) final
+    {
+        (void)value;
+    }
+
+    void println(uint32_t value) final
+    {
+        (void)value;
+    }
+
+    void println(int8_t value) final
+    {
+        (void)value;
+    }
+
+    void println(int16_t value) final
+    {
+        (void)value;
+    }
+
+    void println(int32_t value) final
+    {
+        (void)value;
+    }
+
+    size_t write(const uint8_t* buffer, size_t length) final
+    {
+        (void)buffer;
+        m_outboundLength += length;
+
+        return length;
+    }
+
+    int available() const final
+    {
+        return static_cast<int>(m_inboundLength);
+    }
+
+    size_t readBytes(uint8_t* buffer, size_t length) final
+    {
+        size_t count = (length < m_inboundLength) ? length : m_inboundLength;
+
+        memcpy(buffer, m_inbound, count);
+        m_inbound += count;
+        m_inboundLength -= count;
+
+        return count;
+    }
+
+private:
+    const uint8_t* m_inbound;        /**< Inbound bytes */
+    size_t         m_inboundLength;  /**< Number of inbound bytes */
+    size_t         m_outboundLength; /**< Number of outbound bytes */
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void recordSession();
+static void testInjection();
+static void testEqualSession();
+static void testDifferentContent();
+static void testDifferentTiming();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Name of the recorded session file. */
+static const char* SESSION_FILE_NAME = "test_session.bin";
+
+/** Command, which the host sends at 10 ms. */
+static const uint8_t CMD[] = {0x01U, 0x02U, 0x03U};
+
+/** Response, which the robot sends at 20 ms. */
+static const uint8_t RSP[] = {0xA1U, 0xA2U};
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    recordSession();
+
+    RUN_TEST(testInjection);
+    RUN_TEST(testEqualSession);
+    RUN_TEST(testDifferentContent);
+    RUN_TEST(testDifferentTiming);
+
+    (void)remove(SESSION_FILE_NAME);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Record the session, which is used by all tests: The command is received
+ * at 10 ms, read in two parts and the response is sent at 20 ms.
+ */
+static void recordSession()
+{
+    TestStream      hostStream;
+    SessionRecorder recorder(hostStream);
+    uint8_t         buffer[sizeof(CMD)];
+
+    TEST_ASSERT_TRUE(recorder.open(SESSION_FILE_NAME));
+
+    recorder.process(0U);
+    TEST_ASSERT_EQUAL(0, recorder.available());
+
+    hostStream.setInbound(CMD, sizeof(CMD));
+    recorder.process(10U);
+    TEST_ASSERT_EQUAL(sizeof(CMD), recorder.available());
+    TEST_ASSERT_EQUAL(1U, recorder.readBytes(buffer, 1U));
+    TEST_ASSERT_EQUAL(2U, recorder.readBytes(&buffer[1], 2U));
+
+    recorder.process(20U);
+    TEST_ASSERT_EQUAL(sizeof(RSP), recorder.write(RSP, sizeof(RSP)));
+
+    recorder.close();
+}
+
+/**
+ * Test that the inbound bytes are injected at the recorded time.
+ */
+static void testInjection()
+{
+    SessionReplay replay;
+    uint8_t       buffer[sizeof(CMD)];
+
+    TEST_ASSERT_FALSE(replay.load("not_existing_session.bin"));
+    TEST_ASSERT_TRUE(replay.load(SESSION_FILE_NAME));
+
+    replay.process(9U);
+    TEST_ASSERT_EQUAL(0, replay.available());
+
+    /* Both reads are merged into one record. */
+    replay.process(10U);
+    TEST_ASSERT_EQUAL(sizeof(CMD), replay.available());
+    TEST_ASSERT_EQUAL(sizeof(CMD), replay.readBytes(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(CMD, buffer, sizeof(CMD));
+    TEST_ASSERT_EQUAL(0, replay.available());
+
+    replay.process(20U + SessionReplay::FINISH_DELAY - 1U);
+    TEST_ASSERT_FALSE(replay.isFinished());
+    replay.process(20U + SessionReplay::FINISH_DELAY);
+    TEST_ASSERT_TRUE(replay.isFinished());
+}
+
+/**
+ * Test that a equal session passes.
+ */
+static void testEqualSession()
+{
+    SessionReplay replay;
+
+    TEST_ASSERT_TRUE(replay.load(SESSION_FILE_NAME));
+
+    replay.process(20U);
+    TEST_ASSERT_EQUAL(sizeof(RSP), replay.write(RSP, sizeof(RSP)));
+    TEST_ASSERT_TRUE(replay.report());
+}
+
+/**
+ * Test that different and missing outbound bytes fail.
+ */
+static void testDifferentContent()
+{
+    SessionReplay replay;
+    uint8_t       rsp[sizeof(RSP)];
+
+    memcpy(rsp, RSP, sizeof(rsp));
+    rsp[1] ^= 0xFFU;
+
+    TEST_ASSERT_TRUE(replay.load(SESSION_FILE_NAME));
+    replay.process(20U);
+    (void)replay.write(rsp, sizeof(rsp));
+    TEST_ASSERT_FALSE(replay.report());
+
+    /* Nothing written at all. */
+    TEST_ASSERT_TRUE(replay.load(SESSION_FILE_NAME));
+    TEST_ASSERT_FALSE(replay.report());
+}
+
+/**
+ * Test that a response at another time fails.
+ */
+static void testDifferentTiming()
+{
+    SessionReplay replay;
+
+    TEST_ASSERT_TRUE(replay.load(SESSION_FILE_NAME));
+
+    replay.process(25U);
+    (void)replay.write(RSP, sizeof(RSP));
+    TEST_ASSERT_FALSE(replay.report());
+}
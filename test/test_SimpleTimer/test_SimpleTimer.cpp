@@ -54,6 +54,7 @@
  *****************************************************************************/
 
 static void testSimpleTimer();
+static void testSimpleTimerAdvance();
 
 /******************************************************************************
  * Local Variables
@@ -94,6 +95,7 @@ void loop()
     UNITY_BEGIN();
 
     RUN_TEST(testSimpleTimer);
+    RUN_TEST(testSimpleTimerAdvance);
 
     UNITY_END();
 
@@ -166,3 +168,29 @@ static void testSimpleTimer()
     /* Verify timer duration till now. */
     TEST_ASSERT_GREATER_OR_EQUAL(WAIT_TIME + DELTA_MIN, testTimer.getCurrentDuration());
 }
+
+/**
+ * Test the phase-locked restart of the SimpleTimer class.
+ */
+static void testSimpleTimerAdvance()
+{
+    const uint32_t PERIOD = 100;
+    const uint32_t LATE   = 30;
+    SimpleTimer    testTimer;
+
+    /* Timeout noticed late. The next period shall start when the previous was due. */
+    testTimer.start(PERIOD);
+    delay(PERIOD + LATE);
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+    testTimer.advance();
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_GREATER_OR_EQUAL(LATE, testTimer.getCurrentDuration());
+    TEST_ASSERT_LESS_THAN(PERIOD, testTimer.getCurrentDuration());
+
+    /* More than one period missed. The timer shall be resynchronized to now. */
+    delay(2U * PERIOD);
+    TEST_ASSERT_TRUE(testTimer.isTimeout());
+    testTimer.advance();
+    TEST_ASSERT_FALSE(testTimer.isTimeout());
+    TEST_ASSERT_LESS_THAN(LATE, testTimer.getCurrentDuration());
+}
@@ -0,0 +1,323 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Snapshot.h>
+#include <SimpleTimer.h>
+#include <PIDController.h>
+#include <Odometry.h>
+#include <StateMachine.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** A state without any behaviour, which is only used as state table entry. */
+class TestState : public IState
+{
+public:
+    TestState()
+    {
+    }
+
+    ~TestState()
+    {
+    }
+
+    void entry() final
+    {
+    }
+
+    void process(StateMachine& sm) final
+    {
+        (void)sm;
+    }
+
+    void exit() final
+    {
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testSnapshot();
+static void testPIDController();
+static void testSimpleTimer();
+static void testOdometry();
+static void testStateMachine();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testSnapshot);
+    RUN_TEST(testPIDController);
+    RUN_TEST(testSimpleTimer);
+    RUN_TEST(testOdometry);
+    RUN_TEST(testStateMachine);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the snapshot buffer handling.
+ */
+static void testSnapshot()
+{
+    Snapshot snapshot;
+    uint8_t  data[Snapshot::MAX_SIZE];
+    int32_t  value32 = -123456;
+    uint8_t  value8  = 42U;
+
+    TEST_ASSERT_TRUE(snapshot.put(value32));
+    TEST_ASSERT_TRUE(snapshot.put(value8));
+    TEST_ASSERT_EQUAL(sizeof(value32) + sizeof(value8), snapshot.getSize());
+
+    /* Values are read back in the same order. */
+    value32 = 0;
+    value8  = 0U;
+    TEST_ASSERT_TRUE(snapshot.get(value32));
+    TEST_ASSERT_TRUE(snapshot.get(value8));
+    TEST_ASSERT_EQUAL_INT32(-123456, value32);
+    TEST_ASSERT_EQUAL_UINT8(42U, value8);
+    TEST_ASSERT_TRUE(snapshot.isValid());
+
+    /* Reading more than written invalidates the snapshot. */
+    TEST_ASSERT_FALSE(snapshot.get(value8));
+    TEST_ASSERT_FALSE(snapshot.isValid());
+
+    /* Writing more than the capacity invalidates the snapshot. */
+    snapshot.clear();
+    TEST_ASSERT_TRUE(snapshot.isValid());
+    TEST_ASSERT_TRUE(snapshot.write(data, sizeof(data)));
+    TEST_ASSERT_FALSE(snapshot.put(value8));
+    TEST_ASSERT_FALSE(snapshot.isValid());
+
+    /* Load from external data. */
+    TEST_ASSERT_TRUE(snapshot.load(reinterpret_cast<const uint8_t*>(&value32), sizeof(value32)));
+    value32 = 0;
+    TEST_ASSERT_TRUE(snapshot.get(value32));
+    TEST_ASSERT_EQUAL_INT32(-123456, value32);
+}
+
+/**
+ * Test that a restored PID controller continues like the original one.
+ */
+static void testPIDController()
+{
+    PIDController<int16_t> pidOriginal(1, 2, 1, 10, 1, 4, 1000, -1000);
+    PIDController<int16_t> pidFork;
+    Snapshot               snapshot;
+    int16_t                idx;
+
+    pidOriginal.setSampleTime(0);
+
+    for (idx = 0; idx < 10; ++idx)
+    {
+        (void)pidOriginal.calculate(500, idx * 20);
+    }
+
+    pidOriginal.save(snapshot);
+    pidFork.restore(snapshot);
+    TEST_ASSERT_TRUE(snapshot.isValid());
+
+    for (idx = 10; idx < 20; ++idx)
+    {
+        TEST_ASSERT_EQUAL_INT16(pidOriginal.calculate(500, idx * 20), pidFork.calculate(500, idx * 20));
+    }
+}
+
+/**
+ * Test that a restored timer keeps its elapsed time.
+ */
+static void testSimpleTimer()
+{
+    SimpleTimer timerOriginal;
+    SimpleTimer timerFork;
+    Snapshot    snapshot;
+
+    timerOriginal.start(1000U);
+    timerOriginal.save(snapshot);
+    timerFork.restore(snapshot);
+
+    TEST_ASSERT_TRUE(snapshot.isValid());
+    TEST_ASSERT_TRUE(timerFork.isRunning());
+    TEST_ASSERT_FALSE(timerFork.isTimeout());
+    TEST_ASSERT_UINT32_WITHIN(1U, timerOriginal.getCurrentDuration(), timerFork.getCurrentDuration());
+}
+
+/**
+ * Test that the odometry and the state machine go back to the saved instant.
+ */
+static void testOdometry()
+{
+    Odometry&    odometry = Odometry::getInstance();
+    StateMachine stateMachine;
+    Snapshot     snapshot;
+    int32_t      posX = 0;
+    int32_t      posY = 0;
+
+    odometry.setPosition(100, -200);
+    odometry.setOrientation(1234);
+    stateMachine.save(snapshot, nullptr, 0U);
+    odometry.save(snapshot);
+
+    odometry.setPosition(0, 0);
+    odometry.setOrientation(0);
+
+    snapshot.rewind();
+    TEST_ASSERT_TRUE(stateMachine.restore(snapshot, nullptr, 0U));
+    odometry.restore(snapshot);
+    TEST_ASSERT_TRUE(snapshot.isValid());
+    TEST_ASSERT_NULL(stateMachine.getState());
+
+    odometry.getPosition(posX, posY);
+    TEST_ASSERT_EQUAL_INT32(100, posX);
+    TEST_ASSERT_EQUAL_INT32(-200, posY);
+    TEST_ASSERT_EQUAL_INT32(1234, odometry.getOrientation());
+}
+
+/**
+ * Test that the state machine restores its state by state table index
+ * and rejects a state, which is not in the table.
+ */
+static void testStateMachine()
+{
+    TestState     stateA;
+    TestState     stateB;
+    TestState     stateUnknown;
+    IState* const states[] = {&stateA, &stateB};
+    const uint8_t NUM_STATES = sizeof(states) / sizeof(states[0U]);
+    StateMachine  stateMachine;
+    StateMachine  stateMachineFork;
+    Snapshot      snapshot;
+
+    stateMachine.setState(&stateB);
+    stateMachine.process();
+    stateMachine.save(snapshot, states, NUM_STATES);
+
+    snapshot.rewind();
+    TEST_ASSERT_TRUE(stateMachineFork.restore(snapshot, states, NUM_STATES));
+    TEST_ASSERT_TRUE(snapshot.isValid());
+    TEST_ASSERT_TRUE(&stateB == stateMachineFork.getState());
+
+    /* The state table of the restoring process lacks the saved state. */
+    snapshot.rewind();
+    TEST_ASSERT_FALSE(stateMachineFork.restore(snapshot, states, 1U));
+
+    /* A state, which is not in the table, can't be saved. */
+    snapshot.clear();
+    stateMachine.setState(&stateUnknown);
+    stateMachine.process();
+    stateMachine.save(snapshot, states, NUM_STATES);
+
+    snapshot.rewind();
+    TEST_ASSERT_FALSE(stateMachineFork.restore(snapshot, states, NUM_STATES));
+}
@@ -0,0 +1,199 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SpeedGovernor.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testPlatoonLength();
+static void testThroughput();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Period in ms between two throughput calculations. */
+static const uint32_t STEP_PERIOD = 100U;
+
+/** Distance in mm, which the leader drives per period. */
+static const uint32_t STEP_DISTANCE = 100U;
+
+/** Leader speed in mm/s. */
+static const uint16_t LEADER_SPEED = (STEP_DISTANCE * 1000U) / STEP_PERIOD;
+
+/** Tolerance of the throughput in mm/s, because the periods are measured. */
+static const uint16_t THROUGHPUT_TOLERANCE = 100U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testPlatoonLength);
+    RUN_TEST(testThroughput);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test that the platoon length sums up the gaps of all followers.
+ */
+static void testPlatoonLength()
+{
+    SpeedGovernor& governor = SpeedGovernor::getInstance();
+
+    TEST_ASSERT_EQUAL_INT32(0, governor.getPlatoonLength());
+
+    TEST_ASSERT_TRUE(governor.reportFollower(1U, 100, SpeedGovernor::HEALTH_FULL));
+    TEST_ASSERT_TRUE(governor.reportFollower(2U, 200, SpeedGovernor::HEALTH_FULL));
+    TEST_ASSERT_TRUE(governor.reportFollower(3U, 150, SpeedGovernor::HEALTH_FULL));
+    TEST_ASSERT_EQUAL_UINT8(3U, governor.getNumFollowers());
+    TEST_ASSERT_EQUAL_INT16(200, governor.getWorstGap());
+    TEST_ASSERT_EQUAL_INT32(450, governor.getPlatoonLength());
+
+    /* Let them expire. */
+    delay(SpeedGovernor::REPORT_TIMEOUT + 1U);
+    TEST_ASSERT_TRUE(governor.reportFollower(1U, 100, SpeedGovernor::HEALTH_FULL));
+    TEST_ASSERT_EQUAL_UINT8(1U, governor.getNumFollowers());
+    TEST_ASSERT_EQUAL_INT32(100, governor.getPlatoonLength());
+}
+
+/**
+ * Test the throughput of a platoon with two followers, while one of them
+ * stops reporting and expires. The tail doesn't jump, when it leaves.
+ */
+static void testThroughput()
+{
+    SpeedGovernor& governor  = SpeedGovernor::getInstance();
+    uint32_t       mileage   = 1000U;
+    uint32_t       timestamp = 0U;
+
+    TEST_ASSERT_TRUE(governor.reportFollower(1U, 100, SpeedGovernor::HEALTH_FULL));
+    TEST_ASSERT_TRUE(governor.reportFollower(2U, 200, SpeedGovernor::HEALTH_FULL));
+
+    /* A follower joined, the throughput is measured from now on. */
+    (void)governor.calculateThroughput(mileage);
+    timestamp = millis();
+
+    /* The leader drives with constant speed and the gaps stay constant.
+     * Only follower 2 keeps reporting, follower 1 expires in the meantime.
+     */
+    while ((timestamp + (2U * SpeedGovernor::REPORT_TIMEOUT)) > millis())
+    {
+        delay(STEP_PERIOD);
+        mileage += STEP_DISTANCE;
+
+        TEST_ASSERT_TRUE(governor.reportFollower(2U, 200, SpeedGovernor::HEALTH_FULL));
+        TEST_ASSERT_UINT16_WITHIN(THROUGHPUT_TOLERANCE, LEADER_SPEED, governor.calculateThroughput(mileage));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(1U, governor.getNumFollowers());
+    TEST_ASSERT_EQUAL_INT32(200, governor.getPlatoonLength());
+}
@@ -0,0 +1,374 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Telemetry.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int32_t getValueA();
+static int32_t getValueB();
+static void    sampleValues();
+static void    testRegistration();
+static void    testDecimation();
+static void    testDataFrame();
+static void    testSchemaFrame();
+static void    testSampler();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Value provided by signal A. */
+static int32_t gValueA = 0;
+
+/** Value provided by signal B. */
+static int32_t gValueB = 0;
+
+/** Number of sampler calls. */
+static uint8_t gSampleCnt = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testRegistration);
+    RUN_TEST(testDecimation);
+    RUN_TEST(testDataFrame);
+    RUN_TEST(testSchemaFrame);
+    RUN_TEST(testSampler);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    gValueA    = 0;
+    gValueB    = 0;
+    gSampleCnt = 0U;
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Get value of signal A.
+ *
+ * @return Value
+ */
+static int32_t getValueA()
+{
+    return gValueA;
+}
+
+/**
+ * Get value of signal B.
+ *
+ * @return Value
+ */
+static int32_t getValueB()
+{
+    return gValueB;
+}
+
+/**
+ * Take a snapshot of both signal values at once.
+ */
+static void sampleValues()
+{
+    ++gSampleCnt;
+    gValueA = gSampleCnt;
+    gValueB = -gSampleCnt;
+}
+
+/**
+ * Test signal registration and selection limits.
+ */
+static void testRegistration()
+{
+    Telemetry telemetry;
+    uint8_t   idx;
+    uint8_t   signalIdx;
+    uint8_t   layoutId;
+
+    /* Invalid parameters are rejected. */
+    TEST_ASSERT_EQUAL_UINT8(Telemetry::INVALID_SIGNAL,
+                            telemetry.registerSignal(nullptr, Telemetry::TYPE_INT8, getValueA));
+    TEST_ASSERT_EQUAL_UINT8(Telemetry::INVALID_SIGNAL, telemetry.registerSignal("A", Telemetry::TYPE_INT8, nullptr));
+    TEST_ASSERT_EQUAL_UINT8(Telemetry::INVALID_SIGNAL,
+                            telemetry.registerSignal("A", Telemetry::TYPE_INT8, getValueA, 1, 0));
+
+    /* The registration is limited. */
+    for (idx = 0U; idx < Telemetry::MAX_SIGNALS; ++idx)
+    {
+        TEST_ASSERT_EQUAL_UINT8(idx, telemetry.registerSignal("A", Telemetry::TYPE_INT32, getValueA));
+    }
+    TEST_ASSERT_EQUAL_UINT8(Telemetry::INVALID_SIGNAL, telemetry.registerSignal("A", Telemetry::TYPE_INT8, getValueA));
+
+    /* Unknown signals can not be selected. */
+    TEST_ASSERT_FALSE(telemetry.select(Telemetry::MAX_SIGNALS));
+
+    /* The selection is limited by the data frame payload: 7 x 4 byte fit into 30 byte. */
+    layoutId = telemetry.getLayoutId();
+    for (signalIdx = 0U; signalIdx < 7U; ++signalIdx)
+    {
+        TEST_ASSERT_TRUE(telemetry.select(signalIdx));
+    }
+    TEST_ASSERT_FALSE(telemetry.select(signalIdx));
+    TEST_ASSERT_EQUAL_UINT8(7U, telemetry.getNumSchemaFrames());
+    TEST_ASSERT_NOT_EQUAL(layoutId, telemetry.getLayoutId());
+
+    /* Unselecting frees the payload again. */
+    layoutId = telemetry.getLayoutId();
+    telemetry.unselectAll();
+    TEST_ASSERT_EQUAL_UINT8(0U, telemetry.getNumSchemaFrames());
+    TEST_ASSERT_NOT_EQUAL(layoutId, telemetry.getLayoutId());
+    TEST_ASSERT_TRUE(telemetry.select(0U));
+}
+
+/**
+ * Test the data frame decimation.
+ */
+static void testDecimation()
+{
+    Telemetry            telemetry;
+    Telemetry::DataFrame frame;
+    uint8_t              layoutId;
+    uint8_t              idx;
+
+    /* Nothing selected, nothing to send. */
+    TEST_ASSERT_FALSE(telemetry.process(frame));
+
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("A", Telemetry::TYPE_UINT8, getValueA)));
+
+    /* Without decimation every cycle provides a frame. */
+    TEST_ASSERT_EQUAL_UINT8(1U, telemetry.getDecimation());
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+
+    /* The decimation is part of the layout. */
+    layoutId = telemetry.getLayoutId();
+    telemetry.setDecimation(3U);
+    TEST_ASSERT_EQUAL_UINT8(3U, telemetry.getDecimation());
+    TEST_ASSERT_NOT_EQUAL(layoutId, telemetry.getLayoutId());
+
+    for (idx = 0U; idx < 3U; ++idx)
+    {
+        TEST_ASSERT_FALSE(telemetry.process(frame));
+        TEST_ASSERT_FALSE(telemetry.process(frame));
+        TEST_ASSERT_TRUE(telemetry.process(frame));
+    }
+
+    /* A decimation of 0 is treated as 1. */
+    telemetry.setDecimation(0U);
+    TEST_ASSERT_EQUAL_UINT8(1U, telemetry.getDecimation());
+}
+
+/**
+ * Test the data frame content.
+ */
+static void testDataFrame()
+{
+    Telemetry            telemetry;
+    Telemetry::DataFrame frame;
+    uint8_t              sequence;
+    uint8_t              idx;
+
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("A", Telemetry::TYPE_INT16, getValueA)));
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("B", Telemetry::TYPE_UINT32, getValueB)));
+
+    memset(&frame, 0xAA, sizeof(frame));
+    gValueA = -2;
+    gValueB = 0x12345678;
+
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+    TEST_ASSERT_EQUAL_UINT8(telemetry.getLayoutId(), frame.layoutId);
+    sequence = frame.sequence;
+
+    /* Little endian packed, in selection order. */
+    TEST_ASSERT_EQUAL_UINT8(0xFE, frame.values[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, frame.values[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x78, frame.values[2]);
+    TEST_ASSERT_EQUAL_UINT8(0x56, frame.values[3]);
+    TEST_ASSERT_EQUAL_UINT8(0x34, frame.values[4]);
+    TEST_ASSERT_EQUAL_UINT8(0x12, frame.values[5]);
+
+    /* Unused bytes are cleared. */
+    for (idx = 6U; idx < sizeof(frame.values); ++idx)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0U, frame.values[idx]);
+    }
+
+    /* Every frame has its own sequence number. */
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(sequence + 1U), frame.sequence);
+}
+
+/**
+ * Test the schema frames, which describe the data frame.
+ */
+static void testSchemaFrame()
+{
+    Telemetry              telemetry;
+    Telemetry::SchemaFrame frame;
+
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("A", Telemetry::TYPE_INT16, getValueA)));
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("LONGNAME", Telemetry::TYPE_UINT32, getValueB, 3, 7)));
+    telemetry.setDecimation(2U);
+
+    TEST_ASSERT_FALSE(telemetry.getSchemaFrame(2U, frame));
+
+    TEST_ASSERT_TRUE(telemetry.getSchemaFrame(0U, frame));
+    TEST_ASSERT_EQUAL_UINT8(telemetry.getLayoutId(), frame.layoutId);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame.index);
+    TEST_ASSERT_EQUAL_UINT8(2U, frame.count);
+    TEST_ASSERT_EQUAL_UINT8(Telemetry::TYPE_INT16, frame.type);
+    TEST_ASSERT_EQUAL_UINT8(0U, frame.offset);
+    TEST_ASSERT_EQUAL_UINT8(2U, frame.decimation);
+    TEST_ASSERT_EQUAL_INT16(1, frame.scaleNumerator);
+    TEST_ASSERT_EQUAL_INT16(1, frame.scaleDenominator);
+    TEST_ASSERT_EQUAL_STRING_LEN("A", frame.name, 2U);
+
+    TEST_ASSERT_TRUE(telemetry.getSchemaFrame(1U, frame));
+    TEST_ASSERT_EQUAL_UINT8(1U, frame.index);
+    TEST_ASSERT_EQUAL_UINT8(Telemetry::TYPE_UINT32, frame.type);
+    TEST_ASSERT_EQUAL_UINT8(2U, frame.offset);
+    TEST_ASSERT_EQUAL_INT16(3, frame.scaleNumerator);
+    TEST_ASSERT_EQUAL_INT16(7, frame.scaleDenominator);
+    TEST_ASSERT_EQUAL_MEMORY("LONGNAME", frame.name, Telemetry::MAX_NAME_LENGTH);
+}
+
+/**
+ * Test the sampler, which takes the snapshot once per data frame.
+ */
+static void testSampler()
+{
+    Telemetry            telemetry;
+    Telemetry::DataFrame frame;
+
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("A", Telemetry::TYPE_INT8, getValueA)));
+    TEST_ASSERT_TRUE(telemetry.select(telemetry.registerSignal("B", Telemetry::TYPE_INT8, getValueB)));
+    telemetry.setSampler(sampleValues);
+    telemetry.setDecimation(2U);
+
+    /* No snapshot is taken, if no data frame is composed. */
+    TEST_ASSERT_FALSE(telemetry.process(frame));
+    TEST_ASSERT_EQUAL_UINT8(0U, gSampleCnt);
+
+    /* One snapshot for all signals in the data frame. */
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+    TEST_ASSERT_EQUAL_UINT8(1U, gSampleCnt);
+    TEST_ASSERT_EQUAL_UINT8(0x01U, frame.values[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFFU, frame.values[1]);
+
+    TEST_ASSERT_FALSE(telemetry.process(frame));
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+    TEST_ASSERT_EQUAL_UINT8(2U, gSampleCnt);
+    TEST_ASSERT_EQUAL_UINT8(0x02U, frame.values[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFEU, frame.values[1]);
+
+    /* Without sampler, the getters provide the values directly. */
+    telemetry.setSampler(nullptr);
+    TEST_ASSERT_FALSE(telemetry.process(frame));
+    TEST_ASSERT_TRUE(telemetry.process(frame));
+    TEST_ASSERT_EQUAL_UINT8(2U, gSampleCnt);
+}
@@ -0,0 +1,402 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Units.hpp>
+#include <FPMath.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Orientation, like it is used by the odometry. */
+typedef Units::Quantity<Units::Milliradian, -FP_2PI() + 1, FP_2PI() - 1> Orientation;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testStorage();
+static void testArithmetic();
+static void testConversion();
+static void testSaturation();
+static void testQFormat();
+static void testLegacyEquivalence();
+static void testOperandWidth();
+static void testBenchmark();
+static int32_t calculateOrientationLegacy(int32_t orientation, int16_t stepsLeft, int16_t stepsRight);
+static int32_t calculateOrientationUnits(int32_t orientation, int16_t stepsLeft, int16_t stepsRight);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testStorage);
+    RUN_TEST(testArithmetic);
+    RUN_TEST(testConversion);
+    RUN_TEST(testSaturation);
+    RUN_TEST(testQFormat);
+    RUN_TEST(testLegacyEquivalence);
+    RUN_TEST(testOperandWidth);
+    RUN_TEST(testBenchmark);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the selection of the narrowest storage type.
+ */
+static void testStorage()
+{
+    TEST_ASSERT_EQUAL_UINT32(1U, sizeof(Units::Quantity<Units::Steps, 0, 255>));
+    TEST_ASSERT_EQUAL_UINT32(1U, sizeof(Units::Quantity<Units::Steps, -128, 127>));
+    TEST_ASSERT_EQUAL_UINT32(2U, sizeof(Units::Quantity<Units::Steps, 0, 256>));
+    TEST_ASSERT_EQUAL_UINT32(2U, sizeof(Units::Quantity<Units::Steps, -129, 127>));
+    TEST_ASSERT_EQUAL_UINT32(2U, sizeof(Units::Quantity<Units::Steps, 0, UINT16_MAX>));
+    TEST_ASSERT_EQUAL_UINT32(4U, sizeof(Units::Quantity<Units::Steps, INT16_MIN, INT16_MAX + 1>));
+    TEST_ASSERT_EQUAL_UINT32(4U, sizeof(Units::Quantity<Units::Steps, 0, UINT32_MAX>));
+
+    /* The quantities are not wider than the plain types, they replace. */
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int16_t), sizeof(Units::EncoderSteps));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int16_t), sizeof(Units::LinearSpeed));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int16_t), sizeof(Units::AngularSpeed));
+}
+
+/**
+ * Test the range tracking of additions and subtractions.
+ */
+static void testArithmetic()
+{
+    Units::EncoderSteps left(INT16_MAX);
+    Units::EncoderSteps right(INT16_MAX);
+    Units::EncoderSteps negative(INT16_MIN);
+
+    /* Sum and difference of 16 bit quantities are widened. */
+    TEST_ASSERT_EQUAL_UINT32(4U, sizeof(left + right));
+    TEST_ASSERT_EQUAL_UINT32(4U, sizeof(left - right));
+    TEST_ASSERT_EQUAL_INT32(2 * static_cast<int32_t>(INT16_MAX), (left + right).value());
+    TEST_ASSERT_EQUAL_INT32(static_cast<int32_t>(INT16_MAX) - static_cast<int32_t>(INT16_MIN),
+                            (left - negative).value());
+
+    /* Small ranges stay small. */
+    Units::Quantity<Units::Millimeter, 0, 100> small(100U);
+    Units::Quantity<Units::Millimeter, 0, 50>  smaller(50U);
+
+    TEST_ASSERT_EQUAL_UINT32(1U, sizeof(small + smaller));
+    TEST_ASSERT_EQUAL_UINT8(150U, (small + smaller).value());
+    TEST_ASSERT_EQUAL_UINT32(1U, sizeof(smaller - small));
+    TEST_ASSERT_EQUAL_INT8(-50, (smaller - small).value());
+
+    /* Widening conversion to a quantity of the same unit. */
+    Units::Quantity<Units::Millimeter, -1000, 1000> wide = small;
+    TEST_ASSERT_EQUAL_INT16(100, wide.value());
+}
+
+/**
+ * Test the scaling and the conversion between units.
+ */
+static void testConversion()
+{
+    Units::EncoderSteps steps(-1001);
+
+    /* 1000 / 680 is reduced to 25 / 17. */
+    TEST_ASSERT_EQUAL_INT32(-1001 * 1000 / 680, (steps.convert<Units::Milliradian, 1000, 680>().value()));
+
+    /* Halving keeps the 16 bit range. */
+    TEST_ASSERT_EQUAL_UINT32(2U, sizeof(steps.scale<1, 2>()));
+    TEST_ASSERT_EQUAL_INT16(-500, (steps.scale<1, 2>().value()));
+
+    /* Negative factors swap the range. */
+    TEST_ASSERT_EQUAL_INT16(1001, (steps.scale<-1, 1>().value()));
+
+    /* Runtime divisor, rounded towards zero. */
+    TEST_ASSERT_EQUAL_INT16(-333, steps.divide(3).value());
+}
+
+/**
+ * Test the saturation and the wrap around.
+ */
+static void testSaturation()
+{
+    Units::Quantity<Units::Steps, -100000, 100000> value(-40000);
+
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, (value.clamp<INT16_MIN, INT16_MAX>().value()));
+    TEST_ASSERT_EQUAL_UINT32(2U, sizeof(value.clamp<INT16_MIN, INT16_MAX>()));
+    TEST_ASSERT_EQUAL_INT16(-1000, (value.limit<-INT16_MAX, INT16_MAX>(-1000, 1000).value()));
+    TEST_ASSERT_EQUAL_INT16(-40000 % 6283, (value.wrap<6283>().value()));
+    TEST_ASSERT_EQUAL_UINT32(2U, sizeof(value.wrap<6283>()));
+
+    value = Units::Quantity<Units::Steps, -100000, 100000>(40000);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, (value.clamp<INT16_MIN, INT16_MAX>().value()));
+    TEST_ASSERT_EQUAL_INT16(1000, (value.limit<-INT16_MAX, INT16_MAX>(-1000, 1000).value()));
+    TEST_ASSERT_EQUAL_INT16(40000 % 6283, (value.wrap<6283>().value()));
+}
+
+/**
+ * Test the scaling with Q-format factors.
+ */
+static void testQFormat()
+{
+    Units::EncoderSteps positive(1000);
+    Units::EncoderSteps negative(-1000);
+
+    /* 1 / 8 is exact in Q-format. */
+    TEST_ASSERT_EQUAL_INT16(125, (positive.scaleQ<1, 8, 8>().value()));
+    TEST_ASSERT_EQUAL_INT16(-125, (negative.scaleQ<1, 8, 8>().value()));
+
+    /* 1 / 3 is approximated, rounding is symmetric towards zero. */
+    TEST_ASSERT_INT16_WITHIN(1, 333, (positive.scaleQ<1, 3, 12>().value()));
+    TEST_ASSERT_EQUAL_INT16(-(positive.scaleQ<1, 3, 12>().value()), (negative.scaleQ<1, 3, 12>().value()));
+}
+
+/**
+ * Test that the unit types calculate the same results as the former plain
+ * integer calculations in the service layer.
+ */
+static void testLegacyEquivalence()
+{
+    const int32_t FULL_CIRCLE = 6283; /* [mrad] */
+    int32_t       left        = INT16_MIN;
+
+    while (INT16_MAX >= left)
+    {
+        int16_t             stepsLeft  = static_cast<int16_t>(left);
+        int16_t             stepsRight = static_cast<int16_t>(-left / 3);
+        Units::EncoderSteps unitLeft(stepsLeft);
+        Units::EncoderSteps unitRight(stepsRight);
+
+        /* Former orientation calculation, using two divisions. */
+        int32_t alpha = (static_cast<int32_t>(stepsRight) - static_cast<int32_t>(stepsLeft)) * 1000;
+        alpha /= 8;
+        alpha /= 85;
+        alpha %= FULL_CIRCLE;
+
+        TEST_ASSERT_EQUAL_INT32(
+            alpha, ((unitRight - unitLeft).convert<Units::Milliradian, 1000, 8 * 85>().wrap<6283>().value()));
+
+        /* Former center calculation, using 32 bit. */
+        TEST_ASSERT_EQUAL_INT16((static_cast<int32_t>(stepsLeft) + static_cast<int32_t>(stepsRight)) / 2,
+                                ((unitLeft + unitRight).scale<1, 2>().value()));
+
+        /* Former angular speed calculation. */
+        TEST_ASSERT_EQUAL_INT16((2 * (static_cast<int32_t>(stepsRight) - static_cast<int32_t>(stepsLeft))) / 85,
+                                ((unitRight - unitLeft).convert<Units::MilliradianPerSecond, 2, 85>().value()));
+
+        /* Former linear speed calculation. */
+        TEST_ASSERT_EQUAL_INT32(static_cast<int32_t>(stepsLeft) * 10000 / 7,
+                                (unitLeft.convert<Units::StepsPerSecond, 10000, 1>().divide(7).value()));
+
+        left += 7;
+    }
+}
+
+/**
+ * Test the operand width of the orientation calculation. The width decides
+ * on the target, which division routine is called.
+ */
+static void testOperandWidth()
+{
+    Units::EncoderSteps left(0);
+    Units::EncoderSteps right(0);
+    auto                alpha = (right - left).convert<Units::Milliradian, 1000, 8 * 85>().wrap<FP_2PI()>();
+
+    /* The factor 1000 / (8 * 85) is reduced to 25 / 17, the product still needs 32 bit. */
+    TEST_ASSERT_EQUAL_INT64(25, (Units::ScaledRange<INT16_MIN, INT16_MAX, 1000, 8 * 85>::NUM_REDUCED));
+    TEST_ASSERT_EQUAL_INT64(17, (Units::ScaledRange<INT16_MIN, INT16_MAX, 1000, 8 * 85>::DEN_REDUCED));
+
+    /* After the first wrap around, the orientation sum and its wrap around need only 16 bit.
+     * The former calculation used 32 bit for both.
+     */
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int16_t), sizeof(alpha));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int16_t), sizeof(Orientation(0) + alpha));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int16_t), sizeof((Orientation(0) + alpha).wrap<FP_2PI()>()));
+}
+
+/**
+ * Benchmark the orientation calculation with unit types against the former
+ * plain integer calculation. Both run over the same inputs and shall provide
+ * the same orientation. The durations are reported, they are not asserted,
+ * because they depend on the platform. On the target, the test reports the
+ * real AVR durations.
+ */
+static void testBenchmark()
+{
+    const uint16_t ITERATIONS        = 50000U;
+    int32_t        orientationLegacy = 0;
+    int32_t        orientationUnits  = 0;
+    uint32_t       durationLegacy    = 0U;
+    uint32_t       durationUnits     = 0U;
+    uint32_t       timestamp         = 0U;
+    uint16_t       idx               = 0U;
+    char           message[80];
+
+    timestamp = micros();
+    for (idx = 0U; idx < ITERATIONS; ++idx)
+    {
+        orientationLegacy = calculateOrientationLegacy(orientationLegacy, static_cast<int16_t>(idx % 97U),
+                                                       static_cast<int16_t>(idx % 89U));
+    }
+    durationLegacy = micros() - timestamp;
+
+    timestamp = micros();
+    for (idx = 0U; idx < ITERATIONS; ++idx)
+    {
+        orientationUnits = calculateOrientationUnits(orientationUnits, static_cast<int16_t>(idx % 97U),
+                                                     static_cast<int16_t>(idx % 89U));
+    }
+    durationUnits = micros() - timestamp;
+
+    TEST_ASSERT_EQUAL_INT32(orientationLegacy, orientationUnits);
+
+    (void)snprintf(message, sizeof(message), "Orientation x %u: former %lu us, units %lu us",
+                   static_cast<unsigned int>(ITERATIONS), static_cast<unsigned long>(durationLegacy),
+                   static_cast<unsigned long>(durationUnits));
+    TEST_MESSAGE(message);
+}
+
+/**
+ * Former orientation calculation of the odometry with plain integers.
+ *
+ * @param[in] orientation   Orientation [mrad]
+ * @param[in] stepsLeft     Relative steps left [steps]
+ * @param[in] stepsRight    Relative steps right [steps]
+ *
+ * @return Orientation [mrad]
+ */
+static int32_t calculateOrientationLegacy(int32_t orientation, int16_t stepsLeft, int16_t stepsRight)
+{
+    int32_t alpha = (static_cast<int32_t>(stepsRight) - static_cast<int32_t>(stepsLeft)) * 1000;
+
+    alpha /= 8;
+    alpha /= 85;
+    alpha %= FP_2PI();
+
+    orientation += alpha;
+    orientation %= FP_2PI();
+
+    return orientation;
+}
+
+/**
+ * Orientation calculation of the odometry with unit types.
+ *
+ * @param[in] orientation   Orientation [mrad]
+ * @param[in] stepsLeft     Relative steps left [steps]
+ * @param[in] stepsRight    Relative steps right [steps]
+ *
+ * @return Orientation [mrad]
+ */
+static int32_t calculateOrientationUnits(int32_t orientation, int16_t stepsLeft, int16_t stepsRight)
+{
+    Units::EncoderSteps left(stepsLeft);
+    Units::EncoderSteps right(stepsRight);
+    Orientation alpha = (right - left).convert<Units::Milliradian, 1000, 8 * 85>().wrap<FP_2PI()>();
+
+    return (Orientation(static_cast<Orientation::Type>(orientation)) + alpha).wrap<FP_2PI()>().value();
+}
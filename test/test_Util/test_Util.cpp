@@ -34,6 +34,7 @@
  * Includes
  *****************************************************************************/
 
+#include <Arduino.h>
 #include <unity.h>
 #include <Util.h>
 
@@ -54,6 +55,7 @@
  *****************************************************************************/
 
 static void testUtil();
+static void testCopyStr();
 
 /******************************************************************************
  * Local Variables
@@ -94,6 +96,7 @@ void loop()
     UNITY_BEGIN();
 
     RUN_TEST(testUtil);
+    RUN_TEST(testCopyStr);
 
     UNITY_END();
 
@@ -188,3 +191,24 @@ static void testUtil()
         ++idx;
     }
 }
+
+/**
+ * Test copying strings from RAM and program memory.
+ */
+static void testCopyStr()
+{
+    static const char FLASH_STR[] PROGMEM = "LINE_SENS";
+    char              result[6];
+
+    /* Longer strings are cut and terminated. */
+    Util::copyStr(result, sizeof(result), "CMD_RSP");
+    TEST_ASSERT_EQUAL_STRING("CMD_R", result);
+
+    /* The rest of the destination is filled with zeros. */
+    Util::copyStr(result, sizeof(result), "CMD");
+    TEST_ASSERT_EQUAL_STRING("CMD", result);
+    TEST_ASSERT_EQUAL_UINT8('\0', result[4]);
+
+    Util::copyStr(result, sizeof(result), reinterpret_cast<const __FlashStringHelper*>(FLASH_STR));
+    TEST_ASSERT_EQUAL_STRING("LINE_", result);
+}
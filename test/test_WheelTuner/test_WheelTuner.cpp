@@ -0,0 +1,345 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the wheel tuner tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <WheelTuner.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static bool runStep(WheelTuner& tuner, int16_t start, int16_t target, uint16_t riseTime, int16_t overshoot,
+                    int16_t offset);
+static void testNoStep();
+static void testSlowResponse();
+static void testOvershoot();
+static void testSteadyStateError();
+static void testBounds();
+static void testMovingSetPoint();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Control period in ms. */
+static const uint32_t PERIOD = 10U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program setup routine, which is called once at startup.
+ */
+void setup()
+{
+#ifndef TARGET_NATIVE
+    /* https://docs.platformio.org/en/latest/plus/unit-testing.html#demo */
+    delay(2000);
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Main entry point.
+ */
+void loop()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(testNoStep);
+    RUN_TEST(testSlowResponse);
+    RUN_TEST(testOvershoot);
+    RUN_TEST(testSteadyStateError);
+    RUN_TEST(testBounds);
+    RUN_TEST(testMovingSetPoint);
+
+    UNITY_END();
+
+#ifndef TARGET_NATIVE
+    /* Don't exit on the robot to avoid a endless test loop.
+     * If the test runs on the pc, it must exit.
+     */
+    for (;;)
+    {
+    }
+#endif /* Not defined TARGET_NATIVE */
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+    /* Not used. */
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    /* Not used. */
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Run a set point step with a synthetic wheel speed response.
+ * The speed ramps to the target plus overshoot within the rise time, stays
+ * there for another rise time and settles at the target plus offset afterwards.
+ *
+ * @param[in] tuner     Wheel tuner
+ * @param[in] start     Speed before the step in steps/s
+ * @param[in] target    Set point after the step in steps/s
+ * @param[in] riseTime  Ramp duration in ms
+ * @param[in] overshoot Peak above the target in direction of the step in steps/s
+ * @param[in] offset    Remaining error after settling in steps/s
+ *
+ * @return If the gains were adapted, it will return true otherwise false.
+ */
+static bool runStep(WheelTuner& tuner, int16_t start, int16_t target, uint16_t riseTime, int16_t overshoot,
+                    int16_t offset)
+{
+    bool     isChanged = false;
+    int32_t  direction = (target > start) ? 1 : -1;
+    int32_t  peak      = target + (direction * overshoot);
+    uint32_t elapsed   = 0U;
+
+    /* Steady state before the step. */
+    isChanged = tuner.process(start, start, PERIOD);
+
+    while ((2U * WheelTuner::EVALUATION_TIME) > elapsed)
+    {
+        int32_t speed = 0;
+
+        if (riseTime > elapsed)
+        {
+            speed = start + (((peak - start) * static_cast<int32_t>(elapsed)) / riseTime);
+        }
+        else if ((2U * riseTime) > elapsed)
+        {
+            speed = peak;
+        }
+        else
+        {
+            speed = target + offset;
+        }
+
+        if (true == tuner.process(target, static_cast<int16_t>(speed), PERIOD))
+        {
+            isChanged = true;
+        }
+
+        elapsed += PERIOD;
+    }
+
+    return isChanged;
+}
+
+/**
+ * Test that no gains are adapted without set point steps.
+ */
+static void testNoStep()
+{
+    WheelTuner tuner;
+    uint32_t   count = 0U;
+
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_DEFAULT, tuner.getGains().iDivisor);
+
+    /* Small set point changes are no steps. */
+    while (100U > count)
+    {
+        int16_t setPoint = static_cast<int16_t>(1000U + ((count % 3U) * 100U));
+
+        TEST_ASSERT_FALSE(tuner.process(setPoint, 1000, PERIOD));
+        ++count;
+    }
+
+    /* A wheel, which doesn't reach a constant set point, is evaluated once after the jump only. */
+    count = 0U;
+    while (200U > count)
+    {
+        (void)tuner.process(2000, 1000, PERIOD);
+        ++count;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(1U, tuner.getNumResponses());
+}
+
+/**
+ * Test that a slow response increases the proportional gain.
+ */
+static void testSlowResponse()
+{
+    WheelTuner tuner;
+
+    TEST_ASSERT_TRUE(runStep(tuner, 0, 1000, 300U, 0, 0));
+    TEST_ASSERT_EQUAL_UINT16(1U, tuner.getNumResponses());
+    TEST_ASSERT_EQUAL_UINT16(270U, tuner.getResponse().riseTime);
+    TEST_ASSERT_EQUAL_UINT16(0U, tuner.getResponse().overshoot);
+    TEST_ASSERT_EQUAL_UINT16(0U, tuner.getResponse().steadyStateError);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT - 1, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_DEFAULT, tuner.getGains().iDivisor);
+
+    /* Same in reverse direction. */
+    TEST_ASSERT_TRUE(runStep(tuner, 0, -1000, 300U, 0, 0));
+    TEST_ASSERT_EQUAL_UINT16(2U, tuner.getNumResponses());
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT - 2, tuner.getGains().pDivisor);
+
+    /* A fast response keeps the gains. */
+    TEST_ASSERT_FALSE(runStep(tuner, 0, 1000, 50U, 0, 0));
+    TEST_ASSERT_EQUAL_UINT16(3U, tuner.getNumResponses());
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT - 2, tuner.getGains().pDivisor);
+}
+
+/**
+ * Test that an overshoot decreases the gains.
+ */
+static void testOvershoot()
+{
+    WheelTuner tuner;
+
+    TEST_ASSERT_TRUE(runStep(tuner, 500, 1500, 50U, 300, 0));
+    TEST_ASSERT_EQUAL_UINT16(300U, tuner.getResponse().overshoot);
+    TEST_ASSERT_EQUAL_UINT16(0U, tuner.getResponse().steadyStateError);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT + 1, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_DEFAULT + WheelTuner::I_DIVISOR_NOTCH, tuner.getGains().iDivisor);
+}
+
+/**
+ * Test that a steady-state error increases the integral gain.
+ */
+static void testSteadyStateError()
+{
+    WheelTuner tuner;
+
+    TEST_ASSERT_TRUE(runStep(tuner, 0, 1000, 50U, 0, -100));
+    TEST_ASSERT_EQUAL_UINT16(100U, tuner.getResponse().steadyStateError);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_DEFAULT - WheelTuner::I_DIVISOR_NOTCH, tuner.getGains().iDivisor);
+}
+
+/**
+ * Test that the gains stay within their bounds.
+ */
+static void testBounds()
+{
+    WheelTuner        tuner;
+    WheelTuner::Gains gains = { 100, 1 };
+    uint32_t          count = 0U;
+
+    tuner.setGains(gains);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_MAX, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_MIN, tuner.getGains().iDivisor);
+
+    /* A slow and inaccurate wheel drives the gains to their max. */
+    while (100U > count)
+    {
+        (void)runStep(tuner, 0, 1000, 400U, 0, -200);
+        ++count;
+    }
+
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_MIN, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_MIN, tuner.getGains().iDivisor);
+    TEST_ASSERT_FALSE(runStep(tuner, 0, 1000, 400U, 0, -200));
+
+    /* An oscillating wheel drives them to their min. */
+    count = 0U;
+    while (100U > count)
+    {
+        (void)runStep(tuner, 0, 1000, 50U, 500, 0);
+        ++count;
+    }
+
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_MAX, tuner.getGains().pDivisor);
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::I_DIVISOR_MAX, tuner.getGains().iDivisor);
+}
+
+/**
+ * Test that a set point, which moves away from the step target, aborts the evaluation.
+ */
+static void testMovingSetPoint()
+{
+    WheelTuner tuner;
+    uint32_t   count = 0U;
+
+    (void)tuner.process(0, 0, PERIOD);
+
+    while (100U > count)
+    {
+        int16_t setPoint = static_cast<int16_t>(1000U + (count * 10U));
+
+        TEST_ASSERT_FALSE(tuner.process(setPoint, 0, PERIOD));
+        ++count;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(0U, tuner.getNumResponses());
+    TEST_ASSERT_EQUAL_INT16(WheelTuner::P_DIVISOR_DEFAULT, tuner.getGains().pDivisor);
+
+    /* A reset aborts it as well. */
+    (void)tuner.process(0, 0, PERIOD);
+    (void)tuner.process(1000, 0, PERIOD);
+    tuner.reset();
+    (void)runStep(tuner, 1000, 1000, 300U, 0, 0);
+    TEST_ASSERT_EQUAL_UINT16(0U, tuner.getNumResponses());
+}
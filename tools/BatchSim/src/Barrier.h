@@ -0,0 +1,109 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Thread barrier
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <mutex>
+#include <condition_variable>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Reusable barrier, which blocks the threads until all of them arrived.
+ * C++11 provides no barrier, therefore it is built with a condition variable.
+ */
+class Barrier
+{
+public:
+    /**
+     * Constructs the barrier.
+     *
+     * @param[in] numThreads    Number of threads, which have to arrive.
+     */
+    explicit Barrier(uint32_t numThreads) :
+        m_mutex(),
+        m_condition(),
+        m_numThreads(numThreads),
+        m_numWaiting(0U),
+        m_generation(0U)
+    {
+    }
+
+    /**
+     * Destroys the barrier.
+     */
+    ~Barrier()
+    {
+    }
+
+    /**
+     * Wait until all threads arrived.
+     */
+    void wait();
+
+private:
+    std::mutex              m_mutex;      /**< Protects the counters */
+    std::condition_variable m_condition;  /**< Signals the release of the waiting threads */
+    uint32_t                m_numThreads; /**< Number of threads, which have to arrive */
+    uint32_t                m_numWaiting; /**< Number of threads, which arrived */
+    uint32_t                m_generation; /**< Incremented on every release */
+
+    /* Not allowed. */
+    Barrier(const Barrier& barrier);
+    Barrier& operator=(const Barrier& barrier);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* BARRIER_H */
+/** @} */
@@ -0,0 +1,260 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Batch simulation of line follower candidates
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "BatchSim.h"
+#include "PlantBatch.h"
+#include "Random.h"
+#include <vector>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize static constant data. */
+const float BatchSim::START_OFFSET_MAX         = 5.0F;
+const float BatchSim::START_HEADING_MAX        = 0.05F;
+const float BatchSim::MOTOR_GAIN_DEVIATION_MAX = 0.05F;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+BatchSim::BatchSim(const Track& track, uint32_t robotsPerCandidate, uint32_t seed, int16_t maxMotorSpeed) :
+    m_track(track),
+    m_robotsPerCandidate(robotsPerCandidate),
+    m_seed(seed),
+    m_maxMotorSpeed(maxMotorSpeed)
+{
+}
+
+void BatchSim::run(const RobotController::Parameters* candidates, size_t numCandidates, uint32_t lapTimeout,
+                   Result* results) const
+{
+    const float                  PERIOD       = static_cast<float>(CONTROL_PERIOD) / 1000.0F; /* [s] */
+    const float                  TRACK_LENGTH = m_track.getLength();
+    size_t                       numRobots    = numCandidates * m_robotsPerCandidate;
+    PlantBatch                   plant(m_track, numRobots);
+    std::vector<RobotController> controllers(numRobots);
+    std::vector<float>           lastProgress(numRobots, 0.0F); /* [mm] */
+    std::vector<float>           progress(numRobots, 0.0F);     /* [mm] */
+    std::vector<float>           distanceSum(numRobots, 0.0F);  /* [mm] */
+    std::vector<uint32_t>        numSamples(numRobots, 0U);
+    std::vector<uint32_t>        lapTime(numRobots, 0U); /* [ms], 0 if not finished */
+    std::vector<uint8_t>         isActive(numRobots, 1U);
+    size_t                       numActive = numRobots;
+    uint32_t                     timestamp = 0U; /* [ms] */
+    size_t                       idx       = 0U;
+
+    /* Place the robots with their variations on the start. */
+    for (idx = 0U; idx < numRobots; ++idx)
+    {
+        Random random(m_seed, static_cast<uint32_t>(idx % m_robotsPerCandidate));
+        float  posX    = 0.0F;
+        float  posY    = 0.0F;
+        float  heading = 0.0F;
+        float  offset  = 0.0F;
+
+        m_track.getStartPose(posX, posY, heading);
+
+        offset = START_OFFSET_MAX * random.getNext();
+        posX -= offset * sinf(heading);
+        posY += offset * cosf(heading);
+        heading += START_HEADING_MAX * random.getNext();
+
+        plant.reset(idx, posX, posY, heading, 1.0F + (MOTOR_GAIN_DEVIATION_MAX * random.getNext()),
+                    1.0F + (MOTOR_GAIN_DEVIATION_MAX * random.getNext()));
+        controllers[idx].init(candidates[idx / m_robotsPerCandidate], m_maxMotorSpeed);
+        lastProgress[idx] = plant.getProgress(idx);
+    }
+
+    while ((0U < numActive) && (lapTimeout > timestamp))
+    {
+        plant.sampleLineSensors();
+
+        for (idx = 0U; idx < numRobots; ++idx)
+        {
+            int16_t speedLeft  = 0; /* [steps/s] */
+            int16_t speedRight = 0; /* [steps/s] */
+
+            if (0U != isActive[idx])
+            {
+                uint16_t sensorValues[PlantBatch::NUM_LINE_SENSORS];
+
+                plant.getSensorValues(idx, sensorValues);
+                controllers[idx].process(sensorValues, plant.getMileage(idx), speedLeft, speedRight);
+
+                if (RobotController::TRACK_STATUS_FAILED == controllers[idx].getTrackStatus())
+                {
+                    isActive[idx] = 0U;
+                    --numActive;
+                }
+            }
+
+            plant.setSpeeds(idx, speedLeft, speedRight);
+        }
+
+        plant.step(PERIOD);
+        timestamp += CONTROL_PERIOD;
+
+        /* Measure the progress along the track and the distance to the line. */
+        for (idx = 0U; idx < numRobots; ++idx)
+        {
+            if (0U != isActive[idx])
+            {
+                float currentProgress = plant.getProgress(idx);
+                float delta           = currentProgress - lastProgress[idx];
+
+                /* Unwrap at the start. */
+                if ((-0.5F * TRACK_LENGTH) > delta)
+                {
+                    delta += TRACK_LENGTH;
+                }
+                else if ((0.5F * TRACK_LENGTH) < delta)
+                {
+                    delta -= TRACK_LENGTH;
+                }
+                else
+                {
+                    ;
+                }
+
+                lastProgress[idx] = currentProgress;
+                progress[idx] += delta;
+                distanceSum[idx] += plant.getDistance(idx);
+                ++numSamples[idx];
+
+                if (TRACK_LENGTH <= progress[idx])
+                {
+                    lapTime[idx]  = timestamp;
+                    isActive[idx] = 0U;
+                    --numActive;
+                }
+            }
+        }
+    }
+
+    /* Aggregate the results per candidate. */
+    for (idx = 0U; idx < numCandidates; ++idx)
+    {
+        Result&  result       = results[idx];
+        uint64_t lapTimeSum   = 0U;
+        float    distanceMean = 0.0F;
+        uint32_t robotIdx     = 0U;
+
+        result.numRobots   = m_robotsPerCandidate;
+        result.numFinished = 0U;
+        result.numFailed   = 0U;
+        result.lapTimeMin  = UINT32_MAX;
+        result.lapTimeAvg  = 0U;
+        result.lapTimeMax  = 0U;
+
+        for (robotIdx = 0U; robotIdx < m_robotsPerCandidate; ++robotIdx)
+        {
+            size_t robot = (idx * m_robotsPerCandidate) + robotIdx;
+
+            if (0U != lapTime[robot])
+            {
+                ++result.numFinished;
+                lapTimeSum += lapTime[robot];
+
+                if (result.lapTimeMin > lapTime[robot])
+                {
+                    result.lapTimeMin = lapTime[robot];
+                }
+
+                if (result.lapTimeMax < lapTime[robot])
+                {
+                    result.lapTimeMax = lapTime[robot];
+                }
+            }
+            else if (RobotController::TRACK_STATUS_FAILED == controllers[robot].getTrackStatus())
+            {
+                ++result.numFailed;
+            }
+            else
+            {
+                ;
+            }
+
+            if (0U < numSamples[robot])
+            {
+                distanceMean += distanceSum[robot] / static_cast<float>(numSamples[robot]);
+            }
+        }
+
+        if (0U == result.numFinished)
+        {
+            result.lapTimeMin = 0U;
+        }
+        else
+        {
+            result.lapTimeAvg = static_cast<uint32_t>(lapTimeSum / result.numFinished);
+        }
+
+        result.meanDistance = distanceMean / static_cast<float>(m_robotsPerCandidate);
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,140 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Batch simulation of line follower candidates
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef BATCH_SIM_H
+#define BATCH_SIM_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "Track.h"
+#include "RobotController.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Simulates one lap of several robots per candidate parameter set. All robots
+ * of all candidates are stepped together in one plant batch, only the
+ * controllers run per robot.
+ *
+ * The robots differ by a random start pose and motor gains. The same robot
+ * index gets the same variation for every candidate, so the candidates are
+ * compared under equal conditions. The results only depend on the seed.
+ */
+class BatchSim
+{
+public:
+    /** Aggregated result of a candidate. */
+    struct Result
+    {
+        uint32_t numRobots;    /**< Number of simulated robots */
+        uint32_t numFinished;  /**< Number of robots, which finished the lap */
+        uint32_t numFailed;    /**< Number of robots, which lost the track */
+        uint32_t lapTimeMin;   /**< Min. lap time in [ms] */
+        uint32_t lapTimeAvg;   /**< Average lap time in [ms] */
+        uint32_t lapTimeMax;   /**< Max. lap time in [ms] */
+        float    meanDistance; /**< Mean distance of the robot center to the line in [mm] */
+    };
+
+    /** Control period in [ms], like the LineFollower control period. */
+    static const uint32_t CONTROL_PERIOD = 5U;
+
+    /**
+     * Constructs the batch simulation.
+     *
+     * @param[in] track                 Track
+     * @param[in] robotsPerCandidate    Number of robots per candidate
+     * @param[in] seed                  Seed of the robot variations
+     * @param[in] maxMotorSpeed         Max. motor speed in [steps/s]
+     */
+    BatchSim(const Track& track, uint32_t robotsPerCandidate, uint32_t seed, int16_t maxMotorSpeed);
+
+    /**
+     * Destroys the batch simulation.
+     */
+    ~BatchSim()
+    {
+    }
+
+    /**
+     * Simulate one lap of all robots of the candidates.
+     *
+     * @param[in]  candidates       Candidate parameter sets
+     * @param[in]  numCandidates    Number of candidates
+     * @param[in]  lapTimeout       Max. lap time in [ms]
+     * @param[out] results          Results, one per candidate.
+     */
+    void run(const RobotController::Parameters* candidates, size_t numCandidates, uint32_t lapTimeout,
+             Result* results) const;
+
+private:
+    /** Max. lateral start offset in [mm]. */
+    static const float START_OFFSET_MAX;
+
+    /** Max. start heading deviation in [rad]. */
+    static const float START_HEADING_MAX;
+
+    /** Max. motor gain deviation from the nominal gain. */
+    static const float MOTOR_GAIN_DEVIATION_MAX;
+
+    const Track& m_track;              /**< Track */
+    uint32_t     m_robotsPerCandidate; /**< Number of robots per candidate */
+    uint32_t     m_seed;               /**< Seed of the robot variations */
+    int16_t      m_maxMotorSpeed;      /**< Max. motor speed in [steps/s] */
+
+    /* Not allowed. */
+    BatchSim(const BatchSim& sim);
+    BatchSim& operator=(const BatchSim& sim);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* BATCH_SIM_H */
+/** @} */
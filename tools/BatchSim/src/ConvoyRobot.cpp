@@ -0,0 +1,181 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Robot context of a convoy member
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ConvoyRobot.h"
+#include <Arduino.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ConvoyRobot::ConvoyRobot() :
+    IRobotContext(),
+    m_controller(),
+    m_id(0U),
+    m_nominalSpeed(0),
+    m_topSpeedMax(0),
+    m_isPredecessorKnown(false),
+    m_predecessor(),
+    m_isOffsetValid(false),
+    m_mileageOffset(0),
+    m_gap(0)
+{
+}
+
+void ConvoyRobot::init(uint8_t id, const RobotController::Parameters& parameters, int16_t maxMotorSpeed)
+{
+    m_controller.init(parameters, maxMotorSpeed);
+
+    m_id                 = id;
+    m_nominalSpeed       = parameters.topSpeed;
+    m_topSpeedMax        = parameters.topSpeed + (parameters.topSpeed / 4);
+    m_isPredecessorKnown = false;
+    m_isOffsetValid      = false;
+    m_mileageOffset      = 0;
+    m_gap                = 0;
+
+    memset(&m_predecessor, 0, sizeof(m_predecessor));
+}
+
+void ConvoyRobot::process(const Perception& perception, Actuation& actuation)
+{
+    Status status;
+    size_t idx = 0U;
+
+    /* Take the latest status of the predecessor. */
+    for (idx = 0U; idx < perception.numMessages; ++idx)
+    {
+        const V2VMessage& message = perception.messages[idx];
+
+        if ((0U < m_id) && ((m_id - 1U) == message.senderId) && (sizeof(Status) == message.size))
+        {
+            memcpy(&m_predecessor, message.payload, sizeof(Status));
+            m_isPredecessorKnown = true;
+        }
+    }
+
+    if (0U < m_id)
+    {
+        m_controller.setTopSpeed(calculateFollowerSpeed(perception));
+    }
+
+    m_controller.process(perception.lineSensorValues, perception.mileage, actuation.speedLeft,
+                         actuation.speedRight);
+
+    status.topSpeed = m_controller.getTopSpeed();
+    status.mileage  = perception.mileage;
+
+    memcpy(actuation.message.payload, &status, sizeof(status));
+    actuation.message.size = sizeof(status);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+int16_t ConvoyRobot::calculateFollowerSpeed(const Perception& perception)
+{
+    int16_t topSpeed   = m_nominalSpeed;
+    bool    isGapKnown = true;
+    int32_t gap        = 0; /* [mm] */
+
+    if (true == perception.isRobotAhead)
+    {
+        gap = static_cast<int32_t>(perception.robotAhead.posX) - ROBOT_LENGTH;
+
+        /* Calibrate the estimation by mileage, while the predecessor is in sight. */
+        if (true == m_isPredecessorKnown)
+        {
+            m_mileageOffset = gap - static_cast<int32_t>(m_predecessor.mileage - perception.mileage);
+            m_isOffsetValid = true;
+        }
+    }
+    else if ((true == m_isPredecessorKnown) && (true == m_isOffsetValid))
+    {
+        gap = static_cast<int32_t>(m_predecessor.mileage - perception.mileage) + m_mileageOffset;
+    }
+    else
+    {
+        isGapKnown = false;
+    }
+
+    if (true == isGapKnown)
+    {
+        int32_t predecessorSpeed = (true == m_isPredecessorKnown) ? m_predecessor.topSpeed : m_nominalSpeed;
+        int32_t speed            = predecessorSpeed + (GAP_GAIN * (gap - GAP_NOMINAL));
+
+        topSpeed = static_cast<int16_t>(constrain(speed, 0, m_topSpeedMax));
+        m_gap    = static_cast<int16_t>(constrain(gap, INT16_MIN, INT16_MAX));
+    }
+    else
+    {
+        m_gap = 0;
+    }
+
+    return topSpeed;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
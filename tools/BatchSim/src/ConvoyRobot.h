@@ -0,0 +1,166 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Robot context of a convoy member
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef CONVOY_ROBOT_H
+#define CONVOY_ROBOT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include "IRobotContext.h"
+#include "RobotController.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A member of a convoy, which follows the line. The robot with id 0 is the
+ * leader and drives with the top speed. Every follower controls the gap to
+ * its predecessor (id - 1) by adapting its top speed.
+ *
+ * The gap is measured by the proximity sensors. If the predecessor is out of
+ * sight, e.g. in a curve, the gap is estimated by the mileage, which the
+ * predecessor broadcasts.
+ */
+class ConvoyRobot : public IRobotContext
+{
+public:
+    /** Gap in mm, which the followers keep to the predecessor, like the nominal gap of the speed governor. */
+    static const int16_t GAP_NOMINAL = 150;
+
+    /** Length of a robot in [mm]. */
+    static const int16_t ROBOT_LENGTH = 100;
+
+    /**
+     * Constructs the convoy member.
+     */
+    ConvoyRobot();
+
+    /**
+     * Destroys the convoy member.
+     */
+    ~ConvoyRobot()
+    {
+    }
+
+    /**
+     * Initialize the convoy member.
+     *
+     * @param[in] id            Robot id in the world, which is the position in the convoy.
+     * @param[in] parameters    Line follower parameters, the top speed is the speed of the leader.
+     * @param[in] maxMotorSpeed Max. motor speed in [steps/s]
+     */
+    void init(uint8_t id, const RobotController::Parameters& parameters, int16_t maxMotorSpeed);
+
+    /**
+     * Process one tick.
+     *
+     * @param[in]  perception   Perception of the robot
+     * @param[out] actuation    Actuation of the robot
+     */
+    void process(const Perception& perception, Actuation& actuation) final;
+
+    /**
+     * Get the gap to the predecessor.
+     *
+     * @return Gap in [mm]. For the leader or if it is unknown, it will return 0.
+     */
+    int16_t getGap() const
+    {
+        return m_gap;
+    }
+
+    /**
+     * Get the top speed.
+     *
+     * @return Top speed in [steps/s]
+     */
+    int16_t getTopSpeed() const
+    {
+        return m_controller.getTopSpeed();
+    }
+
+private:
+    /** Payload of the message, which every convoy member broadcasts. */
+    typedef struct _Status
+    {
+        int16_t  topSpeed; /**< Top speed in [steps/s] */
+        uint32_t mileage;  /**< Driven distance in [mm] */
+    } __attribute__((packed)) Status;
+
+    /** Top speed increase in [steps/s] per mm gap above the nominal gap. */
+    static const int16_t GAP_GAIN = 8;
+
+    RobotController m_controller;         /**< Line follower controller */
+    uint8_t         m_id;                 /**< Robot id */
+    int16_t         m_nominalSpeed;       /**< Top speed of the leader in [steps/s] */
+    int16_t         m_topSpeedMax;        /**< Max. top speed of a follower to catch up in [steps/s] */
+    bool            m_isPredecessorKnown; /**< Is a status of the predecessor received? */
+    Status          m_predecessor;        /**< Last received status of the predecessor */
+    bool            m_isOffsetValid;      /**< Is the mileage offset valid? */
+    int32_t         m_mileageOffset;      /**< Gap minus mileage difference to the predecessor in [mm] */
+    int16_t         m_gap;                /**< Gap to the predecessor in [mm] */
+
+    /**
+     * Calculate the top speed of a follower, which controls the gap to the predecessor.
+     *
+     * @param[in] perception    Perception of the robot
+     *
+     * @return Top speed in [steps/s]
+     */
+    int16_t calculateFollowerSpeed(const Perception& perception);
+
+    /* Not allowed. */
+    ConvoyRobot(const ConvoyRobot& robot);
+    ConvoyRobot& operator=(const ConvoyRobot& robot);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* CONVOY_ROBOT_H */
+/** @} */
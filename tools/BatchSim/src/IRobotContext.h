@@ -0,0 +1,138 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Abstract robot context of the world
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef IROBOT_CONTEXT_H
+#define IROBOT_CONTEXT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/** Vehicle to vehicle message, which is broadcasted to all other robots. */
+struct V2VMessage
+{
+    /** Max. payload size in byte. */
+    static const uint8_t MAX_PAYLOAD_SIZE = 16U;
+
+    uint8_t senderId;                  /**< Id of the sending robot */
+    uint8_t size;                      /**< Payload size in byte, 0 if no message is sent. */
+    uint8_t payload[MAX_PAYLOAD_SIZE]; /**< Payload */
+};
+
+/** Pose of another robot, relative to the robot. */
+struct RelativePose
+{
+    float posX;    /**< Distance in front of the robot center in [mm] */
+    float posY;    /**< Distance left of the robot center in [mm] */
+    float heading; /**< Heading difference in [-PI; PI] in [rad] */
+};
+
+/** Everything, a robot senses in one tick. It is derived from the world state at the begin of the tick. */
+struct Perception
+{
+    uint32_t          timestamp;        /**< Virtual time in [ms] */
+    const uint16_t*   lineSensorValues; /**< Line sensor values 0 (white) .. 1000 (black) */
+    uint32_t          mileage;          /**< Driven distance in [mm] */
+    uint8_t           proximityLeft;    /**< Front proximity sensor counts with the left LEDs */
+    uint8_t           proximityRight;   /**< Front proximity sensor counts with the right LEDs */
+    bool              isRobotAhead;     /**< Is a robot in the field of view of the proximity sensors? */
+    RelativePose      robotAhead;       /**< Pose of the nearest robot ahead, if there is one. */
+    const V2VMessage* messages;         /**< Messages of the other robots, sent in the last tick */
+    size_t            numMessages;      /**< Number of messages */
+};
+
+/** Everything, a robot commands in one tick. */
+struct Actuation
+{
+    int16_t    speedLeft;  /**< Linear speed set point left in [steps/s] */
+    int16_t    speedRight; /**< Linear speed set point right in [steps/s] */
+    V2VMessage message;    /**< Message to broadcast, set the size to 0 for none. */
+};
+
+/**
+ * The abstract robot context, which the world processes once per tick.
+ * A context shall only use its own state and the perception, because the
+ * contexts of different robots may be processed in parallel.
+ */
+class IRobotContext
+{
+public:
+    /**
+     * Destroys the interface.
+     */
+    virtual ~IRobotContext()
+    {
+    }
+
+    /**
+     * Process one tick.
+     *
+     * @param[in]  perception   Perception of the robot
+     * @param[out] actuation    Actuation of the robot, which is initialized with stop and no message.
+     */
+    virtual void process(const Perception& perception, Actuation& actuation) = 0;
+
+protected:
+    /**
+     * Constructs the interface.
+     */
+    IRobotContext()
+    {
+    }
+
+private:
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* IROBOT_CONTEXT_H */
+/** @} */
@@ -0,0 +1,218 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Batch of robot plants in structure of arrays layout
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "PlantBatch.h"
+#include <math.h>
+#include <RobotConstants.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize static constant data. */
+const float PlantBatch::SENSOR_OFFSETS[NUM_LINE_SENSORS] = {45.0F, 10.0F, 0.0F, -10.0F, -45.0F};
+const float PlantBatch::SENSOR_LOOKAHEAD                = 50.0F;
+const float PlantBatch::SENSOR_BLUR                     = 8.0F;
+const float PlantBatch::WHEEL_TIME_CONSTANT             = 0.05F;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+PlantBatch::PlantBatch(const Track& track, size_t capacity) :
+    m_track(track),
+    m_capacity(capacity),
+    m_posX(capacity, 0.0F),
+    m_posY(capacity, 0.0F),
+    m_heading(capacity, 0.0F),
+    m_cosHeading(capacity, 1.0F),
+    m_sinHeading(capacity, 0.0F),
+    m_speedLeft(capacity, 0.0F),
+    m_speedRight(capacity, 0.0F),
+    m_setPointLeft(capacity, 0.0F),
+    m_setPointRight(capacity, 0.0F),
+    m_gainLeft(capacity, 1.0F),
+    m_gainRight(capacity, 1.0F),
+    m_mileage(capacity, 0.0F),
+    m_sensorValues()
+{
+    uint8_t sensorIdx = 0U;
+
+    for (sensorIdx = 0U; sensorIdx < NUM_LINE_SENSORS; ++sensorIdx)
+    {
+        m_sensorValues[sensorIdx].assign(capacity, 0U);
+    }
+}
+
+void PlantBatch::reset(size_t idx, float posX, float posY, float heading, float gainLeft, float gainRight)
+{
+    m_posX[idx]          = posX;
+    m_posY[idx]          = posY;
+    m_heading[idx]       = heading;
+    m_cosHeading[idx]    = cosf(heading);
+    m_sinHeading[idx]    = sinf(heading);
+    m_speedLeft[idx]     = 0.0F;
+    m_speedRight[idx]    = 0.0F;
+    m_setPointLeft[idx]  = 0.0F;
+    m_setPointRight[idx] = 0.0F;
+    m_gainLeft[idx]      = gainLeft;
+    m_gainRight[idx]     = gainRight;
+    m_mileage[idx]       = 0.0F;
+}
+
+void PlantBatch::setSpeeds(size_t idx, int16_t speedLeft, int16_t speedRight)
+{
+    const float STEPS_PER_MM = static_cast<float>(RobotConstants::ENCODER_STEPS_PER_MM);
+
+    m_setPointLeft[idx]  = static_cast<float>(speedLeft) / STEPS_PER_MM;
+    m_setPointRight[idx] = static_cast<float>(speedRight) / STEPS_PER_MM;
+}
+
+void PlantBatch::step(float period, size_t begin, size_t end)
+{
+    const float WHEEL_BASE = static_cast<float>(RobotConstants::WHEEL_BASE); /* [mm] */
+    float       alpha      = period / WHEEL_TIME_CONSTANT;
+    float*      posX       = m_posX.data();
+    float*      posY       = m_posY.data();
+    float*      heading    = m_heading.data();
+    float*      cosHeading = m_cosHeading.data();
+    float*      sinHeading = m_sinHeading.data();
+    float*      speedLeft  = m_speedLeft.data();
+    float*      speedRight = m_speedRight.data();
+    float*      mileage    = m_mileage.data();
+    size_t      idx        = 0U;
+
+    if (1.0F < alpha)
+    {
+        alpha = 1.0F;
+    }
+
+    /* Wheel speed dynamics */
+    for (idx = begin; idx < end; ++idx)
+    {
+        speedLeft[idx] += alpha * ((m_gainLeft[idx] * m_setPointLeft[idx]) - speedLeft[idx]);
+        speedRight[idx] += alpha * ((m_gainRight[idx] * m_setPointRight[idx]) - speedRight[idx]);
+    }
+
+    /* Differential drive kinematics, integrated at the mid heading. */
+    for (idx = begin; idx < end; ++idx)
+    {
+        float linearSpeed  = 0.5F * (speedLeft[idx] + speedRight[idx]);       /* [mm/s] */
+        float angularSpeed = (speedRight[idx] - speedLeft[idx]) / WHEEL_BASE; /* [rad/s] */
+        float midHeading   = heading[idx] + (0.5F * angularSpeed * period);   /* [rad] */
+        float distance     = linearSpeed * period;                            /* [mm] */
+
+        posX[idx] += distance * cosf(midHeading);
+        posY[idx] += distance * sinf(midHeading);
+        heading[idx] += angularSpeed * period;
+        mileage[idx] += fabsf(distance);
+    }
+
+    for (idx = begin; idx < end; ++idx)
+    {
+        cosHeading[idx] = cosf(heading[idx]);
+        sinHeading[idx] = sinf(heading[idx]);
+    }
+}
+
+void PlantBatch::sampleLineSensors(size_t begin, size_t end)
+{
+    const float  HALF_LINE_WIDTH = m_track.getHalfLineWidth();
+    const float* posX            = m_posX.data();
+    const float* posY            = m_posY.data();
+    const float* cosHeading      = m_cosHeading.data();
+    const float* sinHeading      = m_sinHeading.data();
+    uint8_t      sensorIdx       = 0U;
+
+    for (sensorIdx = 0U; sensorIdx < NUM_LINE_SENSORS; ++sensorIdx)
+    {
+        const float OFFSET = SENSOR_OFFSETS[sensorIdx];
+        uint16_t*   values = m_sensorValues[sensorIdx].data();
+        size_t      idx    = 0U;
+
+        for (idx = begin; idx < end; ++idx)
+        {
+            float sensorX  = posX[idx] + (SENSOR_LOOKAHEAD * cosHeading[idx]) - (OFFSET * sinHeading[idx]);
+            float sensorY  = posY[idx] + (SENSOR_LOOKAHEAD * sinHeading[idx]) + (OFFSET * cosHeading[idx]);
+            float outside  = m_track.getDistance(sensorX, sensorY) - HALF_LINE_WIDTH; /* [mm] */
+            float darkness = 1.0F - (outside / SENSOR_BLUR);
+
+            darkness    = (0.0F > darkness) ? 0.0F : ((1.0F < darkness) ? 1.0F : darkness);
+            values[idx] = static_cast<uint16_t>(darkness * 1000.0F);
+        }
+    }
+}
+
+void PlantBatch::getSensorValues(size_t idx, uint16_t* values) const
+{
+    uint8_t sensorIdx = 0U;
+
+    for (sensorIdx = 0U; sensorIdx < NUM_LINE_SENSORS; ++sensorIdx)
+    {
+        values[sensorIdx] = m_sensorValues[sensorIdx][idx];
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,271 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Batch of robot plants in structure of arrays layout
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef PLANT_BATCH_H
+#define PLANT_BATCH_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "Track.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The plants of many robots: the differential drive kinematics, the wheel
+ * speed dynamics and the line sensors.
+ *
+ * Every state variable is kept in its own array over all robots (structure
+ * of arrays). The update loops run over all robots without branches and
+ * without calls, so the compiler vectorizes them.
+ *
+ * The wheel speed control of the robot is modelled as first order lag of
+ * the wheel speed set points, with an individual motor gain per wheel.
+ */
+class PlantBatch
+{
+public:
+    /** Number of line sensors. */
+    static const uint8_t NUM_LINE_SENSORS = 5U;
+
+    /**
+     * Constructs the batch.
+     *
+     * @param[in] track     The track, which the robots drive on.
+     * @param[in] capacity  Number of robots
+     */
+    PlantBatch(const Track& track, size_t capacity);
+
+    /**
+     * Destroys the batch.
+     */
+    ~PlantBatch()
+    {
+    }
+
+    /**
+     * Get the number of robots.
+     *
+     * @return Number of robots
+     */
+    size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * Reset a robot to a pose and standstill.
+     *
+     * @param[in] idx       Robot index
+     * @param[in] posX      x-coordinate in [mm]
+     * @param[in] posY      y-coordinate in [mm]
+     * @param[in] heading   Heading in [rad]
+     * @param[in] gainLeft  Gain of the left motor, 1 is nominal.
+     * @param[in] gainRight Gain of the right motor, 1 is nominal.
+     */
+    void reset(size_t idx, float posX, float posY, float heading, float gainLeft, float gainRight);
+
+    /**
+     * Set the wheel speed set points of a robot.
+     *
+     * @param[in] idx           Robot index
+     * @param[in] speedLeft     Linear speed left in [steps/s]
+     * @param[in] speedRight    Linear speed right in [steps/s]
+     */
+    void setSpeeds(size_t idx, int16_t speedLeft, int16_t speedRight);
+
+    /**
+     * Advance all robots by one period.
+     *
+     * @param[in] period    Period in [s]
+     */
+    void step(float period)
+    {
+        step(period, 0U, m_capacity);
+    }
+
+    /**
+     * Advance a range of robots by one period. Only the state of these
+     * robots is written, so disjunct ranges can be stepped in parallel.
+     *
+     * @param[in] period    Period in [s]
+     * @param[in] begin     Index of the first robot
+     * @param[in] end       Index behind the last robot
+     */
+    void step(float period, size_t begin, size_t end);
+
+    /**
+     * Sample the line sensors of all robots.
+     */
+    void sampleLineSensors()
+    {
+        sampleLineSensors(0U, m_capacity);
+    }
+
+    /**
+     * Sample the line sensors of a range of robots.
+     *
+     * @param[in] begin Index of the first robot
+     * @param[in] end   Index behind the last robot
+     */
+    void sampleLineSensors(size_t begin, size_t end);
+
+    /**
+     * Get the normalized line sensor values of a robot.
+     *
+     * @param[in]  idx      Robot index
+     * @param[out] values   Sensor values 0 (white) .. 1000 (black), NUM_LINE_SENSORS values.
+     */
+    void getSensorValues(size_t idx, uint16_t* values) const;
+
+    /**
+     * Get the driven distance of a robot.
+     *
+     * @param[in] idx   Robot index
+     *
+     * @return Mileage in [mm]
+     */
+    uint32_t getMileage(size_t idx) const
+    {
+        return static_cast<uint32_t>(m_mileage[idx]);
+    }
+
+    /**
+     * Get the pose of a robot.
+     *
+     * @param[in]  idx      Robot index
+     * @param[out] posX     x-coordinate in [mm]
+     * @param[out] posY     y-coordinate in [mm]
+     * @param[out] heading  Heading in [rad]
+     */
+    void getPose(size_t idx, float& posX, float& posY, float& heading) const
+    {
+        posX    = m_posX[idx];
+        posY    = m_posY[idx];
+        heading = m_heading[idx];
+    }
+
+    /**
+     * Get the linear speed of a robot.
+     *
+     * @param[in] idx   Robot index
+     *
+     * @return Linear speed in [mm/s]
+     */
+    float getLinearSpeed(size_t idx) const
+    {
+        return 0.5F * (m_speedLeft[idx] + m_speedRight[idx]);
+    }
+
+    /**
+     * Get the progress of a robot along the track.
+     *
+     * @param[in] idx   Robot index
+     *
+     * @return Progress in [mm]
+     */
+    float getProgress(size_t idx) const
+    {
+        return m_track.getProgress(m_posX[idx], m_posY[idx]);
+    }
+
+    /**
+     * Get the distance of the robot center to the line center.
+     *
+     * @param[in] idx   Robot index
+     *
+     * @return Distance in [mm]
+     */
+    float getDistance(size_t idx) const
+    {
+        return m_track.getDistance(m_posX[idx], m_posY[idx]);
+    }
+
+private:
+    /** Lateral offsets of the line sensors to the left in [mm], like in the simulation model. */
+    static const float SENSOR_OFFSETS[NUM_LINE_SENSORS];
+
+    /** Distance of the line sensors in front of the wheel axis in [mm]. */
+    static const float SENSOR_LOOKAHEAD;
+
+    /** Distance from the line border in [mm], where a sensor sees white. */
+    static const float SENSOR_BLUR;
+
+    /** Time constant of the closed wheel speed control loop in [s]. */
+    static const float WHEEL_TIME_CONSTANT;
+
+    const Track&       m_track;         /**< Track */
+    size_t             m_capacity;      /**< Number of robots */
+    std::vector<float> m_posX;          /**< x-coordinates in [mm] */
+    std::vector<float> m_posY;          /**< y-coordinates in [mm] */
+    std::vector<float> m_heading;       /**< Headings in [rad] */
+    std::vector<float> m_cosHeading;    /**< Cosine of the headings */
+    std::vector<float> m_sinHeading;    /**< Sine of the headings */
+    std::vector<float> m_speedLeft;     /**< Linear speeds left in [mm/s] */
+    std::vector<float> m_speedRight;    /**< Linear speeds right in [mm/s] */
+    std::vector<float> m_setPointLeft;  /**< Linear speed set points left in [mm/s] */
+    std::vector<float> m_setPointRight; /**< Linear speed set points right in [mm/s] */
+    std::vector<float> m_gainLeft;      /**< Motor gains left */
+    std::vector<float> m_gainRight;     /**< Motor gains right */
+    std::vector<float> m_mileage;       /**< Driven distance in [mm] */
+
+    /** Normalized line sensor values, one array per sensor. */
+    std::vector<uint16_t> m_sensorValues[NUM_LINE_SENSORS];
+
+    /* Not allowed. */
+    PlantBatch(const PlantBatch& batch);
+    PlantBatch& operator=(const PlantBatch& batch);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* PLANT_BATCH_H */
+/** @} */
@@ -0,0 +1,111 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Reproducible random number generator
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Xorshift random number generator. Every robot uses its own stream, which
+ * only depends on the seed and the robot number. Therefore the results don't
+ * depend on the order or the thread, in which the robots are processed.
+ */
+class Random
+{
+public:
+    /**
+     * Constructs the generator.
+     *
+     * @param[in] seed      Seed
+     * @param[in] stream    Stream number, e.g. the robot number.
+     */
+    Random(uint32_t seed, uint32_t stream) : m_state((seed * 2654435761U) ^ ((stream + 1U) * 40503U))
+    {
+        /* Xorshift gets stuck at 0. */
+        if (0U == m_state)
+        {
+            m_state = 1U;
+        }
+    }
+
+    /**
+     * Destroys the generator.
+     */
+    ~Random()
+    {
+    }
+
+    /**
+     * Get the next uniform random value.
+     *
+     * @return Random value in [-1; 1]
+     */
+    float getNext()
+    {
+        m_state ^= m_state << 13U;
+        m_state ^= m_state >> 17U;
+        m_state ^= m_state << 5U;
+
+        /* Use the upper 24 bit, which fit exactly into the float mantissa. */
+        return (static_cast<float>(m_state >> 8U) / 8388607.5F) - 1.0F;
+    }
+
+private:
+    uint32_t m_state; /**< Generator state, never 0. */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* RANDOM_H */
+/** @} */
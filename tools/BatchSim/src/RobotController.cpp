@@ -0,0 +1,155 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Line follower controller of a single robot in the batch simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "RobotController.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+RobotController::RobotController() :
+    m_normalizer(),
+    m_lineFollowCtrl(),
+    m_maxMotorSpeed(0),
+    m_trackStatus(TRACK_STATUS_ON_TRACK),
+    m_lostMileage(0U),
+    m_speedLeft(0),
+    m_speedRight(0)
+{
+}
+
+void RobotController::init(const Parameters& parameters, int16_t maxMotorSpeed)
+{
+    m_normalizer.clear();
+
+    m_maxMotorSpeed = maxMotorSpeed;
+    m_trackStatus   = TRACK_STATUS_ON_TRACK;
+    m_lostMileage   = 0U;
+    m_speedLeft     = 0;
+    m_speedRight    = 0;
+
+    m_lineFollowCtrl.start(parameters, maxMotorSpeed);
+}
+
+void RobotController::process(const uint16_t* sensorValues, uint32_t mileage, int16_t& speedLeft,
+                              int16_t& speedRight)
+{
+    int16_t position = m_normalizer.estimatePosition(sensorValues);
+
+    switch (m_trackStatus)
+    {
+    case TRACK_STATUS_ON_TRACK:
+        if (true == LineFollowController::isTrackGapDetected(position, PlantBatch::NUM_LINE_SENSORS))
+        {
+            m_trackStatus = TRACK_STATUS_LOST;
+            m_lostMileage = mileage;
+        }
+        else
+        {
+            (void)m_lineFollowCtrl.process(position, LineSensorNormalizer<PlantBatch::NUM_LINE_SENSORS>::NORMALIZED_MAX,
+                                           m_maxMotorSpeed, m_speedLeft, m_speedRight);
+        }
+        break;
+
+    case TRACK_STATUS_LOST:
+        /* Back on track? */
+        if (false == LineFollowController::isTrackGapDetected(position, PlantBatch::NUM_LINE_SENSORS))
+        {
+            m_trackStatus = TRACK_STATUS_ON_TRACK;
+            m_lineFollowCtrl.resync();
+        }
+        /* Max. distance driven, but track still not found? */
+        else if (LineFollowController::MAX_DISTANCE < (mileage - m_lostMileage))
+        {
+            m_speedLeft   = 0;
+            m_speedRight  = 0;
+            m_trackStatus = TRACK_STATUS_FAILED;
+        }
+        else
+        {
+            /* Drive straight on. */
+            m_speedLeft  = m_lineFollowCtrl.getTopSpeed();
+            m_speedRight = m_lineFollowCtrl.getTopSpeed();
+        }
+        break;
+
+    case TRACK_STATUS_FAILED:
+        /* fallthrough */
+
+    default:
+        m_speedLeft  = 0;
+        m_speedRight = 0;
+        break;
+    }
+
+    speedLeft  = m_speedLeft;
+    speedRight = m_speedRight;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
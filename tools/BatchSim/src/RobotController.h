@@ -0,0 +1,172 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Line follower controller of a single robot in the batch simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef ROBOT_CONTROLLER_H
+#define ROBOT_CONTROLLER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <LineFollowController.hpp>
+#include <LineSensorNormalizer.hpp>
+#include "PlantBatch.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The line following control of the LineFollower DrivingState for one robot.
+ *
+ * The DrivingState itself is bound to the board and the differential drive
+ * singletons. Therefore only its track handling is done here, the control
+ * law is the same LineFollowController, which the DrivingState uses. The
+ * line position is estimated by the LineSensorNormalizer, like on the robot.
+ */
+class RobotController
+{
+public:
+    /** Controller parameters, like a parameter set of the LineFollower. */
+    struct Parameters
+    {
+        int16_t topSpeed;      /**< Top speed in [steps/s] */
+        int16_t kPNumerator;   /**< Kp numerator */
+        int16_t kPDenominator; /**< Kp denominator */
+        int16_t kINumerator;   /**< Ki numerator */
+        int16_t kIDenominator; /**< Ki denominator */
+        int16_t kDNumerator;   /**< Kd numerator */
+        int16_t kDDenominator; /**< Kd denominator */
+    };
+
+    /** Track status */
+    enum TrackStatus
+    {
+        TRACK_STATUS_ON_TRACK = 0, /**< Robot is on track */
+        TRACK_STATUS_LOST,         /**< Track is lost */
+        TRACK_STATUS_FAILED        /**< Track not found again, robot stopped */
+    };
+
+    /**
+     * Constructs the controller.
+     */
+    RobotController();
+
+    /**
+     * Destroys the controller.
+     */
+    ~RobotController()
+    {
+    }
+
+    /**
+     * Initialize the controller for a new run, like the DrivingState entry.
+     *
+     * @param[in] parameters    Controller parameters
+     * @param[in] maxMotorSpeed Max. motor speed in [steps/s]
+     */
+    void init(const Parameters& parameters, int16_t maxMotorSpeed);
+
+    /**
+     * Process one control period.
+     *
+     * @param[in]  sensorValues Normalized line sensor values
+     * @param[in]  mileage      Driven distance in [mm]
+     * @param[out] speedLeft    Linear speed set point left in [steps/s]
+     * @param[out] speedRight   Linear speed set point right in [steps/s]
+     */
+    void process(const uint16_t* sensorValues, uint32_t mileage, int16_t& speedLeft, int16_t& speedRight);
+
+    /**
+     * Set the top speed, e.g. by a speed governor.
+     *
+     * @param[in] topSpeed  Top speed in [steps/s]
+     */
+    void setTopSpeed(int16_t topSpeed)
+    {
+        m_lineFollowCtrl.setTopSpeed(topSpeed);
+    }
+
+    /**
+     * Get the top speed.
+     *
+     * @return Top speed in [steps/s]
+     */
+    int16_t getTopSpeed() const
+    {
+        return m_lineFollowCtrl.getTopSpeed();
+    }
+
+    /**
+     * Get the track status.
+     *
+     * @return Track status
+     */
+    TrackStatus getTrackStatus() const
+    {
+        return m_trackStatus;
+    }
+
+private:
+    /** Line position estimation */
+    LineSensorNormalizer<PlantBatch::NUM_LINE_SENSORS> m_normalizer;
+
+    LineFollowController m_lineFollowCtrl; /**< Control law of the line follower */
+    int16_t              m_maxMotorSpeed;  /**< Max. motor speed in [steps/s] */
+    TrackStatus          m_trackStatus;    /**< Track status */
+    uint32_t             m_lostMileage;    /**< Mileage in [mm], when the track was lost */
+    int16_t              m_speedLeft;      /**< Linear speed set point left in [steps/s] */
+    int16_t              m_speedRight;     /**< Linear speed set point right in [steps/s] */
+
+    /* Not allowed. */
+    RobotController(const RobotController& controller);
+    RobotController& operator=(const RobotController& controller);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* ROBOT_CONTROLLER_H */
+/** @} */
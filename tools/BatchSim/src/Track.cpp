@@ -0,0 +1,199 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Track model of the batch simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Track.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** PI as float. */
+static const float FLOAT_PI = 3.14159265F;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Track::Track(float straightLength, float radius, float lineWidth) :
+    m_straightLength(straightLength),
+    m_radius(radius),
+    m_halfLineWidth(0.5F * lineWidth),
+    m_length((2.0F * straightLength) + (2.0F * FLOAT_PI * radius))
+{
+}
+
+void Track::getStartPose(float& posX, float& posY, float& heading) const
+{
+    posX    = 0.0F;
+    posY    = -m_radius;
+    heading = 0.0F;
+}
+
+void Track::getPose(float progress, float& posX, float& posY, float& heading) const
+{
+    float halfStraight = 0.5F * m_straightLength;
+    float halfCircle   = FLOAT_PI * m_radius;
+    float distance     = fmodf(progress + halfStraight, m_length);
+
+    /* Measured from the west end of the lower straight. */
+    if (0.0F > distance)
+    {
+        distance += m_length;
+    }
+
+    /* Lower straight */
+    if (m_straightLength > distance)
+    {
+        posX    = distance - halfStraight;
+        posY    = -m_radius;
+        heading = 0.0F;
+    }
+    /* East half circle */
+    else if ((m_straightLength + halfCircle) > distance)
+    {
+        float angle = ((distance - m_straightLength) / m_radius) - (0.5F * FLOAT_PI);
+
+        posX    = halfStraight + (m_radius * cosf(angle));
+        posY    = m_radius * sinf(angle);
+        heading = angle + (0.5F * FLOAT_PI);
+    }
+    /* Upper straight */
+    else if (((2.0F * m_straightLength) + halfCircle) > distance)
+    {
+        posX    = halfStraight - (distance - m_straightLength - halfCircle);
+        posY    = m_radius;
+        heading = FLOAT_PI;
+    }
+    /* West half circle */
+    else
+    {
+        float angle = ((distance - (2.0F * m_straightLength) - halfCircle) / m_radius) + (0.5F * FLOAT_PI);
+
+        posX    = (m_radius * cosf(angle)) - halfStraight;
+        posY    = m_radius * sinf(angle);
+        heading = angle + (0.5F * FLOAT_PI);
+    }
+}
+
+float Track::getProgress(float posX, float posY) const
+{
+    float halfStraight = 0.5F * m_straightLength;
+    float halfCircle   = FLOAT_PI * m_radius;
+    float progress     = 0.0F; /* Measured from the west end of the lower straight. */
+
+    /* East half circle */
+    if (halfStraight < posX)
+    {
+        float angle = atan2f(posY, posX - halfStraight); /* -PI/2 .. PI/2 */
+
+        progress = m_straightLength + ((angle + (0.5F * FLOAT_PI)) * m_radius);
+    }
+    /* West half circle */
+    else if (-halfStraight > posX)
+    {
+        float angle = atan2f(posY, posX + halfStraight); /* PI/2 .. PI and -PI .. -PI/2 */
+
+        if (0.0F <= angle)
+        {
+            angle -= 0.5F * FLOAT_PI;
+        }
+        else
+        {
+            angle += 1.5F * FLOAT_PI;
+        }
+
+        progress = (2.0F * m_straightLength) + halfCircle + (angle * m_radius);
+    }
+    /* Lower straight */
+    else if (0.0F > posY)
+    {
+        progress = posX + halfStraight;
+    }
+    /* Upper straight */
+    else
+    {
+        progress = m_straightLength + halfCircle + (halfStraight - posX);
+    }
+
+    /* Relative to the start in the middle of the lower straight. */
+    progress -= halfStraight;
+
+    if (0.0F > progress)
+    {
+        progress += m_length;
+    }
+    else if (m_length <= progress)
+    {
+        progress -= m_length;
+    }
+    else
+    {
+        ;
+    }
+
+    return progress;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
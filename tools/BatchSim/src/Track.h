@@ -0,0 +1,167 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Track model of the batch simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef TRACK_H
+#define TRACK_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <math.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Analytic stadium shaped track: two straights, connected by two half
+ * circles. The center line is driven counter-clockwise and the start is in
+ * the middle of the lower straight, heading to the east.
+ *
+ * The track is evaluated analytically, so sampling the line sensors of
+ * thousands of robots needs no texture lookups.
+ */
+class Track
+{
+public:
+    /**
+     * Constructs the track.
+     *
+     * @param[in] straightLength    Length of a straight in [mm]
+     * @param[in] radius            Radius of the half circles in [mm]
+     * @param[in] lineWidth         Width of the line in [mm]
+     */
+    Track(float straightLength, float radius, float lineWidth);
+
+    /**
+     * Destroys the track.
+     */
+    ~Track()
+    {
+    }
+
+    /**
+     * Get the length of the center line.
+     *
+     * @return Length in [mm]
+     */
+    float getLength() const
+    {
+        return m_length;
+    }
+
+    /**
+     * Get half of the line width.
+     *
+     * @return Half line width in [mm]
+     */
+    float getHalfLineWidth() const
+    {
+        return m_halfLineWidth;
+    }
+
+    /**
+     * Get the start pose on the center line.
+     *
+     * @param[out] posX     x-coordinate in [mm]
+     * @param[out] posY     y-coordinate in [mm]
+     * @param[out] heading  Heading in [rad]
+     */
+    void getStartPose(float& posX, float& posY, float& heading) const;
+
+    /**
+     * Get the pose on the center line at a driven distance from the start.
+     *
+     * @param[in]  progress Driven distance from the start in [mm], may be negative.
+     * @param[out] posX     x-coordinate in [mm]
+     * @param[out] posY     y-coordinate in [mm]
+     * @param[out] heading  Heading in [rad]
+     */
+    void getPose(float progress, float& posX, float& posY, float& heading) const;
+
+    /**
+     * Get the distance of a point to the center line.
+     * It is branch free, to allow the compiler to vectorize the callers.
+     *
+     * @param[in] posX  x-coordinate in [mm]
+     * @param[in] posY  y-coordinate in [mm]
+     *
+     * @return Distance in [mm]
+     */
+    float getDistance(float posX, float posY) const
+    {
+        float halfStraight = 0.5F * m_straightLength;
+        float clampedX     = (posX < -halfStraight) ? -halfStraight : ((posX > halfStraight) ? halfStraight : posX);
+        float deltaX       = posX - clampedX;
+        float radial       = sqrtf((deltaX * deltaX) + (posY * posY));
+        float distance     = radial - m_radius;
+
+        return (0.0F > distance) ? -distance : distance;
+    }
+
+    /**
+     * Get the driven distance along the center line from the start to the
+     * projection of a point.
+     *
+     * @param[in] posX  x-coordinate in [mm]
+     * @param[in] posY  y-coordinate in [mm]
+     *
+     * @return Progress in [0; length) in [mm]
+     */
+    float getProgress(float posX, float posY) const;
+
+private:
+    float m_straightLength; /**< Length of a straight in [mm] */
+    float m_radius;         /**< Radius of the half circles in [mm] */
+    float m_halfLineWidth;  /**< Half line width in [mm] */
+    float m_length;         /**< Length of the center line in [mm] */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* TRACK_H */
+/** @} */
@@ -0,0 +1,390 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  World with several robots in virtual time
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "World.h"
+#include <math.h>
+#include <string.h>
+#include <thread>
+#include <functional>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Initialize static constant data. */
+const float World::START_OFFSET_MAX                      = 5.0F;
+const float World::START_HEADING_MAX                     = 0.05F;
+const float World::MOTOR_GAIN_DEVIATION_MAX              = 0.05F;
+const float World::PROXIMITY_SENSOR_X                    = 55.0F;
+const float World::PROXIMITY_SENSOR_Y                    = 20.0F;
+const float World::PROXIMITY_HALF_APERTURE               = 0.35F;
+const float World::PROXIMITY_TABLE_STEP                  = 50.0F;
+const float World::PROXIMITY_TABLE[PROXIMITY_TABLE_SIZE] = {6.0F, 6.0F, 5.0F, 6.0F, 3.0F, 2.0F, 1.0F};
+const float World::ROBOT_RADIUS                          = 50.0F;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+World::World(const Track& track, size_t capacity, uint32_t seed) :
+    m_track(track),
+    m_plant(track, capacity),
+    m_seed(seed),
+    m_contexts(),
+    m_random(),
+    m_messages(),
+    m_messageLossRate(0.0F),
+    m_timestamp(0U)
+{
+    m_contexts.reserve(capacity);
+    m_random.reserve(capacity);
+}
+
+bool World::addRobot(IRobotContext& context, float progress)
+{
+    bool isSuccessful = false;
+
+    if ((m_plant.getCapacity() > m_contexts.size()) && (MAX_ROBOTS > m_contexts.size()))
+    {
+        size_t     id = m_contexts.size();
+        Random     random(m_seed, static_cast<uint32_t>(id));
+        V2VMessage noMessage;
+        float      posX    = 0.0F;
+        float      posY    = 0.0F;
+        float      heading = 0.0F;
+        float      offset  = 0.0F;
+
+        m_track.getPose(progress, posX, posY, heading);
+
+        offset = START_OFFSET_MAX * random.getNext();
+        posX -= offset * sinf(heading);
+        posY += offset * cosf(heading);
+        heading += START_HEADING_MAX * random.getNext();
+
+        m_plant.reset(id, posX, posY, heading, 1.0F + (MOTOR_GAIN_DEVIATION_MAX * random.getNext()),
+                      1.0F + (MOTOR_GAIN_DEVIATION_MAX * random.getNext()));
+
+        memset(&noMessage, 0, sizeof(noMessage));
+        noMessage.senderId = static_cast<uint8_t>(id);
+
+        m_contexts.push_back(&context);
+        m_random.push_back(random);
+        m_messages[0].push_back(noMessage);
+        m_messages[1].push_back(noMessage);
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+void World::run(uint32_t duration, uint32_t numThreads)
+{
+    uint32_t                 numTicks      = (duration + TICK_PERIOD - 1U) / TICK_PERIOD;
+    size_t                   numRobots     = m_contexts.size();
+    size_t                   numPartitions = numThreads;
+    size_t                   partitionSize = 0U;
+    size_t                   begin         = 0U;
+    std::vector<std::thread> threads;
+
+    if (numRobots < numPartitions)
+    {
+        numPartitions = numRobots;
+    }
+
+    if ((0U < numTicks) && (0U < numPartitions))
+    {
+        partitionSize = (numRobots + numPartitions - 1U) / numPartitions;
+        numPartitions = (numRobots + partitionSize - 1U) / partitionSize;
+
+        Barrier barrier(static_cast<uint32_t>(numPartitions));
+
+        /* The first partition is processed by the calling thread. */
+        for (begin = partitionSize; begin < numRobots; begin += partitionSize)
+        {
+            size_t end = ((numRobots - begin) < partitionSize) ? numRobots : (begin + partitionSize);
+
+            threads.push_back(std::thread(&World::runPartition, this, begin, end, numTicks, std::ref(barrier)));
+        }
+
+        runPartition(0U, partitionSize, numTicks, barrier);
+
+        for (size_t idx = 0U; idx < threads.size(); ++idx)
+        {
+            threads[idx].join();
+        }
+
+        m_timestamp += numTicks * TICK_PERIOD;
+    }
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void World::runPartition(size_t begin, size_t end, uint32_t numTicks, Barrier& barrier)
+{
+    const float             PERIOD = static_cast<float>(TICK_PERIOD) / 1000.0F; /* [s] */
+    std::vector<V2VMessage> inbox;
+    uint32_t                tick = 0U;
+
+    inbox.reserve(m_contexts.size());
+
+    for (tick = 0U; tick < numTicks; ++tick)
+    {
+        uint32_t                       timestamp = m_timestamp + (tick * TICK_PERIOD);
+        uint8_t                        current   = static_cast<uint8_t>((timestamp / TICK_PERIOD) % 2U);
+        const std::vector<V2VMessage>& received  = m_messages[1U - current];
+        std::vector<V2VMessage>&       sent      = m_messages[current];
+        size_t                         id        = 0U;
+
+        m_plant.sampleLineSensors(begin, end);
+
+        for (id = begin; id < end; ++id)
+        {
+            processRobot(id, timestamp, received, sent[id], inbox);
+        }
+
+        /* All robots sensed the world state, before it is changed. */
+        barrier.wait();
+
+        m_plant.step(PERIOD, begin, end);
+
+        /* All robots moved, before the next tick senses them. */
+        barrier.wait();
+    }
+}
+
+void World::processRobot(size_t id, uint32_t timestamp, const std::vector<V2VMessage>& received, V2VMessage& sent,
+                         std::vector<V2VMessage>& inbox)
+{
+    uint16_t   sensorValues[PlantBatch::NUM_LINE_SENSORS];
+    Perception perception;
+    Actuation  actuation;
+    size_t     sender = 0U;
+
+    m_plant.getSensorValues(id, sensorValues);
+
+    perception.timestamp        = timestamp;
+    perception.lineSensorValues = sensorValues;
+    perception.mileage          = m_plant.getMileage(id);
+
+    senseRobots(id, perception);
+
+    /* Deliver the messages in the order of the sender ids. */
+    inbox.clear();
+
+    for (sender = 0U; sender < received.size(); ++sender)
+    {
+        if ((sender != id) && (0U < received[sender].size))
+        {
+            /* Every robot draws from its own random generator, so the loss doesn't depend on the threads. */
+            bool isLost = (0.0F < m_messageLossRate) &&
+                          (m_messageLossRate > (0.5F * (m_random[id].getNext() + 1.0F)));
+
+            if (false == isLost)
+            {
+                inbox.push_back(received[sender]);
+            }
+        }
+    }
+
+    perception.messages    = inbox.data();
+    perception.numMessages = inbox.size();
+
+    memset(&actuation, 0, sizeof(actuation));
+    actuation.message.senderId = static_cast<uint8_t>(id);
+
+    m_contexts[id]->process(perception, actuation);
+
+    m_plant.setSpeeds(id, actuation.speedLeft, actuation.speedRight);
+
+    sent          = actuation.message;
+    sent.senderId = static_cast<uint8_t>(id);
+
+    if (V2VMessage::MAX_PAYLOAD_SIZE < sent.size)
+    {
+        sent.size = V2VMessage::MAX_PAYLOAD_SIZE;
+    }
+}
+
+void World::senseRobots(size_t id, Perception& perception) const
+{
+    float  posX            = 0.0F;
+    float  posY            = 0.0F;
+    float  heading         = 0.0F;
+    float  cosHeading      = 0.0F;
+    float  sinHeading      = 0.0F;
+    float  nearestDistance = 0.0F;
+    size_t other           = 0U;
+
+    m_plant.getPose(id, posX, posY, heading);
+    cosHeading = cosf(heading);
+    sinHeading = sinf(heading);
+
+    perception.proximityLeft  = 0U;
+    perception.proximityRight = 0U;
+    perception.isRobotAhead   = false;
+    memset(&perception.robotAhead, 0, sizeof(perception.robotAhead));
+
+    for (other = 0U; other < m_contexts.size(); ++other)
+    {
+        float   otherX       = 0.0F;
+        float   otherY       = 0.0F;
+        float   otherHeading = 0.0F;
+        float   deltaX       = 0.0F;
+        float   deltaY       = 0.0F;
+        float   relativeX    = 0.0F;
+        float   relativeY    = 0.0F;
+        uint8_t countsLeft   = 0U;
+        uint8_t countsRight  = 0U;
+        int8_t  side         = 0;
+
+        if (other != id)
+        {
+            m_plant.getPose(other, otherX, otherY, otherHeading);
+
+            /* Transform into the robot coordinate system. */
+            deltaX    = otherX - posX;
+            deltaY    = otherY - posY;
+            relativeX = (deltaX * cosHeading) + (deltaY * sinHeading);
+            relativeY = (deltaY * cosHeading) - (deltaX * sinHeading);
+
+            /* Left sensor first, right sensor mirrored. */
+            for (side = 1; -1 <= side; side -= 2)
+            {
+                float sensorX = relativeX - PROXIMITY_SENSOR_X;
+                float sensorY = relativeY - (static_cast<float>(side) * PROXIMITY_SENSOR_Y);
+
+                if ((0.0F < sensorX) && (PROXIMITY_HALF_APERTURE >= fabsf(atan2f(sensorY, sensorX))))
+                {
+                    float   distance = sqrtf((sensorX * sensorX) + (sensorY * sensorY)) - ROBOT_RADIUS; /* [mm] */
+                    uint8_t counts   = getProximityCounts(distance);
+
+                    if (0 < side)
+                    {
+                        countsLeft = counts;
+                    }
+                    else
+                    {
+                        countsRight = counts;
+                    }
+                }
+            }
+
+            if (perception.proximityLeft < countsLeft)
+            {
+                perception.proximityLeft = countsLeft;
+            }
+
+            if (perception.proximityRight < countsRight)
+            {
+                perception.proximityRight = countsRight;
+            }
+
+            /* Is it the nearest robot, which the proximity sensors see? */
+            if ((0U < countsLeft) || (0U < countsRight))
+            {
+                float distance = (relativeX * relativeX) + (relativeY * relativeY);
+
+                if ((false == perception.isRobotAhead) || (nearestDistance > distance))
+                {
+                    float deltaHeading = otherHeading - heading;
+
+                    perception.isRobotAhead       = true;
+                    perception.robotAhead.posX    = relativeX;
+                    perception.robotAhead.posY    = relativeY;
+                    perception.robotAhead.heading = atan2f(sinf(deltaHeading), cosf(deltaHeading));
+                    nearestDistance               = distance;
+                }
+            }
+        }
+    }
+}
+
+uint8_t World::getProximityCounts(float distance)
+{
+    const float RANGE  = PROXIMITY_TABLE_STEP * static_cast<float>(PROXIMITY_TABLE_SIZE - 1U);
+    float       counts = 0.0F;
+
+    if (0.0F >= distance)
+    {
+        counts = PROXIMITY_TABLE[0];
+    }
+    else if (RANGE <= distance)
+    {
+        /* Only exactly at the range the last entry is valid, behind nothing is seen. */
+        counts = (RANGE == distance) ? PROXIMITY_TABLE[PROXIMITY_TABLE_SIZE - 1U] : 0.0F;
+    }
+    else
+    {
+        float  position = distance / PROXIMITY_TABLE_STEP;
+        size_t idx      = static_cast<size_t>(position);
+        float  fraction = position - static_cast<float>(idx);
+
+        /* Linear interpolation like the simulation, the counts are truncated by the sensor driver. */
+        counts = PROXIMITY_TABLE[idx] + (fraction * (PROXIMITY_TABLE[idx + 1U] - PROXIMITY_TABLE[idx]));
+    }
+
+    return static_cast<uint8_t>(counts);
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
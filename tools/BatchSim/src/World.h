@@ -0,0 +1,277 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  World with several robots in virtual time
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup BatchSim
+ *
+ * @{
+ */
+
+#ifndef WORLD_H
+#define WORLD_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "Track.h"
+#include "PlantBatch.h"
+#include "Random.h"
+#include "Barrier.h"
+#include "IRobotContext.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * World, which owns one virtual clock and steps several robots in lockstep.
+ * Every tick has two phases, separated by barriers:
+ * 1. Sense and control: Every robot senses the world state at the begin of
+ *    the tick, e.g. the other robots by its proximity sensors and the
+ *    messages of the last tick, and its context commands the motors.
+ * 2. Integrate: The motion of every robot is integrated over the tick.
+ *
+ * A robot only writes its own state in both phases and reads the state of
+ * other robots only in the first phase. Therefore the robots are
+ * partitioned to threads and the results are bit for bit equal, independent
+ * of the number of threads. All random values are derived from the seed.
+ */
+class World
+{
+public:
+    /** Tick period in [ms], like the control period of the applications. */
+    static const uint32_t TICK_PERIOD = 5U;
+
+    /** Max. number of robots, limited by the sender id of the messages. */
+    static const size_t MAX_ROBOTS = UINT8_MAX;
+
+    /**
+     * Constructs the world.
+     *
+     * @param[in] track     Track
+     * @param[in] capacity  Max. number of robots
+     * @param[in] seed      Seed of the robot variations and the message loss
+     */
+    World(const Track& track, size_t capacity, uint32_t seed);
+
+    /**
+     * Destroys the world.
+     */
+    ~World()
+    {
+    }
+
+    /**
+     * Add a robot, placed on the center line with a random variation.
+     * The robot id is the number of robots before.
+     *
+     * @param[in] context   Robot context, which must exist as long as the world.
+     * @param[in] progress  Driven distance of the start position from the track start in [mm]
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addRobot(IRobotContext& context, float progress);
+
+    /**
+     * Set the probability, that a message is lost at a receiver.
+     *
+     * @param[in] lossRate  Probability in [0; 1]
+     */
+    void setMessageLossRate(float lossRate)
+    {
+        m_messageLossRate = lossRate;
+    }
+
+    /**
+     * Run the world for a duration.
+     *
+     * @param[in] duration      Duration in [ms], rounded up to whole ticks.
+     * @param[in] numThreads    Number of threads, the robots are partitioned to.
+     */
+    void run(uint32_t duration, uint32_t numThreads);
+
+    /**
+     * Get the virtual time.
+     *
+     * @return Timestamp in [ms]
+     */
+    uint32_t getTimestamp() const
+    {
+        return m_timestamp;
+    }
+
+    /**
+     * Get the number of robots.
+     *
+     * @return Number of robots
+     */
+    size_t getNumRobots() const
+    {
+        return m_contexts.size();
+    }
+
+    /**
+     * Get the pose of a robot.
+     *
+     * @param[in]  id       Robot id
+     * @param[out] posX     x-coordinate in [mm]
+     * @param[out] posY     y-coordinate in [mm]
+     * @param[out] heading  Heading in [rad]
+     */
+    void getPose(size_t id, float& posX, float& posY, float& heading) const
+    {
+        m_plant.getPose(id, posX, posY, heading);
+    }
+
+    /**
+     * Get the linear speed of a robot.
+     *
+     * @param[in] id    Robot id
+     *
+     * @return Linear speed in [mm/s]
+     */
+    float getLinearSpeed(size_t id) const
+    {
+        return m_plant.getLinearSpeed(id);
+    }
+
+    /**
+     * Get the progress of a robot along the track.
+     *
+     * @param[in] id    Robot id
+     *
+     * @return Progress in [mm]
+     */
+    float getProgress(size_t id) const
+    {
+        return m_plant.getProgress(id);
+    }
+
+private:
+    /** Max. lateral start offset in [mm]. */
+    static const float START_OFFSET_MAX;
+
+    /** Max. start heading deviation in [rad]. */
+    static const float START_HEADING_MAX;
+
+    /** Max. motor gain deviation from the nominal gain. */
+    static const float MOTOR_GAIN_DEVIATION_MAX;
+
+    /** Distance of the proximity sensors in front of the robot center in [mm]. */
+    static const float PROXIMITY_SENSOR_X;
+
+    /** Lateral offset of the left proximity sensor in [mm], the right one is mirrored. */
+    static const float PROXIMITY_SENSOR_Y;
+
+    /** Half aperture of the proximity sensors in [rad]. */
+    static const float PROXIMITY_HALF_APERTURE;
+
+    /** Distance between the entries of the proximity lookup table in [mm]. */
+    static const float PROXIMITY_TABLE_STEP;
+
+    /** Number of proximity lookup table entries. */
+    static const uint8_t PROXIMITY_TABLE_SIZE = 7U;
+
+    /** Proximity sensor counts over the distance, like the lookup table of the simulation model. */
+    static const float PROXIMITY_TABLE[PROXIMITY_TABLE_SIZE];
+
+    /** Radius of a robot, seen by the proximity sensors in [mm]. */
+    static const float ROBOT_RADIUS;
+
+    const Track&                m_track;           /**< Track */
+    PlantBatch                  m_plant;           /**< Motion and line sensors of all robots */
+    uint32_t                    m_seed;            /**< Seed */
+    std::vector<IRobotContext*> m_contexts;        /**< Robot contexts, index is the robot id */
+    std::vector<Random>         m_random;          /**< Random generator per robot */
+    std::vector<V2VMessage>     m_messages[2];     /**< Sent messages of the current and the last tick */
+    float                       m_messageLossRate; /**< Probability of a lost message */
+    uint32_t                    m_timestamp;       /**< Virtual time in [ms] */
+
+    /**
+     * Run a partition of robots for several ticks.
+     *
+     * @param[in] begin     Id of the first robot
+     * @param[in] end       Id behind the last robot
+     * @param[in] numTicks  Number of ticks
+     * @param[in] barrier   Barrier of all partitions
+     */
+    void runPartition(size_t begin, size_t end, uint32_t numTicks, Barrier& barrier);
+
+    /**
+     * Sense and control a robot in one tick.
+     *
+     * @param[in]     id        Robot id
+     * @param[in]     timestamp Virtual time in [ms]
+     * @param[in]     received  Messages sent in the last tick, index is the sender id.
+     * @param[out]    sent      Message, which the robot sends in this tick.
+     * @param[in,out] inbox     Buffer for the received messages of the robot
+     */
+    void processRobot(size_t id, uint32_t timestamp, const std::vector<V2VMessage>& received, V2VMessage& sent,
+                      std::vector<V2VMessage>& inbox);
+
+    /**
+     * Sense the other robots by the proximity sensors.
+     *
+     * @param[in]     id            Robot id
+     * @param[in,out] perception    Perception, whose proximity part is set.
+     */
+    void senseRobots(size_t id, Perception& perception) const;
+
+    /**
+     * Get the proximity sensor counts of an object.
+     *
+     * @param[in] distance  Distance of the object surface in [mm]
+     *
+     * @return Counts
+     */
+    static uint8_t getProximityCounts(float distance);
+
+    /* Not allowed. */
+    World(const World& world);
+    World& operator=(const World& world);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* WORLD_H */
+/** @} */
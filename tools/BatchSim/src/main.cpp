@@ -0,0 +1,530 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Batch simulation of many line followers, running on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "BatchSim.h"
+#include "World.h"
+#include "ConvoyRobot.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** This type defines the possible program arguments. */
+typedef struct
+{
+    const char* candidates;         /**< Candidates file or nullptr for the default candidates */
+    uint32_t    robotsPerCandidate; /**< Number of robots per candidate */
+    uint32_t    lapTimeout;         /**< Max. lap time in [s] */
+    uint32_t    seed;               /**< Seed of the robot variations */
+    int16_t     maxMotorSpeed;      /**< Max. motor speed in [steps/s] */
+    uint32_t    numThreads;         /**< Number of worker threads */
+    uint32_t    convoySize;         /**< Number of robots in the convoy, 0 to compare candidates. */
+    float       messageLossRate;    /**< Probability of a lost convoy message */
+    bool        verbose;            /**< Show verbose information */
+
+} PrgArguments;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int      handleCommandLineArguments(PrgArguments& prgArguments, int argc, char** argv);
+static bool     loadCandidates(const char* fileName, std::vector<RobotController::Parameters>& candidates);
+static void     runCandidates(const PrgArguments&                             prgArguments,
+                              const std::vector<RobotController::Parameters>& candidates);
+static void     printResults(const std::vector<RobotController::Parameters>& candidates,
+                             const std::vector<BatchSim::Result>&            results);
+static void     runConvoy(const PrgArguments& prgArguments, const RobotController::Parameters& parameters);
+static uint32_t getTimestamp();
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Program argument default value of the number of robots per candidate. */
+static const uint32_t PRG_ARG_ROBOTS_PER_CANDIDATE_DEFAULT = 100U;
+
+/** Program argument default value of the max. lap time in [s]. */
+static const uint32_t PRG_ARG_LAP_TIMEOUT_DEFAULT = 30U;
+
+/** Program argument default value of the seed. */
+static const uint32_t PRG_ARG_SEED_DEFAULT = 1U;
+
+/** Program argument default value of the max. motor speed in [steps/s]. */
+static const int16_t PRG_ARG_MAX_MOTOR_SPEED_DEFAULT = 4000;
+
+/** Program argument default value of the number of worker threads. */
+static const uint32_t PRG_ARG_NUM_THREADS_DEFAULT = 1U;
+
+/** Period of the convoy trace in [ms]. */
+static const uint32_t CONVOY_TRACE_PERIOD = 100U;
+
+/** Length of a straight of the track in [mm]. */
+static const float TRACK_STRAIGHT_LENGTH = 1000.0F;
+
+/** Radius of the track curves in [mm]. */
+static const float TRACK_RADIUS = 250.0F;
+
+/** Width of the track line in [mm]. */
+static const float TRACK_LINE_WIDTH = 15.0F;
+
+/** Default candidates, which are the parameter sets of the LineFollower application. */
+static const RobotController::Parameters DEFAULT_CANDIDATES[] = {
+    {1920, 3, 2, 1, 60, 4, 1},  /* Slow */
+    {2400, 3, 2, 1, 40, 40, 1}, /* Fast */
+    {2400, 3, 1, 0, 1, 40, 1}   /* Fast without integral part */
+};
+
+/** Max. length of a line in the candidates file. */
+static const size_t LINE_SIZE = 256U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program entry point.
+ *
+ * @param[in] argc  Number of arguments
+ * @param[in] argv  Arguments
+ *
+ * @return Exit status
+ */
+extern int main(int argc, char** argv)
+{
+    int                                     status = 0;
+    PrgArguments                            prgArguments;
+    std::vector<RobotController::Parameters> candidates;
+
+    status = handleCommandLineArguments(prgArguments, argc, argv);
+
+    if (0 == status)
+    {
+        if (nullptr == prgArguments.candidates)
+        {
+            candidates.assign(DEFAULT_CANDIDATES,
+                              DEFAULT_CANDIDATES + (sizeof(DEFAULT_CANDIDATES) / sizeof(DEFAULT_CANDIDATES[0])));
+        }
+        else if (false == loadCandidates(prgArguments.candidates, candidates))
+        {
+            printf("Invalid candidates file: %s\n", prgArguments.candidates);
+            status = -1;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    if (0 == status)
+    {
+        if (0U < prgArguments.convoySize)
+        {
+            runConvoy(prgArguments, candidates[0]);
+        }
+        else
+        {
+            runCandidates(prgArguments, candidates);
+        }
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Handles the command line arguments.
+ *
+ * @param[out]  prgArguments    Program arguments
+ * @param[in]   argc            Number of arguments
+ * @param[in]   argv            Arguments
+ *
+ * @return If successful, it will return 0 otherwise -1.
+ */
+static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char** argv)
+{
+    int         status           = 0;
+    const char* availableOptions = "c:n:t:s:m:j:p:l:vh";
+    const char* programName      = argv[0];
+    long        maxMotorSpeed    = PRG_ARG_MAX_MOTOR_SPEED_DEFAULT;
+    int         option           = getopt(argc, argv, availableOptions);
+
+    /* Set default values */
+    prgArguments.candidates         = nullptr;
+    prgArguments.robotsPerCandidate = PRG_ARG_ROBOTS_PER_CANDIDATE_DEFAULT;
+    prgArguments.lapTimeout         = PRG_ARG_LAP_TIMEOUT_DEFAULT;
+    prgArguments.seed               = PRG_ARG_SEED_DEFAULT;
+    prgArguments.maxMotorSpeed      = PRG_ARG_MAX_MOTOR_SPEED_DEFAULT;
+    prgArguments.numThreads         = PRG_ARG_NUM_THREADS_DEFAULT;
+    prgArguments.convoySize         = 0U;
+    prgArguments.messageLossRate    = 0.0F;
+    prgArguments.verbose            = false;
+
+    while ((-1 != option) && (0 == status))
+    {
+        switch (option)
+        {
+        case 'c': /* Candidates file */
+            prgArguments.candidates = optarg;
+            break;
+
+        case 'n': /* Robots per candidate */
+            prgArguments.robotsPerCandidate = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 't': /* Lap timeout */
+            prgArguments.lapTimeout = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 's': /* Seed */
+            prgArguments.seed = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'm': /* Max. motor speed */
+            maxMotorSpeed = strtol(optarg, nullptr, 10);
+            break;
+
+        case 'j': /* Worker threads */
+            prgArguments.numThreads = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'p': /* Convoy */
+            prgArguments.convoySize = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'l': /* Message loss rate */
+            prgArguments.messageLossRate = strtof(optarg, nullptr);
+            break;
+
+        case 'v': /* Verbose */
+            prgArguments.verbose = true;
+            break;
+
+        case '?': /* Unknown */
+            /* fallthrough */
+
+        case 'h': /* Help */
+            /* fallthrough */
+
+        default: /* Default */
+            status = -1;
+            break;
+        }
+
+        option = getopt(argc, argv, availableOptions);
+    }
+
+    if ((0 == status) && ((0U == prgArguments.robotsPerCandidate) || (0U == prgArguments.numThreads)))
+    {
+        printf("The number of robots per candidate and threads must be greater than 0.\n");
+        status = -1;
+    }
+
+    if ((0 == status) && (World::MAX_ROBOTS < prgArguments.convoySize))
+    {
+        printf("The convoy is limited to %zu robots.\n", World::MAX_ROBOTS);
+        status = -1;
+    }
+
+    if ((0 == status) && ((0.0F > prgArguments.messageLossRate) || (1.0F < prgArguments.messageLossRate)))
+    {
+        printf("The message loss rate must be in the range 0 to 1.\n");
+        status = -1;
+    }
+
+    if ((0 == status) && ((0 >= maxMotorSpeed) || (INT16_MAX < maxMotorSpeed)))
+    {
+        printf("The max. motor speed must be in the range 1 to %d.\n", INT16_MAX);
+        status = -1;
+    }
+    else
+    {
+        prgArguments.maxMotorSpeed = static_cast<int16_t>(maxMotorSpeed);
+    }
+
+    /* Does the user need help? */
+    if (0 > status)
+    {
+        printf("Usage: %s <option(s)>\nOptions:\n", programName);
+        printf("\t-h\t\t\tShow this help message.\n");
+        printf("\t-c <FILE>\t\tCandidates file with one topSpeed,kPN,kPD,kIN,kID,kDN,kDD per line.\n");
+        printf("\t\t\t\tDefault: The LineFollower parameter sets.\n");
+        printf("\t-n <ROBOTS>\t\tSet number of robots per candidate. Default: %u\n",
+               PRG_ARG_ROBOTS_PER_CANDIDATE_DEFAULT);
+        printf("\t-t <SECONDS>\t\tSet max. lap time or convoy duration. Default: %u\n", PRG_ARG_LAP_TIMEOUT_DEFAULT);
+        printf("\t-s <SEED>\t\tSet seed of the robot variations. Default: %u\n", PRG_ARG_SEED_DEFAULT);
+        printf("\t-m <STEPS/S>\t\tSet max. motor speed. Default: %d\n", PRG_ARG_MAX_MOTOR_SPEED_DEFAULT);
+        printf("\t-j <THREADS>\t\tSet number of worker threads. Default: %u\n", PRG_ARG_NUM_THREADS_DEFAULT);
+        printf("\t-p <ROBOTS>\t\tSimulate a convoy with the first candidate instead and trace it.\n");
+        printf("\t-l <RATE>\t\tSet probability of a lost convoy message. Default: 0\n");
+        printf("\t-v\t\t\tVerbose mode.\n");
+    }
+
+    return status;
+}
+
+/**
+ * Load the candidates from a file. Empty lines and lines starting with # are skipped.
+ *
+ * @param[in]   fileName    Name of the candidates file
+ * @param[out]  candidates  Candidates
+ *
+ * @return If successful, it will return true otherwise false.
+ */
+static bool loadCandidates(const char* fileName, std::vector<RobotController::Parameters>& candidates)
+{
+    bool  isValid = true;
+    FILE* in      = fopen(fileName, "r");
+    char  line[LINE_SIZE];
+
+    if (nullptr == in)
+    {
+        isValid = false;
+    }
+
+    while ((true == isValid) && (nullptr != fgets(line, sizeof(line), in)))
+    {
+        int  values[7];
+        char first = '\0';
+
+        if ((1 != sscanf(line, " %c", &first)) || ('#' == first))
+        {
+            /* Skip empty line or comment. */
+            ;
+        }
+        else if (7 != sscanf(line, " %d , %d , %d , %d , %d , %d , %d", &values[0], &values[1], &values[2],
+                             &values[3], &values[4], &values[5], &values[6]))
+        {
+            isValid = false;
+        }
+        else
+        {
+            RobotController::Parameters candidate;
+
+            candidate.topSpeed      = static_cast<int16_t>(values[0]);
+            candidate.kPNumerator   = static_cast<int16_t>(values[1]);
+            candidate.kPDenominator = static_cast<int16_t>(values[2]);
+            candidate.kINumerator   = static_cast<int16_t>(values[3]);
+            candidate.kIDenominator = static_cast<int16_t>(values[4]);
+            candidate.kDNumerator   = static_cast<int16_t>(values[5]);
+            candidate.kDDenominator = static_cast<int16_t>(values[6]);
+
+            /* The PID controller requires denominators not equal to 0. */
+            if ((0 == candidate.kPDenominator) || (0 == candidate.kIDenominator) || (0 == candidate.kDDenominator))
+            {
+                isValid = false;
+            }
+            else
+            {
+                candidates.push_back(candidate);
+            }
+        }
+    }
+
+    if (nullptr != in)
+    {
+        (void)fclose(in);
+    }
+
+    return (true == isValid) && (false == candidates.empty());
+}
+
+/**
+ * Simulate one lap of the candidates and print the results.
+ *
+ * @param[in] prgArguments  Program arguments
+ * @param[in] candidates    Candidates
+ */
+static void runCandidates(const PrgArguments& prgArguments, const std::vector<RobotController::Parameters>& candidates)
+{
+    Track                         track(TRACK_STRAIGHT_LENGTH, TRACK_RADIUS, TRACK_LINE_WIDTH);
+    BatchSim                      sim(track, prgArguments.robotsPerCandidate, prgArguments.seed,
+                                      prgArguments.maxMotorSpeed);
+    std::vector<BatchSim::Result> results(candidates.size());
+    std::vector<std::thread>      threads;
+    size_t                        numThreads = prgArguments.numThreads;
+    size_t                        chunkSize  = 0U;
+    size_t                        start      = 0U;
+    uint32_t                      startTime  = getTimestamp();
+
+    if (candidates.size() < numThreads)
+    {
+        numThreads = candidates.size();
+    }
+
+    /* Every thread simulates its own chunk of candidates in its own plant batch.
+     * The results don't depend on the number of threads.
+     */
+    chunkSize = (candidates.size() + numThreads - 1U) / numThreads;
+
+    for (start = 0U; start < candidates.size(); start += chunkSize)
+    {
+        size_t count = ((candidates.size() - start) < chunkSize) ? (candidates.size() - start) : chunkSize;
+
+        threads.push_back(std::thread(&BatchSim::run, &sim, &candidates[start], count,
+                                      prgArguments.lapTimeout * 1000U, &results[start]));
+    }
+
+    for (size_t idx = 0U; idx < threads.size(); ++idx)
+    {
+        threads[idx].join();
+    }
+
+    printResults(candidates, results);
+
+    if (true == prgArguments.verbose)
+    {
+        fprintf(stderr, "Simulated %zu robots in %u ms with %zu thread(s).\n",
+                candidates.size() * prgArguments.robotsPerCandidate, getTimestamp() - startTime, threads.size());
+    }
+}
+
+/**
+ * Print the results as CSV to stdout.
+ *
+ * @param[in] candidates    Candidates
+ * @param[in] results       Results, one per candidate.
+ */
+static void printResults(const std::vector<RobotController::Parameters>& candidates,
+                         const std::vector<BatchSim::Result>&            results)
+{
+    printf("topSpeed,kPN,kPD,kIN,kID,kDN,kDD,robots,finished,failed,lapTimeMin,lapTimeAvg,lapTimeMax,distance\n");
+
+    for (size_t idx = 0U; idx < candidates.size(); ++idx)
+    {
+        const RobotController::Parameters& candidate = candidates[idx];
+        const BatchSim::Result&            result    = results[idx];
+
+        printf("%d,%d,%d,%d,%d,%d,%d,%u,%u,%u,%u,%u,%u,%.2f\n", candidate.topSpeed, candidate.kPNumerator,
+               candidate.kPDenominator, candidate.kINumerator, candidate.kIDenominator, candidate.kDNumerator,
+               candidate.kDDenominator, result.numRobots, result.numFinished, result.numFailed, result.lapTimeMin,
+               result.lapTimeAvg, result.lapTimeMax, static_cast<double>(result.meanDistance));
+    }
+}
+
+/**
+ * Simulate a convoy in one world and print the trace of every robot as CSV to stdout.
+ *
+ * @param[in] prgArguments  Program arguments
+ * @param[in] parameters    Line follower parameters of all robots
+ */
+static void runConvoy(const PrgArguments& prgArguments, const RobotController::Parameters& parameters)
+{
+    Track                    track(TRACK_STRAIGHT_LENGTH, TRACK_RADIUS, TRACK_LINE_WIDTH);
+    World                    world(track, prgArguments.convoySize, prgArguments.seed);
+    std::vector<ConvoyRobot> robots(prgArguments.convoySize);
+    uint32_t                 duration  = prgArguments.lapTimeout * 1000U; /* [ms] */
+    uint32_t                 startTime = getTimestamp();
+    size_t                   id        = 0U;
+
+    world.setMessageLossRate(prgArguments.messageLossRate);
+
+    /* Line up the convoy behind the start with the nominal gap. */
+    for (id = 0U; id < robots.size(); ++id)
+    {
+        float progress = -static_cast<float>(id * (ConvoyRobot::GAP_NOMINAL + ConvoyRobot::ROBOT_LENGTH));
+
+        robots[id].init(static_cast<uint8_t>(id), parameters, prgArguments.maxMotorSpeed);
+        (void)world.addRobot(robots[id], progress);
+    }
+
+    printf("timestamp,robot,x,y,heading,progress,speed,topSpeed,gap\n");
+
+    while (duration > world.getTimestamp())
+    {
+        world.run(CONVOY_TRACE_PERIOD, prgArguments.numThreads);
+
+        for (id = 0U; id < robots.size(); ++id)
+        {
+            float posX    = 0.0F;
+            float posY    = 0.0F;
+            float heading = 0.0F;
+
+            world.getPose(id, posX, posY, heading);
+
+            printf("%u,%zu,%.1f,%.1f,%.3f,%.1f,%.1f,%d,%d\n", world.getTimestamp(), id, static_cast<double>(posX),
+                   static_cast<double>(posY), static_cast<double>(heading), static_cast<double>(world.getProgress(id)),
+                   static_cast<double>(world.getLinearSpeed(id)), robots[id].getTopSpeed(), robots[id].getGap());
+        }
+    }
+
+    if (true == prgArguments.verbose)
+    {
+        fprintf(stderr, "Simulated %zu robots for %u ms in %u ms with %u thread(s).\n", robots.size(),
+                world.getTimestamp(), getTimestamp() - startTime, prgArguments.numThreads);
+    }
+}
+
+/**
+ * Get the monotonic timestamp.
+ *
+ * @return Timestamp in [ms]
+ */
+static uint32_t getTimestamp()
+{
+    std::chrono::steady_clock::duration now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
@@ -0,0 +1,148 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  List of the channels to record
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ChannelList.h"
+#include "ColumnLog.h"
+#include "CsvConverter.h"
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+const char* const ChannelList::DEFAULT_LIST = "CMD_RSP,LINE_SENS,SYSID,PATH_STAT,TELEMETRY,TLM_SCHEMA";
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ChannelList::ChannelList() : m_list(), m_names(), m_formats(), m_numChannels(0U)
+{
+}
+
+bool ChannelList::parse(const char* channelList)
+{
+    bool  isValid = (nullptr != channelList) && (MAX_LIST_LENGTH >= strlen(channelList));
+    char* token   = nullptr;
+
+    m_numChannels = 0U;
+
+    if (true == isValid)
+    {
+        strncpy(m_list, channelList, MAX_LIST_LENGTH);
+        m_list[MAX_LIST_LENGTH] = '\0';
+
+        token = strtok(m_list, ",");
+    }
+
+    while ((true == isValid) && (nullptr != token))
+    {
+        char* format = strchr(token, ':');
+
+        if (nullptr != format)
+        {
+            *format = '\0';
+            ++format;
+
+            if (false == CsvConverter::isFormatValid(format))
+            {
+                isValid = false;
+            }
+        }
+
+        if ((MAX_CHANNELS <= m_numChannels) || ('\0' == token[0]) ||
+            (ColumnLog::MAX_CHANNEL_NAME_LENGTH < strlen(token)))
+        {
+            isValid = false;
+        }
+
+        if (true == isValid)
+        {
+            m_names[m_numChannels]   = token;
+            m_formats[m_numChannels] = format;
+            ++m_numChannels;
+
+            token = strtok(nullptr, ",");
+        }
+    }
+
+    if (false == isValid)
+    {
+        m_numChannels = 0U;
+    }
+
+    return (true == isValid) && (0U < m_numChannels);
+}
+
+const char* ChannelList::getName(uint8_t idx) const
+{
+    return (m_numChannels > idx) ? m_names[idx] : nullptr;
+}
+
+const char* ChannelList::getFormat(uint8_t idx) const
+{
+    return (m_numChannels > idx) ? m_formats[idx] : nullptr;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,139 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  List of the channels to record
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef CHANNEL_LIST_H
+#define CHANNEL_LIST_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The channels to record, given as comma separated list NAME[:FORMAT].
+ * The optional format is used for the CSV conversion, see CsvConverter.
+ */
+class ChannelList
+{
+public:
+    /** Max. number of channels, same as the recorder supports. */
+    static const uint8_t MAX_CHANNELS = 10U;
+
+    /** Max. length of the channel list. */
+    static const size_t MAX_LIST_LENGTH = 255U;
+
+    /** Default channel list, which are all tx channels of the RemoteControl application. */
+    static const char* const DEFAULT_LIST;
+
+    /**
+     * Constructs a empty channel list.
+     */
+    ChannelList();
+
+    /**
+     * Destroys the channel list.
+     */
+    ~ChannelList()
+    {
+    }
+
+    /**
+     * Parse a comma separated channel list NAME[:FORMAT]. Already parsed
+     * channels are discarded.
+     *
+     * @param[in] channelList   Channel list
+     *
+     * @return If valid and not empty, it will return true otherwise false.
+     */
+    bool parse(const char* channelList);
+
+    /**
+     * Get the number of channels.
+     *
+     * @return Number of channels
+     */
+    uint8_t getNumChannels() const
+    {
+        return m_numChannels;
+    }
+
+    /**
+     * Get the name of a channel.
+     *
+     * @param[in] idx   Channel index
+     *
+     * @return Channel name or nullptr, if the index is invalid.
+     */
+    const char* getName(uint8_t idx) const;
+
+    /**
+     * Get the payload format of a channel.
+     *
+     * @param[in] idx   Channel index
+     *
+     * @return Payload format or nullptr, if none is given or the index is invalid.
+     */
+    const char* getFormat(uint8_t idx) const;
+
+private:
+    char        m_list[MAX_LIST_LENGTH + 1U]; /**< Copy of the list, which is split into the channels. */
+    const char* m_names[MAX_CHANNELS];        /**< Channel names */
+    const char* m_formats[MAX_CHANNELS];      /**< Payload formats or nullptr */
+    uint8_t     m_numChannels;                /**< Number of channels */
+
+    /* Not allowed. */
+    ChannelList(const ChannelList& list);
+    ChannelList& operator=(const ChannelList& list);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* CHANNEL_LIST_H */
+/** @} */
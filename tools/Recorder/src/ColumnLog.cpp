@@ -0,0 +1,249 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Columnar log of a single SerialMuxProt channel
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "ColumnLog.h"
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+ColumnLog::ColumnLog() :
+    m_file(),
+    m_isWritable(false),
+    m_header(nullptr),
+    m_timestamps(nullptr),
+    m_sizes(nullptr),
+    m_payloads(nullptr)
+{
+    /* The packed header layout is part of the file format. */
+    static_assert(HEADER_SIZE == sizeof(Header), "Header size mismatch.");
+}
+
+bool ColumnLog::create(const char* fileName, const char* channelName, uint32_t segment, uint32_t capacity)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((nullptr != channelName) && (MAX_CHANNEL_NAME_LENGTH >= strlen(channelName)) && (0U < capacity) &&
+        (true == m_file.create(fileName, getFileSize(capacity))))
+    {
+        m_header = reinterpret_cast<Header*>(m_file.getData());
+
+        memset(m_header, 0, sizeof(Header));
+        m_header->magic       = MAGIC;
+        m_header->version     = VERSION;
+        m_header->headerSize  = HEADER_SIZE;
+        m_header->capacity    = capacity;
+        m_header->count       = 0U;
+        m_header->segment     = segment;
+        m_header->payloadSize = MAX_PAYLOAD_SIZE;
+        strncpy(m_header->channelName, channelName, sizeof(m_header->channelName) - 1U);
+
+        mapColumns();
+
+        m_isWritable = true;
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool ColumnLog::open(const char* fileName)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((true == m_file.open(fileName)) && (sizeof(Header) <= m_file.getSize()))
+    {
+        /* The file is mapped read only, the header is never written. */
+        Header* header = reinterpret_cast<Header*>(const_cast<uint8_t*>(m_file.getData()));
+
+        if ((MAGIC == header->magic) && (VERSION == header->version) && (HEADER_SIZE == header->headerSize) &&
+            (MAX_PAYLOAD_SIZE == header->payloadSize) && (header->capacity >= header->count) &&
+            (getFileSize(header->capacity) <= m_file.getSize()) &&
+            ('\0' == header->channelName[sizeof(header->channelName) - 1U]))
+        {
+            m_header = header;
+            mapColumns();
+
+            isSuccessful = true;
+        }
+    }
+
+    if (false == isSuccessful)
+    {
+        close();
+    }
+
+    return isSuccessful;
+}
+
+void ColumnLog::close()
+{
+    m_file.close();
+
+    m_isWritable = false;
+    m_header     = nullptr;
+    m_timestamps = nullptr;
+    m_sizes      = nullptr;
+    m_payloads   = nullptr;
+}
+
+bool ColumnLog::append(uint64_t timestamp, const uint8_t* payload, uint8_t size)
+{
+    bool isSuccessful = false;
+
+    if ((true == m_isWritable) && (false == isFull()) && (MAX_PAYLOAD_SIZE >= size) &&
+        ((nullptr != payload) || (0U == size)))
+    {
+        uint32_t idx = m_header->count;
+
+        m_timestamps[idx] = timestamp;
+        m_sizes[idx]      = size;
+
+        if (0U < size)
+        {
+            memcpy(&m_payloads[idx * MAX_PAYLOAD_SIZE], payload, size);
+        }
+
+        /* The record becomes valid with the count update. */
+        m_header->count = idx + 1U;
+
+        isSuccessful = true;
+    }
+
+    return isSuccessful;
+}
+
+bool ColumnLog::isFull() const
+{
+    return (nullptr == m_header) || (m_header->capacity <= m_header->count);
+}
+
+uint32_t ColumnLog::getCount() const
+{
+    return (nullptr != m_header) ? m_header->count : 0U;
+}
+
+uint32_t ColumnLog::getSegment() const
+{
+    return (nullptr != m_header) ? m_header->segment : 0U;
+}
+
+const char* ColumnLog::getChannelName() const
+{
+    return (nullptr != m_header) ? m_header->channelName : "";
+}
+
+uint64_t ColumnLog::getTimestamp(uint32_t idx) const
+{
+    return (getCount() > idx) ? m_timestamps[idx] : 0U;
+}
+
+const uint8_t* ColumnLog::getPayload(uint32_t idx, uint8_t& size) const
+{
+    const uint8_t* payload = nullptr;
+
+    if (getCount() > idx)
+    {
+        size    = m_sizes[idx];
+        payload = &m_payloads[idx * MAX_PAYLOAD_SIZE];
+
+        /* Never trust a file, which may come from somewhere else. */
+        if (MAX_PAYLOAD_SIZE < size)
+        {
+            size = MAX_PAYLOAD_SIZE;
+        }
+    }
+    else
+    {
+        size = 0U;
+    }
+
+    return payload;
+}
+
+size_t ColumnLog::getFileSize(uint32_t capacity)
+{
+    return HEADER_SIZE + (static_cast<size_t>(capacity) * (sizeof(uint64_t) + sizeof(uint8_t) + MAX_PAYLOAD_SIZE));
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void ColumnLog::mapColumns()
+{
+    uint8_t* data     = const_cast<uint8_t*>(m_file.getData());
+    size_t   capacity = m_header->capacity;
+
+    m_timestamps = reinterpret_cast<uint64_t*>(&data[HEADER_SIZE]);
+    m_sizes      = &data[HEADER_SIZE + (capacity * sizeof(uint64_t))];
+    m_payloads   = &data[HEADER_SIZE + (capacity * (sizeof(uint64_t) + sizeof(uint8_t)))];
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,236 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Columnar log of a single SerialMuxProt channel
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef COLUMN_LOG_H
+#define COLUMN_LOG_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "MappedFile.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A column log stores the received frames of one channel in a preallocated,
+ * memory-mapped file segment. The frames are not stored as rows, instead
+ * every field has its own column:
+ *
+ * | Offset                        | Content                                        |
+ * | ----------------------------- | ---------------------------------------------- |
+ * | 0                             | Header                                         |
+ * | HEADER_SIZE                   | uint64_t timestamps [us], capacity times       |
+ * | HEADER_SIZE + 8 * capacity    | uint8_t payload sizes [byte], capacity times   |
+ * | HEADER_SIZE + 9 * capacity    | Payloads with MAX_PAYLOAD_SIZE, capacity times |
+ *
+ * The number of records in the header is updated after every appended
+ * record, so the segment is consistent even if the recorder is killed.
+ * All values are in host byte order.
+ */
+class ColumnLog
+{
+public:
+    /** File magic "RCOL". */
+    static const uint32_t MAGIC = 0x4C4F4352U;
+
+    /** File format version. */
+    static const uint16_t VERSION = 1U;
+
+    /** Header size in byte, which keeps the timestamp column 8 byte aligned. */
+    static const uint16_t HEADER_SIZE = 64U;
+
+    /** Max. payload size of a SerialMuxProt frame in byte. */
+    static const uint8_t MAX_PAYLOAD_SIZE = 32U;
+
+    /** Max. length of a SerialMuxProt channel name. */
+    static const uint8_t MAX_CHANNEL_NAME_LENGTH = 10U;
+
+    /**
+     * Constructs a closed column log.
+     */
+    ColumnLog();
+
+    /**
+     * Destroys the column log.
+     */
+    ~ColumnLog()
+    {
+    }
+
+    /**
+     * Create a new segment file, which is preallocated for the given number
+     * of records.
+     *
+     * @param[in] fileName      Name of the segment file
+     * @param[in] channelName   Name of the recorded channel
+     * @param[in] segment       Segment number
+     * @param[in] capacity      Max. number of records
+     *
+     * @return If successful created, it will return true otherwise false.
+     */
+    bool create(const char* fileName, const char* channelName, uint32_t segment, uint32_t capacity);
+
+    /**
+     * Open a existing segment file read only.
+     *
+     * @param[in] fileName  Name of the segment file
+     *
+     * @return If successful opened and valid, it will return true otherwise false.
+     */
+    bool open(const char* fileName);
+
+    /**
+     * Close the segment file.
+     */
+    void close();
+
+    /**
+     * Append a record.
+     *
+     * @param[in] timestamp Receive timestamp in [us]
+     * @param[in] payload   Frame payload
+     * @param[in] size      Payload size in byte
+     *
+     * @return If successful appended, it will return true otherwise false.
+     */
+    bool append(uint64_t timestamp, const uint8_t* payload, uint8_t size);
+
+    /**
+     * Is the segment full?
+     *
+     * @return If full or closed, it will return true otherwise false.
+     */
+    bool isFull() const;
+
+    /**
+     * Get the number of records.
+     *
+     * @return Number of records
+     */
+    uint32_t getCount() const;
+
+    /**
+     * Get the segment number.
+     *
+     * @return Segment number
+     */
+    uint32_t getSegment() const;
+
+    /**
+     * Get the name of the recorded channel.
+     *
+     * @return Channel name or a empty string, if closed.
+     */
+    const char* getChannelName() const;
+
+    /**
+     * Get the receive timestamp of a record.
+     *
+     * @param[in] idx   Record index
+     *
+     * @return Timestamp in [us]
+     */
+    uint64_t getTimestamp(uint32_t idx) const;
+
+    /**
+     * Get the payload of a record.
+     *
+     * @param[in]   idx     Record index
+     * @param[out]  size    Payload size in byte
+     *
+     * @return Payload or nullptr, if the index is invalid.
+     */
+    const uint8_t* getPayload(uint32_t idx, uint8_t& size) const;
+
+    /**
+     * Get the file size of a segment.
+     *
+     * @param[in] capacity  Max. number of records
+     *
+     * @return File size in byte
+     */
+    static size_t getFileSize(uint32_t capacity);
+
+private:
+    /** Segment file header. */
+    typedef struct _Header
+    {
+        uint32_t magic;                                     /**< File magic */
+        uint16_t version;                                   /**< File format version */
+        uint16_t headerSize;                                /**< Header size in byte */
+        char     channelName[MAX_CHANNEL_NAME_LENGTH + 2U]; /**< Zero terminated channel name */
+        uint32_t capacity;                                  /**< Max. number of records */
+        uint32_t count;                                     /**< Number of records */
+        uint32_t segment;                                   /**< Segment number */
+        uint8_t  payloadSize;                               /**< Size of a payload column entry in byte */
+        uint8_t  reserved[HEADER_SIZE - 33U];               /**< Reserved, always 0 */
+
+    } __attribute__((packed)) Header;
+
+    MappedFile m_file;       /**< Memory-mapped segment file */
+    bool       m_isWritable; /**< Is the segment opened for writing? */
+    Header*    m_header;     /**< Header in the mapped file */
+    uint64_t*  m_timestamps; /**< Timestamp column */
+    uint8_t*   m_sizes;      /**< Payload size column */
+    uint8_t*   m_payloads;   /**< Payload column */
+
+    /**
+     * Set the column pointers according to the mapped header.
+     */
+    void mapColumns();
+
+    /* Not allowed. */
+    ColumnLog(const ColumnLog& log);
+    ColumnLog& operator=(const ColumnLog& log);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* COLUMN_LOG_H */
+/** @} */
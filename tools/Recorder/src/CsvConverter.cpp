@@ -0,0 +1,269 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Converter of recorded column logs to CSV
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "CsvConverter.h"
+#include "ColumnLog.h"
+#include "Recorder.h"
+#include <inttypes.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+uint32_t CsvConverter::convert(FILE* out, const char* directory, const char* channelName, const char* format)
+{
+    uint32_t  segment = 0U;
+    ColumnLog log;
+    char      fileName[Recorder::MAX_PATH_LENGTH];
+
+    if ((nullptr == out) || ((nullptr != format) && (false == isFormatValid(format))))
+    {
+        return 0U;
+    }
+
+    while ((true == Recorder::getSegmentFileName(fileName, sizeof(fileName), directory, channelName, segment)) &&
+           (true == log.open(fileName)))
+    {
+        uint32_t count = log.getCount();
+        uint32_t idx;
+
+        if (0U == segment)
+        {
+            writeHeader(out, format);
+        }
+
+        for (idx = 0U; idx < count; ++idx)
+        {
+            uint8_t        size    = 0U;
+            const uint8_t* payload = log.getPayload(idx, size);
+
+            writeRecord(out, log.getTimestamp(idx), payload, size, format);
+        }
+
+        log.close();
+        ++segment;
+    }
+
+    return segment;
+}
+
+bool CsvConverter::isFormatValid(const char* format)
+{
+    bool   isValid = (nullptr != format) && ('\0' != format[0]);
+    size_t size    = 0U;
+
+    while ((true == isValid) && ('\0' != *format))
+    {
+        uint8_t valueSize = getValueSize(*format);
+
+        if (0U == valueSize)
+        {
+            isValid = false;
+        }
+        else
+        {
+            size += valueSize;
+            ++format;
+        }
+    }
+
+    return (true == isValid) && (ColumnLog::MAX_PAYLOAD_SIZE >= size);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void CsvConverter::writeHeader(FILE* out, const char* format) const
+{
+    fputs("timestamp_us,size", out);
+
+    if (nullptr == format)
+    {
+        fputs(",payload", out);
+    }
+    else
+    {
+        unsigned int valueIdx = 0U;
+
+        while ('\0' != *format)
+        {
+            if ('x' != *format)
+            {
+                fprintf(out, ",value%u", valueIdx);
+                ++valueIdx;
+            }
+
+            ++format;
+        }
+    }
+
+    fputs("\n", out);
+}
+
+void CsvConverter::writeRecord(FILE* out, uint64_t timestamp, const uint8_t* payload, uint8_t size,
+                               const char* format) const
+{
+    fprintf(out, "%" PRIu64 ",%u,", timestamp, static_cast<unsigned int>(size));
+
+    if (nullptr == format)
+    {
+        uint8_t idx;
+
+        for (idx = 0U; idx < size; ++idx)
+        {
+            fprintf(out, "%02X", payload[idx]);
+        }
+    }
+    else
+    {
+        uint8_t offset  = 0U;
+        bool    isFirst = true;
+
+        while ('\0' != *format)
+        {
+            uint8_t  valueSize = getValueSize(*format);
+            uint32_t raw       = 0U;
+            uint8_t  idx;
+
+            /* Little endian, missing bytes of a short frame are 0. */
+            for (idx = 0U; idx < valueSize; ++idx)
+            {
+                if (size > (offset + idx))
+                {
+                    raw |= static_cast<uint32_t>(payload[offset + idx]) << (8U * idx);
+                }
+            }
+
+            if ('x' != *format)
+            {
+                if (false == isFirst)
+                {
+                    fputc(',', out);
+                }
+
+                switch (*format)
+                {
+                case 'b':
+                    fprintf(out, "%d", static_cast<int>(static_cast<int8_t>(raw)));
+                    break;
+
+                case 'h':
+                    fprintf(out, "%d", static_cast<int>(static_cast<int16_t>(raw)));
+                    break;
+
+                case 'i':
+                    fprintf(out, "%" PRId32, static_cast<int32_t>(raw));
+                    break;
+
+                default:
+                    fprintf(out, "%" PRIu32, raw);
+                    break;
+                }
+
+                isFirst = false;
+            }
+
+            offset += valueSize;
+            ++format;
+        }
+    }
+
+    fputs("\n", out);
+}
+
+uint8_t CsvConverter::getValueSize(char type)
+{
+    uint8_t size = 0U;
+
+    switch (type)
+    {
+    case 'x':
+        /* fallthrough */
+    case 'b':
+        /* fallthrough */
+    case 'B':
+        size = 1U;
+        break;
+
+    case 'h':
+        /* fallthrough */
+    case 'H':
+        size = 2U;
+        break;
+
+    case 'i':
+        /* fallthrough */
+    case 'I':
+        size = 4U;
+        break;
+
+    default:
+        break;
+    }
+
+    return size;
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
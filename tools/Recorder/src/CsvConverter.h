@@ -0,0 +1,149 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Converter of recorded column logs to CSV
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef CSV_CONVERTER_H
+#define CSV_CONVERTER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Converts all recorded segments of a channel to one CSV file with the
+ * columns timestamp [us], payload size [byte] and the payload.
+ *
+ * Without a format the payload is written as one hex string. With a format
+ * the payload is decoded little endian into one column per value, similar
+ * to the Python struct module:
+ * - b: int8_t
+ * - B: uint8_t
+ * - h: int16_t
+ * - H: uint16_t
+ * - i: int32_t
+ * - I: uint32_t
+ * - x: Padding byte, which is skipped.
+ */
+class CsvConverter
+{
+public:
+    /**
+     * Constructs the converter.
+     */
+    CsvConverter()
+    {
+    }
+
+    /**
+     * Destroys the converter.
+     */
+    ~CsvConverter()
+    {
+    }
+
+    /**
+     * Convert all segments of a channel to CSV.
+     *
+     * @param[in] out           Output file
+     * @param[in] directory     Directory with the recorded segments
+     * @param[in] channelName   Channel name
+     * @param[in] format        Payload format or nullptr for hex
+     *
+     * @return Number of converted segments, 0 if no segment was found.
+     */
+    uint32_t convert(FILE* out, const char* directory, const char* channelName, const char* format);
+
+    /**
+     * Is the payload format valid?
+     *
+     * @param[in] format    Payload format
+     *
+     * @return If valid, it will return true otherwise false.
+     */
+    static bool isFormatValid(const char* format);
+
+private:
+    /**
+     * Write the CSV header.
+     *
+     * @param[in] out       Output file
+     * @param[in] format    Payload format or nullptr for hex
+     */
+    void writeHeader(FILE* out, const char* format) const;
+
+    /**
+     * Write one record as CSV line.
+     *
+     * @param[in] out       Output file
+     * @param[in] timestamp Receive timestamp in [us]
+     * @param[in] payload   Payload
+     * @param[in] size      Payload size in byte
+     * @param[in] format    Payload format or nullptr for hex
+     */
+    void writeRecord(FILE* out, uint64_t timestamp, const uint8_t* payload, uint8_t size, const char* format) const;
+
+    /**
+     * Get the size of a payload format value.
+     *
+     * @param[in] type  Format character
+     *
+     * @return Size in byte or 0, if the format character is invalid.
+     */
+    static uint8_t getValueSize(char type);
+
+    /* Not allowed. */
+    CsvConverter(const CsvConverter& converter);
+    CsvConverter& operator=(const CsvConverter& converter);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* CSV_CONVERTER_H */
+/** @} */
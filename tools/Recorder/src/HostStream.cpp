@@ -0,0 +1,212 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary stream on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HostStream.h"
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void HostStream::print(const char str[])
+{
+    /* Not implemented */
+    (void)str;
+}
+
+void HostStream::print(uint8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::print(uint16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::print(uint32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::print(int8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::print(int16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::print(int32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::println(const char str[])
+{
+    /* Not implemented */
+    (void)str;
+}
+
+void HostStream::println(uint8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::println(uint16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::println(uint32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::println(int8_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::println(int16_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+void HostStream::println(int32_t value)
+{
+    /* Not implemented */
+    (void)value;
+}
+
+int HostStream::available() const
+{
+    return static_cast<int>(m_rxWriteIdx - m_rxReadIdx);
+}
+
+size_t HostStream::readBytes(uint8_t* buffer, size_t length)
+{
+    size_t count = m_rxWriteIdx - m_rxReadIdx;
+
+    if (length < count)
+    {
+        count = length;
+    }
+
+    if ((nullptr != buffer) && (0U < count))
+    {
+        memcpy(buffer, &m_rxBuffer[m_rxReadIdx], count);
+        m_rxReadIdx += count;
+    }
+    else
+    {
+        count = 0U;
+    }
+
+    return count;
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+uint8_t* HostStream::getRxSpace(size_t& space)
+{
+    /* Move the unread bytes to the begin, to get the max. space at the end. */
+    if (0U < m_rxReadIdx)
+    {
+        size_t unread = m_rxWriteIdx - m_rxReadIdx;
+
+        memmove(m_rxBuffer, &m_rxBuffer[m_rxReadIdx], unread);
+        m_rxReadIdx  = 0U;
+        m_rxWriteIdx = unread;
+    }
+
+    space = RX_BUFFER_SIZE - m_rxWriteIdx;
+
+    return &m_rxBuffer[m_rxWriteIdx];
+}
+
+void HostStream::commitRx(size_t count)
+{
+    if ((RX_BUFFER_SIZE - m_rxWriteIdx) >= count)
+    {
+        m_rxWriteIdx += count;
+    }
+}
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,227 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Binary stream on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <Stream.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Base of the binary streams, which connect the recorder with the robot.
+ * The SerialMuxProt only writes raw bytes, therefore all print methods are
+ * not implemented.
+ */
+class HostStream : public Stream
+{
+public:
+    /**
+     * Destroys the stream.
+     */
+    virtual ~HostStream()
+    {
+    }
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] str Argument to print.
+     */
+    void print(const char str[]) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(uint32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * @param[in] value Argument to print.
+     */
+    void print(int32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] str Argument to print.
+     */
+    void println(const char str[]) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(uint32_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int8_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int16_t value) final;
+
+    /**
+     * Print argument to the Output Stream.
+     * Appends Carriage Return at the end of the argument.
+     * @param[in] value Argument to print.
+     */
+    void println(int32_t value) final;
+
+    /**
+     * Check if any data has been received.
+     * @returns number of available bytes.
+     */
+    int available() const final;
+
+    /**
+     * Read bytes into a buffer.
+     * @param[in] buffer Array to write bytes to.
+     * @param[in] length number of bytes to be read.
+     * @returns Number of bytes read from Stream.
+     */
+    size_t readBytes(uint8_t* buffer, size_t length) final;
+
+    /**
+     * Receive the pending bytes from the connection.
+     *
+     * @return If the connection is still established, it will return true otherwise false.
+     */
+    virtual bool process() = 0;
+
+protected:
+    /** Size of the receive buffer in byte. */
+    static const size_t RX_BUFFER_SIZE = 4096U;
+
+    uint8_t m_rxBuffer[RX_BUFFER_SIZE]; /**< Receive buffer */
+    size_t  m_rxReadIdx;                /**< Read index in the receive buffer */
+    size_t  m_rxWriteIdx;               /**< Write index in the receive buffer */
+
+    /**
+     * Constructs the stream.
+     */
+    HostStream() : Stream(), m_rxBuffer(), m_rxReadIdx(0U), m_rxWriteIdx(0U)
+    {
+    }
+
+    /**
+     * Get the free space at the end of the receive buffer. Already read
+     * bytes are discarded before.
+     *
+     * @param[out] space    Free space in byte
+     *
+     * @return Write position in the receive buffer
+     */
+    uint8_t* getRxSpace(size_t& space);
+
+    /**
+     * Mark bytes as received, which were written to the space returned by
+     * getRxSpace().
+     *
+     * @param[in] count Number of received bytes
+     */
+    void commitRx(size_t count);
+
+private:
+    /* Not allowed. */
+    HostStream(const HostStream& stream);
+    HostStream& operator=(const HostStream& stream);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* HOST_STREAM_H */
+/** @} */
@@ -0,0 +1,337 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Memory-mapped file
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#undef UNICODE
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Platform specific handles of the mapped file. PIMPL idiom. */
+struct MappedFile::MappedFileImpl
+{
+#ifdef _WIN32
+    HANDLE m_file;    /**< File handle */
+    HANDLE m_mapping; /**< File mapping handle */
+
+    /**
+     * Constructs the handles invalid.
+     */
+    MappedFileImpl() : m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+    {
+    }
+#else
+    int m_fd; /**< File descriptor */
+
+    /**
+     * Constructs the handles invalid.
+     */
+    MappedFileImpl() : m_fd(-1)
+    {
+    }
+#endif
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+MappedFile::MappedFile() : m_members(new MappedFileImpl), m_data(nullptr), m_size(0U)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+
+    if (nullptr != m_members)
+    {
+        delete m_members;
+    }
+}
+
+#ifdef _WIN32
+
+bool MappedFile::create(const char* fileName, size_t size)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((nullptr != m_members) && (nullptr != fileName) && (0U < size))
+    {
+        m_members->m_file = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                                        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (INVALID_HANDLE_VALUE != m_members->m_file)
+        {
+            uint64_t size64 = static_cast<uint64_t>(size);
+
+            /* Preallocates the whole file, the mapping size is taken from the file size. */
+            m_members->m_mapping = CreateFileMappingA(m_members->m_file, nullptr, PAGE_READWRITE,
+                                                      static_cast<DWORD>(size64 >> 32U),
+                                                      static_cast<DWORD>(size64 & 0xFFFFFFFFU), nullptr);
+
+            if (nullptr != m_members->m_mapping)
+            {
+                m_data = static_cast<uint8_t*>(MapViewOfFile(m_members->m_mapping, FILE_MAP_WRITE, 0, 0, size));
+            }
+        }
+
+        if (nullptr != m_data)
+        {
+            m_size       = size;
+            isSuccessful = true;
+        }
+        else
+        {
+            close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool MappedFile::open(const char* fileName)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((nullptr != m_members) && (nullptr != fileName))
+    {
+        m_members->m_file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (INVALID_HANDLE_VALUE != m_members->m_file)
+        {
+            LARGE_INTEGER fileSize;
+
+            if ((FALSE != GetFileSizeEx(m_members->m_file, &fileSize)) && (0 < fileSize.QuadPart))
+            {
+                m_members->m_mapping = CreateFileMappingA(m_members->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+                if (nullptr != m_members->m_mapping)
+                {
+                    m_data = static_cast<uint8_t*>(MapViewOfFile(m_members->m_mapping, FILE_MAP_READ, 0, 0, 0));
+                    m_size = static_cast<size_t>(fileSize.QuadPart);
+                }
+            }
+        }
+
+        if (nullptr != m_data)
+        {
+            isSuccessful = true;
+        }
+        else
+        {
+            close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+void MappedFile::close()
+{
+    if (nullptr != m_data)
+    {
+        (void)UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+
+    if (nullptr != m_members)
+    {
+        if (nullptr != m_members->m_mapping)
+        {
+            (void)CloseHandle(m_members->m_mapping);
+            m_members->m_mapping = nullptr;
+        }
+
+        if (INVALID_HANDLE_VALUE != m_members->m_file)
+        {
+            (void)CloseHandle(m_members->m_file);
+            m_members->m_file = INVALID_HANDLE_VALUE;
+        }
+    }
+
+    m_size = 0U;
+}
+
+#else
+
+bool MappedFile::create(const char* fileName, size_t size)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((nullptr != m_members) && (nullptr != fileName) && (0U < size))
+    {
+        bool isAllocated = false;
+
+        m_members->m_fd = ::open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        if (0 <= m_members->m_fd)
+        {
+#ifdef __linux__
+            /* Reserve the disk space, so no page write back will fail later because the disk is full. */
+            isAllocated = (0 == posix_fallocate(m_members->m_fd, 0, static_cast<off_t>(size)));
+#else
+            isAllocated = (0 == ftruncate(m_members->m_fd, static_cast<off_t>(size)));
+#endif
+        }
+
+        if (true == isAllocated)
+        {
+            void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_members->m_fd, 0);
+
+            if (MAP_FAILED != data)
+            {
+                m_data = static_cast<uint8_t*>(data);
+            }
+        }
+
+        if (nullptr != m_data)
+        {
+            m_size       = size;
+            isSuccessful = true;
+        }
+        else
+        {
+            close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+bool MappedFile::open(const char* fileName)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((nullptr != m_members) && (nullptr != fileName))
+    {
+        struct stat fileStat;
+
+        m_members->m_fd = ::open(fileName, O_RDONLY);
+
+        if ((0 <= m_members->m_fd) && (0 == fstat(m_members->m_fd, &fileStat)) && (0 < fileStat.st_size))
+        {
+            size_t size = static_cast<size_t>(fileStat.st_size);
+            void*  data = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_members->m_fd, 0);
+
+            if (MAP_FAILED != data)
+            {
+                m_data = static_cast<uint8_t*>(data);
+                m_size = size;
+            }
+        }
+
+        if (nullptr != m_data)
+        {
+            isSuccessful = true;
+        }
+        else
+        {
+            close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+void MappedFile::close()
+{
+    if (nullptr != m_data)
+    {
+        (void)munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+
+    if ((nullptr != m_members) && (0 <= m_members->m_fd))
+    {
+        (void)::close(m_members->m_fd);
+        m_members->m_fd = -1;
+    }
+
+    m_size = 0U;
+}
+
+#endif /* _WIN32 */
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
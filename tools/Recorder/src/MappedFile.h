@@ -0,0 +1,158 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Memory-mapped file
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * A file, which is mapped completely into memory. A created file is
+ * preallocated with its final size, so writing to it never allocates and
+ * the operating system writes the pages back in the background.
+ */
+class MappedFile
+{
+public:
+    /**
+     * Constructs a closed file.
+     */
+    MappedFile();
+
+    /**
+     * Destroys the file. A opened file is closed.
+     */
+    ~MappedFile();
+
+    /**
+     * Create a file with the given size and map it read/write.
+     * A existing file is overwritten.
+     *
+     * @param[in] fileName  Name of the file
+     * @param[in] size      File size in byte
+     *
+     * @return If successful created, it will return true otherwise false.
+     */
+    bool create(const char* fileName, size_t size);
+
+    /**
+     * Open a existing file and map it read only.
+     *
+     * @param[in] fileName  Name of the file
+     *
+     * @return If successful opened, it will return true otherwise false.
+     */
+    bool open(const char* fileName);
+
+    /**
+     * Unmap and close the file.
+     */
+    void close();
+
+    /**
+     * Is the file opened?
+     *
+     * @return If opened, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return (nullptr != m_data);
+    }
+
+    /**
+     * Get the mapped file content.
+     *
+     * @return Mapped file content or nullptr, if closed.
+     */
+    uint8_t* getData()
+    {
+        return m_data;
+    }
+
+    /**
+     * Get the mapped file content.
+     *
+     * @return Mapped file content or nullptr, if closed.
+     */
+    const uint8_t* getData() const
+    {
+        return m_data;
+    }
+
+    /**
+     * Get the file size.
+     *
+     * @return File size in byte
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+private:
+    /** Struct for the platform specific handles. PIMPL idiom. */
+    struct MappedFileImpl;
+
+    MappedFileImpl* m_members; /**< Platform specific handles */
+    uint8_t*        m_data;    /**< Mapped file content */
+    size_t          m_size;    /**< File size in byte */
+
+    /* Not allowed. */
+    MappedFile(const MappedFile& file);
+    MappedFile& operator=(const MappedFile& file);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* MAPPED_FILE_H */
+/** @} */
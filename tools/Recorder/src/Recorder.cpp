@@ -0,0 +1,224 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Recorder of SerialMuxProt channels
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "Recorder.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** Callback, which receives the frames of a channel. */
+typedef void (*FrameCallback)(const uint8_t* payload, const uint8_t payloadSize, void* userData);
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+Recorder* Recorder::m_instance = nullptr;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+Recorder::Recorder(Stream& stream, const char* directory, uint32_t segmentCapacity) :
+    m_smpServer(stream),
+    m_directory(directory),
+    m_segmentCapacity(segmentCapacity),
+    m_channels(),
+    m_numChannels(0U),
+    m_startTime(getHostTime())
+{
+    m_instance = this;
+}
+
+Recorder::~Recorder()
+{
+    uint8_t idx;
+
+    for (idx = 0U; idx < m_numChannels; ++idx)
+    {
+        m_channels[idx].log.close();
+    }
+
+    m_instance = nullptr;
+}
+
+bool Recorder::addChannel(const char* channelName)
+{
+    /* One callback per channel, because the callback has no channel context. */
+    static const FrameCallback CALLBACKS[MAX_CHANNELS] = {
+        channelCallback<0U>, channelCallback<1U>, channelCallback<2U>, channelCallback<3U>, channelCallback<4U>,
+        channelCallback<5U>, channelCallback<6U>, channelCallback<7U>, channelCallback<8U>, channelCallback<9U>};
+    bool isSuccessful = false;
+
+    if ((MAX_CHANNELS > m_numChannels) && (nullptr != channelName) &&
+        (ColumnLog::MAX_CHANNEL_NAME_LENGTH >= strlen(channelName)))
+    {
+        Channel& channel = m_channels[m_numChannels];
+
+        strncpy(channel.name, channelName, sizeof(channel.name) - 1U);
+        channel.name[sizeof(channel.name) - 1U] = '\0';
+
+        if (true == createSegment(channel, 0U))
+        {
+            m_smpServer.subscribeToChannel(channel.name, CALLBACKS[m_numChannels]);
+            ++m_numChannels;
+
+            isSuccessful = true;
+        }
+    }
+
+    return isSuccessful;
+}
+
+void Recorder::process(uint32_t timestamp)
+{
+    m_smpServer.process(timestamp);
+}
+
+uint64_t Recorder::getNumRecords() const
+{
+    uint64_t numRecords = 0U;
+    uint8_t  idx;
+
+    for (idx = 0U; idx < m_numChannels; ++idx)
+    {
+        numRecords += m_channels[idx].numRecords;
+    }
+
+    return numRecords;
+}
+
+uint64_t Recorder::getNumLost() const
+{
+    uint64_t numLost = 0U;
+    uint8_t  idx;
+
+    for (idx = 0U; idx < m_numChannels; ++idx)
+    {
+        numLost += m_channels[idx].numLost;
+    }
+
+    return numLost;
+}
+
+bool Recorder::getSegmentFileName(char* fileName, size_t fileNameSize, const char* directory,
+                                  const char* channelName, uint32_t segment)
+{
+    int length = snprintf(fileName, fileNameSize, "%s/%s_%04u.col", directory, channelName,
+                          static_cast<unsigned int>(segment));
+
+    return (0 < length) && (fileNameSize > static_cast<size_t>(length));
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void Recorder::record(uint8_t channelIdx, const uint8_t* payload, uint8_t payloadSize)
+{
+    if (m_numChannels > channelIdx)
+    {
+        Channel& channel   = m_channels[channelIdx];
+        uint64_t timestamp = getHostTime() - m_startTime;
+
+        /* Continue in the next segment, if the current one is full. */
+        if ((true == channel.log.isFull()) && (false == createSegment(channel, channel.log.getSegment() + 1U)))
+        {
+            ++channel.numLost;
+        }
+        else if (false == channel.log.append(timestamp, payload, payloadSize))
+        {
+            ++channel.numLost;
+        }
+        else
+        {
+            ++channel.numRecords;
+        }
+    }
+}
+
+bool Recorder::createSegment(Channel& channel, uint32_t segment)
+{
+    bool isSuccessful = false;
+    char fileName[MAX_PATH_LENGTH];
+
+    if (true == getSegmentFileName(fileName, sizeof(fileName), m_directory, channel.name, segment))
+    {
+        channel.log.close();
+
+        isSuccessful = channel.log.create(fileName, channel.name, segment, m_segmentCapacity);
+
+        if (false == isSuccessful)
+        {
+            printf("Failed to create %s.\n", fileName);
+        }
+    }
+
+    return isSuccessful;
+}
+
+uint64_t Recorder::getHostTime()
+{
+    std::chrono::steady_clock::duration now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
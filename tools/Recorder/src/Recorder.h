@@ -0,0 +1,228 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Recorder of SerialMuxProt channels
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <SerialMuxProtServer.hpp>
+#include "ColumnLog.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * The recorder subscribes to SerialMuxProt channels and appends every
+ * received frame with its receive timestamp to the column log of the
+ * channel. A full column log segment is closed and the next one is created,
+ * so the recording is only limited by the disk size.
+ *
+ * The segments are named &lt;CHANNEL&gt;_&lt;SEGMENT&gt;.col.
+ */
+class Recorder
+{
+public:
+    /** Max. number of recorded channels. */
+    static const uint8_t MAX_CHANNELS = 10U;
+
+    /** Max. length of a file path. */
+    static const size_t MAX_PATH_LENGTH = 256U;
+
+    /**
+     * Constructs the recorder. Only one recorder instance is supported,
+     * because the SerialMuxProt callbacks have no channel context.
+     *
+     * @param[in] stream            Stream to the robot
+     * @param[in] directory         Output directory
+     * @param[in] segmentCapacity   Number of records per segment
+     */
+    Recorder(Stream& stream, const char* directory, uint32_t segmentCapacity);
+
+    /**
+     * Destroys the recorder.
+     */
+    ~Recorder();
+
+    /**
+     * Add a channel to record. The first segment is created immediately,
+     * to detect problems with the output directory before the recording.
+     *
+     * @param[in] channelName   Channel name
+     *
+     * @return If successful added, it will return true otherwise false.
+     */
+    bool addChannel(const char* channelName);
+
+    /**
+     * Process the received frames and the SerialMuxProt synchronization.
+     *
+     * @param[in] timestamp Current timestamp in [ms]
+     */
+    void process(uint32_t timestamp);
+
+    /**
+     * Is the recorder synchronized with the robot?
+     *
+     * @return If synchronized, it will return true otherwise false.
+     */
+    bool isSynced()
+    {
+        return m_smpServer.isSynced();
+    }
+
+    /**
+     * Get the number of recorded frames of all channels.
+     *
+     * @return Number of recorded frames
+     */
+    uint64_t getNumRecords() const;
+
+    /**
+     * Get the number of frames, which could not be recorded.
+     *
+     * @return Number of lost frames
+     */
+    uint64_t getNumLost() const;
+
+    /**
+     * Get the file name of a segment.
+     *
+     * @param[out]  fileName        Buffer for the file name
+     * @param[in]   fileNameSize    Buffer size in byte
+     * @param[in]   directory       Directory
+     * @param[in]   channelName     Channel name
+     * @param[in]   segment         Segment number
+     *
+     * @return If the file name fits into the buffer, it will return true otherwise false.
+     */
+    static bool getSegmentFileName(char* fileName, size_t fileNameSize, const char* directory,
+                                   const char* channelName, uint32_t segment);
+
+private:
+    /** A recorded channel. */
+    struct Channel
+    {
+        char      name[ColumnLog::MAX_CHANNEL_NAME_LENGTH + 1U]; /**< Channel name */
+        ColumnLog log;                                           /**< Current segment */
+        uint64_t  numRecords;                                    /**< Number of recorded frames */
+        uint64_t  numLost;                                       /**< Number of lost frames */
+
+        /**
+         * Constructs a unused channel.
+         */
+        Channel() : name(), log(), numRecords(0U), numLost(0U)
+        {
+        }
+    };
+
+    /** The recorder instance, which is called by the SerialMuxProt callbacks. */
+    static Recorder* m_instance;
+
+    SerialMuxProtServer<MAX_CHANNELS> m_smpServer;              /**< SerialMuxProt server */
+    const char*                       m_directory;              /**< Output directory */
+    uint32_t                          m_segmentCapacity;        /**< Number of records per segment */
+    Channel                           m_channels[MAX_CHANNELS]; /**< Recorded channels */
+    uint8_t                           m_numChannels;            /**< Number of recorded channels */
+    uint64_t                          m_startTime;              /**< Start time of the recording in [us] */
+
+    /**
+     * Record a received frame.
+     *
+     * @param[in] channelIdx    Index of the recorded channel
+     * @param[in] payload       Frame payload
+     * @param[in] payloadSize   Payload size in byte
+     */
+    void record(uint8_t channelIdx, const uint8_t* payload, uint8_t payloadSize);
+
+    /**
+     * Create the next segment of a channel.
+     *
+     * @param[in] channel   Recorded channel
+     * @param[in] segment   Segment number
+     *
+     * @return If successful created, it will return true otherwise false.
+     */
+    bool createSegment(Channel& channel, uint32_t segment);
+
+    /**
+     * Get the monotonic host time.
+     *
+     * @return Host time in [us]
+     */
+    static uint64_t getHostTime();
+
+    /**
+     * Receives the frames of the channel with the index given as template
+     * argument.
+     *
+     * @param[in] payload       Frame payload
+     * @param[in] payloadSize   Payload size in byte
+     * @param[in] userData      User data
+     */
+    template<uint8_t CHANNEL_IDX>
+    static void channelCallback(const uint8_t* payload, const uint8_t payloadSize, void* userData)
+    {
+        (void)userData;
+
+        if (nullptr != m_instance)
+        {
+            m_instance->record(CHANNEL_IDX, payload, payloadSize);
+        }
+    }
+
+    /* Not allowed. */
+    Recorder(const Recorder& recorder);
+    Recorder& operator=(const Recorder& recorder);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* RECORDER_H */
+/** @} */
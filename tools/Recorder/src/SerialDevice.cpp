@@ -0,0 +1,465 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Serial device, e.g. the USB serial port of the robot
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SerialDevice.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef _WIN32
+#undef UNICODE
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** SerialDevice Members. PIMPL Idiom. */
+struct SerialDevice::SerialDeviceImpl
+{
+#ifdef _WIN32
+    /**
+     * Device handle.
+     */
+    HANDLE m_handle;
+
+    /**
+     * Construct an SerialDeviceImpl instance.
+     */
+    SerialDeviceImpl() : m_handle(INVALID_HANDLE_VALUE)
+    {
+    }
+
+    /**
+     * Is the device opened?
+     *
+     * @return If opened, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return (INVALID_HANDLE_VALUE != m_handle);
+    }
+#else
+    /**
+     * File descriptor of the device.
+     */
+    int m_fd;
+
+    /**
+     * Construct an SerialDeviceImpl instance.
+     */
+    SerialDeviceImpl() : m_fd(-1)
+    {
+    }
+
+    /**
+     * Is the device opened?
+     *
+     * @return If opened, it will return true otherwise false.
+     */
+    bool isOpen() const
+    {
+        return (0 <= m_fd);
+    }
+#endif
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+#ifndef _WIN32
+static bool getBaudrate(uint32_t baudrate, speed_t& speed);
+#endif
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. time to wait for received bytes in [ms]. */
+static const int WAIT_TIMEOUT = 1;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SerialDevice::SerialDevice() : HostStream(), m_members(new SerialDeviceImpl)
+{
+}
+
+SerialDevice::~SerialDevice()
+{
+    close();
+
+    if (nullptr != m_members)
+    {
+        delete m_members;
+    }
+}
+
+#ifdef _WIN32
+
+bool SerialDevice::open(const char* deviceName, uint32_t baudrate)
+{
+    bool isSuccessful = false;
+
+    close();
+
+    if ((nullptr != m_members) && (nullptr != deviceName))
+    {
+        char fullName[MAX_PATH];
+
+        /* COM ports above 9 are only accessible with the device namespace prefix. */
+        (void)snprintf(fullName, sizeof(fullName), "\\\\.\\%s", deviceName);
+
+        m_members->m_handle = CreateFileA(fullName, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (INVALID_HANDLE_VALUE != m_members->m_handle)
+        {
+            DCB          dcb;
+            COMMTIMEOUTS timeouts;
+
+            memset(&dcb, 0, sizeof(dcb));
+            dcb.DCBlength = sizeof(dcb);
+
+            if (FALSE != GetCommState(m_members->m_handle, &dcb))
+            {
+                dcb.BaudRate     = baudrate;
+                dcb.ByteSize     = 8;
+                dcb.Parity       = NOPARITY;
+                dcb.StopBits     = ONESTOPBIT;
+                dcb.fBinary      = TRUE;
+                dcb.fParity      = FALSE;
+                dcb.fOutxCtsFlow = FALSE;
+                dcb.fOutxDsrFlow = FALSE;
+                dcb.fDtrControl  = DTR_CONTROL_ENABLE;
+                dcb.fRtsControl  = RTS_CONTROL_ENABLE;
+                dcb.fOutX        = FALSE;
+                dcb.fInX         = FALSE;
+
+                /* Return immediately with the pending bytes or after the timeout, if none is pending. */
+                timeouts.ReadIntervalTimeout         = MAXDWORD;
+                timeouts.ReadTotalTimeoutMultiplier  = MAXDWORD;
+                timeouts.ReadTotalTimeoutConstant    = WAIT_TIMEOUT;
+                timeouts.WriteTotalTimeoutMultiplier = 0;
+                timeouts.WriteTotalTimeoutConstant   = 0;
+
+                if ((FALSE != SetCommState(m_members->m_handle, &dcb)) &&
+                    (FALSE != SetCommTimeouts(m_members->m_handle, &timeouts)))
+                {
+                    isSuccessful = true;
+                }
+            }
+        }
+
+        if (false == isSuccessful)
+        {
+            printf("Failed to open %s.\n", deviceName);
+            close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+size_t SerialDevice::write(const uint8_t* buffer, size_t length)
+{
+    size_t bytesSent = 0U;
+
+    if ((nullptr != m_members) && (true == m_members->isOpen()))
+    {
+        DWORD written = 0;
+
+        if (FALSE == WriteFile(m_members->m_handle, buffer, static_cast<DWORD>(length), &written, nullptr))
+        {
+            printf("write failed\n");
+            close();
+        }
+        else
+        {
+            bytesSent = written;
+        }
+    }
+
+    return bytesSent;
+}
+
+bool SerialDevice::process()
+{
+    if ((nullptr != m_members) && (true == m_members->isOpen()))
+    {
+        size_t   space  = 0U;
+        uint8_t* buffer = getRxSpace(space);
+        DWORD    count  = 0;
+
+        if (0U < space)
+        {
+            if (FALSE == ReadFile(m_members->m_handle, buffer, static_cast<DWORD>(space), &count, nullptr))
+            {
+                printf("read failed\n");
+                close();
+            }
+            else
+            {
+                commitRx(count);
+            }
+        }
+    }
+
+    return (nullptr != m_members) && (true == m_members->isOpen());
+}
+
+#else
+
+bool SerialDevice::open(const char* deviceName, uint32_t baudrate)
+{
+    bool    isSuccessful = false;
+    speed_t speed;
+
+    close();
+
+    if ((nullptr != m_members) && (nullptr != deviceName) && (true == getBaudrate(baudrate, speed)))
+    {
+        m_members->m_fd = ::open(deviceName, O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+        if (0 <= m_members->m_fd)
+        {
+            struct termios tty;
+
+            if (0 == tcgetattr(m_members->m_fd, &tty))
+            {
+                cfmakeraw(&tty);
+                (void)cfsetispeed(&tty, speed);
+                (void)cfsetospeed(&tty, speed);
+
+                tty.c_cflag |= (CLOCAL | CREAD);
+                tty.c_cflag &= ~(CSTOPB | CRTSCTS);
+                tty.c_cc[VMIN]  = 0;
+                tty.c_cc[VTIME] = 0;
+
+                if (0 == tcsetattr(m_members->m_fd, TCSANOW, &tty))
+                {
+                    (void)tcflush(m_members->m_fd, TCIOFLUSH);
+                    isSuccessful = true;
+                }
+            }
+        }
+
+        if (false == isSuccessful)
+        {
+            printf("Failed to open %s.\n", deviceName);
+            close();
+        }
+    }
+
+    return isSuccessful;
+}
+
+size_t SerialDevice::write(const uint8_t* buffer, size_t length)
+{
+    size_t bytesSent = 0U;
+
+    if ((nullptr != m_members) && (true == m_members->isOpen()))
+    {
+        /* The device is non-blocking, wait until the whole buffer is written. */
+        while (length > bytesSent)
+        {
+            ssize_t result = ::write(m_members->m_fd, &buffer[bytesSent], length - bytesSent);
+
+            if (0 < result)
+            {
+                bytesSent += static_cast<size_t>(result);
+            }
+            else if ((0 > result) && (EAGAIN != errno) && (EINTR != errno))
+            {
+                printf("write failed\n");
+                close();
+                break;
+            }
+            else
+            {
+                struct pollfd pfd;
+
+                pfd.fd      = m_members->m_fd;
+                pfd.events  = POLLOUT;
+                pfd.revents = 0;
+
+                (void)poll(&pfd, 1, WAIT_TIMEOUT);
+            }
+        }
+    }
+
+    return bytesSent;
+}
+
+bool SerialDevice::process()
+{
+    if ((nullptr != m_members) && (true == m_members->isOpen()))
+    {
+        struct pollfd pfd;
+        int           result;
+
+        pfd.fd      = m_members->m_fd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+
+        result = poll(&pfd, 1, WAIT_TIMEOUT);
+
+        if ((0 < result) && (0 != (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))))
+        {
+            /* Device removed, e.g. the robot was reset. */
+            close();
+        }
+        else if ((0 < result) && (0 != (pfd.revents & POLLIN)))
+        {
+            size_t   space  = 0U;
+            uint8_t* buffer = getRxSpace(space);
+
+            if (0U < space)
+            {
+                ssize_t count = read(m_members->m_fd, buffer, space);
+
+                if (0 < count)
+                {
+                    commitRx(static_cast<size_t>(count));
+                }
+            }
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return (nullptr != m_members) && (true == m_members->isOpen());
+}
+
+#endif /* _WIN32 */
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SerialDevice::close()
+{
+    if ((nullptr != m_members) && (true == m_members->isOpen()))
+    {
+#ifdef _WIN32
+        (void)CloseHandle(m_members->m_handle);
+        m_members->m_handle = INVALID_HANDLE_VALUE;
+#else
+        (void)::close(m_members->m_fd);
+        m_members->m_fd = -1;
+#endif
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+#ifndef _WIN32
+
+/**
+ * Get the termios speed of a baudrate.
+ *
+ * @param[in]   baudrate    Baudrate
+ * @param[out]  speed       Termios speed
+ *
+ * @return If the baudrate is supported, it will return true otherwise false.
+ */
+static bool getBaudrate(uint32_t baudrate, speed_t& speed)
+{
+    bool isSupported = true;
+
+    switch (baudrate)
+    {
+    case 9600U:
+        speed = B9600;
+        break;
+
+    case 19200U:
+        speed = B19200;
+        break;
+
+    case 38400U:
+        speed = B38400;
+        break;
+
+    case 57600U:
+        speed = B57600;
+        break;
+
+    case 115200U:
+        speed = B115200;
+        break;
+
+    case 230400U:
+        speed = B230400;
+        break;
+
+    default:
+        printf("Baudrate %u is not supported.\n", static_cast<unsigned int>(baudrate));
+        isSupported = false;
+        break;
+    }
+
+    return isSupported;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,121 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Serial device, e.g. the USB serial port of the robot
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef SERIAL_DEVICE_H
+#define SERIAL_DEVICE_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HostStream.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Serial device, e.g. the USB serial port of the robot. It is used in raw
+ * mode with 8 data bits, no parity and 1 stop bit.
+ */
+class SerialDevice : public HostStream
+{
+public:
+    /**
+     * Constructs a closed serial device.
+     */
+    SerialDevice();
+
+    /**
+     * Destroys the serial device. A opened device is closed.
+     */
+    ~SerialDevice();
+
+    /**
+     * Open the serial device.
+     *
+     * @param[in] deviceName    Device name, e.g. /dev/ttyACM0 or COM6
+     * @param[in] baudrate      Baudrate
+     *
+     * @return If successful opened, it will return true otherwise false.
+     */
+    bool open(const char* deviceName, uint32_t baudrate);
+
+    /**
+     * Send bytes to the serial device.
+     * @param[in] buffer Byte buffer to send
+     * @param[in] length Number of bytes to send
+     * @returns Number of bytes written
+     */
+    size_t write(const uint8_t* buffer, size_t length) final;
+
+    /**
+     * Receive the pending bytes from the serial device. Waits up to 1 ms,
+     * if no byte is pending.
+     *
+     * @return If the device is still opened, it will return true otherwise false.
+     */
+    bool process() final;
+
+private:
+    /** Struct for Implementation of PIMPL Idiom. */
+    struct SerialDeviceImpl;
+
+    /** SerialDevice Members. PIMPL Idiom. */
+    SerialDeviceImpl* m_members;
+
+    /**
+     * Close the serial device.
+     */
+    void close();
+
+    /* Not allowed. */
+    SerialDevice(const SerialDevice& device);
+    SerialDevice& operator=(const SerialDevice& device);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIAL_DEVICE_H */
+/** @} */
@@ -0,0 +1,321 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Socket client, which connects to the socket server of the simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "SocketClient.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#undef UNICODE
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <windows.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+#ifndef _WIN32
+#define INVALID_SOCKET (SOCKET)(~0)
+#define SOCKET_ERROR   (-1)
+#endif
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+#ifndef _WIN32
+typedef int SOCKET;
+#endif
+
+/** SocketClient Members. PIMPL Idiom. */
+struct SocketClient::SocketClientImpl
+{
+    /**
+     * File Descriptor of the Socket.
+     */
+    SOCKET m_socket;
+
+    /**
+     * Is Winsock started?
+     */
+    bool m_isStarted;
+
+    /**
+     * Construct an SocketClientImpl instance.
+     */
+    SocketClientImpl() : m_socket(INVALID_SOCKET), m_isStarted(false)
+    {
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Max. time to wait for received bytes in [us]. */
+static const long WAIT_TIMEOUT = 1000;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+SocketClient::SocketClient() : HostStream(), m_members(new SocketClientImpl)
+{
+}
+
+SocketClient::~SocketClient()
+{
+    closeSocket();
+
+    if (nullptr != m_members)
+    {
+        delete m_members;
+    }
+}
+
+bool SocketClient::connect(const char* address, const char* port)
+{
+    int              result;
+    struct addrinfo  hints;
+    struct addrinfo* addrInfo = nullptr;
+    struct addrinfo* info     = nullptr;
+
+    if (nullptr == m_members)
+    {
+        return false;
+    }
+
+    closeSocket();
+
+#ifdef _WIN32
+    WSADATA wsaData;
+
+    /* Initialize Winsock */
+    result = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (0 != result)
+    {
+        printf("WSAStartup failed with error: %d\n", result);
+        return false;
+    }
+
+    m_members->m_isStarted = true;
+#endif
+
+    memset(&hints, 0, sizeof(struct addrinfo));
+
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    /* Resolve the server address and port */
+    result = getaddrinfo(address, port, &hints, &addrInfo);
+    if (0 != result)
+    {
+        printf("getaddrinfo failed with error: %d\n", result);
+        closeSocket();
+        return false;
+    }
+
+    /* Try every resolved address, until one accepts the connection. */
+    for (info = addrInfo; (nullptr != info) && (INVALID_SOCKET == m_members->m_socket); info = info->ai_next)
+    {
+        m_members->m_socket = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+
+        if (INVALID_SOCKET != m_members->m_socket)
+        {
+            result = ::connect(m_members->m_socket, info->ai_addr, static_cast<int>(info->ai_addrlen));
+
+            if (SOCKET_ERROR == result)
+            {
+#ifdef _WIN32
+                closesocket(m_members->m_socket);
+#else
+                close(m_members->m_socket);
+#endif
+                m_members->m_socket = INVALID_SOCKET;
+            }
+        }
+    }
+
+    freeaddrinfo(addrInfo);
+
+    if (INVALID_SOCKET == m_members->m_socket)
+    {
+        printf("connect failed\n");
+        closeSocket();
+        return false;
+    }
+
+    /* The SerialMuxProt frames are small, send them immediately. */
+    {
+        int flag = 1;
+
+        (void)setsockopt(m_members->m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag),
+                         sizeof(flag));
+    }
+
+    return true;
+}
+
+size_t SocketClient::write(const uint8_t* buffer, size_t length)
+{
+    size_t bytesSent = 0;
+
+    if ((nullptr != m_members) && (INVALID_SOCKET != m_members->m_socket))
+    {
+        int result = send(m_members->m_socket, reinterpret_cast<const char*>(buffer), static_cast<int>(length), 0);
+
+        if (SOCKET_ERROR == result)
+        {
+            printf("send failed\n");
+            closeSocket();
+        }
+        else
+        {
+            bytesSent = static_cast<size_t>(result);
+        }
+    }
+
+    return bytesSent;
+}
+
+bool SocketClient::process()
+{
+    if ((nullptr != m_members) && (INVALID_SOCKET != m_members->m_socket))
+    {
+        fd_set         readFDS;
+        int            result;
+        struct timeval timeout;
+
+        timeout.tv_sec  = 0;
+        timeout.tv_usec = WAIT_TIMEOUT;
+
+        FD_ZERO(&readFDS);
+        FD_SET(m_members->m_socket, &readFDS);
+
+        result = select(static_cast<int>(m_members->m_socket) + 1, &readFDS, nullptr, nullptr, &timeout);
+
+        if ((0 < result) && (FD_ISSET(m_members->m_socket, &readFDS)))
+        {
+            size_t   space  = 0U;
+            uint8_t* buffer = getRxSpace(space);
+
+            if (0U < space)
+            {
+                result = recv(m_members->m_socket, reinterpret_cast<char*>(buffer), static_cast<int>(space), 0);
+
+                if (0 < result)
+                {
+                    commitRx(static_cast<size_t>(result));
+                }
+                else
+                {
+                    /* Server disconnected or error on the socket. */
+                    closeSocket();
+                }
+            }
+        }
+        else if (0 > result)
+        {
+            printf("select failed\n");
+            closeSocket();
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return (nullptr != m_members) && (INVALID_SOCKET != m_members->m_socket);
+}
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+void SocketClient::closeSocket()
+{
+    if (nullptr != m_members)
+    {
+        if (INVALID_SOCKET != m_members->m_socket)
+        {
+#ifdef _WIN32
+            closesocket(m_members->m_socket);
+#else
+            close(m_members->m_socket);
+#endif
+            m_members->m_socket = INVALID_SOCKET;
+        }
+
+#ifdef _WIN32
+        /* Terminate the use of the Winsock 2 DLL. */
+        if (true == m_members->m_isStarted)
+        {
+            WSACleanup();
+            m_members->m_isStarted = false;
+        }
+#endif
+    }
+}
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
@@ -0,0 +1,120 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Socket client, which connects to the socket server of the simulation
+ * @author Andreas Merkle <web@blue-andi.de>
+ *
+ * @addtogroup Recorder
+ *
+ * @{
+ */
+
+#ifndef SOCKET_CLIENT_H
+#define SOCKET_CLIENT_H
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include "HostStream.h"
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Socket client, which connects to the socket server of the simulation.
+ */
+class SocketClient : public HostStream
+{
+public:
+    /**
+     * Constructs a disconnected socket client.
+     */
+    SocketClient();
+
+    /**
+     * Destroys the socket client. A established connection is closed.
+     */
+    ~SocketClient();
+
+    /**
+     * Connect to the socket server.
+     *
+     * @param[in] address   Server address
+     * @param[in] port      Server port
+     *
+     * @return If successful connected, it will return true otherwise false.
+     */
+    bool connect(const char* address, const char* port);
+
+    /**
+     * Send bytes to the socket server.
+     * @param[in] buffer Byte buffer to send
+     * @param[in] length Number of bytes to send
+     * @returns Number of bytes written
+     */
+    size_t write(const uint8_t* buffer, size_t length) final;
+
+    /**
+     * Receive the pending bytes from the socket server. Waits up to 1 ms,
+     * if no byte is pending.
+     *
+     * @return If the connection is still established, it will return true otherwise false.
+     */
+    bool process() final;
+
+private:
+    /** Struct for Implementation of PIMPL Idiom. */
+    struct SocketClientImpl;
+
+    /** SocketClient Members. PIMPL Idiom. */
+    SocketClientImpl* m_members;
+
+    /**
+     * Close the connection.
+     */
+    void closeSocket();
+
+    /* Not allowed. */
+    SocketClient(const SocketClient& client);
+    SocketClient& operator=(const SocketClient& client);
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SOCKET_CLIENT_H */
+/** @} */
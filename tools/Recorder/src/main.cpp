@@ -0,0 +1,448 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Recorder of SerialMuxProt channels, running on the host
+ * @author Andreas Merkle <web@blue-andi.de>
+ */
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <getopt.h>
+#include <chrono>
+#include "Recorder.h"
+#include "ChannelList.h"
+#include "CsvConverter.h"
+#include "SocketClient.h"
+#include "SerialDevice.h"
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/** This type defines the possible program arguments. */
+typedef struct
+{
+    const           char*     address;                /**< Socket server address */
+    const           char*     port;                   /**< Socket server port */
+    const           char*     device;                 /**< Serial device or nullptr */
+    uint32_t        baudrate;                         /**< Serial device baudrate */
+    const           char*     directory;              /**< Output directory */
+    uint32_t        segmentCapacity;                  /**< Number of records per segment */
+    uint32_t        duration;                         /**< Recording duration in [s], 0 for unlimited */
+    ChannelList     channels;                         /**< Channels */
+    bool            isConvert;                        /**< Convert to CSV instead of recording? */
+    bool            verbose;                          /**< Show verbose information */
+
+} PrgArguments;
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static int      handleCommandLineArguments(PrgArguments& prgArguments, int argc, char** argv);
+static int      record(const PrgArguments& prgArguments);
+static int      convert(const PrgArguments& prgArguments);
+static uint32_t getTimestamp();
+static void     signalHandler(int signalNumber);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Program argument default value of the socket server address. */
+static const char* PRG_ARG_ADDRESS_DEFAULT = "127.0.0.1";
+
+/** Program argument default value of the socket server port. */
+static const char* PRG_ARG_PORT_DEFAULT = "65432";
+
+/** Program argument default value of the serial device baudrate. */
+static const uint32_t PRG_ARG_BAUDRATE_DEFAULT = 115200U;
+
+/** Program argument default value of the output directory. */
+static const char* PRG_ARG_DIRECTORY_DEFAULT = ".";
+
+/**
+ * Program argument default value of the number of records per segment.
+ * A segment with max. payloads has 41 MB.
+ */
+static const uint32_t PRG_ARG_SEGMENT_CAPACITY_DEFAULT = 1048576U;
+
+/** Period of the status output in verbose mode in [ms]. */
+static const uint32_t STATUS_PERIOD = 1000U;
+
+/** Shall the recording continue? Cleared by Ctrl-C. */
+static volatile sig_atomic_t gIsRunning = 1;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Program entry point.
+ *
+ * @param[in] argc  Number of arguments
+ * @param[in] argv  Arguments
+ *
+ * @return Exit status
+ */
+extern int main(int argc, char** argv)
+{
+    int          status = 0;
+    PrgArguments prgArguments;
+
+    /* Remove any buffering from stout and stderr to get the printed information immediately. */
+    (void)setvbuf(stdout, NULL, _IONBF, 0);
+    (void)setvbuf(stderr, NULL, _IONBF, 0);
+
+    status = handleCommandLineArguments(prgArguments, argc, argv);
+
+    if (0 == status)
+    {
+        if (true == prgArguments.isConvert)
+        {
+            status = convert(prgArguments);
+        }
+        else
+        {
+            status = record(prgArguments);
+        }
+    }
+
+    return status;
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Handles the command line arguments.
+ *
+ * @param[out]  prgArguments    Program arguments
+ * @param[in]   argc            Number of arguments
+ * @param[in]   argv            Arguments
+ *
+ * @return If successful, it will return 0 otherwise -1.
+ */
+static int handleCommandLineArguments(PrgArguments& prgArguments, int argc, char** argv)
+{
+    int         status           = 0;
+    const char* availableOptions = "a:p:d:b:c:o:n:t:xvh";
+    const char* programName      = argv[0];
+    const char* channelList      = ChannelList::DEFAULT_LIST;
+    int         option           = getopt(argc, argv, availableOptions);
+
+    /* Set default values */
+    prgArguments.address         = PRG_ARG_ADDRESS_DEFAULT;
+    prgArguments.port            = PRG_ARG_PORT_DEFAULT;
+    prgArguments.device          = nullptr;
+    prgArguments.baudrate        = PRG_ARG_BAUDRATE_DEFAULT;
+    prgArguments.directory       = PRG_ARG_DIRECTORY_DEFAULT;
+    prgArguments.segmentCapacity = PRG_ARG_SEGMENT_CAPACITY_DEFAULT;
+    prgArguments.duration        = 0U;
+    prgArguments.isConvert       = false;
+    prgArguments.verbose         = false;
+
+    while ((-1 != option) && (0 == status))
+    {
+        switch (option)
+        {
+        case 'a': /* Socket server address */
+            prgArguments.address = optarg;
+            break;
+
+        case 'p': /* Socket server port */
+            prgArguments.port = optarg;
+            break;
+
+        case 'd': /* Serial device */
+            prgArguments.device = optarg;
+            break;
+
+        case 'b': /* Baudrate */
+            prgArguments.baudrate = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'c': /* Channels */
+            channelList = optarg;
+            break;
+
+        case 'o': /* Output directory */
+            prgArguments.directory = optarg;
+            break;
+
+        case 'n': /* Records per segment */
+            prgArguments.segmentCapacity = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 't': /* Duration */
+            prgArguments.duration = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+        case 'x': /* Convert */
+            prgArguments.isConvert = true;
+            break;
+
+        case 'v': /* Verbose */
+            prgArguments.verbose = true;
+            break;
+
+        case '?': /* Unknown */
+            /* fallthrough */
+
+        case 'h': /* Help */
+            /* fallthrough */
+
+        default: /* Default */
+            status = -1;
+            break;
+        }
+
+        option = getopt(argc, argv, availableOptions);
+    }
+
+    if ((0 == status) && (false == prgArguments.channels.parse(channelList)))
+    {
+        printf("Invalid channel list: %s\n", channelList);
+        status = -1;
+    }
+
+    if ((0 == status) && (0U == prgArguments.segmentCapacity))
+    {
+        printf("The number of records per segment must be greater than 0.\n");
+        status = -1;
+    }
+
+    /* Does the user need help? */
+    if (0 > status)
+    {
+        printf("Usage: %s <option(s)>\nOptions:\n", programName);
+        printf("\t-h\t\t\tShow this help message.\n");
+        printf("\t-a <ADDRESS>\t\tSet socket server address. Default: %s\n", PRG_ARG_ADDRESS_DEFAULT);
+        printf("\t-p <PORT NUMBER>\tSet socket server port. Default: %s\n", PRG_ARG_PORT_DEFAULT);
+        printf("\t-d <DEVICE>\t\tUse serial device instead of socket, e.g. /dev/ttyACM0 or COM6.\n");
+        printf("\t-b <BAUDRATE>\t\tSet serial device baudrate. Default: %u\n", PRG_ARG_BAUDRATE_DEFAULT);
+        printf("\t-c <CHANNELS>\t\tComma separated channels NAME[:FORMAT]. Default: %s\n",
+               ChannelList::DEFAULT_LIST);
+        printf("\t\t\t\tFORMAT is used for the CSV conversion, e.g. LINE_SENS:HHHHH.\n");
+        printf("\t-o <DIRECTORY>\t\tSet output directory. Default: %s\n", PRG_ARG_DIRECTORY_DEFAULT);
+        printf("\t-n <RECORDS>\t\tSet number of records per segment. Default: %u\n",
+               PRG_ARG_SEGMENT_CAPACITY_DEFAULT);
+        printf("\t-t <SECONDS>\t\tStop recording after the duration. Default: Stop with Ctrl-C.\n");
+        printf("\t-x\t\t\tConvert the recorded channels to CSV.\n");
+        printf("\t-v\t\t\tVerbose mode.\n");
+    }
+
+    return status;
+}
+
+/**
+ * Record the channels until Ctrl-C, the duration elapsed or the connection is lost.
+ *
+ * @param[in] prgArguments  Program arguments
+ *
+ * @return If successful, it will return 0 otherwise -1.
+ */
+static int record(const PrgArguments& prgArguments)
+{
+    int          status = 0;
+    SocketClient socketClient;
+    SerialDevice serialDevice;
+    HostStream*  stream = nullptr;
+
+    if (nullptr != prgArguments.device)
+    {
+        if (true == serialDevice.open(prgArguments.device, prgArguments.baudrate))
+        {
+            stream = &serialDevice;
+        }
+    }
+    else
+    {
+        if (true == socketClient.connect(prgArguments.address, prgArguments.port))
+        {
+            stream = &socketClient;
+        }
+    }
+
+    if (nullptr == stream)
+    {
+        status = -1;
+    }
+    else
+    {
+        Recorder recorder(*stream, prgArguments.directory, prgArguments.segmentCapacity);
+        uint8_t  idx;
+        uint32_t startTime  = getTimestamp();
+        uint32_t statusTime = startTime;
+        bool     isSynced   = false;
+
+        for (idx = 0U; (idx < prgArguments.channels.getNumChannels()) && (0 == status); ++idx)
+        {
+            if (false == recorder.addChannel(prgArguments.channels.getName(idx)))
+            {
+                status = -1;
+            }
+        }
+
+        (void)signal(SIGINT, signalHandler);
+
+        while ((0 == status) && (0 != gIsRunning) && (true == stream->process()))
+        {
+            uint32_t now = getTimestamp();
+
+            recorder.process(now);
+
+            if (isSynced != recorder.isSynced())
+            {
+                isSynced = recorder.isSynced();
+                printf("%s\n", (true == isSynced) ? "Synchronized." : "Synchronization lost.");
+            }
+
+            if ((true == prgArguments.verbose) && (STATUS_PERIOD <= (now - statusTime)))
+            {
+                printf("Records: %llu, lost: %llu\n", static_cast<unsigned long long>(recorder.getNumRecords()),
+                       static_cast<unsigned long long>(recorder.getNumLost()));
+                statusTime = now;
+            }
+
+            if ((0U < prgArguments.duration) && ((prgArguments.duration * 1000U) <= (now - startTime)))
+            {
+                gIsRunning = 0;
+            }
+        }
+
+        printf("Recorded %llu frames, lost %llu frames.\n", static_cast<unsigned long long>(recorder.getNumRecords()),
+               static_cast<unsigned long long>(recorder.getNumLost()));
+    }
+
+    return status;
+}
+
+/**
+ * Convert the recorded channels to CSV files in the output directory.
+ *
+ * @param[in] prgArguments  Program arguments
+ *
+ * @return If successful, it will return 0 otherwise -1.
+ */
+static int convert(const PrgArguments& prgArguments)
+{
+    int          status = 0;
+    CsvConverter converter;
+    uint8_t      idx;
+
+    for (idx = 0U; idx < prgArguments.channels.getNumChannels(); ++idx)
+    {
+        const char* channelName = prgArguments.channels.getName(idx);
+        char        fileName[Recorder::MAX_PATH_LENGTH];
+        int         length = snprintf(fileName, sizeof(fileName), "%s/%s.csv", prgArguments.directory, channelName);
+
+        if ((0 < length) && (sizeof(fileName) > static_cast<size_t>(length)))
+        {
+            FILE* out = fopen(fileName, "w");
+
+            if (nullptr == out)
+            {
+                printf("Failed to create %s.\n", fileName);
+                status = -1;
+            }
+            else
+            {
+                uint32_t segments;
+
+                /* Large buffer, because the CSV files may be huge. */
+                (void)setvbuf(out, nullptr, _IOFBF, 1024U * 1024U);
+
+                segments = converter.convert(out, prgArguments.directory, channelName,
+                                             prgArguments.channels.getFormat(idx));
+
+                (void)fclose(out);
+
+                if (0U == segments)
+                {
+                    printf("No segment of %s found.\n", channelName);
+                    (void)remove(fileName);
+                }
+                else
+                {
+                    printf("Converted %u segment(s) of %s to %s.\n", segments, channelName, fileName);
+                }
+            }
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Get the monotonic timestamp.
+ *
+ * @return Timestamp in [ms]
+ */
+static uint32_t getTimestamp()
+{
+    std::chrono::steady_clock::duration now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+}
+
+/**
+ * Stops the recording on Ctrl-C.
+ *
+ * @param[in] signalNumber  Signal number
+ */
+static void signalHandler(int signalNumber)
+{
+    (void)signalNumber;
+    gIsRunning = 0;
+}
@@ -0,0 +1,237 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <ChannelList.h>
+#include <string.h>
+
+/* Last, because it defines a MAX_CHANNELS macro. */
+#include <SerialMuxChannels.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testParse();
+static void testInvalid();
+static void testDefaultList();
+static bool isInList(const ChannelList& list, const char* channelName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point.
+ *
+ * @param[in] argc  Number of arguments
+ * @param[in] argv  Arguments
+ *
+ * @return Number of failed tests
+ */
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testParse);
+    RUN_TEST(testInvalid);
+    RUN_TEST(testDefaultList);
+
+    return UNITY_END();
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the parsing of the channel names and their optional payload format.
+ */
+static void testParse()
+{
+    ChannelList list;
+    const char* arg = "LINE_SENS:HHHHH,TELEMETRY,PATH_STAT:BBBHhh";
+
+    TEST_ASSERT_TRUE(list.parse(arg));
+    TEST_ASSERT_EQUAL_UINT8(3U, list.getNumChannels());
+
+    TEST_ASSERT_EQUAL_STRING("LINE_SENS", list.getName(0U));
+    TEST_ASSERT_EQUAL_STRING("HHHHH", list.getFormat(0U));
+    TEST_ASSERT_EQUAL_STRING("TELEMETRY", list.getName(1U));
+    TEST_ASSERT_NULL(list.getFormat(1U));
+    TEST_ASSERT_EQUAL_STRING("PATH_STAT", list.getName(2U));
+    TEST_ASSERT_EQUAL_STRING("BBBHhh", list.getFormat(2U));
+
+    /* The argument itself is not modified. */
+    TEST_ASSERT_EQUAL_STRING("LINE_SENS:HHHHH,TELEMETRY,PATH_STAT:BBBHhh", arg);
+
+    /* Out of range */
+    TEST_ASSERT_NULL(list.getName(3U));
+    TEST_ASSERT_NULL(list.getFormat(3U));
+
+    /* A new list replaces the previous one. */
+    TEST_ASSERT_TRUE(list.parse("SYSID"));
+    TEST_ASSERT_EQUAL_UINT8(1U, list.getNumChannels());
+    TEST_ASSERT_EQUAL_STRING("SYSID", list.getName(0U));
+}
+
+/**
+ * Test that invalid channel lists are rejected.
+ */
+static void testInvalid()
+{
+    ChannelList list;
+
+    TEST_ASSERT_FALSE(list.parse(nullptr));
+    TEST_ASSERT_FALSE(list.parse(""));
+    TEST_ASSERT_FALSE(list.parse(","));
+
+    /* Empty channel name */
+    TEST_ASSERT_FALSE(list.parse(":HH"));
+
+    /* Channel name with max. length and one character more */
+    TEST_ASSERT_TRUE(list.parse("ABCDEFGHIJ"));
+    TEST_ASSERT_FALSE(list.parse("ABCDEFGHIJK"));
+
+    /* Invalid formats: empty, unknown type and more than a payload */
+    TEST_ASSERT_FALSE(list.parse("LINE_SENS:"));
+    TEST_ASSERT_FALSE(list.parse("LINE_SENS:HHq"));
+    TEST_ASSERT_FALSE(list.parse("LINE_SENS:IIIIIIIIB"));
+    TEST_ASSERT_TRUE(list.parse("LINE_SENS:IIIIIIII"));
+
+    /* Max. number of channels and one more */
+    TEST_ASSERT_TRUE(list.parse("C0,C1,C2,C3,C4,C5,C6,C7,C8,C9"));
+    TEST_ASSERT_EQUAL_UINT8(10U, list.getNumChannels());
+    TEST_ASSERT_FALSE(list.parse("C0,C1,C2,C3,C4,C5,C6,C7,C8,C9,C10"));
+
+    /* No channel is left from a rejected list. */
+    TEST_ASSERT_EQUAL_UINT8(0U, list.getNumChannels());
+    TEST_ASSERT_NULL(list.getName(0U));
+}
+
+/**
+ * Test that the default list subscribes all tx channels of the RemoteControl
+ * application with exactly the names, the robot creates them.
+ */
+static void testDefaultList()
+{
+    ChannelList list;
+
+    TEST_ASSERT_TRUE(list.parse(ChannelList::DEFAULT_LIST));
+    TEST_ASSERT_EQUAL_UINT8(6U, list.getNumChannels());
+
+    TEST_ASSERT_TRUE(isInList(list, COMMAND_RESPONSE_CHANNEL_NAME));
+    TEST_ASSERT_TRUE(isInList(list, LINE_SENSOR_CHANNEL_NAME));
+    TEST_ASSERT_TRUE(isInList(list, SYSID_DATA_CHANNEL_NAME));
+    TEST_ASSERT_TRUE(isInList(list, PATH_STATUS_CHANNEL_NAME));
+    TEST_ASSERT_TRUE(isInList(list, TELEMETRY_CHANNEL_NAME));
+    TEST_ASSERT_TRUE(isInList(list, TELEMETRY_SCHEMA_CHANNEL_NAME));
+
+    /* The rx channels of the robot are not recorded. */
+    TEST_ASSERT_FALSE(isInList(list, COMMAND_CHANNEL_NAME));
+    TEST_ASSERT_FALSE(isInList(list, SPEED_SETPOINT_CHANNEL_NAME));
+    TEST_ASSERT_FALSE(isInList(list, SYSID_CONFIG_CHANNEL_NAME));
+    TEST_ASSERT_FALSE(isInList(list, WAYPOINTS_CHANNEL_NAME));
+}
+
+/**
+ * Is the channel in the list?
+ *
+ * @param[in] list          Channel list
+ * @param[in] channelName   Channel name
+ *
+ * @return If the channel is in the list, it will return true otherwise false.
+ */
+static bool isInList(const ChannelList& list, const char* channelName)
+{
+    bool    isFound = false;
+    uint8_t idx;
+
+    for (idx = 0U; (idx < list.getNumChannels()) && (false == isFound); ++idx)
+    {
+        if (0 == strcmp(channelName, list.getName(idx)))
+        {
+            isFound = true;
+        }
+    }
+
+    return isFound;
+}
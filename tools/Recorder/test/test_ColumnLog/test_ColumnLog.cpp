@@ -0,0 +1,395 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <ColumnLog.h>
+#include <CsvConverter.h>
+#include <Recorder.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void   testFileFormat();
+static void   testFull();
+static void   testOpen();
+static void   testCsvHex();
+static void   testCsvFormat();
+static void   writeSegment(uint32_t segment, uint32_t capacity);
+static size_t readFile(const char* fileName, uint8_t* buffer, size_t size);
+static void   assertCsv(const char* format, const char* expected);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Output directory of the test. */
+static const char* DIRECTORY = ".";
+
+/** Channel name of the test. */
+static const char* CHANNEL_NAME = "TEST_LOG";
+
+/** Number of records per segment. */
+static const uint32_t CAPACITY = 4U;
+
+/** Number of segments, which the tests create at most. */
+static const uint32_t MAX_SEGMENTS = 2U;
+
+/** Payloads of the records, which are written to every segment. */
+static const uint8_t PAYLOADS[][4U] = {{0x01U, 0x02U, 0xFEU, 0xFFU}, {0x80U, 0x00U, 0x34U, 0x12U}};
+
+/** Payload sizes of the records, the last record is a short frame. */
+static const uint8_t PAYLOAD_SIZES[] = {4U, 3U};
+
+/** Number of records, which are written to every segment. */
+static const uint32_t NUM_RECORDS = sizeof(PAYLOAD_SIZES) / sizeof(PAYLOAD_SIZES[0U]);
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point.
+ *
+ * @param[in] argc  Number of arguments
+ * @param[in] argv  Arguments
+ *
+ * @return Number of failed tests
+ */
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testFileFormat);
+    RUN_TEST(testFull);
+    RUN_TEST(testOpen);
+    RUN_TEST(testCsvHex);
+    RUN_TEST(testCsvFormat);
+
+    return UNITY_END();
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    uint32_t segment;
+    char     fileName[Recorder::MAX_PATH_LENGTH];
+
+    for (segment = 0U; segment < MAX_SEGMENTS; ++segment)
+    {
+        if (true == Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, CHANNEL_NAME, segment))
+        {
+            (void)remove(fileName);
+        }
+    }
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test the segment file layout byte by byte, as documented in the README.
+ */
+static void testFileFormat()
+{
+    const uint32_t SEGMENT   = 7U;
+    const size_t   FILE_SIZE = 64U + (8U + 1U + 32U) * CAPACITY;
+    static uint8_t file[FILE_SIZE + 1U];
+    char           fileName[Recorder::MAX_PATH_LENGTH];
+    uint32_t       value32 = 0U;
+    uint16_t       value16 = 0U;
+    uint64_t       value64 = 0U;
+    uint32_t       idx;
+
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, ColumnLog::getFileSize(CAPACITY));
+
+    TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, CHANNEL_NAME, 1U));
+    TEST_ASSERT_EQUAL_STRING("./TEST_LOG_0001.col", fileName);
+
+    writeSegment(SEGMENT, CAPACITY);
+
+    TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, CHANNEL_NAME, SEGMENT));
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, readFile(fileName, file, sizeof(file)));
+    (void)remove(fileName);
+
+    /* Header */
+    memcpy(&value32, &file[0U], sizeof(value32));
+    TEST_ASSERT_EQUAL_UINT32(ColumnLog::MAGIC, value32);
+    TEST_ASSERT_EQUAL_MEMORY("RCOL", &file[0U], 4U);
+    memcpy(&value16, &file[4U], sizeof(value16));
+    TEST_ASSERT_EQUAL_UINT16(1U, value16);
+    memcpy(&value16, &file[6U], sizeof(value16));
+    TEST_ASSERT_EQUAL_UINT16(64U, value16);
+    TEST_ASSERT_EQUAL_STRING(CHANNEL_NAME, reinterpret_cast<const char*>(&file[8U]));
+    memcpy(&value32, &file[20U], sizeof(value32));
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, value32);
+    memcpy(&value32, &file[24U], sizeof(value32));
+    TEST_ASSERT_EQUAL_UINT32(NUM_RECORDS, value32);
+    memcpy(&value32, &file[28U], sizeof(value32));
+    TEST_ASSERT_EQUAL_UINT32(SEGMENT, value32);
+    TEST_ASSERT_EQUAL_UINT8(32U, file[32U]);
+
+    /* Columns */
+    for (idx = 0U; idx < NUM_RECORDS; ++idx)
+    {
+        memcpy(&value64, &file[64U + 8U * idx], sizeof(value64));
+        TEST_ASSERT_EQUAL_INT64(1000U * (idx + 1U), value64);
+        TEST_ASSERT_EQUAL_UINT8(PAYLOAD_SIZES[idx], file[64U + 8U * CAPACITY + idx]);
+        TEST_ASSERT_EQUAL_MEMORY(PAYLOADS[idx], &file[64U + 9U * CAPACITY + 32U * idx], PAYLOAD_SIZES[idx]);
+    }
+}
+
+/**
+ * Test that a full segment rejects further records.
+ */
+static void testFull()
+{
+    ColumnLog log;
+    char      fileName[Recorder::MAX_PATH_LENGTH];
+    uint8_t   payload[ColumnLog::MAX_PAYLOAD_SIZE + 1U];
+    uint32_t  idx;
+
+    memset(payload, 0xA5, sizeof(payload));
+
+    TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, CHANNEL_NAME, 0U));
+    TEST_ASSERT_TRUE(log.create(fileName, CHANNEL_NAME, 0U, CAPACITY));
+
+    /* A payload larger than a column entry is rejected. */
+    TEST_ASSERT_FALSE(log.append(0U, payload, sizeof(payload)));
+
+    for (idx = 0U; idx < CAPACITY; ++idx)
+    {
+        TEST_ASSERT_FALSE(log.isFull());
+        TEST_ASSERT_TRUE(log.append(idx, payload, ColumnLog::MAX_PAYLOAD_SIZE));
+    }
+
+    TEST_ASSERT_TRUE(log.isFull());
+    TEST_ASSERT_FALSE(log.append(CAPACITY, payload, 1U));
+    TEST_ASSERT_EQUAL_UINT32(CAPACITY, log.getCount());
+
+    log.close();
+}
+
+/**
+ * Test reading a segment, which was written before.
+ */
+static void testOpen()
+{
+    ColumnLog log;
+    char      fileName[Recorder::MAX_PATH_LENGTH];
+    uint32_t  idx;
+
+    writeSegment(1U, CAPACITY);
+
+    TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, CHANNEL_NAME, 1U));
+    TEST_ASSERT_TRUE(log.open(fileName));
+
+    TEST_ASSERT_EQUAL_STRING(CHANNEL_NAME, log.getChannelName());
+    TEST_ASSERT_EQUAL_UINT32(1U, log.getSegment());
+    TEST_ASSERT_EQUAL_UINT32(NUM_RECORDS, log.getCount());
+    TEST_ASSERT_FALSE(log.isFull());
+
+    for (idx = 0U; idx < NUM_RECORDS; ++idx)
+    {
+        uint8_t        size    = 0U;
+        const uint8_t* payload = log.getPayload(idx, size);
+
+        TEST_ASSERT_EQUAL_INT64(1000U * (idx + 1U), log.getTimestamp(idx));
+        TEST_ASSERT_NOT_NULL(payload);
+        TEST_ASSERT_EQUAL_UINT8(PAYLOAD_SIZES[idx], size);
+        TEST_ASSERT_EQUAL_MEMORY(PAYLOADS[idx], payload, size);
+    }
+
+    /* A segment opened for reading is not writable. */
+    TEST_ASSERT_FALSE(log.append(0U, PAYLOADS[0U], 1U));
+
+    log.close();
+
+    /* Not a segment file */
+    TEST_ASSERT_FALSE(log.open("./TEST_LOG_9999.col"));
+}
+
+/**
+ * Test the conversion of all segments of a channel with the payload as hex string.
+ */
+static void testCsvHex()
+{
+    writeSegment(0U, CAPACITY);
+    writeSegment(1U, CAPACITY);
+
+    assertCsv(nullptr, "timestamp_us,size,payload\n"
+                       "1000,4,0102FEFF\n"
+                       "2000,3,800034\n"
+                       "1000,4,0102FEFF\n"
+                       "2000,3,800034\n");
+}
+
+/**
+ * Test the conversion with a payload format, which decodes the values little endian.
+ * The missing byte of the short frame is 0.
+ */
+static void testCsvFormat()
+{
+    writeSegment(0U, CAPACITY);
+
+    assertCsv("Bbh", "timestamp_us,size,value0,value1,value2\n"
+                     "1000,4,1,2,-2\n"
+                     "2000,3,128,0,52\n");
+
+    assertCsv("xxH", "timestamp_us,size,value0\n"
+                     "1000,4,65534\n"
+                     "2000,3,52\n");
+
+    assertCsv("i", "timestamp_us,size,value0\n"
+                   "1000,4,-130559\n"
+                   "2000,3,3408000\n");
+
+    /* An invalid format converts nothing. */
+    assertCsv("q", "");
+}
+
+/**
+ * Write the test records to a segment.
+ *
+ * @param[in] segment   Segment number
+ * @param[in] capacity  Number of records per segment
+ */
+static void writeSegment(uint32_t segment, uint32_t capacity)
+{
+    ColumnLog log;
+    char      fileName[Recorder::MAX_PATH_LENGTH];
+    uint32_t  idx;
+
+    TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, CHANNEL_NAME, segment));
+    TEST_ASSERT_TRUE(log.create(fileName, CHANNEL_NAME, segment, capacity));
+
+    for (idx = 0U; idx < NUM_RECORDS; ++idx)
+    {
+        TEST_ASSERT_TRUE(log.append(1000U * (idx + 1U), PAYLOADS[idx], PAYLOAD_SIZES[idx]));
+    }
+
+    log.close();
+}
+
+/**
+ * Read a file completely.
+ *
+ * @param[in]   fileName    File name
+ * @param[out]  buffer      Buffer
+ * @param[in]   size        Buffer size in byte
+ *
+ * @return Number of read bytes
+ */
+static size_t readFile(const char* fileName, uint8_t* buffer, size_t size)
+{
+    size_t count = 0U;
+    FILE*  file  = fopen(fileName, "rb");
+
+    if (nullptr != file)
+    {
+        count = fread(buffer, 1U, size, file);
+        (void)fclose(file);
+    }
+
+    return count;
+}
+
+/**
+ * Convert the test channel and compare the CSV output.
+ *
+ * @param[in] format    Payload format or nullptr
+ * @param[in] expected  Expected CSV output
+ */
+static void assertCsv(const char* format, const char* expected)
+{
+    CsvConverter converter;
+    FILE*        out = tmpfile();
+    char         csv[256U];
+    size_t       count;
+
+    TEST_ASSERT_NOT_NULL(out);
+
+    if (nullptr != out)
+    {
+        (void)converter.convert(out, DIRECTORY, CHANNEL_NAME, format);
+
+        rewind(out);
+        count      = fread(csv, 1U, sizeof(csv) - 1U, out);
+        csv[count] = '\0';
+        (void)fclose(out);
+
+        TEST_ASSERT_EQUAL_STRING(expected, csv);
+    }
+}
@@ -0,0 +1,408 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 Andreas Merkle <web@blue-andi.de>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @author  Andreas Merkle <web@blue-andi.de>
+ * @brief   This module contains the program entry point for the tests.
+ */
+
+/******************************************************************************
+ * Compile Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <unity.h>
+#include <Recorder.h>
+#include <HostStream.h>
+#include <ColumnLog.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************************************************************
+ * Compiler Switches
+ *****************************************************************************/
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and classes
+ *****************************************************************************/
+
+/**
+ * Stream, which writes directly into the receive buffer of its peer stream.
+ * Two connected loopback streams replace the connection to the robot.
+ */
+class LoopbackStream : public HostStream
+{
+public:
+    /**
+     * Constructs the loopback stream.
+     */
+    LoopbackStream() : HostStream(), m_peer(nullptr)
+    {
+    }
+
+    /**
+     * Destroys the loopback stream.
+     */
+    ~LoopbackStream()
+    {
+    }
+
+    /**
+     * Connect the stream with its peer.
+     *
+     * @param[in] peer  Peer stream, which receives the written bytes.
+     */
+    void connect(LoopbackStream& peer)
+    {
+        m_peer = &peer;
+    }
+
+    /**
+     * Write bytes to the peer stream.
+     *
+     * @param[in] buffer    Bytes to write
+     * @param[in] length    Number of bytes
+     *
+     * @return Number of written bytes
+     */
+    size_t write(const uint8_t* buffer, size_t length) final
+    {
+        size_t count = 0U;
+
+        if (nullptr != m_peer)
+        {
+            count = m_peer->receive(buffer, length);
+        }
+
+        return count;
+    }
+
+    /**
+     * The bytes are received already by write() of the peer.
+     *
+     * @return Always true, because the connection can not be lost.
+     */
+    bool process() final
+    {
+        return true;
+    }
+
+private:
+    LoopbackStream* m_peer; /**< Peer stream */
+
+    /**
+     * Receive bytes into the receive buffer.
+     *
+     * @param[in] buffer    Received bytes
+     * @param[in] length    Number of bytes
+     *
+     * @return Number of bytes, which fit into the receive buffer.
+     */
+    size_t receive(const uint8_t* buffer, size_t length)
+    {
+        size_t   space = 0U;
+        uint8_t* rx    = getRxSpace(space);
+
+        if (length < space)
+        {
+            space = length;
+        }
+
+        memcpy(rx, buffer, space);
+        commitRx(space);
+
+        return space;
+    }
+};
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static void testSubscription();
+static void processAll(Recorder& recorder, SerialMuxProtServer<Recorder::MAX_CHANNELS>& robot, uint32_t duration);
+static void assertSegment(const char* channelName, uint32_t segment, uint8_t marker, uint32_t firstIdx,
+                          uint32_t count);
+static void removeSegments(const char* channelName);
+
+/******************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/** Output directory of the test. */
+static const char* DIRECTORY = ".";
+
+/** Number of records per segment, small to get a new segment during the test. */
+static const uint32_t CAPACITY = 4U;
+
+/** Number of frames, which the robot sends per channel. */
+static const uint32_t NUM_FRAMES = 6U;
+
+/** Payload size of the test channels. */
+static const uint8_t PAYLOAD_SIZE = 4U;
+
+/** Names of the channels, which the robot provides. */
+static const char* CHANNEL_NAMES[] = {"REC_A", "REC_B", "REC_C"};
+
+/** Number of channels, which the robot provides. */
+static const uint8_t NUM_CHANNELS = sizeof(CHANNEL_NAMES) / sizeof(CHANNEL_NAMES[0U]);
+
+/** Number of channels, which the recorder subscribes. The last robot channel is not recorded. */
+static const uint8_t NUM_RECORDED_CHANNELS = NUM_CHANNELS - 1U;
+
+/** Simulated time step in [ms]. */
+static const uint32_t TIME_STEP = 10U;
+
+/** Stream of the robot side. */
+static LoopbackStream gRobotStream;
+
+/** Stream of the recorder side. */
+static LoopbackStream gRecorderStream;
+
+/** Simulated time in [ms]. */
+static uint32_t gTimestamp = 0U;
+
+/******************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Protected Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/******************************************************************************
+ * External Functions
+ *****************************************************************************/
+
+/**
+ * Main entry point.
+ *
+ * @param[in] argc  Number of arguments
+ * @param[in] argv  Arguments
+ *
+ * @return Number of failed tests
+ */
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    gRobotStream.connect(gRecorderStream);
+    gRecorderStream.connect(gRobotStream);
+
+    UNITY_BEGIN();
+
+    RUN_TEST(testSubscription);
+
+    return UNITY_END();
+}
+
+/**
+ * Initialize the test setup.
+ */
+extern void setUp(void)
+{
+}
+
+/**
+ * Clean up test setup.
+ */
+extern void tearDown(void)
+{
+    uint8_t idx;
+
+    for (idx = 0U; idx < NUM_CHANNELS; ++idx)
+    {
+        removeSegments(CHANNEL_NAMES[idx]);
+    }
+}
+
+/******************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/**
+ * Test that the recorder subscribes the channels by name and records every
+ * frame only in the column log of its channel. The robot channels are created
+ * in a different order than they are subscribed, so a mix up of the channel
+ * numbers is detected.
+ */
+static void testSubscription()
+{
+    SerialMuxProtServer<Recorder::MAX_CHANNELS> robot(gRobotStream);
+    uint8_t                                     channelIds[NUM_CHANNELS];
+    uint8_t                                     idx;
+    uint32_t                                    frameIdx;
+
+    /* Robot creates the channels in reverse order. */
+    for (idx = 0U; idx < NUM_CHANNELS; ++idx)
+    {
+        uint8_t channelIdx = NUM_CHANNELS - 1U - idx;
+
+        channelIds[channelIdx] = robot.createChannel(CHANNEL_NAMES[channelIdx], PAYLOAD_SIZE);
+        TEST_ASSERT_NOT_EQUAL(0U, channelIds[channelIdx]);
+    }
+
+    {
+        Recorder recorder(gRecorderStream, DIRECTORY, CAPACITY);
+
+        for (idx = 0U; idx < NUM_RECORDED_CHANNELS; ++idx)
+        {
+            TEST_ASSERT_TRUE(recorder.addChannel(CHANNEL_NAMES[idx]));
+        }
+
+        /* Too long for a column log. */
+        TEST_ASSERT_FALSE(recorder.addChannel("ABCDEFGHIJK"));
+
+        /* Synchronize and subscribe. */
+        processAll(recorder, robot, 2000U);
+        TEST_ASSERT_TRUE(recorder.isSynced());
+        TEST_ASSERT_TRUE(robot.isSynced());
+
+        for (frameIdx = 0U; frameIdx < NUM_FRAMES; ++frameIdx)
+        {
+            for (idx = 0U; idx < NUM_CHANNELS; ++idx)
+            {
+                uint8_t payload[PAYLOAD_SIZE] = {static_cast<uint8_t>(0xA0U + idx), static_cast<uint8_t>(frameIdx),
+                                                 0x55U, 0xAAU};
+
+                (void)robot.sendData(channelIds[idx], payload, sizeof(payload));
+            }
+
+            processAll(recorder, robot, TIME_STEP);
+        }
+
+        TEST_ASSERT_EQUAL_INT64(NUM_RECORDED_CHANNELS * NUM_FRAMES, recorder.getNumRecords());
+        TEST_ASSERT_EQUAL_INT64(0U, recorder.getNumLost());
+    }
+
+    /* The frames of a channel are split into a full and a partly filled segment. */
+    for (idx = 0U; idx < NUM_RECORDED_CHANNELS; ++idx)
+    {
+        assertSegment(CHANNEL_NAMES[idx], 0U, 0xA0U + idx, 0U, CAPACITY);
+        assertSegment(CHANNEL_NAMES[idx], 1U, 0xA0U + idx, CAPACITY, NUM_FRAMES - CAPACITY);
+    }
+
+    /* The not subscribed channel is not recorded. */
+    {
+        ColumnLog log;
+        char      fileName[Recorder::MAX_PATH_LENGTH];
+
+        TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY,
+                                                      CHANNEL_NAMES[NUM_CHANNELS - 1U], 0U));
+        TEST_ASSERT_FALSE(log.open(fileName));
+    }
+}
+
+/**
+ * Process the robot and the recorder for the given duration.
+ *
+ * @param[in] recorder  Recorder
+ * @param[in] robot     SerialMuxProt server of the robot
+ * @param[in] duration  Duration in [ms]
+ */
+static void processAll(Recorder& recorder, SerialMuxProtServer<Recorder::MAX_CHANNELS>& robot, uint32_t duration)
+{
+    uint32_t endTime = gTimestamp + duration;
+
+    while (endTime > gTimestamp)
+    {
+        gTimestamp += TIME_STEP;
+
+        robot.process(gTimestamp);
+        recorder.process(gTimestamp);
+    }
+}
+
+/**
+ * Check that a segment contains only the frames of its channel.
+ *
+ * @param[in] channelName   Channel name
+ * @param[in] segment       Segment number
+ * @param[in] marker        First payload byte, which identifies the channel
+ * @param[in] firstIdx      Frame index of the first record in the segment
+ * @param[in] count         Number of records in the segment
+ */
+static void assertSegment(const char* channelName, uint32_t segment, uint8_t marker, uint32_t firstIdx,
+                          uint32_t count)
+{
+    ColumnLog log;
+    char      fileName[Recorder::MAX_PATH_LENGTH];
+    uint32_t  idx;
+
+    TEST_ASSERT_TRUE(Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, channelName, segment));
+    TEST_ASSERT_TRUE(log.open(fileName));
+    TEST_ASSERT_EQUAL_STRING(channelName, log.getChannelName());
+    TEST_ASSERT_EQUAL_UINT32(count, log.getCount());
+
+    for (idx = 0U; idx < log.getCount(); ++idx)
+    {
+        uint8_t        size    = 0U;
+        const uint8_t* payload = log.getPayload(idx, size);
+
+        TEST_ASSERT_NOT_NULL(payload);
+        TEST_ASSERT_EQUAL_UINT8(PAYLOAD_SIZE, size);
+
+        if (nullptr != payload)
+        {
+            TEST_ASSERT_EQUAL_UINT8(marker, payload[0U]);
+            TEST_ASSERT_EQUAL_UINT8(firstIdx + idx, payload[1U]);
+        }
+
+        /* Timestamps are in receive order. */
+        if (0U < idx)
+        {
+            TEST_ASSERT_LESS_OR_EQUAL(log.getTimestamp(idx), log.getTimestamp(idx - 1U));
+        }
+    }
+
+    log.close();
+}
+
+/**
+ * Remove all segment files of a channel.
+ *
+ * @param[in] channelName   Channel name
+ */
+static void removeSegments(const char* channelName)
+{
+    uint32_t segment = 0U;
+    char     fileName[Recorder::MAX_PATH_LENGTH];
+
+    while ((true == Recorder::getSegmentFileName(fileName, sizeof(fileName), DIRECTORY, channelName, segment)) &&
+           (0 == remove(fileName)))
+    {
+        ++segment;
+    }
+}